@@ -1,351 +1,457 @@
-//************************************************************************
-//
-// Bitmap.cpp
-//
-//************************************************************************
-
-#include "StdAfx.h"
-#include "Bitmap.h"
-
-//************************************************************************
-//
-// cBitmap::cBitmap
-//
-//************************************************************************
-
-cBitmap::cBitmap(void)
-{
-    m_hBM = NULL;
-    m_nWidth = 0;
-    m_nHeight = 0;
-    m_pGdiPlusBitmap = NULL;
-}
-
-
-//************************************************************************
-//
-// cBitmap::~cBitmap
-//
-//************************************************************************
-
-cBitmap::~cBitmap(void)
-{
-    Shutdown();
-}
-
-
-//************************************************************************
-//
-// cBitmap::Shutdown
-//
-//************************************************************************
-
-void cBitmap::Shutdown(void)
-{
-    m_nWidth = 0;
-    m_nHeight = 0;
-    if(NULL != m_pGdiPlusBitmap)
-    {
-        delete m_pGdiPlusBitmap;
-        m_pGdiPlusBitmap = NULL;
-    }
-    m_hBM = NULL;
-}
-
-
-//************************************************************************
-//
-// cBitmap::Detach
-//
-//************************************************************************
-
-void cBitmap::Detach(void)
-{
-    Shutdown();
-}
-
-
-//************************************************************************
-//
-// cBitmap::LoadFromResource
-//
-//************************************************************************
-
-HRESULT cBitmap::LoadFromResource(HDC hDC, 
-                                  HINSTANCE hInstance, 
-                                  UINT nResourceID, 
-                                  LPCTSTR sResourceType /* = MAKEINTRESOURCE(RT_BITMAP */)
-{
-    UNREFERENCED_PARAMETER(hDC);
-
-    // Clear the old bitmap
-    Shutdown();
-
-    HRSRC hResource = FindResource(hInstance, MAKEINTRESOURCE(nResourceID), sResourceType);
-    if(NULL == hResource)
-    {
-        TRACE(_T("CBitmap::LoadImageFromResource(): failed to locate resource 0x%x (type: 0x%x) in instance 0x%x.\n"),
-            nResourceID, sResourceType, hInstance);
-        return E_FAIL;
-    }
-
-    DWORD dwImageSize = SizeofResource(hInstance, hResource);
-    if (0 == dwImageSize)
-    {
-        return E_FAIL;
-    }
-
-    const void* pResourceData = LockResource(LoadResource(hInstance, hResource));
-    if (NULL == pResourceData)
-    {
-        return E_FAIL;
-    }
-
-    HGLOBAL hGlobal = GlobalAlloc(GMEM_MOVEABLE | GMEM_DISCARDABLE, dwImageSize);
-    if (NULL == hGlobal)
-    {
-        return E_FAIL;
-    }
-
-    void* pBuffer = GlobalLock(hGlobal);
-    if (NULL == pBuffer)
-    {
-        GlobalFree(hGlobal);
-        return E_FAIL;
-    }
-
-    CopyMemory(pBuffer, pResourceData, dwImageSize);
-
-    // CreateStreamOnHGlobal requires HGLOBAL to be GlobalAlloc, moveable, and discardable 
-    if(NULL == hGlobal)
-    {
-        TRACE(_T("cBitmap::LoadImageFromResource(): failed to load resource 0x%x (type: 0x%x) in instance 0x%x.\n"),
-            nResourceID, sResourceType, hInstance);
-        GlobalFree(hGlobal);
-        return E_FAIL;
-    }
-
-    // Create an IStram from the HGLOBAL
-    IStream* pStream = NULL;
-    DWORD dwRet = S_OK;
-    dwRet = ::CreateStreamOnHGlobal(hGlobal, FALSE, &pStream);
-    if (FAILED(dwRet))
-    {
-        TRACE(_T("ERROR: CBitmap::LoadImageFromResource CreateStreamOnHGlobal returned %d\n"), dwRet);
-        GlobalFree(hGlobal);
-        return dwRet;
-    }
-
-    // Use GDI+ to generate a bitmap
-    m_pGdiPlusBitmap = Gdiplus::Bitmap::FromStream(pStream);
-    pStream->Release();
-    if (!m_pGdiPlusBitmap)
-    {
-        TRACE(_T("ERROR: CBitmap::LoadImageFromResource Gdiplus::Bitmap::FromStream failed\n"));
-        GlobalFree(hGlobal);
-        return E_FAIL;
-    }
-
-    // We don;t need the global memory block anymore
-    GlobalFree(hGlobal);
-    hGlobal = NULL;
-
-    // Get the bitmap handle
-    HBITMAP hBitmap = NULL;
-    if (m_pGdiPlusBitmap->GetHBITMAP(RGB(0,0,0), &hBitmap) != Gdiplus::Ok)
-    {
-        TRACE(_T("ERROR: CBitmap::LoadImageFromResource Gdiplus::Bitmap::GetHBITMAP failed\n"));
-        if (m_pGdiPlusBitmap)
-        {
-            delete m_pGdiPlusBitmap;
-            m_pGdiPlusBitmap = NULL;
-        }
-        return E_FAIL;
-    }
-
-    // Get the bitmap dimensions
-    BITMAP bmpInfo;
-    ZeroMemory(&bmpInfo, sizeof(bmpInfo));
-    ::GetObject(hBitmap, sizeof(BITMAP), &bmpInfo);
-
-    m_nWidth = bmpInfo.bmWidth;
-    m_nHeight = bmpInfo.bmHeight;
-
-    m_hBM = hBitmap;
-
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// cBitmap::LoadFromFile
-//
-//************************************************************************
-
-HRESULT cBitmap::LoadFromFile(HDC hDC, LPCTSTR sFilename)
-{
-    UNREFERENCED_PARAMETER(hDC);
-
-    // Clear the old bitmap
-    Shutdown();
-
-    // Use GDI+ to generate a bitmap
-    CStringW wsFilename(sFilename);
-    m_pGdiPlusBitmap = Gdiplus::Bitmap::FromFile(wsFilename);
-    if(NULL == m_pGdiPlusBitmap)
-    {
-        return E_FAIL;
-    }
-
-    // Get the bitmap handle
-    HBITMAP hBitmap = NULL;
-    if (m_pGdiPlusBitmap->GetHBITMAP(RGB(0,0,0), &hBitmap) != Gdiplus::Ok)
-    {
-        TRACE(_T("ERROR: cBitmap::LoadImageFromFile Gdiplus::Bitmap::GetHBITMAP failed\n"));
-        delete m_pGdiPlusBitmap;
-        m_pGdiPlusBitmap = NULL;
-        return E_FAIL;
-    }
-
-    // Get the bitmap dimensions
-    BITMAP bmpInfo;
-    ZeroMemory(&bmpInfo, sizeof(bmpInfo));
-    ::GetObject(hBitmap, sizeof(BITMAP), &bmpInfo);
-
-    m_nWidth = bmpInfo.bmWidth;
-    m_nHeight = bmpInfo.bmHeight;
-
-    m_hBM = hBitmap;
-
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// cBitmap::LoadFromMemory
-//
-//************************************************************************
-
-HRESULT cBitmap::LoadFromMemory(HDC hDC, LPVOID pBuffer, size_t nBufferSize)
-{
-    UNREFERENCED_PARAMETER(hDC);
-
-    // Clear the old bitmap
-    Shutdown();
-    HGLOBAL hGlobal = GlobalAlloc(GMEM_MOVEABLE/* | GMEM_DISCARDABLE*/, nBufferSize);
-    if (NULL == hGlobal)
-    {
-        return E_FAIL;
-    }
-
-    void* pGBuffer = GlobalLock(hGlobal);
-    if (NULL == pGBuffer)
-    {
-        GlobalFree(hGlobal);
-        return E_FAIL;
-    }
-
-    CopyMemory(pGBuffer, pBuffer, nBufferSize);
-
-    GlobalUnlock(hGlobal);
-
-    // Create an IStream from the HGLOBAL
-    IStream* pStream = NULL;
-    DWORD dwRet = S_OK;
-    dwRet = ::CreateStreamOnHGlobal(hGlobal, FALSE, &pStream);
-    if (FAILED(dwRet))
-    {
-        TRACE(_T("ERROR: cBitmap::LoadFromMemory CreateStreamOnHGlobal returned %d\n"), dwRet);
-        GlobalFree(hGlobal);
-        hGlobal = NULL;
-        return dwRet;
-    }
-
-    // Use GDI+ to generate a bitmap
-    m_pGdiPlusBitmap = Gdiplus::Bitmap::FromStream(pStream);
-    if (!m_pGdiPlusBitmap)
-    {
-        TRACE(_T("ERROR: cBitmap::LoadFromMemory Gdiplus::Bitmap::FromStream failed\n"));
-
-        pStream->Release();
-        GlobalFree(hGlobal);
-        hGlobal = NULL;
-
-        return E_FAIL;
-    }
-
-    // Get the bitmap handle
-    HBITMAP hBitmap = NULL;
-    Gdiplus::Status status = m_pGdiPlusBitmap->GetHBITMAP(RGB(0,0,0), &hBitmap);
-    if (Gdiplus::Ok != status)
-    {
-        TRACE(_T("ERROR: cBitmap::LoadFromMemory Gdiplus::Bitmap::GetHBITMAP failed\n"));
-        delete m_pGdiPlusBitmap;
-        m_pGdiPlusBitmap = NULL;
-
-        pStream->Release();
-        GlobalFree(hGlobal);
-        hGlobal = NULL;
-
-        return E_FAIL;
-    }
-
-    // Get the bitmap dimensions
-    BITMAP bmpInfo;
-    ZeroMemory(&bmpInfo, sizeof(bmpInfo));
-    ::GetObject(hBitmap, sizeof(BITMAP), &bmpInfo);
-
-    m_nWidth = bmpInfo.bmWidth;
-    m_nHeight = bmpInfo.bmHeight;
-
-    m_hBM = hBitmap;
-
-    // We don't need the global memory block anymore
-    pStream->Release();
-    GlobalFree(hGlobal);
-    hGlobal = NULL;
-
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// cBitmap::GetWidth
-//
-//************************************************************************
-
-int cBitmap::GetWidth(void)
-{
-    return m_nWidth;
-}
-
-
-//************************************************************************
-//
-// cBitmap::GetHeight
-//
-//************************************************************************
-
-int cBitmap::GetHeight(void)
-{
-    return m_nHeight;
-}
-
-
-//************************************************************************
-//
-// cBitmap::GetHBITMAP
-//
-//************************************************************************
-
-HBITMAP cBitmap::GetHBITMAP(void)
-{
-    return m_hBM;
-}
-
-
-//** end of Bitmap.cpp ***************************************************
-
+//************************************************************************
+//
+// Bitmap.cpp
+//
+//************************************************************************
+
+#include "StdAfx.h"
+#include "Bitmap.h"
+#include "LCDUI.h"
+
+//************************************************************************
+//
+// cBitmap::cBitmap
+//
+//************************************************************************
+
+cBitmap::cBitmap(void)
+{
+    m_hBM = NULL;
+    m_nWidth = 0;
+    m_nHeight = 0;
+    m_pGdiPlusBitmap = NULL;
+}
+
+
+//************************************************************************
+//
+// cBitmap::~cBitmap
+//
+//************************************************************************
+
+cBitmap::~cBitmap(void)
+{
+    Shutdown();
+}
+
+
+//************************************************************************
+//
+// cBitmap::Shutdown
+//
+//************************************************************************
+
+void cBitmap::Shutdown(void)
+{
+    m_nWidth = 0;
+    m_nHeight = 0;
+    if(NULL != m_pGdiPlusBitmap)
+    {
+        delete m_pGdiPlusBitmap;
+        m_pGdiPlusBitmap = NULL;
+    }
+    m_hBM = NULL;
+}
+
+
+//************************************************************************
+//
+// cBitmap::Detach
+//
+//************************************************************************
+
+void cBitmap::Detach(void)
+{
+    Shutdown();
+}
+
+
+//************************************************************************
+//
+// cBitmap::LoadFromResource
+//
+//************************************************************************
+
+HRESULT cBitmap::LoadFromResource(HDC hDC, 
+                                  HINSTANCE hInstance, 
+                                  UINT nResourceID, 
+                                  LPCTSTR sResourceType /* = MAKEINTRESOURCE(RT_BITMAP */)
+{
+    // Clear the old bitmap
+    Shutdown();
+
+    DWORD dwImageSize = 0;
+    const BYTE* pResourceData = FindResourceData(hInstance, nResourceID, sResourceType, dwImageSize);
+    if (NULL == pResourceData)
+    {
+        return E_FAIL;
+    }
+
+    // resources stay mapped, so they are decoded in place
+    return LoadFromMemory(hDC, (LPVOID)pResourceData, dwImageSize);
+}
+
+
+//************************************************************************
+//
+// cBitmap::LoadFromResources
+//
+// Sets up the bitmaps one after the other, which is cheap, then decodes
+// them all on every processor.
+//************************************************************************
+
+HRESULT cBitmap::LoadFromResources(HINSTANCE hInstance,
+                                   LPCTSTR sResourceType,
+                                   const UINT *pResourceIDs,
+                                   cBitmap **ppBitmaps,
+                                   int nCount)
+{
+    HRESULT hRes = S_OK;
+    std::vector<CLCDImageDecoder::DECODEJOB> jobs;
+    std::vector<int> jobBitmaps;
+
+    for (int i = 0; i < nCount; i++)
+    {
+        ppBitmaps[i]->Shutdown();
+
+        DWORD dwImageSize = 0;
+        const BYTE* pResourceData = FindResourceData(hInstance, pResourceIDs[i], sResourceType, dwImageSize);
+        PBYTE pBits = NULL;
+        HRESULT hResBitmap = (NULL == pResourceData) ? E_FAIL :
+                             ppBitmaps[i]->CreateTarget(pResourceData, dwImageSize, pBits);
+        if (SUCCEEDED(hResBitmap))
+        {
+            CLCDImageDecoder::DECODEJOB job;
+            ZeroMemory(&job, sizeof(job));
+            job.pData = pResourceData;
+            job.nSize = dwImageSize;
+            job.pBits = pBits;
+            job.nPitch = ppBitmaps[i]->m_nWidth * 4;
+            jobs.push_back(job);
+            jobBitmaps.push_back(i);
+        }
+        else if (E_NOTIMPL == hResBitmap)
+        {
+            hResBitmap = ppBitmaps[i]->LoadWithGdiPlus((LPVOID)pResourceData, dwImageSize);
+        }
+
+        if (FAILED(hResBitmap) && SUCCEEDED(hRes))
+        {
+            hRes = hResBitmap;
+        }
+    }
+
+    if (!jobs.empty())
+    {
+        CLCDImageDecoder::DecodeBatch(&jobs[0], (int)jobs.size());
+    }
+
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        if (SUCCEEDED(jobs[i].hRes))
+        {
+            continue;
+        }
+
+        cBitmap *pBitmap = ppBitmaps[jobBitmaps[i]];
+        DeleteObject(pBitmap->m_hBM);
+        pBitmap->Shutdown();
+        HRESULT hResBitmap = jobs[i].hRes;
+        if (E_NOTIMPL == hResBitmap)
+        {
+            hResBitmap = pBitmap->LoadWithGdiPlus((LPVOID)jobs[i].pData, jobs[i].nSize);
+        }
+        if (FAILED(hResBitmap) && SUCCEEDED(hRes))
+        {
+            hRes = hResBitmap;
+        }
+    }
+
+    return hRes;
+}
+
+
+//************************************************************************
+//
+// cBitmap::LoadFromFile
+//
+//************************************************************************
+
+HRESULT cBitmap::LoadFromFile(HDC hDC, LPCTSTR sFilename)
+{
+    // Clear the old bitmap
+    Shutdown();
+
+    HANDLE hFile = CreateFile(sFilename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == hFile)
+    {
+        TRACE(_T("ERROR: cBitmap::LoadFromFile could not open %s\n"), sFilename);
+        return E_FAIL;
+    }
+
+    std::vector<BYTE> buffer;
+    DWORD dwFileSize = GetFileSize(hFile, NULL);
+    DWORD dwRead = 0;
+    BOOL bRead = FALSE;
+    if ((INVALID_FILE_SIZE != dwFileSize) && (0 != dwFileSize))
+    {
+        buffer.resize(dwFileSize);
+        bRead = ReadFile(hFile, &buffer[0], dwFileSize, &dwRead, NULL) && (dwRead == dwFileSize);
+    }
+    CloseHandle(hFile);
+
+    if (!bRead)
+    {
+        TRACE(_T("ERROR: cBitmap::LoadFromFile could not read %s\n"), sFilename);
+        return E_FAIL;
+    }
+
+    return LoadFromMemory(hDC, &buffer[0], buffer.size());
+}
+
+
+//************************************************************************
+//
+// cBitmap::LoadFromMemory
+//
+// PNG and BMP are decoded straight into the DIB section, premultiplied,
+// as AlphaBlend() and CLCDBitmap take them. GDI+ loads anything else.
+//************************************************************************
+
+HRESULT cBitmap::LoadFromMemory(HDC hDC, LPVOID pBuffer, size_t nBufferSize)
+{
+    UNREFERENCED_PARAMETER(hDC);
+
+    // Clear the old bitmap
+    Shutdown();
+
+    const BYTE* pData = (const BYTE*)pBuffer;
+    PBYTE pBits = NULL;
+    HRESULT hRes = CreateTarget(pData, nBufferSize, pBits);
+    if (SUCCEEDED(hRes))
+    {
+        hRes = CLCDImageDecoder::Decode(pData, nBufferSize, pBits, m_nWidth * 4);
+        if (SUCCEEDED(hRes))
+        {
+            return S_OK;
+        }
+
+        DeleteObject(m_hBM);
+        Shutdown();
+    }
+
+    if (E_NOTIMPL == hRes)
+    {
+        return LoadWithGdiPlus(pBuffer, nBufferSize);
+    }
+
+    TRACE(_T("ERROR: cBitmap::LoadFromMemory could not decode the image (0x%x)\n"), hRes);
+    return hRes;
+}
+
+
+//************************************************************************
+//
+// cBitmap::FindResourceData
+//
+//************************************************************************
+
+const BYTE* cBitmap::FindResourceData(HINSTANCE hInstance,
+                                      UINT nResourceID,
+                                      LPCTSTR sResourceType,
+                                      DWORD &dwSize)
+{
+    dwSize = 0;
+
+    HRSRC hResource = FindResource(hInstance, MAKEINTRESOURCE(nResourceID), sResourceType);
+    if(NULL == hResource)
+    {
+        TRACE(_T("cBitmap::FindResourceData(): failed to locate resource 0x%x (type: 0x%x) in instance 0x%x.\n"),
+            nResourceID, sResourceType, hInstance);
+        return NULL;
+    }
+
+    DWORD dwImageSize = SizeofResource(hInstance, hResource);
+    if (0 == dwImageSize)
+    {
+        return NULL;
+    }
+
+    const BYTE* pResourceData = (const BYTE*)LockResource(LoadResource(hInstance, hResource));
+    if (NULL == pResourceData)
+    {
+        return NULL;
+    }
+
+    dwSize = dwImageSize;
+    return pResourceData;
+}
+
+
+//************************************************************************
+//
+// cBitmap::CreateTarget
+//
+// Creates the 32bpp top-down DIB section the image is decoded into.
+//************************************************************************
+
+HRESULT cBitmap::CreateTarget(const BYTE* pData, size_t nSize, PBYTE &pBits)
+{
+    pBits = NULL;
+
+    int nWidth = 0;
+    int nHeight = 0;
+    HRESULT hRes = CLCDImageDecoder::GetInfo(pData, nSize, nWidth, nHeight);
+    if (FAILED(hRes))
+    {
+        return hRes;
+    }
+
+    BITMAPINFO bmi;
+    ZeroMemory(&bmi, sizeof(bmi));
+    bmi.bmiHeader.biSize = sizeof(bmi.bmiHeader);
+    bmi.bmiHeader.biWidth = nWidth;
+    bmi.bmiHeader.biHeight = -nHeight;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    HBITMAP hBitmap = CreateDIBSection(NULL, &bmi, DIB_RGB_COLORS, (void**)&pBits, NULL, 0);
+    if ((NULL == hBitmap) || (NULL == pBits))
+    {
+        TRACE(_T("ERROR: cBitmap::CreateTarget CreateDIBSection failed\n"));
+        pBits = NULL;
+        return E_OUTOFMEMORY;
+    }
+
+    m_hBM = hBitmap;
+    m_nWidth = nWidth;
+    m_nHeight = nHeight;
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// cBitmap::LoadWithGdiPlus
+//
+//************************************************************************
+
+HRESULT cBitmap::LoadWithGdiPlus(LPVOID pBuffer, size_t nBufferSize)
+{
+    HGLOBAL hGlobal = GlobalAlloc(GMEM_MOVEABLE/* | GMEM_DISCARDABLE*/, nBufferSize);
+    if (NULL == hGlobal)
+    {
+        return E_FAIL;
+    }
+
+    void* pGBuffer = GlobalLock(hGlobal);
+    if (NULL == pGBuffer)
+    {
+        GlobalFree(hGlobal);
+        return E_FAIL;
+    }
+
+    CopyMemory(pGBuffer, pBuffer, nBufferSize);
+
+    GlobalUnlock(hGlobal);
+
+    // Create an IStream from the HGLOBAL
+    IStream* pStream = NULL;
+    DWORD dwRet = S_OK;
+    dwRet = ::CreateStreamOnHGlobal(hGlobal, FALSE, &pStream);
+    if (FAILED(dwRet))
+    {
+        TRACE(_T("ERROR: cBitmap::LoadWithGdiPlus CreateStreamOnHGlobal returned %d\n"), dwRet);
+        GlobalFree(hGlobal);
+        hGlobal = NULL;
+        return dwRet;
+    }
+
+    // Use GDI+ to generate a bitmap
+    m_pGdiPlusBitmap = Gdiplus::Bitmap::FromStream(pStream);
+    if (!m_pGdiPlusBitmap)
+    {
+        TRACE(_T("ERROR: cBitmap::LoadWithGdiPlus Gdiplus::Bitmap::FromStream failed\n"));
+
+        pStream->Release();
+        GlobalFree(hGlobal);
+        hGlobal = NULL;
+
+        return E_FAIL;
+    }
+
+    // Get the bitmap handle
+    HBITMAP hBitmap = NULL;
+    Gdiplus::Status status = m_pGdiPlusBitmap->GetHBITMAP(RGB(0,0,0), &hBitmap);
+    if (Gdiplus::Ok != status)
+    {
+        TRACE(_T("ERROR: cBitmap::LoadWithGdiPlus Gdiplus::Bitmap::GetHBITMAP failed\n"));
+        delete m_pGdiPlusBitmap;
+        m_pGdiPlusBitmap = NULL;
+
+        pStream->Release();
+        GlobalFree(hGlobal);
+        hGlobal = NULL;
+
+        return E_FAIL;
+    }
+
+    // Get the bitmap dimensions
+    BITMAP bmpInfo;
+    ZeroMemory(&bmpInfo, sizeof(bmpInfo));
+    ::GetObject(hBitmap, sizeof(BITMAP), &bmpInfo);
+
+    m_nWidth = bmpInfo.bmWidth;
+    m_nHeight = bmpInfo.bmHeight;
+
+    m_hBM = hBitmap;
+
+    // We don't need the global memory block anymore
+    pStream->Release();
+    GlobalFree(hGlobal);
+    hGlobal = NULL;
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// cBitmap::GetWidth
+//
+//************************************************************************
+
+int cBitmap::GetWidth(void)
+{
+    return m_nWidth;
+}
+
+
+//************************************************************************
+//
+// cBitmap::GetHeight
+//
+//************************************************************************
+
+int cBitmap::GetHeight(void)
+{
+    return m_nHeight;
+}
+
+
+//************************************************************************
+//
+// cBitmap::GetHBITMAP
+//
+//************************************************************************
+
+HBITMAP cBitmap::GetHBITMAP(void)
+{
+    return m_hBM;
+}
+
+
+//** end of Bitmap.cpp ***************************************************
+
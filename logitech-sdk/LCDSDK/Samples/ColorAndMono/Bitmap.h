@@ -1,42 +1,53 @@
-//************************************************************************
-//
-// Bitmap.h
-//
-//************************************************************************
-
-#ifndef _BITMAP_H_INCLUDED_ 
-#define _BITMAP_H_INCLUDED_ 
-
-#include <GdiPlus.h>
-
-class cBitmap
-{
-public:
-    cBitmap(void);
-    virtual ~cBitmap(void);
-
-    void Shutdown(void);
-    void Detach(void);
-
-    HRESULT LoadFromResource(HDC hDC, HINSTANCE hInstance, UINT nResourceID, LPCTSTR sResourceType);
-    HRESULT LoadFromFile(HDC hDC, LPCTSTR sFilename);
-    HRESULT LoadFromMemory(HDC hDC, LPVOID pBuffer, size_t nBufferSize);
-
-    int GetWidth(void);
-    int GetHeight(void);
-
-    HBITMAP GetHBITMAP(void);
-
-    BOOL IsValid() { return NULL != m_pGdiPlusBitmap; }
-
-private:
-    Gdiplus::Bitmap* m_pGdiPlusBitmap;
-    HBITMAP m_hBM;
-    int m_nWidth;
-    int m_nHeight;
-};
-
-
-#endif // !_BITMAP_H_INCLUDED_ 
-
-//** end of Bitmap.h *****************************************************
+//************************************************************************
+//
+// Bitmap.h
+//
+//************************************************************************
+
+#ifndef _BITMAP_H_INCLUDED_ 
+#define _BITMAP_H_INCLUDED_ 
+
+#include <GdiPlus.h>
+
+class cBitmap
+{
+public:
+    cBitmap(void);
+    virtual ~cBitmap(void);
+
+    void Shutdown(void);
+    void Detach(void);
+
+    HRESULT LoadFromResource(HDC hDC, HINSTANCE hInstance, UINT nResourceID, LPCTSTR sResourceType);
+    HRESULT LoadFromFile(HDC hDC, LPCTSTR sFilename);
+    HRESULT LoadFromMemory(HDC hDC, LPVOID pBuffer, size_t nBufferSize);
+
+    // Loads several resources, decoded in parallel
+    static HRESULT LoadFromResources(HINSTANCE hInstance, LPCTSTR sResourceType,
+                                     const UINT *pResourceIDs, cBitmap **ppBitmaps, int nCount);
+
+    int GetWidth(void);
+    int GetHeight(void);
+
+    HBITMAP GetHBITMAP(void);
+
+    BOOL IsValid() { return NULL != m_hBM; }
+
+private:
+    static const BYTE *FindResourceData(HINSTANCE hInstance, UINT nResourceID,
+                                        LPCTSTR sResourceType, DWORD &dwSize);
+    HRESULT CreateTarget(const BYTE *pData, size_t nSize, PBYTE &pBits);
+    HRESULT LoadWithGdiPlus(LPVOID pBuffer, size_t nBufferSize);
+
+private:
+    // only for the formats CLCDImageDecoder does not read
+    Gdiplus::Bitmap* m_pGdiPlusBitmap;
+    HBITMAP m_hBM;
+    int m_nWidth;
+    int m_nHeight;
+};
+
+
+#endif // !_BITMAP_H_INCLUDED_ 
+
+//** end of Bitmap.h *****************************************************
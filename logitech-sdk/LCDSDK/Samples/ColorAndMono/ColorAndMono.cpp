@@ -1,131 +1,131 @@
-// ColorAndMono.cpp : Defines the class behaviors for the application.
-//
-
-#include "stdafx.h"
-#include "ColorAndMono.h"
-#include "ColorAndMonoDlg.h"
-
-#ifdef _DEBUG
-#define new DEBUG_NEW
-#endif
-
-#define LCDSAMPLE_MUTEXNAME               _T("LCDSample_Mutex_1_0")
-
-// CColorAndMonoApp
-
-BEGIN_MESSAGE_MAP(CColorAndMonoApp, CWinApp)
-    ON_COMMAND(ID_HELP, &CWinApp::OnHelp)
-END_MESSAGE_MAP()
-
-
-// CColorAndMonoApp construction
-
-CColorAndMonoApp::CColorAndMonoApp()
-{
-    // TODO: add construction code here,
-    // Place all significant initialization in InitInstance
-    m_hMutex = NULL;
-    m_gdiplusToken = NULL;
-}
-
-
-// The one and only CColorAndMonoApp object
-
-CColorAndMonoApp theApp;
-
-
-// CColorAndMonoApp initialization
-
-BOOL CColorAndMonoApp::InitInstance()
-{
-    // InitCommonControlsEx() is required on Windows XP if an application
-    // manifest specifies use of ComCtl32.dll version 6 or later to enable
-    // visual styles.  Otherwise, any window creation will fail.
-    INITCOMMONCONTROLSEX InitCtrls;
-    InitCtrls.dwSize = sizeof(InitCtrls);
-    // Set this to include all the common control classes you want to use
-    // in your application.
-    InitCtrls.dwICC = ICC_WIN95_CLASSES;
-    InitCommonControlsEx(&InitCtrls);
-
-    // Initialize GDI+
-    Gdiplus::GdiplusStartupInput gdiplusStartupInput;
-    GdiplusStartup(&m_gdiplusToken, &gdiplusStartupInput, NULL);
-
-    CWinApp::InitInstance();
-
-    // Standard initialization
-    // If you are not using these features and wish to reduce the size
-    // of your final executable, you should remove from the following
-    // the specific initialization routines you do not need
-    // Change the registry key under which our settings are stored
-    // TODO: You should modify this string to be something appropriate
-    // such as the name of your company or organization
-    SetRegistryKey(_T("Local AppWizard-Generated Applications"));
-
-    m_hMutex = ClaimMutex(LCDSAMPLE_MUTEXNAME, NULL);
-    if(NULL == m_hMutex)
-    {
-        return FALSE;
-    }
-
-    CColorAndMonoDlg dlg;
-    m_pMainWnd = &dlg;
-    INT_PTR nResponse = dlg.DoModal();
-    if (nResponse == IDOK)
-    {
-        // TODO: Place code here to handle when the dialog is
-        //  dismissed with OK
-    }
-    else if (nResponse == IDCANCEL)
-    {
-        // TODO: Place code here to handle when the dialog is
-        //  dismissed with Cancel
-    }
-
-    // Since the dialog has been closed, return FALSE so that we exit the
-    //  application, rather than start the application's message pump.
-    return FALSE;
-}
-
-INT CColorAndMonoApp::ExitInstance() 
-{
-    if(NULL != m_hMutex)
-    {
-        ReleaseMutex(m_hMutex);
-        CloseHandle(m_hMutex);
-        m_hMutex = NULL;
-    }
-    
-    Gdiplus::GdiplusShutdown(m_gdiplusToken);
-
-    return CWinApp::ExitInstance();
-}
-
-HANDLE CColorAndMonoApp::ClaimMutex(LPCTSTR szMutex, LPCTSTR szWndClassName)
-{
-    // attempt to claim the mutex
-    HANDLE hMutex = CreateMutex(NULL, TRUE, szMutex);
-    if (ERROR_ALREADY_EXISTS == GetLastError())
-    {
-        if (hMutex)
-        {
-            CloseHandle(hMutex);
-            hMutex = NULL;
-        }
-
-        // bring the existing wnd to the foreground
-        if (szWndClassName)
-        {
-            HWND hExistingWnd = FindWindow(szWndClassName, NULL);
-            if (hExistingWnd)
-            {
-                ShowWindow(hExistingWnd, SW_RESTORE);
-                SetForegroundWindow(hExistingWnd);
-            }
-        }
-        return NULL;
-    }
-
-    return hMutex;
-}
+// ColorAndMono.cpp : Defines the class behaviors for the application.
+//
+
+#include "stdafx.h"
+#include "ColorAndMono.h"
+#include "ColorAndMonoDlg.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+#define LCDSAMPLE_MUTEXNAME               _T("LCDSample_Mutex_1_0")
+
+// CColorAndMonoApp
+
+BEGIN_MESSAGE_MAP(CColorAndMonoApp, CWinApp)
+    ON_COMMAND(ID_HELP, &CWinApp::OnHelp)
+END_MESSAGE_MAP()
+
+
+// CColorAndMonoApp construction
+
+CColorAndMonoApp::CColorAndMonoApp()
+{
+    // TODO: add construction code here,
+    // Place all significant initialization in InitInstance
+    m_hMutex = NULL;
+    m_gdiplusToken = NULL;
+}
+
+
+// The one and only CColorAndMonoApp object
+
+CColorAndMonoApp theApp;
+
+
+// CColorAndMonoApp initialization
+
+BOOL CColorAndMonoApp::InitInstance()
+{
+    // InitCommonControlsEx() is required on Windows XP if an application
+    // manifest specifies use of ComCtl32.dll version 6 or later to enable
+    // visual styles.  Otherwise, any window creation will fail.
+    INITCOMMONCONTROLSEX InitCtrls;
+    InitCtrls.dwSize = sizeof(InitCtrls);
+    // Set this to include all the common control classes you want to use
+    // in your application.
+    InitCtrls.dwICC = ICC_WIN95_CLASSES;
+    InitCommonControlsEx(&InitCtrls);
+
+    // Initialize GDI+
+    Gdiplus::GdiplusStartupInput gdiplusStartupInput;
+    GdiplusStartup(&m_gdiplusToken, &gdiplusStartupInput, NULL);
+
+    CWinApp::InitInstance();
+
+    // Standard initialization
+    // If you are not using these features and wish to reduce the size
+    // of your final executable, you should remove from the following
+    // the specific initialization routines you do not need
+    // Change the registry key under which our settings are stored
+    // TODO: You should modify this string to be something appropriate
+    // such as the name of your company or organization
+    SetRegistryKey(_T("Local AppWizard-Generated Applications"));
+
+    m_hMutex = ClaimMutex(LCDSAMPLE_MUTEXNAME, NULL);
+    if(NULL == m_hMutex)
+    {
+        return FALSE;
+    }
+
+    CColorAndMonoDlg dlg;
+    m_pMainWnd = &dlg;
+    INT_PTR nResponse = dlg.DoModal();
+    if (nResponse == IDOK)
+    {
+        // TODO: Place code here to handle when the dialog is
+        //  dismissed with OK
+    }
+    else if (nResponse == IDCANCEL)
+    {
+        // TODO: Place code here to handle when the dialog is
+        //  dismissed with Cancel
+    }
+
+    // Since the dialog has been closed, return FALSE so that we exit the
+    //  application, rather than start the application's message pump.
+    return FALSE;
+}
+
+INT CColorAndMonoApp::ExitInstance() 
+{
+    if(NULL != m_hMutex)
+    {
+        ReleaseMutex(m_hMutex);
+        CloseHandle(m_hMutex);
+        m_hMutex = NULL;
+    }
+    
+    Gdiplus::GdiplusShutdown(m_gdiplusToken);
+
+    return CWinApp::ExitInstance();
+}
+
+HANDLE CColorAndMonoApp::ClaimMutex(LPCTSTR szMutex, LPCTSTR szWndClassName)
+{
+    // attempt to claim the mutex
+    HANDLE hMutex = CreateMutex(NULL, TRUE, szMutex);
+    if (ERROR_ALREADY_EXISTS == GetLastError())
+    {
+        if (hMutex)
+        {
+            CloseHandle(hMutex);
+            hMutex = NULL;
+        }
+
+        // bring the existing wnd to the foreground
+        if (szWndClassName)
+        {
+            HWND hExistingWnd = FindWindow(szWndClassName, NULL);
+            if (hExistingWnd)
+            {
+                ShowWindow(hExistingWnd, SW_RESTORE);
+                SetForegroundWindow(hExistingWnd);
+            }
+        }
+        return NULL;
+    }
+
+    return hMutex;
+}
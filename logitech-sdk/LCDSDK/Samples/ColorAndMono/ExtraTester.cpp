@@ -1,284 +1,2522 @@
-#include "stdafx.h"
-
-#include "ExtraTester.h"
-
-VOID ExtraTester::DoButtonTestingMono(CEzLcd &lcd)
-{
-    if (lcd.ButtonTriggered(LG_BUTTON_1))
-    {
-        TRACE(_T("LG_BUTTON_1 triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_2))
-    {
-        TRACE(_T("LG_BUTTON_2 triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_3))
-    {
-        TRACE(_T("LG_BUTTON_3 triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_4))
-    {
-        TRACE(_T("LG_BUTTON_4 triggered\n"));
-    }
-
-    if (lcd.ButtonIsPressed(LG_BUTTON_1))
-    {
-        TRACE(_T("LG_BUTTON_1 is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_2))
-    {
-        TRACE(_T("LG_BUTTON_2 is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_3))
-    {
-        TRACE(_T("LG_BUTTON_3 is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_4))
-    {
-        TRACE(_T("LG_BUTTON_4 is pressed\n"));
-    }
-
-    if (lcd.ButtonReleased(LG_BUTTON_1))
-    {
-        TRACE(_T("LG_BUTTON_1 released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_2))
-    {
-        TRACE(_T("LG_BUTTON_2 released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_3))
-    {
-        TRACE(_T("LG_BUTTON_3 released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_4))
-    {
-        TRACE(_T("LG_BUTTON_4 released\n"));
-    }
-}
-
-VOID ExtraTester::DoButtonTestingColor(CEzLcd &lcd)
-{
-    if (lcd.ButtonTriggered(LG_BUTTON_LEFT))
-    {
-        TRACE(_T("LG_BUTTON_LEFT triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_RIGHT))
-    {
-        TRACE(_T("LG_BUTTON_RIGHT triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_UP))
-    {
-        TRACE(_T("LG_BUTTON_UP triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_DOWN))
-    {
-        TRACE(_T("LG_BUTTON_DOWN triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_OK))
-    {
-        TRACE(_T("LG_BUTTON_OK triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_CANCEL))
-    {
-        TRACE(_T("LG_BUTTON_CANCEL triggered\n"));
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_MENU))
-    {
-        TRACE(_T("LG_BUTTON_MENU triggered\n"));
-    }
-
-    if (lcd.ButtonIsPressed(LG_BUTTON_LEFT))
-    {
-        TRACE(_T("LG_BUTTON_LEFT is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_RIGHT))
-    {
-        TRACE(_T("LG_BUTTON_RIGHT is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_UP))
-    {
-        TRACE(_T("LG_BUTTON_UP is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_DOWN))
-    {
-        TRACE(_T("LG_BUTTON_DOWN is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_OK))
-    {
-        TRACE(_T("LG_BUTTON_OK is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_CANCEL))
-    {
-        TRACE(_T("LG_BUTTON_CANCEL is pressed\n"));
-    }
-    if (lcd.ButtonIsPressed(LG_BUTTON_MENU))
-    {
-        TRACE(_T("LG_BUTTON_MENU is pressed\n"));
-    }
-
-    if (lcd.ButtonReleased(LG_BUTTON_LEFT))
-    {
-        TRACE(_T("LG_BUTTON_LEFT released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_RIGHT))
-    {
-        TRACE(_T("LG_BUTTON_RIGHT released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_UP))
-    {
-        TRACE(_T("LG_BUTTON_UP released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_DOWN))
-    {
-        TRACE(_T("LG_BUTTON_DOWN released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_OK))
-    {
-        TRACE(_T("LG_BUTTON_OK released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_CANCEL))
-    {
-        TRACE(_T("LG_BUTTON_CANCEL released\n"));
-    }
-    if (lcd.ButtonReleased(LG_BUTTON_MENU))
-    {
-        TRACE(_T("LG_BUTTON_MENU released\n"));
-    }
-}
-
-VOID ExtraTester::DoScreenPriorityTesting(CEzLcd &lcd)
-{
-    static DWORD lastScreenPriority_ = 0xFFFFFFFF;
-
-    DWORD currentScreenPriority_ = lcd.GetScreenPriority();
-
-    switch(currentScreenPriority_)
-    {
-    case LGLCD_PRIORITY_IDLE_NO_SHOW:
-        if (lastScreenPriority_ != currentScreenPriority_)
-        {
-            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_IDLE_NO_SHOW\n"));
-        }
-        break;
-    case LGLCD_PRIORITY_BACKGROUND:
-        if (lastScreenPriority_ != currentScreenPriority_)
-        {
-            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_BACKGROUND\n"));
-        }
-        break;
-    case LGLCD_PRIORITY_NORMAL:
-        if (lastScreenPriority_ != currentScreenPriority_)
-        {
-            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_NORMAL\n"));
-        }
-        break;
-    case LGLCD_PRIORITY_ALERT:
-        if (lastScreenPriority_ != currentScreenPriority_)
-        {
-            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_ALERT\n"));
-        }
-        break;
-    }
-
-    lastScreenPriority_ = currentScreenPriority_;
-
-    if (lcd.ButtonTriggered(LG_BUTTON_LEFT) || lcd.ButtonTriggered(LG_BUTTON_1))
-    {
-        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_IDLE_NO_SHOW\n"));
-        lcd.SetScreenPriority(LGLCD_PRIORITY_IDLE_NO_SHOW);
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_RIGHT) || lcd.ButtonTriggered(LG_BUTTON_2))
-    {
-        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_BACKGROUND\n"));
-        lcd.SetScreenPriority(LGLCD_PRIORITY_BACKGROUND);
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_UP) || lcd.ButtonTriggered(LG_BUTTON_3))
-    {
-        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_NORMAL\n"));
-        lcd.SetScreenPriority(LGLCD_PRIORITY_NORMAL);
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_DOWN) || lcd.ButtonTriggered(LG_BUTTON_4))
-    {
-        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_ALERT\n"));
-        lcd.SetScreenPriority(LGLCD_PRIORITY_ALERT);
-    }
-}
-
-VOID ExtraTester::DoForegroundTesting(CEzLcd &lcd)
-{
-    lcd.ModifyDisplay(LG_MONOCHROME);
-    if (lcd.ButtonTriggered(LG_BUTTON_1))
-    {
-        TRACE(_T("Setting mono foreground to TRUE\n"));
-        lcd.SetAsForeground(TRUE);
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_2))
-    {
-        TRACE(_T("Setting mono foreground to FALSE\n"));
-        lcd.SetAsForeground(FALSE);
-    }
-
-    lcd.ModifyDisplay(LG_COLOR);
-    if (lcd.ButtonTriggered(LG_BUTTON_UP))
-    {
-        TRACE(_T("Setting color foreground to TRUE\n"));
-        lcd.SetAsForeground(TRUE);
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_DOWN))
-    {
-        TRACE(_T("Setting color foreground to FALSE\n"));
-        lcd.SetAsForeground(FALSE);
-    }
-}
-
-VOID ExtraTester::DoVisibleTesting(CEzLcd &lcd, std::vector<HANDLE> handles)
-{
-    if (lcd.ButtonTriggered(LG_BUTTON_1) || lcd.ButtonTriggered(LG_BUTTON_UP))
-    {
-        TRACE(_T("Setting handles to not visible\n"));
-        for (UINT index_ = 0; index_ < handles.size(); index_++)
-        {
-            lcd.SetVisible(handles[index_], FALSE);
-        }
-    }
-
-    if (lcd.ButtonTriggered(LG_BUTTON_2) || lcd.ButtonTriggered(LG_BUTTON_DOWN))
-    {
-        TRACE(_T("Setting handles to visible\n"));
-        for (UINT index_ = 0; index_ < handles.size(); index_++)
-        {
-            lcd.SetVisible(handles[index_], TRUE);
-        }
-    }
-}
-
-VOID ExtraTester::DoPageTesting(CEzLcd &lcd)
-{
-    lcd.ModifyDisplay(LG_MONOCHROME);
-    if (lcd.ButtonTriggered(LG_BUTTON_1))
-    {
-        TRACE(_T("Current mono page count is %d\n"), lcd.GetPageCount());
-        lcd.AddNumberOfPages(3);
-        TRACE(_T("Added 3 pages. New mono page count is %d\n"), lcd.GetPageCount());
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_2))
-    {
-        TRACE(_T("Current mono page count is %d. Removing page %d.\n"), lcd.GetPageCount(), lcd.GetPageCount() - 1);
-        lcd.RemovePage(lcd.GetPageCount() - 1);
-        TRACE(_T("New mono page count is %d\n"), lcd.GetPageCount());
-    }
-
-    lcd.ModifyDisplay(LG_COLOR);
-    if (lcd.ButtonTriggered(LG_BUTTON_UP))
-    {
-        TRACE(_T("Current color page count is %d\n"), lcd.GetPageCount());
-        lcd.AddNumberOfPages(3);
-        TRACE(_T("Added 3 pages. New color page count is %d\n"), lcd.GetPageCount());
-    }
-    if (lcd.ButtonTriggered(LG_BUTTON_DOWN))
-    {
-        TRACE(_T("Current color page count is %d. Removing page %d.\n"), lcd.GetPageCount(), lcd.GetPageCount() - 1);
-        lcd.RemovePage(lcd.GetPageCount() - 1);
-        TRACE(_T("New color page count is %d\n"), lcd.GetPageCount());
-    }
-}
+#include "stdafx.h"
+
+#include "ExtraTester.h"
+#include "LCDUI.h"
+#include "Resource.h"
+
+VOID ExtraTester::DoButtonTestingMono(CEzLcd &lcd)
+{
+    if (lcd.ButtonTriggered(LG_BUTTON_1))
+    {
+        TRACE(_T("LG_BUTTON_1 triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_2))
+    {
+        TRACE(_T("LG_BUTTON_2 triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_3))
+    {
+        TRACE(_T("LG_BUTTON_3 triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_4))
+    {
+        TRACE(_T("LG_BUTTON_4 triggered\n"));
+    }
+
+    if (lcd.ButtonIsPressed(LG_BUTTON_1))
+    {
+        TRACE(_T("LG_BUTTON_1 is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_2))
+    {
+        TRACE(_T("LG_BUTTON_2 is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_3))
+    {
+        TRACE(_T("LG_BUTTON_3 is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_4))
+    {
+        TRACE(_T("LG_BUTTON_4 is pressed\n"));
+    }
+
+    if (lcd.ButtonReleased(LG_BUTTON_1))
+    {
+        TRACE(_T("LG_BUTTON_1 released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_2))
+    {
+        TRACE(_T("LG_BUTTON_2 released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_3))
+    {
+        TRACE(_T("LG_BUTTON_3 released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_4))
+    {
+        TRACE(_T("LG_BUTTON_4 released\n"));
+    }
+}
+
+VOID ExtraTester::DoButtonTestingColor(CEzLcd &lcd)
+{
+    if (lcd.ButtonTriggered(LG_BUTTON_LEFT))
+    {
+        TRACE(_T("LG_BUTTON_LEFT triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_RIGHT))
+    {
+        TRACE(_T("LG_BUTTON_RIGHT triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_UP))
+    {
+        TRACE(_T("LG_BUTTON_UP triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_DOWN))
+    {
+        TRACE(_T("LG_BUTTON_DOWN triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_OK))
+    {
+        TRACE(_T("LG_BUTTON_OK triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_CANCEL))
+    {
+        TRACE(_T("LG_BUTTON_CANCEL triggered\n"));
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_MENU))
+    {
+        TRACE(_T("LG_BUTTON_MENU triggered\n"));
+    }
+
+    if (lcd.ButtonIsPressed(LG_BUTTON_LEFT))
+    {
+        TRACE(_T("LG_BUTTON_LEFT is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_RIGHT))
+    {
+        TRACE(_T("LG_BUTTON_RIGHT is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_UP))
+    {
+        TRACE(_T("LG_BUTTON_UP is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_DOWN))
+    {
+        TRACE(_T("LG_BUTTON_DOWN is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_OK))
+    {
+        TRACE(_T("LG_BUTTON_OK is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_CANCEL))
+    {
+        TRACE(_T("LG_BUTTON_CANCEL is pressed\n"));
+    }
+    if (lcd.ButtonIsPressed(LG_BUTTON_MENU))
+    {
+        TRACE(_T("LG_BUTTON_MENU is pressed\n"));
+    }
+
+    if (lcd.ButtonReleased(LG_BUTTON_LEFT))
+    {
+        TRACE(_T("LG_BUTTON_LEFT released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_RIGHT))
+    {
+        TRACE(_T("LG_BUTTON_RIGHT released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_UP))
+    {
+        TRACE(_T("LG_BUTTON_UP released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_DOWN))
+    {
+        TRACE(_T("LG_BUTTON_DOWN released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_OK))
+    {
+        TRACE(_T("LG_BUTTON_OK released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_CANCEL))
+    {
+        TRACE(_T("LG_BUTTON_CANCEL released\n"));
+    }
+    if (lcd.ButtonReleased(LG_BUTTON_MENU))
+    {
+        TRACE(_T("LG_BUTTON_MENU released\n"));
+    }
+}
+
+VOID ExtraTester::DoScreenPriorityTesting(CEzLcd &lcd)
+{
+    static DWORD lastScreenPriority_ = 0xFFFFFFFF;
+
+    DWORD currentScreenPriority_ = lcd.GetScreenPriority();
+
+    switch(currentScreenPriority_)
+    {
+    case LGLCD_PRIORITY_IDLE_NO_SHOW:
+        if (lastScreenPriority_ != currentScreenPriority_)
+        {
+            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_IDLE_NO_SHOW\n"));
+        }
+        break;
+    case LGLCD_PRIORITY_BACKGROUND:
+        if (lastScreenPriority_ != currentScreenPriority_)
+        {
+            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_BACKGROUND\n"));
+        }
+        break;
+    case LGLCD_PRIORITY_NORMAL:
+        if (lastScreenPriority_ != currentScreenPriority_)
+        {
+            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_NORMAL\n"));
+        }
+        break;
+    case LGLCD_PRIORITY_ALERT:
+        if (lastScreenPriority_ != currentScreenPriority_)
+        {
+            TRACE(_T("Current screenpriority is LGLCD_PRIORITY_ALERT\n"));
+        }
+        break;
+    }
+
+    lastScreenPriority_ = currentScreenPriority_;
+
+    if (lcd.ButtonTriggered(LG_BUTTON_LEFT) || lcd.ButtonTriggered(LG_BUTTON_1))
+    {
+        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_IDLE_NO_SHOW\n"));
+        lcd.SetScreenPriority(LGLCD_PRIORITY_IDLE_NO_SHOW);
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_RIGHT) || lcd.ButtonTriggered(LG_BUTTON_2))
+    {
+        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_BACKGROUND\n"));
+        lcd.SetScreenPriority(LGLCD_PRIORITY_BACKGROUND);
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_UP) || lcd.ButtonTriggered(LG_BUTTON_3))
+    {
+        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_NORMAL\n"));
+        lcd.SetScreenPriority(LGLCD_PRIORITY_NORMAL);
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_DOWN) || lcd.ButtonTriggered(LG_BUTTON_4))
+    {
+        TRACE(_T("Setting screenpriority to LGLCD_PRIORITY_ALERT\n"));
+        lcd.SetScreenPriority(LGLCD_PRIORITY_ALERT);
+    }
+}
+
+VOID ExtraTester::DoForegroundTesting(CEzLcd &lcd)
+{
+    lcd.ModifyDisplay(LG_MONOCHROME);
+    if (lcd.ButtonTriggered(LG_BUTTON_1))
+    {
+        TRACE(_T("Setting mono foreground to TRUE\n"));
+        lcd.SetAsForeground(TRUE);
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_2))
+    {
+        TRACE(_T("Setting mono foreground to FALSE\n"));
+        lcd.SetAsForeground(FALSE);
+    }
+
+    lcd.ModifyDisplay(LG_COLOR);
+    if (lcd.ButtonTriggered(LG_BUTTON_UP))
+    {
+        TRACE(_T("Setting color foreground to TRUE\n"));
+        lcd.SetAsForeground(TRUE);
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_DOWN))
+    {
+        TRACE(_T("Setting color foreground to FALSE\n"));
+        lcd.SetAsForeground(FALSE);
+    }
+}
+
+VOID ExtraTester::DoVisibleTesting(CEzLcd &lcd, std::vector<HANDLE> handles)
+{
+    if (lcd.ButtonTriggered(LG_BUTTON_1) || lcd.ButtonTriggered(LG_BUTTON_UP))
+    {
+        TRACE(_T("Setting handles to not visible\n"));
+        for (UINT index_ = 0; index_ < handles.size(); index_++)
+        {
+            lcd.SetVisible(handles[index_], FALSE);
+        }
+    }
+
+    if (lcd.ButtonTriggered(LG_BUTTON_2) || lcd.ButtonTriggered(LG_BUTTON_DOWN))
+    {
+        TRACE(_T("Setting handles to visible\n"));
+        for (UINT index_ = 0; index_ < handles.size(); index_++)
+        {
+            lcd.SetVisible(handles[index_], TRUE);
+        }
+    }
+}
+
+VOID ExtraTester::DoPageTesting(CEzLcd &lcd)
+{
+    lcd.ModifyDisplay(LG_MONOCHROME);
+    if (lcd.ButtonTriggered(LG_BUTTON_1))
+    {
+        TRACE(_T("Current mono page count is %d\n"), lcd.GetPageCount());
+        lcd.AddNumberOfPages(3);
+        TRACE(_T("Added 3 pages. New mono page count is %d\n"), lcd.GetPageCount());
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_2))
+    {
+        TRACE(_T("Current mono page count is %d. Removing page %d.\n"), lcd.GetPageCount(), lcd.GetPageCount() - 1);
+        lcd.RemovePage(lcd.GetPageCount() - 1);
+        TRACE(_T("New mono page count is %d\n"), lcd.GetPageCount());
+    }
+
+    lcd.ModifyDisplay(LG_COLOR);
+    if (lcd.ButtonTriggered(LG_BUTTON_UP))
+    {
+        TRACE(_T("Current color page count is %d\n"), lcd.GetPageCount());
+        lcd.AddNumberOfPages(3);
+        TRACE(_T("Added 3 pages. New color page count is %d\n"), lcd.GetPageCount());
+    }
+    if (lcd.ButtonTriggered(LG_BUTTON_DOWN))
+    {
+        TRACE(_T("Current color page count is %d. Removing page %d.\n"), lcd.GetPageCount(), lcd.GetPageCount() - 1);
+        lcd.RemovePage(lcd.GetPageCount() - 1);
+        TRACE(_T("New color page count is %d\n"), lcd.GetPageCount());
+    }
+}
+
+VOID ExtraTester::DoRenderBenchmark(INT frames)
+{
+    // Same kind of layout as the sample pages: background, a title, some
+    // body text and a progress bar. Each layout is rendered through the
+    // GDI surface and through the software surface.
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        BOOL color_ = (0 == pass_);
+        INT width_ = color_ ? LGLCD_QVGA_BMP_WIDTH : LGLCD_BW_BMP_WIDTH;
+        INT height_ = color_ ? LGLCD_QVGA_BMP_HEIGHT : LGLCD_BW_BMP_HEIGHT;
+
+        CLCDPage page_;
+        page_.SetSize(width_, height_);
+        page_.SetBackground(color_ ? RGB(0, 0, 64) : RGB(0, 0, 0));
+
+        CLCDText title_;
+        title_.SetOrigin(0, 0);
+        title_.SetSize(width_, height_ / 4);
+        title_.SetAlignment(DT_CENTER);
+        title_.SetText(_T("Render benchmark"));
+        page_.AddObject(&title_);
+
+        CLCDText body_;
+        body_.SetOrigin(0, height_ / 4);
+        body_.SetSize(width_, height_ / 2);
+        body_.SetWordWrap(TRUE);
+        body_.SetText(_T("The quick brown fox jumps over the lazy dog.\nPack my box with five dozen liquor jugs."));
+        page_.AddObject(&body_);
+
+        CLCDProgressBar monoBar_;
+        CLCDColorProgressBar colorBar_;
+        CLCDProgressBar &progressBar_ = color_ ? colorBar_ : monoBar_;
+        progressBar_.Initialize();
+        progressBar_.SetOrigin(4, height_ - height_ / 6);
+        progressBar_.SetSize(width_ - 8, height_ / 8);
+        page_.AddObject(&progressBar_);
+
+        CLCDGfxColor gfxColor_;
+        CLCDGfxMono gfxMono_;
+        CLCDGfxBase &gfx_ = color_ ? (CLCDGfxBase &)gfxColor_ : (CLCDGfxBase &)gfxMono_;
+        CLCDGfxSoft gfxSoft_(color_ ? 32 : 8);
+
+        if (FAILED(gfx_.Initialize()) || FAILED(gfxSoft_.Initialize()))
+        {
+            TRACE(_T("Render benchmark: failed to initialize surfaces\n"));
+            return;
+        }
+
+        DOUBLE gdiFps_ = MeasureFramesPerSecond(gfx_, page_, progressBar_, frames);
+        DOUBLE softFps_ = MeasureFramesPerSecond(gfxSoft_, page_, progressBar_, frames);
+
+        TRACE(_T("Render benchmark (%s, %d frames): GDI %.1f fps, software %.1f fps\n"),
+            color_ ? _T("color") : _T("mono"), frames, gdiFps_, softFps_);
+
+        if (!color_)
+        {
+            // packed 1bpp surface, expanded to the 8bpp layout at submit
+            CLCDGfxSoft gfxPacked_(1);
+            if (SUCCEEDED(gfxPacked_.Initialize()))
+            {
+                DOUBLE packedFps_ = MeasureFramesPerSecond(gfxPacked_, page_, progressBar_, frames);
+                TRACE(_T("Render benchmark (mono, %d frames): packed 1bpp %.1f fps\n"),
+                    frames, packedFps_);
+            }
+        }
+    }
+}
+
+VOID ExtraTester::DoSoftSurfaceTest(VOID)
+{
+    // The raster core drawing into a plain buffer, as it would without
+    // Windows, must give the same pixels as CLCDGfxSoft, which adds the
+    // vector blending of CLCDCompositor
+    const WORD bitCounts_[3] = { 32, 8, 1 };
+    for (INT pass_ = 0; pass_ < 3; pass_++)
+    {
+        CLCDGfxSoft gfx_(bitCounts_[pass_]);
+        if (FAILED(gfx_.Initialize()))
+        {
+            TRACE(_T("Soft surface test: failed to initialize\n"));
+            return;
+        }
+
+        std::vector<BYTE> bits_((size_t)gfx_.GetPitch() * gfx_.GetHeight(), 0);
+        CLCDSoftSurface core_;
+        core_.Attach(&bits_[0], gfx_.GetWidth(), gfx_.GetHeight(), gfx_.GetPitch(), gfx_.GetBitCount());
+        core_.SetClipRect(NULL);
+
+        // a translucent premultiplied gradient
+        const INT spriteSize_ = 24;
+        std::vector<BYTE> sprite_(spriteSize_ * spriteSize_ * 4);
+        for (INT pixel_ = 0; pixel_ < spriteSize_ * spriteSize_; pixel_++)
+        {
+            BYTE alpha_ = (BYTE)(pixel_ * 255 / (spriteSize_ * spriteSize_));
+            sprite_[pixel_ * 4 + 0] = (BYTE)(alpha_ / 2);
+            sprite_[pixel_ * 4 + 1] = alpha_;
+            sprite_[pixel_ * 4 + 2] = (BYTE)(alpha_ / 3);
+            sprite_[pixel_ * 4 + 3] = alpha_;
+        }
+
+        RECT fill_ = { 2, 2, 60, 30 };
+        LCDSOFTRECT softFill_ = { 2, 2, 60, 30 };
+        RECT clip_ = { 10, 0, 120, 40 };
+        LCDSOFTRECT softClip_ = { 10, 0, 120, 40 };
+
+        gfx_.BeginDraw();
+        gfx_.ClearScreen();
+        gfx_.FillRect(fill_, RGB(200, 80, 40));
+        gfx_.SetClipRect(&clip_);
+        gfx_.SetOrigin(5, 3);
+        gfx_.Blit(20, 4, spriteSize_, spriteSize_, &sprite_[0], spriteSize_ * 4, TRUE);
+        gfx_.DrawText(0, 20, _T("Soft 42%"), 8, RGB(255, 255, 255));
+        gfx_.InvertRect(fill_);
+        gfx_.EndDraw();
+
+        core_.FillRect(softFill_, LCDSOFT_RGB(200, 80, 40));
+        core_.SetClipRect(&softClip_);
+        core_.SetOrigin(5, 3);
+        core_.Blit(20, 4, spriteSize_, spriteSize_, &sprite_[0], spriteSize_ * 4, true);
+        core_.DrawText(0, 20, "Soft 42%", 8, LCDSOFT_RGB(255, 255, 255));
+        core_.InvertRect(softFill_);
+
+        const BYTE *gfxBits_ = gfx_.GetBits();
+        INT differ_ = 0;
+        BOOL drawn_ = FALSE;
+        for (size_t index_ = 0; index_ < bits_.size(); index_++)
+        {
+            differ_ += (gfxBits_[index_] != bits_[index_]) ? 1 : 0;
+            drawn_ = drawn_ || (0 != bits_[index_]);
+        }
+
+        TRACE(_T("Soft surface test (%d bpp): %d bytes differ: %s\n"),
+            bitCounts_[pass_], differ_, (drawn_ && (0 == differ_)) ? _T("passed") : _T("FAILED"));
+    }
+}
+
+VOID ExtraTester::DoDitherBenchmark(INT frames)
+{
+    // A full color frame with gradients, dithered down the way a bitmap
+    // is when it is assigned to a monochrome page
+    INT width_ = LGLCD_QVGA_BMP_WIDTH;
+    INT height_ = LGLCD_QVGA_BMP_HEIGHT;
+    std::vector<BYTE> pixels_(width_ * height_ * 4);
+    for (INT y_ = 0; y_ < height_; y_++)
+    {
+        for (INT x_ = 0; x_ < width_; x_++)
+        {
+            BYTE *pixel_ = &pixels_[(y_ * width_ + x_) * 4];
+            pixel_[0] = (BYTE)(x_ * 255 / width_);
+            pixel_[1] = (BYTE)(y_ * 255 / height_);
+            pixel_[2] = (BYTE)((x_ + y_) & 0xFF);
+            pixel_[3] = 0xFF;
+        }
+    }
+
+    INT pitch_ = CLCDDither::GetPackedPitch(width_);
+    std::vector<BYTE> packed_(pitch_ * height_);
+
+    static const CLCDDither::eDITHER_MODE modes_[] =
+        { CLCDDither::DITHER_THRESHOLD, CLCDDither::DITHER_ORDERED, CLCDDither::DITHER_DIFFUSION };
+    static const LPCTSTR names_[] = { _T("threshold"), _T("ordered"), _T("diffusion") };
+
+    LARGE_INTEGER frequency_;
+    QueryPerformanceFrequency(&frequency_);
+
+    for (INT mode_ = 0; mode_ < 3; mode_++)
+    {
+        LARGE_INTEGER start_, stop_;
+        QueryPerformanceCounter(&start_);
+
+        for (INT frame_ = 0; frame_ < frames; frame_++)
+        {
+            CLCDDither::Dither(&pixels_[0], width_ * 4, width_, height_,
+                &packed_[0], pitch_, modes_[mode_]);
+        }
+
+        QueryPerformanceCounter(&stop_);
+
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        TRACE(_T("Dither benchmark (%s, %d frames of %dx%d): %.1f fps\n"),
+            names_[mode_], frames, width_, height_, (seconds_ > 0.0) ? frames / seconds_ : 0.0);
+    }
+}
+
+VOID ExtraTester::DoCompositeBenchmark(INT frames)
+{
+    // A full screen, half transparent background, blended the way the
+    // controls used to (a new DC and AlphaBlend each time) and through
+    // the compositor, once with per pixel and once with constant alpha
+    INT width_ = LGLCD_QVGA_BMP_WIDTH;
+    INT height_ = LGLCD_QVGA_BMP_HEIGHT;
+
+    BITMAPINFO info_;
+    ZeroMemory(&info_, sizeof(info_));
+    info_.bmiHeader.biSize = sizeof(info_.bmiHeader);
+    info_.bmiHeader.biWidth = width_;
+    info_.bmiHeader.biHeight = -height_;
+    info_.bmiHeader.biPlanes = 1;
+    info_.bmiHeader.biBitCount = 32;
+    info_.bmiHeader.biCompression = BI_RGB;
+
+    BYTE *bits_ = NULL;
+    HBITMAP bitmap_ = CreateDIBSection(NULL, &info_, DIB_RGB_COLORS, (VOID **)&bits_, NULL, 0);
+    if (NULL == bitmap_ || NULL == bits_)
+    {
+        TRACE(_T("Composite benchmark: failed to create bitmap\n"));
+        return;
+    }
+
+    for (INT y_ = 0; y_ < height_; y_++)
+    {
+        for (INT x_ = 0; x_ < width_; x_++)
+        {
+            BYTE *pixel_ = &bits_[(y_ * width_ + x_) * 4];
+            BYTE alpha_ = (BYTE)(x_ * 255 / (width_ - 1));
+            pixel_[0] = (BYTE)(alpha_ * 200 / 255);
+            pixel_[1] = (BYTE)(alpha_ * (y_ * 255 / height_) / 255);
+            pixel_[2] = (BYTE)(alpha_ / 2);
+            pixel_[3] = alpha_;
+        }
+    }
+    GdiFlush();
+
+    CLCDImage image_;
+    CLCDGfxColor gfx_;
+    if (FAILED(image_.SetBitmap(bitmap_)) || FAILED(gfx_.Initialize()))
+    {
+        TRACE(_T("Composite benchmark: failed to initialize\n"));
+        DeleteObject(bitmap_);
+        return;
+    }
+
+    RECT screen_ = { 0, 0, width_, height_ };
+    LARGE_INTEGER frequency_;
+    QueryPerformanceFrequency(&frequency_);
+
+    for (INT pass_ = 0; pass_ < 4; pass_++)
+    {
+        BOOL compositor_ = (0 != (pass_ & 1));
+        BOOL perPixel_ = (0 == (pass_ & 2));
+        BYTE alpha_ = perPixel_ ? 255 : 128;
+
+        gfx_.BeginDraw();
+        gfx_.ClearScreen();
+
+        LARGE_INTEGER start_, stop_;
+        QueryPerformanceCounter(&start_);
+
+        for (INT frame_ = 0; frame_ < frames; frame_++)
+        {
+            if (compositor_)
+            {
+                gfx_.DrawImage(screen_, image_, NULL, alpha_, perPixel_);
+            }
+            else
+            {
+                HDC dc_ = CreateCompatibleDC(gfx_.GetHDC());
+                HBITMAP old_ = (HBITMAP)SelectObject(dc_, bitmap_);
+                BLENDFUNCTION blend_ = { AC_SRC_OVER, 0, alpha_, (BYTE)(perPixel_ ? AC_SRC_ALPHA : 0) };
+                AlphaBlend(gfx_.GetHDC(), 0, 0, width_, height_, dc_, 0, 0, width_, height_, blend_);
+                SelectObject(dc_, old_);
+                DeleteDC(dc_);
+            }
+        }
+        GdiFlush();
+
+        QueryPerformanceCounter(&stop_);
+        gfx_.EndDraw();
+
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        TRACE(_T("Composite benchmark (%s alpha, %d frames of %dx%d): %s %.1f fps\n"),
+            perPixel_ ? _T("per pixel") : _T("constant"), frames, width_, height_,
+            compositor_ ? _T("compositor") : _T("GDI"), (seconds_ > 0.0) ? frames / seconds_ : 0.0);
+    }
+
+    gfx_.Shutdown();
+    DeleteObject(bitmap_);
+}
+
+VOID ExtraTester::DoNestedClipTest(VOID)
+{
+    // A label wider than the collection it is in must be cut off at the
+    // edge of the collection, on the GDI and on the software surface
+    INT width_ = LGLCD_QVGA_BMP_WIDTH;
+    INT height_ = LGLCD_QVGA_BMP_HEIGHT;
+    RECT box_ = { width_ / 4, height_ / 4, width_ / 2, height_ / 2 };
+
+    CLCDPage page_;
+    page_.SetSize(width_, height_);
+    page_.SetBackground(RGB(0, 0, 0));
+
+    CLCDCollection nested_;
+    nested_.SetOrigin(box_.left, box_.top);
+    nested_.SetSize(box_.right - box_.left, box_.bottom - box_.top);
+    page_.AddObject(&nested_);
+
+    CLCDText label_;
+    label_.SetSize(width_, box_.bottom - box_.top);
+    label_.SetFontPointSize(16);
+    label_.SetText(_T("WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW"));
+    nested_.AddObject(&label_);
+
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        BOOL soft_ = (1 == pass_);
+        CLCDGfxColor gfxColor_;
+        CLCDGfxSoft gfxSoft_(32);
+        CLCDGfxBase &gfx_ = soft_ ? (CLCDGfxBase &)gfxSoft_ : (CLCDGfxBase &)gfxColor_;
+        if (FAILED(gfx_.Initialize()))
+        {
+            TRACE(_T("Nested clip test: failed to initialize\n"));
+            return;
+        }
+
+        RenderFrame(gfx_, page_);
+        std::vector<BYTE> frame_;
+        CopyFrame(gfx_, frame_);
+
+        // count lit pixels inside and outside of the collection
+        INT pitch_ = gfx_.GetPitch();
+        INT inside_ = 0;
+        INT outside_ = 0;
+        for (INT y_ = 0; y_ < height_; y_++)
+        {
+            for (INT x_ = 0; x_ < width_; x_++)
+            {
+                const BYTE *pixel_ = &frame_[(size_t)y_ * pitch_ + x_ * 4];
+                if (0 == (pixel_[0] | pixel_[1] | pixel_[2]))
+                {
+                    continue;
+                }
+                POINT pt_ = { x_, y_ };
+                if (PtInRect(&box_, pt_))
+                {
+                    inside_++;
+                }
+                else
+                {
+                    outside_++;
+                }
+            }
+        }
+
+        TRACE(_T("Nested clip test (%s): %d pixels inside, %d outside of the collection: %s\n"),
+            soft_ ? _T("software") : _T("GDI"), inside_, outside_,
+            ((0 < inside_) && (0 == outside_)) ? _T("passed") : _T("FAILED"));
+
+        gfx_.Shutdown();
+    }
+}
+
+VOID ExtraTester::DoTileBenchmark(INT frames)
+{
+    // A busy color page: a grid of labels, a column of progress bars, a
+    // half transparent bitmap and a nested collection with a scrolling
+    // label. Each frame is drawn on one thread and then in tiles, and
+    // the two must match.
+    CLCDVirtualClock clock_;
+    CLCDClock::SetInstance(&clock_);
+
+    {
+        INT width_ = LGLCD_QVGA_BMP_WIDTH;
+        INT height_ = LGLCD_QVGA_BMP_HEIGHT;
+        const INT columns_ = 3;
+        const INT rows_ = 8;
+        const INT bars_ = 4;
+        INT gridHeight_ = height_ * 3 / 4;
+
+        CLCDPage page_;
+        page_.SetSize(width_, height_);
+        page_.SetBackground(RGB(0, 0, 64));
+
+        CLCDText labels_[columns_ * rows_];
+        for (INT index_ = 0; index_ < columns_ * rows_; index_++)
+        {
+            TCHAR text_[32];
+            wsprintf(text_, _T("Label %d"), index_);
+            labels_[index_].SetOrigin((index_ % columns_) * (width_ / 2 / columns_), (index_ / columns_) * (gridHeight_ / rows_));
+            labels_[index_].SetSize(width_ / 2 / columns_, gridHeight_ / rows_);
+            labels_[index_].SetFontPointSize(8);
+            labels_[index_].SetText(text_);
+            page_.AddObject(&labels_[index_]);
+        }
+
+        CLCDColorProgressBar progressBars_[bars_];
+        for (INT index_ = 0; index_ < bars_; index_++)
+        {
+            progressBars_[index_].Initialize();
+            progressBars_[index_].SetOrigin(width_ / 2 + 8, 8 + index_ * (gridHeight_ / bars_));
+            progressBars_[index_].SetSize(width_ / 2 - 16, gridHeight_ / bars_ - 16);
+            page_.AddObject(&progressBars_[index_]);
+        }
+
+        // over the bars and the labels, across several tiles
+        INT bitmapWidth_ = width_ / 2;
+        INT bitmapHeight_ = gridHeight_ / 2;
+        BYTE *bits_ = NULL;
+        HBITMAP bitmap_ = CreateBitmap32(bitmapWidth_, bitmapHeight_, &bits_);
+        if (NULL == bitmap_)
+        {
+            TRACE(_T("Tile benchmark: failed to create bitmap\n"));
+            CLCDClock::SetInstance(NULL);
+            return;
+        }
+        for (INT y_ = 0; y_ < bitmapHeight_; y_++)
+        {
+            for (INT x_ = 0; x_ < bitmapWidth_; x_++)
+            {
+                BYTE *pixel_ = &bits_[(y_ * bitmapWidth_ + x_) * 4];
+                BYTE alpha_ = (BYTE)(x_ * 255 / (bitmapWidth_ - 1));
+                pixel_[0] = (BYTE)(alpha_ * (y_ * 255 / bitmapHeight_) / 255);
+                pixel_[1] = (BYTE)(alpha_ / 2);
+                pixel_[2] = alpha_;
+                pixel_[3] = alpha_;
+            }
+        }
+        GdiFlush();
+
+        CLCDBitmap picture_;
+        picture_.SetBitmap(bitmap_);
+        picture_.SetOrigin(width_ / 4, gridHeight_ / 4);
+        picture_.SetSize(bitmapWidth_, bitmapHeight_);
+        page_.AddObject(&picture_);
+
+        CLCDCollection footer_;
+        footer_.SetOrigin(0, gridHeight_);
+        footer_.SetSize(width_, height_ - gridHeight_);
+        page_.AddObject(&footer_);
+
+        CLCDText caption_;
+        caption_.SetSize(width_, (height_ - gridHeight_) / 2);
+        caption_.SetAlignment(DT_CENTER);
+        caption_.SetText(_T("Nested collection"));
+        footer_.AddObject(&caption_);
+
+        CLCDColorText ticker_;
+        ticker_.SetOrigin(0, (height_ - gridHeight_) / 2);
+        ticker_.SetSize(width_, (height_ - gridHeight_) / 2);
+        ticker_.SetForegroundColor(RGB(255, 255, 0));
+        ticker_.SetText(_T("A scrolling label with far more text than fits on one line of the display"));
+        footer_.AddObject(&ticker_);
+
+        CLCDGfxColor gfx_;
+        CLCDTileRenderer renderer_;
+        if (FAILED(gfx_.Initialize()) || FAILED(renderer_.Initialize(&gfx_)))
+        {
+            TRACE(_T("Tile benchmark: failed to initialize\n"));
+            DeleteObject(bitmap_);
+            CLCDClock::SetInstance(NULL);
+            return;
+        }
+
+        RECT screen_ = { 0, 0, width_, height_ };
+        std::vector<BYTE> serialFrame_, tiledFrame_;
+        LONGLONG ticks_[2] = { 0, 0 };
+        INT differ_ = 0;
+        INT notTiled_ = 0;
+        LARGE_INTEGER frequency_;
+        QueryPerformanceFrequency(&frequency_);
+
+        for (INT frame_ = 0; frame_ < frames; frame_++)
+        {
+            for (INT index_ = 0; index_ < bars_; index_++)
+            {
+                progressBars_[index_].SetPos((FLOAT)((frame_ + index_ * 25) % 100));
+            }
+            clock_.Advance(40);
+            page_.OnUpdate(CLCDClock::Now());
+
+            // the same page state, drawn both ways
+            for (INT pass_ = 0; pass_ < 2; pass_++)
+            {
+                BOOL tiled_ = (1 == pass_);
+                LARGE_INTEGER start_, stop_;
+                QueryPerformanceCounter(&start_);
+
+                gfx_.BeginDraw();
+                gfx_.ClearScreen();
+                if (!tiled_ || !renderer_.Render(page_, screen_))
+                {
+                    if (tiled_)
+                    {
+                        notTiled_++;
+                    }
+                    page_.OnDraw(gfx_);
+                }
+                gfx_.EndDraw();
+                gfx_.GetLCDScreen();
+
+                QueryPerformanceCounter(&stop_);
+                ticks_[pass_] += stop_.QuadPart - start_.QuadPart;
+
+                CopyFrame(gfx_, tiled_ ? tiledFrame_ : serialFrame_);
+            }
+
+            if (tiledFrame_ != serialFrame_)
+            {
+                differ_++;
+            }
+        }
+
+        for (INT pass_ = 0; pass_ < 2; pass_++)
+        {
+            DOUBLE seconds_ = (DOUBLE)ticks_[pass_] / (DOUBLE)frequency_.QuadPart;
+            TRACE(_T("Tile benchmark (%d frames): %s %.1f fps\n"), frames,
+                (1 == pass_) ? _T("tiled") : _T("serial"), (seconds_ > 0.0) ? frames / seconds_ : 0.0);
+        }
+
+        TRACE(_T("Tile benchmark: %d workers, %d of %d frames differ, %d not tiled: %s\n"),
+            renderer_.GetThreadCount(), differ_, frames, notTiled_,
+            ((0 == differ_) && (0 == notTiled_)) ? _T("passed") : _T("FAILED"));
+
+        renderer_.Shutdown();
+        gfx_.Shutdown();
+        DeleteObject(bitmap_);
+    }
+
+    CLCDClock::SetInstance(NULL);
+}
+
+// A label that counts how often it is prepared
+class CPrepareCountingText : public CLCDText
+{
+public:
+    CPrepareCountingText() : m_nPrepared(0) {}
+
+    virtual void OnPrepareDraw(CLCDGfxBase &rGfx)
+    {
+        InterlockedIncrement(&m_nPrepared);
+        CLCDText::OnPrepareDraw(rGfx);
+    }
+
+    volatile LONG m_nPrepared;
+};
+
+VOID ExtraTester::DoTilePrepareTest(INT frames)
+{
+    // Draws a page in tiles and checks that every label, the ones in a
+    // nested collection included, is prepared exactly once per frame
+    INT width_ = LGLCD_QVGA_BMP_WIDTH;
+    INT height_ = LGLCD_QVGA_BMP_HEIGHT;
+    const INT labelCount_ = 8;
+
+    CLCDPage page_;
+    page_.SetSize(width_, height_);
+
+    CLCDCollection nested_;
+    nested_.SetOrigin(0, height_ / 2);
+    nested_.SetSize(width_, height_ / 2);
+    page_.AddObject(&nested_);
+
+    CPrepareCountingText labels_[labelCount_];
+    for (INT index_ = 0; index_ < labelCount_; index_++)
+    {
+        // wide enough to cross several tiles
+        BOOL inNested_ = (index_ >= labelCount_ / 2);
+        INT row_ = index_ % (labelCount_ / 2);
+        labels_[index_].SetOrigin(0, row_ * (height_ / labelCount_));
+        labels_[index_].SetSize(width_, height_ / labelCount_);
+        labels_[index_].SetAlignment(DT_RIGHT);
+        labels_[index_].SetText(_T("Prepared once per frame"));
+        if (inNested_)
+        {
+            nested_.AddObject(&labels_[index_]);
+        }
+        else
+        {
+            page_.AddObject(&labels_[index_]);
+        }
+    }
+
+    CLCDGfxColor gfx_;
+    CLCDTileRenderer renderer_;
+    if (FAILED(gfx_.Initialize()) || FAILED(renderer_.Initialize(&gfx_)))
+    {
+        TRACE(_T("Tile prepare test: failed to initialize\n"));
+        return;
+    }
+
+    RECT screen_ = { 0, 0, width_, height_ };
+    BOOL tiled_ = TRUE;
+    for (INT frame_ = 0; frame_ < frames; frame_++)
+    {
+        gfx_.BeginDraw();
+        gfx_.ClearScreen();
+        if (!renderer_.Render(page_, screen_))
+        {
+            tiled_ = FALSE;
+            page_.OnDraw(gfx_);
+        }
+        gfx_.EndDraw();
+    }
+
+    INT wrong_ = 0;
+    for (INT index_ = 0; index_ < labelCount_; index_++)
+    {
+        if (labels_[index_].m_nPrepared != frames)
+        {
+            TRACE(_T("Tile prepare test: label %d prepared %d times in %d frames\n"),
+                index_, labels_[index_].m_nPrepared, frames);
+            wrong_++;
+        }
+    }
+
+    TRACE(_T("Tile prepare test (%d frames, %d workers, %s): %s\n"), frames,
+        renderer_.GetThreadCount(), tiled_ ? _T("tiled") : _T("NOT tiled"),
+        (0 == wrong_) ? _T("passed") : _T("FAILED"));
+
+    renderer_.Shutdown();
+    gfx_.Shutdown();
+}
+
+// A label that counts how often it is drawn
+class CDrawCountingText : public CLCDText
+{
+public:
+    CDrawCountingText() : m_nDrawn(0) {}
+
+    virtual void OnDraw(CLCDGfxBase &rGfx)
+    {
+        InterlockedIncrement(&m_nDrawn);
+        CLCDText::OnDraw(rGfx);
+    }
+
+    volatile LONG m_nDrawn;
+};
+
+// Lets the tests drive the rendering of an output without a device
+class CRenderTestOutput : public CLCDOutput
+{
+public:
+    VOID Render(void) { RenderActivePage(); }
+    VOID Mirror(void) { RenderMirror(); }
+};
+
+VOID ExtraTester::DoMirrorDrawTest(INT frames)
+{
+    // Mirrors a color output on a mono one and checks that the color page
+    // is drawn once per update, whether the color output drew it on its
+    // own device first or only the mirror needs it
+    CLCDGfxColor colorGfx_;
+    CLCDGfxMono monoGfx_;
+    if (FAILED(colorGfx_.Initialize()) || FAILED(monoGfx_.Initialize()))
+    {
+        TRACE(_T("Mirror draw test: failed to initialize\n"));
+        return;
+    }
+
+    CLCDPage page_;
+    page_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT);
+    CDrawCountingText label_;
+    label_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT / 4);
+    label_.SetText(_T("Drawn once per update"));
+    page_.AddObject(&label_);
+
+    CRenderTestOutput source_;
+    source_.SetGfx(&colorGfx_);
+    source_.AddPage(&page_);
+    source_.ShowPage(&page_);
+
+    CRenderTestOutput mirror_;
+    mirror_.SetGfx(&monoGfx_);
+    mirror_.SetMirrorSource(&source_, CLCDDither::DITHER_ORDERED);
+
+    // both devices there: the connection updates and draws the color
+    // output first, then the mono one
+    for (INT frame_ = 0; frame_ < frames; frame_++)
+    {
+        source_.OnUpdate(CLCDClock::Now());
+        source_.Render();
+        mirror_.Mirror();
+    }
+    LONG withDevice_ = label_.m_nDrawn;
+
+    // only the mono device there: the mirror updates the source itself
+    label_.m_nDrawn = 0;
+    for (INT frame_ = 0; frame_ < frames; frame_++)
+    {
+        mirror_.OnUpdate(CLCDClock::Now());
+        mirror_.Mirror();
+    }
+    LONG withoutDevice_ = label_.m_nDrawn;
+
+    TRACE(_T("Mirror draw test (%d updates): drawn %d times with the color device, %d without: %s\n"),
+        frames, withDevice_, withoutDevice_,
+        ((withDevice_ == frames) && (withoutDevice_ == frames)) ? _T("passed") : _T("FAILED"));
+
+    mirror_.SetMirrorSource(NULL, CLCDDither::DITHER_ORDERED);
+    mirror_.Shutdown();
+    source_.Shutdown();
+    colorGfx_.Shutdown();
+    monoGfx_.Shutdown();
+}
+
+// The color or the monochrome display, for the tests that run on both
+class CTestDisplay
+{
+public:
+    CTestDisplay(BOOL color)
+    :   m_bColor(color),
+        m_nWidth(color ? LGLCD_QVGA_BMP_WIDTH : LGLCD_BW_BMP_WIDTH),
+        m_nHeight(color ? LGLCD_QVGA_BMP_HEIGHT : LGLCD_BW_BMP_HEIGHT)
+    {
+    }
+
+    HRESULT Initialize(void) { return Gfx().Initialize(); }
+    CLCDGfxBase &Gfx(void) { return m_bColor ? (CLCDGfxBase &)m_GfxColor : (CLCDGfxBase &)m_GfxMono; }
+    LPCTSTR GetName(void) { return m_bColor ? _T("color") : _T("mono"); }
+
+    BOOL m_bColor;
+    INT m_nWidth;
+    INT m_nHeight;
+
+private:
+    CLCDGfxColor m_GfxColor;
+    CLCDGfxMono m_GfxMono;
+};
+
+VOID ExtraTester::DoGlyphCacheBenchmark(INT frames)
+{
+    // A text heavy page: a grid of short labels and a wrapped paragraph,
+    // drawn with DrawTextEx() and then from the glyph cache. The cached
+    // frame must look like the DrawTextEx() one, and once the cache is
+    // warm every glyph must be found in it.
+    CLCDGlyphCache &cache_ = CLCDGlyphCache::GetInstance();
+    BOOL wasEnabled_ = cache_.IsEnabled();
+
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        CTestDisplay display_(0 == pass_);
+        INT width_ = display_.m_nWidth;
+        INT height_ = display_.m_nHeight;
+        const INT columns_ = 4;
+        const INT rows_ = display_.m_bColor ? 8 : 2;
+
+        CLCDPage page_;
+        page_.SetSize(width_, height_);
+        page_.SetBackground(RGB(0, 0, 0));
+
+        CLCDText labels_[4 * 8];
+        for (INT index_ = 0; index_ < columns_ * rows_; index_++)
+        {
+            TCHAR text_[32];
+            wsprintf(text_, _T("Item %d: %d%%"), index_, (index_ * 37) % 100);
+            labels_[index_].SetOrigin((index_ % columns_) * (width_ / columns_), (index_ / columns_) * (height_ / 2 / rows_));
+            labels_[index_].SetSize(width_ / columns_, height_ / 2 / rows_);
+            labels_[index_].SetText(text_);
+            page_.AddObject(&labels_[index_]);
+        }
+
+        CLCDText body_;
+        body_.SetOrigin(0, height_ / 2);
+        body_.SetSize(width_, height_ / 2);
+        body_.SetWordWrap(TRUE);
+        body_.SetAlignment(DT_CENTER);
+        body_.SetText(_T("The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs. ")
+                      _T("How vexingly quick daft zebras jump! Sphinx of black quartz, judge my vow."));
+        page_.AddObject(&body_);
+
+        if (FAILED(display_.Initialize()))
+        {
+            TRACE(_T("Glyph cache benchmark: failed to initialize\n"));
+            break;
+        }
+        CLCDGfxBase &gfx_ = display_.Gfx();
+
+        cache_.Enable(FALSE);
+        DOUBLE gdiFps_ = MeasureFramesPerSecond(gfx_, page_, frames);
+        std::vector<BYTE> gdiFrame_, cachedFrame_;
+        CopyFrame(gfx_, gdiFrame_);
+
+        cache_.Enable(TRUE);
+        cache_.ResetStatistics();
+        DOUBLE cachedFps_ = MeasureFramesPerSecond(gfx_, page_, frames);
+        CopyFrame(gfx_, cachedFrame_);
+
+        DWORD hits_ = 0, misses_ = 0;
+        cache_.GetStatistics(hits_, misses_);
+        DOUBLE hitRate_ = (0 < hits_ + misses_) ? 100.0 * hits_ / (hits_ + misses_) : 0.0;
+
+        // one more frame, all of it from the cache
+        DWORD warmHits_ = 0, warmMisses_ = 0;
+        cache_.ResetStatistics();
+        RenderFrame(gfx_, page_);
+        cache_.GetStatistics(warmHits_, warmMisses_);
+
+        // the gray edges of the cached glyphs may round differently
+        INT differ_ = CountDifferences(gdiFrame_, cachedFrame_, display_.m_bColor ? 48 : 0);
+
+        TRACE(_T("Glyph cache benchmark (%s, %d frames): DrawTextEx %.1f fps, cached %.1f fps, %.2f%% hits (%u/%u)\n"),
+            display_.GetName(), frames, gdiFps_, cachedFps_, hitRate_, hits_, hits_ + misses_);
+        TRACE(_T("Glyph cache benchmark (%s): %d bytes differ from DrawTextEx, %u misses when warm: %s\n"),
+            display_.GetName(), differ_, warmMisses_,
+            ((0 == differ_) && (0 < warmHits_) && (0 == warmMisses_)) ? _T("passed") : _T("FAILED"));
+    }
+
+    cache_.Enable(wasEnabled_);
+}
+
+VOID ExtraTester::DoFontBenchmark(INT objects)
+{
+    // Sets up labels the way CEzLcdPage::AddText() does: face, weight,
+    // then size. Identical labels share their fonts through the registry.
+    CLCDFontRegistry &registry_ = CLCDFontRegistry::GetInstance();
+    DWORD createdBefore_ = registry_.GetCreatedFontCount();
+
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+    QueryPerformanceCounter(&start_);
+
+    std::vector<CLCDText *> labels_;
+    for (INT index_ = 0; index_ < objects; index_++)
+    {
+        CLCDText *label_ = new CLCDText;
+        label_->SetFontFaceName(_T("Arial"));
+        label_->SetFontWeight((0 == index_ % 4) ? FW_BOLD : FW_NORMAL);
+        label_->SetFontPointSize(9);
+        labels_.push_back(label_);
+    }
+
+    QueryPerformanceCounter(&stop_);
+
+    DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+    TRACE(_T("Font benchmark (%d labels): %.3f ms, %u fonts created, %d in use\n"),
+        objects, seconds_ * 1000.0, registry_.GetCreatedFontCount() - createdBefore_,
+        registry_.GetFontCount());
+
+    for (size_t index_ = 0; index_ < labels_.size(); index_++)
+    {
+        delete labels_[index_];
+    }
+}
+
+VOID ExtraTester::DoLayoutBenchmark(INT passes)
+{
+    // Popups measure their message and buttons every time they are laid
+    // out; the same few strings come back over and over.
+    CLCDText message_;
+    message_.SetFontFaceName(_T("Arial"));
+    message_.SetFontPointSize(9);
+    message_.SetSize(140, 30);
+
+    LPCTSTR texts_[] =
+    {
+        _T("Battery low"),
+        _T("A new version is available. Install it now?"),
+        _T("OK"),
+        _T("Cancel"),
+    };
+    const INT textCount_ = sizeof(texts_) / sizeof(texts_[0]);
+
+    CLCDTextLayout &layout_ = CLCDTextLayout::GetInstance();
+    BOOL wasEnabled_ = layout_.IsEnabled();
+
+    LARGE_INTEGER frequency_;
+    QueryPerformanceFrequency(&frequency_);
+
+    for (INT cached_ = 0; cached_ < 2; cached_++)
+    {
+        layout_.Enable(cached_);
+        layout_.Clear();
+        layout_.ResetStatistics();
+
+        LARGE_INTEGER start_, stop_;
+        QueryPerformanceCounter(&start_);
+
+        for (INT pass_ = 0; pass_ < passes; pass_++)
+        {
+            message_.SetText(texts_[pass_ % textCount_]);
+            message_.CalculateExtent(TRUE);
+            message_.CalculateExtent(FALSE);
+        }
+
+        QueryPerformanceCounter(&stop_);
+
+        DWORD hits_, misses_;
+        layout_.GetStatistics(hits_, misses_);
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        TRACE(_T("Layout benchmark (%s, %d passes): %.3f ms, %u hits, %u misses\n"),
+            cached_ ? _T("cached") : _T("uncached"), passes, seconds_ * 1000.0, hits_, misses_);
+    }
+
+    layout_.Enable(wasEnabled_);
+}
+
+VOID ExtraTester::DoMarqueeBenchmark(INT frames)
+{
+    // Ticker lines that do not fit and stream continuously; each frame
+    // copies the visible part of the pre-rendered strips. Then, on a
+    // virtual clock, each frame must be the previous one moved left.
+    const INT steps_ = 20;
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        CTestDisplay display_(0 == pass_);
+        INT width_ = display_.m_nWidth;
+        INT height_ = display_.m_nHeight;
+        const INT lines_ = 4;
+
+        CLCDPage page_;
+        page_.SetSize(width_, height_);
+        page_.SetBackground(RGB(0, 0, 0));
+
+        CLCDStreamingText tickers_[lines_];
+        for (INT index_ = 0; index_ < lines_; index_++)
+        {
+            tickers_[index_].Initialize();
+            tickers_[index_].SetOrigin(0, index_ * (height_ / lines_));
+            tickers_[index_].SetSize(width_, height_ / lines_);
+            tickers_[index_].SetFontPointSize(display_.m_bColor ? 14 : 7);
+            tickers_[index_].SetStartDelay(0);
+            tickers_[index_].SetSpeed(200);
+            tickers_[index_].SetScrollingStep(1);
+            tickers_[index_].SetText(_T("Now playing: a song with a title far too long to fit on one line of the display"));
+            page_.AddObject(&tickers_[index_]);
+        }
+
+        if (FAILED(display_.Initialize()))
+        {
+            TRACE(_T("Marquee benchmark: failed to initialize\n"));
+            break;
+        }
+        CLCDGfxBase &gfx_ = display_.Gfx();
+
+        DOUBLE fps_ = MeasureFramesPerSecond(gfx_, page_, frames);
+        TRACE(_T("Marquee benchmark (%s, %d frames): %.1f fps\n"),
+            display_.GetName(), frames, fps_);
+
+        // from where the real clock stopped, 10 pixels per step
+        INT moved_ = 0;
+        {
+            CLCDVirtualClock clock_(CLCDClock::Now());
+            CLCDClock::SetInstance(&clock_);
+
+            std::vector<BYTE> previous_, frame_;
+            RenderFrame(gfx_, page_);
+            RenderFrame(gfx_, page_);
+            CopyFrame(gfx_, previous_);
+            for (INT step_ = 0; step_ < steps_; step_++)
+            {
+                clock_.Advance(50);
+                RenderFrame(gfx_, page_);
+                CopyFrame(gfx_, frame_);
+                if (0 < FindScroll(gfx_, previous_, frame_))
+                {
+                    moved_++;
+                }
+                previous_.swap(frame_);
+            }
+
+            CLCDClock::SetInstance(NULL);
+        }
+
+        TRACE(_T("Marquee benchmark (%s): moved cleanly in %d of %d steps: %s\n"),
+            display_.GetName(), moved_, steps_, (moved_ == steps_) ? _T("passed") : _T("FAILED"));
+    }
+}
+
+VOID ExtraTester::DoColorTextScrollTest(INT seconds)
+{
+    // Draws a scrolling color label through CLCDPage::OnDraw() alone, as
+    // an output does without tile rendering, and checks that the text
+    // shows up, moves, and follows SetText()
+    CLCDVirtualClock clock_;
+    CLCDClock::SetInstance(&clock_);
+
+    {
+        INT width_ = LGLCD_QVGA_BMP_WIDTH;
+        INT height_ = LGLCD_QVGA_BMP_HEIGHT;
+
+        CLCDPage page_;
+        page_.SetSize(width_, height_);
+        page_.SetBackground(RGB(0, 0, 0));
+
+        CLCDColorText label_;
+        label_.SetOrigin(0, height_ / 3);
+        label_.SetSize(width_, height_ / 3);
+        label_.SetForegroundColor(RGB(255, 255, 255));
+        label_.SetText(_T("A color label with far too much text to fit on one line of the display"));
+        page_.AddObject(&label_);
+
+        CLCDGfxColor gfx_;
+        if (FAILED(gfx_.Initialize()))
+        {
+            TRACE(_T("Color text scroll test: failed to initialize\n"));
+            CLCDClock::SetInstance(NULL);
+            return;
+        }
+
+        std::vector<BYTE> blank_, first_, frame_;
+        gfx_.BeginDraw();
+        gfx_.ClearScreen();
+        gfx_.EndDraw();
+        CopyFrame(gfx_, blank_);
+
+        RenderFrame(gfx_, page_);
+        CopyFrame(gfx_, first_);
+        BOOL visible_ = (first_ != blank_);
+
+        // the label is measured now, this starts its scroll timer; then
+        // it jumps once per second
+        page_.OnUpdate(CLCDClock::Now());
+        INT moved_ = 0;
+        for (INT second_ = 0; second_ < seconds; second_++)
+        {
+            std::vector<BYTE> previous_;
+            CopyFrame(gfx_, previous_);
+            clock_.Advance(1000);
+            RenderFrame(gfx_, page_);
+            CopyFrame(gfx_, frame_);
+            if (frame_ != previous_)
+            {
+                moved_++;
+            }
+        }
+
+        label_.SetText(_T("Different text, just as long and still far too wide for the display"));
+        RenderFrame(gfx_, page_);
+        CopyFrame(gfx_, frame_);
+        BOOL changed_ = (frame_ != first_) && (frame_ != blank_);
+
+        TRACE(_T("Color text scroll test (%d s): visible %d, moved in %d of %d seconds, new text %d: %s\n"),
+            seconds, visible_, moved_, seconds, changed_,
+            (visible_ && (moved_ == seconds) && changed_) ? _T("passed") : _T("FAILED"));
+
+        gfx_.Shutdown();
+    }
+
+    CLCDClock::SetInstance(NULL);
+}
+
+VOID ExtraTester::DoVirtualClockTest(INT minutes)
+{
+    // Runs a page with streaming and scrolling text through simulated
+    // time, and checks that it expires when it should
+    CLCDVirtualClock clock_;
+    CLCDClock::SetInstance(&clock_);
+
+    {
+        const DWORD step_ = 50;
+        const DWORD expiration_ = (DWORD)minutes * 60 * 1000 / 2;
+
+        CLCDPage page_;
+        page_.SetSize(LGLCD_BW_BMP_WIDTH, LGLCD_BW_BMP_HEIGHT);
+
+        CLCDStreamingText ticker_;
+        ticker_.Initialize();
+        ticker_.SetSize(LGLCD_BW_BMP_WIDTH, LGLCD_BW_BMP_HEIGHT / 2);
+        ticker_.SetText(_T("Now playing: a song with a title far too long to fit on one line of the display"));
+        page_.AddObject(&ticker_);
+
+        CLCDScrollingText scroller_;
+        scroller_.Initialize();
+        scroller_.SetOrigin(0, LGLCD_BW_BMP_HEIGHT / 2);
+        scroller_.SetSize(LGLCD_BW_BMP_WIDTH, LGLCD_BW_BMP_HEIGHT / 2);
+        scroller_.SetText(_T("Another line that scrolls to its end, waits, and starts over"));
+        page_.AddObject(&scroller_);
+
+        page_.SetExpiration(expiration_);
+
+        CLCDGfxMono gfx_;
+        if (FAILED(gfx_.Initialize()))
+        {
+            TRACE(_T("Virtual clock test: failed to initialize\n"));
+            CLCDClock::SetInstance(NULL);
+            return;
+        }
+
+        LARGE_INTEGER frequency_, start_, stop_;
+        QueryPerformanceFrequency(&frequency_);
+        QueryPerformanceCounter(&start_);
+
+        DWORD simulated_ = 0;
+        DWORD expiredAt_ = 0;
+        while (simulated_ < (DWORD)minutes * 60 * 1000)
+        {
+            clock_.Advance(step_);
+            simulated_ += step_;
+
+            // same sequence as CLCDOutput::OnDraw
+            page_.OnUpdate(CLCDClock::Now());
+            gfx_.BeginDraw();
+            gfx_.ClearScreen();
+            page_.OnDraw(gfx_);
+            gfx_.EndDraw();
+
+            if ((0 == expiredAt_) && page_.HasExpired())
+            {
+                expiredAt_ = simulated_;
+            }
+        }
+
+        QueryPerformanceCounter(&stop_);
+
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        TRACE(_T("Virtual clock test: %d minutes in %.2f s, page expired at %u ms (expected %u ms) %s\n"),
+            minutes, seconds_, expiredAt_, expiration_,
+            (expiredAt_ == expiration_) ? _T("ok") : _T("WRONG"));
+
+        gfx_.Shutdown();
+    }
+
+    CLCDClock::SetInstance(NULL);
+}
+
+VOID ExtraTester::DoPaginateBenchmark(INT kilobytes)
+{
+    // Patch notes on the color screen: a long document that is paged
+    // through, and that grows at the end
+    CLCDPaginateText::lcdstring document_;
+    LPCTSTR paragraph_ = _T("Fixed an issue where the inventory would not update after selling an item to a vendor ")
+                         _T("while the stash was open.\r\n");
+    while (document_.size() * sizeof(TCHAR) < (size_t)kilobytes * 1024)
+    {
+        document_.append(paragraph_);
+    }
+
+    CLCDPage page_;
+    page_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT);
+    page_.SetBackground(RGB(0, 0, 0));
+
+    CLCDPaginateText notes_;
+    notes_.Initialize();
+    notes_.SetFontFaceName(_T("Arial"));
+    notes_.SetFontPointSize(9);
+    notes_.SetFontColor(RGB(255, 255, 255));
+    notes_.SetWordWrap(TRUE);
+    notes_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT);
+    page_.AddObject(&notes_);
+
+    CLCDGfxColor gfx_;
+    if (FAILED(gfx_.Initialize()))
+    {
+        TRACE(_T("Paginate benchmark: failed to initialize\n"));
+        return;
+    }
+
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+
+    // what every change cost when the whole text was measured by GDI
+    CLCDTextLayout &layout_ = CLCDTextLayout::GetInstance();
+    BOOL wasEnabled_ = layout_.IsEnabled();
+    layout_.Enable(FALSE);
+    DRAWTEXTPARAMS dtp_ = { sizeof(DRAWTEXTPARAMS), 0, 0, 0, 0 };
+    QueryPerformanceCounter(&start_);
+    layout_.GetExtent(NULL, notes_.GetFont(), document_.c_str(), (INT)document_.size(),
+        LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT, DT_LEFT | DT_NOPREFIX | DT_WORDBREAK, dtp_);
+    QueryPerformanceCounter(&stop_);
+    layout_.Enable(wasEnabled_);
+    DOUBLE measureMs_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) * 1000.0 / (DOUBLE)frequency_.QuadPart;
+
+    // building the line index
+    QueryPerformanceCounter(&start_);
+    notes_.SetText(document_.c_str());
+    INT pages_ = notes_.GetTotalPages();
+    QueryPerformanceCounter(&stop_);
+    DOUBLE indexMs_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) * 1000.0 / (DOUBLE)frequency_.QuadPart;
+
+    // jumping around and drawing the page
+    const INT jumps_ = 200;
+    QueryPerformanceCounter(&start_);
+    for (INT jump_ = 0; jump_ < jumps_; jump_++)
+    {
+        notes_.SetCurPage((jump_ * 7919) % pages_);
+
+        gfx_.BeginDraw();
+        gfx_.ClearScreen();
+        page_.OnDraw(gfx_);
+        gfx_.EndDraw();
+    }
+    QueryPerformanceCounter(&stop_);
+    DOUBLE jumpMs_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) * 1000.0 / (DOUBLE)frequency_.QuadPart / jumps_;
+
+    // appending a paragraph at a time
+    const INT appends_ = 200;
+    QueryPerformanceCounter(&start_);
+    for (INT append_ = 0; append_ < appends_; append_++)
+    {
+        notes_.AppendText(paragraph_);
+        pages_ = notes_.GetTotalPages();
+    }
+    QueryPerformanceCounter(&stop_);
+    DOUBLE appendMs_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) * 1000.0 / (DOUBLE)frequency_.QuadPart / appends_;
+
+    TRACE(_T("Paginate benchmark (%d KB, %d pages): whole text measure %.2f ms, index %.2f ms, ")
+          _T("page jump %.3f ms, append %.3f ms\n"),
+        kilobytes, pages_, measureMs_, indexMs_, jumpMs_, appendMs_);
+
+    gfx_.Shutdown();
+}
+
+VOID ExtraTester::DoLogViewBenchmark(INT frames)
+{
+    // A combat log on the color screen, a few events per frame: in a log
+    // view, and in a text whose string keeps growing
+    const INT eventsPerFrame_ = 5;
+    LPCTSTR events_[] =
+    {
+        _T("You hit the Fallen Shaman for 1250 damage."),
+        _T("The Fallen Shaman resurrects a Fallen."),
+        _T("Picked up 312 gold."),
+        _T("Legendary item dropped: a ring with a name long enough to be wrapped on the display."),
+    };
+    const INT eventCount_ = sizeof(events_) / sizeof(events_[0]);
+
+    CLCDGfxColor gfx_;
+    if (FAILED(gfx_.Initialize()))
+    {
+        TRACE(_T("Log view benchmark: failed to initialize\n"));
+        return;
+    }
+
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        BOOL logView_ = (0 == pass_);
+
+        CLCDPage page_;
+        page_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT);
+        page_.SetBackground(RGB(0, 0, 0));
+
+        CLCDLogView log_;
+        log_.SetFontFaceName(_T("Arial"));
+        log_.SetFontPointSize(9);
+        log_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT);
+
+        CLCDText text_;
+        text_.SetFontFaceName(_T("Arial"));
+        text_.SetFontPointSize(9);
+        text_.SetWordWrap(TRUE);
+        text_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT);
+        CLCDText::lcdstring history_;
+
+        page_.AddObject(logView_ ? (CLCDBase *)&log_ : (CLCDBase *)&text_);
+
+        // the growing string gets too slow to run as long
+        INT passFrames_ = logView_ ? frames : min(frames, 100);
+
+        QueryPerformanceCounter(&start_);
+
+        for (INT frame_ = 0; frame_ < passFrames_; frame_++)
+        {
+            for (INT event_ = 0; event_ < eventsPerFrame_; event_++)
+            {
+                LPCTSTR line_ = events_[(frame_ * eventsPerFrame_ + event_) % eventCount_];
+                if (logView_)
+                {
+                    log_.AddLine(line_, (0 == event_ % 2) ? RGB(255, 255, 255) : RGB(255, 200, 0));
+                }
+                else
+                {
+                    history_.append(line_);
+                    history_.append(_T("\r\n"));
+                }
+            }
+            if (!logView_)
+            {
+                text_.SetText(history_.c_str());
+            }
+
+            gfx_.BeginDraw();
+            gfx_.ClearScreen();
+            page_.OnDraw(gfx_);
+            gfx_.EndDraw();
+        }
+
+        QueryPerformanceCounter(&stop_);
+
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        DOUBLE fps_ = (seconds_ > 0.0) ? passFrames_ / seconds_ : 0.0;
+        if (logView_)
+        {
+            TRACE(_T("Log view benchmark (log view, %d frames, %d events per frame): %.1f fps, %d of %d lines kept\n"),
+                passFrames_, eventsPerFrame_, fps_, log_.GetLineCount(), log_.GetCapacity());
+        }
+        else
+        {
+            TRACE(_T("Log view benchmark (growing text, %d frames, %d events per frame): %.1f fps, %u characters\n"),
+                passFrames_, eventsPerFrame_, fps_, (UINT)history_.size());
+        }
+    }
+
+    gfx_.Shutdown();
+}
+
+VOID ExtraTester::DoBitmapFontBenchmark(INT frames)
+{
+    // A grid of short labels on the mono screen and on a soft surface:
+    // with DrawTextEx(), from the glyph cache and with a bitmap font. The
+    // font is a BDF made from the built-in font of the soft surface, so
+    // that no font file is needed, and so it must draw the same pixels.
+    CLCDGfxSoft glyphs_(8);
+    if (FAILED(glyphs_.Initialize()))
+    {
+        TRACE(_T("Bitmap font benchmark: failed to initialize\n"));
+        return;
+    }
+
+    std::string bdf_ = "STARTFONT 2.1\nFONT -builtin-5x7\nSIZE 7 75 75\nFONTBOUNDINGBOX 5 7 0 0\n"
+                       "STARTPROPERTIES 3\nFONT_ASCENT 7\nFONT_DESCENT 2\nDEFAULT_CHAR 63\nENDPROPERTIES\nCHARS 95\n";
+    for (INT char_ = 32; char_ < 127; char_++)
+    {
+        TCHAR text_ = (TCHAR)char_;
+        glyphs_.BeginDraw();
+        glyphs_.ClearScreen();
+        glyphs_.DrawText(0, 0, &text_, 1, RGB(255, 255, 255));
+        glyphs_.EndDraw();
+
+        CHAR line_[80];
+        wsprintfA(line_, "STARTCHAR C%03d\nENCODING %d\nDWIDTH %d 0\nBBX %d %d 0 0\nBITMAP\n", char_, char_,
+            CLCDGfxSoft::GLYPH_ADVANCE, CLCDGfxSoft::GLYPH_WIDTH, CLCDGfxSoft::GLYPH_HEIGHT);
+        bdf_ += line_;
+        for (INT y_ = 0; y_ < CLCDGfxSoft::GLYPH_HEIGHT; y_++)
+        {
+            const BYTE *pixels_ = glyphs_.GetBits() + y_ * glyphs_.GetPitch();
+            INT row_ = 0;
+            for (INT x_ = 0; x_ < CLCDGfxSoft::GLYPH_WIDTH; x_++)
+            {
+                row_ |= pixels_[x_] ? (0x80 >> x_) : 0;
+            }
+            wsprintfA(line_, "%02X\n", row_);
+            bdf_ += line_;
+        }
+        bdf_ += "ENDCHAR\n";
+    }
+    bdf_ += "ENDFONT\n";
+
+    // what the bitmap font must draw
+    LPCTSTR sample_ = _T("CPU 42% RAM 3.1G 12:45");
+    glyphs_.BeginDraw();
+    glyphs_.ClearScreen();
+    glyphs_.DrawText(0, 0, sample_, (INT)_tcslen(sample_), RGB(255, 255, 255));
+    glyphs_.EndDraw();
+    std::vector<BYTE> expected_;
+    CopyFrame(glyphs_, expected_);
+    INT expectedPitch_ = glyphs_.GetPitch();
+    glyphs_.Shutdown();
+
+    CLCDBitmapFont font_;
+    if (FAILED(font_.LoadBDF(bdf_.c_str(), (INT)bdf_.size())))
+    {
+        TRACE(_T("Bitmap font benchmark: failed to load the font\n"));
+        return;
+    }
+
+    CLCDGlyphCache &cache_ = CLCDGlyphCache::GetInstance();
+    BOOL wasEnabled_ = cache_.IsEnabled();
+    LPCTSTR labels_[] = { _T("CPU 42%"), _T("GPU 67C"), _T("RAM 3.1G"), _T("FPS 144"),
+                          _T("Ping 23"), _T("HP 870"), _T("Ammo 30"), _T("12:45") };
+    const INT labelCount_ = sizeof(labels_) / sizeof(labels_[0]);
+    const INT columns_ = 4;
+
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        BOOL soft_ = (1 == pass_);
+
+        CLCDGfxMono gfxMono_;
+        CLCDGfxSoft gfxSoft_(8);
+        CLCDGfxBase &gfx_ = soft_ ? (CLCDGfxBase &)gfxSoft_ : (CLCDGfxBase &)gfxMono_;
+        if (FAILED(gfx_.Initialize()))
+        {
+            TRACE(_T("Bitmap font benchmark: failed to initialize\n"));
+            break;
+        }
+
+        CLCDPage page_;
+        page_.SetSize(LGLCD_BW_BMP_WIDTH, LGLCD_BW_BMP_HEIGHT);
+
+        CLCDText text_[labelCount_];
+        for (INT index_ = 0; index_ < labelCount_; index_++)
+        {
+            text_[index_].SetOrigin((index_ % columns_) * (LGLCD_BW_BMP_WIDTH / columns_),
+                                    (index_ / columns_) * font_.GetLineHeight());
+            text_[index_].SetSize(LGLCD_BW_BMP_WIDTH / columns_, font_.GetLineHeight());
+            text_[index_].SetText(labels_[index_]);
+            page_.AddObject(&text_[index_]);
+        }
+
+        // soft surfaces always draw with their built-in font
+        cache_.Enable(FALSE);
+        DOUBLE gdiFps_ = MeasureFramesPerSecond(gfx_, page_, frames);
+
+        cache_.Enable(TRUE);
+        DOUBLE cachedFps_ = soft_ ? gdiFps_ : MeasureFramesPerSecond(gfx_, page_, frames);
+
+        for (INT index_ = 0; index_ < labelCount_; index_++)
+        {
+            text_[index_].SetBitmapFont(&font_);
+        }
+        DOUBLE bitmapFps_ = MeasureFramesPerSecond(gfx_, page_, frames);
+
+        // the sample line, lit where the built-in font lit it
+        RECT screen_ = { 0, 0, LGLCD_BW_BMP_WIDTH, LGLCD_BW_BMP_HEIGHT };
+        gfx_.BeginDraw();
+        gfx_.ClearScreen();
+        BOOL drawn_ = font_.DrawText(gfx_, screen_, sample_, (INT)_tcslen(sample_),
+            DT_LEFT | DT_TOP | DT_SINGLELINE | DT_NOPREFIX, RGB(255, 255, 255));
+        gfx_.EndDraw();
+        std::vector<BYTE> frame_;
+        CopyFrame(gfx_, frame_);
+
+        INT differ_ = 0;
+        for (INT y_ = 0; y_ < LGLCD_BW_BMP_HEIGHT; y_++)
+        {
+            for (INT x_ = 0; x_ < LGLCD_BW_BMP_WIDTH; x_++)
+            {
+                BOOL lit_ = (0 != frame_[(size_t)y_ * gfx_.GetPitch() + x_]);
+                BOOL expectedLit_ = (0 != expected_[(size_t)y_ * expectedPitch_ + x_]);
+                if (lit_ != expectedLit_)
+                {
+                    differ_++;
+                }
+            }
+        }
+
+        if (soft_)
+        {
+            TRACE(_T("Bitmap font benchmark (soft, %d frames): built-in font %.1f fps, bitmap font %.1f fps\n"),
+                frames, gdiFps_, bitmapFps_);
+        }
+        else
+        {
+            TRACE(_T("Bitmap font benchmark (mono, %d frames): DrawTextEx %.1f fps, cached %.1f fps, bitmap font %.1f fps\n"),
+                frames, gdiFps_, cachedFps_, bitmapFps_);
+        }
+        TRACE(_T("Bitmap font benchmark (%s): %d pixels differ from the built-in font: %s\n"),
+            soft_ ? _T("soft") : _T("mono"), differ_, (drawn_ && (0 == differ_)) ? _T("passed") : _T("FAILED"));
+
+        gfx_.Shutdown();
+    }
+
+    cache_.Enable(wasEnabled_);
+}
+
+VOID ExtraTester::DoNumericTextBenchmark(INT frames)
+{
+    // Stats on the mono screen, all changing every frame: formatted and
+    // set as text, then set as values. Frames are drawn the way
+    // CLCDOutput does, clearing and redrawing only the damaged area. A
+    // few more frames are checked against a full redraw afterwards.
+    const INT counters_ = 8;
+    const INT columns_ = 2;
+    const INT checks_ = 50;
+    const LONGLONG steps_[counters_] = { 1, 7, 13, 250, 1, 3, 1000, 17 };
+
+    CLCDGfxMono gfx_;
+    CLCDGfxMono full_;
+    if (FAILED(gfx_.Initialize()) || FAILED(full_.Initialize()))
+    {
+        TRACE(_T("Numeric text benchmark: failed to initialize\n"));
+        return;
+    }
+    RECT rcScreen = { 0, 0, LGLCD_BW_BMP_WIDTH, LGLCD_BW_BMP_HEIGHT };
+
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        BOOL numeric_ = (1 == pass_);
+
+        CLCDPage page_;
+        page_.SetSize(LGLCD_BW_BMP_WIDTH, LGLCD_BW_BMP_HEIGHT);
+
+        CLCDText text_[counters_];
+        CLCDNumericText numbers_[counters_];
+        for (INT index_ = 0; index_ < counters_; index_++)
+        {
+            CLCDText &counter_ = numeric_ ? numbers_[index_] : text_[index_];
+            counter_.SetOrigin((index_ % columns_) * (LGLCD_BW_BMP_WIDTH / columns_),
+                               (index_ / columns_) * (LGLCD_BW_BMP_HEIGHT / (counters_ / columns_)));
+            counter_.SetSize(LGLCD_BW_BMP_WIDTH / columns_, LGLCD_BW_BMP_HEIGHT / (counters_ / columns_));
+            counter_.SetAlignment(DT_RIGHT);
+            numbers_[index_].SetGroupSeparator(_T(','));
+            page_.AddObject(&counter_);
+        }
+
+        LONGLONG pixels_ = 0;
+        INT differ_ = 0;
+        std::vector<BYTE> partial_, expected_;
+        QueryPerformanceCounter(&start_);
+
+        for (INT frame_ = 0; frame_ < frames + checks_; frame_++)
+        {
+            if (frame_ == frames)
+            {
+                QueryPerformanceCounter(&stop_);
+            }
+
+            for (INT index_ = 0; index_ < counters_; index_++)
+            {
+                LONGLONG value_ = 1000000 + frame_ * steps_[index_];
+                if (numeric_)
+                {
+                    numbers_[index_].SetValue(value_);
+                }
+                else
+                {
+                    // what the formatted path costs per update
+                    TCHAR buffer_[32];
+                    wsprintf(buffer_, _T("%d,%03d,%03d"), (INT)(value_ / 1000000),
+                        (INT)(value_ / 1000 % 1000), (INT)(value_ % 1000));
+                    text_[index_].SetText(buffer_);
+                }
+            }
+
+            RECT damage_;
+            SetRectEmpty(&damage_);
+            page_.GetDamage(damage_);
+            IntersectRect(&damage_, &damage_, &rcScreen);
+            if (frame_ < frames)
+            {
+                pixels_ += (damage_.right - damage_.left) * (damage_.bottom - damage_.top);
+            }
+
+            gfx_.BeginDraw();
+            if (!IsRectEmpty(&damage_))
+            {
+                gfx_.ClearRect(damage_);
+                gfx_.SetDamageRect(&damage_);
+                page_.OnDraw(gfx_);
+                gfx_.SetDamageRect(NULL);
+            }
+            gfx_.EndDraw();
+            page_.ClearDamage();
+
+            if (frame_ >= frames)
+            {
+                // redrawing the damage must leave what a full redraw draws
+                CopyFrame(gfx_, partial_);
+                RenderFrame(full_, page_);
+                CopyFrame(full_, expected_);
+                if (partial_ != expected_)
+                {
+                    differ_++;
+                }
+            }
+        }
+
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        DOUBLE fps_ = (seconds_ > 0.0) ? frames / seconds_ : 0.0;
+        DOUBLE damaged_ = (0 < frames) ?
+            100.0 * pixels_ / ((DOUBLE)frames * LGLCD_BW_BMP_WIDTH * LGLCD_BW_BMP_HEIGHT) : 0.0;
+        TRACE(_T("Numeric text benchmark (%s, %d frames, %d counters): %.1f fps, %.1f%% of the screen redrawn\n"),
+            numeric_ ? _T("numeric text") : _T("formatted text"), frames, counters_, fps_, damaged_);
+        TRACE(_T("Numeric text benchmark (%s): %d of %d partial frames differ from a full redraw: %s\n"),
+            numeric_ ? _T("numeric text") : _T("formatted text"), differ_, checks_,
+            (0 == differ_) ? _T("passed") : _T("FAILED"));
+    }
+
+    full_.Shutdown();
+    gfx_.Shutdown();
+}
+
+VOID ExtraTester::DoSetTextBenchmark(INT updates)
+{
+    // A telemetry line kept in a buffer of the caller, half of the
+    // updates changing one digit and half unchanged, set terminated,
+    // with its length and moved in. Only setting is timed, not drawing.
+    const INT passes_ = 3;
+    const TCHAR *names_[passes_] = { _T("terminated"), _T("with length"), _T("moved") };
+
+    TCHAR line_[] = _T("CPU 00% RAM 1024 MB NET 000 KB/s FPS 060 GPU 00% TEMP 50 C");
+    const INT length_ = (INT)(sizeof(line_) / sizeof(line_[0])) - 1;
+
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+
+    for (INT pass_ = 0; pass_ < passes_; pass_++)
+    {
+#ifndef LCDUI_RVALUE_REFS
+        if (2 == pass_)
+        {
+            break;
+        }
+#endif
+        CLCDText text_;
+        text_.SetSize(LGLCD_BW_BMP_WIDTH, 9);
+        CLCDText::lcdstring spare_(line_, length_);
+
+        QueryPerformanceCounter(&start_);
+
+        for (INT update_ = 0; update_ < updates; update_++)
+        {
+            line_[5] = (TCHAR)(_T('0') + (update_ / 2) % 10);
+            if (0 == pass_)
+            {
+                text_.SetText(line_);
+            }
+            else if (1 == pass_)
+            {
+                text_.SetText(line_, length_);
+            }
+#ifdef LCDUI_RVALUE_REFS
+            else
+            {
+                // the string gets the buffer of the previous text back
+                spare_.assign(line_, length_);
+                text_.SetText(std::move(spare_));
+            }
+#endif
+            text_.ClearDamage();
+        }
+
+        QueryPerformanceCounter(&stop_);
+
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        TRACE(_T("SetText benchmark (%s, %d updates): %.1f updates per ms\n"),
+            names_[pass_], updates, (seconds_ > 0.0) ? updates / (seconds_ * 1000.0) : 0.0);
+    }
+}
+
+// A bitmap that counts how often its zoom cache is built
+class CZoomCountingBitmap : public CLCDBitmap
+{
+public:
+    CZoomCountingBitmap() : m_nBuilt(0) {}
+
+    virtual void OnPrepareDraw(CLCDGfxBase &rGfx)
+    {
+        BOOL valid_ = IsZoomCacheValid();
+        CLCDBitmap::OnPrepareDraw(rGfx);
+        if (!valid_ && IsZoomCacheValid())
+        {
+            m_nBuilt++;
+        }
+    }
+
+    INT m_nBuilt;
+};
+
+VOID ExtraTester::DoZoomBenchmark(INT frames)
+{
+    // A half-screen picture zoomed to the full color screen: stretched by
+    // AlphaBlend every frame, as CLCDBitmap used to, then through the
+    // zoom cache at a fixed zoom, and with a zoom changing every frame so
+    // that the cache is rebuilt each time. The cache must be built once
+    // at a fixed zoom and once per change, and going back to the fixed
+    // zoom must draw the same frame again.
+    INT width_ = LGLCD_QVGA_BMP_WIDTH / 2;
+    INT height_ = LGLCD_QVGA_BMP_HEIGHT / 2;
+
+    BYTE *bits_ = NULL;
+    HBITMAP bitmap_ = CreateBitmap32(width_, height_, &bits_);
+    if (NULL == bitmap_)
+    {
+        TRACE(_T("Zoom benchmark: failed to create bitmap\n"));
+        return;
+    }
+
+    for (INT y_ = 0; y_ < height_; y_++)
+    {
+        for (INT x_ = 0; x_ < width_; x_++)
+        {
+            BYTE *pixel_ = &bits_[(y_ * width_ + x_) * 4];
+            pixel_[0] = (BYTE)(x_ * 255 / width_);
+            pixel_[1] = (BYTE)(y_ * 255 / height_);
+            pixel_[2] = (BYTE)(((x_ / 8) + (y_ / 8)) % 2 ? 255 : 0);
+            pixel_[3] = 255;
+        }
+    }
+    GdiFlush();
+
+    CLCDGfxColor gfx_;
+    if (FAILED(gfx_.Initialize()))
+    {
+        TRACE(_T("Zoom benchmark: failed to initialize\n"));
+        DeleteObject(bitmap_);
+        return;
+    }
+
+    CZoomCountingBitmap zoomed_;
+    zoomed_.SetBitmap(bitmap_);
+    zoomed_.SetSize(width_, height_);
+
+    LARGE_INTEGER frequency_;
+    QueryPerformanceFrequency(&frequency_);
+    INT built_[3] = { 0, 0, 0 };
+    std::vector<BYTE> fixedFrame_, blank_, frame_;
+
+    for (INT pass_ = 0; pass_ < 3; pass_++)
+    {
+        const TCHAR *names_[3] = { _T("AlphaBlend"), _T("cached"), _T("changing zoom") };
+        zoomed_.m_nBuilt = 0;
+
+        LARGE_INTEGER start_, stop_;
+        QueryPerformanceCounter(&start_);
+
+        for (INT frame_ = 0; frame_ < frames; frame_++)
+        {
+            gfx_.BeginDraw();
+            gfx_.ClearScreen();
+            if (0 == pass_)
+            {
+                HDC dc_ = CreateCompatibleDC(gfx_.GetHDC());
+                HBITMAP old_ = (HBITMAP)SelectObject(dc_, bitmap_);
+                BLENDFUNCTION blend_ = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+                AlphaBlend(gfx_.GetHDC(), 0, 0, width_ * 2, height_ * 2, dc_, 0, 0, width_, height_, blend_);
+                SelectObject(dc_, old_);
+                DeleteDC(dc_);
+            }
+            else
+            {
+                // as CLCDPage::OnDraw does
+                zoomed_.SetZoomLevel((1 == pass_) ? 2.0f : 1.5f + (frame_ % 50) / 100.0f);
+                zoomed_.OnPrepareDraw(gfx_);
+                zoomed_.OnDraw(gfx_);
+            }
+            gfx_.EndDraw();
+        }
+
+        QueryPerformanceCounter(&stop_);
+        built_[pass_] = zoomed_.m_nBuilt;
+        if (1 == pass_)
+        {
+            CopyFrame(gfx_, fixedFrame_);
+        }
+
+        DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+        TRACE(_T("Zoom benchmark (%d frames of %dx%d to %dx%d): %s %.1f fps\n"),
+            frames, width_, height_, width_ * 2, height_ * 2, names_[pass_],
+            (seconds_ > 0.0) ? frames / seconds_ : 0.0);
+    }
+
+    // back to the fixed zoom after the changes
+    gfx_.BeginDraw();
+    gfx_.ClearScreen();
+    gfx_.EndDraw();
+    CopyFrame(gfx_, blank_);
+    gfx_.BeginDraw();
+    gfx_.ClearScreen();
+    zoomed_.SetZoomLevel(2.0f);
+    zoomed_.OnPrepareDraw(gfx_);
+    zoomed_.OnDraw(gfx_);
+    gfx_.EndDraw();
+    CopyFrame(gfx_, frame_);
+
+    // consecutive zooms of the changing pass all differ
+    BOOL passed_ = (0 < frames) && (1 == built_[1]) && (frames == built_[2]) &&
+        (frame_ == fixedFrame_) && (frame_ != blank_);
+    TRACE(_T("Zoom benchmark: cache built %d times at a fixed zoom, %d times in %d changes, same frame after the changes %d: %s\n"),
+        built_[1], built_[2], frames, (frame_ == fixedFrame_), passed_ ? _T("passed") : _T("FAILED"));
+
+    gfx_.Shutdown();
+    DeleteObject(bitmap_);
+}
+
+VOID ExtraTester::DoIconBenchmark(INT frames)
+{
+    // A screen full of 16x16 icons on both displays: drawn with DrawIconEx
+    // every frame, as CLCDIcon used to, then from the conversion CLCDIcon
+    // keeps since SetIcon
+    const INT count_ = 40;
+    HICON icon_ = LoadIcon(NULL, IDI_INFORMATION);
+
+    CLCDIcon icons_[count_];
+    for (INT i_ = 0; i_ < count_; i_++)
+    {
+        icons_[i_].SetIcon(icon_, 16, 16);
+        icons_[i_].SetSize(16, 16);
+    }
+
+    CLCDGfxMono gfxMono_;
+    CLCDGfxColor gfxColor_;
+    CLCDGfxBase *surfaces_[2] = { &gfxMono_, &gfxColor_ };
+    const TCHAR *surfaceNames_[2] = { _T("mono"), _T("color") };
+
+    LARGE_INTEGER frequency_;
+    QueryPerformanceFrequency(&frequency_);
+
+    for (INT surface_ = 0; surface_ < 2; surface_++)
+    {
+        CLCDGfxBase &gfx_ = *surfaces_[surface_];
+        if (FAILED(gfx_.Initialize()))
+        {
+            TRACE(_T("Icon benchmark: failed to initialize\n"));
+            continue;
+        }
+        INT columns_ = gfx_.GetWidth() / 16;
+
+        for (INT pass_ = 0; pass_ < 2; pass_++)
+        {
+            LARGE_INTEGER start_, stop_;
+            QueryPerformanceCounter(&start_);
+
+            for (INT frame_ = 0; frame_ < frames; frame_++)
+            {
+                gfx_.BeginDraw();
+                gfx_.ClearScreen();
+                for (INT i_ = 0; i_ < count_; i_++)
+                {
+                    INT x_ = (i_ % columns_) * 16;
+                    INT y_ = (i_ / columns_) * 16;
+                    if (0 == pass_)
+                    {
+                        DrawIconEx(gfx_.GetHDC(), x_, y_, icon_, 16, 16, 0, NULL, DI_NORMAL);
+                    }
+                    else
+                    {
+                        POINT origin_ = { 0, 0 };
+                        SetViewportOrgEx(gfx_.GetHDC(), x_, y_, &origin_);
+                        icons_[i_].OnDraw(gfx_);
+                        SetViewportOrgEx(gfx_.GetHDC(), origin_.x, origin_.y, NULL);
+                    }
+                }
+                gfx_.EndDraw();
+            }
+
+            QueryPerformanceCounter(&stop_);
+
+            DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+            TRACE(_T("Icon benchmark (%d frames of %d icons, %s): %s %.1f fps\n"),
+                frames, count_, surfaceNames_[surface_], (0 == pass_) ? _T("DrawIconEx") : _T("converted"),
+                (seconds_ > 0.0) ? frames / seconds_ : 0.0);
+        }
+
+        gfx_.Shutdown();
+    }
+}
+
+VOID ExtraTester::DoAnimationBenchmark(INT frames)
+{
+    // A dozen animated 32x32 icons sharing one atlas of 8 frames each.
+    // First every icon draws the whole atlas clipped to its frame, as
+    // CLCDAnimatedBitmap did by moving the logical origin, then each
+    // draws its frame rectangle only. At a given time both must show the
+    // frames that follow from the durations of the icons.
+    const INT icons_ = 12;
+    const INT frameCount_ = 8;
+    const INT size_ = 32;
+    INT width_ = size_ * frameCount_;
+    INT height_ = size_ * icons_;
+
+    BYTE *bits_ = NULL;
+    HBITMAP bitmap_ = CreateBitmap32(width_, height_, &bits_);
+    if (NULL == bitmap_)
+    {
+        TRACE(_T("Animation benchmark: failed to create bitmap\n"));
+        return;
+    }
+
+    // a disc growing from frame to frame, premultiplied
+    for (INT y_ = 0; y_ < height_; y_++)
+    {
+        for (INT x_ = 0; x_ < width_; x_++)
+        {
+            INT dx_ = x_ % size_ - size_ / 2;
+            INT dy_ = y_ % size_ - size_ / 2;
+            INT radius_ = 4 + (x_ / size_) * 12 / frameCount_;
+            BYTE alpha_ = (BYTE)((dx_ * dx_ + dy_ * dy_ <= radius_ * radius_) ? 255 : 0);
+            BYTE *pixel_ = &bits_[(y_ * width_ + x_) * 4];
+            pixel_[0] = (BYTE)(alpha_ * (y_ / size_) / icons_);
+            pixel_[1] = alpha_;
+            pixel_[2] = (BYTE)(alpha_ - pixel_[0]);
+            pixel_[3] = alpha_;
+        }
+    }
+    GdiFlush();
+
+    CLCDSpriteAtlas atlas_;
+    atlas_.SetBitmap(bitmap_);
+    INT animations_[icons_];
+    for (INT icon_ = 0; icon_ < icons_; icon_++)
+    {
+        animations_[icon_] = atlas_.AddStrip(0, icon_ * size_, size_, size_, frameCount_, 50 + icon_ * 10);
+    }
+
+    for (INT pass_ = 0; pass_ < 2; pass_++)
+    {
+        CTestDisplay display_(0 == pass_);
+        INT columns_ = display_.m_nWidth / size_;
+
+        if (FAILED(display_.Initialize()))
+        {
+            TRACE(_T("Animation benchmark: failed to initialize\n"));
+            break;
+        }
+        CLCDGfxBase &gfx_ = display_.Gfx();
+
+        CLCDPage stripPage_;
+        CLCDPage atlasPage_;
+        stripPage_.SetSize(display_.m_nWidth, display_.m_nHeight);
+        atlasPage_.SetSize(display_.m_nWidth, display_.m_nHeight);
+
+        CLCDBitmap strips_[icons_];
+        CLCDAnimatedBitmap animated_[icons_];
+        for (INT icon_ = 0; icon_ < icons_; icon_++)
+        {
+            INT x_ = (icon_ % columns_) * size_;
+            INT y_ = (icon_ / columns_) * size_ % display_.m_nHeight;
+
+            strips_[icon_].SetBitmap(bitmap_);
+            strips_[icon_].SetOrigin(x_, y_);
+            strips_[icon_].SetSize(size_, size_);
+            strips_[icon_].SetLogicalSize(width_, height_);
+            strips_[icon_].SetLogicalOrigin(-size_ * (icon_ % frameCount_), -size_ * icon_);
+            stripPage_.AddObject(&strips_[icon_]);
+
+            animated_[icon_].Initialize();
+            animated_[icon_].SetOrigin(x_, y_);
+            animated_[icon_].SetSize(size_, size_);
+            animated_[icon_].SetAnimation(&atlas_, animations_[icon_]);
+            atlasPage_.AddObject(&animated_[icon_]);
+        }
+
+        DOUBLE stripFps_ = MeasureFramesPerSecond(gfx_, stripPage_, frames);
+        DOUBLE atlasFps_ = MeasureFramesPerSecond(gfx_, atlasPage_, frames);
+        TRACE(_T("Animation benchmark (%s, %d frames of %d icons): whole strip %.1f fps, frame rectangle %.1f fps\n"),
+            display_.GetName(), frames, icons_, stripFps_, atlasFps_);
+
+        // a virtual clock, at the start and later on
+        DWORD start_ = CLCDClock::Now();
+        const DWORD elapsed_[2] = { 0, 1234 };
+        std::vector<BYTE> stripFrame_, atlasFrame_, firstFrame_;
+        INT differ_[2] = { 0, 0 };
+        for (INT icon_ = 0; icon_ < icons_; icon_++)
+        {
+            animated_[icon_].SetStartTime(start_);
+        }
+
+        for (INT check_ = 0; check_ < 2; check_++)
+        {
+            for (INT icon_ = 0; icon_ < icons_; icon_++)
+            {
+                INT frame_ = (INT)(elapsed_[check_] / (50 + icon_ * 10)) % frameCount_;
+                strips_[icon_].SetLogicalOrigin(-size_ * frame_, -size_ * icon_);
+            }
+
+            CLCDPage *pages_[2] = { &stripPage_, &atlasPage_ };
+            std::vector<BYTE> *copies_[2] = { &stripFrame_, &atlasFrame_ };
+            for (INT page_ = 0; page_ < 2; page_++)
+            {
+                gfx_.BeginDraw();
+                gfx_.ClearScreen();
+                pages_[page_]->OnUpdate(start_ + elapsed_[check_]);
+                pages_[page_]->OnDraw(gfx_);
+                gfx_.EndDraw();
+                CopyFrame(gfx_, *copies_[page_]);
+            }
+
+            differ_[check_] = CountDifferences(stripFrame_, atlasFrame_, display_.m_bColor ? 2 : 0);
+            if (0 == check_)
+            {
+                firstFrame_ = atlasFrame_;
+            }
+        }
+
+        BOOL passed_ = (0 == differ_[0]) && (0 == differ_[1]) && (atlasFrame_ != firstFrame_);
+        TRACE(_T("Animation benchmark (%s): %d and %d bytes differ from the strips, frames advanced %d: %s\n"),
+            display_.GetName(), differ_[0], differ_[1], (atlasFrame_ != firstFrame_),
+            passed_ ? _T("passed") : _T("FAILED"));
+    }
+
+    DeleteObject(bitmap_);
+}
+
+VOID ExtraTester::DoAnimationStripTest(VOID)
+{
+    // An animated bitmap cut into frames by SetSubpicWidth() must show
+    // the new bitmap and use the new dither mode when they are changed
+    const INT size_ = 32;
+    const INT frameCount_ = 2;
+    const COLORREF colors_[2] = { RGB(255, 0, 0), RGB(0, 255, 0) };
+    HBITMAP bitmaps_[2] = { NULL, NULL };
+    for (INT index_ = 0; index_ < 2; index_++)
+    {
+        BYTE *bits_ = NULL;
+        bitmaps_[index_] = CreateBitmap32(size_ * frameCount_, size_, &bits_);
+        if (NULL == bitmaps_[index_])
+        {
+            TRACE(_T("Animation strip test: failed to create bitmap\n"));
+            DeleteObject(bitmaps_[0]);
+            return;
+        }
+        for (INT pixel_ = 0; pixel_ < size_ * frameCount_ * size_; pixel_++)
+        {
+            bits_[pixel_ * 4 + 0] = GetBValue(colors_[index_]);
+            bits_[pixel_ * 4 + 1] = GetGValue(colors_[index_]);
+            bits_[pixel_ * 4 + 2] = GetRValue(colors_[index_]);
+            bits_[pixel_ * 4 + 3] = 255;
+        }
+    }
+    GdiFlush();
+
+    CLCDPage page_;
+    page_.SetSize(LGLCD_QVGA_BMP_WIDTH, LGLCD_QVGA_BMP_HEIGHT);
+    CLCDAnimatedBitmap animated_;
+    animated_.Initialize();
+    animated_.SetSize(size_, size_);
+    animated_.SetBitmap(bitmaps_[0]);
+    animated_.SetSubpicWidth(size_);
+    page_.AddObject(&animated_);
+
+    CLCDGfxColor gfx_;
+    if (FAILED(gfx_.Initialize()))
+    {
+        TRACE(_T("Animation strip test: failed to initialize\n"));
+        DeleteObject(bitmaps_[0]);
+        DeleteObject(bitmaps_[1]);
+        return;
+    }
+
+    // the color in the middle of the shown frame, for each bitmap
+    BOOL shown_[2] = { FALSE, FALSE };
+    for (INT index_ = 0; index_ < 2; index_++)
+    {
+        animated_.SetBitmap(bitmaps_[index_]);
+        RenderFrame(gfx_, page_);
+        std::vector<BYTE> frame_;
+        CopyFrame(gfx_, frame_);
+        const BYTE *pixel_ = &frame_[(size_t)(size_ / 2) * gfx_.GetPitch() + (size_ / 2) * 4];
+        shown_[index_] = (RGB(pixel_[2], pixel_[1], pixel_[0]) == colors_[index_]);
+    }
+
+    animated_.SetDitherMode(CLCDDither::DITHER_DIFFUSION);
+    BOOL dithered_ = (NULL != animated_.GetAtlas()) &&
+        (CLCDDither::DITHER_DIFFUSION == animated_.GetAtlas()->GetDitherMode());
+
+    TRACE(_T("Animation strip test: first bitmap %d, second bitmap %d, dither mode %d: %s\n"),
+        shown_[0], shown_[1], dithered_,
+        (shown_[0] && shown_[1] && dithered_) ? _T("passed") : _T("FAILED"));
+
+    gfx_.Shutdown();
+    DeleteObject(bitmaps_[0]);
+    DeleteObject(bitmaps_[1]);
+}
+
+VOID ExtraTester::DoDecodeBenchmark(INT passes)
+{
+    // Decodes the PNG resources of the sample, first one after the
+    // other, then all at once with DecodeBatch()
+    const UINT resources_[] =
+    {
+        IDR_BACKGROUND, IDR_NEXT, IDR_PREVIOUS, IDR_HIGHLIGHT, IDR_LOGO_SMALL,
+        IDR_SLIDER_BASE, IDR_SLIDER_HIGHLIGHT, IDR_SLIDER_LEFT, IDR_SLIDER_MID,
+        IDR_SLIDER_RIGHT, IDR_SLIDER_BASE_2, IDR_SLIDER_HIGHLIGHT_2
+    };
+    const INT count_ = sizeof(resources_) / sizeof(resources_[0]);
+
+    HINSTANCE instance_ = AfxGetInstanceHandle();
+    CLCDImage images_[count_];
+    CLCDImageDecoder::DECODEJOB jobs_[count_];
+    ZeroMemory(jobs_, sizeof(jobs_));
+    for (INT index_ = 0; index_ < count_; index_++)
+    {
+        HRSRC resource_ = FindResource(instance_, MAKEINTRESOURCE(resources_[index_]), _T("PNG"));
+        if (NULL == resource_)
+        {
+            TRACE(_T("Decode benchmark: resource %u not found\n"), resources_[index_]);
+            return;
+        }
+        jobs_[index_].pData = (const BYTE *)LockResource(LoadResource(instance_, resource_));
+        jobs_[index_].nSize = SizeofResource(instance_, resource_);
+        jobs_[index_].pImage = &images_[index_];
+    }
+
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+
+    QueryPerformanceCounter(&start_);
+    HRESULT result_ = S_OK;
+    for (INT pass_ = 0; pass_ < passes; pass_++)
+    {
+        for (INT index_ = 0; index_ < count_; index_++)
+        {
+            HRESULT decoded_ = CLCDImageDecoder::Decode(jobs_[index_].pData, jobs_[index_].nSize, images_[index_]);
+            if (FAILED(decoded_))
+            {
+                result_ = decoded_;
+            }
+        }
+    }
+    QueryPerformanceCounter(&stop_);
+    DOUBLE serialSeconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+
+    QueryPerformanceCounter(&start_);
+    for (INT pass_ = 0; pass_ < passes; pass_++)
+    {
+        HRESULT decoded_ = CLCDImageDecoder::DecodeBatch(jobs_, count_);
+        if (FAILED(decoded_))
+        {
+            result_ = decoded_;
+        }
+    }
+    QueryPerformanceCounter(&stop_);
+    DOUBLE batchSeconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+
+    TRACE(_T("Decode benchmark (%d passes of %d images): one by one %.3f ms, batch %.3f ms per pass%s\n"),
+        passes, count_, serialSeconds_ * 1000.0 / passes, batchSeconds_ * 1000.0 / passes,
+        FAILED(result_) ? _T(", decoding FAILED") : _T(""));
+}
+
+VOID ExtraTester::RenderFrame(CLCDGfxBase &gfx, CLCDPage &page)
+{
+    // same sequence as CLCDOutput::OnDraw
+    gfx.BeginDraw();
+    gfx.ClearScreen();
+    page.OnUpdate(CLCDClock::Now());
+    page.OnDraw(gfx);
+    gfx.EndDraw();
+}
+
+VOID ExtraTester::CopyFrame(CLCDGfxBase &gfx, std::vector<BYTE> &frame)
+{
+    // the submitted pixels, packed surfaces included
+    gfx.GetLCDScreen();
+    const BYTE *bits_ = gfx.GetBits();
+    frame.assign(bits_, bits_ + (size_t)gfx.GetPitch() * gfx.GetHeight());
+}
+
+INT ExtraTester::FindScroll(CLCDGfxBase &gfx, const std::vector<BYTE> &previous, const std::vector<BYTE> &next)
+{
+    // How far next is previous moved left, where the two overlap; -1 if
+    // it is not, or if there is nothing to see
+    INT bytes_ = gfx.GetBitCount() / 8;
+    INT pitch_ = gfx.GetPitch();
+    INT rowBytes_ = gfx.GetWidth() * bytes_;
+    if ((0 == bytes_) || (previous.size() != next.size()) ||
+        (previous.size() < (size_t)pitch_ * gfx.GetHeight()))
+    {
+        return -1;
+    }
+
+    BOOL blank_ = TRUE;
+    for (size_t index_ = 0; blank_ && (index_ < next.size()); index_++)
+    {
+        blank_ = (0 == next[index_]);
+    }
+    if (blank_)
+    {
+        return -1;
+    }
+
+    for (INT shift_ = 0; shift_ < gfx.GetWidth() / 2; shift_++)
+    {
+        BOOL match_ = TRUE;
+        for (INT y_ = 0; match_ && (y_ < gfx.GetHeight()); y_++)
+        {
+            match_ = (0 == memcmp(&next[(size_t)y_ * pitch_],
+                                  &previous[(size_t)y_ * pitch_ + shift_ * bytes_],
+                                  rowBytes_ - shift_ * bytes_));
+        }
+        if (match_)
+        {
+            return shift_;
+        }
+    }
+    return -1;
+}
+
+INT ExtraTester::CountDifferences(const std::vector<BYTE> &first, const std::vector<BYTE> &second, INT tolerance)
+{
+    // bytes that differ by more than tolerance
+    if (first.size() != second.size())
+    {
+        return (INT)max(first.size(), second.size());
+    }
+
+    INT differ_ = 0;
+    for (size_t index_ = 0; index_ < first.size(); index_++)
+    {
+        if (abs((INT)first[index_] - (INT)second[index_]) > tolerance)
+        {
+            differ_++;
+        }
+    }
+    return differ_;
+}
+
+HBITMAP ExtraTester::CreateBitmap32(INT width, INT height, BYTE **bits)
+{
+    // top-down, so that row y starts at bits + y * width * 4
+    BITMAPINFO info_;
+    ZeroMemory(&info_, sizeof(info_));
+    info_.bmiHeader.biSize = sizeof(info_.bmiHeader);
+    info_.bmiHeader.biWidth = width;
+    info_.bmiHeader.biHeight = -height;
+    info_.bmiHeader.biPlanes = 1;
+    info_.bmiHeader.biBitCount = 32;
+    info_.bmiHeader.biCompression = BI_RGB;
+
+    *bits = NULL;
+    HBITMAP bitmap_ = CreateDIBSection(NULL, &info_, DIB_RGB_COLORS, (VOID **)bits, NULL, 0);
+    if ((NULL != bitmap_) && (NULL == *bits))
+    {
+        DeleteObject(bitmap_);
+        bitmap_ = NULL;
+    }
+    return bitmap_;
+}
+
+DOUBLE ExtraTester::MeasureFramesPerSecond(CLCDGfxBase &gfx, CLCDPage &page, INT frames)
+{
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+    QueryPerformanceCounter(&start_);
+
+    for (INT frame_ = 0; frame_ < frames; frame_++)
+    {
+        RenderFrame(gfx, page);
+        gfx.GetLCDScreen();
+    }
+
+    QueryPerformanceCounter(&stop_);
+
+    DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+    return (seconds_ > 0.0) ? frames / seconds_ : 0.0;
+}
+
+DOUBLE ExtraTester::MeasureFramesPerSecond(CLCDGfxBase &gfx, CLCDPage &page, CLCDProgressBar &progressBar, INT frames)
+{
+    LARGE_INTEGER frequency_, start_, stop_;
+    QueryPerformanceFrequency(&frequency_);
+    QueryPerformanceCounter(&start_);
+
+    for (INT frame_ = 0; frame_ < frames; frame_++)
+    {
+        progressBar.SetPos((FLOAT)(frame_ % 100));
+
+        // same sequence as CLCDOutput::OnDraw
+        gfx.BeginDraw();
+        gfx.ClearScreen();
+        page.OnUpdate(CLCDClock::Now());
+        page.OnDraw(gfx);
+        gfx.EndDraw();
+        gfx.GetLCDScreen();
+    }
+
+    QueryPerformanceCounter(&stop_);
+
+    DOUBLE seconds_ = (DOUBLE)(stop_.QuadPart - start_.QuadPart) / (DOUBLE)frequency_.QuadPart;
+    return (seconds_ > 0.0) ? frames / seconds_ : 0.0;
+}
@@ -1,22 +1,58 @@
-#ifndef EXTRA_TESTER_H_INCLUDED_
-#define EXTRA_TESTER_H_INCLUDED_
-
-#include "EZ_LCD.h"
-#include <vector>
-
-class ExtraTester
-{
-public:
-    static VOID DoButtonTestingMono(CEzLcd &lcd);
-    static VOID DoButtonTestingColor(CEzLcd &lcd);
-
-    static VOID DoScreenPriorityTesting(CEzLcd &lcd);
-
-    static VOID DoForegroundTesting(CEzLcd &lcd);
-
-    static VOID DoVisibleTesting(CEzLcd &lcd, std::vector<HANDLE> handles);
-
-    static VOID DoPageTesting(CEzLcd &lcd);
-};
-
+#ifndef EXTRA_TESTER_H_INCLUDED_
+#define EXTRA_TESTER_H_INCLUDED_
+
+#include "EZ_LCD.h"
+#include <vector>
+
+class CLCDProgressBar;
+
+class ExtraTester
+{
+public:
+    static VOID DoButtonTestingMono(CEzLcd &lcd);
+    static VOID DoButtonTestingColor(CEzLcd &lcd);
+
+    static VOID DoScreenPriorityTesting(CEzLcd &lcd);
+
+    static VOID DoForegroundTesting(CEzLcd &lcd);
+
+    static VOID DoVisibleTesting(CEzLcd &lcd, std::vector<HANDLE> handles);
+
+    static VOID DoPageTesting(CEzLcd &lcd);
+
+    static VOID DoRenderBenchmark(INT frames);
+    static VOID DoSoftSurfaceTest(VOID);
+    static VOID DoDitherBenchmark(INT frames);
+    static VOID DoCompositeBenchmark(INT frames);
+    static VOID DoNestedClipTest(VOID);
+    static VOID DoTileBenchmark(INT frames);
+    static VOID DoTilePrepareTest(INT frames);
+    static VOID DoMirrorDrawTest(INT frames);
+    static VOID DoGlyphCacheBenchmark(INT frames);
+    static VOID DoFontBenchmark(INT objects);
+    static VOID DoLayoutBenchmark(INT passes);
+    static VOID DoMarqueeBenchmark(INT frames);
+    static VOID DoColorTextScrollTest(INT seconds);
+    static VOID DoVirtualClockTest(INT minutes);
+    static VOID DoPaginateBenchmark(INT kilobytes);
+    static VOID DoLogViewBenchmark(INT frames);
+    static VOID DoBitmapFontBenchmark(INT frames);
+    static VOID DoNumericTextBenchmark(INT frames);
+    static VOID DoSetTextBenchmark(INT updates);
+    static VOID DoZoomBenchmark(INT frames);
+    static VOID DoIconBenchmark(INT frames);
+    static VOID DoAnimationBenchmark(INT frames);
+    static VOID DoAnimationStripTest(VOID);
+    static VOID DoDecodeBenchmark(INT passes);
+
+private:
+    static VOID RenderFrame(CLCDGfxBase &gfx, CLCDPage &page);
+    static VOID CopyFrame(CLCDGfxBase &gfx, std::vector<BYTE> &frame);
+    static INT FindScroll(CLCDGfxBase &gfx, const std::vector<BYTE> &previous, const std::vector<BYTE> &next);
+    static INT CountDifferences(const std::vector<BYTE> &first, const std::vector<BYTE> &second, INT tolerance);
+    static HBITMAP CreateBitmap32(INT width, INT height, BYTE **bits);
+    static DOUBLE MeasureFramesPerSecond(CLCDGfxBase &gfx, CLCDPage &page, INT frames);
+    static DOUBLE MeasureFramesPerSecond(CLCDGfxBase &gfx, CLCDPage &page, CLCDProgressBar &progressBar, INT frames);
+};
+
 #endif // EXTRA_TESTER_H_INCLUDED_
\ No newline at end of file
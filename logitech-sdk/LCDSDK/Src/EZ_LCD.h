@@ -1,139 +1,164 @@
-#ifndef EZLCD_H_INCLUDED_
-#define EZLCD_H_INCLUDED_
-
-
-#include "EZ_LCD_Defines.h"
-#include "EZ_LCD_Page.h"
-#include "LCDConnection.h"
-
-
-enum AppletSupportType { LG_MONOCHROME_MODE_ONLY, LG_COLOR_MODE_ONLY, LG_DUAL_MODE, LG_NONE };
-enum DisplayType { LG_MONOCHROME, LG_COLOR };
-
-class CEzLcd
-{
-public:
-    CEzLcd();
-    ~CEzLcd();
-
-    CEzLcd(LPCTSTR friendlyName);
-
-    HRESULT Initialize(LPCTSTR friendlyName, 
-        AppletSupportType supportType,
-        BOOL isAutoStartable = FALSE,
-        BOOL isPersistent = FALSE,
-        lgLcdConfigureContext * configContext = NULL,
-        lgLcdSoftbuttonsChangedContext * softbuttonChangedContext = NULL);
-
-    BOOL IsDeviceAvailable(DisplayType type);
-    VOID ModifyDisplay(DisplayType type);
-
-    INT AddNewPage();
-    INT RemovePage(INT pageNumber);
-    INT GetPageCount();
-    INT AddNumberOfPages(INT numberOfPages);
-    HRESULT ModifyControlsOnPage(INT pageNumber);
-    HRESULT ShowPage(INT pageNumber);
-    INT GetCurrentPageNumber();
-
-    VOID SetBackground(HBITMAP bitmap);
-    VOID SetBackground(COLORREF color);
-
-    HANDLE AddText(LGObjectType type, LGTextSize size, INT alignment, INT maxLengthPixels, INT numberOfLines = 1, LONG fontWeight = FW_DONTCARE);
-    HRESULT SetText(HANDLE handle, LPCTSTR text, BOOL resetScrollingTextPosition = FALSE);
-
-    //These functions are for color only.
-    //The background can either be OPAQUE or TRANSPARENT. If transparent, there is no need to
-    //set the third parameter.
-    HRESULT SetTextBackground(HANDLE handle, INT backMode, COLORREF color=RGB(0,0,0));
-    HRESULT SetTextFontColor(HANDLE handle, COLORREF color);
-
-    HANDLE AddIcon(HICON hIcon, INT sizeX, INT sizeY);
-
-    HANDLE AddProgressBar(LGProgressBarType type);
-    HRESULT SetProgressBarPosition(HANDLE handle, FLOAT percentage);
-    HRESULT SetProgressBarSize(HANDLE handle, INT width, INT height);
-
-    //This one is for color displays only
-    HRESULT SetProgressBarColors(HANDLE handle, COLORREF cursorcolor, COLORREF bordercolor);
-    HRESULT SetProgressBarBackgroundColor(HANDLE handle, COLORREF color);
-
-    //Skinned Progress Bar is for color only
-    //This type of progress bar uses LG_CURSOR and LG_FILLED types
-    //Each width and height refers to the size of the bitmap image
-    //Furthermore, do not use the non-skinned function SetProgressBarSize() -- the skinned
-    //  version does not scale and displays as the size of the background.
-    HANDLE AddSkinnedProgressBar(LGProgressBarType type);
-    HRESULT SetSkinnedProgressBarBackground(HANDLE handle, HBITMAP background, INT width, INT height);
-    HRESULT SetSkinnedProgressBarFiller(HANDLE handle, HBITMAP filler, INT width, INT height);
-    HRESULT SetSkinnedProgressBarCursor(HANDLE handle, HBITMAP cursor, INT width, INT height);
-    HRESULT SetSkinnedProgressBarThreePieceCursor(HANDLE handle, HBITMAP left, INT bmpLeftWidth, INT bmpLeftHeight,
-                             HBITMAP mid, INT bmpMidWidth, INT bmpMidHeight,
-                             HBITMAP right, INT bmpRightWidth, INT bmpRightHeight);
-    HRESULT SetSkinnedProgressHighlight(HANDLE handle, HBITMAP highlight, INT width, INT height);
-
-    HANDLE AddBitmap(INT width, INT height);
-    HRESULT SetBitmap(HANDLE handle, HBITMAP bitmap);
-
-    HRESULT SetOrigin(HANDLE handle, INT originX, INT originY);
-    HRESULT SetVisible(HANDLE handle, BOOL visible);
-
-    HRESULT SetAsForeground(BOOL setAsForeground);
-
-    HRESULT SetScreenPriority(DWORD priority);
-    DWORD GetScreenPriority();
-
-    BOOL ButtonTriggered(INT button);
-    BOOL ButtonReleased(INT button);
-    BOOL ButtonIsPressed(INT button); 
-
-    // These functions have been deprecated.
-    BOOL AnyDeviceOfThisFamilyPresent(DWORD deviceFamily);
-    HRESULT SetDeviceFamilyToUse(DWORD deviceFamily);
-    HRESULT SetPreferredDisplayFamily(DWORD deviceFamily);
-
-    VOID Update();
-
-protected:
-    static DWORD WINAPI OnButtonCB(IN INT connection, IN DWORD dwButtons, IN const PVOID pContext);
-    virtual VOID OnButtons(DWORD buttons);
-    CLCDOutput*             GetCurrentOutput();
-
-    TCHAR                   m_friendlyName[MAX_PATH];
-    CLCDConnection          m_connection;
-    AppletSupportType       m_SupportType;
-
-    LCD_PAGE_LIST           m_LCDPageListMono, m_LCDPageListColor;
-    CEzLcdPage*             m_activePageMono, *m_activePageColor;
-    INT                     m_pageCountMono, m_pageCountColor;		// How many pages there are
-    INT                     m_currentPageNumberShownMono, m_currentPageNumberShownColor;
-
-    BOOL                    m_initNeeded;
-    BOOL                    m_initSucceeded;
-    lgLcdConfigureContext * m_configContext;
-    BOOL                    m_isPersistent;
-    BOOL                    m_isAutoStartable;
-    DWORD                   m_currentDeviceFamily;
-    DWORD                   m_preferredDeviceFamily;
-
-    INT m_previousScreenPriorityBW;
-    INT m_previousScreenPriorityColor;
-
-    CRITICAL_SECTION        m_ButtonCS;
-    DWORD                   m_ButtonCache;
-    DWORD                   m_PrevButtonStatus;
-    DWORD                   m_CurrButtonStatus;
-    lgLcdSoftbuttonsChangedContext m_SBContext;
-
-    inline CEzLcdPage*      GetActivePage();
-private:
-    CLCDOutput*             m_pCurrentOutput;
-
-    LCD_PAGE_LIST&          GetPageList();
-    inline VOID             SetActivePage(CEzLcdPage*);
-    INT                     GetCurrentPageNumberShown();
-    VOID                    SetCurrentPageNumberShown(INT nPage);  
-};
-
-
-#endif
+#ifndef EZLCD_H_INCLUDED_
+#define EZLCD_H_INCLUDED_
+
+
+#include "EZ_LCD_Defines.h"
+#include "EZ_LCD_Page.h"
+#include "EZ_LCD_Batch.h"
+#include "LCDConnection.h"
+
+
+enum AppletSupportType { LG_MONOCHROME_MODE_ONLY, LG_COLOR_MODE_ONLY, LG_DUAL_MODE, LG_NONE };
+enum DisplayType { LG_MONOCHROME, LG_COLOR };
+
+class CEzLcd
+{
+public:
+    CEzLcd();
+    ~CEzLcd();
+
+    CEzLcd(LPCTSTR friendlyName);
+
+    HRESULT Initialize(LPCTSTR friendlyName, 
+        AppletSupportType supportType,
+        BOOL isAutoStartable = FALSE,
+        BOOL isPersistent = FALSE,
+        lgLcdConfigureContext * configContext = NULL,
+        lgLcdSoftbuttonsChangedContext * softbuttonChangedContext = NULL);
+
+    BOOL IsDeviceAvailable(DisplayType type);
+    VOID ModifyDisplay(DisplayType type);
+
+    INT AddNewPage();
+    INT RemovePage(INT pageNumber);
+    INT GetPageCount();
+    INT AddNumberOfPages(INT numberOfPages);
+    HRESULT ModifyControlsOnPage(INT pageNumber);
+    HRESULT ShowPage(INT pageNumber);
+    INT GetCurrentPageNumber();
+
+    VOID SetBackground(HBITMAP bitmap);
+    VOID SetBackground(COLORREF color);
+
+    HANDLE AddText(LGObjectType type, LGTextSize size, INT alignment, INT maxLengthPixels, INT numberOfLines = 1, LONG fontWeight = FW_DONTCARE);
+    HANDLE AddText(LGObjectType type, CLCDBitmapFont *pFont, INT alignment, INT maxLengthPixels, INT numberOfLines = 1);
+    HRESULT SetText(HANDLE handle, LPCTSTR text, BOOL resetScrollingTextPosition = FALSE);
+    //The text needs no terminator
+    HRESULT SetTextN(HANDLE handle, LPCTSTR text, INT length, BOOL resetScrollingTextPosition = FALSE);
+#ifdef LCDUI_RVALUE_REFS
+    //The control takes the buffer of the string
+    HRESULT SetText(HANDLE handle, std::basic_string<TCHAR> &&text, BOOL resetScrollingTextPosition = FALSE);
+#endif
+
+    //These functions are for color only.
+    //The background can either be OPAQUE or TRANSPARENT. If transparent, there is no need to
+    //set the third parameter.
+    HRESULT SetTextBackground(HANDLE handle, INT backMode, COLORREF color=RGB(0,0,0));
+    HRESULT SetTextFontColor(HANDLE handle, COLORREF color);
+
+    HANDLE AddIcon(HICON hIcon, INT sizeX, INT sizeY);
+
+    HANDLE AddProgressBar(LGProgressBarType type);
+    HRESULT SetProgressBarPosition(HANDLE handle, FLOAT percentage);
+    HRESULT SetProgressBarSize(HANDLE handle, INT width, INT height);
+
+    //This one is for color displays only
+    HRESULT SetProgressBarColors(HANDLE handle, COLORREF cursorcolor, COLORREF bordercolor);
+    HRESULT SetProgressBarBackgroundColor(HANDLE handle, COLORREF color);
+
+    //Skinned Progress Bar is for color only
+    //This type of progress bar uses LG_CURSOR and LG_FILLED types
+    //Each width and height refers to the size of the bitmap image
+    //Furthermore, do not use the non-skinned function SetProgressBarSize() -- the skinned
+    //  version does not scale and displays as the size of the background.
+    HANDLE AddSkinnedProgressBar(LGProgressBarType type);
+    HRESULT SetSkinnedProgressBarBackground(HANDLE handle, HBITMAP background, INT width, INT height);
+    HRESULT SetSkinnedProgressBarFiller(HANDLE handle, HBITMAP filler, INT width, INT height);
+    HRESULT SetSkinnedProgressBarCursor(HANDLE handle, HBITMAP cursor, INT width, INT height);
+    HRESULT SetSkinnedProgressBarThreePieceCursor(HANDLE handle, HBITMAP left, INT bmpLeftWidth, INT bmpLeftHeight,
+                             HBITMAP mid, INT bmpMidWidth, INT bmpMidHeight,
+                             HBITMAP right, INT bmpRightWidth, INT bmpRightHeight);
+    HRESULT SetSkinnedProgressHighlight(HANDLE handle, HBITMAP highlight, INT width, INT height);
+
+    HANDLE AddBitmap(INT width, INT height);
+    HRESULT SetBitmap(HANDLE handle, HBITMAP bitmap);
+    HRESULT SetBitmapDitherMode(HANDLE handle, LGDitherMode mode);
+
+    HRESULT SetOrigin(HANDLE handle, INT originX, INT originY);
+    HRESULT SetVisible(HANDLE handle, BOOL visible);
+
+    HRESULT SetAsForeground(BOOL setAsForeground);
+
+    HRESULT SetScreenPriority(DWORD priority);
+    DWORD GetScreenPriority();
+    HRESULT GetFrameCounters(DWORD* submitted, DWORD* suppressed);
+    HRESULT EnablePipelinedUpdate(BOOL enable);
+    HRESULT EnablePartialRedraw(BOOL enable);
+    HRESULT EnableTileRendering(BOOL enable);
+    HRESULT EnableMonoMirror(BOOL enable, LGDitherMode mode = LG_DITHER_ORDERED);
+
+    BOOL ButtonTriggered(INT button);
+    BOOL ButtonReleased(INT button);
+    BOOL ButtonIsPressed(INT button); 
+
+    // These functions have been deprecated.
+    BOOL AnyDeviceOfThisFamilyPresent(DWORD deviceFamily);
+    HRESULT SetDeviceFamilyToUse(DWORD deviceFamily);
+    HRESULT SetPreferredDisplayFamily(DWORD deviceFamily);
+
+    VOID Update();
+
+    // While updating, SetText(), SetProgressBarPosition(), SetOrigin() and
+    // SetVisible() are recorded and applied by CommitUpdate() in one pass
+    VOID BeginUpdate();
+    HRESULT CommitUpdate();
+    HRESULT CommitUpdate(CEzLcdBatch &batch);
+
+protected:
+    static DWORD WINAPI OnButtonCB(IN INT connection, IN DWORD dwButtons, IN const PVOID pContext);
+    virtual VOID OnButtons(DWORD buttons);
+    CLCDOutput*             GetCurrentOutput();
+    static CLCDDither::eDITHER_MODE ToDitherMode(LGDitherMode mode);
+
+    TCHAR                   m_friendlyName[MAX_PATH];
+    CLCDConnection          m_connection;
+    AppletSupportType       m_SupportType;
+
+    LCD_PAGE_LIST           m_LCDPageListMono, m_LCDPageListColor;
+    CEzLcdPage*             m_activePageMono, *m_activePageColor;
+    INT                     m_pageCountMono, m_pageCountColor;		// How many pages there are
+    INT                     m_currentPageNumberShownMono, m_currentPageNumberShownColor;
+
+    BOOL                    m_initNeeded;
+    BOOL                    m_initSucceeded;
+    lgLcdConfigureContext * m_configContext;
+    BOOL                    m_isPersistent;
+    BOOL                    m_isAutoStartable;
+    DWORD                   m_currentDeviceFamily;
+    DWORD                   m_preferredDeviceFamily;
+
+    INT m_previousScreenPriorityBW;
+    INT m_previousScreenPriorityColor;
+
+    CRITICAL_SECTION        m_ButtonCS;
+    DWORD                   m_ButtonCache;
+    DWORD                   m_PrevButtonStatus;
+    DWORD                   m_CurrButtonStatus;
+    lgLcdSoftbuttonsChangedContext m_SBContext;
+
+    CRITICAL_SECTION        m_UpdateCS;
+    BOOL                    m_batching;
+    CEzLcdBatch             m_batch;
+
+    inline CEzLcdPage*      GetActivePage();
+private:
+    CLCDOutput*             m_pCurrentOutput;
+
+    LCD_PAGE_LIST&          GetPageList();
+    inline VOID             SetActivePage(CEzLcdPage*);
+    INT                     GetCurrentPageNumberShown();
+    VOID                    SetCurrentPageNumberShown(INT nPage);  
+};
+
+
+#endif
@@ -0,0 +1,243 @@
+/****h* EZ.LCD.SDK.Wrapper/EZ_LCD_Batch.cpp
+ * NAME
+ *   EZ_LCD_Batch.cpp
+ * COPYRIGHT
+ *   The Logitech EZ LCD SDK Wrapper, including all accompanying
+ *   documentation, is protected by intellectual property laws. All rights
+ *   not expressly granted by Logitech are reserved.
+ * PURPOSE
+ *   Part of the SDK package. A batch records the changes of one tick,
+ *   on any thread, for CEzLcd::CommitUpdate() to apply all at once.
+ * MODIFICATION HISTORY
+ *   10/17/2026 - Created.
+ *
+ *******
+ */
+
+#include "LCDUI.h"
+#include "EZ_LCD_Batch.h"
+
+CEzLcdBatch::CEzLcdBatch()
+{
+}
+
+CEzLcdBatch::~CEzLcdBatch()
+{
+}
+
+/****f* LCD.SDK/CEzLcdBatch::SetText(HANDLE.handle,LPCTSTR.text,BOOL.resetScrollingTextPosition)
+* NAME
+*  HRESULT SetText(HANDLE handle,
+*   LPCTSTR text,
+*   BOOL resetScrollingTextPosition = FALSE) -- Records a new text for
+*   a text object. The text is copied.
+* INPUTS
+*  handle                     - handle to the object.
+*  text                       - text string.
+*  resetScrollingTextPosition - indicates if position of scrolling
+*                               text needs to be reset.
+* RETURN VALUE
+*  S_OK if succeeded.
+*  E_INVALIDARG if the handle or the text is NULL.
+******
+*/
+HRESULT CEzLcdBatch::SetText(HANDLE handle, LPCTSTR text, BOOL resetScrollingTextPosition)
+{
+    if (NULL == text)
+    {
+        return E_INVALIDARG;
+    }
+
+    return SetTextN(handle, text, (INT)_tcslen(text), resetScrollingTextPosition);
+}
+
+/****f* LCD.SDK/CEzLcdBatch::SetTextN(HANDLE.handle,LPCTSTR.text,INT.length,BOOL.resetScrollingTextPosition)
+* NAME
+*  HRESULT SetTextN(HANDLE handle,
+*   LPCTSTR text,
+*   INT length,
+*   BOOL resetScrollingTextPosition = FALSE) -- Records the first length
+*   characters of text for a text object. They are copied.
+* INPUTS
+*  handle                     - handle to the object.
+*  text                       - text string, that needs no terminator.
+*  length                     - number of characters of text.
+*  resetScrollingTextPosition - indicates if position of scrolling
+*                               text needs to be reset.
+* RETURN VALUE
+*  S_OK if succeeded.
+*  E_INVALIDARG if the handle or the text is NULL, or the length is
+*  negative.
+******
+*/
+HRESULT CEzLcdBatch::SetTextN(HANDLE handle, LPCTSTR text, INT length, BOOL resetScrollingTextPosition)
+{
+    if (NULL == text || 0 > length)
+    {
+        return E_INVALIDARG;
+    }
+
+    LGBatchEntry* entry_ = NULL;
+    HRESULT hRes_ = AddEntry(LG_BATCH_TEXT, handle, entry_);
+    if (FAILED(hRes_))
+    {
+        return hRes_;
+    }
+
+    entry_->textOffset = m_text.size();
+    entry_->textLength = length;
+    entry_->flag = resetScrollingTextPosition;
+    m_text.insert(m_text.end(), text, text + length);
+    return S_OK;
+}
+
+/****f* LCD.SDK/CEzLcdBatch::SetProgressBarPosition(HANDLE.handle,FLOAT.percentage)
+* NAME
+*  HRESULT SetProgressBarPosition(HANDLE handle, FLOAT percentage) --
+*  Records a new position for a progress bar.
+* INPUTS
+*  handle     - handle to the object.
+*  percentage - percentage of progress (0 to 100).
+* RETURN VALUE
+*  S_OK if succeeded.
+*  E_INVALIDARG if the handle is NULL.
+******
+*/
+HRESULT CEzLcdBatch::SetProgressBarPosition(HANDLE handle, FLOAT percentage)
+{
+    LGBatchEntry* entry_ = NULL;
+    HRESULT hRes_ = AddEntry(LG_BATCH_PROGRESS_BAR_POSITION, handle, entry_);
+    if (SUCCEEDED(hRes_))
+    {
+        entry_->percentage = percentage;
+    }
+    return hRes_;
+}
+
+/****f* LCD.SDK/CEzLcdBatch::SetOrigin(HANDLE.handle,INT.originX,INT.originY)
+* NAME
+*  HRESULT SetOrigin(HANDLE handle, INT originX, INT originY) -- Records
+*  a new origin for an object.
+* INPUTS
+*  handle  - handle to the object.
+*  originX - x axis part of the origin.
+*  originY - y axis part of the origin.
+* RETURN VALUE
+*  S_OK if succeeded.
+*  E_INVALIDARG if the handle is NULL.
+******
+*/
+HRESULT CEzLcdBatch::SetOrigin(HANDLE handle, INT originX, INT originY)
+{
+    LGBatchEntry* entry_ = NULL;
+    HRESULT hRes_ = AddEntry(LG_BATCH_ORIGIN, handle, entry_);
+    if (SUCCEEDED(hRes_))
+    {
+        entry_->x = originX;
+        entry_->y = originY;
+    }
+    return hRes_;
+}
+
+/****f* LCD.SDK/CEzLcdBatch::SetVisible(HANDLE.handle,BOOL.visible)
+* NAME
+*  HRESULT SetVisible(HANDLE handle, BOOL visible) -- Records whether
+*  an object is shown.
+* INPUTS
+*  handle  - handle to the object.
+*  visible - set to FALSE to make object invisible, TRUE to make it
+*            visible.
+* RETURN VALUE
+*  S_OK if succeeded.
+*  E_INVALIDARG if the handle is NULL.
+******
+*/
+HRESULT CEzLcdBatch::SetVisible(HANDLE handle, BOOL visible)
+{
+    LGBatchEntry* entry_ = NULL;
+    HRESULT hRes_ = AddEntry(LG_BATCH_VISIBLE, handle, entry_);
+    if (SUCCEEDED(hRes_))
+    {
+        entry_->flag = visible;
+    }
+    return hRes_;
+}
+
+/****f* LCD.SDK/CEzLcdBatch::GetCount()
+* NAME
+*  INT GetCount() -- Number of changes recorded.
+******
+*/
+INT CEzLcdBatch::GetCount()
+{
+    return (INT)m_entries.size();
+}
+
+/****f* LCD.SDK/CEzLcdBatch::Clear()
+* NAME
+*  VOID Clear() -- Forgets the changes recorded, keeping the memory
+*  for the next batch.
+******
+*/
+VOID CEzLcdBatch::Clear()
+{
+    m_entries.clear();
+    m_text.clear();
+}
+
+HRESULT CEzLcdBatch::AddEntry(LGBatchOperation operation, HANDLE handle, LGBatchEntry *&entry)
+{
+    LCDUIASSERT(NULL != handle);
+    if (NULL == handle)
+    {
+        return E_INVALIDARG;
+    }
+
+    LGBatchEntry entry_;
+    ZeroMemory(&entry_, sizeof(entry_));
+    entry_.operation = operation;
+    entry_.handle = handle;
+    m_entries.push_back(entry_);
+
+    entry = &m_entries.back();
+    return S_OK;
+}
+
+// The texts are not terminated, and an empty one may be the last
+LPCTSTR CEzLcdBatch::GetText(const LGBatchEntry &entry)
+{
+    return m_text.empty() ? _T("") : &m_text[0] + entry.textOffset;
+}
+
+// Checks every change against the type of its object, so that a batch
+// is applied whole or not at all
+HRESULT CEzLcdBatch::Validate()
+{
+    for (size_t ii = 0; ii < m_entries.size(); ii++)
+    {
+        CLCDBase* object_ = (CLCDBase*)m_entries[ii].handle;
+        LGObjectType type_ = object_->GetObjectType();
+
+        switch (m_entries[ii].operation)
+        {
+        case LG_BATCH_TEXT:
+            if (LG_STATIC_TEXT != type_ && LG_SCROLLING_TEXT != type_)
+            {
+                LCDUITRACE(_T("ERROR: batched text for an object that is not text\n"));
+                return E_INVALIDARG;
+            }
+            break;
+        case LG_BATCH_PROGRESS_BAR_POSITION:
+            if (LG_PROGRESS_BAR != type_)
+            {
+                LCDUITRACE(_T("ERROR: batched position for an object that is not a progress bar\n"));
+                return E_INVALIDARG;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return S_OK;
+}
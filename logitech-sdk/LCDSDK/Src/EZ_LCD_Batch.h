@@ -0,0 +1,53 @@
+
+#ifndef EZLCD_BATCH_H_INCLUDED_
+#define EZLCD_BATCH_H_INCLUDED_
+
+#include <vector>
+
+// The changes of one tick, recorded on any thread and applied together
+// by CEzLcd::CommitUpdate()
+class CEzLcdBatch
+{
+public:
+    CEzLcdBatch();
+    ~CEzLcdBatch();
+
+    HRESULT SetText(HANDLE handle, LPCTSTR text, BOOL resetScrollingTextPosition = FALSE);
+    HRESULT SetTextN(HANDLE handle, LPCTSTR text, INT length, BOOL resetScrollingTextPosition = FALSE);
+    HRESULT SetProgressBarPosition(HANDLE handle, FLOAT percentage);
+    HRESULT SetOrigin(HANDLE handle, INT originX, INT originY);
+    HRESULT SetVisible(HANDLE handle, BOOL visible);
+
+    INT GetCount();
+    VOID Clear();
+
+protected:
+    friend class CEzLcd;
+
+    enum LGBatchOperation { LG_BATCH_TEXT, LG_BATCH_PROGRESS_BAR_POSITION, LG_BATCH_ORIGIN, LG_BATCH_VISIBLE };
+
+    struct LGBatchEntry
+    {
+        LGBatchOperation operation;
+        HANDLE handle;
+        // offset and length of the text in m_text
+        size_t textOffset;
+        INT textLength;
+        FLOAT percentage;
+        INT x;
+        INT y;
+        BOOL flag;
+    };
+
+    HRESULT AddEntry(LGBatchOperation operation, HANDLE handle, LGBatchEntry *&entry);
+    HRESULT Validate();
+    LPCTSTR GetText(const LGBatchEntry &entry);
+
+    // the texts are kept one after the other, so that recording a tick
+    // does not allocate once the batch has been used
+    std::vector<LGBatchEntry> m_entries;
+    std::vector<TCHAR> m_text;
+};
+
+
+#endif		// EZLCD_BATCH_H_INCLUDED_
@@ -1,138 +1,274 @@
-//************************************************************************
-//
-// LCDAnimatedBitmap.cpp
-//
-// The CLCDAnimatedBitmap class draws animated bitmaps onto the LCD.
-// An animated bitmap consists of a tiled bitmap representing the
-// animation. The tile size is set with the SetSubpicWidth.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDAnimatedBitmap::CLCDAnimatedBitmap
-//
-//************************************************************************
-
-CLCDAnimatedBitmap::CLCDAnimatedBitmap(void)
-{
-    m_dwCurrSubpic = 0;
-    m_dwTotalSubpics = 0;
-}
-
-
-//************************************************************************
-//
-// CLCDAnimatedBitmap::CLCDAnimatedBitmap
-//
-//************************************************************************
-
-CLCDAnimatedBitmap::~CLCDAnimatedBitmap(void)
-{
-
-}
-
-
-//************************************************************************
-//
-// CLCDAnimatedBitmap::Initialize
-//
-//************************************************************************
-
-HRESULT CLCDAnimatedBitmap::Initialize(void)
-{
-    m_dwRate        = 250;
-    m_dwElapsedTime = 0;
-    m_dwLastUpdate = GetTickCount();
-
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// CLCDAnimatedBitmap::ResetUpdate
-//
-//************************************************************************
-
-void CLCDAnimatedBitmap::ResetUpdate(void)
-{
-    m_dwCurrSubpic = 0;
-    m_dwLastUpdate = GetTickCount();
-}
-
-
-//************************************************************************
-//
-// CLCDAnimatedBitmap::SetSubpicWidth
-//
-//************************************************************************
-
-void CLCDAnimatedBitmap::SetSubpicWidth(DWORD dwWidth)
-{
-    m_dwSubpicWidth = dwWidth;
-    LCDUIASSERT(NULL != m_hBitmap);
-    LCDUIASSERT(0 != dwWidth);
-    if((NULL != m_hBitmap) && (0 != dwWidth))
-    {
-        // figure out how many tiles we have
-        BITMAP bitmap;
-        if(GetObject(m_hBitmap, sizeof(bitmap), &bitmap))
-        {
-            m_dwTotalSubpics = bitmap.bmWidth / dwWidth;
-            SetLogicalSize(bitmap.bmWidth, bitmap.bmHeight);
-        }
-        else
-        {
-            m_dwTotalSubpics = 0;
-        }
-    }
-    else
-    {
-        m_dwTotalSubpics = 0;
-    }
-}
-
-//************************************************************************
-//
-// CLCDAnimatedBitmap::SetAnimationRate
-//
-//************************************************************************
-
-void CLCDAnimatedBitmap::SetAnimationRate(DWORD dwRate)
-{
-    m_dwRate = dwRate;
-}
-
-
-//************************************************************************
-//
-// CLCDAnimatedBitmap::OnUpdate
-//
-//************************************************************************
-
-void CLCDAnimatedBitmap::OnUpdate(DWORD dwTimestamp)
-{
-    m_dwElapsedTime = (dwTimestamp - m_dwLastUpdate);
-
-    // Just update the logical origin
-    SetLogicalOrigin(-1 * m_dwSubpicWidth * m_dwCurrSubpic, 0);
-
-    DWORD increment = m_dwElapsedTime / m_dwRate;
-    if(increment > 0)
-    {
-        m_dwCurrSubpic += increment;
-        m_dwCurrSubpic %= m_dwTotalSubpics;
-        m_dwElapsedTime %= m_dwRate;
-        m_dwLastUpdate = GetTickCount();
-    }
-}
-
-
-//** end of LCDAnimatedBitmap.cpp ****************************************
+//************************************************************************
+//
+// LCDAnimatedBitmap.cpp
+//
+// The CLCDAnimatedBitmap class draws animated bitmaps onto the LCD.
+// An animated bitmap consists of a tiled bitmap representing the
+// animation. The tile size is set with the SetSubpicWidth. Animations
+// can also be taken from a CLCDSpriteAtlas shared by many objects.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::CLCDAnimatedBitmap
+//
+//************************************************************************
+
+CLCDAnimatedBitmap::CLCDAnimatedBitmap(void)
+{
+    m_dwRate = 250;
+    m_dwStartTime = 0;
+    m_dwSubpicWidth = 0;
+    m_pAtlas = NULL;
+    m_nAnimation = -1;
+    m_nCurrFrame = -1;
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::CLCDAnimatedBitmap
+//
+//************************************************************************
+
+CLCDAnimatedBitmap::~CLCDAnimatedBitmap(void)
+{
+
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDAnimatedBitmap::Initialize(void)
+{
+    m_dwRate        = 250;
+    m_dwStartTime   = CLCDClock::Now();
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::ResetUpdate
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::ResetUpdate(void)
+{
+    SetStartTime(CLCDClock::Now());
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::SetSubpicWidth
+//
+// Turns the bitmap into an atlas with one animation of equal frames.
+//************************************************************************
+
+void CLCDAnimatedBitmap::SetSubpicWidth(DWORD dwWidth)
+{
+    m_dwSubpicWidth = dwWidth;
+    LCDUIASSERT(NULL != m_hBitmap);
+    LCDUIASSERT(0 != dwWidth);
+    if(&m_Strip == m_pAtlas)
+    {
+        SetAnimation(NULL, -1);
+    }
+
+    if((NULL != m_hBitmap) && (0 != dwWidth))
+    {
+        // figure out how many tiles we have
+        BITMAP bitmap;
+        if(GetObject(m_hBitmap, sizeof(bitmap), &bitmap) &&
+           SUCCEEDED(m_Strip.SetBitmap(m_hBitmap)))
+        {
+            m_Strip.SetDitherMode(m_eDitherMode);
+            int nAnimation = m_Strip.AddStrip(0, 0, dwWidth, bitmap.bmHeight,
+                                              bitmap.bmWidth / dwWidth, m_dwRate);
+            SetLogicalSize(dwWidth, bitmap.bmHeight);
+            SetAnimation(&m_Strip, nAnimation);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::SetBitmap
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::SetBitmap(HBITMAP hBitmap)
+{
+    CLCDBitmap::SetBitmap(hBitmap);
+
+    // the strip still refers to the frames of the old bitmap
+    if(&m_Strip == m_pAtlas)
+    {
+        if(NULL != hBitmap)
+        {
+            SetSubpicWidth(m_dwSubpicWidth);
+        }
+        else
+        {
+            SetAnimation(NULL, -1);
+            m_Strip.SetBitmap(NULL);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::SetDitherMode
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::SetDitherMode(CLCDDither::eDITHER_MODE eMode)
+{
+    CLCDBitmap::SetDitherMode(eMode);
+    if(&m_Strip == m_pAtlas)
+    {
+        m_Strip.SetDitherMode(eMode);
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::SetAnimationRate
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::SetAnimationRate(DWORD dwRate)
+{
+    m_dwRate = dwRate;
+    if(&m_Strip == m_pAtlas)
+    {
+        m_Strip.SetDuration(m_nAnimation, dwRate);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::SetAnimation
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::SetAnimation(CLCDSpriteAtlas *pAtlas, int nAnimation)
+{
+    m_pAtlas = pAtlas;
+    m_nAnimation = nAnimation;
+    m_nCurrFrame = (NULL != pAtlas) ? pAtlas->GetFrameAt(nAnimation, 0) : -1;
+    m_dwStartTime = CLCDClock::Now();
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::GetAtlas
+//
+//************************************************************************
+
+CLCDSpriteAtlas *CLCDAnimatedBitmap::GetAtlas(void)
+{
+    return m_pAtlas;
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::GetAnimation
+//
+//************************************************************************
+
+int CLCDAnimatedBitmap::GetAnimation(void)
+{
+    return m_nAnimation;
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::GetCurrentFrame
+//
+//************************************************************************
+
+int CLCDAnimatedBitmap::GetCurrentFrame(void)
+{
+    return m_nCurrFrame;
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::SetStartTime
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::SetStartTime(DWORD dwStartTime)
+{
+    m_dwStartTime = dwStartTime;
+    OnUpdate(CLCDClock::Now());
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::OnUpdate
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::OnUpdate(DWORD dwTimestamp)
+{
+    if(NULL == m_pAtlas)
+    {
+        return;
+    }
+
+    // computed from the clock, so a late update does not slow it down
+    int nFrame = m_pAtlas->GetFrameAt(m_nAnimation, dwTimestamp - m_dwStartTime);
+    if(nFrame != m_nCurrFrame)
+    {
+        m_nCurrFrame = nFrame;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDAnimatedBitmap::OnDraw
+//
+//************************************************************************
+
+void CLCDAnimatedBitmap::OnDraw(CLCDGfxBase &rGfx)
+{
+    if((NULL == m_pAtlas) || (0 > m_nCurrFrame))
+    {
+        CLCDBitmap::OnDraw(rGfx);
+        return;
+    }
+
+    // only the current frame is read
+    m_pAtlas->DrawFrame(rGfx, m_nAnimation, m_nCurrFrame, 0, 0);
+}
+
+
+//** end of LCDAnimatedBitmap.cpp ****************************************
@@ -1,49 +1,69 @@
-//************************************************************************
-//
-// LCDAnimatedBitmap.h
-//
-// The CLCDAnimatedBitmap class draws animated bitmaps onto the LCD.
-// An animated bitmap consists of a tiled bitmap representing the
-// animation. The tile size is set with the SetSubpicWidth.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-
-#ifndef _LCDANIMATEDBITMAP_H_INCLUDED_ 
-#define _LCDANIMATEDBITMAP_H_INCLUDED_ 
-
-#include "LCDBase.h"
-#include "LCDBitmap.h"
-
-class CLCDAnimatedBitmap : public CLCDBitmap
-{
-public:
-    CLCDAnimatedBitmap(void);
-    virtual ~CLCDAnimatedBitmap(void);
-
-    virtual HRESULT Initialize(void);
-    virtual void ResetUpdate(void);
-
-    void SetSubpicWidth(DWORD dwWidth);
-    void SetAnimationRate(DWORD dwRate);    // milliseconds/subpicture
-
-protected:
-    virtual void OnUpdate(DWORD dwTimestamp);
-
-private:
-    DWORD m_dwElapsedTime;  // elapsed time in state
-    DWORD m_dwRate;         // milliseconds per subpicture
-    DWORD m_dwLastUpdate;   // milliseconds
-
-    DWORD m_dwSubpicWidth;
-    DWORD m_dwCurrSubpic;
-    DWORD m_dwTotalSubpics;
-};
-
-
-#endif // !_LCDANIMATEDBITMAP_H_INCLUDED_ 
-
-//** end of LCDBitmap.h **************************************************
+//************************************************************************
+//
+// LCDAnimatedBitmap.h
+//
+// The CLCDAnimatedBitmap class draws animated bitmaps onto the LCD.
+// An animated bitmap consists of a tiled bitmap representing the
+// animation. The tile size is set with the SetSubpicWidth. Animations
+// can also be taken from a CLCDSpriteAtlas shared by many objects.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+
+#ifndef _LCDANIMATEDBITMAP_H_INCLUDED_ 
+#define _LCDANIMATEDBITMAP_H_INCLUDED_ 
+
+#include "LCDBase.h"
+#include "LCDBitmap.h"
+#include "LCDSpriteAtlas.h"
+
+class CLCDAnimatedBitmap : public CLCDBitmap
+{
+public:
+    CLCDAnimatedBitmap(void);
+    virtual ~CLCDAnimatedBitmap(void);
+
+    virtual HRESULT Initialize(void);
+    virtual void ResetUpdate(void);
+
+    void SetSubpicWidth(DWORD dwWidth);
+    void SetAnimationRate(DWORD dwRate);    // milliseconds/subpicture
+
+    // CLCDBitmap, these also rebuild the atlas made by SetSubpicWidth
+    virtual void SetBitmap(HBITMAP hBitmap);
+    virtual void SetDitherMode(CLCDDither::eDITHER_MODE eMode);
+
+    // Plays an animation of pAtlas, which is not owned and must outlive
+    // this object. The frame shown follows from the time since the start.
+    void SetAnimation(CLCDSpriteAtlas *pAtlas, int nAnimation);
+    CLCDSpriteAtlas *GetAtlas(void);
+    int GetAnimation(void);
+    int GetCurrentFrame(void);
+    // for keeping several animations in step
+    void SetStartTime(DWORD dwStartTime);
+
+    // CLCDBase
+    virtual void OnDraw(CLCDGfxBase &rGfx);
+
+protected:
+    virtual void OnUpdate(DWORD dwTimestamp);
+
+private:
+    DWORD m_dwRate;         // milliseconds per subpicture
+    DWORD m_dwStartTime;    // milliseconds
+    DWORD m_dwSubpicWidth;
+
+    CLCDSpriteAtlas *m_pAtlas;
+    int m_nAnimation;
+    int m_nCurrFrame;
+    // the atlas made by SetSubpicWidth from the bitmap
+    CLCDSpriteAtlas m_Strip;
+};
+
+
+#endif // !_LCDANIMATEDBITMAP_H_INCLUDED_ 
+
+//** end of LCDBitmap.h **************************************************
@@ -1,377 +1,510 @@
-//************************************************************************
-//
-// LCDBase.cpp
-//
-// The CLCDBase class is the generic base class for all lcd ui objects
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDBase::CLCDBase
-//
-//************************************************************************
-
-CLCDBase::CLCDBase(void)
-{
-    m_Size.cx = 0;
-    m_Size.cy = 0;
-    m_Origin.x = 0;
-    m_Origin.y = 0;
-    m_bVisible = TRUE;
-    m_bInverted = FALSE;
-    ZeroMemory(&m_ptLogical, sizeof(m_ptLogical));
-    ZeroMemory(&m_sizeLogical, sizeof(m_sizeLogical));
-    m_nBkMode = TRANSPARENT;
-    m_objectType = LG_UNKNOWN;
-    m_crBackgroundColor = RGB(0, 0, 0);
-    m_crForegroundColor = RGB(255, 255, 255);
-}
-
-
-//************************************************************************
-//
-// CLCDBase::~CLCDBase
-//
-//************************************************************************
-
-CLCDBase::~CLCDBase(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDBase::Initialize
-//
-//************************************************************************
-
-HRESULT CLCDBase::Initialize(void)
-{
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::Shutdown
-//
-//************************************************************************
-
-void CLCDBase::Shutdown(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetOrigin
-//
-//************************************************************************
-
-void CLCDBase::SetOrigin(POINT pt)
-{
-    m_Origin = pt;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetOrigin
-//
-//************************************************************************
-
-void CLCDBase::SetOrigin(int nX, int nY)
-{
-    POINT pt = { nX, nY };
-    SetOrigin(pt);
-}
-
-
-//************************************************************************
-//
-// CLCDBase::GetOrigin
-//
-//************************************************************************
-
-POINT& CLCDBase::GetOrigin(void)
-{
-    return m_Origin;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetSize
-//
-//************************************************************************
-
-void CLCDBase::SetSize(SIZE& size)
-{
-    m_Size = size;
-    SetLogicalSize(m_Size);
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetSize
-//
-//************************************************************************
-
-void CLCDBase::SetSize(int nCX, int nCY)
-{
-    SIZE size = { nCX, nCY };
-    SetSize(size);
-}
-
-
-//************************************************************************
-//
-// CLCDBase::GetSize
-//
-//************************************************************************
-
-SIZE& CLCDBase::GetSize(void)
-{
-    return m_Size;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetLogicalOrigin
-//
-//************************************************************************
-
-void CLCDBase::SetLogicalOrigin(POINT& pt)
-{
-    m_ptLogical = pt;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetLogicalOrigin
-//
-//************************************************************************
-
-void CLCDBase::SetLogicalOrigin(int nX, int nY)
-{
-    m_ptLogical.x = nX;
-    m_ptLogical.y = nY;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::GetLogicalOrigin
-//
-//************************************************************************
-
-POINT& CLCDBase::GetLogicalOrigin(void)
-{
-    return m_ptLogical;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetLogicalSize
-//
-//************************************************************************
-
-void CLCDBase::SetLogicalSize(SIZE& size)
-{
-    m_sizeLogical = size;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetLogicalSize
-//
-//************************************************************************
-
-void CLCDBase::SetLogicalSize(int nCX, int nCY)
-{
-    m_sizeLogical.cx = nCX;
-    m_sizeLogical.cy = nCY;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::GetLogicalSize
-//
-//************************************************************************
-
-SIZE& CLCDBase::GetLogicalSize(void)
-{
-    return m_sizeLogical;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::Show
-//
-//************************************************************************
-
-void CLCDBase::Show(BOOL bShow)
-{
-    m_bVisible = bShow;
-}
-
-
-//************************************************************************
-//
-// BOOL CLCDBase::
-//
-//************************************************************************
-
-BOOL CLCDBase::IsVisible(void)
-{
-    return m_bVisible;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::Invert
-//
-//************************************************************************
-
-void CLCDBase::Invert(BOOL bEnable)
-{
-    m_bInverted = bEnable;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::ResetUpdate
-//
-//************************************************************************
-
-void CLCDBase::ResetUpdate(void)
-{
-    // do nothing
-}
-
-
-//************************************************************************
-//
-// CLCDBase::OnUpdate
-//
-//************************************************************************
-
-void CLCDBase::OnUpdate(DWORD dwTimestamp)
-{
-    UNREFERENCED_PARAMETER(dwTimestamp);
-}
-
-
-//************************************************************************
-//
-// CLCDBase::OnPrepareDraw
-//
-//************************************************************************
-
-void CLCDBase::OnPrepareDraw(CLCDGfxBase &rGfx)
-{
-    UNREFERENCED_PARAMETER(rGfx);
-}
-
-
-//************************************************************************
-//
-// CLCDBase::OnDraw
-//
-//************************************************************************
-
-void CLCDBase::OnDraw(CLCDGfxBase &rGfx)
-{
-    UNREFERENCED_PARAMETER(rGfx);
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetBackgroundMode
-//
-//************************************************************************
-
-void CLCDBase::SetBackgroundMode(int nMode)
-{
-    m_nBkMode = nMode;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::GetBackgroundMode
-//
-//************************************************************************
-
-int CLCDBase::GetBackgroundMode()
-{
-    return m_nBkMode;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::GetObjectType
-//
-//************************************************************************
-
-const LGObjectType CLCDBase::GetObjectType()
-{
-    return m_objectType;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetObjectType
-//
-//************************************************************************
-
-void CLCDBase::SetObjectType(const LGObjectType type)
-{
-    m_objectType = type;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetForegroundColor
-//
-//************************************************************************
-
-void CLCDBase::SetForegroundColor(COLORREF crForeground)
-{
-    m_crForegroundColor = crForeground;
-}
-
-
-//************************************************************************
-//
-// CLCDBase::SetBackgroundColor
-//
-//************************************************************************
-
-void CLCDBase::SetBackgroundColor(COLORREF crBackground)
-{
-    m_crBackgroundColor = crBackground;
-}
-
-
-//** end of LCDBase.cpp **************************************************
+//************************************************************************
+//
+// LCDBase.cpp
+//
+// The CLCDBase class is the generic base class for all lcd ui objects
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDBase::CLCDBase
+//
+//************************************************************************
+
+CLCDBase::CLCDBase(void)
+{
+    m_Size.cx = 0;
+    m_Size.cy = 0;
+    m_Origin.x = 0;
+    m_Origin.y = 0;
+    m_bVisible = TRUE;
+    m_bInverted = FALSE;
+    ZeroMemory(&m_ptLogical, sizeof(m_ptLogical));
+    ZeroMemory(&m_sizeLogical, sizeof(m_sizeLogical));
+    m_nBkMode = TRANSPARENT;
+    m_objectType = LG_UNKNOWN;
+    m_crBackgroundColor = RGB(0, 0, 0);
+    m_crForegroundColor = RGB(255, 255, 255);
+    m_bDirty = TRUE;
+    SetRectEmpty(&m_rcDrawn);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::~CLCDBase
+//
+//************************************************************************
+
+CLCDBase::~CLCDBase(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDBase::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDBase::Initialize(void)
+{
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::Shutdown
+//
+//************************************************************************
+
+void CLCDBase::Shutdown(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetOrigin
+//
+//************************************************************************
+
+void CLCDBase::SetOrigin(POINT pt)
+{
+    if ((m_Origin.x != pt.x) || (m_Origin.y != pt.y))
+    {
+        m_Origin = pt;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetOrigin
+//
+//************************************************************************
+
+void CLCDBase::SetOrigin(int nX, int nY)
+{
+    POINT pt = { nX, nY };
+    SetOrigin(pt);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetOrigin
+//
+//************************************************************************
+
+POINT& CLCDBase::GetOrigin(void)
+{
+    return m_Origin;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetSize
+//
+//************************************************************************
+
+void CLCDBase::SetSize(SIZE& size)
+{
+    if ((m_Size.cx != size.cx) || (m_Size.cy != size.cy))
+    {
+        Invalidate();
+    }
+    m_Size = size;
+    SetLogicalSize(m_Size);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetSize
+//
+//************************************************************************
+
+void CLCDBase::SetSize(int nCX, int nCY)
+{
+    SIZE size = { nCX, nCY };
+    SetSize(size);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetSize
+//
+//************************************************************************
+
+SIZE& CLCDBase::GetSize(void)
+{
+    return m_Size;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetLogicalOrigin
+//
+//************************************************************************
+
+void CLCDBase::SetLogicalOrigin(POINT& pt)
+{
+    SetLogicalOrigin(pt.x, pt.y);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetLogicalOrigin
+//
+//************************************************************************
+
+void CLCDBase::SetLogicalOrigin(int nX, int nY)
+{
+    if ((m_ptLogical.x != nX) || (m_ptLogical.y != nY))
+    {
+        m_ptLogical.x = nX;
+        m_ptLogical.y = nY;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetLogicalOrigin
+//
+//************************************************************************
+
+POINT& CLCDBase::GetLogicalOrigin(void)
+{
+    return m_ptLogical;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetLogicalSize
+//
+//************************************************************************
+
+void CLCDBase::SetLogicalSize(SIZE& size)
+{
+    SetLogicalSize(size.cx, size.cy);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetLogicalSize
+//
+//************************************************************************
+
+void CLCDBase::SetLogicalSize(int nCX, int nCY)
+{
+    if ((m_sizeLogical.cx != nCX) || (m_sizeLogical.cy != nCY))
+    {
+        m_sizeLogical.cx = nCX;
+        m_sizeLogical.cy = nCY;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetLogicalSize
+//
+//************************************************************************
+
+SIZE& CLCDBase::GetLogicalSize(void)
+{
+    return m_sizeLogical;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::Show
+//
+//************************************************************************
+
+void CLCDBase::Show(BOOL bShow)
+{
+    if (m_bVisible != bShow)
+    {
+        m_bVisible = bShow;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// BOOL CLCDBase::
+//
+//************************************************************************
+
+BOOL CLCDBase::IsVisible(void)
+{
+    return m_bVisible;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::Invert
+//
+//************************************************************************
+
+void CLCDBase::Invert(BOOL bEnable)
+{
+    if (m_bInverted != bEnable)
+    {
+        m_bInverted = bEnable;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::ResetUpdate
+//
+//************************************************************************
+
+void CLCDBase::ResetUpdate(void)
+{
+    // do nothing
+}
+
+
+//************************************************************************
+//
+// CLCDBase::OnUpdate
+//
+//************************************************************************
+
+void CLCDBase::OnUpdate(DWORD dwTimestamp)
+{
+    UNREFERENCED_PARAMETER(dwTimestamp);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::OnPrepareDraw
+//
+//************************************************************************
+
+void CLCDBase::OnPrepareDraw(CLCDGfxBase &rGfx)
+{
+    UNREFERENCED_PARAMETER(rGfx);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::OnDraw
+//
+//************************************************************************
+
+void CLCDBase::OnDraw(CLCDGfxBase &rGfx)
+{
+    UNREFERENCED_PARAMETER(rGfx);
+}
+
+
+//************************************************************************
+//
+// CLCDBase::IsTileSafe
+//
+//************************************************************************
+
+BOOL CLCDBase::IsTileSafe(void)
+{
+    return FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetBackgroundMode
+//
+//************************************************************************
+
+void CLCDBase::SetBackgroundMode(int nMode)
+{
+    if (m_nBkMode != nMode)
+    {
+        m_nBkMode = nMode;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetBackgroundMode
+//
+//************************************************************************
+
+int CLCDBase::GetBackgroundMode()
+{
+    return m_nBkMode;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetObjectType
+//
+//************************************************************************
+
+const LGObjectType CLCDBase::GetObjectType()
+{
+    return m_objectType;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetObjectType
+//
+//************************************************************************
+
+void CLCDBase::SetObjectType(const LGObjectType type)
+{
+    m_objectType = type;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetForegroundColor
+//
+//************************************************************************
+
+void CLCDBase::SetForegroundColor(COLORREF crForeground)
+{
+    if (m_crForegroundColor != crForeground)
+    {
+        m_crForegroundColor = crForeground;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::SetBackgroundColor
+//
+//************************************************************************
+
+void CLCDBase::SetBackgroundColor(COLORREF crBackground)
+{
+    if (m_crBackgroundColor != crBackground)
+    {
+        m_crBackgroundColor = crBackground;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::Invalidate
+//
+//************************************************************************
+
+void CLCDBase::Invalidate(void)
+{
+    m_bDirty = TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::IsDirty
+//
+//************************************************************************
+
+BOOL CLCDBase::IsDirty(void)
+{
+    return m_bDirty;
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetBounds
+//
+//************************************************************************
+
+void CLCDBase::GetBounds(RECT &rcBounds)
+{
+    SetRect(&rcBounds, GetOrigin().x, GetOrigin().y,
+            GetOrigin().x + GetWidth(), GetOrigin().y + GetHeight());
+}
+
+
+//************************************************************************
+//
+// CLCDBase::GetDamage
+//
+// Adds the area that has to be redrawn to rcDamage: both where the
+// object was last drawn and where it will be drawn now.
+//
+//************************************************************************
+
+void CLCDBase::GetDamage(RECT &rcDamage)
+{
+    if (!IsDirty())
+    {
+        return;
+    }
+
+    UnionRect(&rcDamage, &rcDamage, &m_rcDrawn);
+    if (IsVisible())
+    {
+        RECT rcBounds;
+        GetBounds(rcBounds);
+        UnionRect(&rcDamage, &rcDamage, &rcBounds);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBase::ClearDamage
+//
+//************************************************************************
+
+void CLCDBase::ClearDamage(void)
+{
+    m_bDirty = FALSE;
+    if (IsVisible())
+    {
+        GetBounds(m_rcDrawn);
+    }
+    else
+    {
+        SetRectEmpty(&m_rcDrawn);
+    }
+}
+
+
+//** end of LCDBase.cpp **************************************************
@@ -1,171 +1,614 @@
-//************************************************************************
-//
-// LCDBitmap.cpp
-//
-// The CLCDBitmap class draws bitmaps onto the LCD.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDBitmap::CLCDBitmap
-//
-//************************************************************************
-
-CLCDBitmap::CLCDBitmap(void)
-{
-    m_hBitmap = NULL;
-    m_dwROP = SRCCOPY;
-    m_fZoom = 1.0f;
-    m_bAlpha = TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::CLCDBitmap
-//
-//************************************************************************
-
-CLCDBitmap::~CLCDBitmap(void)
-{
-
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::SetBitmap
-//
-//************************************************************************
-
-void CLCDBitmap::SetBitmap(HBITMAP hBitmap)
-{
-    m_hBitmap = hBitmap;
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::GetBitmap
-//
-//************************************************************************
-HBITMAP CLCDBitmap::GetBitmap(void)
-{
-    return m_hBitmap;
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::SetBitmap
-//
-//************************************************************************
-
-void CLCDBitmap::SetROP(DWORD dwROP)
-{
-    m_dwROP = dwROP;
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::SetZoomLevel
-//
-//************************************************************************
-
-void CLCDBitmap::SetZoomLevel(float fzoom)
-{
-    m_fZoom = fzoom; 
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::GetZoomLevel
-//
-//************************************************************************
-
-float CLCDBitmap::GetZoomLevel(void)
-{
-    return m_fZoom; 
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::SetAlpha
-//
-//************************************************************************
-
-void CLCDBitmap::SetAlpha(BOOL bAlpha)
-{
-    m_bAlpha = bAlpha;
-}
-
-
-//************************************************************************
-//
-// CLCDBitmap::OnDraw
-//
-// The logical size is our 'canvas'.
-// The control size is our 'window'. The window size can be smaller than the canvas.
-// The assumption is that the bitmap size is the size of the canvas.
-//************************************************************************
-
-void CLCDBitmap::OnDraw(CLCDGfxBase &rGfx)
-{
-    if(m_hBitmap)
-    {
-        HDC hCompatibleDC = CreateCompatibleDC(rGfx.GetHDC());
-        HBITMAP hOldBitmap = (HBITMAP)SelectObject(hCompatibleDC, m_hBitmap);
-        
-        // If monochrome output, don't even bother with alpha blend
-        if (LGLCD_BMP_FORMAT_160x43x1 == rGfx.GetLCDScreen()->hdr.Format)
-        {
-            BitBlt(rGfx.GetHDC(), 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, hCompatibleDC, 0, 0, m_dwROP);
-        }
-        else
-        {
-            if(0.001f > fabs(1.0f - m_fZoom))
-            {
-                BOOL b = FALSE;
-                if(m_bAlpha)
-                {
-                    BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
-                    b = AlphaBlend(rGfx.GetHDC(), 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, hCompatibleDC, 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, opblender);
-                }
-                else
-                {
-                    BitBlt(rGfx.GetHDC(), 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, hCompatibleDC, 0, 0, m_dwROP);
-                }
-            }
-            else
-            {
-                if(m_bAlpha)
-                {
-                    BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
-                    AlphaBlend(rGfx.GetHDC(), 0, 0, (int)(m_fZoom* m_sizeLogical.cx), (int)(m_fZoom*m_sizeLogical.cy), hCompatibleDC, 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, opblender);
-                }
-                else
-                {
-                    BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, 0};
-                    AlphaBlend(rGfx.GetHDC(), 0, 0, (int)(m_fZoom* m_sizeLogical.cx), (int)(m_fZoom*m_sizeLogical.cy), hCompatibleDC, 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, opblender);
-                }
-            }
-        }
-        
-        // restores
-        SelectObject(hCompatibleDC, hOldBitmap);
-        DeleteDC(hCompatibleDC);
-    }
-}
-
-
-//** end of LCDBitmap.cpp ************************************************
+//************************************************************************
+//
+// LCDBitmap.cpp
+//
+// The CLCDBitmap class draws bitmaps onto the LCD.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDBitmap::CLCDBitmap
+//
+//************************************************************************
+
+CLCDBitmap::CLCDBitmap(void)
+{
+    m_hBitmap = NULL;
+    m_dwROP = SRCCOPY;
+    m_fZoom = 1.0f;
+    m_bAlpha = TRUE;
+    m_eDitherMode = CLCDDither::DITHER_NONE;
+    m_nDitherPitch = 0;
+    m_sizeDither.cx = m_sizeDither.cy = 0;
+    m_hDitherBitmap = NULL;
+    m_sizeZoomSource.cx = m_sizeZoomSource.cy = 0;
+    m_hZoomBitmap = NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::CLCDBitmap
+//
+//************************************************************************
+
+CLCDBitmap::~CLCDBitmap(void)
+{
+    FreeDitherCache();
+    FreeZoomCache();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::SetBitmap
+//
+//************************************************************************
+
+void CLCDBitmap::SetBitmap(HBITMAP hBitmap)
+{
+    m_hBitmap = hBitmap;
+    m_Image.SetBitmap(hBitmap);
+    UpdateDitherCache();
+    FreeZoomCache();
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::GetBitmap
+//
+//************************************************************************
+HBITMAP CLCDBitmap::GetBitmap(void)
+{
+    return m_hBitmap;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::SetBitmap
+//
+//************************************************************************
+
+void CLCDBitmap::SetROP(DWORD dwROP)
+{
+    m_dwROP = dwROP;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::SetZoomLevel
+//
+//************************************************************************
+
+void CLCDBitmap::SetZoomLevel(float fzoom)
+{
+    m_fZoom = fzoom; 
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::GetZoomLevel
+//
+//************************************************************************
+
+float CLCDBitmap::GetZoomLevel(void)
+{
+    return m_fZoom; 
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::SetAlpha
+//
+//************************************************************************
+
+void CLCDBitmap::SetAlpha(BOOL bAlpha)
+{
+    m_bAlpha = bAlpha;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::SetDitherMode
+//
+//************************************************************************
+
+void CLCDBitmap::SetDitherMode(CLCDDither::eDITHER_MODE eMode)
+{
+    if(m_eDitherMode != eMode)
+    {
+        m_eDitherMode = eMode;
+        UpdateDitherCache();
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::GetDitherMode
+//
+//************************************************************************
+
+CLCDDither::eDITHER_MODE CLCDBitmap::GetDitherMode(void)
+{
+    return m_eDitherMode;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::OnPrepareDraw
+//
+// Resamples a zoomed bitmap before the frame, so that tiles drawing
+// this object at the same time find the cache complete.
+//************************************************************************
+
+void CLCDBitmap::OnPrepareDraw(CLCDGfxBase &rGfx)
+{
+    CLCDBase::OnPrepareDraw(rGfx);
+
+    // monochrome surfaces draw the dithering result, which is not zoomed
+    if(!IsZoomed() || (32 != rGfx.GetBitCount()) || !UpdateZoomCache())
+    {
+        return;
+    }
+
+    // device contexts that the compositor cannot write fall back to GDI
+    if(NULL == rGfx.GetSoftSurface())
+    {
+        UpdateZoomBitmap();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::OnDraw
+//
+// The logical size is our 'canvas'.
+// The control size is our 'window'. The window size can be smaller than the canvas.
+// The assumption is that the bitmap size is the size of the canvas.
+//************************************************************************
+
+void CLCDBitmap::OnDraw(CLCDGfxBase &rGfx)
+{
+    CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+    if(NULL != pSoft)
+    {
+        DrawSoft(*pSoft);
+        return;
+    }
+
+    BOOL bMono = (LGLCD_BMP_FORMAT_160x43x1 == rGfx.GetLCDScreen()->hdr.Format);
+    if(bMono ? DrawPacked(rGfx) : DrawImage(rGfx))
+    {
+        return;
+    }
+
+    if(m_hBitmap)
+    {
+        HDC hCompatibleDC = CreateCompatibleDC(rGfx.GetHDC());
+        HBITMAP hSource = (bMono && (NULL != m_hDitherBitmap)) ? m_hDitherBitmap : m_hBitmap;
+        HBITMAP hOldBitmap = (HBITMAP)SelectObject(hCompatibleDC, hSource);
+        
+        // If monochrome output, don't even bother with alpha blend
+        if (bMono)
+        {
+            BitBlt(rGfx.GetHDC(), 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, hCompatibleDC, 0, 0, m_dwROP);
+        }
+        else
+        {
+            if(!IsZoomed())
+            {
+                BOOL b = FALSE;
+                if(m_bAlpha)
+                {
+                    BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+                    b = AlphaBlend(rGfx.GetHDC(), 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, hCompatibleDC, 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, opblender);
+                }
+                else
+                {
+                    BitBlt(rGfx.GetHDC(), 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, hCompatibleDC, 0, 0, m_dwROP);
+                }
+            }
+            else if(IsZoomCacheValid() && (NULL != m_hZoomBitmap))
+            {
+                // already resampled, so not stretched
+                SelectObject(hCompatibleDC, m_hZoomBitmap);
+                BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, (BYTE)(m_bAlpha ? AC_SRC_ALPHA : 0)};
+                AlphaBlend(rGfx.GetHDC(), 0, 0, m_ZoomImage.GetWidth(), m_ZoomImage.GetHeight(),
+                           hCompatibleDC, 0, 0, m_ZoomImage.GetWidth(), m_ZoomImage.GetHeight(), opblender);
+            }
+            else
+            {
+                if(m_bAlpha)
+                {
+                    BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+                    AlphaBlend(rGfx.GetHDC(), 0, 0, (int)(m_fZoom* m_sizeLogical.cx), (int)(m_fZoom*m_sizeLogical.cy), hCompatibleDC, 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, opblender);
+                }
+                else
+                {
+                    BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, 0};
+                    AlphaBlend(rGfx.GetHDC(), 0, 0, (int)(m_fZoom* m_sizeLogical.cx), (int)(m_fZoom*m_sizeLogical.cy), hCompatibleDC, 0, 0, m_sizeLogical.cx, m_sizeLogical.cy, opblender);
+                }
+            }
+        }
+        
+        // restores
+        SelectObject(hCompatibleDC, hOldBitmap);
+        DeleteDC(hCompatibleDC);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::IsTileSafe
+//
+//************************************************************************
+
+BOOL CLCDBitmap::IsTileSafe(void)
+{
+    // the caches are only written by setters and OnPrepareDraw()
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::DrawImage
+//
+// Draws the color output through the compositor, with the same
+// rectangles as the AlphaBlend() calls in OnDraw. Returns FALSE if the
+// surface or the raster operation need GDI.
+//************************************************************************
+
+BOOL CLCDBitmap::DrawImage(CLCDGfxBase &rGfx)
+{
+    if(m_Image.IsEmpty())
+    {
+        return (NULL == m_hBitmap);
+    }
+
+    RECT rcSrc = { 0, 0, m_sizeLogical.cx, m_sizeLogical.cy };
+    RECT rcDst = rcSrc;
+    if(!IsZoomed())
+    {
+        // BitBlt() applies the raster operation, only copies are ours
+        if(!m_bAlpha && (SRCCOPY != m_dwROP))
+        {
+            return FALSE;
+        }
+        rcSrc.right = rcDst.right = min(m_sizeLogical.cx, m_Image.GetWidth());
+        rcSrc.bottom = rcDst.bottom = min(m_sizeLogical.cy, m_Image.GetHeight());
+    }
+    else if(IsZoomCacheValid())
+    {
+        // resampled once, drawn as is
+        SetRect(&rcDst, 0, 0, m_ZoomImage.GetWidth(), m_ZoomImage.GetHeight());
+        return rGfx.DrawImage(rcDst, m_ZoomImage, NULL, 255, m_bAlpha);
+    }
+    else
+    {
+        rcDst.right = (int)(m_fZoom * m_sizeLogical.cx);
+        rcDst.bottom = (int)(m_fZoom * m_sizeLogical.cy);
+    }
+
+    return rGfx.DrawImage(rcDst, m_Image, &rcSrc, 255, m_bAlpha);
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::DrawPacked
+//
+// Draws the monochrome output from the cached conversion. Returns FALSE
+// if the surface or the raster operation need GDI.
+//************************************************************************
+
+BOOL CLCDBitmap::DrawPacked(CLCDGfxBase &rGfx)
+{
+    if(m_DitherBits.empty() || (SRCCOPY != m_dwROP))
+    {
+        return FALSE;
+    }
+
+    BOOL bMask = m_bAlpha && !m_DitherMask.empty();
+    return rGfx.DrawPacked(0, 0, min(m_sizeLogical.cx, m_sizeDither.cx),
+                           min(m_sizeLogical.cy, m_sizeDither.cy),
+                           &m_DitherBits[0], m_nDitherPitch,
+                           bMask ? &m_DitherMask[0] : NULL, m_nDitherPitch);
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::DrawSoft
+//
+//************************************************************************
+
+void CLCDBitmap::DrawSoft(CLCDGfxSoft &rSoft)
+{
+    if(NULL == m_hBitmap)
+    {
+        return;
+    }
+
+    // monochrome surfaces take the cached dithering result as is
+    if((32 != rSoft.GetBitCount()) && !m_DitherBits.empty())
+    {
+        BOOL bMask = m_bAlpha && !m_DitherMask.empty();
+        rSoft.BlitPacked(0, 0, min(m_sizeLogical.cx, m_sizeDither.cx),
+                         min(m_sizeLogical.cy, m_sizeDither.cy),
+                         &m_DitherBits[0], m_nDitherPitch,
+                         bMask ? &m_DitherMask[0] : NULL, m_nDitherPitch);
+        return;
+    }
+
+    if(!DrawImage(rSoft) && !m_Image.IsEmpty())
+    {
+        rSoft.Blit(0, 0, min(m_sizeLogical.cx, m_Image.GetWidth()),
+                   min(m_sizeLogical.cy, m_Image.GetHeight()),
+                   m_Image.GetBits(), m_Image.GetPitch(), m_bAlpha);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::IsZoomed
+//
+//************************************************************************
+
+BOOL CLCDBitmap::IsZoomed(void)
+{
+    return (0.001f <= fabs(1.0f - m_fZoom));
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::IsZoomCacheValid
+//
+// TRUE if the zoom cache matches the current zoom and logical size.
+//************************************************************************
+
+BOOL CLCDBitmap::IsZoomCacheValid(void)
+{
+    int nWidth = (int)(m_fZoom * m_sizeLogical.cx);
+    int nHeight = (int)(m_fZoom * m_sizeLogical.cy);
+    return !m_ZoomImage.IsEmpty() && (m_ZoomImage.GetWidth() == nWidth) && (m_ZoomImage.GetHeight() == nHeight) &&
+           (m_sizeZoomSource.cx == m_sizeLogical.cx) && (m_sizeZoomSource.cy == m_sizeLogical.cy);
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::UpdateZoomCache
+//
+// Resamples the logical part of the image to the zoomed size, unless it
+// already is. Returns FALSE if there is nothing to resample.
+//************************************************************************
+
+BOOL CLCDBitmap::UpdateZoomCache(void)
+{
+    if(IsZoomCacheValid())
+    {
+        return TRUE;
+    }
+
+    FreeZoomCache();
+
+    // the same rectangles as the AlphaBlend() calls in OnDraw
+    int nWidth = (int)(m_fZoom * m_sizeLogical.cx);
+    int nHeight = (int)(m_fZoom * m_sizeLogical.cy);
+    RECT rcSrc = { 0, 0, m_sizeLogical.cx, m_sizeLogical.cy };
+    if(m_Image.IsEmpty() || FAILED(m_ZoomImage.CreateScaled(m_Image, &rcSrc, nWidth, nHeight)))
+    {
+        return FALSE;
+    }
+    m_sizeZoomSource = m_sizeLogical;
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::UpdateZoomBitmap
+//
+// Copies the zoom cache into a 32bpp DIB section, for drawing with GDI.
+//************************************************************************
+
+BOOL CLCDBitmap::UpdateZoomBitmap(void)
+{
+    if(!UpdateZoomCache())
+    {
+        return FALSE;
+    }
+    if(NULL != m_hZoomBitmap)
+    {
+        return TRUE;
+    }
+
+    BITMAPINFO bmi;
+    ZeroMemory(&bmi, sizeof(bmi));
+    bmi.bmiHeader.biSize = sizeof(bmi.bmiHeader);
+    bmi.bmiHeader.biWidth = m_ZoomImage.GetWidth();
+    bmi.bmiHeader.biHeight = -m_ZoomImage.GetHeight();
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    PBYTE pBits = NULL;
+    m_hZoomBitmap = CreateDIBSection(NULL, &bmi, DIB_RGB_COLORS, (void **)&pBits, NULL, 0);
+    if((NULL == m_hZoomBitmap) || (NULL == pBits))
+    {
+        LCDUITRACE(_T("CLCDBitmap::UpdateZoomBitmap(): CreateDIBSection failed.\n"));
+        if(NULL != m_hZoomBitmap)
+        {
+            DeleteObject(m_hZoomBitmap);
+            m_hZoomBitmap = NULL;
+        }
+        return FALSE;
+    }
+
+    memcpy(pBits, m_ZoomImage.GetBits(), (size_t)m_ZoomImage.GetPitch() * m_ZoomImage.GetHeight());
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::FreeZoomCache
+//
+//************************************************************************
+
+void CLCDBitmap::FreeZoomCache(void)
+{
+    if(NULL != m_hZoomBitmap)
+    {
+        DeleteObject(m_hZoomBitmap);
+        m_hZoomBitmap = NULL;
+    }
+    m_ZoomImage.Clear();
+    m_sizeZoomSource.cx = m_sizeZoomSource.cy = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::UpdateDitherCache
+//
+// Reads the bitmap back as 32bpp and dithers it, or thresholds it with
+// DITHER_NONE, as the soft surfaces do. The bitmap must not be selected
+// into a device context at this point.
+//************************************************************************
+
+void CLCDBitmap::UpdateDitherCache(void)
+{
+    FreeDitherCache();
+
+    if(NULL == m_hBitmap)
+    {
+        return;
+    }
+
+    DIBSECTION ds;
+    ZeroMemory(&ds, sizeof(ds));
+    int nObjectSize = GetObject(m_hBitmap, sizeof(ds), &ds);
+    if((0 == nObjectSize) || (0 >= ds.dsBm.bmWidth) || (0 == ds.dsBm.bmHeight))
+    {
+        LCDUITRACE(_T("CLCDBitmap::UpdateDitherCache(): invalid bitmap.\n"));
+        return;
+    }
+    // only DIB sections of 32bpp carry an alpha channel
+    BOOL bHasAlpha = (sizeof(ds) == nObjectSize) && (32 == ds.dsBm.bmBitsPixel);
+
+    int nWidth = ds.dsBm.bmWidth;
+    int nHeight = abs(ds.dsBm.bmHeight);
+
+    BITMAPINFO bmi;
+    ZeroMemory(&bmi, sizeof(bmi));
+    bmi.bmiHeader.biSize = sizeof(bmi.bmiHeader);
+    bmi.bmiHeader.biWidth = nWidth;
+    bmi.bmiHeader.biHeight = -nHeight;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    std::vector<BYTE> Pixels((size_t)nWidth * nHeight * 4);
+    HDC hDC = CreateCompatibleDC(NULL);
+    int nLines = GetDIBits(hDC, m_hBitmap, 0, nHeight, &Pixels[0], &bmi, DIB_RGB_COLORS);
+    DeleteDC(hDC);
+    if(nLines != nHeight)
+    {
+        LCDUITRACE(_T("CLCDBitmap::UpdateDitherCache(): GetDIBits failed.\n"));
+        return;
+    }
+
+    m_sizeDither.cx = nWidth;
+    m_sizeDither.cy = nHeight;
+    m_nDitherPitch = CLCDDither::GetPackedPitch(nWidth);
+    m_DitherBits.resize((size_t)m_nDitherPitch * nHeight);
+    CLCDDither::Dither(&Pixels[0], nWidth * 4, nWidth, nHeight,
+                       &m_DitherBits[0], m_nDitherPitch, m_eDitherMode);
+    if(bHasAlpha)
+    {
+        m_DitherMask.resize(m_DitherBits.size());
+        CLCDDither::AlphaMask(&Pixels[0], nWidth * 4, nWidth, nHeight,
+                              &m_DitherMask[0], m_nDitherPitch);
+    }
+
+    // 8bpp copy with the palette of the monochrome surface, so that a
+    // BitBlt onto it is a plain copy
+    std::vector<BYTE> Info(sizeof(BITMAPINFOHEADER) + 256 * sizeof(RGBQUAD));
+    BITMAPINFO *pInfo = (BITMAPINFO *)&Info[0];
+    pInfo->bmiHeader = bmi.bmiHeader;
+    pInfo->bmiHeader.biBitCount = 8;
+    pInfo->bmiHeader.biClrUsed = 256;
+    for(int nColor = 0; nColor < 256; ++nColor)
+    {
+        BYTE byLevel = (BYTE)((nColor > 128) ? 255 : 0);
+        pInfo->bmiColors[nColor].rgbRed = byLevel;
+        pInfo->bmiColors[nColor].rgbGreen = byLevel;
+        pInfo->bmiColors[nColor].rgbBlue = byLevel;
+        pInfo->bmiColors[nColor].rgbReserved = 0;
+    }
+
+    PBYTE pBits = NULL;
+    m_hDitherBitmap = CreateDIBSection(NULL, pInfo, DIB_RGB_COLORS, (void **)&pBits, NULL, 0);
+    if((NULL == m_hDitherBitmap) || (NULL == pBits))
+    {
+        LCDUITRACE(_T("CLCDBitmap::UpdateDitherCache(): CreateDIBSection failed.\n"));
+        return;
+    }
+
+    int nPitch = (nWidth + 3) & ~3;
+    for(int y = 0; y < nHeight; ++y)
+    {
+        CLCDGfxSoft::ExpandPackedRow(&m_DitherBits[(size_t)y * m_nDitherPitch],
+                                     pBits + y * nPitch, nWidth);
+    }
+    GdiFlush();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmap::FreeDitherCache
+//
+//************************************************************************
+
+void CLCDBitmap::FreeDitherCache(void)
+{
+    if(NULL != m_hDitherBitmap)
+    {
+        DeleteObject(m_hDitherBitmap);
+        m_hDitherBitmap = NULL;
+    }
+    m_DitherBits.clear();
+    m_DitherMask.clear();
+    m_nDitherPitch = 0;
+    m_sizeDither.cx = m_sizeDither.cy = 0;
+}
+
+
+//** end of LCDBitmap.cpp ************************************************
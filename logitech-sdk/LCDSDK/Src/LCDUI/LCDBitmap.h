@@ -1,46 +1,86 @@
-//************************************************************************
-//
-// LCDBitmap.h
-//
-// The CLCDBitmap class draws bitmaps onto the LCD.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#ifndef _LCDBITMAP_H_INCLUDED_ 
-#define _LCDBITMAP_H_INCLUDED_ 
-
-#include "LCDBase.h"
-
-class CLCDBitmap : public CLCDBase
-{
-public:
-    CLCDBitmap();
-    virtual ~CLCDBitmap(); 
-
-    // CLCDBase
-    virtual void OnDraw(CLCDGfxBase &rGfx);
-
-    void SetBitmap(HBITMAP hBitmap);
-    HBITMAP GetBitmap(void);
-    void SetROP(DWORD dwROP);
-    void SetZoomLevel(float fzoom);
-    float GetZoomLevel(void);
-    void SetAlpha(BOOL bAlpha);
-
-protected:   
-    HBITMAP m_hBitmap;
-    DWORD   m_dwROP;
-    float   m_fZoom;
-    // this indicates the bitmap has an alpha channel
-    BOOL    m_bAlpha;
-
-private:
-};
-
-
-#endif // !_LCDBITMAP_H_INCLUDED_ 
-
-//** end of LCDBitmap.h **************************************************
+//************************************************************************
+//
+// LCDBitmap.h
+//
+// The CLCDBitmap class draws bitmaps onto the LCD.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDBITMAP_H_INCLUDED_ 
+#define _LCDBITMAP_H_INCLUDED_ 
+
+#include "LCDBase.h"
+#include "LCDDither.h"
+#include "LCDCompositor.h"
+
+class CLCDBitmap : public CLCDBase
+{
+public:
+    CLCDBitmap();
+    virtual ~CLCDBitmap(); 
+
+    // CLCDBase
+    virtual void OnPrepareDraw(CLCDGfxBase &rGfx);
+    virtual void OnDraw(CLCDGfxBase &rGfx);
+    virtual BOOL IsTileSafe(void);
+
+    virtual void SetBitmap(HBITMAP hBitmap);
+    HBITMAP GetBitmap(void);
+    void SetROP(DWORD dwROP);
+    void SetZoomLevel(float fzoom);
+    float GetZoomLevel(void);
+    void SetAlpha(BOOL bAlpha);
+
+    // How the bitmap is converted for the monochrome display. The result
+    // is computed once, when the bitmap or the mode is set, and copied
+    // as is on every frame.
+    virtual void SetDitherMode(CLCDDither::eDITHER_MODE eMode);
+    CLCDDither::eDITHER_MODE GetDitherMode(void);
+
+protected:
+    BOOL DrawImage(CLCDGfxBase &rGfx);
+    BOOL DrawPacked(CLCDGfxBase &rGfx);
+    void DrawSoft(CLCDGfxSoft &rSoft);
+    void UpdateDitherCache(void);
+    void FreeDitherCache(void);
+    BOOL IsZoomed(void);
+    BOOL IsZoomCacheValid(void);
+    BOOL UpdateZoomCache(void);
+    BOOL UpdateZoomBitmap(void);
+    void FreeZoomCache(void);
+
+protected:   
+    HBITMAP m_hBitmap;
+    DWORD   m_dwROP;
+    float   m_fZoom;
+    // this indicates the bitmap has an alpha channel
+    BOOL    m_bAlpha;
+    // premultiplied copy of the bitmap for the compositor
+    CLCDImage m_Image;
+
+    // packed 1bpp result of the dithering, and the alpha mask if any
+    CLCDDither::eDITHER_MODE m_eDitherMode;
+    std::vector<BYTE> m_DitherBits;
+    std::vector<BYTE> m_DitherMask;
+    int     m_nDitherPitch;
+    SIZE    m_sizeDither;
+    // the same result as an 8bpp DIB section, for device contexts
+    HBITMAP m_hDitherBitmap;
+
+    // m_Image resampled to the zoomed size, kept until the bitmap or the
+    // size changes, and its DIB section when drawn with GDI. Both are
+    // made in OnPrepareDraw(), OnDraw() only reads them.
+    CLCDImage m_ZoomImage;
+    SIZE    m_sizeZoomSource;
+    HBITMAP m_hZoomBitmap;
+
+private:
+};
+
+
+#endif // !_LCDBITMAP_H_INCLUDED_ 
+
+//** end of LCDBitmap.h **************************************************
@@ -0,0 +1,1134 @@
+//************************************************************************
+//
+// LCDBitmapFont.cpp
+//
+// The CLCDBitmapFont class loads a bitmap font, BDF or PCF, and draws
+// text with it pixel for pixel, without GDI.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+#include <algorithm>
+
+// PCF table types and format bits
+enum
+{
+    PCF_ACCELERATORS = 0x0002,
+    PCF_METRICS = 0x0004,
+    PCF_BITMAPS = 0x0008,
+    PCF_BDF_ENCODINGS = 0x0020,
+    PCF_BDF_ACCELERATORS = 0x0100,
+
+    PCF_GLYPH_PAD_MASK = 0x0003,
+    PCF_BYTE_MASK = 0x0004,
+    PCF_BIT_MASK = 0x0008,
+    PCF_SCAN_UNIT_SHIFT = 4,
+    PCF_COMPRESSED_METRICS = 0x0100
+};
+
+
+//************************************************************************
+//
+// ReadPCF32
+//
+//************************************************************************
+
+static DWORD ReadPCF32(const BYTE *p, BOOL bMSBFirst)
+{
+    if(bMSBFirst)
+    {
+        return ((DWORD)p[0] << 24) | ((DWORD)p[1] << 16) | ((DWORD)p[2] << 8) | (DWORD)p[3];
+    }
+    return ((DWORD)p[3] << 24) | ((DWORD)p[2] << 16) | ((DWORD)p[1] << 8) | (DWORD)p[0];
+}
+
+
+//************************************************************************
+//
+// ReadPCF16
+//
+//************************************************************************
+
+static int ReadPCF16(const BYTE *p, BOOL bMSBFirst)
+{
+    return (short)(bMSBFirst ? ((p[0] << 8) | p[1]) : ((p[1] << 8) | p[0]));
+}
+
+
+//************************************************************************
+//
+// ReverseBits
+//
+//************************************************************************
+
+static BYTE ReverseBits(BYTE by)
+{
+    by = (BYTE)(((by & 0xF0) >> 4) | ((by & 0x0F) << 4));
+    by = (BYTE)(((by & 0xCC) >> 2) | ((by & 0x33) << 2));
+    by = (BYTE)(((by & 0xAA) >> 1) | ((by & 0x55) << 1));
+    return by;
+}
+
+
+//************************************************************************
+//
+// IsBDFKeyword
+//
+//************************************************************************
+
+static BOOL IsBDFKeyword(const char *pLine, const char *pLineEnd, const char *szKeyword)
+{
+    int nKeyword = (int)strlen(szKeyword);
+    return (pLineEnd - pLine >= nKeyword) && (0 == strncmp(pLine, szKeyword, nKeyword)) &&
+        ((pLineEnd - pLine == nKeyword) || (' ' == pLine[nKeyword]) || ('\t' == pLine[nKeyword]));
+}
+
+
+//************************************************************************
+//
+// ParseBDFInts
+//
+// Reads up to nCount integers after the keyword, returns how many
+//
+//************************************************************************
+
+static int ParseBDFInts(const char *pLine, const char *pLineEnd, int *pValues, int nCount)
+{
+    // past the keyword
+    const char *p = pLine;
+    while((p < pLineEnd) && (' ' != *p) && ('\t' != *p))
+    {
+        p++;
+    }
+
+    int nParsed = 0;
+    while(nParsed < nCount)
+    {
+        while((p < pLineEnd) && ((' ' == *p) || ('\t' == *p)))
+        {
+            p++;
+        }
+
+        BOOL bNegative = FALSE;
+        if((p < pLineEnd) && (('-' == *p) || ('+' == *p)))
+        {
+            bNegative = ('-' == *p);
+            p++;
+        }
+        if((p >= pLineEnd) || (*p < '0') || (*p > '9'))
+        {
+            break;
+        }
+
+        int nValue = 0;
+        while((p < pLineEnd) && (*p >= '0') && (*p <= '9'))
+        {
+            nValue = nValue * 10 + (*p - '0');
+            p++;
+        }
+        pValues[nParsed++] = bNegative ? -nValue : nValue;
+    }
+    return nParsed;
+}
+
+
+//************************************************************************
+//
+// HexDigit
+//
+//************************************************************************
+
+static int HexDigit(char c)
+{
+    if((c >= '0') && (c <= '9'))
+    {
+        return c - '0';
+    }
+    if((c >= 'A') && (c <= 'F'))
+    {
+        return c - 'A' + 10;
+    }
+    if((c >= 'a') && (c <= 'f'))
+    {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::CLCDBitmapFont
+//
+//************************************************************************
+
+CLCDBitmapFont::CLCDBitmapFont(void)
+{
+    Unload();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::~CLCDBitmapFont
+//
+//************************************************************************
+
+CLCDBitmapFont::~CLCDBitmapFont(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::LoadFile
+//
+//************************************************************************
+
+HRESULT CLCDBitmapFont::LoadFile(LPCTSTR szPath)
+{
+    HANDLE hFile = CreateFile(szPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if(INVALID_HANDLE_VALUE == hFile)
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadFile(): could not open %s.\n"), szPath);
+        return E_FAIL;
+    }
+
+    std::vector<BYTE> Data;
+    DWORD dwSize = GetFileSize(hFile, NULL);
+    DWORD dwRead = 0;
+    BOOL bRead = FALSE;
+    if((INVALID_FILE_SIZE != dwSize) && (0 < dwSize))
+    {
+        Data.resize(dwSize);
+        bRead = ReadFile(hFile, &Data[0], dwSize, &dwRead, NULL) && (dwRead == dwSize);
+    }
+    CloseHandle(hFile);
+
+    if(!bRead)
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadFile(): could not read %s.\n"), szPath);
+        return E_FAIL;
+    }
+
+    if((4 <= dwSize) && (0 == memcmp(&Data[0], "\1fcp", 4)))
+    {
+        return LoadPCF(&Data[0], (int)dwSize);
+    }
+    return LoadBDF((const char *)&Data[0], (int)dwSize);
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::LoadBDF
+//
+//************************************************************************
+
+HRESULT CLCDBitmapFont::LoadBDF(const char *pData, int nSize)
+{
+    Unload();
+    if((NULL == pData) || (9 > nSize) || (0 != strncmp(pData, "STARTFONT", 9)))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadBDF(): not a BDF font.\n"));
+        return E_INVALIDARG;
+    }
+
+    ENCODING_LIST Encodings;
+    int nDefaultChar = -1;
+    int nBoundingBox[4] = { 0, 0, 0, 0 };
+    BOOL bAscent = FALSE;
+    BOOL bDescent = FALSE;
+
+    // the glyph being read
+    int nEncoding = -1;
+    int nAdvance = 0;
+    int nBBX[4] = { 0, 0, 0, 0 };
+    std::vector<BYTE> Rows;
+    int nRowBytes = 0;
+    int nRow = 0;
+    BOOL bInBitmap = FALSE;
+
+    const char *pEnd = pData + nSize;
+    const char *pLine = pData;
+    while(pLine < pEnd)
+    {
+        const char *pLineEnd = pLine;
+        while((pLineEnd < pEnd) && ('\n' != *pLineEnd) && ('\r' != *pLineEnd))
+        {
+            pLineEnd++;
+        }
+
+        if(bInBitmap)
+        {
+            if(IsBDFKeyword(pLine, pLineEnd, "ENDCHAR"))
+            {
+                if(0 <= nEncoding)
+                {
+                    // relative to the baseline until the ascent is known
+                    GLYPH Glyph;
+                    Glyph.nWidth = nBBX[0];
+                    Glyph.nHeight = nBBX[1];
+                    Glyph.nOffsetX = nBBX[2];
+                    Glyph.nOffsetY = -(nBBX[1] + nBBX[3]);
+                    Glyph.nAdvance = nAdvance;
+                    Encodings.push_back(std::make_pair((DWORD)nEncoding, (int)m_Glyphs.size()));
+                    AddGlyph(Glyph, Rows.empty() ? NULL : &Rows[0], nRowBytes, TRUE);
+                }
+                bInBitmap = FALSE;
+            }
+            else if(nRow < nBBX[1])
+            {
+                PBYTE pRow = &Rows[nRow * nRowBytes];
+                const char *p = pLine;
+                for(int i = 0; (i < nRowBytes) && (p + 1 < pLineEnd); i++, p += 2)
+                {
+                    int nHigh = HexDigit(p[0]);
+                    int nLow = HexDigit(p[1]);
+                    if((0 > nHigh) || (0 > nLow))
+                    {
+                        break;
+                    }
+                    pRow[i] = (BYTE)((nHigh << 4) | nLow);
+                }
+                nRow++;
+            }
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "FONTBOUNDINGBOX"))
+        {
+            ParseBDFInts(pLine, pLineEnd, nBoundingBox, 4);
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "FONT_ASCENT"))
+        {
+            bAscent = (1 == ParseBDFInts(pLine, pLineEnd, &m_nAscent, 1));
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "FONT_DESCENT"))
+        {
+            bDescent = (1 == ParseBDFInts(pLine, pLineEnd, &m_nDescent, 1));
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "DEFAULT_CHAR"))
+        {
+            ParseBDFInts(pLine, pLineEnd, &nDefaultChar, 1);
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "STARTCHAR"))
+        {
+            nEncoding = -1;
+            nAdvance = 0;
+            memcpy(nBBX, nBoundingBox, sizeof(nBBX));
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "ENCODING"))
+        {
+            ParseBDFInts(pLine, pLineEnd, &nEncoding, 1);
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "DWIDTH"))
+        {
+            ParseBDFInts(pLine, pLineEnd, &nAdvance, 1);
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "BBX"))
+        {
+            ParseBDFInts(pLine, pLineEnd, nBBX, 4);
+        }
+        else if(IsBDFKeyword(pLine, pLineEnd, "BITMAP"))
+        {
+            nBBX[0] = min(max(0, nBBX[0]), (int)MAX_GLYPH_SIZE);
+            nBBX[1] = min(max(0, nBBX[1]), (int)MAX_GLYPH_SIZE);
+            nRowBytes = (nBBX[0] + 7) / 8;
+            Rows.assign(nRowBytes * nBBX[1], 0);
+            nRow = 0;
+            bInBitmap = TRUE;
+        }
+
+        pLine = pLineEnd;
+        while((pLine < pEnd) && (('\n' == *pLine) || ('\r' == *pLine)))
+        {
+            pLine++;
+        }
+    }
+
+    if(!bAscent)
+    {
+        m_nAscent = nBoundingBox[1] + nBoundingBox[3];
+    }
+    if(!bDescent)
+    {
+        m_nDescent = -nBoundingBox[3];
+    }
+
+    return FinishLoad(Encodings, nDefaultChar);
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::LoadPCF
+//
+// Reads the metrics, bitmaps, encodings and accelerators tables
+//
+//************************************************************************
+
+HRESULT CLCDBitmapFont::LoadPCF(const BYTE *pData, int nSize)
+{
+    Unload();
+    if((NULL == pData) || (8 > nSize) || (0 != memcmp(pData, "\1fcp", 4)))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): not a PCF font.\n"));
+        return E_INVALIDARG;
+    }
+
+    // the tables of contents
+    const BYTE *pMetrics = NULL, *pBitmaps = NULL, *pEncodings = NULL, *pAccelerators = NULL;
+    int nMetricsSize = 0, nBitmapsSize = 0, nEncodingsSize = 0, nAcceleratorsSize = 0;
+
+    int nTables = (int)ReadPCF32(pData + 4, FALSE);
+    if((0 >= nTables) || (nTables > (nSize - 8) / 16))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): bad table of contents.\n"));
+        return E_FAIL;
+    }
+    for(int i = 0; i < nTables; i++)
+    {
+        const BYTE *pEntry = pData + 8 + i * 16;
+        DWORD dwType = ReadPCF32(pEntry, FALSE);
+        DWORD dwTableSize = ReadPCF32(pEntry + 8, FALSE);
+        DWORD dwOffset = ReadPCF32(pEntry + 12, FALSE);
+        if((dwOffset > (DWORD)nSize) || (dwTableSize > (DWORD)nSize - dwOffset) || (4 > dwTableSize))
+        {
+            continue;
+        }
+
+        switch(dwType)
+        {
+        case PCF_METRICS:
+            pMetrics = pData + dwOffset;
+            nMetricsSize = (int)dwTableSize;
+            break;
+        case PCF_BITMAPS:
+            pBitmaps = pData + dwOffset;
+            nBitmapsSize = (int)dwTableSize;
+            break;
+        case PCF_BDF_ENCODINGS:
+            pEncodings = pData + dwOffset;
+            nEncodingsSize = (int)dwTableSize;
+            break;
+        case PCF_ACCELERATORS:
+        case PCF_BDF_ACCELERATORS:
+            // the BDF accelerators are the more accurate
+            if((NULL == pAccelerators) || (PCF_BDF_ACCELERATORS == dwType))
+            {
+                pAccelerators = pData + dwOffset;
+                nAcceleratorsSize = (int)dwTableSize;
+            }
+            break;
+        }
+    }
+    if((NULL == pMetrics) || (NULL == pBitmaps) || (NULL == pEncodings))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): missing tables.\n"));
+        return E_FAIL;
+    }
+
+    // metrics, relative to the baseline until the ascent is known
+    DWORD dwFormat = ReadPCF32(pMetrics, FALSE);
+    BOOL bMSBFirst = (0 != (dwFormat & PCF_BYTE_MASK));
+    BOOL bCompressed = (0 != (dwFormat & PCF_COMPRESSED_METRICS));
+    int nHeader = bCompressed ? 6 : 8;
+    int nMetricSize = bCompressed ? 5 : 12;
+    if(nMetricsSize < nHeader)
+    {
+        return E_FAIL;
+    }
+    int nGlyphs = bCompressed ? (WORD)ReadPCF16(pMetrics + 4, bMSBFirst) : (int)ReadPCF32(pMetrics + 4, bMSBFirst);
+    if((0 >= nGlyphs) || (nGlyphs > (nMetricsSize - nHeader) / nMetricSize))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): bad metrics.\n"));
+        return E_FAIL;
+    }
+
+    std::vector<GLYPH> Glyphs(nGlyphs);
+    for(int i = 0; i < nGlyphs; i++)
+    {
+        const BYTE *pMetric = pMetrics + nHeader + i * nMetricSize;
+        int nMetric[5];
+        for(int j = 0; j < 5; j++)
+        {
+            nMetric[j] = bCompressed ? (int)pMetric[j] - 0x80 : ReadPCF16(pMetric + j * 2, bMSBFirst);
+        }
+
+        // left and right bearing, advance, ascent, descent
+        Glyphs[i].nWidth = max(0, nMetric[1] - nMetric[0]);
+        Glyphs[i].nHeight = max(0, nMetric[3] + nMetric[4]);
+        Glyphs[i].nOffsetX = nMetric[0];
+        Glyphs[i].nOffsetY = -nMetric[3];
+        Glyphs[i].nAdvance = nMetric[2];
+    }
+
+    // bitmaps
+    dwFormat = ReadPCF32(pBitmaps, FALSE);
+    bMSBFirst = (0 != (dwFormat & PCF_BYTE_MASK));
+    BOOL bMSBitFirst = (0 != (dwFormat & PCF_BIT_MASK));
+    int nPad = 1 << (dwFormat & PCF_GLYPH_PAD_MASK);
+    int nScanUnit = 1 << ((dwFormat >> PCF_SCAN_UNIT_SHIFT) & 3);
+    // the header and the four sizes of the padded data, at least
+    if(8 + 16 > nBitmapsSize)
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): bad bitmaps.\n"));
+        return E_FAIL;
+    }
+    int nBitmaps = (int)ReadPCF32(pBitmaps + 4, bMSBFirst);
+    if((0 > nBitmaps) || (nBitmaps > (nBitmapsSize - 8 - 16) / 4))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): bad bitmaps.\n"));
+        return E_FAIL;
+    }
+    const BYTE *pOffsets = pBitmaps + 8;
+    const BYTE *pSizes = pOffsets + nBitmaps * 4;
+    const BYTE *pBitmapData = pSizes + 16;
+    int nDataSize = (int)ReadPCF32(pSizes + (dwFormat & PCF_GLYPH_PAD_MASK) * 4, bMSBFirst);
+    if((0 > nDataSize) || (nDataSize > nBitmapsSize - (int)(pBitmapData - pBitmaps)))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): bad bitmaps.\n"));
+        return E_FAIL;
+    }
+
+    std::vector<BYTE> Rows;
+    for(int i = 0; i < nGlyphs; i++)
+    {
+        GLYPH &rGlyph = Glyphs[i];
+        int nRowBytes = ((rGlyph.nWidth + nPad * 8 - 1) / (nPad * 8)) * nPad;
+        int nOffset = (i < nBitmaps) ? (int)ReadPCF32(pOffsets + i * 4, bMSBFirst) : -1;
+        if((0 > nOffset) || (nOffset > nDataSize) || (nRowBytes * rGlyph.nHeight > nDataSize - nOffset))
+        {
+            rGlyph.nWidth = rGlyph.nHeight = 0;
+            AddGlyph(rGlyph, NULL, 0, FALSE);
+            continue;
+        }
+
+        Rows.assign(pBitmapData + nOffset, pBitmapData + nOffset + nRowBytes * rGlyph.nHeight);
+
+        // bytes in the order of the bits
+        if((bMSBFirst != bMSBitFirst) && (1 < nScanUnit))
+        {
+            for(size_t j = 0; j + nScanUnit <= Rows.size(); j += nScanUnit)
+            {
+                std::reverse(Rows.begin() + j, Rows.begin() + j + nScanUnit);
+            }
+        }
+        AddGlyph(rGlyph, Rows.empty() ? NULL : &Rows[0], nRowBytes, bMSBitFirst);
+    }
+
+    // encodings, two bytes per character
+    dwFormat = ReadPCF32(pEncodings, FALSE);
+    bMSBFirst = (0 != (dwFormat & PCF_BYTE_MASK));
+    if(14 > nEncodingsSize)
+    {
+        Unload();
+        return E_FAIL;
+    }
+    int nMinByte2 = ReadPCF16(pEncodings + 4, bMSBFirst);
+    int nMaxByte2 = ReadPCF16(pEncodings + 6, bMSBFirst);
+    int nMinByte1 = ReadPCF16(pEncodings + 8, bMSBFirst);
+    int nMaxByte1 = ReadPCF16(pEncodings + 10, bMSBFirst);
+    int nDefaultChar = (WORD)ReadPCF16(pEncodings + 12, bMSBFirst);
+    // the bytes of a character code
+    if((0 > nMinByte2) || (255 < nMaxByte2) || (0 > nMinByte1) || (255 < nMaxByte1))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): bad encodings.\n"));
+        Unload();
+        return E_FAIL;
+    }
+    int nColumns = nMaxByte2 - nMinByte2 + 1;
+    int nRows = nMaxByte1 - nMinByte1 + 1;
+    if((0 >= nColumns) || (0 >= nRows) || (nRows > (nEncodingsSize - 14) / 2 / nColumns))
+    {
+        LCDUITRACE(_T("CLCDBitmapFont::LoadPCF(): bad encodings.\n"));
+        Unload();
+        return E_FAIL;
+    }
+
+    ENCODING_LIST Encodings;
+    for(int nRow = 0; nRow < nRows; nRow++)
+    {
+        for(int nColumn = 0; nColumn < nColumns; nColumn++)
+        {
+            int nGlyph = (WORD)ReadPCF16(pEncodings + 14 + (nRow * nColumns + nColumn) * 2, bMSBFirst);
+            if((0xFFFF != nGlyph) && (nGlyph < nGlyphs))
+            {
+                DWORD dwChar = ((nRow + nMinByte1) << 8) | (nColumn + nMinByte2);
+                Encodings.push_back(std::make_pair(dwChar, nGlyph));
+            }
+        }
+    }
+
+    // ascent and descent, or the extremes of the glyphs
+    if(20 <= nAcceleratorsSize)
+    {
+        dwFormat = ReadPCF32(pAccelerators, FALSE);
+        bMSBFirst = (0 != (dwFormat & PCF_BYTE_MASK));
+        m_nAscent = (int)ReadPCF32(pAccelerators + 12, bMSBFirst);
+        m_nDescent = (int)ReadPCF32(pAccelerators + 16, bMSBFirst);
+    }
+    else
+    {
+        for(int i = 0; i < nGlyphs; i++)
+        {
+            m_nAscent = max(m_nAscent, -Glyphs[i].nOffsetY);
+            m_nDescent = max(m_nDescent, Glyphs[i].nHeight + Glyphs[i].nOffsetY);
+        }
+    }
+
+    return FinishLoad(Encodings, nDefaultChar);
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::Unload
+//
+//************************************************************************
+
+void CLCDBitmapFont::Unload(void)
+{
+    m_Glyphs.clear();
+    m_Bits.clear();
+    m_ExtendedGlyphs.clear();
+    for(int i = 0; i < 256; i++)
+    {
+        m_DirectGlyphs[i] = -1;
+    }
+    m_nDefaultGlyph = -1;
+    m_nAscent = 0;
+    m_nDescent = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::IsLoaded
+//
+//************************************************************************
+
+BOOL CLCDBitmapFont::IsLoaded(void)
+{
+    return !m_Glyphs.empty();
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::GetAscent
+//
+//************************************************************************
+
+int CLCDBitmapFont::GetAscent(void)
+{
+    return m_nAscent;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::GetDescent
+//
+//************************************************************************
+
+int CLCDBitmapFont::GetDescent(void)
+{
+    return m_nDescent;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::GetLineHeight
+//
+//************************************************************************
+
+int CLCDBitmapFont::GetLineHeight(void)
+{
+    return m_nAscent + m_nDescent;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::GetTextExtent
+//
+//************************************************************************
+
+SIZE CLCDBitmapFont::GetTextExtent(LPCTSTR szText, int nLength, int nMaxWidth, UINT nFormat)
+{
+    SIZE sizeText = { 0, 0 };
+    if(!IsLoaded() || (NULL == szText) || (0 >= nLength))
+    {
+        return sizeText;
+    }
+
+    int nStart = 0;
+    do
+    {
+        int nNext = 0;
+        int nLineWidth = 0;
+        BreakLine(szText, nStart, nLength, nMaxWidth, nFormat, nNext, nLineWidth);
+
+        sizeText.cx = max(sizeText.cx, nLineWidth);
+        sizeText.cy += GetLineHeight();
+        nStart = nNext;
+    }
+    while(nStart < nLength);
+
+    return sizeText;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::DrawText
+//
+//************************************************************************
+
+BOOL CLCDBitmapFont::DrawText(CLCDGfxBase &rGfx, const RECT &rcBoundary, LPCTSTR szText, int nLength,
+                              UINT nFormat, COLORREF crColor)
+{
+    if(!IsLoaded() || (NULL == szText))
+    {
+        return FALSE;
+    }
+    if(0 >= nLength)
+    {
+        return TRUE;
+    }
+
+    TARGET Target;
+    if(!GetTarget(rGfx, crColor, Target))
+    {
+        return FALSE;
+    }
+
+    RECT rcBox = rcBoundary;
+    OffsetRect(&rcBox, Target.ptOffset.x, Target.ptOffset.y);
+    if(!(nFormat & DT_NOCLIP))
+    {
+        IntersectRect(&Target.rcClip, &Target.rcClip, &rcBox);
+    }
+
+    int nBoxWidth = rcBox.right - rcBox.left;
+    int nLineHeight = GetLineHeight();
+    int nY = rcBox.top;
+    if(nFormat & DT_SINGLELINE)
+    {
+        if(nFormat & DT_BOTTOM)
+        {
+            nY = rcBox.bottom - nLineHeight;
+        }
+        else if(nFormat & DT_VCENTER)
+        {
+            nY = rcBox.top + (rcBox.bottom - rcBox.top - nLineHeight) / 2;
+        }
+    }
+
+    int nStart = 0;
+    do
+    {
+        int nNext = 0;
+        int nLineWidth = 0;
+        int nEnd = BreakLine(szText, nStart, nLength, nBoxWidth, nFormat, nNext, nLineWidth);
+
+        int nX = rcBox.left;
+        if(nFormat & DT_CENTER)
+        {
+            nX += (nBoxWidth - nLineWidth) / 2;
+        }
+        else if(nFormat & DT_RIGHT)
+        {
+            nX = rcBox.right - nLineWidth;
+        }
+
+        // lines above the clip box are only laid out
+        if(nY + nLineHeight > Target.rcClip.top)
+        {
+            for(int i = nStart; i < nEnd; i++)
+            {
+                const GLYPH *pGlyph = FindGlyph(szText[i]);
+                if(NULL != pGlyph)
+                {
+                    DrawGlyph(Target, *pGlyph, nX + pGlyph->nOffsetX, nY + pGlyph->nOffsetY);
+                    nX += pGlyph->nAdvance;
+                }
+            }
+        }
+
+        nY += nLineHeight;
+        nStart = nNext;
+    }
+    while((nStart < nLength) && (nY < Target.rcClip.bottom));
+
+    if(NULL != Target.hBrush)
+    {
+        DeleteObject(Target.hBrush);
+    }
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::FindGlyph
+//
+// Control characters have no glyph and take no room
+//
+//************************************************************************
+
+const CLCDBitmapFont::GLYPH *CLCDBitmapFont::FindGlyph(TCHAR ch)
+{
+    DWORD dwChar = (DWORD)(TBYTE)ch;
+    if(0x20 > dwChar)
+    {
+        return NULL;
+    }
+
+    int nGlyph = -1;
+    if(256 > dwChar)
+    {
+        nGlyph = m_DirectGlyphs[dwChar];
+    }
+    else
+    {
+        ENCODING_LIST::const_iterator it = std::lower_bound(m_ExtendedGlyphs.begin(), m_ExtendedGlyphs.end(),
+                                                            std::make_pair(dwChar, -1));
+        if((it != m_ExtendedGlyphs.end()) && (it->first == dwChar))
+        {
+            nGlyph = it->second;
+        }
+    }
+
+    if(0 > nGlyph)
+    {
+        nGlyph = m_nDefaultGlyph;
+    }
+    return (0 <= nGlyph) ? &m_Glyphs[nGlyph] : NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::BreakLine
+//
+// Returns the end of the line starting at nStart, sets where the next
+// one starts and the width of this one. Breaks as CLCDTextLayout does
+// for DrawTextEx(): a word wider than nMaxWidth is not broken.
+//
+//************************************************************************
+
+int CLCDBitmapFont::BreakLine(LPCTSTR szText, int nStart, int nLength, int nMaxWidth, UINT nFormat,
+                              int &nNext, int &nLineWidth)
+{
+    BOOL bSingleLine = (0 != (nFormat & DT_SINGLELINE));
+    BOOL bWordBreak = !bSingleLine && (0 != (nFormat & DT_WORDBREAK));
+
+    int nEnd = nStart;
+    int nBlank = -1;
+    int nBlankWidth = 0;
+    BOOL bWrapped = FALSE;
+    nLineWidth = 0;
+    while(nEnd < nLength)
+    {
+        TCHAR ch = szText[nEnd];
+        if(!bSingleLine && ((_T('\r') == ch) || (_T('\n') == ch)))
+        {
+            break;
+        }
+
+        const GLYPH *pGlyph = FindGlyph(ch);
+        int nAdvance = (NULL != pGlyph) ? pGlyph->nAdvance : 0;
+        if(bWordBreak && (nEnd > nStart) && (nLineWidth + nAdvance > nMaxWidth))
+        {
+            if(_T(' ') == ch)
+            {
+                bWrapped = TRUE;
+                break;
+            }
+            if(0 <= nBlank)
+            {
+                // back to the blank before the word that does not fit
+                nEnd = nBlank;
+                nLineWidth = nBlankWidth;
+                bWrapped = TRUE;
+                break;
+            }
+        }
+
+        if(_T(' ') == ch)
+        {
+            nBlank = nEnd;
+            nBlankWidth = nLineWidth;
+        }
+        nLineWidth += nAdvance;
+        nEnd++;
+    }
+
+    // skip the line break, or the blanks a wrapped line ends with
+    nNext = nEnd;
+    if(bWrapped)
+    {
+        while((nNext < nLength) && (_T(' ') == szText[nNext]))
+        {
+            nNext++;
+        }
+    }
+    else if((nNext < nLength) && (_T('\r') == szText[nNext]))
+    {
+        nNext++;
+        if((nNext < nLength) && (_T('\n') == szText[nNext]))
+        {
+            nNext++;
+        }
+    }
+    else if((nNext < nLength) && (_T('\n') == szText[nNext]))
+    {
+        nNext++;
+    }
+    return nEnd;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::GetTarget
+//
+// The pixels of surfaces with direct access, the device context
+// otherwise. Monochrome surfaces get the on or off value closest to the
+// color, with the threshold of their palette.
+//
+//************************************************************************
+
+BOOL CLCDBitmapFont::GetTarget(CLCDGfxBase &rGfx, COLORREF crColor, TARGET &rTarget)
+{
+    ZeroMemory(&rTarget, sizeof(rTarget));
+
+    // only soft surfaces are packed
+    int nBitCount = rGfx.GetBitCount();
+    if(((1 == nBitCount) || (8 == nBitCount) || (32 == nBitCount)) &&
+        rGfx.GetDirectTarget(rTarget.ptOffset, rTarget.rcClip))
+    {
+        rTarget.pBits = rGfx.GetBits();
+        rTarget.nPitch = rGfx.GetPitch();
+        rTarget.nBitCount = nBitCount;
+    }
+
+    if(NULL == rTarget.pBits)
+    {
+        // through GDI, which clips
+        rTarget.hDC = rGfx.GetHDC();
+        rTarget.hBrush = CreateSolidBrush(crColor);
+        rTarget.nBitCount = 0;
+        rTarget.ptOffset.x = rTarget.ptOffset.y = 0;
+        SetRect(&rTarget.rcClip, -0x8000, -0x8000, 0x7FFF, 0x7FFF);
+        if((NULL == rTarget.hDC) || (NULL == rTarget.hBrush))
+        {
+            if(NULL != rTarget.hBrush)
+            {
+                DeleteObject(rTarget.hBrush);
+            }
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    UINT nLuma = (GetRValue(crColor) * 77 + GetGValue(crColor) * 150 + GetBValue(crColor) * 29) >> 8;
+    switch(rTarget.nBitCount)
+    {
+    case 1:
+        rTarget.dwColor = (nLuma > 128) ? 1 : 0;
+        break;
+    case 8:
+        rTarget.dwColor = (nLuma > 128) ? 0xFF : 0x00;
+        break;
+    case 32:
+        // BGRA, opaque except on soft surfaces, which have no alpha
+        rTarget.dwColor = ((NULL != rGfx.GetSoftSurface()) ? 0 : 0xFF000000) |
+            ((DWORD)GetRValue(crColor) << 16) | ((DWORD)GetGValue(crColor) << 8) | (DWORD)GetBValue(crColor);
+        break;
+    default:
+        return FALSE;
+    }
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::DrawGlyph
+//
+// nX, nY is the top left of the glyph bitmap, in target coordinates.
+// Set pixels are filled a run at a time.
+//
+//************************************************************************
+
+void CLCDBitmapFont::DrawGlyph(const TARGET &rTarget, const GLYPH &rGlyph, int nX, int nY)
+{
+    RECT rcGlyph = { nX, nY, nX + rGlyph.nWidth, nY + rGlyph.nHeight };
+    RECT rcDraw;
+    if(!IntersectRect(&rcDraw, &rcGlyph, &rTarget.rcClip))
+    {
+        return;
+    }
+
+    for(int y = rcDraw.top; y < rcDraw.bottom; y++)
+    {
+        const BYTE *pRow = &m_Bits[rGlyph.nBits + (y - nY) * rGlyph.nPitch];
+        int x = rcDraw.left;
+        while(x < rcDraw.right)
+        {
+            int nBit = x - nX;
+            if((0 == (nBit & 7)) && (0 == pRow[nBit >> 3]))
+            {
+                // eight blank pixels
+                x += 8;
+                continue;
+            }
+            if(!(pRow[nBit >> 3] & (1 << (nBit & 7))))
+            {
+                x++;
+                continue;
+            }
+
+            int nRunEnd = x + 1;
+            while((nRunEnd < rcDraw.right) &&
+                (pRow[(nRunEnd - nX) >> 3] & (1 << ((nRunEnd - nX) & 7))))
+            {
+                nRunEnd++;
+            }
+            FillRun(rTarget, y, x, nRunEnd);
+            x = nRunEnd;
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::FillRun
+//
+//************************************************************************
+
+void CLCDBitmapFont::FillRun(const TARGET &rTarget, int nY, int nLeft, int nRight)
+{
+    PBYTE pRow = rTarget.pBits + nY * rTarget.nPitch;
+    switch(rTarget.nBitCount)
+    {
+    case 0:
+        {
+            RECT rcRun = { nLeft, nY, nRight, nY + 1 };
+            FillRect(rTarget.hDC, &rcRun, rTarget.hBrush);
+        }
+        break;
+    case 1:
+        for(int x = nLeft; x < nRight; x++)
+        {
+            BYTE byBit = (BYTE)(1 << (x & 7));
+            pRow[x >> 3] = rTarget.dwColor ? (BYTE)(pRow[x >> 3] | byBit) : (BYTE)(pRow[x >> 3] & ~byBit);
+        }
+        break;
+    case 8:
+        memset(pRow + nLeft, (BYTE)rTarget.dwColor, nRight - nLeft);
+        break;
+    case 32:
+        {
+            DWORD *pPixel = (DWORD *)pRow + nLeft;
+            for(int x = nLeft; x < nRight; x++)
+            {
+                *pPixel++ = rTarget.dwColor;
+            }
+        }
+        break;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::AddGlyph
+//
+// Copies the rows, nRowBytes apart, into m_Bits with the least
+// significant bit first
+//
+//************************************************************************
+
+void CLCDBitmapFont::AddGlyph(GLYPH &rGlyph, const BYTE *pRows, int nRowBytes, BOOL bMSBFirst)
+{
+    rGlyph.nPitch = (rGlyph.nWidth + 7) / 8;
+    rGlyph.nBits = (int)m_Bits.size();
+    m_Bits.resize(m_Bits.size() + rGlyph.nPitch * rGlyph.nHeight, 0);
+
+    if(NULL != pRows)
+    {
+        for(int y = 0; y < rGlyph.nHeight; y++)
+        {
+            PBYTE pDst = &m_Bits[rGlyph.nBits + y * rGlyph.nPitch];
+            for(int x = 0; (x < rGlyph.nPitch) && (x < nRowBytes); x++)
+            {
+                BYTE by = pRows[y * nRowBytes + x];
+                pDst[x] = bMSBFirst ? ReverseBits(by) : by;
+            }
+
+            // nothing past the width
+            if(rGlyph.nWidth & 7)
+            {
+                pDst[rGlyph.nPitch - 1] &= (BYTE)((1 << (rGlyph.nWidth & 7)) - 1);
+            }
+        }
+    }
+
+    m_Glyphs.push_back(rGlyph);
+}
+
+
+//************************************************************************
+//
+// CLCDBitmapFont::FinishLoad
+//
+// Places the glyphs below the ascent and builds the character lookup
+//
+//************************************************************************
+
+HRESULT CLCDBitmapFont::FinishLoad(ENCODING_LIST &rEncodings, int nDefaultChar)
+{
+    if(m_Glyphs.empty() || rEncodings.empty())
+    {
+        LCDUITRACE(_T("CLCDBitmapFont: the font has no glyphs.\n"));
+        Unload();
+        return E_FAIL;
+    }
+
+    for(size_t i = 0; i < m_Glyphs.size(); i++)
+    {
+        m_Glyphs[i].nOffsetY += m_nAscent;
+    }
+
+    std::sort(rEncodings.begin(), rEncodings.end());
+    for(size_t i = 0; i < rEncodings.size(); i++)
+    {
+        if(256 > rEncodings[i].first)
+        {
+            m_DirectGlyphs[rEncodings[i].first] = rEncodings[i].second;
+        }
+        else
+        {
+            m_ExtendedGlyphs.push_back(rEncodings[i]);
+        }
+
+        if((DWORD)nDefaultChar == rEncodings[i].first)
+        {
+            m_nDefaultGlyph = rEncodings[i].second;
+        }
+    }
+
+    return S_OK;
+}
+
+
+//** end of LCDBitmapFont.cpp ********************************************
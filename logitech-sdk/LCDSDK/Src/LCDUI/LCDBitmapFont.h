@@ -0,0 +1,110 @@
+//************************************************************************
+//
+// LCDBitmapFont.h
+//
+// The CLCDBitmapFont class loads a bitmap font, BDF or PCF, and draws
+// text with it pixel for pixel, without GDI. Glyphs are kept packed, one
+// bit per pixel, and their advances in a table, so that measuring a
+// string only adds up its advances.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDBITMAPFONT_H_INCLUDED_
+#define _LCDBITMAPFONT_H_INCLUDED_
+
+#include "LCDGfxBase.h"
+
+class CLCDBitmapFont
+{
+public:
+    CLCDBitmapFont(void);
+    virtual ~CLCDBitmapFont(void);
+
+    // A .bdf or .pcf file; compressed PCF files are not read
+    HRESULT LoadFile(LPCTSTR szPath);
+    HRESULT LoadBDF(const char *pData, int nSize);
+    HRESULT LoadPCF(const BYTE *pData, int nSize);
+    void Unload(void);
+    BOOL IsLoaded(void);
+
+    // glyphs of BDF fonts are cut to this many pixels each way
+    enum { MAX_GLYPH_SIZE = 1024 };
+
+    int GetAscent(void);
+    int GetDescent(void);
+    int GetLineHeight(void);
+
+    // The extent of the text as DrawText() lays it out, lines breaking at
+    // CR, LF or CR LF, and with DT_WORDBREAK at the last blank that fits
+    // in nMaxWidth
+    SIZE GetTextExtent(LPCTSTR szText, int nLength, int nMaxWidth, UINT nFormat);
+
+    // Draws the text into rcBoundary, in logical coordinates of rGfx,
+    // with a transparent background. DT_LEFT, DT_CENTER, DT_RIGHT,
+    // DT_WORDBREAK, DT_NOCLIP and, on a single line, DT_VCENTER and
+    // DT_BOTTOM are followed. Soft surfaces and surfaces with direct
+    // access are written to directly, others through GDI.
+    BOOL DrawText(CLCDGfxBase &rGfx, const RECT &rcBoundary, LPCTSTR szText, int nLength,
+                  UINT nFormat, COLORREF crColor);
+
+protected:
+    struct GLYPH
+    {
+        int nWidth;
+        int nHeight;
+        // of the top left of the bitmap, from the pen on the top of the line
+        int nOffsetX;
+        int nOffsetY;
+        int nAdvance;
+        // packed rows in m_Bits, least significant bit first
+        int nBits;
+        int nPitch;
+    };
+
+    // where glyphs are drawn
+    struct TARGET
+    {
+        PBYTE pBits;
+        int nPitch;
+        // 0 draws through hDC
+        int nBitCount;
+        HDC hDC;
+        DWORD dwColor;
+        HBRUSH hBrush;
+        // logical to target coordinates
+        POINT ptOffset;
+        RECT rcClip;
+    };
+
+    typedef std::vector<std::pair<DWORD, int> > ENCODING_LIST;
+
+    const GLYPH *FindGlyph(TCHAR ch);
+    int BreakLine(LPCTSTR szText, int nStart, int nLength, int nMaxWidth, UINT nFormat,
+                  int &nNext, int &nLineWidth);
+    BOOL GetTarget(CLCDGfxBase &rGfx, COLORREF crColor, TARGET &rTarget);
+    void DrawGlyph(const TARGET &rTarget, const GLYPH &rGlyph, int nX, int nY);
+    void FillRun(const TARGET &rTarget, int nY, int nLeft, int nRight);
+    void AddGlyph(GLYPH &rGlyph, const BYTE *pRows, int nRowBytes, BOOL bMSBFirst);
+    HRESULT FinishLoad(ENCODING_LIST &rEncodings, int nDefaultChar);
+
+protected:
+    std::vector<GLYPH> m_Glyphs;
+    std::vector<BYTE> m_Bits;
+
+    // glyph of the first 256 characters, -1 if none
+    int m_DirectGlyphs[256];
+    // glyphs of the others, sorted by character
+    ENCODING_LIST m_ExtendedGlyphs;
+    // drawn for characters without a glyph, -1 if none
+    int m_nDefaultGlyph;
+
+    int m_nAscent;
+    int m_nDescent;
+};
+
+#endif // !_LCDBITMAPFONT_H_INCLUDED_
+
+//** end of LCDBitmapFont.h **********************************************
@@ -0,0 +1,180 @@
+//************************************************************************
+//
+// LCDClock.cpp
+//
+// The CLCDClock class is where all LCDUI timing comes from.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+static CLCDSystemClock s_SystemClock;
+static CLCDClock *s_pClock = &s_SystemClock;
+
+
+//************************************************************************
+//
+// CLCDClock::CLCDClock
+//
+//************************************************************************
+
+CLCDClock::CLCDClock(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDClock::~CLCDClock
+//
+//************************************************************************
+
+CLCDClock::~CLCDClock(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDClock::GetInstance
+//
+//************************************************************************
+
+CLCDClock &CLCDClock::GetInstance(void)
+{
+    return *s_pClock;
+}
+
+
+//************************************************************************
+//
+// CLCDClock::SetInstance
+//
+//************************************************************************
+
+void CLCDClock::SetInstance(CLCDClock *pClock)
+{
+    s_pClock = (NULL != pClock) ? pClock : &s_SystemClock;
+}
+
+
+//************************************************************************
+//
+// CLCDClock::Now
+//
+//************************************************************************
+
+DWORD CLCDClock::Now(void)
+{
+    return s_pClock->GetTime();
+}
+
+
+//************************************************************************
+//
+// CLCDSystemClock::CLCDSystemClock
+//
+//************************************************************************
+
+CLCDSystemClock::CLCDSystemClock(void)
+{
+    m_dwStart = GetTickCount();
+    m_bHighResolution = QueryPerformanceFrequency(&m_liFrequency) &&
+        (0 < m_liFrequency.QuadPart) && QueryPerformanceCounter(&m_liStart);
+}
+
+
+//************************************************************************
+//
+// CLCDSystemClock::~CLCDSystemClock
+//
+//************************************************************************
+
+CLCDSystemClock::~CLCDSystemClock(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDSystemClock::GetTime
+//
+//************************************************************************
+
+DWORD CLCDSystemClock::GetTime(void)
+{
+    if(!m_bHighResolution)
+    {
+        return GetTickCount();
+    }
+
+    LARGE_INTEGER liNow;
+    QueryPerformanceCounter(&liNow);
+    LONGLONG llElapsed = (liNow.QuadPart - m_liStart.QuadPart) * 1000 / m_liFrequency.QuadPart;
+    return m_dwStart + (DWORD)llElapsed;
+}
+
+
+//************************************************************************
+//
+// CLCDVirtualClock::CLCDVirtualClock
+//
+//************************************************************************
+
+CLCDVirtualClock::CLCDVirtualClock(DWORD dwStart)
+:   m_lTime((LONG)dwStart)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDVirtualClock::~CLCDVirtualClock
+//
+//************************************************************************
+
+CLCDVirtualClock::~CLCDVirtualClock(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDVirtualClock::GetTime
+//
+//************************************************************************
+
+DWORD CLCDVirtualClock::GetTime(void)
+{
+    return (DWORD)m_lTime;
+}
+
+
+//************************************************************************
+//
+// CLCDVirtualClock::SetTime
+//
+//************************************************************************
+
+void CLCDVirtualClock::SetTime(DWORD dwTime)
+{
+    InterlockedExchange(&m_lTime, (LONG)dwTime);
+}
+
+
+//************************************************************************
+//
+// CLCDVirtualClock::Advance
+//
+//************************************************************************
+
+void CLCDVirtualClock::Advance(DWORD dwMilliseconds)
+{
+    InterlockedExchangeAdd(&m_lTime, (LONG)dwMilliseconds);
+}
+
+
+//** end of LCDClock.cpp *************************************************
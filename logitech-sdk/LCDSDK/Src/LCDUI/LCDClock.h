@@ -0,0 +1,76 @@
+//************************************************************************
+//
+// LCDClock.h
+//
+// The CLCDClock class is where all LCDUI timing comes from: scrolling,
+// animations and page expiration. The default clock follows the
+// performance counter. A CLCDVirtualClock can be installed instead, to
+// run through hours of updates in a simulation.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDCLOCK_H_INCLUDED_
+#define _LCDCLOCK_H_INCLUDED_
+
+class CLCDClock
+{
+public:
+    CLCDClock(void);
+    virtual ~CLCDClock(void);
+
+    // Milliseconds since an arbitrary start, wrapping around like
+    // GetTickCount(). Only differences between two times are meaningful.
+    virtual DWORD GetTime(void) = 0;
+
+    // the clock in use
+    static CLCDClock &GetInstance(void);
+    // Installs pClock, which must outlive its use; NULL restores the
+    // system clock. Not to be called while outputs are updated.
+    static void SetInstance(CLCDClock *pClock);
+
+    // the time of the clock in use
+    static DWORD Now(void);
+};
+
+
+class CLCDSystemClock : public CLCDClock
+{
+public:
+    CLCDSystemClock(void);
+    virtual ~CLCDSystemClock(void);
+
+    // the performance counter, or GetTickCount() if there is none
+    virtual DWORD GetTime(void);
+
+protected:
+    BOOL m_bHighResolution;
+    LARGE_INTEGER m_liFrequency;
+    LARGE_INTEGER m_liStart;
+    // the time at m_liStart, so that times look like tick counts
+    DWORD m_dwStart;
+};
+
+
+class CLCDVirtualClock : public CLCDClock
+{
+public:
+    // Pages take a start time of 0 for no expiration, so the clock does
+    // not start there by default.
+    CLCDVirtualClock(DWORD dwStart = 1);
+    virtual ~CLCDVirtualClock(void);
+
+    // only moves when told to
+    virtual DWORD GetTime(void);
+    void SetTime(DWORD dwTime);
+    void Advance(DWORD dwMilliseconds);
+
+protected:
+    volatile LONG m_lTime;
+};
+
+#endif // !_LCDCLOCK_H_INCLUDED_
+
+//** end of LCDClock.h ***************************************************
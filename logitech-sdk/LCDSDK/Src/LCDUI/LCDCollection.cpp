@@ -1,225 +1,390 @@
-//************************************************************************
-//
-// LCDCollection.cpp
-//
-// Holds a collection of base items.  Its draw will draw everything
-// in its list.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDCollection::CLCDCollection
-//
-//************************************************************************
-
-CLCDCollection::CLCDCollection(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::~CLCDCollection
-//
-//************************************************************************
-
-CLCDCollection::~CLCDCollection(void)
-{
-
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::GetObjectCount
-//
-//************************************************************************
-
-int CLCDCollection::GetObjectCount(void)
-{
-    return (int)m_Objects.size();
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::AddObject
-//
-//************************************************************************
-
-bool CLCDCollection::AddObject(CLCDBase* pObject)
-{
-    m_Objects.push_back(pObject);
-    return true;
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::RemoveObject
-//
-//************************************************************************
-
-bool CLCDCollection::RemoveObject(CLCDBase* pObject)
-{
-    LCD_OBJECT_LIST::iterator it = 
-        std::find(m_Objects.begin(), m_Objects.end(), pObject);
-    if(it != m_Objects.end())
-    {
-        m_Objects.erase(it);
-        return true;
-    }
-
-    return false;
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::RemoveObject
-//
-//************************************************************************
-
-bool CLCDCollection::RemoveObject(int objpos)
-{
-    if(!m_Objects.empty())
-    {
-        if((0 <= objpos) && (objpos < (int) m_Objects.size()))
-        {
-            m_Objects.erase(m_Objects.begin() + objpos);
-            return true;
-        }
-    }
-    return false;
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::RemoveAll
-//
-//************************************************************************
-
-void CLCDCollection::RemoveAll()
-{
-    m_Objects.clear();
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::RetrieveObject
-//
-//************************************************************************
-
-CLCDBase* CLCDCollection::RetrieveObject(int objpos)
-{
-    if(!m_Objects.empty())
-    {
-        if((0 <= objpos) && (objpos < (int) m_Objects.size()))
-        {
-            return m_Objects[objpos];
-        }
-    }
-    return NULL;
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::OnDraw
-//
-//************************************************************************
-
-void CLCDCollection::OnDraw(CLCDGfxBase &rGfx)
-{
-    if(!IsVisible())
-    {
-        return;
-    }
-
-    //iterate through your objects and draw them
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-    while(it != m_Objects.end())
-    {
-        CLCDBase *pObject = *it++;
-        LCDUIASSERT(NULL != pObject);
-
-        if (pObject->IsVisible())
-        {
-            pObject->OnPrepareDraw(rGfx);
-
-            // create the clip region
-            HRGN hRgn = CreateRectRgn(pObject->GetOrigin().x, pObject->GetOrigin().y,
-                                      pObject->GetOrigin().x + pObject->GetWidth(),
-                                      pObject->GetOrigin().y + pObject->GetHeight());
-
-            // ensure that controls only draw within their specified region
-            SelectClipRgn(rGfx.GetHDC(), hRgn);
-
-            // free the region (a copy is used in the call above)
-            DeleteObject(hRgn);
-
-            // offset the control at its origin so controls use (0,0)
-            POINT ptPrevViewportOrg = { 0, 0 };
-            SetViewportOrgEx(rGfx.GetHDC(),
-                             pObject->GetOrigin().x,
-                             pObject->GetOrigin().y,
-                             &ptPrevViewportOrg);
-
-            // allow controls to supply additional translation
-            // this allows controls to move freely within the confined viewport
-            OffsetViewportOrgEx(rGfx.GetHDC(),
-                                pObject->GetLogicalOrigin().x,
-                                pObject->GetLogicalOrigin().y,
-                                NULL);
-
-            pObject->OnDraw(rGfx);
-
-            // set the clipping region to nothing
-            SelectClipRgn(rGfx.GetHDC(), NULL);
-
-            // restore the viewport origin
-            SetViewportOrgEx(rGfx.GetHDC(),
-                ptPrevViewportOrg.x,
-                ptPrevViewportOrg.y,
-                NULL);
-
-            // restore the viewport origin offset
-            OffsetViewportOrgEx(rGfx.GetHDC(), 0, 0, NULL);
-        }
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDCollection::OnUpdate
-//
-//************************************************************************
-
-void CLCDCollection::OnUpdate(DWORD dwTimestamp)
-{
-    //iterate through your objects and update them
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-    while(it != m_Objects.end())
-    {
-        CLCDBase *pObject = *it++;
-        LCDUIASSERT(NULL != pObject);
-
-        pObject->OnUpdate(dwTimestamp);
-    }
-
-    //and update yourself
-    CLCDBase::OnUpdate(dwTimestamp);
-}
-
-
-//** end of LCDCollection.cpp ********************************************
+//************************************************************************
+//
+// LCDCollection.cpp
+//
+// Holds a collection of base items.  Its draw will draw everything
+// in its list.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDCollection::CLCDCollection
+//
+//************************************************************************
+
+CLCDCollection::CLCDCollection(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::~CLCDCollection
+//
+//************************************************************************
+
+CLCDCollection::~CLCDCollection(void)
+{
+
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::GetObjectCount
+//
+//************************************************************************
+
+int CLCDCollection::GetObjectCount(void)
+{
+    return (int)m_Objects.size();
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::AddObject
+//
+//************************************************************************
+
+bool CLCDCollection::AddObject(CLCDBase* pObject)
+{
+    pObject->Invalidate();
+    m_Objects.push_back(pObject);
+    return true;
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::RemoveObject
+//
+//************************************************************************
+
+bool CLCDCollection::RemoveObject(CLCDBase* pObject)
+{
+    LCD_OBJECT_LIST::iterator it = 
+        std::find(m_Objects.begin(), m_Objects.end(), pObject);
+    if(it != m_Objects.end())
+    {
+        m_Objects.erase(it);
+        Invalidate();
+        return true;
+    }
+
+    return false;
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::RemoveObject
+//
+//************************************************************************
+
+bool CLCDCollection::RemoveObject(int objpos)
+{
+    if(!m_Objects.empty())
+    {
+        if((0 <= objpos) && (objpos < (int) m_Objects.size()))
+        {
+            m_Objects.erase(m_Objects.begin() + objpos);
+            Invalidate();
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::RemoveAll
+//
+//************************************************************************
+
+void CLCDCollection::RemoveAll()
+{
+    m_Objects.clear();
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::RetrieveObject
+//
+//************************************************************************
+
+CLCDBase* CLCDCollection::RetrieveObject(int objpos)
+{
+    if(!m_Objects.empty())
+    {
+        if((0 <= objpos) && (objpos < (int) m_Objects.size()))
+        {
+            return m_Objects[objpos];
+        }
+    }
+    return NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::OnPrepareDraw
+//
+//************************************************************************
+
+void CLCDCollection::OnPrepareDraw(CLCDGfxBase &rGfx)
+{
+    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
+    while(it != m_Objects.end())
+    {
+        CLCDBase *pObject = *it++;
+        LCDUIASSERT(NULL != pObject);
+
+        if (pObject->IsVisible())
+        {
+            pObject->OnPrepareDraw(rGfx);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::OnDraw
+//
+//************************************************************************
+
+void CLCDCollection::OnDraw(CLCDGfxBase &rGfx)
+{
+    if(!IsVisible())
+    {
+        return;
+    }
+
+    // The parent has translated to this collection, so that nested
+    // collections place their objects relative to their own origin
+    POINT ptOrg = { 0, 0 };
+    if(NULL != rGfx.GetSoftSurface())
+    {
+        ptOrg = rGfx.GetSoftSurface()->GetOrigin();
+    }
+    else
+    {
+        GetViewportOrgEx(rGfx.GetHDC(), &ptOrg);
+    }
+
+    //iterate through your objects and draw them
+    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
+    while(it != m_Objects.end())
+    {
+        CLCDBase *pObject = *it++;
+        LCDUIASSERT(NULL != pObject);
+
+        if (pObject->IsVisible())
+        {
+            // skip controls outside of the area being redrawn
+            RECT rcClip = { ptOrg.x + pObject->GetOrigin().x,
+                            ptOrg.y + pObject->GetOrigin().y,
+                            ptOrg.x + pObject->GetOrigin().x + pObject->GetWidth(),
+                            ptOrg.y + pObject->GetOrigin().y + pObject->GetHeight() };
+            if (!rGfx.ClipToDamage(rcClip))
+            {
+                continue;
+            }
+
+            // the tile renderer prepared the whole page before the tiles
+            if (!rGfx.IsPrepared())
+            {
+                pObject->OnPrepareDraw(rGfx);
+            }
+
+            CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+            if(NULL != pSoft)
+            {
+                // same clipping and translation, without a device context,
+                // and within the clip of the enclosing collection
+                RECT rcPrevClip;
+                pSoft->GetClipRect(&rcPrevClip);
+                RECT rcSoftClip;
+                IntersectRect(&rcSoftClip, &rcClip, &rcPrevClip);
+                pSoft->SetClipRect(&rcSoftClip);
+                POINT ptPrevOrg = pSoft->SetOrigin(
+                    ptOrg.x + pObject->GetOrigin().x + pObject->GetLogicalOrigin().x,
+                    ptOrg.y + pObject->GetOrigin().y + pObject->GetLogicalOrigin().y);
+
+                pObject->OnDraw(rGfx);
+
+                pSoft->SetClipRect(&rcPrevClip);
+                pSoft->SetOrigin(ptPrevOrg.x, ptPrevOrg.y);
+                continue;
+            }
+
+            // create the clip region
+            HRGN hRgn = CreateRectRgnIndirect(&rcClip);
+
+            // ensure that controls only draw within their specified region,
+            // and within the clip of the enclosing collection
+            HRGN hPrevRgn = CreateRectRgn(0, 0, 0, 0);
+            BOOL bPrevClip = (1 == GetClipRgn(rGfx.GetHDC(), hPrevRgn));
+            SelectClipRgn(rGfx.GetHDC(), hRgn);
+            if (bPrevClip)
+            {
+                ExtSelectClipRgn(rGfx.GetHDC(), hPrevRgn, RGN_AND);
+            }
+
+            // free the region (a copy is used in the call above)
+            DeleteObject(hRgn);
+
+            // offset the control at its origin so controls use (0,0)
+            POINT ptPrevViewportOrg = { 0, 0 };
+            SetViewportOrgEx(rGfx.GetHDC(),
+                             ptOrg.x + pObject->GetOrigin().x,
+                             ptOrg.y + pObject->GetOrigin().y,
+                             &ptPrevViewportOrg);
+
+            // allow controls to supply additional translation
+            // this allows controls to move freely within the confined viewport
+            OffsetViewportOrgEx(rGfx.GetHDC(),
+                                pObject->GetLogicalOrigin().x,
+                                pObject->GetLogicalOrigin().y,
+                                NULL);
+
+            pObject->OnDraw(rGfx);
+
+            // restore the clipping region of the enclosing collection
+            SelectClipRgn(rGfx.GetHDC(), bPrevClip ? hPrevRgn : NULL);
+            DeleteObject(hPrevRgn);
+
+            // restore the viewport origin
+            SetViewportOrgEx(rGfx.GetHDC(),
+                ptPrevViewportOrg.x,
+                ptPrevViewportOrg.y,
+                NULL);
+
+            // restore the viewport origin offset
+            OffsetViewportOrgEx(rGfx.GetHDC(), 0, 0, NULL);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::OnUpdate
+//
+//************************************************************************
+
+void CLCDCollection::OnUpdate(DWORD dwTimestamp)
+{
+    //iterate through your objects and update them
+    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
+    while(it != m_Objects.end())
+    {
+        CLCDBase *pObject = *it++;
+        LCDUIASSERT(NULL != pObject);
+
+        pObject->OnUpdate(dwTimestamp);
+    }
+
+    //and update yourself
+    CLCDBase::OnUpdate(dwTimestamp);
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::IsTileSafe
+//
+// A collection is as safe as the objects it draws
+//
+//************************************************************************
+
+BOOL CLCDCollection::IsTileSafe(void)
+{
+    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
+    while(it != m_Objects.end())
+    {
+        CLCDBase *pObject = *it++;
+        LCDUIASSERT(NULL != pObject);
+
+        if (pObject->IsVisible() && !pObject->IsTileSafe())
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::GetDamage
+//
+//************************************************************************
+
+void CLCDCollection::GetDamage(RECT &rcDamage)
+{
+    // a change to the collection itself covers all of its objects
+    if (IsDirty())
+    {
+        CLCDBase::GetDamage(rcDamage);
+        return;
+    }
+
+    if (!IsVisible())
+    {
+        return;
+    }
+
+    // objects report their damage relative to this collection, which is
+    // drawn at its origin within the parent
+    RECT rcObjects;
+    SetRectEmpty(&rcObjects);
+    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
+    while(it != m_Objects.end())
+    {
+        CLCDBase *pObject = *it++;
+        LCDUIASSERT(NULL != pObject);
+        pObject->GetDamage(rcObjects);
+    }
+
+    if (!IsRectEmpty(&rcObjects))
+    {
+        OffsetRect(&rcObjects, GetOrigin().x + GetLogicalOrigin().x,
+                   GetOrigin().y + GetLogicalOrigin().y);
+        UnionRect(&rcDamage, &rcDamage, &rcObjects);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCollection::ClearDamage
+//
+//************************************************************************
+
+void CLCDCollection::ClearDamage(void)
+{
+    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
+    while(it != m_Objects.end())
+    {
+        CLCDBase *pObject = *it++;
+        LCDUIASSERT(NULL != pObject);
+        pObject->ClearDamage();
+    }
+
+    CLCDBase::ClearDamage();
+}
+
+
+//** end of LCDCollection.cpp ********************************************
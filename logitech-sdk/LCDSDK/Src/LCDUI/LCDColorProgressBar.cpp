@@ -1,195 +1,265 @@
-//************************************************************************
-//
-// LCDColorProgressBar.cpp
-//
-// The CLCDColorProgressBar class draws a progress bar onto the color LCD.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::CLCDColorProgressBar
-//
-//************************************************************************
-
-CLCDColorProgressBar::CLCDColorProgressBar(void)
-    : CLCDProgressBar()
-{
-    SetProgressStyle(STYLE_FILLED);
-    SetCursorWidth(25);
-    SetBackgroundColor(RGB(0, 255, 100));
-    SetBorderThickness(3);
-
-    // Show a border by default
-    EnableBorder(FALSE);
-    SetBorderColor(RGB(0, 100, 150));
-}
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::~CLCDColorProgressBar
-//
-//************************************************************************
-
-CLCDColorProgressBar::~CLCDColorProgressBar(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::OnDraw
-//
-//************************************************************************
-
-void CLCDColorProgressBar::OnDraw(CLCDGfxBase &rGfx)
-{
-    HBRUSH hCursorBrush = CreateSolidBrush(m_crForegroundColor);
-    HBRUSH hBackBrush = CreateSolidBrush(m_crBackgroundColor);
-
-    RECT rBoundary = { 0, 0, GetWidth(), GetHeight() };
-
-    // Draw the background/border or just background
-    if (m_bBorderOn && (m_nBorderThickness > 0))
-    {
-        HBRUSH hOldBrush = (HBRUSH)SelectObject(rGfx.GetHDC(), hBackBrush);
-        HPEN hBorderPen = CreatePen(PS_INSIDEFRAME, m_nBorderThickness, m_crBorderColor);
-        HPEN hOldPen = (HPEN)SelectObject(rGfx.GetHDC(), hBorderPen);
-        Rectangle(rGfx.GetHDC(), rBoundary.left, rBoundary.top, rBoundary.right, rBoundary.bottom);
-        SelectObject(rGfx.GetHDC(), hOldPen);
-        SelectObject(rGfx.GetHDC(), hOldBrush);
-        DeleteObject(hBorderPen);
-
-        // adjust the progress boundary by the thickness
-        rBoundary.top += m_nBorderThickness;
-        rBoundary.bottom -= m_nBorderThickness;
-        rBoundary.left += m_nBorderThickness;
-        rBoundary.right -= m_nBorderThickness;
-    }
-    else
-    {
-        FillRect(rGfx.GetHDC(), &rBoundary, hBackBrush);
-    }
-
-    //Drawing the cursor
-    switch(m_eStyle)
-    {      
-    case STYLE_CURSOR:
-        {
-            RECT r = rBoundary;
-            int nCursorPos = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
-                (float)rBoundary.left, (float)(rBoundary.right - m_nCursorWidth),
-                m_fPos);
-            r.left = nCursorPos;
-            r.right = nCursorPos + m_nCursorWidth;
-            FillRect(rGfx.GetHDC(), &r, hCursorBrush);
-
-            break;
-        }
-    case STYLE_FILLED:
-        {
-            RECT r = rBoundary;
-            int nBarWidth = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
-                (float)rBoundary.left, (float)(rBoundary.right),
-                m_fPos);
-            r.right = nBarWidth ? nBarWidth : r.left;
-            FillRect(rGfx.GetHDC(), &r, hCursorBrush);
-
-            break;
-        }
-    case STYLE_DASHED_CURSOR:
-        {
-            RECT r = rBoundary;
-            int nCursorPos = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
-                (float)rBoundary.left, (float)(rBoundary.right - m_nCursorWidth),
-                m_fPos);
-            r.left = nCursorPos;
-            r.right = nCursorPos + m_nCursorWidth;
-            FillRect(rGfx.GetHDC(), &r, hCursorBrush);
-            HPEN hCursorPen = ::CreatePen(PS_DOT, 1, m_crForegroundColor);
-            HPEN hOldPen = (HPEN)::SelectObject(rGfx.GetHDC(), hCursorPen);
-
-            ::MoveToEx(rGfx.GetHDC(), rBoundary.left, (r.bottom - r.top)/2, NULL);
-            ::LineTo(rGfx.GetHDC(), nCursorPos, (r.bottom - r.top)/2);
-
-            DeleteObject(hCursorPen);
-            ::SelectObject(rGfx.GetHDC(), hOldPen);
-            break;
-        }
-
-    default:
-        break;
-    }
-
-    DeleteObject(hBackBrush);
-    DeleteObject(hCursorBrush);
-}
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::SetCursorColor
-//
-//************************************************************************
-
-void CLCDColorProgressBar::SetCursorColor(COLORREF color)
-{
-    SetForegroundColor(color);
-}
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::EnableBorder
-//
-//************************************************************************
-
-void CLCDColorProgressBar::EnableBorder(BOOL bEnable)
-{
-    m_bBorderOn = bEnable;
-}
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::SetBorderColor
-//
-//************************************************************************
-
-void CLCDColorProgressBar::SetBorderColor(COLORREF color)
-{
-    m_crBorderColor = color;
-}
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::SetBorderThickness
-//
-//************************************************************************
-
-void CLCDColorProgressBar::SetBorderThickness(int thickness)
-{
-    m_nBorderThickness = thickness;
-}
-
-
-//************************************************************************
-//
-// CLCDColorProgressBar::SetCursorWidth
-//
-//************************************************************************
-
-void CLCDColorProgressBar::SetCursorWidth(int width)
-{
-    m_nCursorWidth = width;
-}
-
-//** end of LCDColorProgressBar.cpp **************************************
+//************************************************************************
+//
+// LCDColorProgressBar.cpp
+//
+// The CLCDColorProgressBar class draws a progress bar onto the color LCD.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::CLCDColorProgressBar
+//
+//************************************************************************
+
+CLCDColorProgressBar::CLCDColorProgressBar(void)
+    : CLCDProgressBar()
+{
+    SetProgressStyle(STYLE_FILLED);
+    SetCursorWidth(25);
+    SetBackgroundColor(RGB(0, 255, 100));
+    SetBorderThickness(3);
+
+    // Show a border by default
+    EnableBorder(FALSE);
+    SetBorderColor(RGB(0, 100, 150));
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::~CLCDColorProgressBar
+//
+//************************************************************************
+
+CLCDColorProgressBar::~CLCDColorProgressBar(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::OnDraw
+//
+//************************************************************************
+
+void CLCDColorProgressBar::OnDraw(CLCDGfxBase &rGfx)
+{
+    CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+    if(NULL != pSoft)
+    {
+        DrawSoft(*pSoft);
+        return;
+    }
+
+    HBRUSH hCursorBrush = CreateSolidBrush(m_crForegroundColor);
+    HBRUSH hBackBrush = CreateSolidBrush(m_crBackgroundColor);
+
+    RECT rBoundary = { 0, 0, GetWidth(), GetHeight() };
+
+    // Draw the background/border or just background
+    if (m_bBorderOn && (m_nBorderThickness > 0))
+    {
+        HBRUSH hOldBrush = (HBRUSH)SelectObject(rGfx.GetHDC(), hBackBrush);
+        HPEN hBorderPen = CreatePen(PS_INSIDEFRAME, m_nBorderThickness, m_crBorderColor);
+        HPEN hOldPen = (HPEN)SelectObject(rGfx.GetHDC(), hBorderPen);
+        Rectangle(rGfx.GetHDC(), rBoundary.left, rBoundary.top, rBoundary.right, rBoundary.bottom);
+        SelectObject(rGfx.GetHDC(), hOldPen);
+        SelectObject(rGfx.GetHDC(), hOldBrush);
+        DeleteObject(hBorderPen);
+
+        // adjust the progress boundary by the thickness
+        rBoundary.top += m_nBorderThickness;
+        rBoundary.bottom -= m_nBorderThickness;
+        rBoundary.left += m_nBorderThickness;
+        rBoundary.right -= m_nBorderThickness;
+    }
+    else
+    {
+        FillRect(rGfx.GetHDC(), &rBoundary, hBackBrush);
+    }
+
+    //Drawing the cursor
+    switch(m_eStyle)
+    {      
+    case STYLE_CURSOR:
+        {
+            RECT r = rBoundary;
+            int nCursorPos = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
+                (float)rBoundary.left, (float)(rBoundary.right - m_nCursorWidth),
+                m_fPos);
+            r.left = nCursorPos;
+            r.right = nCursorPos + m_nCursorWidth;
+            FillRect(rGfx.GetHDC(), &r, hCursorBrush);
+
+            break;
+        }
+    case STYLE_FILLED:
+        {
+            RECT r = rBoundary;
+            int nBarWidth = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
+                (float)rBoundary.left, (float)(rBoundary.right),
+                m_fPos);
+            r.right = nBarWidth ? nBarWidth : r.left;
+            FillRect(rGfx.GetHDC(), &r, hCursorBrush);
+
+            break;
+        }
+    case STYLE_DASHED_CURSOR:
+        {
+            RECT r = rBoundary;
+            int nCursorPos = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
+                (float)rBoundary.left, (float)(rBoundary.right - m_nCursorWidth),
+                m_fPos);
+            r.left = nCursorPos;
+            r.right = nCursorPos + m_nCursorWidth;
+            FillRect(rGfx.GetHDC(), &r, hCursorBrush);
+            HPEN hCursorPen = ::CreatePen(PS_DOT, 1, m_crForegroundColor);
+            HPEN hOldPen = (HPEN)::SelectObject(rGfx.GetHDC(), hCursorPen);
+
+            ::MoveToEx(rGfx.GetHDC(), rBoundary.left, (r.bottom - r.top)/2, NULL);
+            ::LineTo(rGfx.GetHDC(), nCursorPos, (r.bottom - r.top)/2);
+
+            DeleteObject(hCursorPen);
+            ::SelectObject(rGfx.GetHDC(), hOldPen);
+            break;
+        }
+
+    default:
+        break;
+    }
+
+    DeleteObject(hBackBrush);
+    DeleteObject(hCursorBrush);
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::DrawSoft
+//
+//************************************************************************
+
+void CLCDColorProgressBar::DrawSoft(CLCDGfxSoft &rSoft)
+{
+    RECT rBoundary = { 0, 0, GetWidth(), GetHeight() };
+
+    // Draw the background/border or just background
+    rSoft.FillRect(rBoundary, m_crBackgroundColor);
+    if (m_bBorderOn && (m_nBorderThickness > 0))
+    {
+        for(int i = 0; i < m_nBorderThickness; ++i)
+        {
+            rSoft.FrameRect(rBoundary, m_crBorderColor);
+            InflateRect(&rBoundary, -1, -1);
+        }
+    }
+
+    //Drawing the cursor
+    RECT r = rBoundary;
+    switch(m_eStyle)
+    {
+    case STYLE_CURSOR:
+    case STYLE_DASHED_CURSOR:
+        {
+            int nCursorPos = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
+                (float)rBoundary.left, (float)(rBoundary.right - m_nCursorWidth),
+                m_fPos);
+            if(STYLE_DASHED_CURSOR == m_eStyle)
+            {
+                int nY = (r.bottom - r.top)/2;
+                for(int x = rBoundary.left; x < nCursorPos; x += 2)
+                {
+                    rSoft.HLine(x, x + 1, nY, m_crForegroundColor);
+                }
+            }
+            r.left = nCursorPos;
+            r.right = nCursorPos + m_nCursorWidth;
+            rSoft.FillRect(r, m_crForegroundColor);
+            break;
+        }
+    case STYLE_FILLED:
+        {
+            int nBarWidth = (int)Scalef((float)m_Range.nMin, (float)m_Range.nMax,
+                (float)rBoundary.left, (float)(rBoundary.right),
+                m_fPos);
+            r.right = nBarWidth ? nBarWidth : r.left;
+            rSoft.FillRect(r, m_crForegroundColor);
+            break;
+        }
+    default:
+        break;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::SetCursorColor
+//
+//************************************************************************
+
+void CLCDColorProgressBar::SetCursorColor(COLORREF color)
+{
+    SetForegroundColor(color);
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::EnableBorder
+//
+//************************************************************************
+
+void CLCDColorProgressBar::EnableBorder(BOOL bEnable)
+{
+    m_bBorderOn = bEnable;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::SetBorderColor
+//
+//************************************************************************
+
+void CLCDColorProgressBar::SetBorderColor(COLORREF color)
+{
+    m_crBorderColor = color;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::SetBorderThickness
+//
+//************************************************************************
+
+void CLCDColorProgressBar::SetBorderThickness(int thickness)
+{
+    m_nBorderThickness = thickness;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDColorProgressBar::SetCursorWidth
+//
+//************************************************************************
+
+void CLCDColorProgressBar::SetCursorWidth(int width)
+{
+    m_nCursorWidth = width;
+    Invalidate();
+}
+
+//** end of LCDColorProgressBar.cpp **************************************
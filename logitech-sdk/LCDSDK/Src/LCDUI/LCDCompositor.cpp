@@ -0,0 +1,910 @@
+//************************************************************************
+//
+// LCDCompositor.cpp
+//
+// CLCDImage holds a bitmap as premultiplied 32bpp BGRA pixels, converted
+// once when the bitmap is assigned. CLCDCompositor blends such images
+// onto 32bpp surfaces without a device context, replacing AlphaBlend().
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define LCDUI_SSE2
+#endif
+
+// only when the compiler targets AVX2 (/arch:AVX2)
+#if defined(LCDUI_SSE2) && defined(__AVX2__)
+#include <immintrin.h>
+#define LCDUI_AVX2
+#endif
+
+
+//************************************************************************
+//
+// x * a / 255, rounded, for 0 <= x, a <= 255. The vector versions below
+// compute exactly the same values.
+//
+//************************************************************************
+
+static inline UINT Mul255(UINT x, UINT a)
+{
+    UINT t = x * a + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+#ifdef LCDUI_SSE2
+static inline __m128i Mul255Epi16(__m128i xmmX, __m128i xmmA)
+{
+    __m128i xmmT = _mm_add_epi16(_mm_mullo_epi16(xmmX, xmmA), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(xmmT, _mm_srli_epi16(xmmT, 8)), 8);
+}
+
+// replicates the alpha word of each of the two pixels over its channels
+static inline __m128i BroadcastAlphaEpi16(__m128i xmmPixels)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(xmmPixels, _MM_SHUFFLE(3, 3, 3, 3)),
+                               _MM_SHUFFLE(3, 3, 3, 3));
+}
+#endif
+
+#ifdef LCDUI_SSE2
+// two 16 bit weights, for _mm_madd_epi16() on interleaved values
+static inline __m128i WeightPairEpi32(int nFirst, int nSecond)
+{
+    return _mm_set1_epi32((nSecond << 16) | nFirst);
+}
+#endif
+
+
+//************************************************************************
+//
+// Source pixels and weights, in CLCDCompositor::SCALE_ONE units, for
+// each of nDst pixels resampled from nSrc: a box filter when shrinking,
+// so that every source pixel counts, a tent when enlarging. Every pixel
+// gets the same even number of taps, the unused ones weigh nothing.
+// Returns the number of taps.
+//
+//************************************************************************
+
+static int BuildScaleTaps(int nSrc, int nDst, std::vector<int> &Sources, std::vector<int> &Weights)
+{
+    double dScale = (double)nSrc / nDst;
+    int nTaps = (nDst < nSrc) ? (int)ceil(dScale) + 1 : 2;
+    nTaps = (nTaps + 1) & ~1;
+
+    Sources.assign((size_t)nDst * nTaps, 0);
+    Weights.assign((size_t)nDst * nTaps, 0);
+
+    std::vector<double> Exact(nTaps);
+    for(int i = 0; i < nDst; ++i)
+    {
+        int *pSources = &Sources[(size_t)i * nTaps];
+        int *pWeights = &Weights[(size_t)i * nTaps];
+        int nUsed = 0;
+
+        if(nDst < nSrc)
+        {
+            // the part of each source pixel under [dLow, dHigh)
+            double dLow = i * dScale;
+            double dHigh = (i + 1) * dScale;
+            for(int j = (int)floor(dLow); (j < nSrc) && (j < dHigh) && (nUsed < nTaps); ++j)
+            {
+                double dCover = min(dHigh, (double)(j + 1)) - max(dLow, (double)j);
+                if(0.0 < dCover)
+                {
+                    pSources[nUsed] = j;
+                    Exact[nUsed++] = dCover / dScale;
+                }
+            }
+        }
+        else
+        {
+            double dCenter = (i + 0.5) * dScale - 0.5;
+            int j = (int)floor(dCenter);
+            double dFract = dCenter - j;
+            pSources[0] = max(0, min(j, nSrc - 1));
+            pSources[1] = max(0, min(j + 1, nSrc - 1));
+            Exact[0] = 1.0 - dFract;
+            Exact[1] = dFract;
+            nUsed = 2;
+        }
+
+        // rounded, with the difference on the heaviest tap so that the
+        // sum is exact and opaque stays opaque
+        int nSum = 0;
+        int nHeaviest = 0;
+        for(int t = 0; t < nUsed; ++t)
+        {
+            pWeights[t] = (int)(Exact[t] * CLCDCompositor::SCALE_ONE + 0.5);
+            nSum += pWeights[t];
+            if(pWeights[t] > pWeights[nHeaviest])
+            {
+                nHeaviest = t;
+            }
+        }
+        pWeights[nHeaviest] += CLCDCompositor::SCALE_ONE - nSum;
+
+        for(int t = nUsed; t < nTaps; ++t)
+        {
+            pSources[t] = pSources[0];
+        }
+    }
+
+    return nTaps;
+}
+
+#ifdef LCDUI_AVX2
+static inline __m256i Mul255Epi16(__m256i ymmX, __m256i ymmA)
+{
+    __m256i ymmT = _mm256_add_epi16(_mm256_mullo_epi16(ymmX, ymmA), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(ymmT, _mm256_srli_epi16(ymmT, 8)), 8);
+}
+
+static inline __m256i BroadcastAlphaEpi16(__m256i ymmPixels)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(ymmPixels, _MM_SHUFFLE(3, 3, 3, 3)),
+                                  _MM_SHUFFLE(3, 3, 3, 3));
+}
+#endif
+
+
+//************************************************************************
+//
+// CLCDImage::CLCDImage
+//
+//************************************************************************
+
+CLCDImage::CLCDImage(void)
+:   m_nWidth(0),
+    m_nHeight(0),
+    m_hSource(NULL),
+    m_bHasAlpha(FALSE)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDImage::~CLCDImage
+//
+//************************************************************************
+
+CLCDImage::~CLCDImage(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDImage::SetBitmap
+//
+// The bitmap must not be selected into a device context at this point.
+//
+//************************************************************************
+
+HRESULT CLCDImage::SetBitmap(HBITMAP hBitmap, BOOL bPremultiply)
+{
+    Clear();
+
+    if(NULL == hBitmap)
+    {
+        return S_OK;
+    }
+
+    BITMAP bm;
+    ZeroMemory(&bm, sizeof(bm));
+    if((0 == GetObject(hBitmap, sizeof(bm), &bm)) || (0 >= bm.bmWidth) || (0 == bm.bmHeight))
+    {
+        LCDUITRACE(_T("CLCDImage::SetBitmap(): invalid bitmap.\n"));
+        return E_INVALIDARG;
+    }
+
+    int nWidth = bm.bmWidth;
+    int nHeight = abs(bm.bmHeight);
+
+    BITMAPINFO bmi;
+    ZeroMemory(&bmi, sizeof(bmi));
+    bmi.bmiHeader.biSize = sizeof(bmi.bmiHeader);
+    bmi.bmiHeader.biWidth = nWidth;
+    bmi.bmiHeader.biHeight = -nHeight;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    m_Bits.resize((size_t)nWidth * nHeight * 4);
+    HDC hDC = CreateCompatibleDC(NULL);
+    int nLines = GetDIBits(hDC, hBitmap, 0, nHeight, &m_Bits[0], &bmi, DIB_RGB_COLORS);
+    DeleteDC(hDC);
+    if(nLines != nHeight)
+    {
+        LCDUITRACE(_T("CLCDImage::SetBitmap(): GetDIBits failed.\n"));
+        Clear();
+        return E_FAIL;
+    }
+
+    m_nWidth = nWidth;
+    m_nHeight = nHeight;
+    m_hSource = hBitmap;
+
+    if(32 != bm.bmBitsPixel)
+    {
+        // no alpha channel, GetDIBits leaves it at zero
+        for(size_t i = 3; i < m_Bits.size(); i += 4)
+        {
+            m_Bits[i] = 0xFF;
+        }
+    }
+    else if(bPremultiply)
+    {
+        for(int y = 0; y < m_nHeight; ++y)
+        {
+            PBYTE pRow = &m_Bits[(size_t)y * GetPitch()];
+            CLCDCompositor::PremultiplyRow(pRow, pRow, m_nWidth);
+        }
+    }
+
+    m_bHasAlpha = FALSE;
+    for(size_t i = 3; i < m_Bits.size(); i += 4)
+    {
+        if(0xFF != m_Bits[i])
+        {
+            m_bHasAlpha = TRUE;
+            break;
+        }
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::Create
+//
+//************************************************************************
+
+HRESULT CLCDImage::Create(int nWidth, int nHeight, const BYTE *pBits, int nPitch,
+                          BOOL bPremultiply)
+{
+    Clear();
+
+    LCDUIASSERT(NULL != pBits);
+    if((NULL == pBits) || (0 >= nWidth) || (0 >= nHeight))
+    {
+        return E_INVALIDARG;
+    }
+
+    m_nWidth = nWidth;
+    m_nHeight = nHeight;
+    m_Bits.resize((size_t)nWidth * nHeight * 4);
+
+    m_bHasAlpha = FALSE;
+    for(int y = 0; y < nHeight; ++y)
+    {
+        PBYTE pRow = &m_Bits[(size_t)y * GetPitch()];
+        if(bPremultiply)
+        {
+            CLCDCompositor::PremultiplyRow(pRow, pBits + y * nPitch, nWidth);
+        }
+        else
+        {
+            memcpy(pRow, pBits + y * nPitch, GetPitch());
+        }
+
+        for(int x = 0; (x < nWidth) && !m_bHasAlpha; ++x)
+        {
+            m_bHasAlpha = (0xFF != pRow[x * 4 + 3]);
+        }
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::CreateScaled
+//
+// Filters the columns of the source rows into one row, then that row
+// into the output pixels.
+//
+//************************************************************************
+
+HRESULT CLCDImage::CreateScaled(const CLCDImage &rSource, const RECT *prcSource,
+                                int nWidth, int nHeight)
+{
+    Clear();
+
+    RECT rcSrc = { 0, 0, rSource.GetWidth(), rSource.GetHeight() };
+    if((NULL != prcSource) && !IntersectRect(&rcSrc, prcSource, &rcSrc))
+    {
+        SetRectEmpty(&rcSrc);
+    }
+    if(rSource.IsEmpty() || IsRectEmpty(&rcSrc) || (0 >= nWidth) || (0 >= nHeight))
+    {
+        return E_INVALIDARG;
+    }
+
+    int nSrcWidth = rcSrc.right - rcSrc.left;
+    int nSrcHeight = rcSrc.bottom - rcSrc.top;
+
+    std::vector<int> ColumnSources, ColumnWeights, RowSources, RowWeights;
+    int nColumnTaps = BuildScaleTaps(nSrcWidth, nWidth, ColumnSources, ColumnWeights);
+    int nRowTaps = BuildScaleTaps(nSrcHeight, nHeight, RowSources, RowWeights);
+
+    m_nWidth = nWidth;
+    m_nHeight = nHeight;
+    m_Bits.resize((size_t)nWidth * nHeight * 4);
+
+    std::vector<BYTE> Row((size_t)nSrcWidth * 4);
+    std::vector<const BYTE *> SrcRows(nRowTaps);
+    const BYTE *pSrcBits = rSource.GetBits() + rcSrc.top * rSource.GetPitch() + rcSrc.left * 4;
+    for(int y = 0; y < nHeight; ++y)
+    {
+        for(int t = 0; t < nRowTaps; ++t)
+        {
+            SrcRows[t] = pSrcBits + RowSources[(size_t)y * nRowTaps + t] * rSource.GetPitch();
+        }
+        CLCDCompositor::ResampleRows(&Row[0], &SrcRows[0], &RowWeights[(size_t)y * nRowTaps],
+                                     nRowTaps, nSrcWidth * 4);
+        CLCDCompositor::ResampleRow(&m_Bits[(size_t)y * GetPitch()], &Row[0], &ColumnSources[0],
+                                    &ColumnWeights[0], nColumnTaps, nWidth);
+    }
+
+    m_bHasAlpha = rSource.HasAlpha();
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::Clear
+//
+//************************************************************************
+
+void CLCDImage::Clear(void)
+{
+    m_Bits.clear();
+    m_nWidth = 0;
+    m_nHeight = 0;
+    m_hSource = NULL;
+    m_bHasAlpha = FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::IsEmpty
+//
+//************************************************************************
+
+BOOL CLCDImage::IsEmpty(void) const
+{
+    return m_Bits.empty();
+}
+
+
+//************************************************************************
+//
+// CLCDImage::GetWidth
+//
+//************************************************************************
+
+int CLCDImage::GetWidth(void) const
+{
+    return m_nWidth;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::GetHeight
+//
+//************************************************************************
+
+int CLCDImage::GetHeight(void) const
+{
+    return m_nHeight;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::GetPitch
+//
+//************************************************************************
+
+int CLCDImage::GetPitch(void) const
+{
+    return m_nWidth * 4;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::GetBits
+//
+//************************************************************************
+
+const BYTE *CLCDImage::GetBits(void) const
+{
+    return m_Bits.empty() ? NULL : &m_Bits[0];
+}
+
+
+//************************************************************************
+//
+// CLCDImage::GetSourceBitmap
+//
+//************************************************************************
+
+HBITMAP CLCDImage::GetSourceBitmap(void) const
+{
+    return m_hSource;
+}
+
+
+//************************************************************************
+//
+// CLCDImage::HasAlpha
+//
+//************************************************************************
+
+BOOL CLCDImage::HasAlpha(void) const
+{
+    return m_bHasAlpha;
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::Composite
+//
+//************************************************************************
+
+void CLCDCompositor::Composite(PBYTE pDstBits, int nDstPitch, const RECT &rcClip,
+                               const RECT &rcDst, const CLCDImage &rImage, const RECT *prcSrc,
+                               BYTE byAlpha, BOOL bPerPixelAlpha)
+{
+    LCDUIASSERT(NULL != pDstBits);
+    if((NULL == pDstBits) || rImage.IsEmpty() || (0 == byAlpha))
+    {
+        return;
+    }
+
+    RECT rcImage = { 0, 0, rImage.GetWidth(), rImage.GetHeight() };
+    RECT rcSrc = rcImage;
+    if((NULL != prcSrc) && !IntersectRect(&rcSrc, prcSrc, &rcImage))
+    {
+        return;
+    }
+
+    int nDstWidth = rcDst.right - rcDst.left;
+    int nDstHeight = rcDst.bottom - rcDst.top;
+    int nSrcWidth = rcSrc.right - rcSrc.left;
+    int nSrcHeight = rcSrc.bottom - rcSrc.top;
+
+    RECT rc;
+    if((0 >= nDstWidth) || (0 >= nDstHeight) || !IntersectRect(&rc, &rcDst, &rcClip))
+    {
+        return;
+    }
+
+    int nWidth = rc.right - rc.left;
+    BOOL bScaled = (nDstWidth != nSrcWidth) || (nDstHeight != nSrcHeight);
+    BOOL bCopy = (255 == byAlpha) && (!bPerPixelAlpha || !rImage.HasAlpha());
+
+    // point sampled source columns, and a row to gather them into
+    std::vector<int> Columns;
+    std::vector<DWORD> Row;
+    if(bScaled)
+    {
+        Columns.resize(nWidth);
+        Row.resize(nWidth);
+        for(int i = 0; i < nWidth; ++i)
+        {
+            Columns[i] = rcSrc.left + (rc.left + i - rcDst.left) * nSrcWidth / nDstWidth;
+        }
+    }
+
+    for(int y = rc.top; y < rc.bottom; ++y)
+    {
+        int nSrcY = rcSrc.top + (y - rcDst.top) * nSrcHeight / nDstHeight;
+        const BYTE *pSrcRow = rImage.GetBits() + nSrcY * rImage.GetPitch();
+        const BYTE *pSrc = pSrcRow + (rcSrc.left + rc.left - rcDst.left) * 4;
+        if(bScaled)
+        {
+            const DWORD *pSrcPixels = (const DWORD *)pSrcRow;
+            for(int i = 0; i < nWidth; ++i)
+            {
+                Row[i] = pSrcPixels[Columns[i]];
+            }
+            pSrc = (const BYTE *)&Row[0];
+        }
+
+        PBYTE pDst = pDstBits + y * nDstPitch + rc.left * 4;
+        if(bCopy)
+        {
+            memcpy(pDst, pSrc, nWidth * 4);
+        }
+        else if(255 == byAlpha)
+        {
+            BlendRow(pDst, pSrc, nWidth);
+        }
+        else
+        {
+            BlendRowConstant(pDst, pSrc, nWidth, byAlpha, bPerPixelAlpha);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::BlendRow
+//
+// dst = src + dst * (1 - src.alpha)
+//
+//************************************************************************
+
+void CLCDCompositor::BlendRow(PBYTE pDst, const BYTE *pSrc, int nWidth)
+{
+    int x = 0;
+
+#ifdef LCDUI_AVX2
+    const __m256i ymmZero = _mm256_setzero_si256();
+    const __m256i ymm255 = _mm256_set1_epi16(255);
+    for(; x + 8 <= nWidth; x += 8)
+    {
+        __m256i ymmSrc = _mm256_loadu_si256((const __m256i *)(pSrc + x * 4));
+        __m256i ymmDst = _mm256_loadu_si256((const __m256i *)(pDst + x * 4));
+        __m256i ymmLo = _mm256_sub_epi16(ymm255, BroadcastAlphaEpi16(_mm256_unpacklo_epi8(ymmSrc, ymmZero)));
+        __m256i ymmHi = _mm256_sub_epi16(ymm255, BroadcastAlphaEpi16(_mm256_unpackhi_epi8(ymmSrc, ymmZero)));
+        ymmLo = Mul255Epi16(_mm256_unpacklo_epi8(ymmDst, ymmZero), ymmLo);
+        ymmHi = Mul255Epi16(_mm256_unpackhi_epi8(ymmDst, ymmZero), ymmHi);
+        _mm256_storeu_si256((__m256i *)(pDst + x * 4),
+            _mm256_adds_epu8(ymmSrc, _mm256_packus_epi16(ymmLo, ymmHi)));
+    }
+#endif
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmZero = _mm_setzero_si128();
+    const __m128i xmm255 = _mm_set1_epi16(255);
+    const __m128i xmmOnes = _mm_set1_epi8((char)0xFF);
+    for(; x + 4 <= nWidth; x += 4)
+    {
+        __m128i xmmSrc = _mm_loadu_si128((const __m128i *)(pSrc + x * 4));
+
+        // opaque pixels replace the destination
+        if(0x8888 == (_mm_movemask_epi8(_mm_cmpeq_epi8(xmmSrc, xmmOnes)) & 0x8888))
+        {
+            _mm_storeu_si128((__m128i *)(pDst + x * 4), xmmSrc);
+            continue;
+        }
+
+        __m128i xmmDst = _mm_loadu_si128((const __m128i *)(pDst + x * 4));
+        __m128i xmmLo = _mm_sub_epi16(xmm255, BroadcastAlphaEpi16(_mm_unpacklo_epi8(xmmSrc, xmmZero)));
+        __m128i xmmHi = _mm_sub_epi16(xmm255, BroadcastAlphaEpi16(_mm_unpackhi_epi8(xmmSrc, xmmZero)));
+        xmmLo = Mul255Epi16(_mm_unpacklo_epi8(xmmDst, xmmZero), xmmLo);
+        xmmHi = Mul255Epi16(_mm_unpackhi_epi8(xmmDst, xmmZero), xmmHi);
+        _mm_storeu_si128((__m128i *)(pDst + x * 4),
+            _mm_adds_epu8(xmmSrc, _mm_packus_epi16(xmmLo, xmmHi)));
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        const BYTE *pS = pSrc + x * 4;
+        PBYTE pD = pDst + x * 4;
+        UINT nInvAlpha = 255 - pS[3];
+        for(int c = 0; c < 4; ++c)
+        {
+            pD[c] = (BYTE)min(255U, pS[c] + Mul255(pD[c], nInvAlpha));
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::BlendRowConstant
+//
+// src' = src * a, then
+//  dst = src' + dst * (1 - src'.alpha)   with per pixel alpha
+//  dst = src' + dst * (1 - a)            without
+//
+//************************************************************************
+
+void CLCDCompositor::BlendRowConstant(PBYTE pDst, const BYTE *pSrc, int nWidth,
+                                      BYTE byAlpha, BOOL bPerPixelAlpha)
+{
+    int x = 0;
+
+#ifdef LCDUI_AVX2
+    const __m256i ymmZero = _mm256_setzero_si256();
+    const __m256i ymm255 = _mm256_set1_epi16(255);
+    const __m256i ymmAlpha = _mm256_set1_epi16(byAlpha);
+    for(; x + 8 <= nWidth; x += 8)
+    {
+        __m256i ymmSrc = _mm256_loadu_si256((const __m256i *)(pSrc + x * 4));
+        __m256i ymmDst = _mm256_loadu_si256((const __m256i *)(pDst + x * 4));
+        __m256i ymmSrcLo = Mul255Epi16(_mm256_unpacklo_epi8(ymmSrc, ymmZero), ymmAlpha);
+        __m256i ymmSrcHi = Mul255Epi16(_mm256_unpackhi_epi8(ymmSrc, ymmZero), ymmAlpha);
+        __m256i ymmInvLo = _mm256_sub_epi16(ymm255, bPerPixelAlpha ? BroadcastAlphaEpi16(ymmSrcLo) : ymmAlpha);
+        __m256i ymmInvHi = _mm256_sub_epi16(ymm255, bPerPixelAlpha ? BroadcastAlphaEpi16(ymmSrcHi) : ymmAlpha);
+        __m256i ymmLo = Mul255Epi16(_mm256_unpacklo_epi8(ymmDst, ymmZero), ymmInvLo);
+        __m256i ymmHi = Mul255Epi16(_mm256_unpackhi_epi8(ymmDst, ymmZero), ymmInvHi);
+        _mm256_storeu_si256((__m256i *)(pDst + x * 4),
+            _mm256_adds_epu8(_mm256_packus_epi16(ymmSrcLo, ymmSrcHi), _mm256_packus_epi16(ymmLo, ymmHi)));
+    }
+#endif
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmZero = _mm_setzero_si128();
+    const __m128i xmm255 = _mm_set1_epi16(255);
+    const __m128i xmmAlpha = _mm_set1_epi16(byAlpha);
+    for(; x + 4 <= nWidth; x += 4)
+    {
+        __m128i xmmSrc = _mm_loadu_si128((const __m128i *)(pSrc + x * 4));
+        __m128i xmmDst = _mm_loadu_si128((const __m128i *)(pDst + x * 4));
+        __m128i xmmSrcLo = Mul255Epi16(_mm_unpacklo_epi8(xmmSrc, xmmZero), xmmAlpha);
+        __m128i xmmSrcHi = Mul255Epi16(_mm_unpackhi_epi8(xmmSrc, xmmZero), xmmAlpha);
+        __m128i xmmInvLo = _mm_sub_epi16(xmm255, bPerPixelAlpha ? BroadcastAlphaEpi16(xmmSrcLo) : xmmAlpha);
+        __m128i xmmInvHi = _mm_sub_epi16(xmm255, bPerPixelAlpha ? BroadcastAlphaEpi16(xmmSrcHi) : xmmAlpha);
+        __m128i xmmLo = Mul255Epi16(_mm_unpacklo_epi8(xmmDst, xmmZero), xmmInvLo);
+        __m128i xmmHi = Mul255Epi16(_mm_unpackhi_epi8(xmmDst, xmmZero), xmmInvHi);
+        _mm_storeu_si128((__m128i *)(pDst + x * 4),
+            _mm_adds_epu8(_mm_packus_epi16(xmmSrcLo, xmmSrcHi), _mm_packus_epi16(xmmLo, xmmHi)));
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        const BYTE *pS = pSrc + x * 4;
+        PBYTE pD = pDst + x * 4;
+        UINT nSrcAlpha = Mul255(pS[3], byAlpha);
+        UINT nInvAlpha = 255 - (bPerPixelAlpha ? nSrcAlpha : byAlpha);
+        for(int c = 0; c < 4; ++c)
+        {
+            pD[c] = (BYTE)min(255U, Mul255(pS[c], byAlpha) + Mul255(pD[c], nInvAlpha));
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::PremultiplyRow
+//
+// pDst may be the same as pSrc.
+//
+//************************************************************************
+
+void CLCDCompositor::PremultiplyRow(PBYTE pDst, const BYTE *pSrc, int nWidth)
+{
+    int x = 0;
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmZero = _mm_setzero_si128();
+    const __m128i xmmAlphaMask = _mm_set1_epi32(0xFF000000);
+    for(; x + 4 <= nWidth; x += 4)
+    {
+        __m128i xmmSrc = _mm_loadu_si128((const __m128i *)(pSrc + x * 4));
+        __m128i xmmLo = _mm_unpacklo_epi8(xmmSrc, xmmZero);
+        __m128i xmmHi = _mm_unpackhi_epi8(xmmSrc, xmmZero);
+        xmmLo = Mul255Epi16(xmmLo, BroadcastAlphaEpi16(xmmLo));
+        xmmHi = Mul255Epi16(xmmHi, BroadcastAlphaEpi16(xmmHi));
+        // the alpha channel itself stays as it was
+        __m128i xmmColor = _mm_andnot_si128(xmmAlphaMask, _mm_packus_epi16(xmmLo, xmmHi));
+        _mm_storeu_si128((__m128i *)(pDst + x * 4),
+            _mm_or_si128(xmmColor, _mm_and_si128(xmmSrc, xmmAlphaMask)));
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        const BYTE *pS = pSrc + x * 4;
+        PBYTE pD = pDst + x * 4;
+        BYTE byAlpha = pS[3];
+        pD[0] = (BYTE)Mul255(pS[0], byAlpha);
+        pD[1] = (BYTE)Mul255(pS[1], byAlpha);
+        pD[2] = (BYTE)Mul255(pS[2], byAlpha);
+        pD[3] = byAlpha;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::ResampleRows
+//
+// Weighs the same byte of every row, rounded.
+//
+//************************************************************************
+
+void CLCDCompositor::ResampleRows(PBYTE pDst, const BYTE * const *ppSrcRows, const int *pWeights,
+                                  int nTaps, int nBytes)
+{
+    LCDUIASSERT(0 == (nTaps & 1));
+    int i = 0;
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmZero = _mm_setzero_si128();
+    const __m128i xmmRound = _mm_set1_epi32(SCALE_ONE / 2);
+    for(; i + 16 <= nBytes; i += 16)
+    {
+        __m128i xmmSum0 = xmmRound, xmmSum1 = xmmRound, xmmSum2 = xmmRound, xmmSum3 = xmmRound;
+        for(int t = 0; t < nTaps; t += 2)
+        {
+            // bytes of two rows interleaved, weighed and added in pairs
+            __m128i xmmWeights = WeightPairEpi32(pWeights[t], pWeights[t + 1]);
+            __m128i xmmFirst = _mm_loadu_si128((const __m128i *)(ppSrcRows[t] + i));
+            __m128i xmmSecond = _mm_loadu_si128((const __m128i *)(ppSrcRows[t + 1] + i));
+            __m128i xmmLo = _mm_unpacklo_epi8(xmmFirst, xmmSecond);
+            __m128i xmmHi = _mm_unpackhi_epi8(xmmFirst, xmmSecond);
+            xmmSum0 = _mm_add_epi32(xmmSum0, _mm_madd_epi16(_mm_unpacklo_epi8(xmmLo, xmmZero), xmmWeights));
+            xmmSum1 = _mm_add_epi32(xmmSum1, _mm_madd_epi16(_mm_unpackhi_epi8(xmmLo, xmmZero), xmmWeights));
+            xmmSum2 = _mm_add_epi32(xmmSum2, _mm_madd_epi16(_mm_unpacklo_epi8(xmmHi, xmmZero), xmmWeights));
+            xmmSum3 = _mm_add_epi32(xmmSum3, _mm_madd_epi16(_mm_unpackhi_epi8(xmmHi, xmmZero), xmmWeights));
+        }
+        __m128i xmmLo = _mm_packs_epi32(_mm_srai_epi32(xmmSum0, SCALE_BITS), _mm_srai_epi32(xmmSum1, SCALE_BITS));
+        __m128i xmmHi = _mm_packs_epi32(_mm_srai_epi32(xmmSum2, SCALE_BITS), _mm_srai_epi32(xmmSum3, SCALE_BITS));
+        _mm_storeu_si128((__m128i *)(pDst + i), _mm_packus_epi16(xmmLo, xmmHi));
+    }
+#endif
+
+    for(; i < nBytes; ++i)
+    {
+        int nSum = SCALE_ONE / 2;
+        for(int t = 0; t < nTaps; ++t)
+        {
+            nSum += ppSrcRows[t][i] * pWeights[t];
+        }
+        pDst[i] = (BYTE)(nSum >> SCALE_BITS);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::ResampleRow
+//
+// Weighs the pixels of one row, rounded.
+//
+//************************************************************************
+
+void CLCDCompositor::ResampleRow(PBYTE pDst, const BYTE *pSrc, const int *pSources,
+                                 const int *pWeights, int nTaps, int nWidth)
+{
+    LCDUIASSERT(0 == (nTaps & 1));
+    const DWORD *pSrcPixels = (const DWORD *)pSrc;
+    int x = 0;
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmZero = _mm_setzero_si128();
+    const __m128i xmmRound = _mm_set1_epi32(SCALE_ONE / 2);
+    for(; x < nWidth; ++x)
+    {
+        const int *pS = pSources + x * nTaps;
+        const int *pW = pWeights + x * nTaps;
+        __m128i xmmSum = xmmRound;
+        for(int t = 0; t < nTaps; t += 2)
+        {
+            // channels of two pixels interleaved, weighed and added in pairs
+            __m128i xmmPair = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)pSrcPixels[pS[t]]),
+                                                _mm_cvtsi32_si128((int)pSrcPixels[pS[t + 1]]));
+            xmmSum = _mm_add_epi32(xmmSum, _mm_madd_epi16(_mm_unpacklo_epi8(xmmPair, xmmZero),
+                                                          WeightPairEpi32(pW[t], pW[t + 1])));
+        }
+        xmmSum = _mm_srai_epi32(xmmSum, SCALE_BITS);
+        xmmSum = _mm_packus_epi16(_mm_packs_epi32(xmmSum, xmmZero), xmmZero);
+        ((DWORD *)pDst)[x] = (DWORD)_mm_cvtsi128_si32(xmmSum);
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        const int *pS = pSources + x * nTaps;
+        const int *pW = pWeights + x * nTaps;
+        PBYTE pD = pDst + x * 4;
+        for(int c = 0; c < 4; ++c)
+        {
+            int nSum = SCALE_ONE / 2;
+            for(int t = 0; t < nTaps; ++t)
+            {
+                nSum += pSrc[pS[t] * 4 + c] * pW[t];
+            }
+            pD[c] = (BYTE)(nSum >> SCALE_BITS);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::BlendCoverageRow
+//
+// Draws crColor over 32bpp pixels, weighted by the coverage.
+//
+//************************************************************************
+
+void CLCDCompositor::BlendCoverageRow(PBYTE pDst, const BYTE *pCoverage, int nWidth, COLORREF crColor)
+{
+    // BGRA, as in the surface
+    DWORD dwColor = 0xFF000000 | (GetRValue(crColor) << 16) | (GetGValue(crColor) << 8) | GetBValue(crColor);
+    int x = 0;
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmZero = _mm_setzero_si128();
+    const __m128i xmmMax = _mm_set1_epi16(255);
+    const __m128i xmmColor = _mm_unpacklo_epi8(_mm_set1_epi32((int)dwColor), xmmZero);
+    for(; x + 4 <= nWidth; x += 4)
+    {
+        DWORD dwCoverage = *(const UNALIGNED DWORD *)(pCoverage + x);
+        if(0 == dwCoverage)
+        {
+            continue;
+        }
+
+        // one coverage byte for each channel of the four pixels
+        __m128i xmmCoverage = _mm_cvtsi32_si128((int)dwCoverage);
+        xmmCoverage = _mm_unpacklo_epi8(xmmCoverage, xmmCoverage);
+        xmmCoverage = _mm_unpacklo_epi8(xmmCoverage, xmmCoverage);
+        __m128i xmmCovLo = _mm_unpacklo_epi8(xmmCoverage, xmmZero);
+        __m128i xmmCovHi = _mm_unpackhi_epi8(xmmCoverage, xmmZero);
+
+        __m128i xmmDst = _mm_loadu_si128((const __m128i *)(pDst + x * 4));
+        __m128i xmmLo = _mm_add_epi16(Mul255Epi16(xmmColor, xmmCovLo),
+            Mul255Epi16(_mm_unpacklo_epi8(xmmDst, xmmZero), _mm_sub_epi16(xmmMax, xmmCovLo)));
+        __m128i xmmHi = _mm_add_epi16(Mul255Epi16(xmmColor, xmmCovHi),
+            Mul255Epi16(_mm_unpackhi_epi8(xmmDst, xmmZero), _mm_sub_epi16(xmmMax, xmmCovHi)));
+        _mm_storeu_si128((__m128i *)(pDst + x * 4), _mm_packus_epi16(xmmLo, xmmHi));
+    }
+#endif
+
+    const BYTE *pColor = (const BYTE *)&dwColor;
+    for(; x < nWidth; ++x)
+    {
+        UINT nCoverage = pCoverage[x];
+        if(0 == nCoverage)
+        {
+            continue;
+        }
+
+        PBYTE pD = pDst + x * 4;
+        UINT nInvCoverage = 255 - nCoverage;
+        for(int c = 0; c < 4; ++c)
+        {
+            pD[c] = (BYTE)min(255U, Mul255(pColor[c], nCoverage) + Mul255(pD[c], nInvCoverage));
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDCompositor::ThresholdCoverageRow
+//
+// Sets 8bpp pixels that are at least half covered to byValue.
+//
+//************************************************************************
+
+void CLCDCompositor::ThresholdCoverageRow(PBYTE pDst, const BYTE *pCoverage, int nWidth, BYTE byValue)
+{
+    for(int x = 0; x < nWidth; ++x)
+    {
+        if(128 <= pCoverage[x])
+        {
+            pDst[x] = byValue;
+        }
+    }
+}
+
+
+//** end of LCDCompositor.cpp ********************************************
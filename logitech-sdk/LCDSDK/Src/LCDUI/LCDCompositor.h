@@ -0,0 +1,93 @@
+//************************************************************************
+//
+// LCDCompositor.h
+//
+// CLCDImage holds a bitmap as premultiplied 32bpp BGRA pixels, converted
+// once when the bitmap is assigned. CLCDCompositor blends such images
+// onto 32bpp surfaces without a device context, replacing AlphaBlend().
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDCOMPOSITOR_H_INCLUDED_
+#define _LCDCOMPOSITOR_H_INCLUDED_
+
+class CLCDImage
+{
+public:
+    CLCDImage(void);
+    virtual ~CLCDImage(void);
+
+    // 32bpp bitmaps are expected to be premultiplied, as with AlphaBlend(),
+    // unless bPremultiply is set. Bitmaps of other depths become opaque.
+    HRESULT SetBitmap(HBITMAP hBitmap, BOOL bPremultiply = FALSE);
+    HRESULT Create(int nWidth, int nHeight, const BYTE *pBits, int nPitch,
+                   BOOL bPremultiply = FALSE);
+    // Resamples rSource, or the prcSource part of it, to nWidth x nHeight:
+    // averaged over the pixels covered when shrinking, interpolated
+    // bilinearly when enlarging. Opaque images stay opaque.
+    HRESULT CreateScaled(const CLCDImage &rSource, const RECT *prcSource,
+                         int nWidth, int nHeight);
+    void Clear(void);
+
+    BOOL IsEmpty(void) const;
+    int GetWidth(void) const;
+    int GetHeight(void) const;
+    int GetPitch(void) const;
+    const BYTE *GetBits(void) const;
+    HBITMAP GetSourceBitmap(void) const;
+
+    // FALSE if every pixel is opaque, so blending is a copy
+    BOOL HasAlpha(void) const;
+
+protected:
+    // decodes straight into m_Bits
+    friend class CLCDImageDecoder;
+
+    std::vector<BYTE> m_Bits;
+    int m_nWidth;
+    int m_nHeight;
+    HBITMAP m_hSource;
+    BOOL m_bHasAlpha;
+};
+
+
+class CLCDCompositor
+{
+public:
+    // Blends rImage, or the prcSrc part of it, into the rcDst rectangle of
+    // a 32bpp surface. The image is point sampled if the sizes differ, as
+    // with AlphaBlend(). Both rectangles and rcClip are in surface pixels.
+    //  bPerPixelAlpha = TRUE:  dst = src * a + dst * (1 - src.alpha * a)
+    //  bPerPixelAlpha = FALSE: dst = src * a + dst * (1 - a)
+    // where a is byAlpha / 255.
+    static void Composite(PBYTE pDstBits, int nDstPitch, const RECT &rcClip,
+                          const RECT &rcDst, const CLCDImage &rImage, const RECT *prcSrc,
+                          BYTE byAlpha, BOOL bPerPixelAlpha);
+
+    // row kernels, all pixels are premultiplied BGRA
+    static void BlendRow(PBYTE pDst, const BYTE *pSrc, int nWidth);
+    static void BlendRowConstant(PBYTE pDst, const BYTE *pSrc, int nWidth,
+                                 BYTE byAlpha, BOOL bPerPixelAlpha);
+    static void PremultiplyRow(PBYTE pDst, const BYTE *pSrc, int nWidth);
+
+    // resampling kernels, nTaps is even and the weights of an output value
+    // add up to SCALE_ONE
+    enum { SCALE_BITS = 14, SCALE_ONE = 1 << SCALE_BITS };
+    // pDst[i] = sum of ppSrcRows[t][i] * pWeights[t], for nBytes bytes
+    static void ResampleRows(PBYTE pDst, const BYTE * const *ppSrcRows, const int *pWeights,
+                             int nTaps, int nBytes);
+    // pixel x = sum of pixel pSources[x * nTaps + t] * pWeights[x * nTaps + t]
+    static void ResampleRow(PBYTE pDst, const BYTE *pSrc, const int *pSources,
+                            const int *pWeights, int nTaps, int nWidth);
+
+    // glyph kernels, pCoverage holds one byte of coverage per pixel
+    static void BlendCoverageRow(PBYTE pDst, const BYTE *pCoverage, int nWidth, COLORREF crColor);
+    static void ThresholdCoverageRow(PBYTE pDst, const BYTE *pCoverage, int nWidth, BYTE byValue);
+};
+
+#endif // !_LCDCOMPOSITOR_H_INCLUDED_
+
+//** end of LCDCompositor.h **********************************************
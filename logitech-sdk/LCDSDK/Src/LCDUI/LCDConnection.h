@@ -1,146 +1,180 @@
-//************************************************************************
-//
-// LCDConnection.h
-//
-// The CLCDConnection class manages connections to all LCD devices
-// including color and monochrome
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#ifndef __LCDCONNECTION_H__
-#define __LCDCONNECTION_H__
-
-#include "LCDOutput.h"
-#include "LCDGfxMono.h"
-#include "LCDGfxColor.h"
-#include <queue>
-
-// LCD device state
-typedef struct LCD_DEVICE_STATE
-{
-    CLCDOutput* pOutput;
-    CLCDGfxBase* pGfx;
-
-}LCD_DEVICE_STATE;
-
-// Applet state
-typedef struct APPLET_STATE
-{
-    LCD_DEVICE_STATE Color;
-    LCD_DEVICE_STATE Mono;
-    BOOL isEnabled;
-
-}APPLET_STATE;
-
-#define LGLCD_INVALID_DEVICE_COOKIE     (0)
-
-
-class CLCDConnection
-{
-public:
-    CLCDConnection(void);
-    virtual ~CLCDConnection(void);
-
-    //This will attempt to open the library
-    //Call this function before Connect()
-    virtual BOOL Initialize(lgLcdConnectContext & ConnectContext,
-                            lgLcdSoftbuttonsChangedContext* pSoftButtonChangedContext = NULL);
-    virtual BOOL Initialize(lgLcdConnectContextEx & ConnectContext,
-                            lgLcdSoftbuttonsChangedContext* pSoftButtonChangedContext = NULL);
-
-    //This will close your library
-    virtual void Shutdown(void);
-    
-    //Checks if there is a valid connection
-    virtual BOOL IsConnected(void);
-    virtual int  GetConnectionId(void);
-
-    // Call this function every game frame
-    virtual void Update(void);
-
-    // Add your controls to the appropriate display
-    CLCDOutput *ColorOutput(void);
-    CLCDOutput *MonoOutput(void);
-
-    BOOL HasColorDevice() { return m_AppletState.Color.pOutput && m_AppletState.Color.pOutput->IsOpened(); }
-    BOOL HasMonochromeDevice() { return m_AppletState.Mono.pOutput && m_AppletState.Mono.pOutput->IsOpened(); }
-
-protected:
-    // dwDisplayType = LGLCD_DEVICE_BW or LGLCD_DEVICE_QVGA
-    virtual void OnDeviceArrival(DWORD dwDisplayType);
-    virtual void OnDeviceRemoval(DWORD dwDisplayType);
-    virtual void OnAppletEnabled(void);
-    virtual void OnAppletDisabled(void);
-    virtual void OnNotification(DWORD dwNotification, DWORD dwParam1 = 0);
-    virtual void OnConfigure(void);
-    virtual void OnSoftButtonEvent(int nDeviceId, DWORD dwButtonState);
-    virtual void OnCallbackEvent(void) { }
-
-protected:
-    virtual void Connect(void);
-    virtual void Disconnect(void);
-
-protected:
-    // Override only if you need to create custom output classes
-    virtual CLCDOutput* AllocMonoOutput(void);
-    virtual CLCDOutput* AllocColorOutput(void);
-    virtual void FreeMonoOutput(void);
-    virtual void FreeColorOutput(void);
-
-private:
-    lgLcdConnectContextEx m_lcdConnectCtxEx;
-    int m_hConnection;
-
-    APPLET_STATE m_AppletState;
-
-    lgLcdSoftbuttonsChangedContext* m_plcdSoftButtonsChangedCtx;
-
-private:
-    // Internal threaded event handling
-    enum CB_TYPE { CBT_BUTTON, CBT_CONFIG, CBT_NOTIFICATION };
-    typedef struct CB_EVENT
-    {
-        CB_TYPE Type;
-        DWORD CallbackCode;
-        DWORD CallbackParam1;
-        DWORD CallbackParam2;
-        DWORD CallbackParam3;
-        DWORD CallbackParam;
-
-    } CB_EVENT;
-
-    typedef std::queue<CB_EVENT> LCD_CB_EVENT_QUEUE;
-
-    CRITICAL_SECTION m_csCallback;
-    LCD_CB_EVENT_QUEUE m_CallbackEventQueue;
-    
-    BOOL GetNextCallbackEvent(CB_EVENT& rEvent);
-
-private:
-    static LONG g_lInitCount;
-
-    static DWORD CALLBACK _OnNotificationCallback(
-        IN int connection,
-        IN const PVOID pContext,
-        IN DWORD notificationCode,
-        IN DWORD notifyParm1,
-        IN DWORD notifyParm2,
-        IN DWORD notifyParm3,
-        IN DWORD notifyParm4);
-
-    static DWORD CALLBACK _OnSoftButtonsCallback(
-        IN int device,
-        IN DWORD dwButtons,
-        IN const PVOID pContext);
-
-    static DWORD CALLBACK _OnConfigureCallback(
-        IN int connection,
-        IN const PVOID pContext);
-};
-
-#endif
-
-//** end of LCDConnection.h **********************************************
+//************************************************************************
+//
+// LCDConnection.h
+//
+// The CLCDConnection class manages connections to all LCD devices
+// including color and monochrome
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef __LCDCONNECTION_H__
+#define __LCDCONNECTION_H__
+
+#include "LCDOutput.h"
+#include "LCDGfxMono.h"
+#include "LCDGfxColor.h"
+#include <queue>
+
+// LCD device state
+typedef struct LCD_DEVICE_STATE
+{
+    CLCDOutput* pOutput;
+    CLCDGfxBase* pGfx;
+
+}LCD_DEVICE_STATE;
+
+// Applet state
+typedef struct APPLET_STATE
+{
+    LCD_DEVICE_STATE Color;
+    LCD_DEVICE_STATE Mono;
+    BOOL isEnabled;
+
+}APPLET_STATE;
+
+#define LGLCD_INVALID_DEVICE_COOKIE     (0)
+
+
+class CLCDConnection
+{
+public:
+    CLCDConnection(void);
+    virtual ~CLCDConnection(void);
+
+    //This will attempt to open the library
+    //Call this function before Connect()
+    virtual BOOL Initialize(lgLcdConnectContext & ConnectContext,
+                            lgLcdSoftbuttonsChangedContext* pSoftButtonChangedContext = NULL);
+    virtual BOOL Initialize(lgLcdConnectContextEx & ConnectContext,
+                            lgLcdSoftbuttonsChangedContext* pSoftButtonChangedContext = NULL);
+
+    //This will close your library
+    virtual void Shutdown(void);
+    
+    //Checks if there is a valid connection
+    virtual BOOL IsConnected(void);
+    virtual int  GetConnectionId(void);
+
+    // Call this function every game frame
+    virtual void Update(void);
+
+    // While suspended, Update() keeps the connection and the buttons
+    // going, but neither updates nor draws the pages
+    void SuspendDrawing(BOOL bSuspend);
+
+    // Add your controls to the appropriate display
+    CLCDOutput *ColorOutput(void);
+    CLCDOutput *MonoOutput(void);
+
+    BOOL HasColorDevice() { return m_AppletState.Color.pOutput && m_AppletState.Color.pOutput->IsOpened(); }
+    BOOL HasMonochromeDevice() { return m_AppletState.Mono.pOutput && m_AppletState.Mono.pOutput->IsOpened(); }
+
+    // Submit frames from a worker thread per output, so that Update()
+    // does not wait for the LCD manager. Off by default.
+    HRESULT EnablePipelinedUpdate(BOOL bEnable);
+
+    // Redraw only the parts of the pages that changed since the last
+    // frame, see CLCDOutput::EnablePartialRedraw(). Off by default.
+    void EnablePartialRedraw(BOOL bEnable);
+
+    // Draw the color pages in tiles on worker threads. The monochrome
+    // screen is too small to gain from it. Off by default.
+    HRESULT EnableTileRendering(BOOL bEnable, int nThreads = 0);
+
+    // Derive the monochrome frame from the color pages, so that only one
+    // page tree has to be built and updated. prcSource selects the part
+    // of the color screen to show, NULL shows all of it.
+    HRESULT EnableMonoMirror(BOOL bEnable, CLCDDither::eDITHER_MODE eMode = CLCDDither::DITHER_ORDERED,
+                             const RECT *prcSource = NULL);
+    BOOL IsMonoMirrorEnabled(void);
+
+protected:
+    // dwDisplayType = LGLCD_DEVICE_BW or LGLCD_DEVICE_QVGA
+    virtual void OnDeviceArrival(DWORD dwDisplayType);
+    virtual void OnDeviceRemoval(DWORD dwDisplayType);
+    virtual void OnAppletEnabled(void);
+    virtual void OnAppletDisabled(void);
+    virtual void OnNotification(DWORD dwNotification, DWORD dwParam1 = 0);
+    virtual void OnConfigure(void);
+    virtual void OnSoftButtonEvent(int nDeviceId, DWORD dwButtonState);
+    virtual void OnCallbackEvent(void) { }
+
+protected:
+    virtual void Connect(void);
+    virtual void Disconnect(void);
+
+protected:
+    // Override only if you need to create custom output classes
+    virtual CLCDOutput* AllocMonoOutput(void);
+    virtual CLCDOutput* AllocColorOutput(void);
+    virtual void FreeMonoOutput(void);
+    virtual void FreeColorOutput(void);
+
+private:
+    lgLcdConnectContextEx m_lcdConnectCtxEx;
+    int m_hConnection;
+
+    APPLET_STATE m_AppletState;
+
+    lgLcdSoftbuttonsChangedContext* m_plcdSoftButtonsChangedCtx;
+
+    BOOL m_bPipelinedUpdate;
+    BOOL m_bPartialRedraw;
+    BOOL m_bDrawingSuspended;
+
+    BOOL m_bTileRendering;
+    int m_nTileThreads;
+
+    BOOL m_bMonoMirror;
+    CLCDDither::eDITHER_MODE m_eMirrorDither;
+    RECT m_rcMirrorSource;
+
+private:
+    // Internal threaded event handling
+    enum CB_TYPE { CBT_BUTTON, CBT_CONFIG, CBT_NOTIFICATION };
+    typedef struct CB_EVENT
+    {
+        CB_TYPE Type;
+        DWORD CallbackCode;
+        DWORD CallbackParam1;
+        DWORD CallbackParam2;
+        DWORD CallbackParam3;
+        DWORD CallbackParam;
+
+    } CB_EVENT;
+
+    typedef std::queue<CB_EVENT> LCD_CB_EVENT_QUEUE;
+
+    CRITICAL_SECTION m_csCallback;
+    LCD_CB_EVENT_QUEUE m_CallbackEventQueue;
+    
+    BOOL GetNextCallbackEvent(CB_EVENT& rEvent);
+
+private:
+    static LONG g_lInitCount;
+
+    static DWORD CALLBACK _OnNotificationCallback(
+        IN int connection,
+        IN const PVOID pContext,
+        IN DWORD notificationCode,
+        IN DWORD notifyParm1,
+        IN DWORD notifyParm2,
+        IN DWORD notifyParm3,
+        IN DWORD notifyParm4);
+
+    static DWORD CALLBACK _OnSoftButtonsCallback(
+        IN int device,
+        IN DWORD dwButtons,
+        IN const PVOID pContext);
+
+    static DWORD CALLBACK _OnConfigureCallback(
+        IN int connection,
+        IN const PVOID pContext);
+};
+
+#endif
+
+//** end of LCDConnection.h **********************************************
@@ -0,0 +1,362 @@
+//************************************************************************
+//
+// LCDDither.cpp
+//
+// The CLCDDither class converts 32bpp images into packed 1bpp images for
+// the monochrome display, using a threshold, an ordered (Bayer) pattern
+// or error diffusion.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define LCDUI_SSE2
+#endif
+
+// 8x8 Bayer matrix, levels 0 to 63
+static const BYTE s_BayerMatrix[8][8] =
+{
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 }
+};
+
+
+//************************************************************************
+//
+// CLCDDither::GetPackedPitch
+//
+//************************************************************************
+
+int CLCDDither::GetPackedPitch(int nWidth)
+{
+    return ((nWidth + 31) / 32) * 4;
+}
+
+
+//************************************************************************
+//
+// CLCDDither::LuminanceRow
+//
+// Rec. 601 weights in 8 bit fixed point: (29 B + 150 G + 77 R) / 256
+//************************************************************************
+
+void CLCDDither::LuminanceRow(const BYTE *pSrc, PBYTE pDst, int nWidth)
+{
+    int x = 0;
+
+#ifdef LCDUI_SSE2
+    // 16 pixels per step. pmaddwd sums B and G, and R and A, of each pixel;
+    // adding the upper half of every 64 bit lane completes the sum.
+    const __m128i xmmZero = _mm_setzero_si128();
+    const __m128i xmmWeights = _mm_setr_epi16(29, 150, 77, 0, 29, 150, 77, 0);
+    const __m128i xmmRound = _mm_set1_epi32(128);
+    for(; x + 16 <= nWidth; x += 16)
+    {
+        __m128i axmmLuma[4];
+        for(int i = 0; i < 4; ++i)
+        {
+            __m128i xmmPixels = _mm_loadu_si128((const __m128i *)(pSrc + (x + i * 4) * 4));
+            __m128i xmmLo = _mm_madd_epi16(_mm_unpacklo_epi8(xmmPixels, xmmZero), xmmWeights);
+            __m128i xmmHi = _mm_madd_epi16(_mm_unpackhi_epi8(xmmPixels, xmmZero), xmmWeights);
+            xmmLo = _mm_add_epi32(xmmLo, _mm_srli_epi64(xmmLo, 32));
+            xmmHi = _mm_add_epi32(xmmHi, _mm_srli_epi64(xmmHi, 32));
+            xmmLo = _mm_shuffle_epi32(xmmLo, _MM_SHUFFLE(3, 1, 2, 0));
+            xmmHi = _mm_shuffle_epi32(xmmHi, _MM_SHUFFLE(3, 1, 2, 0));
+            __m128i xmmSum = _mm_unpacklo_epi64(xmmLo, xmmHi);
+            axmmLuma[i] = _mm_srli_epi32(_mm_add_epi32(xmmSum, xmmRound), 8);
+        }
+        __m128i xmmLuma = _mm_packus_epi16(_mm_packs_epi32(axmmLuma[0], axmmLuma[1]),
+                                           _mm_packs_epi32(axmmLuma[2], axmmLuma[3]));
+        _mm_storeu_si128((__m128i *)(pDst + x), xmmLuma);
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        const BYTE *pPixel = pSrc + x * 4;
+        pDst[x] = (BYTE)((29 * pPixel[0] + 150 * pPixel[1] + 77 * pPixel[2] + 128) >> 8);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDDither::Dither
+//
+//************************************************************************
+
+void CLCDDither::Dither(const BYTE *pSrcBits, int nSrcPitch, int nWidth, int nHeight,
+                        PBYTE pDstBits, int nDstPitch, eDITHER_MODE eMode)
+{
+    LCDUIASSERT(NULL != pSrcBits);
+    LCDUIASSERT(NULL != pDstBits);
+    if((NULL == pSrcBits) || (NULL == pDstBits) || (0 >= nWidth) || (0 >= nHeight))
+    {
+        return;
+    }
+
+    std::vector<BYTE> Luma((size_t)nWidth * nHeight);
+    for(int y = 0; y < nHeight; ++y)
+    {
+        LuminanceRow(pSrcBits + y * nSrcPitch, &Luma[(size_t)y * nWidth], nWidth);
+    }
+
+    DitherLuminance(&Luma[0], nWidth, nWidth, nHeight, pDstBits, nDstPitch, eMode);
+}
+
+
+//************************************************************************
+//
+// CLCDDither::DitherLuminance
+//
+//************************************************************************
+
+void CLCDDither::DitherLuminance(const BYTE *pLuma, int nLumaPitch, int nWidth, int nHeight,
+                                 PBYTE pDstBits, int nDstPitch, eDITHER_MODE eMode)
+{
+    LCDUIASSERT(NULL != pLuma);
+    LCDUIASSERT(NULL != pDstBits);
+    if((NULL == pLuma) || (NULL == pDstBits) || (0 >= nWidth) || (0 >= nHeight))
+    {
+        return;
+    }
+
+    if(DITHER_DIFFUSION == eMode)
+    {
+        // errors of the current and the next row, one guard entry per side
+        std::vector<int> Errors(2 * (nWidth + 2), 0);
+        int *pErrThis = &Errors[0];
+        int *pErrNext = &Errors[nWidth + 2];
+
+        for(int y = 0; y < nHeight; ++y)
+        {
+            DiffuseRow(pLuma + y * nLumaPitch, pDstBits + y * nDstPitch, nWidth,
+                       pErrThis, pErrNext, (y & 1) ? TRUE : FALSE);
+
+            int *pSwap = pErrThis;
+            pErrThis = pErrNext;
+            pErrNext = pSwap;
+            memset(pErrNext, 0, (nWidth + 2) * sizeof(int));
+        }
+        return;
+    }
+
+    BYTE Pattern[8];
+    for(int y = 0; y < nHeight; ++y)
+    {
+        for(int i = 0; i < 8; ++i)
+        {
+            // a pixel is set when its luminance is above the pattern value
+            Pattern[i] = (BYTE)((DITHER_ORDERED == eMode) ?
+                (s_BayerMatrix[y & 7][i] * 4 + 2) : (THRESHOLD - 1));
+        }
+        ThresholdRow(pLuma + y * nLumaPitch, pDstBits + y * nDstPitch, nWidth, Pattern);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDDither::DownscaleLuminance
+//
+// Every destination pixel is the average of the source pixels it covers.
+// Rows are summed per column first, then the columns of each pixel.
+//************************************************************************
+
+void CLCDDither::DownscaleLuminance(const BYTE *pSrcBits, int nSrcPitch, int nSrcWidth, int nSrcHeight,
+                                    PBYTE pDst, int nDstPitch, int nDstWidth, int nDstHeight)
+{
+    LCDUIASSERT(NULL != pSrcBits);
+    LCDUIASSERT(NULL != pDst);
+    if((NULL == pSrcBits) || (NULL == pDst) || (0 >= nSrcWidth) || (0 >= nSrcHeight) ||
+       (0 >= nDstWidth) || (0 >= nDstHeight))
+    {
+        return;
+    }
+
+    std::vector<BYTE> Luma(nSrcWidth);
+    std::vector<DWORD> Sums(nSrcWidth);
+
+    for(int y = 0; y < nDstHeight; ++y)
+    {
+        int nTop = y * nSrcHeight / nDstHeight;
+        int nBottom = max(nTop + 1, (y + 1) * nSrcHeight / nDstHeight);
+
+        memset(&Sums[0], 0, nSrcWidth * sizeof(DWORD));
+        for(int nRow = nTop; nRow < nBottom; ++nRow)
+        {
+            LuminanceRow(pSrcBits + nRow * nSrcPitch, &Luma[0], nSrcWidth);
+            AccumulateRow(&Luma[0], &Sums[0], nSrcWidth);
+        }
+
+        PBYTE pDstRow = pDst + y * nDstPitch;
+        for(int x = 0; x < nDstWidth; ++x)
+        {
+            int nLeft = x * nSrcWidth / nDstWidth;
+            int nRight = max(nLeft + 1, (x + 1) * nSrcWidth / nDstWidth);
+
+            DWORD dwSum = 0;
+            for(int nCol = nLeft; nCol < nRight; ++nCol)
+            {
+                dwSum += Sums[nCol];
+            }
+            DWORD dwCount = (DWORD)(nRight - nLeft) * (nBottom - nTop);
+            pDstRow[x] = (BYTE)((dwSum + dwCount / 2) / dwCount);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDDither::AlphaMask
+//
+//************************************************************************
+
+void CLCDDither::AlphaMask(const BYTE *pSrcBits, int nSrcPitch, int nWidth, int nHeight,
+                           PBYTE pDstBits, int nDstPitch)
+{
+    LCDUIASSERT(NULL != pSrcBits);
+    LCDUIASSERT(NULL != pDstBits);
+    if((NULL == pSrcBits) || (NULL == pDstBits))
+    {
+        return;
+    }
+
+    for(int y = 0; y < nHeight; ++y)
+    {
+        const BYTE *pSrc = pSrcBits + y * nSrcPitch;
+        PBYTE pDst = pDstBits + y * nDstPitch;
+        memset(pDst, 0, GetPackedPitch(nWidth));
+        for(int x = 0; x < nWidth; ++x)
+        {
+            if(THRESHOLD <= pSrc[x * 4 + 3])
+            {
+                pDst[x >> 3] |= (BYTE)(1 << (x & 7));
+            }
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDDither::ThresholdRow
+//
+// pPattern holds 8 thresholds that repeat along the row.
+//************************************************************************
+
+void CLCDDither::ThresholdRow(const BYTE *pLuma, PBYTE pDst, int nWidth, const BYTE *pPattern)
+{
+    memset(pDst, 0, GetPackedPitch(nWidth));
+
+    int x = 0;
+
+#ifdef LCDUI_SSE2
+    // the sign flip turns the signed byte compare into an unsigned one, and
+    // the byte mask is already in the packed bit order
+    const __m128i xmmSign = _mm_set1_epi8((char)0x80);
+    __m128i xmmPattern = _mm_loadl_epi64((const __m128i *)pPattern);
+    xmmPattern = _mm_xor_si128(_mm_unpacklo_epi64(xmmPattern, xmmPattern), xmmSign);
+    for(; x + 16 <= nWidth; x += 16)
+    {
+        __m128i xmmLuma = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(pLuma + x)), xmmSign);
+        int nBits = _mm_movemask_epi8(_mm_cmpgt_epi8(xmmLuma, xmmPattern));
+        pDst[x >> 3] = (BYTE)nBits;
+        pDst[(x >> 3) + 1] = (BYTE)(nBits >> 8);
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        if(pLuma[x] > pPattern[x & 7])
+        {
+            pDst[x >> 3] |= (BYTE)(1 << (x & 7));
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDDither::AccumulateRow
+//
+//************************************************************************
+
+void CLCDDither::AccumulateRow(const BYTE *pLuma, DWORD *pSums, int nWidth)
+{
+    int x = 0;
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmZero = _mm_setzero_si128();
+    for(; x + 16 <= nWidth; x += 16)
+    {
+        __m128i xmmLuma = _mm_loadu_si128((const __m128i *)(pLuma + x));
+        __m128i xmmLo = _mm_unpacklo_epi8(xmmLuma, xmmZero);
+        __m128i xmmHi = _mm_unpackhi_epi8(xmmLuma, xmmZero);
+        __m128i axmmWide[4] =
+        {
+            _mm_unpacklo_epi16(xmmLo, xmmZero), _mm_unpackhi_epi16(xmmLo, xmmZero),
+            _mm_unpacklo_epi16(xmmHi, xmmZero), _mm_unpackhi_epi16(xmmHi, xmmZero)
+        };
+        for(int i = 0; i < 4; ++i)
+        {
+            __m128i *pSum = (__m128i *)(pSums + x + i * 4);
+            _mm_storeu_si128(pSum, _mm_add_epi32(_mm_loadu_si128(pSum), axmmWide[i]));
+        }
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        pSums[x] += pLuma[x];
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDDither::DiffuseRow
+//
+// Floyd-Steinberg, in 1/16 units. Errors are indexed from x + 1, so that
+// both neighbours of the edge pixels exist. Every other row is scanned
+// from the right to avoid directional artifacts.
+//************************************************************************
+
+void CLCDDither::DiffuseRow(const BYTE *pLuma, PBYTE pDst, int nWidth,
+                            int *pErrThis, int *pErrNext, BOOL bReverse)
+{
+    memset(pDst, 0, GetPackedPitch(nWidth));
+
+    int nStep = bReverse ? -1 : 1;
+    int x = bReverse ? nWidth - 1 : 0;
+    for(int i = 0; i < nWidth; ++i, x += nStep)
+    {
+        int nValue = pLuma[x] + pErrThis[x + 1] / 16;
+        int nError = nValue;
+        if(THRESHOLD <= nValue)
+        {
+            pDst[x >> 3] |= (BYTE)(1 << (x & 7));
+            nError -= 255;
+        }
+
+        pErrThis[x + 1 + nStep] += nError * 7;
+        pErrNext[x + 1 - nStep] += nError * 3;
+        pErrNext[x + 1] += nError * 5;
+        pErrNext[x + 1 + nStep] += nError;
+    }
+}
+
+
+//** end of LCDDither.cpp ************************************************
@@ -0,0 +1,55 @@
+//************************************************************************
+//
+// LCDDither.h
+//
+// The CLCDDither class converts 32bpp images into packed 1bpp images for
+// the monochrome display, using a threshold, an ordered (Bayer) pattern
+// or error diffusion.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDDITHER_H_INCLUDED_
+#define _LCDDITHER_H_INCLUDED_
+
+class CLCDDither
+{
+public:
+    enum eDITHER_MODE { DITHER_NONE, DITHER_THRESHOLD, DITHER_ORDERED, DITHER_DIFFUSION };
+
+    // Packed images use the layout of the 1bpp CLCDGfxSoft surface: the
+    // first pixel of a row is the lowest bit, rows are whole DWORDs.
+    static int GetPackedPitch(int nWidth);
+
+    // 32bpp BGRA rows to 8 bit luminance. Premultiplied alpha reads as
+    // drawn over black.
+    static void LuminanceRow(const BYTE *pSrc, PBYTE pDst, int nWidth);
+
+    // Converts a whole image. DITHER_NONE is handled as DITHER_THRESHOLD.
+    static void Dither(const BYTE *pSrcBits, int nSrcPitch, int nWidth, int nHeight,
+                       PBYTE pDstBits, int nDstPitch, eDITHER_MODE eMode);
+    static void DitherLuminance(const BYTE *pLuma, int nLumaPitch, int nWidth, int nHeight,
+                                PBYTE pDstBits, int nDstPitch, eDITHER_MODE eMode);
+
+    // Box filters a 32bpp image down to an 8 bit luminance image
+    static void DownscaleLuminance(const BYTE *pSrcBits, int nSrcPitch, int nSrcWidth, int nSrcHeight,
+                                   PBYTE pDst, int nDstPitch, int nDstWidth, int nDstHeight);
+
+    // Sets the bits of pixels that are at least half opaque
+    static void AlphaMask(const BYTE *pSrcBits, int nSrcPitch, int nWidth, int nHeight,
+                          PBYTE pDstBits, int nDstPitch);
+
+    enum { THRESHOLD = 128 };
+
+protected:
+    static void ThresholdRow(const BYTE *pLuma, PBYTE pDst, int nWidth, const BYTE *pPattern);
+    static void AccumulateRow(const BYTE *pLuma, DWORD *pSums, int nWidth);
+    static void DiffuseRow(const BYTE *pLuma, PBYTE pDst, int nWidth,
+                           int *pErrThis, int *pErrNext, BOOL bReverse);
+};
+
+#endif // !_LCDDITHER_H_INCLUDED_
+
+//** end of LCDDither.h **************************************************
@@ -0,0 +1,282 @@
+//************************************************************************
+//
+// LCDFontRegistry.cpp
+//
+// The CLCDFontRegistry class hands out fonts shared by all the objects
+// that ask for the same LOGFONT.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+static CLCDFontRegistry s_FontRegistry;
+
+// text objects with static storage may outlive the registry
+static BOOL s_bRegistryDestroyed = FALSE;
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::CLCDFontRegistry
+//
+//************************************************************************
+
+CLCDFontRegistry::CLCDFontRegistry(void)
+:   m_dwCreated(0)
+{
+    InitializeCriticalSection(&m_csRegistry);
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::~CLCDFontRegistry
+//
+//************************************************************************
+
+CLCDFontRegistry::~CLCDFontRegistry(void)
+{
+    // objects still holding fonts are going away with the process
+    std::map<FONTKEY, FONT *>::iterator it = m_Fonts.begin();
+    while(it != m_Fonts.end())
+    {
+        DeleteObject(it->second->hFont);
+        delete it->second;
+        ++it;
+    }
+    m_Fonts.clear();
+    m_Handles.clear();
+    m_Unused.clear();
+
+    DeleteCriticalSection(&m_csRegistry);
+    s_bRegistryDestroyed = TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::GetInstance
+//
+//************************************************************************
+
+CLCDFontRegistry &CLCDFontRegistry::GetInstance(void)
+{
+    return s_FontRegistry;
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::MakeKey
+//
+// The face name is compared as a whole, so whatever follows its end
+// is cleared.
+//
+//************************************************************************
+
+void CLCDFontRegistry::MakeKey(const LOGFONT &lf, FONTKEY &rKey)
+{
+    rKey.lf = lf;
+    size_t nLength = 0;
+    while((nLength < LF_FACESIZE) && (0 != lf.lfFaceName[nLength]))
+    {
+        nLength++;
+    }
+    if(nLength == LF_FACESIZE)
+    {
+        nLength = LF_FACESIZE - 1;
+    }
+    ZeroMemory(rKey.lf.lfFaceName + nLength, (LF_FACESIZE - nLength) * sizeof(TCHAR));
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::Acquire
+//
+//************************************************************************
+
+HFONT CLCDFontRegistry::Acquire(const LOGFONT &lf)
+{
+    if(s_bRegistryDestroyed)
+    {
+        return CreateFontIndirect(&lf);
+    }
+
+    FONTKEY Key;
+    MakeKey(lf, Key);
+
+    EnterCriticalSection(&m_csRegistry);
+
+    HFONT hFont = NULL;
+    std::map<FONTKEY, FONT *>::iterator it = m_Fonts.find(Key);
+    if(it != m_Fonts.end())
+    {
+        FONT *pFont = it->second;
+        if(0 == pFont->nRefs++)
+        {
+            for(size_t i = 0; i < m_Unused.size(); i++)
+            {
+                if(m_Unused[i] == pFont)
+                {
+                    m_Unused.erase(m_Unused.begin() + i);
+                    break;
+                }
+            }
+        }
+        hFont = pFont->hFont;
+    }
+    else
+    {
+        hFont = CreateFontIndirect(&Key.lf);
+        if(NULL != hFont)
+        {
+            m_dwCreated++;
+
+            FONT *pFont = new FONT;
+            pFont->Key = Key;
+            pFont->hFont = hFont;
+            pFont->nRefs = 1;
+            m_Fonts[Key] = pFont;
+            m_Handles[hFont] = pFont;
+        }
+        else
+        {
+            LCDUITRACE(_T("CLCDFontRegistry::Acquire(): failed to create the font.\n"));
+        }
+    }
+
+    LeaveCriticalSection(&m_csRegistry);
+    return hFont;
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::Release
+//
+//************************************************************************
+
+void CLCDFontRegistry::Release(HFONT hFont)
+{
+    if((NULL == hFont) || s_bRegistryDestroyed)
+    {
+        return;
+    }
+
+    EnterCriticalSection(&m_csRegistry);
+
+    std::map<HFONT, FONT *>::iterator it = m_Handles.find(hFont);
+    if(it != m_Handles.end())
+    {
+        FONT *pFont = it->second;
+        LCDUIASSERT(0 < pFont->nRefs);
+        if(0 == --pFont->nRefs)
+        {
+            m_Unused.push_back(pFont);
+            if(MAX_UNUSED < (int)m_Unused.size())
+            {
+                DeleteFont(m_Unused.front());
+                m_Unused.erase(m_Unused.begin());
+            }
+        }
+    }
+
+    LeaveCriticalSection(&m_csRegistry);
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::GetLogFont
+//
+//************************************************************************
+
+BOOL CLCDFontRegistry::GetLogFont(HFONT hFont, LOGFONT &lf)
+{
+    BOOL bFound = FALSE;
+    if(!s_bRegistryDestroyed)
+    {
+        EnterCriticalSection(&m_csRegistry);
+        std::map<HFONT, FONT *>::iterator it = m_Handles.find(hFont);
+        if(it != m_Handles.end())
+        {
+            lf = it->second->Key.lf;
+            bFound = TRUE;
+        }
+        LeaveCriticalSection(&m_csRegistry);
+    }
+
+    if(!bFound)
+    {
+        ZeroMemory(&lf, sizeof(lf));
+        bFound = (0 != GetObject(hFont, sizeof(LOGFONT), &lf));
+    }
+    return bFound;
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::GetFontCount
+//
+//************************************************************************
+
+int CLCDFontRegistry::GetFontCount(void)
+{
+    EnterCriticalSection(&m_csRegistry);
+    int nCount = (int)(m_Fonts.size() - m_Unused.size());
+    LeaveCriticalSection(&m_csRegistry);
+    return nCount;
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::GetUnusedFontCount
+//
+//************************************************************************
+
+int CLCDFontRegistry::GetUnusedFontCount(void)
+{
+    EnterCriticalSection(&m_csRegistry);
+    int nCount = (int)m_Unused.size();
+    LeaveCriticalSection(&m_csRegistry);
+    return nCount;
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::GetCreatedFontCount
+//
+//************************************************************************
+
+DWORD CLCDFontRegistry::GetCreatedFontCount(void)
+{
+    EnterCriticalSection(&m_csRegistry);
+    DWORD dwCreated = m_dwCreated;
+    LeaveCriticalSection(&m_csRegistry);
+    return dwCreated;
+}
+
+
+//************************************************************************
+//
+// CLCDFontRegistry::DeleteFont
+//
+//************************************************************************
+
+void CLCDFontRegistry::DeleteFont(FONT *pFont)
+{
+    m_Handles.erase(pFont->hFont);
+    m_Fonts.erase(pFont->Key);
+    DeleteObject(pFont->hFont);
+    delete pFont;
+}
+
+
+//** end of LCDFontRegistry.cpp ******************************************
@@ -0,0 +1,81 @@
+//************************************************************************
+//
+// LCDFontRegistry.h
+//
+// The CLCDFontRegistry class hands out fonts shared by all the objects
+// that ask for the same LOGFONT, so that identical text objects do not
+// each create their own.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDFONTREGISTRY_H_INCLUDED_
+#define _LCDFONTREGISTRY_H_INCLUDED_
+
+#include <map>
+
+class CLCDFontRegistry
+{
+public:
+    CLCDFontRegistry(void);
+    virtual ~CLCDFontRegistry(void);
+
+    // the registry shared by all text objects
+    static CLCDFontRegistry &GetInstance(void);
+
+    // Returns the font for lf, NULL if it cannot be created. Every font
+    // acquired must be released, and not be deleted with DeleteObject().
+    HFONT Acquire(const LOGFONT &lf);
+    // Fonts that did not come from Acquire(), such as stock fonts, are
+    // ignored
+    void Release(HFONT hFont);
+
+    // Like GetObject(), without asking GDI for fonts of the registry
+    BOOL GetLogFont(HFONT hFont, LOGFONT &lf);
+
+    // fonts in use, and unused fonts kept for reuse
+    int GetFontCount(void);
+    int GetUnusedFontCount(void);
+    // calls to CreateFontIndirect()
+    DWORD GetCreatedFontCount(void);
+
+    // unused fonts kept around, as setting up a text object goes through
+    // a few fonts that the next object asks for again
+    enum { MAX_UNUSED = 16 };
+
+protected:
+    struct FONTKEY
+    {
+        LOGFONT lf;
+
+        bool operator<(const FONTKEY &rOther) const
+        {
+            return memcmp(&lf, &rOther.lf, sizeof(LOGFONT)) < 0;
+        }
+    };
+
+    struct FONT
+    {
+        FONTKEY Key;
+        HFONT hFont;
+        LONG nRefs;
+    };
+
+    static void MakeKey(const LOGFONT &lf, FONTKEY &rKey);
+    void DeleteFont(FONT *pFont);
+
+protected:
+    std::map<FONTKEY, FONT *> m_Fonts;
+    std::map<HFONT, FONT *> m_Handles;
+    // oldest first
+    std::vector<FONT *> m_Unused;
+    DWORD m_dwCreated;
+
+    CRITICAL_SECTION m_csRegistry;
+};
+
+#endif // !_LCDFONTREGISTRY_H_INCLUDED_
+
+//** end of LCDFontRegistry.h ********************************************
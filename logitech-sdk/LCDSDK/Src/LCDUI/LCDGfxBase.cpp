@@ -1,292 +1,839 @@
-//************************************************************************
-//
-// NOTE: This version of ColorLCDUI is pre-release and is subject to 
-// change.
-//
-// LCDGfxBase.cpp
-//
-//
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDGfxBase::CLCDGfxBase
-//
-//************************************************************************
-
-CLCDGfxBase::CLCDGfxBase(void)
-:   m_pLCDScreen(NULL),
-    m_nWidth(0),
-    m_nHeight(0),
-    m_pBitmapInfo(NULL),
-    m_hDC(NULL),
-    m_hBitmap(NULL),
-    m_hPrevBitmap(NULL),
-    m_pBitmapBits(NULL)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::~CLCDGfxBase
-//
-//************************************************************************
-
-CLCDGfxBase::~CLCDGfxBase(void)
-{
-    Shutdown();
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::Initialize
-//
-//************************************************************************
-
-HRESULT CLCDGfxBase::Initialize(void)
-{
-    m_hDC = CreateCompatibleDC(NULL);
-    if(NULL == m_hDC)
-    {
-        LCDUITRACE(_T("CLCDGfxBase::Initialize(): failed to create compatible DC.\n"));
-        Shutdown();
-        return E_FAIL;
-    }
-
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::Shutdown
-//
-//************************************************************************
-
-void CLCDGfxBase::Shutdown(void)
-{
-    if(NULL != m_hBitmap)
-    {
-        DeleteObject(m_hBitmap);
-        m_hBitmap = NULL;
-        m_pBitmapBits = NULL;
-    }
-
-    LCDUIASSERT(NULL == m_hPrevBitmap);
-    m_hPrevBitmap = NULL;
-
-    if(NULL != m_pBitmapInfo)
-    {
-        delete [] m_pBitmapInfo;
-        m_pBitmapInfo = NULL;
-    }
-
-    if(NULL != m_hDC)
-    {
-        DeleteDC(m_hDC);
-        m_hDC = NULL;
-    }
-
-    m_nWidth = 0;
-    m_nHeight = 0;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::ClearScreen
-//
-//************************************************************************
-
-void CLCDGfxBase::ClearScreen(void)
-{
-    // this means, we're inside BeginDraw()/EndDraw()
-    LCDUIASSERT(NULL != m_hPrevBitmap);
-    RECT rc = { 0, 0, m_nWidth, m_nHeight };
-    FillRect(m_hDC, &rc, (HBRUSH) GetStockObject(BLACK_BRUSH));
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::BeginDraw
-//
-//************************************************************************
-
-void CLCDGfxBase::BeginDraw(void)
-{
-    LCDUIASSERT(NULL != m_hBitmap);
-    LCDUIASSERT(NULL == m_hPrevBitmap);
-    if(NULL == m_hPrevBitmap)
-    {
-        m_hPrevBitmap = (HBITMAP) SelectObject(m_hDC, m_hBitmap);
-        SetTextColor(m_hDC, RGB(255, 255, 255));
-        SetBkColor(m_hDC, RGB(0, 0, 0));
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::EndDraw
-//
-//************************************************************************
-
-void CLCDGfxBase::EndDraw(void)
-{
-    LCDUIASSERT(NULL != m_hPrevBitmap);
-    if(NULL != m_hPrevBitmap)
-    {
-        GdiFlush();
-        m_hPrevBitmap = (HBITMAP) SelectObject(m_hDC, m_hPrevBitmap);
-        LCDUIASSERT(m_hPrevBitmap == m_hBitmap);
-        m_hPrevBitmap = NULL;
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::GetHDC
-//
-//************************************************************************
-
-HDC CLCDGfxBase::GetHDC(void)
-{
-    LCDUIASSERT(NULL != m_hDC);
-    return m_hDC;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::GetLCDScreen
-//
-//************************************************************************
-
-lgLcdBitmap* CLCDGfxBase::GetLCDScreen(void)
-{
-    LCDUIASSERT(NULL != m_pLCDScreen);
-    if(NULL != m_pLCDScreen)
-    {
-        // monochrome, as well as color pixels start at the same offset...
-        memcpy(m_pLCDScreen->bmp_mono.pixels, m_pBitmapBits, m_nWidth * m_nHeight * 4);
-    }
-
-    return m_pLCDScreen;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::GetBitmapInfo
-//
-//************************************************************************
-
-BITMAPINFO* CLCDGfxBase::GetBitmapInfo(void)
-{
-    LCDUIASSERT(NULL != m_pBitmapInfo);
-    return m_pBitmapInfo;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::GetHBITMAP
-//
-//************************************************************************
-
-HBITMAP CLCDGfxBase::GetHBITMAP(void)
-{
-    LCDUIASSERT(NULL != m_hBitmap);
-    return m_hBitmap;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::GetWidth
-//
-//************************************************************************
-
-int CLCDGfxBase::GetWidth(void)
-{
-    return m_nWidth;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::GetHeight
-//
-//************************************************************************
-
-int CLCDGfxBase::GetHeight(void)
-{
-    return m_nHeight;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxBase::CreateBitmap
-//
-//************************************************************************
-
-HRESULT CLCDGfxBase::CreateBitmap(WORD wBitCount)
-{
-    int nBMISize = sizeof(BITMAPINFO) + 256 * sizeof(RGBQUAD);
-    m_pBitmapInfo = (BITMAPINFO *) new BYTE [nBMISize];
-    if(NULL == m_pBitmapInfo)
-    {
-        LCDUITRACE(_T("CLCDGfxBase::CreateBitmap(): failed to allocate bitmap info.\n"));
-        Shutdown();
-        return E_OUTOFMEMORY;
-    }
-
-    ZeroMemory(m_pBitmapInfo, nBMISize);
-    m_pBitmapInfo->bmiHeader.biSize = sizeof(m_pBitmapInfo->bmiHeader);
-    m_pBitmapInfo->bmiHeader.biWidth = m_nWidth;
-    m_pBitmapInfo->bmiHeader.biHeight = -m_nHeight;
-    m_pBitmapInfo->bmiHeader.biPlanes = 1;
-    m_pBitmapInfo->bmiHeader.biBitCount = wBitCount;
-    m_pBitmapInfo->bmiHeader.biCompression = BI_RGB;
-    m_pBitmapInfo->bmiHeader.biSizeImage = 
-        (m_nWidth * 
-        m_nHeight * 
-        m_pBitmapInfo->bmiHeader.biBitCount) / 8;
-    m_pBitmapInfo->bmiHeader.biXPelsPerMeter = 3200;
-    m_pBitmapInfo->bmiHeader.biYPelsPerMeter = 3200;
-    m_pBitmapInfo->bmiHeader.biClrUsed = 256;
-    m_pBitmapInfo->bmiHeader.biClrImportant = 256;
-
-    for(int nColor = 0; nColor < 256; ++nColor)
-    {
-        m_pBitmapInfo->bmiColors[nColor].rgbRed = (BYTE)((nColor > 128) ? 255 : 0);
-        m_pBitmapInfo->bmiColors[nColor].rgbGreen = (BYTE)((nColor > 128) ? 255 : 0);
-        m_pBitmapInfo->bmiColors[nColor].rgbBlue = (BYTE)((nColor > 128) ? 255 : 0);
-        m_pBitmapInfo->bmiColors[nColor].rgbReserved = 0;
-    }
-
-    m_hBitmap = CreateDIBSection(m_hDC, m_pBitmapInfo, DIB_RGB_COLORS,
-        (PVOID *) &m_pBitmapBits, NULL, 0);
-    if(NULL == m_hBitmap)
-    {
-        LCDUITRACE(_T("CLCDGfxBase::CreateBitmap(): failed to create bitmap.\n"));
-        Shutdown();
-        return E_FAIL;
-    }
-
-    return S_OK;
-}
-
-
-//** end of LCDGfxBase.cpp ***********************************************
+//************************************************************************
+//
+// NOTE: This version of ColorLCDUI is pre-release and is subject to 
+// change.
+//
+// LCDGfxBase.cpp
+//
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDGfxBase::CLCDGfxBase
+//
+//************************************************************************
+
+CLCDGfxBase::CLCDGfxBase(void)
+:   m_hScreenMapping(NULL),
+    m_pLCDScreen(NULL),
+    m_nWidth(0),
+    m_nHeight(0),
+    m_pBitmapInfo(NULL),
+    m_hDC(NULL),
+    m_hBitmap(NULL),
+    m_hPrevBitmap(NULL),
+    m_pBitmapBits(NULL),
+    m_bPartialDraw(FALSE),
+    m_bPrepared(FALSE),
+    m_nBuffer(0),
+    m_dwBufferSerial(1),
+    m_dwSharedSerial(0)
+{
+    SetRectEmpty(&m_rcDamage);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::~CLCDGfxBase
+//
+//************************************************************************
+
+CLCDGfxBase::~CLCDGfxBase(void)
+{
+    Shutdown();
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDGfxBase::Initialize(void)
+{
+    m_hDC = CreateCompatibleDC(NULL);
+    if(NULL == m_hDC)
+    {
+        LCDUITRACE(_T("CLCDGfxBase::Initialize(): failed to create compatible DC.\n"));
+        Shutdown();
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::Shutdown
+//
+//************************************************************************
+
+void CLCDGfxBase::Shutdown(void)
+{
+    LCDUIASSERT(NULL == m_hPrevBitmap);
+    m_hPrevBitmap = NULL;
+
+    FreeBuffers(0);
+
+    if(NULL != m_pBitmapInfo)
+    {
+        delete [] m_pBitmapInfo;
+        m_pBitmapInfo = NULL;
+    }
+
+    if(NULL != m_hDC)
+    {
+        DeleteDC(m_hDC);
+        m_hDC = NULL;
+    }
+
+    m_nWidth = 0;
+    m_nHeight = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::ClearScreen
+//
+//************************************************************************
+
+void CLCDGfxBase::ClearScreen(void)
+{
+    // this means, we're inside BeginDraw()/EndDraw()
+    LCDUIASSERT(NULL != m_hPrevBitmap);
+    RECT rc = { 0, 0, m_nWidth, m_nHeight };
+    FillRect(m_hDC, &rc, (HBRUSH) GetStockObject(BLACK_BRUSH));
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::ClearRect
+//
+//************************************************************************
+
+void CLCDGfxBase::ClearRect(const RECT &rc)
+{
+    // this means, we're inside BeginDraw()/EndDraw()
+    LCDUIASSERT(NULL != m_hPrevBitmap);
+    FillRect(m_hDC, &rc, (HBRUSH) GetStockObject(BLACK_BRUSH));
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::BeginDraw
+//
+//************************************************************************
+
+void CLCDGfxBase::BeginDraw(void)
+{
+    LCDUIASSERT(NULL != m_hBitmap);
+    LCDUIASSERT(NULL == m_hPrevBitmap);
+    if(NULL == m_hPrevBitmap)
+    {
+        m_hPrevBitmap = (HBITMAP) SelectObject(m_hDC, m_hBitmap);
+        SetTextColor(m_hDC, RGB(255, 255, 255));
+        SetBkColor(m_hDC, RGB(0, 0, 0));
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::EndDraw
+//
+//************************************************************************
+
+void CLCDGfxBase::EndDraw(void)
+{
+    LCDUIASSERT(NULL != m_hPrevBitmap);
+    if(NULL != m_hPrevBitmap)
+    {
+        GdiFlush();
+        m_hPrevBitmap = (HBITMAP) SelectObject(m_hDC, m_hPrevBitmap);
+        LCDUIASSERT(m_hPrevBitmap == m_hBitmap);
+        m_hPrevBitmap = NULL;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetHDC
+//
+//************************************************************************
+
+HDC CLCDGfxBase::GetHDC(void)
+{
+    LCDUIASSERT(NULL != m_hDC);
+    return m_hDC;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetLCDScreen
+//
+//************************************************************************
+
+lgLcdBitmap* CLCDGfxBase::GetLCDScreen(void)
+{
+    // the pixels were rendered in place, nothing to copy
+    LCDUIASSERT(NULL != m_pLCDScreen);
+    return m_pLCDScreen;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetBitmapInfo
+//
+//************************************************************************
+
+BITMAPINFO* CLCDGfxBase::GetBitmapInfo(void)
+{
+    LCDUIASSERT(NULL != m_pBitmapInfo);
+    return m_pBitmapInfo;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetHBITMAP
+//
+//************************************************************************
+
+HBITMAP CLCDGfxBase::GetHBITMAP(void)
+{
+    LCDUIASSERT(NULL != m_hBitmap);
+    return m_hBitmap;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetSoftSurface
+//
+//************************************************************************
+
+CLCDGfxSoft* CLCDGfxBase::GetSoftSurface(void)
+{
+    return NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetWidth
+//
+//************************************************************************
+
+int CLCDGfxBase::GetWidth(void)
+{
+    return m_nWidth;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetHeight
+//
+//************************************************************************
+
+int CLCDGfxBase::GetHeight(void)
+{
+    return m_nHeight;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::SetDamageRect
+//
+//************************************************************************
+
+void CLCDGfxBase::SetDamageRect(const RECT *prcDamage)
+{
+    m_bPartialDraw = (NULL != prcDamage);
+    if (m_bPartialDraw)
+    {
+        m_rcDamage = *prcDamage;
+    }
+    else
+    {
+        SetRectEmpty(&m_rcDamage);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetDamageRect
+//
+//************************************************************************
+
+BOOL CLCDGfxBase::GetDamageRect(RECT &rcDamage)
+{
+    rcDamage = m_rcDamage;
+    return m_bPartialDraw;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::ClipToDamage
+//
+// Restricts rc, in surface coordinates, to the area being redrawn.
+// Returns FALSE if nothing is left to draw.
+//
+//************************************************************************
+
+BOOL CLCDGfxBase::ClipToDamage(RECT &rc)
+{
+    if (m_bPartialDraw)
+    {
+        return IntersectRect(&rc, &rc, &m_rcDamage);
+    }
+    return !IsRectEmpty(&rc);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::SetPrepared
+//
+//************************************************************************
+
+void CLCDGfxBase::SetPrepared(BOOL bPrepared)
+{
+    m_bPrepared = bPrepared;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::IsPrepared
+//
+//************************************************************************
+
+BOOL CLCDGfxBase::IsPrepared(void)
+{
+    return m_bPrepared;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetDirectTarget
+//
+//************************************************************************
+
+BOOL CLCDGfxBase::GetDirectTarget(POINT &ptOffset, RECT &rcClip)
+{
+    LCDUIASSERT(NULL != m_hPrevBitmap);
+    if((NULL == m_hPrevBitmap) || (NULL == m_pBitmapBits) || (MM_TEXT != GetMapMode(m_hDC)))
+    {
+        return FALSE;
+    }
+
+    switch(GetClipBox(m_hDC, &rcClip))
+    {
+    case NULLREGION:
+        SetRectEmpty(&rcClip);
+        break;
+    case SIMPLEREGION:
+        break;
+    default:
+        return FALSE;
+    }
+
+    // logical to surface coordinates
+    POINT ptViewport, ptWindow;
+    GetViewportOrgEx(m_hDC, &ptViewport);
+    GetWindowOrgEx(m_hDC, &ptWindow);
+    ptOffset.x = ptViewport.x - ptWindow.x;
+    ptOffset.y = ptViewport.y - ptWindow.y;
+    OffsetRect(&rcClip, ptOffset.x, ptOffset.y);
+
+    // let GDI finish whatever it has queued for these pixels
+    GdiFlush();
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetBits
+//
+//************************************************************************
+
+PBYTE CLCDGfxBase::GetBits(void)
+{
+    return m_pBitmapBits;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetPitch
+//
+//************************************************************************
+
+int CLCDGfxBase::GetPitch(void)
+{
+    return m_nWidth * GetBitCount() / 8;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetBitCount
+//
+//************************************************************************
+
+int CLCDGfxBase::GetBitCount(void)
+{
+    return (NULL != m_pBitmapInfo) ? m_pBitmapInfo->bmiHeader.biBitCount : 0;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::DrawImage
+//
+// Writes straight into the DIB section, so this only handles 32bpp
+// surfaces with a plain rectangular clip and an unscaled mapping.
+//
+//************************************************************************
+
+BOOL CLCDGfxBase::DrawImage(const RECT &rcDst, const CLCDImage &rImage, const RECT *prcSrc,
+                            BYTE byAlpha, BOOL bPerPixelAlpha)
+{
+    POINT ptOffset;
+    RECT rcClip;
+    if((32 != GetBitCount()) || !GetDirectTarget(ptOffset, rcClip))
+    {
+        return FALSE;
+    }
+    if(IsRectEmpty(&rcClip))
+    {
+        return TRUE;
+    }
+
+    RECT rcSurface = rcDst;
+    OffsetRect(&rcSurface, ptOffset.x, ptOffset.y);
+    CLCDCompositor::Composite(m_pBitmapBits, GetPitch(), rcClip, rcSurface,
+        rImage, prcSrc, byAlpha, bPerPixelAlpha);
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::DrawPacked
+//
+// Expands the bits into the 8bpp DIB section of the monochrome surface,
+// whole bytes at a time when the image starts on a byte and has no mask.
+//
+//************************************************************************
+
+BOOL CLCDGfxBase::DrawPacked(int nX, int nY, int nWidth, int nHeight,
+                             const BYTE *pBits, int nPitch,
+                             const BYTE *pMaskBits, int nMaskPitch)
+{
+    LCDUIASSERT(NULL != pBits);
+    POINT ptOffset;
+    RECT rcClip;
+    if((NULL == pBits) || (8 != GetBitCount()) || !GetDirectTarget(ptOffset, rcClip))
+    {
+        return FALSE;
+    }
+
+    RECT rcDst = { nX, nY, nX + nWidth, nY + nHeight };
+    OffsetRect(&rcDst, ptOffset.x, ptOffset.y);
+    RECT rcSurface = { 0, 0, m_nWidth, m_nHeight };
+    RECT rc;
+    if(!IntersectRect(&rc, &rcDst, &rcClip) || !IntersectRect(&rc, &rc, &rcSurface))
+    {
+        return TRUE;
+    }
+
+    int nSrcX = rc.left - rcDst.left;
+    int nCount = rc.right - rc.left;
+    for(int y = rc.top; y < rc.bottom; ++y)
+    {
+        const BYTE *pRow = pBits + (y - rcDst.top) * nPitch;
+        PBYTE pDst = m_pBitmapBits + y * GetPitch() + rc.left;
+        if((NULL == pMaskBits) && (0 == (nSrcX & 7)))
+        {
+            CLCDGfxSoft::ExpandPackedRow(pRow + (nSrcX >> 3), pDst, nCount);
+            continue;
+        }
+
+        const BYTE *pMaskRow = (NULL != pMaskBits) ? pMaskBits + (y - rcDst.top) * nMaskPitch : NULL;
+        for(int x = 0; x < nCount; ++x)
+        {
+            int nBit = nSrcX + x;
+            if((NULL == pMaskRow) || (pMaskRow[nBit >> 3] & (1 << (nBit & 7))))
+            {
+                pDst[x] = (pRow[nBit >> 3] & (1 << (nBit & 7))) ? 0xFF : 0x00;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::CreateBitmap
+//
+//************************************************************************
+
+HRESULT CLCDGfxBase::CreateBitmap(WORD wBitCount)
+{
+    int nBMISize = sizeof(BITMAPINFO) + 256 * sizeof(RGBQUAD);
+    m_pBitmapInfo = (BITMAPINFO *) new BYTE [nBMISize];
+    if(NULL == m_pBitmapInfo)
+    {
+        LCDUITRACE(_T("CLCDGfxBase::CreateBitmap(): failed to allocate bitmap info.\n"));
+        Shutdown();
+        return E_OUTOFMEMORY;
+    }
+
+    ZeroMemory(m_pBitmapInfo, nBMISize);
+    m_pBitmapInfo->bmiHeader.biSize = sizeof(m_pBitmapInfo->bmiHeader);
+    m_pBitmapInfo->bmiHeader.biWidth = m_nWidth;
+    m_pBitmapInfo->bmiHeader.biHeight = -m_nHeight;
+    m_pBitmapInfo->bmiHeader.biPlanes = 1;
+    m_pBitmapInfo->bmiHeader.biBitCount = wBitCount;
+    m_pBitmapInfo->bmiHeader.biCompression = BI_RGB;
+    m_pBitmapInfo->bmiHeader.biSizeImage = 
+        (m_nWidth * 
+        m_nHeight * 
+        m_pBitmapInfo->bmiHeader.biBitCount) / 8;
+    m_pBitmapInfo->bmiHeader.biXPelsPerMeter = 3200;
+    m_pBitmapInfo->bmiHeader.biYPelsPerMeter = 3200;
+    m_pBitmapInfo->bmiHeader.biClrUsed = 256;
+    m_pBitmapInfo->bmiHeader.biClrImportant = 256;
+
+    for(int nColor = 0; nColor < 256; ++nColor)
+    {
+        m_pBitmapInfo->bmiColors[nColor].rgbRed = (BYTE)((nColor > 128) ? 255 : 0);
+        m_pBitmapInfo->bmiColors[nColor].rgbGreen = (BYTE)((nColor > 128) ? 255 : 0);
+        m_pBitmapInfo->bmiColors[nColor].rgbBlue = (BYTE)((nColor > 128) ? 255 : 0);
+        m_pBitmapInfo->bmiColors[nColor].rgbReserved = 0;
+    }
+
+    HRESULT hRes = AddBuffer();
+    if(FAILED(hRes))
+    {
+        Shutdown();
+        return hRes;
+    }
+
+    SelectBuffer(0);
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::CreateSharedBitmap
+//
+// Creates DIB sections of our own on the pixels of rOwner, so that this
+// object and rOwner can draw into different parts of the same screen
+// from different threads.
+//
+//************************************************************************
+
+HRESULT CLCDGfxBase::CreateSharedBitmap(CLCDGfxBase &rOwner)
+{
+    LCDUIASSERT(!rOwner.m_Buffers.empty() && (NULL != rOwner.m_pBitmapInfo));
+    if(rOwner.m_Buffers.empty() || (NULL == rOwner.m_pBitmapInfo))
+    {
+        return E_INVALIDARG;
+    }
+
+    m_nWidth = rOwner.m_nWidth;
+    m_nHeight = rOwner.m_nHeight;
+
+    int nBMISize = sizeof(BITMAPINFO) + 256 * sizeof(RGBQUAD);
+    m_pBitmapInfo = (BITMAPINFO *) new BYTE [nBMISize];
+    if(NULL == m_pBitmapInfo)
+    {
+        LCDUITRACE(_T("CLCDGfxBase::CreateSharedBitmap(): failed to allocate bitmap info.\n"));
+        Shutdown();
+        return E_OUTOFMEMORY;
+    }
+    memcpy(m_pBitmapInfo, rOwner.m_pBitmapInfo, nBMISize);
+
+    HRESULT hRes = FollowBuffers(rOwner);
+    if(FAILED(hRes))
+    {
+        Shutdown();
+    }
+    return hRes;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::FollowBuffers
+//
+//************************************************************************
+
+HRESULT CLCDGfxBase::FollowBuffers(CLCDGfxBase &rOwner)
+{
+    if((m_dwSharedSerial != rOwner.m_dwBufferSerial) ||
+       (m_Buffers.size() != rOwner.m_Buffers.size()))
+    {
+        FreeBuffers(0);
+        for(size_t i = 0; i < rOwner.m_Buffers.size(); i++)
+        {
+            // our own handle, so that Shutdown() works the same for both objects
+            HANDLE hMapping = NULL;
+            if(!DuplicateHandle(GetCurrentProcess(), rOwner.m_Buffers[i].hMapping,
+                GetCurrentProcess(), &hMapping, 0, FALSE, DUPLICATE_SAME_ACCESS))
+            {
+                LCDUITRACE(_T("CLCDGfxBase::FollowBuffers(): failed to duplicate screen mapping.\n"));
+                FreeBuffers(0);
+                return E_FAIL;
+            }
+
+            HRESULT hRes = MapBuffer(hMapping);
+            if(FAILED(hRes))
+            {
+                FreeBuffers(0);
+                return hRes;
+            }
+        }
+        m_dwSharedSerial = rOwner.m_dwBufferSerial;
+    }
+
+    if(m_Buffers.empty())
+    {
+        return E_FAIL;
+    }
+    SelectBuffer(rOwner.m_nBuffer);
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::AddBuffer
+//
+// Back the DIB with a mapping that holds a complete lgLcdBitmap.
+// Monochrome, as well as color pixels start at the same (DWORD aligned)
+// offset, which is where the DIB bits are placed.
+//
+//************************************************************************
+
+HRESULT CLCDGfxBase::AddBuffer(void)
+{
+    LCDUIASSERT(NULL != m_pBitmapInfo);
+    DWORD dwPixelOffset = (DWORD)FIELD_OFFSET(lgLcdBitmap160x43x1, pixels);
+    DWORD dwMappingSize = dwPixelOffset + m_pBitmapInfo->bmiHeader.biSizeImage;
+
+    HANDLE hMapping = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+        0, dwMappingSize, NULL);
+    if(NULL == hMapping)
+    {
+        LCDUITRACE(_T("CLCDGfxBase::AddBuffer(): failed to create screen mapping.\n"));
+        return E_OUTOFMEMORY;
+    }
+
+    return MapBuffer(hMapping);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::MapBuffer
+//
+// Maps hMapping and creates the DIB section on top of it. The buffer
+// owns hMapping, which is closed if this fails.
+//
+//************************************************************************
+
+HRESULT CLCDGfxBase::MapBuffer(HANDLE hMapping)
+{
+    DWORD dwPixelOffset = (DWORD)FIELD_OFFSET(lgLcdBitmap160x43x1, pixels);
+    DWORD dwMappingSize = dwPixelOffset + m_pBitmapInfo->bmiHeader.biSizeImage;
+
+    SCREENBUFFER Buffer;
+    ZeroMemory(&Buffer, sizeof(Buffer));
+    Buffer.hMapping = hMapping;
+
+    Buffer.pScreen = (lgLcdBitmap *) MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS,
+        0, 0, dwMappingSize);
+    if(NULL == Buffer.pScreen)
+    {
+        LCDUITRACE(_T("CLCDGfxBase::MapBuffer(): failed to map screen.\n"));
+        CloseHandle(hMapping);
+        return E_OUTOFMEMORY;
+    }
+
+    Buffer.hBitmap = CreateDIBSection(m_hDC, m_pBitmapInfo, DIB_RGB_COLORS,
+        (PVOID *) &Buffer.pBits, hMapping, dwPixelOffset);
+    if(NULL == Buffer.hBitmap)
+    {
+        LCDUITRACE(_T("CLCDGfxBase::MapBuffer(): failed to create bitmap.\n"));
+        UnmapViewOfFile(Buffer.pScreen);
+        CloseHandle(hMapping);
+        return E_FAIL;
+    }
+
+    LCDUIASSERT(Buffer.pBits == Buffer.pScreen->bmp_mono.pixels);
+
+    m_Buffers.push_back(Buffer);
+    m_dwBufferSerial++;
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::FreeBuffers
+//
+// Frees the buffers from nFirst on. The first one is selected if the
+// current one went away.
+//
+//************************************************************************
+
+void CLCDGfxBase::FreeBuffers(int nFirst)
+{
+    LCDUIASSERT(NULL == m_hPrevBitmap);
+
+    while((int)m_Buffers.size() > nFirst)
+    {
+        SCREENBUFFER &rBuffer = m_Buffers.back();
+        if(NULL != rBuffer.hBitmap)
+        {
+            DeleteObject(rBuffer.hBitmap);
+        }
+        if(NULL != rBuffer.hMapping)
+        {
+            UnmapViewOfFile(rBuffer.pScreen);
+            CloseHandle(rBuffer.hMapping);
+        }
+        if(NULL != rBuffer.pAllocation)
+        {
+            delete [] rBuffer.pAllocation;
+        }
+        m_Buffers.pop_back();
+        m_dwBufferSerial++;
+    }
+
+    if(m_nBuffer >= (int)m_Buffers.size())
+    {
+        if(m_Buffers.empty())
+        {
+            m_nBuffer = 0;
+            m_hScreenMapping = NULL;
+            m_pLCDScreen = NULL;
+            m_hBitmap = NULL;
+            m_pBitmapBits = NULL;
+        }
+        else
+        {
+            SelectBuffer(0);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::SetBufferCount
+//
+//************************************************************************
+
+HRESULT CLCDGfxBase::SetBufferCount(int nBuffers)
+{
+    LCDUIASSERT(NULL == m_hPrevBitmap);
+    if(m_Buffers.empty())
+    {
+        return E_FAIL;
+    }
+
+    nBuffers = max(1, nBuffers);
+    int nPrevBuffers = (int)m_Buffers.size();
+    while((int)m_Buffers.size() < nBuffers)
+    {
+        HRESULT hRes = AddBuffer();
+        if(FAILED(hRes))
+        {
+            FreeBuffers(nPrevBuffers);
+            return hRes;
+        }
+    }
+    FreeBuffers(nBuffers);
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetBufferCount
+//
+//************************************************************************
+
+int CLCDGfxBase::GetBufferCount(void)
+{
+    return (int)m_Buffers.size();
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::SelectBuffer
+//
+//************************************************************************
+
+void CLCDGfxBase::SelectBuffer(int nBuffer)
+{
+    LCDUIASSERT(NULL == m_hPrevBitmap);
+    LCDUIASSERT((0 <= nBuffer) && (nBuffer < (int)m_Buffers.size()));
+    if((0 > nBuffer) || (nBuffer >= (int)m_Buffers.size()))
+    {
+        return;
+    }
+
+    const SCREENBUFFER &rBuffer = m_Buffers[nBuffer];
+    m_nBuffer = nBuffer;
+    m_hScreenMapping = rBuffer.hMapping;
+    m_pLCDScreen = rBuffer.pScreen;
+    m_hBitmap = rBuffer.hBitmap;
+    m_pBitmapBits = rBuffer.pBits;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxBase::GetCurrentBuffer
+//
+//************************************************************************
+
+int CLCDGfxBase::GetCurrentBuffer(void)
+{
+    return m_nBuffer;
+}
+
+
+//** end of LCDGfxBase.cpp ***********************************************
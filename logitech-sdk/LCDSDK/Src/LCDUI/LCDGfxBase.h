@@ -1,87 +1,177 @@
-//************************************************************************
-//
-// NOTE: This version of ColorLCDUI is pre-release and is subject to 
-// change.
-//
-// LCDGfxBase.h
-//
-// Abstract class for different display types.
-//
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#ifndef __LCDGFXBASE_H__
-#define __LCDGFXBASE_H__
-
-#include <lglcd.h>
-
-
-#if _MSC_VER >= 1400  
-#define LCDUI_tcsncpy(x, y, z)       _tcsncpy_s(x, _countof(x), y, z)
-#define LCDUI_tcscpy(x, y)           _tcscpy_s(x, _countof(x), y)
-#else
-#define LCDUI_tcsncpy(x, y, z)       _tcsncpy(x, y, z)
-#define LCDUI_tcscpy(x, y)           _tcscpy(x, y)
-#endif
-
-#ifndef LCDUITRACE
-    // .NET compiler uses __noop intrinsic
-    #if _MSC_VER > 1300
-        #define LCDUITRACE __noop
-    #else
-        #define LCDUITRACE (void)0
-    #endif
-#endif
-
-#ifndef LCDUIASSERT
-    // .NET compiler uses __noop intrinsic
-    #if _MSC_VER > 1300
-        #define LCDUIASSERT __noop
-    #else
-        #define LCDUIASSERT (void)0
-    #endif
-#endif
-
-
-class CLCDGfxBase
-{
-public:
-    CLCDGfxBase(void);
-    virtual ~CLCDGfxBase(void);
-
-    virtual HRESULT Initialize(void);
-    virtual void Shutdown(void);
-    virtual void ClearScreen(void);
-    virtual void BeginDraw(void);
-    virtual void EndDraw(void);
-
-    virtual HDC GetHDC(void);
-    virtual lgLcdBitmap *GetLCDScreen(void);
-    virtual BITMAPINFO *GetBitmapInfo(void);
-    virtual HBITMAP GetHBITMAP(void);
-
-    virtual DWORD GetFamily(void) = 0;
-
-    virtual int GetWidth(void);
-    virtual int GetHeight(void);
-
-protected:
-    HRESULT CreateBitmap(WORD wBitCount);
-
-protected:
-    lgLcdBitmap *m_pLCDScreen;
-    int m_nWidth;
-    int m_nHeight;
-    BITMAPINFO *m_pBitmapInfo;
-    HDC m_hDC;
-    HBITMAP m_hBitmap;
-    HBITMAP m_hPrevBitmap;
-    PBYTE m_pBitmapBits;
-
-};
-
-#endif
-
-//** end of LCDGfxBase.h *************************************************
+//************************************************************************
+//
+// NOTE: This version of ColorLCDUI is pre-release and is subject to 
+// change.
+//
+// LCDGfxBase.h
+//
+// Abstract class for different display types.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef __LCDGFXBASE_H__
+#define __LCDGFXBASE_H__
+
+#include <lglcd.h>
+
+
+#if _MSC_VER >= 1400  
+#define LCDUI_tcsncpy(x, y, z)       _tcsncpy_s(x, _countof(x), y, z)
+#define LCDUI_tcscpy(x, y)           _tcscpy_s(x, _countof(x), y)
+#else
+#define LCDUI_tcsncpy(x, y, z)       _tcsncpy(x, y, z)
+#define LCDUI_tcscpy(x, y)           _tcscpy(x, y)
+#endif
+
+// Strings can be moved into the controls (Visual C++ 2010 and later)
+#if (_MSC_VER >= 1600) || (__cplusplus >= 201103L)
+#define LCDUI_RVALUE_REFS
+#endif
+
+#ifndef LCDUITRACE
+    // .NET compiler uses __noop intrinsic
+    #if _MSC_VER > 1300
+        #define LCDUITRACE __noop
+    #else
+        #define LCDUITRACE (void)0
+    #endif
+#endif
+
+#ifndef LCDUIASSERT
+    // .NET compiler uses __noop intrinsic
+    #if _MSC_VER > 1300
+        #define LCDUIASSERT __noop
+    #else
+        #define LCDUIASSERT (void)0
+    #endif
+#endif
+
+
+class CLCDGfxSoft;
+class CLCDImage;
+
+class CLCDGfxBase
+{
+public:
+    CLCDGfxBase(void);
+    virtual ~CLCDGfxBase(void);
+
+    virtual HRESULT Initialize(void);
+    virtual void Shutdown(void);
+    virtual void ClearScreen(void);
+    virtual void ClearRect(const RECT &rc);
+    virtual void BeginDraw(void);
+    virtual void EndDraw(void);
+
+    virtual HDC GetHDC(void);
+    virtual lgLcdBitmap *GetLCDScreen(void);
+    virtual BITMAPINFO *GetBitmapInfo(void);
+    virtual HBITMAP GetHBITMAP(void);
+
+    // software surface, if this object renders without a device context
+    virtual CLCDGfxSoft *GetSoftSurface(void);
+
+    virtual DWORD GetFamily(void) = 0;
+
+    virtual int GetWidth(void);
+    virtual int GetHeight(void);
+
+    // While a damage rectangle is set, only that part of the surface is
+    // being redrawn. NULL redraws the whole surface.
+    void SetDamageRect(const RECT *prcDamage);
+    BOOL GetDamageRect(RECT &rcDamage);
+    BOOL ClipToDamage(RECT &rc);
+
+    // Set while drawing a page whose objects already ran OnPrepareDraw()
+    // for this frame, such as the tiles of CLCDTileRenderer. Collections
+    // then skip preparing their objects again.
+    void SetPrepared(BOOL bPrepared);
+    BOOL IsPrepared(void);
+
+    // Screen buffers, for pipelined submission. Drawing and GetLCDScreen()
+    // use the current buffer; selecting another one lets the previous
+    // frame be sent while the next is drawn. A buffer keeps whatever was
+    // last drawn into it. Not between BeginDraw() and EndDraw().
+    HRESULT SetBufferCount(int nBuffers);
+    int GetBufferCount(void);
+    void SelectBuffer(int nBuffer);
+    int GetCurrentBuffer(void);
+
+    // For drawing into the pixels without GDI: the offset from logical to
+    // surface coordinates and the clip box in surface pixels. Returns
+    // FALSE if GDI has to be used, because the mapping is scaled or the
+    // clip region is not a rectangle. GDI is flushed when TRUE returns.
+    // Soft surfaces return their origin and clip rectangle.
+    virtual BOOL GetDirectTarget(POINT &ptOffset, RECT &rcClip);
+    virtual PBYTE GetBits(void);
+    virtual int GetPitch(void);
+    virtual int GetBitCount(void);
+
+    // Composites a premultiplied image into rcDst, in logical coordinates
+    // of the device context, without going through AlphaBlend(). Returns
+    // FALSE if the surface cannot take it, the caller then falls back to
+    // GDI. See CLCDCompositor::Composite for the blend modes.
+    virtual BOOL DrawImage(const RECT &rcDst, const CLCDImage &rImage, const RECT *prcSrc = NULL,
+                           BYTE byAlpha = 255, BOOL bPerPixelAlpha = TRUE);
+
+    // Copies a packed 1bpp image (see CLCDDither) to (nX, nY), in logical
+    // coordinates, leaving the pixels whose mask bit is clear. Returns
+    // FALSE if the surface is not monochrome or cannot be written
+    // directly, the caller then falls back to GDI.
+    virtual BOOL DrawPacked(int nX, int nY, int nWidth, int nHeight,
+                            const BYTE *pBits, int nPitch,
+                            const BYTE *pMaskBits = NULL, int nMaskPitch = 0);
+
+protected:
+    HRESULT CreateBitmap(WORD wBitCount);
+    HRESULT CreateSharedBitmap(CLCDGfxBase &rOwner);
+    // Shares the buffers of rOwner, again if they changed since the last
+    // call, and selects the one rOwner draws into
+    HRESULT FollowBuffers(CLCDGfxBase &rOwner);
+    // appends a buffer, without selecting it
+    virtual HRESULT AddBuffer(void);
+    HRESULT MapBuffer(HANDLE hMapping);
+    void FreeBuffers(int nFirst);
+
+    struct SCREENBUFFER
+    {
+        HANDLE hMapping;
+        // soft surfaces allocate their buffers
+        PBYTE pAllocation;
+        lgLcdBitmap *pScreen;
+        HBITMAP hBitmap;
+        PBYTE pBits;
+    };
+
+protected:
+    // the DIB section is created on top of this mapping, so GDI renders
+    // straight into the pixels of the bitmap handed to lgLcdUpdateBitmap()
+    HANDLE m_hScreenMapping;
+    lgLcdBitmap *m_pLCDScreen;
+    int m_nWidth;
+    int m_nHeight;
+    BITMAPINFO *m_pBitmapInfo;
+    HDC m_hDC;
+    HBITMAP m_hBitmap;
+    HBITMAP m_hPrevBitmap;
+    PBYTE m_pBitmapBits;
+    RECT m_rcDamage;
+    BOOL m_bPartialDraw;
+    BOOL m_bPrepared;
+
+    // the members above describe the current buffer
+    std::vector<SCREENBUFFER> m_Buffers;
+    int m_nBuffer;
+    // changes whenever buffers are added or freed
+    DWORD m_dwBufferSerial;
+    // m_dwBufferSerial of the owner when its buffers were last shared
+    DWORD m_dwSharedSerial;
+
+};
+
+#endif
+
+//** end of LCDGfxBase.h *************************************************
@@ -1,100 +1,123 @@
-//************************************************************************
-//
-// NOTE: This version of ColorLCDUI is pre-release and is subject to 
-// change.
-//
-// LCDGfxMono.cpp
-//
-// This Gfx object handles drawing to a 160x43 monochrome display.
-//
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDGfxMono::CLCDGfxMono
-//
-//************************************************************************
-
-CLCDGfxMono::CLCDGfxMono(void)
-{
-    m_pLCDScreen = (lgLcdBitmap *) &m_LCDScreen;
-    m_pLCDScreen->hdr.Format = LGLCD_BMP_FORMAT_160x43x1;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxMono::~CLCDGfxMono
-//
-//************************************************************************
-
-CLCDGfxMono::~CLCDGfxMono(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDGfxMono::Initialize
-//
-//************************************************************************
-
-HRESULT CLCDGfxMono::Initialize(void)
-{
-    //reset everything
-    Shutdown();
-
-    m_nWidth = LGLCD_BW_BMP_WIDTH;
-    m_nHeight = LGLCD_BW_BMP_HEIGHT;
-
-    HRESULT hRes = CLCDGfxBase::Initialize();
-    if(FAILED(hRes))
-    {
-        return hRes;
-    }
-
-    hRes = CLCDGfxBase::CreateBitmap(8);
-    if(FAILED(hRes))
-    {
-        return hRes;
-    }
-
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxMono::GetLCDScreen
-//
-//************************************************************************
-
-lgLcdBitmap* CLCDGfxMono::GetLCDScreen(void)
-{
-    LCDUIASSERT(m_pLCDScreen == (lgLcdBitmap *) &m_LCDScreen);
-    m_LCDScreen.hdr.Format = LGLCD_BMP_FORMAT_160x43x1;
-    memcpy(m_LCDScreen.pixels, m_pBitmapBits, m_nWidth * m_nHeight);
-    return m_pLCDScreen;
-}
-
-
-//************************************************************************
-//
-// CLCDGfxMono::ClearScreen
-//
-//************************************************************************
-
-void CLCDGfxMono::ClearScreen(void)
-{
-    memset(m_pBitmapBits, 0, m_nWidth * m_nHeight);
-
-    CLCDGfxBase::ClearScreen();
-}
-
-//** end of LCDGfxMono.cpp ***********************************************
+//************************************************************************
+//
+// NOTE: This version of ColorLCDUI is pre-release and is subject to 
+// change.
+//
+// LCDGfxMono.cpp
+//
+// This Gfx object handles drawing to a 160x43 monochrome display.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDGfxMono::CLCDGfxMono
+//
+//************************************************************************
+
+CLCDGfxMono::CLCDGfxMono(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDGfxMono::~CLCDGfxMono
+//
+//************************************************************************
+
+CLCDGfxMono::~CLCDGfxMono(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDGfxMono::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDGfxMono::Initialize(void)
+{
+    //reset everything
+    Shutdown();
+
+    m_nWidth = LGLCD_BW_BMP_WIDTH;
+    m_nHeight = LGLCD_BW_BMP_HEIGHT;
+
+    HRESULT hRes = CLCDGfxBase::Initialize();
+    if(FAILED(hRes))
+    {
+        return hRes;
+    }
+
+    hRes = CLCDGfxBase::CreateBitmap(8);
+    if(FAILED(hRes))
+    {
+        return hRes;
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxMono::GetLCDScreen
+//
+//************************************************************************
+
+lgLcdBitmap* CLCDGfxMono::GetLCDScreen(void)
+{
+    // rendered in place by the DIB section, see CLCDGfxBase::CreateBitmap()
+    LCDUIASSERT(NULL != m_pLCDScreen);
+    if(NULL != m_pLCDScreen)
+    {
+        m_pLCDScreen->hdr.Format = LGLCD_BMP_FORMAT_160x43x1;
+    }
+    return m_pLCDScreen;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxMono::ClearScreen
+//
+//************************************************************************
+
+void CLCDGfxMono::ClearScreen(void)
+{
+    memset(m_pBitmapBits, 0, m_nWidth * m_nHeight);
+
+    CLCDGfxBase::ClearScreen();
+}
+
+
+//************************************************************************
+//
+// CLCDGfxMono::ClearRect
+//
+//************************************************************************
+
+void CLCDGfxMono::ClearRect(const RECT &rc)
+{
+    RECT rcClear = { 0, 0, m_nWidth, m_nHeight };
+    if (IntersectRect(&rcClear, &rcClear, &rc))
+    {
+        for (int y = rcClear.top; y < rcClear.bottom; y++)
+        {
+            memset(m_pBitmapBits + y * m_nWidth + rcClear.left, 0,
+                   rcClear.right - rcClear.left);
+        }
+    }
+
+    CLCDGfxBase::ClearRect(rc);
+}
+
+//** end of LCDGfxMono.cpp ***********************************************
@@ -0,0 +1,649 @@
+//************************************************************************
+//
+// LCDGfxSoft.cpp
+//
+// This Gfx object renders into a plain, aligned pixel buffer without
+// any device context.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// RECT and POINT to the structs of the raster core, and back
+//
+//************************************************************************
+
+static inline LCDSOFTRECT ToSoftRect(const RECT &rc)
+{
+    LCDSOFTRECT rcSoft = { rc.left, rc.top, rc.right, rc.bottom };
+    return rcSoft;
+}
+
+static inline RECT FromSoftRect(const LCDSOFTRECT &rcSoft)
+{
+    RECT rc = { rcSoft.left, rcSoft.top, rcSoft.right, rcSoft.bottom };
+    return rc;
+}
+
+static inline POINT FromSoftPoint(const LCDSOFTPOINT &ptSoft)
+{
+    POINT pt = { ptSoft.x, ptSoft.y };
+    return pt;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::CLCDGfxSoft
+//
+//************************************************************************
+
+CLCDGfxSoft::CLCDGfxSoft(WORD wBitCount)
+:   m_wBitCount(wBitCount),
+    m_nPitch(0)
+{
+    LCDUIASSERT((32 == wBitCount) || (8 == wBitCount) || (1 == wBitCount));
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::~CLCDGfxSoft
+//
+//************************************************************************
+
+CLCDGfxSoft::~CLCDGfxSoft(void)
+{
+    Shutdown();
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDGfxSoft::Initialize(void)
+{
+    //reset everything
+    Shutdown();
+
+    if(32 == m_wBitCount)
+    {
+        m_nWidth = LGLCD_QVGA_BMP_WIDTH;
+        m_nHeight = LGLCD_QVGA_BMP_HEIGHT;
+    }
+    else
+    {
+        m_nWidth = LGLCD_BW_BMP_WIDTH;
+        m_nHeight = LGLCD_BW_BMP_HEIGHT;
+    }
+
+    if(1 == m_wBitCount)
+    {
+        m_nPitch = ((m_nWidth + 31) / 32) * sizeof(DWORD);
+    }
+    else
+    {
+        m_nPitch = m_nWidth * ((32 == m_wBitCount) ? 4 : 1);
+    }
+
+    HRESULT hRes = AddBuffer();
+    if(FAILED(hRes))
+    {
+        Shutdown();
+        return hRes;
+    }
+    SelectBuffer(0);
+
+    SetClipRect(NULL);
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::Shutdown
+//
+//************************************************************************
+
+void CLCDGfxSoft::Shutdown(void)
+{
+    // the buffers are freed by CLCDGfxBase
+    m_Surface.Detach();
+    m_nPitch = 0;
+
+    CLCDGfxBase::Shutdown();
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::AddBuffer
+//
+// The 8bpp and 32bpp surfaces are the payload of an lgLcdBitmap, so
+// they can be submitted without a copy. Both row sizes are a multiple
+// of the alignment, so aligning the first pixel aligns every row.
+// The 1bpp surface is packed into rows of DWORDs (leftmost pixel in
+// the least significant bit) and expanded into the payload at submit.
+//
+//************************************************************************
+
+HRESULT CLCDGfxSoft::AddBuffer(void)
+{
+    int nPayloadPitch = m_nWidth * ((32 == m_wBitCount) ? 4 : 1);
+    LCDUIASSERT(0 == (nPayloadPitch % SURFACE_ALIGNMENT));
+
+    int nPackedBytes = (1 == m_wBitCount) ? m_nPitch * m_nHeight + SURFACE_ALIGNMENT : 0;
+    int nPixelOffset = (int)FIELD_OFFSET(lgLcdBitmap160x43x1, pixels);
+    int nPayloadBytes = nPayloadPitch * m_nHeight;
+
+    SCREENBUFFER Buffer;
+    ZeroMemory(&Buffer, sizeof(Buffer));
+    Buffer.pAllocation = new BYTE [nPixelOffset + nPayloadBytes + SURFACE_ALIGNMENT - 1 + nPackedBytes];
+    if(NULL == Buffer.pAllocation)
+    {
+        LCDUITRACE(_T("CLCDGfxSoft::AddBuffer(): failed to allocate surface.\n"));
+        return E_OUTOFMEMORY;
+    }
+
+    PBYTE pPayload = (PBYTE)(((UINT_PTR)Buffer.pAllocation + nPixelOffset + SURFACE_ALIGNMENT - 1) &
+        ~((UINT_PTR)SURFACE_ALIGNMENT - 1));
+    Buffer.pScreen = (lgLcdBitmap *)(pPayload - nPixelOffset);
+    Buffer.pScreen->hdr.Format = (32 == m_wBitCount) ?
+        LGLCD_BMP_FORMAT_QVGAx32 : LGLCD_BMP_FORMAT_160x43x1;
+    memset(pPayload, 0, nPayloadBytes);
+
+    if(1 == m_wBitCount)
+    {
+        Buffer.pBits = (PBYTE)(((UINT_PTR)pPayload + nPayloadBytes + SURFACE_ALIGNMENT - 1) &
+            ~((UINT_PTR)SURFACE_ALIGNMENT - 1));
+    }
+    else
+    {
+        Buffer.pBits = pPayload;
+    }
+    memset(Buffer.pBits, 0, m_nPitch * m_nHeight);
+
+    m_Buffers.push_back(Buffer);
+    m_dwBufferSerial++;
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::ClearScreen
+//
+//************************************************************************
+
+void CLCDGfxSoft::ClearScreen(void)
+{
+    LCDUIASSERT(NULL != m_pBitmapBits);
+    GetRasterCore().Clear();
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::ClearRect
+//
+//************************************************************************
+
+void CLCDGfxSoft::ClearRect(const RECT &rc)
+{
+    GetRasterCore().ClearRect(ToSoftRect(rc));
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::BeginDraw
+//
+//************************************************************************
+
+void CLCDGfxSoft::BeginDraw(void)
+{
+    SetClipRect(NULL);
+    SetOrigin(0, 0);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::EndDraw
+//
+//************************************************************************
+
+void CLCDGfxSoft::EndDraw(void)
+{
+    SetClipRect(NULL);
+    SetOrigin(0, 0);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetHDC
+//
+// There is no device context behind this surface.
+//************************************************************************
+
+HDC CLCDGfxSoft::GetHDC(void)
+{
+    return NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetLCDScreen
+//
+//************************************************************************
+
+lgLcdBitmap* CLCDGfxSoft::GetLCDScreen(void)
+{
+    // rendered in place, nothing to copy unless the surface is packed
+    LCDUIASSERT(NULL != m_pLCDScreen);
+    if(NULL != m_pLCDScreen)
+    {
+        m_pLCDScreen->hdr.Format = (32 == m_wBitCount) ?
+            LGLCD_BMP_FORMAT_QVGAx32 : LGLCD_BMP_FORMAT_160x43x1;
+
+        if((1 == m_wBitCount) && (NULL != m_pBitmapBits))
+        {
+            for(int y = 0; y < m_nHeight; ++y)
+            {
+                CLCDSoftSurface::ExpandPackedRow(m_pBitmapBits + y * m_nPitch,
+                                m_pLCDScreen->bmp_mono.pixels + y * m_nWidth, m_nWidth);
+            }
+        }
+    }
+    return m_pLCDScreen;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetHBITMAP
+//
+//************************************************************************
+
+HBITMAP CLCDGfxSoft::GetHBITMAP(void)
+{
+    return NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetSoftSurface
+//
+//************************************************************************
+
+CLCDGfxSoft* CLCDGfxSoft::GetSoftSurface(void)
+{
+    return this;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetFamily
+//
+//************************************************************************
+
+DWORD CLCDGfxSoft::GetFamily(void)
+{
+    return (32 == m_wBitCount) ?
+        LGLCD_DEVICE_FAMILY_QVGA_BASIC : LGLCD_DEVICE_FAMILY_KEYBOARD_G15;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetDirectTarget
+//
+// The pixels are always written directly, at the current origin and
+// within the clip rectangle.
+//************************************************************************
+
+BOOL CLCDGfxSoft::GetDirectTarget(POINT &ptOffset, RECT &rcClip)
+{
+    CLCDSoftSurface &rSurface = GetRasterCore();
+    ptOffset = FromSoftPoint(rSurface.GetOrigin());
+    rcClip = FromSoftRect(rSurface.GetClipRect());
+    return (NULL != m_pBitmapBits);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetBits
+//
+//************************************************************************
+
+PBYTE CLCDGfxSoft::GetBits(void)
+{
+    return m_pBitmapBits;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetPitch
+//
+//************************************************************************
+
+int CLCDGfxSoft::GetPitch(void)
+{
+    return m_nPitch;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetBitCount
+//
+//************************************************************************
+
+int CLCDGfxSoft::GetBitCount(void)
+{
+    return m_wBitCount;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetRasterCore
+//
+// Attaches the core to the buffer CLCDGfxBase has selected, which
+// changes when frames are pipelined.
+//************************************************************************
+
+CLCDSoftSurface &CLCDGfxSoft::GetRasterCore(void)
+{
+    if(m_Surface.GetBits() != m_pBitmapBits)
+    {
+        m_Surface.Attach(m_pBitmapBits, m_nWidth, m_nHeight, m_nPitch, m_wBitCount);
+    }
+    return m_Surface;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::SetClipRect
+//
+// NULL resets the clip rectangle to the whole surface.
+//************************************************************************
+
+void CLCDGfxSoft::SetClipRect(const RECT *prcClip)
+{
+    if(NULL == prcClip)
+    {
+        GetRasterCore().SetClipRect(NULL);
+        return;
+    }
+
+    LCDSOFTRECT rcClip = ToSoftRect(*prcClip);
+    GetRasterCore().SetClipRect(&rcClip);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetClipRect
+//
+//************************************************************************
+
+void CLCDGfxSoft::GetClipRect(RECT *prcClip)
+{
+    LCDUIASSERT(NULL != prcClip);
+    if(NULL != prcClip)
+    {
+        *prcClip = FromSoftRect(GetRasterCore().GetClipRect());
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::SetOrigin
+//
+// Returns the previous origin.
+//************************************************************************
+
+POINT CLCDGfxSoft::SetOrigin(int nX, int nY)
+{
+    return FromSoftPoint(GetRasterCore().SetOrigin(nX, nY));
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetOrigin
+//
+//************************************************************************
+
+POINT CLCDGfxSoft::GetOrigin(void)
+{
+    return FromSoftPoint(GetRasterCore().GetOrigin());
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::FillRect
+//
+//************************************************************************
+
+void CLCDGfxSoft::FillRect(const RECT &rc, COLORREF crColor)
+{
+    GetRasterCore().FillRect(ToSoftRect(rc), crColor);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::FrameRect
+//
+//************************************************************************
+
+void CLCDGfxSoft::FrameRect(const RECT &rc, COLORREF crColor)
+{
+    GetRasterCore().FrameRect(ToSoftRect(rc), crColor);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::InvertRect
+//
+//************************************************************************
+
+void CLCDGfxSoft::InvertRect(const RECT &rc)
+{
+    GetRasterCore().InvertRect(ToSoftRect(rc));
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::HLine
+//
+//************************************************************************
+
+void CLCDGfxSoft::HLine(int nX1, int nX2, int nY, COLORREF crColor)
+{
+    GetRasterCore().HLine(nX1, nX2, nY, crColor);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::Blit
+//
+// The source is a top-down 32bpp BGRA image. With bAlpha, the source is
+// expected to be premultiplied, as with AlphaBlend().
+//************************************************************************
+
+void CLCDGfxSoft::Blit(int nX, int nY, int nWidth, int nHeight,
+                       const BYTE *pSrcBits, int nSrcPitch, BOOL bAlpha)
+{
+    LCDUIASSERT(NULL != pSrcBits);
+    GetRasterCore().Blit(nX, nY, nWidth, nHeight, pSrcBits, nSrcPitch, bAlpha ? true : false);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::DrawImage
+//
+// Only 32bpp surfaces composite images, the others are left to the
+// caller (see CLCDBitmap::DrawSoft).
+//************************************************************************
+
+BOOL CLCDGfxSoft::DrawImage(const RECT &rcDst, const CLCDImage &rImage, const RECT *prcSrc,
+                            BYTE byAlpha, BOOL bPerPixelAlpha)
+{
+    if((32 != m_wBitCount) || (NULL == m_pBitmapBits))
+    {
+        return FALSE;
+    }
+
+    POINT ptOrigin = GetOrigin();
+    RECT rcClip;
+    GetClipRect(&rcClip);
+
+    RECT rcSurface = rcDst;
+    OffsetRect(&rcSurface, ptOrigin.x, ptOrigin.y);
+    CLCDCompositor::Composite(m_pBitmapBits, m_nPitch, rcClip, rcSurface,
+        rImage, prcSrc, byAlpha, bPerPixelAlpha);
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::DrawPacked
+//
+//************************************************************************
+
+BOOL CLCDGfxSoft::DrawPacked(int nX, int nY, int nWidth, int nHeight,
+                             const BYTE *pBits, int nPitch,
+                             const BYTE *pMaskBits, int nMaskPitch)
+{
+    if((32 == m_wBitCount) || (NULL == m_pBitmapBits))
+    {
+        return FALSE;
+    }
+
+    BlitPacked(nX, nY, nWidth, nHeight, pBits, nPitch, pMaskBits, nMaskPitch);
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::BlitPacked
+//
+// The source and the optional mask are packed 1bpp images in the layout
+// of the 1bpp surface. Pixels whose mask bit is clear are left alone.
+//************************************************************************
+
+void CLCDGfxSoft::BlitPacked(int nX, int nY, int nWidth, int nHeight,
+                             const BYTE *pSrcBits, int nSrcPitch,
+                             const BYTE *pMaskBits, int nMaskPitch)
+{
+    LCDUIASSERT(NULL != pSrcBits);
+    GetRasterCore().BlitPacked(nX, nY, nWidth, nHeight, pSrcBits, nSrcPitch, pMaskBits, nMaskPitch);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::DrawText
+//
+// Draws with the built-in 5x7 font. '\n' starts a new line.
+//************************************************************************
+
+void CLCDGfxSoft::DrawText(int nX, int nY, LPCTSTR szText, int nLength,
+                           COLORREF crColor, int nScale)
+{
+    LCDUIASSERT(NULL != szText);
+    GetRasterCore().DrawText(nX, nY, szText, nLength, crColor, nScale);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetTextExtent
+//
+//************************************************************************
+
+SIZE CLCDGfxSoft::GetTextExtent(LPCTSTR szText, int nLength, int nScale)
+{
+    LCDSOFTSIZE sizeSoft = CLCDSoftSurface::GetTextExtent(szText, nLength, nScale);
+    SIZE sizeExtent = { sizeSoft.cx, sizeSoft.cy };
+    return sizeExtent;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetScaleForFontHeight
+//
+// Maps a LOGFONT height onto an integer scale of the built-in font.
+//************************************************************************
+
+int CLCDGfxSoft::GetScaleForFontHeight(int nFontHeight)
+{
+    return CLCDSoftSurface::GetScaleForFontHeight(nFontHeight);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::GetPackedBits
+//
+//************************************************************************
+
+DWORD CLCDGfxSoft::GetPackedBits(const BYTE *pRow, int nBit, int nRowBits)
+{
+    return CLCDSoftSurface::GetPackedBits(pRow, nBit, nRowBits);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::ExpandPackedRow
+//
+//************************************************************************
+
+void CLCDGfxSoft::ExpandPackedRow(const BYTE *pSrc, PBYTE pDst, int nWidth)
+{
+    CLCDSoftSurface::ExpandPackedRow(pSrc, pDst, nWidth);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxSoft::CSurface::BlendRow
+//
+//************************************************************************
+
+void CLCDGfxSoft::CSurface::BlendRow(unsigned char *pDst, const unsigned char *pSrc, int nWidth)
+{
+    CLCDCompositor::BlendRow(pDst, pSrc, nWidth);
+}
+
+//** end of LCDGfxSoft.cpp ***********************************************
@@ -0,0 +1,115 @@
+//************************************************************************
+//
+// LCDGfxSoft.h
+//
+// This Gfx object renders into a plain, aligned pixel buffer without
+// any device context, so that page trees can be rendered headless
+// (offscreen profiling, regression captures) as well as submitted to a
+// device. The fill, blit, clip and text primitives are those of
+// CLCDSoftSurface, which builds without windows.h; this class adapts
+// them to RECT, COLORREF and TCHAR, owns the lgLcdBitmap buffers and
+// draws CLCDImage. The page tree itself still uses the Windows types,
+// so only the raster core is portable.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef __LCDGFXSOFT_H__
+#define __LCDGFXSOFT_H__
+
+#include "LCDGfxBase.h"
+#include "LCDSoftSurface.h"
+
+class CLCDGfxSoft : public CLCDGfxBase
+{
+public:
+    // 32 bits per pixel renders a QVGA frame, 8 bits per pixel a 160x43 one.
+    // 1 bit per pixel renders the 160x43 frame into a packed surface.
+    CLCDGfxSoft(WORD wBitCount = 32);
+    virtual ~CLCDGfxSoft(void);
+
+    virtual HRESULT Initialize(void);
+    virtual void Shutdown(void);
+    virtual void ClearScreen(void);
+    virtual void ClearRect(const RECT &rc);
+    virtual void BeginDraw(void);
+    virtual void EndDraw(void);
+
+    virtual HDC GetHDC(void);
+    virtual lgLcdBitmap *GetLCDScreen(void);
+    virtual HBITMAP GetHBITMAP(void);
+    virtual CLCDGfxSoft *GetSoftSurface(void);
+
+    virtual DWORD GetFamily(void);
+
+    // surface access
+    virtual BOOL GetDirectTarget(POINT &ptOffset, RECT &rcClip);
+    virtual PBYTE GetBits(void);
+    virtual int GetPitch(void);
+    virtual int GetBitCount(void);
+
+    // clipping and origin, in surface coordinates
+    void SetClipRect(const RECT *prcClip);
+    void GetClipRect(RECT *prcClip);
+    POINT SetOrigin(int nX, int nY);
+    POINT GetOrigin(void);
+
+    // primitives, in coordinates relative to the current origin
+    void FillRect(const RECT &rc, COLORREF crColor);
+    void FrameRect(const RECT &rc, COLORREF crColor);
+    void InvertRect(const RECT &rc);
+    void HLine(int nX1, int nX2, int nY, COLORREF crColor);
+    void Blit(int nX, int nY, int nWidth, int nHeight,
+              const BYTE *pSrcBits, int nSrcPitch, BOOL bAlpha);
+    void BlitPacked(int nX, int nY, int nWidth, int nHeight,
+                    const BYTE *pSrcBits, int nSrcPitch,
+                    const BYTE *pMaskBits = NULL, int nMaskPitch = 0);
+    void DrawText(int nX, int nY, LPCTSTR szText, int nLength,
+                  COLORREF crColor, int nScale = 1);
+    virtual BOOL DrawImage(const RECT &rcDst, const CLCDImage &rImage, const RECT *prcSrc = NULL,
+                           BYTE byAlpha = 255, BOOL bPerPixelAlpha = TRUE);
+    virtual BOOL DrawPacked(int nX, int nY, int nWidth, int nHeight,
+                            const BYTE *pBits, int nPitch,
+                            const BYTE *pMaskBits = NULL, int nMaskPitch = 0);
+
+    // the portable raster core, attached to the current buffer
+    CLCDSoftSurface &GetRasterCore(void);
+
+    // built-in 5x7 font metrics
+    static SIZE GetTextExtent(LPCTSTR szText, int nLength, int nScale = 1);
+    static int GetScaleForFontHeight(int nFontHeight);
+
+    // packed 1bpp helpers
+    static void ExpandPackedRow(const BYTE *pSrc, PBYTE pDst, int nWidth);
+    static DWORD GetPackedBits(const BYTE *pRow, int nBit, int nRowBits);
+
+    enum
+    {
+        GLYPH_WIDTH = CLCDSoftSurface::GLYPH_WIDTH,
+        GLYPH_HEIGHT = CLCDSoftSurface::GLYPH_HEIGHT,
+        GLYPH_ADVANCE = CLCDSoftSurface::GLYPH_ADVANCE,
+        GLYPH_LINEHEIGHT = CLCDSoftSurface::GLYPH_LINEHEIGHT,
+        SURFACE_ALIGNMENT = 16
+    };
+
+protected:
+    virtual HRESULT AddBuffer(void);
+
+    // blends with the vector kernels of CLCDCompositor
+    class CSurface : public CLCDSoftSurface
+    {
+    protected:
+        virtual void BlendRow(unsigned char *pDst, const unsigned char *pSrc, int nWidth);
+    };
+
+protected:
+    WORD m_wBitCount;
+    int m_nPitch;
+    CSurface m_Surface;
+};
+
+#endif
+
+//** end of LCDGfxSoft.h *************************************************
@@ -0,0 +1,107 @@
+//************************************************************************
+//
+// LCDGfxView.cpp
+//
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDGfxView::CLCDGfxView
+//
+//************************************************************************
+
+CLCDGfxView::CLCDGfxView(CLCDGfxBase &rOwner)
+:   m_rOwner(rOwner)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDGfxView::~CLCDGfxView
+//
+//************************************************************************
+
+CLCDGfxView::~CLCDGfxView(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDGfxView::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDGfxView::Initialize(void)
+{
+    //reset everything
+    Shutdown();
+
+    // lets the owner fill in the bitmap header
+    if(NULL == m_rOwner.GetLCDScreen())
+    {
+        return E_FAIL;
+    }
+
+    HRESULT hRes = CLCDGfxBase::Initialize();
+    if(FAILED(hRes))
+    {
+        return hRes;
+    }
+
+    return CLCDGfxBase::CreateSharedBitmap(m_rOwner);
+}
+
+
+//************************************************************************
+//
+// CLCDGfxView::BeginDraw
+//
+//************************************************************************
+
+void CLCDGfxView::BeginDraw(void)
+{
+    if(FAILED(FollowBuffers(m_rOwner)))
+    {
+        LCDUITRACE(_T("CLCDGfxView::BeginDraw(): failed to share the screen buffers.\n"));
+    }
+    CLCDGfxBase::BeginDraw();
+}
+
+
+//************************************************************************
+//
+// CLCDGfxView::GetLCDScreen
+//
+// The header is the one of the owner, see Initialize()
+//
+//************************************************************************
+
+lgLcdBitmap* CLCDGfxView::GetLCDScreen(void)
+{
+    LCDUIASSERT(NULL != m_pLCDScreen);
+    return m_pLCDScreen;
+}
+
+
+//************************************************************************
+//
+// CLCDGfxView::GetFamily
+//
+//************************************************************************
+
+DWORD CLCDGfxView::GetFamily(void)
+{
+    return m_rOwner.GetFamily();
+}
+
+
+//** end of LCDGfxView.cpp ***********************************************
@@ -0,0 +1,39 @@
+//************************************************************************
+//
+// LCDGfxView.h
+//
+// This Gfx object draws into the screen of another Gfx object, through
+// a device context of its own. Each thread that draws into the same
+// screen needs one.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef __LCDGFXVIEW_H__
+#define __LCDGFXVIEW_H__
+
+#include "LCDGfxBase.h"
+
+class CLCDGfxView : public CLCDGfxBase
+{
+public:
+    // rOwner must be initialized, and outlive this object
+    CLCDGfxView(CLCDGfxBase &rOwner);
+    virtual ~CLCDGfxView(void);
+
+    virtual HRESULT Initialize(void);
+    // draws into the buffer the owner draws into
+    virtual void BeginDraw(void);
+    virtual lgLcdBitmap *GetLCDScreen(void);
+
+    virtual DWORD GetFamily(void);
+
+protected:
+    CLCDGfxBase &m_rOwner;
+};
+
+#endif
+
+//** end of LCDGfxView.h *************************************************
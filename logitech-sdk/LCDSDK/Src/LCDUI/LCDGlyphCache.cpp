@@ -0,0 +1,658 @@
+//************************************************************************
+//
+// LCDGlyphCache.cpp
+//
+// The CLCDGlyphCache class keeps the glyphs of the fonts used by the
+// text objects rasterized in atlas pages.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+static CLCDGlyphCache s_GlyphCache;
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::CLCDGlyphCache
+//
+//************************************************************************
+
+CLCDGlyphCache::CLCDGlyphCache(void)
+:   m_nShelfX(0),
+    m_nShelfY(0),
+    m_nShelfHeight(0),
+    m_hDC(NULL),
+    m_bEnabled(TRUE),
+    m_dwHits(0),
+    m_dwMisses(0)
+{
+    InitializeCriticalSection(&m_csCache);
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::~CLCDGlyphCache
+//
+//************************************************************************
+
+CLCDGlyphCache::~CLCDGlyphCache(void)
+{
+    Clear();
+    if(NULL != m_hDC)
+    {
+        DeleteDC(m_hDC);
+        m_hDC = NULL;
+    }
+    DeleteCriticalSection(&m_csCache);
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::GetInstance
+//
+//************************************************************************
+
+CLCDGlyphCache &CLCDGlyphCache::GetInstance(void)
+{
+    return s_GlyphCache;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::Clear
+//
+//************************************************************************
+
+void CLCDGlyphCache::Clear(void)
+{
+    EnterCriticalSection(&m_csCache);
+
+    for(size_t i = 0; i < m_Fonts.size(); i++)
+    {
+        DeleteObject(m_Fonts[i]->hFont);
+        delete m_Fonts[i];
+    }
+    m_Fonts.clear();
+
+    for(size_t i = 0; i < m_Pages.size(); i++)
+    {
+        delete [] m_Pages[i];
+    }
+    m_Pages.clear();
+    m_nShelfX = m_nShelfY = m_nShelfHeight = 0;
+
+    LeaveCriticalSection(&m_csCache);
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::Enable
+//
+//************************************************************************
+
+void CLCDGlyphCache::Enable(BOOL bEnable)
+{
+    m_bEnabled = bEnable;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::IsEnabled
+//
+//************************************************************************
+
+BOOL CLCDGlyphCache::IsEnabled(void)
+{
+    return m_bEnabled;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::GetStatistics
+//
+//************************************************************************
+
+void CLCDGlyphCache::GetStatistics(DWORD &dwHits, DWORD &dwMisses)
+{
+    EnterCriticalSection(&m_csCache);
+    dwHits = m_dwHits;
+    dwMisses = m_dwMisses;
+    LeaveCriticalSection(&m_csCache);
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::ResetStatistics
+//
+//************************************************************************
+
+void CLCDGlyphCache::ResetStatistics(void)
+{
+    EnterCriticalSection(&m_csCache);
+    m_dwHits = 0;
+    m_dwMisses = 0;
+    LeaveCriticalSection(&m_csCache);
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::DrawText
+//
+// Lays the text out like DrawTextEx(): lines end at CR, LF or CR LF and,
+// with DT_WORDBREAK, before the first word that does not fit. The glyphs
+// are looked up in one go, then drawn without holding the lock.
+//
+//************************************************************************
+
+BOOL CLCDGlyphCache::DrawText(CLCDGfxBase &rGfx, HFONT hFont, LPCTSTR szText, int nLength,
+                              const RECT &rcBoundary, UINT nFormat, const DRAWTEXTPARAMS &dtp,
+                              COLORREF crColor)
+{
+    const UINT nUnsupported = DT_CALCRECT | DT_EXPANDTABS | DT_TABSTOP | DT_EXTERNALLEADING |
+        DT_END_ELLIPSIS | DT_PATH_ELLIPSIS | DT_WORD_ELLIPSIS | DT_MODIFYSTRING |
+        DT_RTLREADING | DT_EDITCONTROL | DT_INTERNAL | DT_HIDEPREFIX | DT_PREFIXONLY;
+
+    if(!m_bEnabled || (NULL == szText) || (nFormat & nUnsupported))
+    {
+        return FALSE;
+    }
+
+    int nBitCount = rGfx.GetBitCount();
+    if((8 != nBitCount) && (32 != nBitCount))
+    {
+        return FALSE;
+    }
+
+    BOOL bSingleLine = (0 != (nFormat & DT_SINGLELINE));
+    for(int i = 0; i < nLength; i++)
+    {
+        TCHAR ch = szText[i];
+        if((_T('\t') == ch) ||
+            ((_T('&') == ch) && !(nFormat & DT_NOPREFIX)) ||
+            (bSingleLine && ((_T('\r') == ch) || (_T('\n') == ch))))
+        {
+            return FALSE;
+        }
+    }
+
+    std::vector<GLYPH> Glyphs(nLength);
+    int nLineHeight = 0;
+    int nAscent = 0;
+
+    EnterCriticalSection(&m_csCache);
+    FONT *pFont = FindFont(hFont, (8 == nBitCount));
+    BOOL bCached = (NULL != pFont);
+    for(int i = 0; bCached && (i < nLength); i++)
+    {
+        if((_T('\r') == szText[i]) || (_T('\n') == szText[i]))
+        {
+            ZeroMemory(&Glyphs[i], sizeof(GLYPH));
+        }
+        else
+        {
+            bCached = FindGlyph(*pFont, (UINT)(TBYTE)szText[i], Glyphs[i]);
+        }
+    }
+    if(bCached)
+    {
+        nLineHeight = pFont->nLineHeight;
+        nAscent = pFont->nAscent;
+    }
+    LeaveCriticalSection(&m_csCache);
+
+    POINT ptOffset;
+    RECT rcClip;
+    if(!bCached || !rGfx.GetDirectTarget(ptOffset, rcClip))
+    {
+        return FALSE;
+    }
+
+    // DrawTextEx() clips to the boundary, unless told not to
+    if(!(nFormat & DT_NOCLIP))
+    {
+        RECT rcBoundarySurface = rcBoundary;
+        OffsetRect(&rcBoundarySurface, ptOffset.x, ptOffset.y);
+        IntersectRect(&rcClip, &rcClip, &rcBoundarySurface);
+    }
+    if(IsRectEmpty(&rcClip))
+    {
+        return TRUE;
+    }
+
+    int nLeft = rcBoundary.left + dtp.iLeftMargin;
+    int nRight = rcBoundary.right - dtp.iRightMargin;
+    int nY = rcBoundary.top;
+    if(bSingleLine)
+    {
+        if(nFormat & DT_VCENTER)
+        {
+            nY = rcBoundary.top + (rcBoundary.bottom - rcBoundary.top - nLineHeight) / 2;
+        }
+        else if(nFormat & DT_BOTTOM)
+        {
+            nY = rcBoundary.bottom - nLineHeight;
+        }
+    }
+
+    int nStart = 0;
+    while((nStart < nLength) && (nY + ptOffset.y < rcClip.bottom))
+    {
+        int nEnd = nStart;
+        while((nEnd < nLength) && (_T('\r') != szText[nEnd]) && (_T('\n') != szText[nEnd]))
+        {
+            nEnd++;
+        }
+
+        int nNext = nEnd;
+        if((nFormat & DT_WORDBREAK) && !bSingleLine)
+        {
+            int nWidth = 0;
+            int nSpace = NO_GLYPH;
+            for(int i = nStart; i < nEnd; i++)
+            {
+                if(_T(' ') == szText[i])
+                {
+                    nSpace = i;
+                }
+                else if((NO_GLYPH != nSpace) && (nLeft + nWidth + Glyphs[i].nAdvance > nRight))
+                {
+                    nEnd = nSpace;
+                    nNext = nSpace;
+                    break;
+                }
+                nWidth += Glyphs[i].nAdvance;
+            }
+        }
+
+        // blanks at the end of a line do not count for the alignment
+        int nTrimmed = nEnd;
+        while((nTrimmed > nStart) && (_T(' ') == szText[nTrimmed - 1]))
+        {
+            nTrimmed--;
+        }
+
+        int nX = nLeft;
+        if(nFormat & DT_CENTER)
+        {
+            nX = nLeft + (nRight - nLeft - GetTextWidth(Glyphs, nStart, nTrimmed)) / 2;
+        }
+        else if(nFormat & DT_RIGHT)
+        {
+            nX = nRight - GetTextWidth(Glyphs, nStart, nTrimmed);
+        }
+
+        if(nY + nLineHeight + ptOffset.y > rcClip.top)
+        {
+            DrawGlyphs(rGfx, ptOffset, rcClip, Glyphs, nStart, nTrimmed, nX, nY + nAscent, crColor);
+        }
+        nY += nLineHeight;
+
+        // skip the line break, or the blanks a wrapped line ends with
+        nStart = nNext;
+        if((nStart < nLength) && (_T('\r') == szText[nStart]))
+        {
+            nStart++;
+            if((nStart < nLength) && (_T('\n') == szText[nStart]))
+            {
+                nStart++;
+            }
+        }
+        else if((nStart < nLength) && (_T('\n') == szText[nStart]))
+        {
+            nStart++;
+        }
+        else
+        {
+            while((nStart < nLength) && (_T(' ') == szText[nStart]))
+            {
+                nStart++;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::FindFont
+//
+// Monochrome surfaces, and fonts that ask for it, get 1 bit glyphs like
+// GDI would draw; the others get gray levels. Returns NULL if the font
+// has decorations or a rotation that the cache does not draw.
+//
+//************************************************************************
+
+CLCDGlyphCache::FONT *CLCDGlyphCache::FindFont(HFONT hFont, BOOL bMonoSurface)
+{
+    LOGFONT lf;
+    if((NULL == hFont) || !CLCDFontRegistry::GetInstance().GetLogFont(hFont, lf))
+    {
+        return NULL;
+    }
+    if(lf.lfUnderline || lf.lfStrikeOut || (0 != lf.lfEscapement) || (0 != lf.lfOrientation))
+    {
+        return NULL;
+    }
+
+    FONTKEY Key;
+    ZeroMemory(&Key, sizeof(Key));
+    LCDUI_tcsncpy(Key.szFaceName, lf.lfFaceName, LF_FACESIZE - 1);
+    Key.lHeight = lf.lfHeight;
+    Key.lWidth = lf.lfWidth;
+    Key.lWeight = lf.lfWeight;
+    Key.byItalic = lf.lfItalic;
+    Key.byCharSet = lf.lfCharSet;
+    Key.byQuality = lf.lfQuality;
+    Key.byFormat = (BYTE)((bMonoSurface || (NONANTIALIASED_QUALITY == lf.lfQuality)) ? GLYPH_MONO : GLYPH_GRAY);
+
+    for(size_t i = 0; i < m_Fonts.size(); i++)
+    {
+        if(0 == memcmp(&m_Fonts[i]->Key, &Key, sizeof(Key)))
+        {
+            return m_Fonts[i]->bSupported ? m_Fonts[i] : NULL;
+        }
+    }
+
+    if(NULL == m_hDC)
+    {
+        m_hDC = CreateCompatibleDC(NULL);
+        if(NULL == m_hDC)
+        {
+            return NULL;
+        }
+    }
+
+    FONT *pFont = new FONT;
+    pFont->Key = Key;
+    pFont->hFont = CreateFontIndirect(&lf);
+    pFont->bSupported = FALSE;
+    pFont->nLineHeight = 0;
+    pFont->nAscent = 0;
+    for(int i = 0; i < 256; i++)
+    {
+        pFont->anLatin[i] = NO_GLYPH;
+    }
+
+    // only outline fonts have glyph outlines
+    TEXTMETRIC tm;
+    HFONT hOldFont = (HFONT)SelectObject(m_hDC, pFont->hFont);
+    if(GetTextMetrics(m_hDC, &tm) && (tm.tmPitchAndFamily & (TMPF_TRUETYPE | TMPF_VECTOR)))
+    {
+        pFont->bSupported = TRUE;
+        pFont->nLineHeight = tm.tmHeight;
+        pFont->nAscent = tm.tmAscent;
+    }
+    SelectObject(m_hDC, hOldFont);
+
+    m_Fonts.push_back(pFont);
+    return pFont->bSupported ? pFont : NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::FindGlyph
+//
+//************************************************************************
+
+BOOL CLCDGlyphCache::FindGlyph(FONT &rFont, UINT nChar, GLYPH &rGlyph)
+{
+    int *pIndex = NULL;
+    if(nChar < 256)
+    {
+        pIndex = &rFont.anLatin[nChar];
+    }
+    else
+    {
+        std::map<UINT, int>::iterator it = rFont.Others.find(nChar);
+        if(it == rFont.Others.end())
+        {
+            it = rFont.Others.insert(std::make_pair(nChar, (int)NO_GLYPH)).first;
+        }
+        pIndex = &it->second;
+    }
+
+    if(0 <= *pIndex)
+    {
+        m_dwHits++;
+        rGlyph = rFont.Glyphs[*pIndex];
+        return TRUE;
+    }
+
+    m_dwMisses++;
+    if(NO_GLYPH == *pIndex)
+    {
+        // missing glyphs stay with GDI, which can take them from a
+        // linked font; a full atlas is tried again next time
+        if(!RasterizeGlyph(rFont, nChar, rGlyph))
+        {
+            return FALSE;
+        }
+        *pIndex = (int)rFont.Glyphs.size();
+        rFont.Glyphs.push_back(rGlyph);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::RasterizeGlyph
+//
+//************************************************************************
+
+BOOL CLCDGlyphCache::RasterizeGlyph(FONT &rFont, UINT nChar, GLYPH &rGlyph)
+{
+    HFONT hOldFont = (HFONT)SelectObject(m_hDC, rFont.hFont);
+    BOOL bRet = FALSE;
+
+    // surrogates, and characters the font does not have, are left to GDI
+    WORD wIndex = 0xFFFF;
+#ifdef UNICODE
+    WCHAR wch = (WCHAR)nChar;
+    BOOL bExists = ((wch < 0xD800) || (wch > 0xDFFF)) &&
+        (1 == GetGlyphIndicesW(m_hDC, &wch, 1, &wIndex, GGI_MARK_NONEXISTING_GLYPHS)) &&
+        (0xFFFF != wIndex);
+#else
+    CHAR ch = (CHAR)nChar;
+    BOOL bExists = !IsDBCSLeadByte((BYTE)ch) &&
+        (1 == GetGlyphIndicesA(m_hDC, &ch, 1, &wIndex, GGI_MARK_NONEXISTING_GLYPHS)) &&
+        (0xFFFF != wIndex);
+#endif
+
+    UINT nFormat = (GLYPH_MONO == rFont.Key.byFormat) ? GGO_BITMAP : GGO_GRAY8_BITMAP;
+    MAT2 mat = { { 0, 1 }, { 0, 0 }, { 0, 0 }, { 0, 1 } };
+    GLYPHMETRICS gm;
+    DWORD dwSize = bExists ? GetGlyphOutline(m_hDC, nChar, nFormat, &gm, 0, NULL, &mat) : GDI_ERROR;
+
+    if(!bExists)
+    {
+        int *pIndex = (nChar < 256) ? &rFont.anLatin[nChar] : &rFont.Others[nChar];
+        *pIndex = MISSING_GLYPH;
+    }
+    else if(GDI_ERROR != dwSize)
+    {
+        ZeroMemory(&rGlyph, sizeof(rGlyph));
+        rGlyph.nOffsetX = gm.gmptGlyphOrigin.x;
+        rGlyph.nOffsetY = -gm.gmptGlyphOrigin.y;
+        rGlyph.nAdvance = gm.gmCellIncX;
+
+        if(0 == dwSize)
+        {
+            // blank
+            bRet = TRUE;
+        }
+        else
+        {
+            std::vector<BYTE> Buffer(dwSize);
+            int nWidth = (int)gm.gmBlackBoxX;
+            int nHeight = (int)gm.gmBlackBoxY;
+            if((GDI_ERROR != GetGlyphOutline(m_hDC, nChar, nFormat, &gm, dwSize, &Buffer[0], &mat)) &&
+                (NULL != (rGlyph.pCoverage = AllocateCoverage(nWidth, nHeight))))
+            {
+                rGlyph.nWidth = nWidth;
+                rGlyph.nHeight = nHeight;
+
+                // rows of both formats are DWORD aligned
+                for(int y = 0; y < nHeight; y++)
+                {
+                    PBYTE pDst = rGlyph.pCoverage + y * PAGE_SIZE;
+                    if(GGO_BITMAP == nFormat)
+                    {
+                        const BYTE *pSrc = &Buffer[y * (((nWidth + 31) / 32) * 4)];
+                        for(int x = 0; x < nWidth; x++)
+                        {
+                            pDst[x] = (pSrc[x >> 3] & (0x80 >> (x & 7))) ? 255 : 0;
+                        }
+                    }
+                    else
+                    {
+                        // 65 levels
+                        const BYTE *pSrc = &Buffer[y * ((nWidth + 3) & ~3)];
+                        for(int x = 0; x < nWidth; x++)
+                        {
+                            pDst[x] = (BYTE)((min(64, pSrc[x]) * 255 + 32) / 64);
+                        }
+                    }
+                }
+                bRet = TRUE;
+            }
+        }
+    }
+
+    SelectObject(m_hDC, hOldFont);
+    return bRet;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::AllocateCoverage
+//
+// Glyphs are packed in rows ("shelves") as high as their tallest glyph.
+// Returns NULL once all pages are full.
+//
+//************************************************************************
+
+PBYTE CLCDGlyphCache::AllocateCoverage(int nWidth, int nHeight)
+{
+    if((nWidth > PAGE_SIZE) || (nHeight > PAGE_SIZE))
+    {
+        return NULL;
+    }
+
+    if(m_nShelfX + nWidth > PAGE_SIZE)
+    {
+        m_nShelfX = 0;
+        m_nShelfY += m_nShelfHeight;
+        m_nShelfHeight = 0;
+    }
+
+    if(m_Pages.empty() || (m_nShelfY + nHeight > PAGE_SIZE))
+    {
+        if(MAX_PAGES <= (int)m_Pages.size())
+        {
+            return NULL;
+        }
+
+        PBYTE pPage = new BYTE[PAGE_SIZE * PAGE_SIZE];
+        ZeroMemory(pPage, PAGE_SIZE * PAGE_SIZE);
+        m_Pages.push_back(pPage);
+        m_nShelfX = m_nShelfY = m_nShelfHeight = 0;
+    }
+
+    PBYTE pCoverage = m_Pages.back() + m_nShelfY * PAGE_SIZE + m_nShelfX;
+    m_nShelfX += nWidth;
+    m_nShelfHeight = max(m_nShelfHeight, nHeight);
+    return pCoverage;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::GetTextWidth
+//
+//************************************************************************
+
+int CLCDGlyphCache::GetTextWidth(const std::vector<GLYPH> &rGlyphs, int nStart, int nEnd)
+{
+    int nWidth = 0;
+    for(int i = nStart; i < nEnd; i++)
+    {
+        nWidth += rGlyphs[i].nAdvance;
+    }
+    return nWidth;
+}
+
+
+//************************************************************************
+//
+// CLCDGlyphCache::DrawGlyphs
+//
+// Draws one line, the pen starts at nX on the baseline. Monochrome
+// surfaces get the on or off value closest to the color.
+//
+//************************************************************************
+
+void CLCDGlyphCache::DrawGlyphs(CLCDGfxBase &rGfx, const POINT &ptOffset, const RECT &rcClip,
+                                const std::vector<GLYPH> &rGlyphs, int nStart, int nEnd,
+                                int nX, int nBaseline, COLORREF crColor)
+{
+    PBYTE pBits = rGfx.GetBits();
+    int nPitch = rGfx.GetPitch();
+    BOOL bMono = (8 == rGfx.GetBitCount());
+    BYTE byMono = (BYTE)((77 * GetRValue(crColor) + 150 * GetGValue(crColor) +
+        29 * GetBValue(crColor) >= 128 * 256) ? 255 : 0);
+
+    int nPenX = nX + ptOffset.x;
+    int nPenY = nBaseline + ptOffset.y;
+    for(int i = nStart; i < nEnd; i++)
+    {
+        const GLYPH &rGlyph = rGlyphs[i];
+        if(NULL != rGlyph.pCoverage)
+        {
+            RECT rcGlyph = { nPenX + rGlyph.nOffsetX, nPenY + rGlyph.nOffsetY,
+                nPenX + rGlyph.nOffsetX + rGlyph.nWidth, nPenY + rGlyph.nOffsetY + rGlyph.nHeight };
+            RECT rcDraw;
+            if(IntersectRect(&rcDraw, &rcGlyph, &rcClip))
+            {
+                int nWidth = rcDraw.right - rcDraw.left;
+                for(int y = rcDraw.top; y < rcDraw.bottom; y++)
+                {
+                    const BYTE *pCoverage = rGlyph.pCoverage +
+                        (y - rcGlyph.top) * PAGE_SIZE + (rcDraw.left - rcGlyph.left);
+                    if(bMono)
+                    {
+                        CLCDCompositor::ThresholdCoverageRow(pBits + y * nPitch + rcDraw.left,
+                            pCoverage, nWidth, byMono);
+                    }
+                    else
+                    {
+                        CLCDCompositor::BlendCoverageRow(pBits + y * nPitch + rcDraw.left * 4,
+                            pCoverage, nWidth, crColor);
+                    }
+                }
+            }
+        }
+        nPenX += rGlyph.nAdvance;
+    }
+}
+
+
+//** end of LCDGlyphCache.cpp ********************************************
@@ -0,0 +1,127 @@
+//************************************************************************
+//
+// LCDGlyphCache.h
+//
+// The CLCDGlyphCache class keeps the glyphs of the fonts used by the
+// text objects rasterized in atlas pages, so that text is composited
+// from cached coverage instead of going through DrawTextEx() each frame.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDGLYPHCACHE_H_INCLUDED_
+#define _LCDGLYPHCACHE_H_INCLUDED_
+
+#include <map>
+
+class CLCDGlyphCache
+{
+public:
+    CLCDGlyphCache(void);
+    virtual ~CLCDGlyphCache(void);
+
+    // the cache shared by all text objects
+    static CLCDGlyphCache &GetInstance(void);
+
+    // Draws the text the way DrawTextEx() would, in logical coordinates
+    // of the surface, with a transparent background. Returns FALSE
+    // without drawing for what the cache does not handle (tabs, prefixes,
+    // ellipses, non TrueType fonts, complex clip regions, a full atlas),
+    // the caller then uses DrawTextEx().
+    BOOL DrawText(CLCDGfxBase &rGfx, HFONT hFont, LPCTSTR szText, int nLength,
+                  const RECT &rcBoundary, UINT nFormat, const DRAWTEXTPARAMS &dtp,
+                  COLORREF crColor);
+
+    // Frees all the glyphs. Must not be called while pages are drawn.
+    void Clear(void);
+
+    // While disabled, DrawText() returns FALSE
+    void Enable(BOOL bEnable);
+    BOOL IsEnabled(void);
+
+    // glyph lookups since the last reset
+    void GetStatistics(DWORD &dwHits, DWORD &dwMisses);
+    void ResetStatistics(void);
+
+    enum { PAGE_SIZE = 256, MAX_PAGES = 16 };
+
+protected:
+    // how the coverage is rasterized
+    enum eGLYPH_FORMAT { GLYPH_MONO, GLYPH_GRAY };
+
+    struct FONTKEY
+    {
+        TCHAR szFaceName[LF_FACESIZE];
+        LONG lHeight;
+        LONG lWidth;
+        LONG lWeight;
+        BYTE byItalic;
+        BYTE byCharSet;
+        BYTE byQuality;
+        BYTE byFormat;
+    };
+
+    struct GLYPH
+    {
+        // in an atlas page, nWidth x nHeight with a pitch of PAGE_SIZE.
+        // NULL for blanks.
+        PBYTE pCoverage;
+        int nWidth;
+        int nHeight;
+        // top left of the coverage, relative to the pen on the baseline
+        int nOffsetX;
+        int nOffsetY;
+        int nAdvance;
+    };
+
+    struct FONT
+    {
+        FONTKEY Key;
+        HFONT hFont;
+        // FALSE if GetGlyphOutline() does not work with the font
+        BOOL bSupported;
+        int nLineHeight;
+        int nAscent;
+        // glyph indexes of the first 256 characters, then the others
+        int anLatin[256];
+        std::map<UINT, int> Others;
+        std::vector<GLYPH> Glyphs;
+    };
+
+    // glyph indexes that are not in Glyphs
+    enum { NO_GLYPH = -1, MISSING_GLYPH = -2 };
+
+    FONT *FindFont(HFONT hFont, BOOL bMonoSurface);
+    BOOL FindGlyph(FONT &rFont, UINT nChar, GLYPH &rGlyph);
+    BOOL RasterizeGlyph(FONT &rFont, UINT nChar, GLYPH &rGlyph);
+    PBYTE AllocateCoverage(int nWidth, int nHeight);
+    static int GetTextWidth(const std::vector<GLYPH> &rGlyphs, int nStart, int nEnd);
+    static void DrawGlyphs(CLCDGfxBase &rGfx, const POINT &ptOffset, const RECT &rcClip,
+                           const std::vector<GLYPH> &rGlyphs, int nStart, int nEnd,
+                           int nX, int nBaseline, COLORREF crColor);
+
+protected:
+    // the fonts, and the atlas pages holding the glyphs of all of them
+    std::vector<FONT *> m_Fonts;
+    std::vector<PBYTE> m_Pages;
+    // where the next glyph goes in the last page
+    int m_nShelfX;
+    int m_nShelfY;
+    int m_nShelfHeight;
+
+    // rasterizes the glyphs
+    HDC m_hDC;
+
+    BOOL m_bEnabled;
+    DWORD m_dwHits;
+    DWORD m_dwMisses;
+
+    // the tile renderer draws text from several threads
+    CRITICAL_SECTION m_csCache;
+};
+
+#endif // !_LCDGLYPHCACHE_H_INCLUDED_
+
+//** end of LCDGlyphCache.h **********************************************
@@ -1,74 +1,204 @@
-//************************************************************************
-//
-// LCDIcon.cpp
-//
-// The CLCDIcon class draws icons onto the lcd.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDIcon::CLCDIcon
-//
-//************************************************************************
-
-CLCDIcon::CLCDIcon(void)
-:   m_hIcon(NULL),
-    m_nIconWidth(16),
-    m_nIconHeight(16)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDIcon::CLCDIcon
-//
-//************************************************************************
-
-CLCDIcon::~CLCDIcon(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDIcon::SetIcon
-//
-//************************************************************************
-
-void CLCDIcon::SetIcon(HICON hIcon, int nWidth /* = 16 */, int nHeight /* = 16 */)
-{
-    m_hIcon = hIcon;
-    m_nIconWidth = nWidth;
-    m_nIconHeight = nHeight;
-}
-
-
-//************************************************************************
-//
-// CLCDIcon::OnDraw
-//
-//************************************************************************
-
-void CLCDIcon::OnDraw(CLCDGfxBase &rGfx)
-{
-    if (m_hIcon)
-    {
-        int nOldBkMode = SetBkMode(rGfx.GetHDC(), TRANSPARENT);
-
-        DrawIconEx(rGfx.GetHDC(), 0, 0, m_hIcon,
-                   m_nIconWidth, m_nIconHeight, 0, NULL, DI_NORMAL);
-
-        SetBkMode(rGfx.GetHDC(), nOldBkMode);
-    }
-}
-
-
-//** end of LCDIcon.cpp **************************************************
+//************************************************************************
+//
+// LCDIcon.cpp
+//
+// The CLCDIcon class draws icons onto the lcd.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDIcon::CLCDIcon
+//
+//************************************************************************
+
+CLCDIcon::CLCDIcon(void)
+:   m_hIcon(NULL),
+    m_nIconWidth(16),
+    m_nIconHeight(16),
+    m_nPackedPitch(0)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDIcon::CLCDIcon
+//
+//************************************************************************
+
+CLCDIcon::~CLCDIcon(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDIcon::SetIcon
+//
+//************************************************************************
+
+void CLCDIcon::SetIcon(HICON hIcon, int nWidth /* = 16 */, int nHeight /* = 16 */)
+{
+    m_hIcon = hIcon;
+    m_nIconWidth = nWidth;
+    m_nIconHeight = nHeight;
+    ConvertIcon();
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDIcon::ConvertIcon
+//
+// Draws the icon once over black and once over white. The difference
+// gives the alpha, the result over black the premultiplied color.
+//************************************************************************
+
+void CLCDIcon::ConvertIcon(void)
+{
+    m_Image.Clear();
+    m_PackedBits.clear();
+    m_PackedMask.clear();
+    m_nPackedPitch = 0;
+
+    if((NULL == m_hIcon) || (0 >= m_nIconWidth) || (0 >= m_nIconHeight))
+    {
+        return;
+    }
+
+    BITMAPINFO bmi;
+    ZeroMemory(&bmi, sizeof(bmi));
+    bmi.bmiHeader.biSize = sizeof(bmi.bmiHeader);
+    bmi.bmiHeader.biWidth = m_nIconWidth;
+    bmi.bmiHeader.biHeight = -m_nIconHeight;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    PBYTE pBlack = NULL;
+    PBYTE pWhite = NULL;
+    HBITMAP hBlack = CreateDIBSection(NULL, &bmi, DIB_RGB_COLORS, (void **)&pBlack, NULL, 0);
+    HBITMAP hWhite = CreateDIBSection(NULL, &bmi, DIB_RGB_COLORS, (void **)&pWhite, NULL, 0);
+    HDC hDC = CreateCompatibleDC(NULL);
+    BOOL bDrawn = FALSE;
+    size_t nSize = (size_t)m_nIconWidth * m_nIconHeight * 4;
+
+    if((NULL != hBlack) && (NULL != hWhite) && (NULL != pBlack) && (NULL != pWhite) && (NULL != hDC))
+    {
+        memset(pBlack, 0x00, nSize);
+        memset(pWhite, 0xFF, nSize);
+
+        HBITMAP hOldBitmap = (HBITMAP)SelectObject(hDC, hBlack);
+        bDrawn = DrawIconEx(hDC, 0, 0, m_hIcon, m_nIconWidth, m_nIconHeight, 0, NULL, DI_NORMAL);
+        SelectObject(hDC, hWhite);
+        bDrawn = bDrawn && DrawIconEx(hDC, 0, 0, m_hIcon, m_nIconWidth, m_nIconHeight, 0, NULL, DI_NORMAL);
+        SelectObject(hDC, hOldBitmap);
+        GdiFlush();
+    }
+
+    if(bDrawn)
+    {
+        for(size_t i = 0; i < nSize; i += 4)
+        {
+            int nCoverage = 0;
+            for(int c = 0; c < 3; c++)
+            {
+                nCoverage = max(nCoverage, (int)pWhite[i + c] - (int)pBlack[i + c]);
+            }
+            BYTE byAlpha = (BYTE)(255 - nCoverage);
+            for(int c = 0; c < 3; c++)
+            {
+                pBlack[i + c] = min(pBlack[i + c], byAlpha);
+            }
+            pBlack[i + 3] = byAlpha;
+        }
+
+        int nPitch = m_nIconWidth * 4;
+        m_Image.Create(m_nIconWidth, m_nIconHeight, pBlack, nPitch);
+
+        m_nPackedPitch = CLCDDither::GetPackedPitch(m_nIconWidth);
+        m_PackedBits.resize((size_t)m_nPackedPitch * m_nIconHeight);
+        m_PackedMask.resize(m_PackedBits.size());
+        CLCDDither::Dither(pBlack, nPitch, m_nIconWidth, m_nIconHeight,
+                           &m_PackedBits[0], m_nPackedPitch, CLCDDither::DITHER_THRESHOLD);
+        CLCDDither::AlphaMask(pBlack, nPitch, m_nIconWidth, m_nIconHeight,
+                              &m_PackedMask[0], m_nPackedPitch);
+    }
+    else
+    {
+        LCDUITRACE(_T("CLCDIcon::ConvertIcon(): could not render the icon.\n"));
+    }
+
+    if(NULL != hDC)
+    {
+        DeleteDC(hDC);
+    }
+    if(NULL != hBlack)
+    {
+        DeleteObject(hBlack);
+    }
+    if(NULL != hWhite)
+    {
+        DeleteObject(hWhite);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDIcon::OnDraw
+//
+//************************************************************************
+
+void CLCDIcon::OnDraw(CLCDGfxBase &rGfx)
+{
+    // each surface takes the conversion it can copy directly
+    if(!m_Image.IsEmpty())
+    {
+        if(rGfx.DrawPacked(0, 0, m_nIconWidth, m_nIconHeight,
+                           &m_PackedBits[0], m_nPackedPitch,
+                           &m_PackedMask[0], m_nPackedPitch))
+        {
+            return;
+        }
+
+        RECT rcIcon = { 0, 0, m_nIconWidth, m_nIconHeight };
+        if(rGfx.DrawImage(rcIcon, m_Image))
+        {
+            return;
+        }
+    }
+
+    if (m_hIcon)
+    {
+        int nOldBkMode = SetBkMode(rGfx.GetHDC(), TRANSPARENT);
+
+        DrawIconEx(rGfx.GetHDC(), 0, 0, m_hIcon,
+                   m_nIconWidth, m_nIconHeight, 0, NULL, DI_NORMAL);
+
+        SetBkMode(rGfx.GetHDC(), nOldBkMode);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDIcon::IsTileSafe
+//
+//************************************************************************
+
+BOOL CLCDIcon::IsTileSafe(void)
+{
+    return TRUE;
+}
+
+
+//** end of LCDIcon.cpp **************************************************
@@ -0,0 +1,1367 @@
+//************************************************************************
+//
+// LCDImageDecoder.cpp
+//
+// The CLCDImageDecoder class decodes PNG and BMP files straight into
+// premultiplied 32bpp BGRA pixels. PNG data is inflated here as well,
+// so no library beyond LCDUI is needed.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define LCDUI_SSE2
+#endif
+
+
+//************************************************************************
+//
+// Byte order helpers. PNG is big endian, BMP little endian.
+//
+//************************************************************************
+
+static inline DWORD ReadBE32(const BYTE *p)
+{
+    return ((DWORD)p[0] << 24) | ((DWORD)p[1] << 16) | ((DWORD)p[2] << 8) | p[3];
+}
+
+static inline WORD ReadLE16(const BYTE *p)
+{
+    return (WORD)(p[0] | (p[1] << 8));
+}
+
+static inline DWORD ReadLE32(const BYTE *p)
+{
+    return (DWORD)p[0] | ((DWORD)p[1] << 8) | ((DWORD)p[2] << 16) | ((DWORD)p[3] << 24);
+}
+
+
+//************************************************************************
+//
+// Inflate (RFC 1950/1951). Huffman codes up to FAST_BITS long are looked
+// up in one step, longer ones by comparing against the canonical codes.
+//
+//************************************************************************
+
+#define FAST_BITS   9
+#define FAST_SIZE   (1 << FAST_BITS)
+
+struct HUFFMAN
+{
+    // (size << 9) | symbol, indexed by the next bits of the stream
+    WORD awFast[FAST_SIZE];
+    WORD awFirstCode[16];
+    WORD awFirstSymbol[16];
+    DWORD adwMaxCode[17];
+    BYTE abySizes[288];
+    WORD awSymbols[288];
+};
+
+struct INFLATE
+{
+    const BYTE *pSrc;
+    const BYTE *pSrcEnd;
+    DWORD dwBits;
+    int nBits;
+    // zero bytes fed in past the end of the data
+    int nOverrun;
+    PBYTE pDstStart;
+    PBYTE pDst;
+    PBYTE pDstEnd;
+    HUFFMAN Literals;
+    HUFFMAN Distances;
+};
+
+static const WORD s_awLengthBase[29] =
+{
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const BYTE s_abyLengthExtra[29] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const WORD s_awDistanceBase[30] =
+{
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const BYTE s_abyDistanceExtra[30] =
+{
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const BYTE s_abyCodeLengthOrder[19] =
+{
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+static inline UINT ReverseBits(UINT v, int nCount)
+{
+    v = ((v & 0xAAAA) >> 1) | ((v & 0x5555) << 1);
+    v = ((v & 0xCCCC) >> 2) | ((v & 0x3333) << 2);
+    v = ((v & 0xF0F0) >> 4) | ((v & 0x0F0F) << 4);
+    v = ((v & 0xFF00) >> 8) | ((v & 0x00FF) << 8);
+    return v >> (16 - nCount);
+}
+
+static BOOL BuildHuffman(HUFFMAN &rHuffman, const BYTE *pSizes, int nSymbols)
+{
+    int anCount[16];
+    int anNextCode[16];
+    memset(anCount, 0, sizeof(anCount));
+    memset(rHuffman.awFast, 0, sizeof(rHuffman.awFast));
+    memset(rHuffman.abySizes, 0, sizeof(rHuffman.abySizes));
+    for(int i = 0; i < nSymbols; i++)
+    {
+        anCount[pSizes[i]]++;
+    }
+    anCount[0] = 0;
+
+    int nCode = 0;
+    int nSymbol = 0;
+    for(int nSize = 1; nSize < 16; nSize++)
+    {
+        anNextCode[nSize] = nCode;
+        rHuffman.awFirstCode[nSize] = (WORD)nCode;
+        rHuffman.awFirstSymbol[nSize] = (WORD)nSymbol;
+        nCode += anCount[nSize];
+        if((0 != anCount[nSize]) && (nCode - 1 >= (1 << nSize)))
+        {
+            // more codes than fit in nSize bits
+            return FALSE;
+        }
+        rHuffman.adwMaxCode[nSize] = (DWORD)nCode << (16 - nSize);
+        nCode <<= 1;
+        nSymbol += anCount[nSize];
+    }
+    rHuffman.adwMaxCode[16] = 0x10000;
+
+    for(int i = 0; i < nSymbols; i++)
+    {
+        int nSize = pSizes[i];
+        if(0 == nSize)
+        {
+            continue;
+        }
+        int nIndex = anNextCode[nSize] - rHuffman.awFirstCode[nSize] + rHuffman.awFirstSymbol[nSize];
+        rHuffman.abySizes[nIndex] = (BYTE)nSize;
+        rHuffman.awSymbols[nIndex] = (WORD)i;
+        if(nSize <= FAST_BITS)
+        {
+            for(UINT j = ReverseBits(anNextCode[nSize], nSize); j < FAST_SIZE; j += (1 << nSize))
+            {
+                rHuffman.awFast[j] = (WORD)((nSize << 9) | i);
+            }
+        }
+        anNextCode[nSize]++;
+    }
+    return TRUE;
+}
+
+static inline void Refill(INFLATE &rZ)
+{
+    while(rZ.nBits <= 24)
+    {
+        DWORD dwByte = 0;
+        if(rZ.pSrc < rZ.pSrcEnd)
+        {
+            dwByte = *rZ.pSrc++;
+        }
+        else
+        {
+            rZ.nOverrun++;
+        }
+        rZ.dwBits |= dwByte << rZ.nBits;
+        rZ.nBits += 8;
+    }
+}
+
+static inline UINT GetBits(INFLATE &rZ, int nCount)
+{
+    if(rZ.nBits < nCount)
+    {
+        Refill(rZ);
+    }
+    UINT nValue = rZ.dwBits & ((1 << nCount) - 1);
+    rZ.dwBits >>= nCount;
+    rZ.nBits -= nCount;
+    return nValue;
+}
+
+// TRUE once bits beyond the end of the data have been used
+static inline BOOL IsOverrun(const INFLATE &rZ)
+{
+    return rZ.nOverrun * 8 > rZ.nBits;
+}
+
+static inline int DecodeSymbol(INFLATE &rZ, const HUFFMAN &rHuffman)
+{
+    if(rZ.nBits < 16)
+    {
+        Refill(rZ);
+    }
+
+    WORD wFast = rHuffman.awFast[rZ.dwBits & (FAST_SIZE - 1)];
+    if(0 != wFast)
+    {
+        int nSize = wFast >> 9;
+        rZ.dwBits >>= nSize;
+        rZ.nBits -= nSize;
+        return wFast & 511;
+    }
+
+    UINT nCode = ReverseBits(rZ.dwBits & 0xFFFF, 16);
+    int nSize = FAST_BITS + 1;
+    while(nCode >= rHuffman.adwMaxCode[nSize])
+    {
+        nSize++;
+    }
+    if(16 <= nSize)
+    {
+        return -1;
+    }
+
+    int nIndex = (nCode >> (16 - nSize)) - rHuffman.awFirstCode[nSize] + rHuffman.awFirstSymbol[nSize];
+    if((288 <= nIndex) || (nSize != rHuffman.abySizes[nIndex]))
+    {
+        return -1;
+    }
+    rZ.dwBits >>= nSize;
+    rZ.nBits -= nSize;
+    return rHuffman.awSymbols[nIndex];
+}
+
+static BOOL InflateCodes(INFLATE &rZ)
+{
+    for(;;)
+    {
+        int nSymbol = DecodeSymbol(rZ, rZ.Literals);
+        if(256 > nSymbol)
+        {
+            if((0 > nSymbol) || (rZ.pDst >= rZ.pDstEnd))
+            {
+                return FALSE;
+            }
+            *rZ.pDst++ = (BYTE)nSymbol;
+            continue;
+        }
+        if(256 == nSymbol)
+        {
+            return !IsOverrun(rZ);
+        }
+
+        nSymbol -= 257;
+        if(29 <= nSymbol)
+        {
+            return FALSE;
+        }
+        int nLength = s_awLengthBase[nSymbol] + GetBits(rZ, s_abyLengthExtra[nSymbol]);
+
+        nSymbol = DecodeSymbol(rZ, rZ.Distances);
+        if((0 > nSymbol) || (30 <= nSymbol))
+        {
+            return FALSE;
+        }
+        int nDistance = s_awDistanceBase[nSymbol] + GetBits(rZ, s_abyDistanceExtra[nSymbol]);
+
+        if((rZ.pDst - rZ.pDstStart < nDistance) || (rZ.pDstEnd - rZ.pDst < nLength))
+        {
+            return FALSE;
+        }
+        const BYTE *pFrom = rZ.pDst - nDistance;
+        if(1 == nDistance)
+        {
+            memset(rZ.pDst, *pFrom, nLength);
+        }
+        else
+        {
+            // the copy may overlap what it writes
+            for(int i = 0; i < nLength; i++)
+            {
+                rZ.pDst[i] = pFrom[i];
+            }
+        }
+        rZ.pDst += nLength;
+    }
+}
+
+static BOOL InflateStored(INFLATE &rZ)
+{
+    GetBits(rZ, rZ.nBits & 7);
+    UINT nLength = GetBits(rZ, 16);
+    UINT nInverse = GetBits(rZ, 16);
+    if((nLength ^ 0xFFFF) != nInverse)
+    {
+        return FALSE;
+    }
+
+    // hand the whole bytes still buffered back to the source
+    int nBuffered = rZ.nBits / 8;
+    if(rZ.nOverrun > nBuffered)
+    {
+        return FALSE;
+    }
+    rZ.pSrc -= nBuffered - rZ.nOverrun;
+    rZ.dwBits = 0;
+    rZ.nBits = 0;
+    rZ.nOverrun = 0;
+
+    if(((UINT)(rZ.pSrcEnd - rZ.pSrc) < nLength) || ((UINT)(rZ.pDstEnd - rZ.pDst) < nLength))
+    {
+        return FALSE;
+    }
+    memcpy(rZ.pDst, rZ.pSrc, nLength);
+    rZ.pSrc += nLength;
+    rZ.pDst += nLength;
+    return TRUE;
+}
+
+static BOOL ReadDynamicTables(INFLATE &rZ)
+{
+    int nLiterals = GetBits(rZ, 5) + 257;
+    int nDistances = GetBits(rZ, 5) + 1;
+    int nCodeLengths = GetBits(rZ, 4) + 4;
+
+    BYTE abyCodeSizes[19];
+    memset(abyCodeSizes, 0, sizeof(abyCodeSizes));
+    for(int i = 0; i < nCodeLengths; i++)
+    {
+        abyCodeSizes[s_abyCodeLengthOrder[i]] = (BYTE)GetBits(rZ, 3);
+    }
+
+    HUFFMAN CodeLengths;
+    if(!BuildHuffman(CodeLengths, abyCodeSizes, 19))
+    {
+        return FALSE;
+    }
+
+    BYTE abySizes[288 + 32];
+    int nTotal = nLiterals + nDistances;
+    int n = 0;
+    while(n < nTotal)
+    {
+        int nSymbol = DecodeSymbol(rZ, CodeLengths);
+        if((0 > nSymbol) || (18 < nSymbol))
+        {
+            return FALSE;
+        }
+        if(16 > nSymbol)
+        {
+            abySizes[n++] = (BYTE)nSymbol;
+            continue;
+        }
+
+        BYTE byFill = 0;
+        int nRepeat = 0;
+        if(16 == nSymbol)
+        {
+            if(0 == n)
+            {
+                return FALSE;
+            }
+            byFill = abySizes[n - 1];
+            nRepeat = GetBits(rZ, 2) + 3;
+        }
+        else if(17 == nSymbol)
+        {
+            nRepeat = GetBits(rZ, 3) + 3;
+        }
+        else
+        {
+            nRepeat = GetBits(rZ, 7) + 11;
+        }
+        if(nTotal - n < nRepeat)
+        {
+            return FALSE;
+        }
+        memset(abySizes + n, byFill, nRepeat);
+        n += nRepeat;
+    }
+
+    return !IsOverrun(rZ) &&
+           BuildHuffman(rZ.Literals, abySizes, nLiterals) &&
+           BuildHuffman(rZ.Distances, abySizes + nLiterals, nDistances);
+}
+
+static void BuildFixedTables(INFLATE &rZ)
+{
+    BYTE abySizes[288];
+    memset(abySizes, 8, 144);
+    memset(abySizes + 144, 9, 112);
+    memset(abySizes + 256, 7, 24);
+    memset(abySizes + 280, 8, 8);
+    BuildHuffman(rZ.Literals, abySizes, 288);
+
+    memset(abySizes, 5, 30);
+    BuildHuffman(rZ.Distances, abySizes, 30);
+}
+
+// Inflates a zlib stream that must fill pDst exactly
+static BOOL Inflate(const BYTE *pSrc, size_t nSrcSize, PBYTE pDst, size_t nDstSize)
+{
+    if(2 > nSrcSize)
+    {
+        return FALSE;
+    }
+    // deflate, no preset dictionary
+    UINT nHeader = (pSrc[0] << 8) | pSrc[1];
+    if((8 != (pSrc[0] & 0x0F)) || (0 != (nHeader % 31)) || (0 != (pSrc[1] & 0x20)))
+    {
+        return FALSE;
+    }
+
+    INFLATE *pZ = new INFLATE;
+    pZ->pSrc = pSrc + 2;
+    pZ->pSrcEnd = pSrc + nSrcSize;
+    pZ->dwBits = 0;
+    pZ->nBits = 0;
+    pZ->nOverrun = 0;
+    pZ->pDstStart = pDst;
+    pZ->pDst = pDst;
+    pZ->pDstEnd = pDst + nDstSize;
+
+    BOOL bOK = TRUE;
+    BOOL bFinal = FALSE;
+    while(bOK && !bFinal)
+    {
+        bFinal = GetBits(*pZ, 1);
+        switch(GetBits(*pZ, 2))
+        {
+        case 0:
+            bOK = InflateStored(*pZ);
+            break;
+        case 1:
+            BuildFixedTables(*pZ);
+            bOK = InflateCodes(*pZ);
+            break;
+        case 2:
+            bOK = ReadDynamicTables(*pZ) && InflateCodes(*pZ);
+            break;
+        default:
+            bOK = FALSE;
+            break;
+        }
+        bOK = bOK && !IsOverrun(*pZ);
+    }
+
+    // the Adler-32 checksum is not verified, the size is
+    bOK = bOK && (pZ->pDst == pZ->pDstEnd);
+    delete pZ;
+    return bOK;
+}
+
+
+//************************************************************************
+//
+// PNG helpers
+//
+//************************************************************************
+
+struct PNGINFO
+{
+    int nWidth;
+    int nHeight;
+    int nDepth;
+    int nColorType;
+    int nChannels;
+    BOOL bInterlaced;
+};
+
+static const BYTE s_abyPngSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+// Adam7 passes; a plain image is the single pass { 0, 0, 1, 1 }
+static const BYTE s_abyAdam7[7][4] =
+{
+    { 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 },
+    { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 }
+};
+
+static HRESULT ReadPngHeader(const BYTE *pData, size_t nSize, PNGINFO &rInfo)
+{
+    if((33 > nSize) || (0 != memcmp(pData, s_abyPngSignature, 8)))
+    {
+        return E_NOTIMPL;
+    }
+    if((13 != ReadBE32(pData + 8)) || (0 != memcmp(pData + 12, "IHDR", 4)))
+    {
+        return E_FAIL;
+    }
+
+    DWORD dwWidth = ReadBE32(pData + 16);
+    DWORD dwHeight = ReadBE32(pData + 20);
+    rInfo.nDepth = pData[24];
+    rInfo.nColorType = pData[25];
+    rInfo.bInterlaced = (1 == pData[28]);
+    if((0 == dwWidth) || (0 == dwHeight) ||
+       (CLCDImageDecoder::MAX_DIMENSION < dwWidth) || (CLCDImageDecoder::MAX_DIMENSION < dwHeight) ||
+       (0 != pData[26]) || (0 != pData[27]) || (1 < pData[28]))
+    {
+        return E_FAIL;
+    }
+    rInfo.nWidth = (int)dwWidth;
+    rInfo.nHeight = (int)dwHeight;
+
+    int nDepth = rInfo.nDepth;
+    BOOL bValid = FALSE;
+    switch(rInfo.nColorType)
+    {
+    case 0:
+        rInfo.nChannels = 1;
+        bValid = (1 == nDepth) || (2 == nDepth) || (4 == nDepth) || (8 == nDepth) || (16 == nDepth);
+        break;
+    case 3:
+        rInfo.nChannels = 1;
+        bValid = (1 == nDepth) || (2 == nDepth) || (4 == nDepth) || (8 == nDepth);
+        break;
+    case 2:
+    case 4:
+    case 6:
+        rInfo.nChannels = (2 == rInfo.nColorType) ? 3 : ((4 == rInfo.nColorType) ? 2 : 4);
+        bValid = (8 == nDepth) || (16 == nDepth);
+        break;
+    }
+    return bValid ? S_OK : E_FAIL;
+}
+
+static inline size_t GetPngRowBytes(const PNGINFO &rInfo, int nWidth)
+{
+    return ((size_t)nWidth * rInfo.nChannels * rInfo.nDepth + 7) / 8;
+}
+
+static BOOL UnfilterRow(PBYTE pRow, const BYTE *pPrior, size_t nRowBytes, int nBpp, BYTE byFilter)
+{
+    size_t i;
+    switch(byFilter)
+    {
+    case 0:
+        break;
+    case 1:
+        for(i = nBpp; i < nRowBytes; i++)
+        {
+            pRow[i] = (BYTE)(pRow[i] + pRow[i - nBpp]);
+        }
+        break;
+    case 2:
+        for(i = 0; i < nRowBytes; i++)
+        {
+            pRow[i] = (BYTE)(pRow[i] + pPrior[i]);
+        }
+        break;
+    case 3:
+        for(i = 0; i < (size_t)nBpp; i++)
+        {
+            pRow[i] = (BYTE)(pRow[i] + (pPrior[i] >> 1));
+        }
+        for(; i < nRowBytes; i++)
+        {
+            pRow[i] = (BYTE)(pRow[i] + ((pRow[i - nBpp] + pPrior[i]) >> 1));
+        }
+        break;
+    case 4:
+        for(i = 0; i < (size_t)nBpp; i++)
+        {
+            pRow[i] = (BYTE)(pRow[i] + pPrior[i]);
+        }
+        for(; i < nRowBytes; i++)
+        {
+            int a = pRow[i - nBpp];
+            int b = pPrior[i];
+            int c = pPrior[i - nBpp];
+            int pa = abs(b - c);
+            int pb = abs(a - c);
+            int pc = abs(a + b - 2 * c);
+            int nPredictor = ((pa <= pb) && (pa <= pc)) ? a : ((pb <= pc) ? b : c);
+            pRow[i] = (BYTE)(pRow[i] + nPredictor);
+        }
+        break;
+    default:
+        return FALSE;
+    }
+    return TRUE;
+}
+
+// sample i of a row of nDepth bit samples, packed from the high bit
+static inline UINT GetSample(const BYTE *pRow, int i, int nDepth)
+{
+    switch(nDepth)
+    {
+    case 8:
+        return pRow[i];
+    case 16:
+        return (pRow[i * 2] << 8) | pRow[i * 2 + 1];
+    default:
+        {
+            int nBit = i * nDepth;
+            return (pRow[nBit >> 3] >> (8 - nDepth - (nBit & 7))) & ((1 << nDepth) - 1);
+        }
+    }
+}
+
+static inline BYTE ScaleSample(UINT nSample, int nDepth)
+{
+    switch(nDepth)
+    {
+    case 8:
+        return (BYTE)nSample;
+    case 16:
+        return (BYTE)(nSample >> 8);
+    default:
+        return (BYTE)(nSample * 255 / ((1 << nDepth) - 1));
+    }
+}
+
+// TRUE if any pixel of the row is not opaque
+static BOOL HasAlphaRow(const BYTE *pRow, int nWidth)
+{
+    for(int x = 0; x < nWidth; x++)
+    {
+        if(0xFF != pRow[x * 4 + 3])
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::GetInfo
+//
+//************************************************************************
+
+HRESULT CLCDImageDecoder::GetInfo(const BYTE *pData, size_t nSize, int &nWidth, int &nHeight,
+                                  eIMAGE_FORMAT *peFormat /* = NULL */)
+{
+    nWidth = nHeight = 0;
+    if(NULL != peFormat)
+    {
+        *peFormat = FORMAT_UNKNOWN;
+    }
+    if((NULL == pData) || (2 > nSize))
+    {
+        return E_INVALIDARG;
+    }
+
+    if(0x89 == pData[0])
+    {
+        PNGINFO Info;
+        HRESULT hRes = ReadPngHeader(pData, nSize, Info);
+        if(SUCCEEDED(hRes))
+        {
+            nWidth = Info.nWidth;
+            nHeight = Info.nHeight;
+            if(NULL != peFormat)
+            {
+                *peFormat = FORMAT_PNG;
+            }
+        }
+        return hRes;
+    }
+
+    if(('B' == pData[0]) && ('M' == pData[1]))
+    {
+        // DecodeBmp() checks the rest of the header
+        if(26 > nSize)
+        {
+            return E_FAIL;
+        }
+        DWORD dwHeaderSize = ReadLE32(pData + 14);
+        LONG lWidth = (12 == dwHeaderSize) ? ReadLE16(pData + 18) : (LONG)ReadLE32(pData + 18);
+        LONG lHeight = (12 == dwHeaderSize) ? ReadLE16(pData + 20) : (LONG)ReadLE32(pData + 22);
+        if((12 != dwHeaderSize) && ((40 > dwHeaderSize) || (14 + 40 > nSize)))
+        {
+            return E_FAIL;
+        }
+        lHeight = abs(lHeight);
+        if((0 >= lWidth) || (0 >= lHeight) || (MAX_DIMENSION < lWidth) || (MAX_DIMENSION < lHeight))
+        {
+            return E_FAIL;
+        }
+        nWidth = (int)lWidth;
+        nHeight = (int)lHeight;
+        if(NULL != peFormat)
+        {
+            *peFormat = FORMAT_BMP;
+        }
+        return S_OK;
+    }
+
+    return E_NOTIMPL;
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::Decode
+//
+//************************************************************************
+
+HRESULT CLCDImageDecoder::Decode(const BYTE *pData, size_t nSize, PBYTE pBits, int nPitch,
+                                 BOOL *pbHasAlpha /* = NULL */)
+{
+    LCDUIASSERT(NULL != pBits);
+    int nWidth = 0;
+    int nHeight = 0;
+    eIMAGE_FORMAT eFormat = FORMAT_UNKNOWN;
+    HRESULT hRes = GetInfo(pData, nSize, nWidth, nHeight, &eFormat);
+    if(FAILED(hRes))
+    {
+        return hRes;
+    }
+    if((NULL == pBits) || (nWidth * 4 > nPitch))
+    {
+        return E_INVALIDARG;
+    }
+
+    BOOL bHasAlpha = FALSE;
+    hRes = (FORMAT_PNG == eFormat) ? DecodePng(pData, nSize, pBits, nPitch, bHasAlpha) :
+                                     DecodeBmp(pData, nSize, pBits, nPitch, bHasAlpha);
+    if(NULL != pbHasAlpha)
+    {
+        *pbHasAlpha = bHasAlpha;
+    }
+    return hRes;
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::Decode
+//
+//************************************************************************
+
+HRESULT CLCDImageDecoder::Decode(const BYTE *pData, size_t nSize, CLCDImage &rImage)
+{
+    rImage.Clear();
+
+    int nWidth = 0;
+    int nHeight = 0;
+    HRESULT hRes = GetInfo(pData, nSize, nWidth, nHeight);
+    if(FAILED(hRes))
+    {
+        return hRes;
+    }
+
+    // straight into the pixels of the image
+    rImage.m_Bits.resize((size_t)nWidth * nHeight * 4);
+    rImage.m_nWidth = nWidth;
+    rImage.m_nHeight = nHeight;
+    hRes = Decode(pData, nSize, &rImage.m_Bits[0], nWidth * 4, &rImage.m_bHasAlpha);
+    if(FAILED(hRes))
+    {
+        rImage.Clear();
+    }
+    return hRes;
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::DecodeBatch
+//
+//************************************************************************
+
+HRESULT CLCDImageDecoder::DecodeBatch(DECODEJOB *pJobs, int nJobs, int nThreads /* = 0 */)
+{
+    if(0 >= nJobs)
+    {
+        return S_OK;
+    }
+    LCDUIASSERT(NULL != pJobs);
+
+    if(0 >= nThreads)
+    {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        nThreads = (int)si.dwNumberOfProcessors;
+    }
+    nThreads = min(nThreads, min(nJobs, MAXIMUM_WAIT_OBJECTS + 1));
+
+    BATCH Batch;
+    Batch.pJobs = pJobs;
+    Batch.nJobs = nJobs;
+    Batch.nNext = 0;
+
+    // the calling thread takes its share, so one thread less is started
+    std::vector<HANDLE> Threads;
+    for(int i = 1; i < nThreads; i++)
+    {
+        HANDLE hThread = CreateThread(NULL, 0, _WorkerThreadProc, &Batch, 0, NULL);
+        if(NULL == hThread)
+        {
+            LCDUITRACE(_T("CLCDImageDecoder::DecodeBatch(): could not start a worker.\n"));
+            break;
+        }
+        Threads.push_back(hThread);
+    }
+
+    RunJobs(Batch);
+
+    if(!Threads.empty())
+    {
+        WaitForMultipleObjects((DWORD)Threads.size(), &Threads[0], TRUE, INFINITE);
+        for(size_t i = 0; i < Threads.size(); i++)
+        {
+            CloseHandle(Threads[i]);
+        }
+    }
+
+    for(int i = 0; i < nJobs; i++)
+    {
+        if(FAILED(pJobs[i].hRes))
+        {
+            return pJobs[i].hRes;
+        }
+    }
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::SwapRedBlueRow
+//
+//************************************************************************
+
+void CLCDImageDecoder::SwapRedBlueRow(PBYTE pDst, const BYTE *pSrc, int nWidth)
+{
+    int x = 0;
+
+#ifdef LCDUI_SSE2
+    const __m128i xmmGreenAlpha = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i xmmLow = _mm_set1_epi32(0x000000FF);
+    for(; x + 4 <= nWidth; x += 4)
+    {
+        __m128i xmmSrc = _mm_loadu_si128((const __m128i *)(pSrc + x * 4));
+        __m128i xmmRedBlue = _mm_andnot_si128(xmmGreenAlpha, xmmSrc);
+        xmmRedBlue = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(xmmRedBlue, xmmLow), 16),
+                                  _mm_srli_epi32(xmmRedBlue, 16));
+        _mm_storeu_si128((__m128i *)(pDst + x * 4),
+            _mm_or_si128(_mm_and_si128(xmmSrc, xmmGreenAlpha), xmmRedBlue));
+    }
+#endif
+
+    for(; x < nWidth; x++)
+    {
+        const BYTE *pS = pSrc + x * 4;
+        PBYTE pD = pDst + x * 4;
+        BYTE byRed = pS[0];
+        pD[0] = pS[2];
+        pD[1] = pS[1];
+        pD[2] = byRed;
+        pD[3] = pS[3];
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::DecodePng
+//
+// Inflates all IDAT chunks at once, then unfilters and converts the rows
+// in place. 8 bit RGBA, the common case, is converted with SIMD.
+//************************************************************************
+
+HRESULT CLCDImageDecoder::DecodePng(const BYTE *pData, size_t nSize, PBYTE pBits, int nPitch,
+                                    BOOL &bHasAlpha)
+{
+    PNGINFO Info;
+    HRESULT hRes = ReadPngHeader(pData, nSize, Info);
+    if(FAILED(hRes))
+    {
+        return hRes;
+    }
+
+    // palette as straight BGRA until the transparency is known
+    DWORD adwPalette[256];
+    PBYTE abyPalette = (PBYTE)adwPalette;
+    for(int i = 0; i < 256; i++)
+    {
+        adwPalette[i] = 0xFF000000;
+    }
+    int nPaletteEntries = 0;
+    BOOL bColorKey = FALSE;
+    UINT anColorKey[3] = { 0, 0, 0 };
+
+    const BYTE *pCompressed = NULL;
+    size_t nCompressed = 0;
+    std::vector<BYTE> Joined;
+
+    size_t nOffset = 8;
+    while(nOffset + 12 <= nSize)
+    {
+        DWORD dwLength = ReadBE32(pData + nOffset);
+        const BYTE *pType = pData + nOffset + 4;
+        const BYTE *pChunk = pData + nOffset + 8;
+        if(dwLength > nSize - nOffset - 12)
+        {
+            return E_FAIL;
+        }
+
+        if(0 == memcmp(pType, "IDAT", 4))
+        {
+            if(NULL == pCompressed)
+            {
+                pCompressed = pChunk;
+                nCompressed = dwLength;
+            }
+            else
+            {
+                // split over several chunks, as most encoders do for large images
+                if(Joined.empty())
+                {
+                    Joined.assign(pCompressed, pCompressed + nCompressed);
+                }
+                Joined.insert(Joined.end(), pChunk, pChunk + dwLength);
+            }
+        }
+        else if(0 == memcmp(pType, "PLTE", 4))
+        {
+            if((0 != dwLength % 3) || (768 < dwLength))
+            {
+                return E_FAIL;
+            }
+            nPaletteEntries = dwLength / 3;
+            for(int i = 0; i < nPaletteEntries; i++)
+            {
+                abyPalette[i * 4 + 0] = pChunk[i * 3 + 2];
+                abyPalette[i * 4 + 1] = pChunk[i * 3 + 1];
+                abyPalette[i * 4 + 2] = pChunk[i * 3 + 0];
+            }
+        }
+        else if(0 == memcmp(pType, "tRNS", 4))
+        {
+            if(3 == Info.nColorType)
+            {
+                for(DWORD i = 0; (i < dwLength) && (i < 256); i++)
+                {
+                    abyPalette[i * 4 + 3] = pChunk[i];
+                }
+            }
+            else if((0 == Info.nColorType) && (2 <= dwLength))
+            {
+                bColorKey = TRUE;
+                anColorKey[0] = anColorKey[1] = anColorKey[2] = (pChunk[0] << 8) | pChunk[1];
+            }
+            else if((2 == Info.nColorType) && (6 <= dwLength))
+            {
+                bColorKey = TRUE;
+                for(int c = 0; c < 3; c++)
+                {
+                    anColorKey[c] = (pChunk[c * 2] << 8) | pChunk[c * 2 + 1];
+                }
+            }
+        }
+        else if(0 == memcmp(pType, "IEND", 4))
+        {
+            break;
+        }
+
+        nOffset += 12 + dwLength;
+    }
+
+    if(!Joined.empty())
+    {
+        pCompressed = &Joined[0];
+        nCompressed = Joined.size();
+    }
+    if((NULL == pCompressed) || ((3 == Info.nColorType) && (0 == nPaletteEntries)))
+    {
+        LCDUITRACE(_T("CLCDImageDecoder::DecodePng(): missing image data or palette.\n"));
+        return E_FAIL;
+    }
+    CLCDCompositor::PremultiplyRow(abyPalette, abyPalette, 256);
+
+    // every row with its filter byte, pass after pass
+    int nPasses = Info.bInterlaced ? 7 : 1;
+    int anPassWidth[7];
+    int anPassHeight[7];
+    size_t nRawSize = 0;
+    for(int nPass = 0; nPass < nPasses; nPass++)
+    {
+        int nX = Info.bInterlaced ? s_abyAdam7[nPass][0] : 0;
+        int nY = Info.bInterlaced ? s_abyAdam7[nPass][1] : 0;
+        int nStepX = Info.bInterlaced ? s_abyAdam7[nPass][2] : 1;
+        int nStepY = Info.bInterlaced ? s_abyAdam7[nPass][3] : 1;
+        anPassWidth[nPass] = (Info.nWidth > nX) ? (Info.nWidth - nX + nStepX - 1) / nStepX : 0;
+        anPassHeight[nPass] = (Info.nHeight > nY) ? (Info.nHeight - nY + nStepY - 1) / nStepY : 0;
+        if((0 != anPassWidth[nPass]) && (0 != anPassHeight[nPass]))
+        {
+            nRawSize += anPassHeight[nPass] * (1 + GetPngRowBytes(Info, anPassWidth[nPass]));
+        }
+    }
+
+    std::vector<BYTE> Raw(nRawSize);
+    if(!Inflate(pCompressed, nCompressed, &Raw[0], nRawSize))
+    {
+        LCDUITRACE(_T("CLCDImageDecoder::DecodePng(): corrupt image data.\n"));
+        return E_FAIL;
+    }
+
+    int nBpp = max(1, Info.nChannels * Info.nDepth / 8);
+    std::vector<BYTE> Prior(GetPngRowBytes(Info, Info.nWidth) + 1, 0);
+    std::vector<BYTE> Pass;
+    if(Info.bInterlaced)
+    {
+        Pass.resize((size_t)Info.nWidth * 4);
+    }
+
+    bHasAlpha = FALSE;
+    PBYTE pRaw = &Raw[0];
+    for(int nPass = 0; nPass < nPasses; nPass++)
+    {
+        int nWidth = anPassWidth[nPass];
+        if((0 == nWidth) || (0 == anPassHeight[nPass]))
+        {
+            continue;
+        }
+        size_t nRowBytes = GetPngRowBytes(Info, nWidth);
+        const BYTE *pPrior = &Prior[0];
+
+        for(int nRow = 0; nRow < anPassHeight[nPass]; nRow++)
+        {
+            PBYTE pRow = pRaw + 1;
+            if(!UnfilterRow(pRow, pPrior, nRowBytes, nBpp, pRaw[0]))
+            {
+                return E_FAIL;
+            }
+            pPrior = pRow;
+            pRaw += 1 + nRowBytes;
+
+            int y = Info.bInterlaced ? s_abyAdam7[nPass][1] + nRow * s_abyAdam7[nPass][3] : nRow;
+            PBYTE pDst = Info.bInterlaced ? &Pass[0] : pBits + y * nPitch;
+
+            if((6 == Info.nColorType) && (8 == Info.nDepth))
+            {
+                SwapRedBlueRow(pDst, pRow, nWidth);
+                CLCDCompositor::PremultiplyRow(pDst, pDst, nWidth);
+            }
+            else if(3 == Info.nColorType)
+            {
+                for(int x = 0; x < nWidth; x++)
+                {
+                    ((DWORD *)pDst)[x] = adwPalette[GetSample(pRow, x, Info.nDepth)];
+                }
+            }
+            else
+            {
+                // gray, gray with alpha, RGB, and 16 bit RGBA
+                BOOL bGray = (0 == Info.nColorType) || (4 == Info.nColorType);
+                BOOL bAlpha = (4 == Info.nColorType) || (6 == Info.nColorType);
+                int nColors = bGray ? 1 : 3;
+                for(int x = 0; x < nWidth; x++)
+                {
+                    UINT anSample[4];
+                    for(int c = 0; c < Info.nChannels; c++)
+                    {
+                        anSample[c] = GetSample(pRow, x * Info.nChannels + c, Info.nDepth);
+                    }
+                    PBYTE pPixel = pDst + x * 4;
+                    pPixel[2] = ScaleSample(anSample[0], Info.nDepth);
+                    pPixel[1] = ScaleSample(anSample[bGray ? 0 : 1], Info.nDepth);
+                    pPixel[0] = ScaleSample(anSample[bGray ? 0 : 2], Info.nDepth);
+                    pPixel[3] = bAlpha ? ScaleSample(anSample[nColors], Info.nDepth) : 0xFF;
+                    if(bColorKey && (anSample[0] == anColorKey[0]) &&
+                       (bGray || ((anSample[1] == anColorKey[1]) && (anSample[2] == anColorKey[2]))))
+                    {
+                        pPixel[3] = 0;
+                    }
+                }
+                CLCDCompositor::PremultiplyRow(pDst, pDst, nWidth);
+            }
+
+            bHasAlpha = bHasAlpha || HasAlphaRow(pDst, nWidth);
+
+            if(Info.bInterlaced)
+            {
+                const DWORD *pSrc = (const DWORD *)&Pass[0];
+                DWORD *pLine = (DWORD *)(pBits + y * nPitch);
+                int nStepX = s_abyAdam7[nPass][2];
+                for(int x = 0, nX = s_abyAdam7[nPass][0]; x < nWidth; x++, nX += nStepX)
+                {
+                    pLine[nX] = pSrc[x];
+                }
+            }
+        }
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::DecodeBmp
+//
+// Uncompressed bitmaps of 1 to 32 bits, with or without bit fields. The
+// alpha channel of 32bpp bitmaps is used if any pixel sets it.
+//************************************************************************
+
+HRESULT CLCDImageDecoder::DecodeBmp(const BYTE *pData, size_t nSize, PBYTE pBits, int nPitch,
+                                    BOOL &bHasAlpha)
+{
+    int nWidth = 0;
+    int nHeight = 0;
+    HRESULT hRes = GetInfo(pData, nSize, nWidth, nHeight);
+    if(FAILED(hRes))
+    {
+        return hRes;
+    }
+
+    DWORD dwBitsOffset = ReadLE32(pData + 10);
+    DWORD dwHeaderSize = ReadLE32(pData + 14);
+    BOOL bCore = (12 == dwHeaderSize);
+    BOOL bTopDown = !bCore && (0 > (LONG)ReadLE32(pData + 22));
+    int nBitCount = ReadLE16(pData + (bCore ? 24 : 28));
+    DWORD dwCompression = bCore ? BI_RGB : ReadLE32(pData + 30);
+    DWORD dwColorsUsed = bCore ? 0 : ReadLE32(pData + 46);
+    // written so that a huge header size cannot wrap around
+    if((14 > nSize) || (dwHeaderSize > nSize - 14))
+    {
+        return E_FAIL;
+    }
+
+    // BI_ALPHABITFIELDS is not declared by all SDKs
+    BOOL bBitFields = (BI_BITFIELDS == dwCompression) || (6 == dwCompression);
+    BOOL bSupported = FALSE;
+    switch(nBitCount)
+    {
+    case 1:
+    case 4:
+    case 8:
+    case 24:
+        bSupported = (BI_RGB == dwCompression);
+        break;
+    case 16:
+    case 32:
+        bSupported = (BI_RGB == dwCompression) || bBitFields;
+        break;
+    }
+    if(!bSupported)
+    {
+        return E_NOTIMPL;
+    }
+
+    DWORD adwMasks[4] = { 0, 0, 0, 0 };
+    size_t nPaletteOffset = 14 + dwHeaderSize;
+    if(bBitFields)
+    {
+        // after a BITMAPINFOHEADER, within the later headers
+        int nMasks = ((6 == dwCompression) || (56 <= dwHeaderSize)) ? 4 : 3;
+        if(14 + 40 + nMasks * 4 > nSize)
+        {
+            return E_FAIL;
+        }
+        for(int i = 0; i < nMasks; i++)
+        {
+            adwMasks[i] = ReadLE32(pData + 14 + 40 + i * 4);
+        }
+        if(40 == dwHeaderSize)
+        {
+            nPaletteOffset += nMasks * 4;
+        }
+    }
+    else if(16 == nBitCount)
+    {
+        adwMasks[0] = 0x7C00;
+        adwMasks[1] = 0x03E0;
+        adwMasks[2] = 0x001F;
+    }
+    else if(32 == nBitCount)
+    {
+        adwMasks[0] = 0x00FF0000;
+        adwMasks[1] = 0x0000FF00;
+        adwMasks[2] = 0x000000FF;
+    }
+
+    size_t nStride = (((size_t)nWidth * nBitCount + 31) / 32) * 4;
+    if((dwBitsOffset > nSize) || (nStride * nHeight > nSize - dwBitsOffset))
+    {
+        return E_FAIL;
+    }
+    const BYTE *pSrcBits = pData + dwBitsOffset;
+
+    // palettes become opaque BGRA
+    DWORD adwPalette[256];
+    if(8 >= nBitCount)
+    {
+        int nEntrySize = bCore ? 3 : 4;
+        size_t nEntries = (0 != dwColorsUsed) ? min(dwColorsUsed, (DWORD)256) : ((size_t)1 << nBitCount);
+        if(nPaletteOffset <= nSize)
+        {
+            nEntries = min(nEntries, (nSize - nPaletteOffset) / nEntrySize);
+        }
+        else
+        {
+            nEntries = 0;
+        }
+        for(size_t i = 0; i < 256; i++)
+        {
+            adwPalette[i] = 0xFF000000;
+            if(i < nEntries)
+            {
+                const BYTE *pEntry = pData + nPaletteOffset + i * nEntrySize;
+                adwPalette[i] |= pEntry[0] | (pEntry[1] << 8) | (pEntry[2] << 16);
+            }
+        }
+    }
+
+    // plain BI_RGB leaves the fourth byte undefined, it is only taken as
+    // alpha when some pixel sets it
+    if((32 == nBitCount) && (BI_RGB == dwCompression))
+    {
+        for(int y = 0; (y < nHeight) && (0 == adwMasks[3]); y++)
+        {
+            const BYTE *pRow = pSrcBits + y * nStride;
+            for(int x = 0; x < nWidth; x++)
+            {
+                if(0 != pRow[x * 4 + 3])
+                {
+                    adwMasks[3] = 0xFF000000;
+                    break;
+                }
+            }
+        }
+    }
+
+    // bit field positions and widths
+    int anShift[4];
+    int anBits[4];
+    for(int c = 0; c < 4; c++)
+    {
+        anShift[c] = 0;
+        anBits[c] = 0;
+        DWORD dwMask = adwMasks[c];
+        while((0 != dwMask) && (0 == (dwMask & 1)))
+        {
+            dwMask >>= 1;
+            anShift[c]++;
+        }
+        while(0 != (dwMask & 1))
+        {
+            dwMask >>= 1;
+            anBits[c]++;
+        }
+    }
+    BOOL bStandard32 = (32 == nBitCount) && (0x00FF0000 == adwMasks[0]) &&
+                       (0x0000FF00 == adwMasks[1]) && (0x000000FF == adwMasks[2]) &&
+                       ((0 == adwMasks[3]) || (0xFF000000 == adwMasks[3]));
+
+    bHasAlpha = FALSE;
+    for(int y = 0; y < nHeight; y++)
+    {
+        const BYTE *pRow = pSrcBits + (bTopDown ? y : nHeight - 1 - y) * nStride;
+        DWORD *pDst = (DWORD *)(pBits + y * nPitch);
+
+        if(8 >= nBitCount)
+        {
+            for(int x = 0; x < nWidth; x++)
+            {
+                pDst[x] = adwPalette[GetSample(pRow, x, nBitCount)];
+            }
+        }
+        else if(24 == nBitCount)
+        {
+            for(int x = 0; x < nWidth; x++)
+            {
+                const BYTE *pPixel = pRow + x * 3;
+                pDst[x] = 0xFF000000 | pPixel[0] | (pPixel[1] << 8) | (pPixel[2] << 16);
+            }
+        }
+        else if(bStandard32)
+        {
+            memcpy(pDst, pRow, nWidth * 4);
+            if(0 == adwMasks[3])
+            {
+                for(int x = 0; x < nWidth; x++)
+                {
+                    pDst[x] |= 0xFF000000;
+                }
+            }
+        }
+        else
+        {
+            for(int x = 0; x < nWidth; x++)
+            {
+                DWORD dwPixel = (16 == nBitCount) ? ReadLE16(pRow + x * 2) : ReadLE32(pRow + x * 4);
+                BYTE abyChannels[4];
+                for(int c = 0; c < 4; c++)
+                {
+                    if(0 == anBits[c])
+                    {
+                        abyChannels[c] = (BYTE)((3 == c) ? 0xFF : 0);
+                        continue;
+                    }
+                    UINT nValue = (dwPixel & adwMasks[c]) >> anShift[c];
+                    abyChannels[c] = (BYTE)((8 <= anBits[c]) ? (nValue >> (anBits[c] - 8)) :
+                                                               (nValue * 255 / ((1 << anBits[c]) - 1)));
+                }
+                pDst[x] = abyChannels[2] | (abyChannels[1] << 8) | (abyChannels[0] << 16) |
+                          ((DWORD)abyChannels[3] << 24);
+            }
+        }
+
+        if(HasAlphaRow((const BYTE *)pDst, nWidth))
+        {
+            bHasAlpha = TRUE;
+            CLCDCompositor::PremultiplyRow((PBYTE)pDst, (const BYTE *)pDst, nWidth);
+        }
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::RunJobs
+//
+//************************************************************************
+
+void CLCDImageDecoder::RunJobs(BATCH &rBatch)
+{
+    for(;;)
+    {
+        LONG nJob = InterlockedIncrement(&rBatch.nNext) - 1;
+        if(nJob >= rBatch.nJobs)
+        {
+            break;
+        }
+
+        DECODEJOB &rJob = rBatch.pJobs[nJob];
+        rJob.bHasAlpha = FALSE;
+        if(NULL != rJob.pImage)
+        {
+            rJob.hRes = Decode(rJob.pData, rJob.nSize, *rJob.pImage);
+            rJob.bHasAlpha = SUCCEEDED(rJob.hRes) && rJob.pImage->HasAlpha();
+        }
+        else
+        {
+            rJob.hRes = Decode(rJob.pData, rJob.nSize, rJob.pBits, rJob.nPitch, &rJob.bHasAlpha);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDImageDecoder::_WorkerThreadProc
+//
+//************************************************************************
+
+DWORD WINAPI CLCDImageDecoder::_WorkerThreadProc(LPVOID pContext)
+{
+    RunJobs(*(BATCH *)pContext);
+    return 0;
+}
+
+
+//** end of LCDImageDecoder.cpp ******************************************
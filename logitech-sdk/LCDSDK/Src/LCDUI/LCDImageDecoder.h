@@ -0,0 +1,80 @@
+//************************************************************************
+//
+// LCDImageDecoder.h
+//
+// The CLCDImageDecoder class decodes PNG and BMP files straight into
+// premultiplied 32bpp BGRA pixels, the format of CLCDImage and of the
+// 32bpp DIB sections drawn with AlphaBlend(), without GDI+.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDIMAGEDECODER_H_INCLUDED_
+#define _LCDIMAGEDECODER_H_INCLUDED_
+
+#include "LCDCompositor.h"
+
+class CLCDImageDecoder
+{
+public:
+    enum eIMAGE_FORMAT { FORMAT_UNKNOWN, FORMAT_PNG, FORMAT_BMP };
+
+    // larger images are refused
+    enum { MAX_DIMENSION = 16384 };
+
+    // Reads the size from the header. Returns E_NOTIMPL for formats and
+    // variants that are not handled (JPEG, GIF, RLE bitmaps), which GDI+
+    // can still load, and E_FAIL for broken data.
+    static HRESULT GetInfo(const BYTE *pData, size_t nSize, int &nWidth, int &nHeight,
+                           eIMAGE_FORMAT *peFormat = NULL);
+
+    // Decodes into nWidth x nHeight premultiplied pixels, top row first.
+    // pbHasAlpha receives whether any pixel is not opaque.
+    static HRESULT Decode(const BYTE *pData, size_t nSize, PBYTE pBits, int nPitch,
+                          BOOL *pbHasAlpha = NULL);
+    static HRESULT Decode(const BYTE *pData, size_t nSize, CLCDImage &rImage);
+
+    // One image of a batch. The destination is either pBits, sized by the
+    // caller with GetInfo(), or pImage.
+    struct DECODEJOB
+    {
+        const BYTE *pData;
+        size_t nSize;
+        PBYTE pBits;
+        int nPitch;
+        CLCDImage *pImage;
+        // results
+        HRESULT hRes;
+        BOOL bHasAlpha;
+    };
+
+    // Decodes the jobs on nThreads threads, the calling one included, or
+    // on all processors for 0. Returns the first failure, each job holds
+    // its own result.
+    static HRESULT DecodeBatch(DECODEJOB *pJobs, int nJobs, int nThreads = 0);
+
+    // RGBA to BGRA, pDst may be pSrc
+    static void SwapRedBlueRow(PBYTE pDst, const BYTE *pSrc, int nWidth);
+
+protected:
+    struct BATCH
+    {
+        DECODEJOB *pJobs;
+        int nJobs;
+        volatile LONG nNext;
+    };
+
+    static HRESULT DecodePng(const BYTE *pData, size_t nSize, PBYTE pBits, int nPitch,
+                             BOOL &bHasAlpha);
+    static HRESULT DecodeBmp(const BYTE *pData, size_t nSize, PBYTE pBits, int nPitch,
+                             BOOL &bHasAlpha);
+    static void RunJobs(BATCH &rBatch);
+    static DWORD WINAPI _WorkerThreadProc(LPVOID pContext);
+};
+
+
+#endif // !_LCDIMAGEDECODER_H_INCLUDED_
+
+//** end of LCDImageDecoder.h ********************************************
@@ -0,0 +1,557 @@
+//************************************************************************
+//
+// LCDLogView.cpp
+//
+// The CLCDLogView class shows a log of events, newest at the bottom.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDLogView::CLCDLogView
+//
+//************************************************************************
+
+CLCDLogView::CLCDLogView(void)
+:   m_nFirst(0),
+    m_nCount(0),
+    m_nScrollBack(0),
+    m_hFont(NULL),
+    m_nLineHeight(0)
+{
+    InitializeCriticalSection(&m_csLines);
+    m_Lines.resize(DEFAULT_CAPACITY);
+    SetBackgroundMode(TRANSPARENT);
+    Initialize();
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::~CLCDLogView
+//
+//************************************************************************
+
+CLCDLogView::~CLCDLogView(void)
+{
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    m_hFont = NULL;
+    DeleteCriticalSection(&m_csLines);
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDLogView::Initialize(void)
+{
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    m_hFont = (HFONT) GetStockObject(DEFAULT_GUI_FONT);
+    if(NULL != m_hFont)
+    {
+        SetFontPointSize(DEFAULT_POINTSIZE);
+    }
+    SetForegroundColor(RGB(255, 255, 255));
+    return (NULL != m_hFont) ? S_OK : E_OUTOFMEMORY;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::SetCapacity
+//
+//************************************************************************
+
+HRESULT CLCDLogView::SetCapacity(int nLines)
+{
+    if(0 >= nLines)
+    {
+        LCDUITRACE(_T("CLCDLogView::SetCapacity(): invalid capacity %d.\n"), nLines);
+        return E_INVALIDARG;
+    }
+
+    EnterCriticalSection(&m_csLines);
+    m_Lines.clear();
+    m_Lines.resize(nLines);
+    m_nFirst = 0;
+    m_nCount = 0;
+    m_nScrollBack = 0;
+    LeaveCriticalSection(&m_csLines);
+
+    Invalidate();
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::GetCapacity
+//
+//************************************************************************
+
+int CLCDLogView::GetCapacity(void)
+{
+    return (int)m_Lines.size();
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::AddLine
+//
+//************************************************************************
+
+void CLCDLogView::AddLine(LPCTSTR szText)
+{
+    AddLine(szText, m_crForegroundColor);
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::AddLine
+//
+// Breaks the event the way a CLCDText with word wrap would, and copies
+// its lines into the ring
+//
+//************************************************************************
+
+void CLCDLogView::AddLine(LPCTSTR szText, COLORREF crColor)
+{
+    LCDUIASSERT(NULL != szText);
+    if(NULL == szText)
+    {
+        return;
+    }
+
+    int nLength = (int)_tcslen(szText);
+    int nWidth = GetWidth();
+    UINT nFormat = DT_LEFT | DT_NOPREFIX | ((0 < nWidth) ? DT_WORDBREAK : 0);
+    DRAWTEXTPARAMS dtp;
+    ZeroMemory(&dtp, sizeof(dtp));
+    dtp.cbSize = sizeof(dtp);
+
+    EnterCriticalSection(&m_csLines);
+
+    m_LineStarts.clear();
+    CLCDTextLayout::GetInstance().ExtendLineStarts(m_hFont, szText, nLength, nWidth, nFormat, dtp, m_LineStarts);
+
+    // of an event longer than the log, only the end is kept
+    int nLines = (int)m_LineStarts.size();
+    int nFirstLine = max(0, nLines - (int)m_Lines.size());
+    for(int i = nFirstLine; i < nLines; i++)
+    {
+        int nStart = m_LineStarts[i];
+        int nEnd = (i + 1 < nLines) ? m_LineStarts[i + 1] : nLength;
+
+        // without the line break or the blanks the line ends with
+        while((nEnd > nStart) &&
+            ((_T('\r') == szText[nEnd - 1]) || (_T('\n') == szText[nEnd - 1]) || (_T(' ') == szText[nEnd - 1])))
+        {
+            nEnd--;
+        }
+
+        LINE &rLine = PushLine();
+        rLine.nLength = min(nEnd - nStart, (int)MAX_LINE_LENGTH);
+        memcpy(rLine.szText, szText + nStart, rLine.nLength * sizeof(TCHAR));
+        rLine.crColor = crColor;
+    }
+
+    if(0 < m_nScrollBack)
+    {
+        m_nScrollBack = min(m_nScrollBack + nLines - nFirstLine, m_nCount - 1);
+    }
+
+    LeaveCriticalSection(&m_csLines);
+
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::Clear
+//
+//************************************************************************
+
+void CLCDLogView::Clear(void)
+{
+    EnterCriticalSection(&m_csLines);
+    m_nFirst = 0;
+    m_nCount = 0;
+    m_nScrollBack = 0;
+    LeaveCriticalSection(&m_csLines);
+
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::GetLineCount
+//
+//************************************************************************
+
+int CLCDLogView::GetLineCount(void)
+{
+    EnterCriticalSection(&m_csLines);
+    int nCount = m_nCount;
+    LeaveCriticalSection(&m_csLines);
+    return nCount;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::SetScrollBack
+//
+//************************************************************************
+
+void CLCDLogView::SetScrollBack(int nLines)
+{
+    EnterCriticalSection(&m_csLines);
+    m_nScrollBack = max(0, min(nLines, m_nCount - 1));
+    LeaveCriticalSection(&m_csLines);
+
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::GetScrollBack
+//
+//************************************************************************
+
+int CLCDLogView::GetScrollBack(void)
+{
+    EnterCriticalSection(&m_csLines);
+    int nScrollBack = m_nScrollBack;
+    LeaveCriticalSection(&m_csLines);
+    return nScrollBack;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::SetFont
+//
+//************************************************************************
+
+void CLCDLogView::SetFont(LOGFONT& lf)
+{
+    HFONT hFont = CLCDFontRegistry::GetInstance().Acquire(lf);
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    if (hFont == m_hFont)
+    {
+        return;
+    }
+
+    m_hFont = hFont;
+    m_nLineHeight = 0;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::GetFont
+//
+//************************************************************************
+
+HFONT CLCDLogView::GetFont(void)
+{
+    return m_hFont;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::SetFontFaceName
+//
+//************************************************************************
+
+void CLCDLogView::SetFontFaceName(LPCTSTR szFontName)
+{
+    // if NULL, uses the default gui font
+    if (NULL == szFontName)
+    {
+        return;
+    }
+
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    LCDUI_tcsncpy(lf.lfFaceName, szFontName, LF_FACESIZE);
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::SetFontPointSize
+//
+//************************************************************************
+
+void CLCDLogView::SetFontPointSize(int nPointSize)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    lf.lfHeight = -MulDiv(nPointSize, DEFAULT_DPI, 72);
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::SetFontWeight
+//
+//************************************************************************
+
+void CLCDLogView::SetFontWeight(int nWeight)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    lf.lfWeight = nWeight;
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::SetFontColor
+//
+// The color of lines added without one
+//
+//************************************************************************
+
+void CLCDLogView::SetFontColor(COLORREF color)
+{
+    SetForegroundColor(color);
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::OnPrepareDraw
+//
+// Measures the line height before drawing, so that OnDraw() only reads
+//
+//************************************************************************
+
+void CLCDLogView::OnPrepareDraw(CLCDGfxBase &rGfx)
+{
+    if(NULL == rGfx.GetSoftSurface())
+    {
+        GetLineHeight();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::OnDraw
+//
+//************************************************************************
+
+void CLCDLogView::OnDraw(CLCDGfxBase &rGfx)
+{
+    RECT rcAll = { 0, 0, GetWidth(), GetHeight() };
+    CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+
+    if (GetBackgroundMode() == OPAQUE)
+    {
+        if(NULL != pSoft)
+        {
+            pSoft->FillRect(rcAll, m_crBackgroundColor);
+        }
+        else
+        {
+            HBRUSH hBackBrush = CreateSolidBrush(m_crBackgroundColor);
+            FillRect(rGfx.GetHDC(), &rcAll, hBackBrush);
+            DeleteObject(hBackBrush);
+        }
+    }
+
+    if (!IsVisible())
+    {
+        return;
+    }
+
+    if(NULL != pSoft)
+    {
+        DrawSoftLines(*pSoft);
+        if (m_bInverted)
+        {
+            pSoft->InvertRect(rcAll);
+        }
+    }
+    else
+    {
+        DrawLines(rGfx);
+        if (m_bInverted)
+        {
+            InvertRect(rGfx.GetHDC(), &rcAll);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::IsTileSafe
+//
+//************************************************************************
+
+BOOL CLCDLogView::IsTileSafe(void)
+{
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::PushLine
+//
+// The next line of the ring, the oldest one once the ring is full. The
+// lines must be locked.
+//
+//************************************************************************
+
+CLCDLogView::LINE &CLCDLogView::PushLine(void)
+{
+    int nCapacity = (int)m_Lines.size();
+    if(m_nCount < nCapacity)
+    {
+        return m_Lines[(m_nFirst + m_nCount++) % nCapacity];
+    }
+
+    LINE &rLine = m_Lines[m_nFirst];
+    m_nFirst = (m_nFirst + 1) % nCapacity;
+    return rLine;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::GetLineHeight
+//
+//************************************************************************
+
+int CLCDLogView::GetLineHeight(void)
+{
+    if(0 == m_nLineHeight)
+    {
+        DRAWTEXTPARAMS dtp;
+        ZeroMemory(&dtp, sizeof(dtp));
+        dtp.cbSize = sizeof(dtp);
+
+        // the height of one line of text, whatever the text
+        m_nLineHeight = CLCDTextLayout::GetInstance().GetExtent(NULL, m_hFont, _T(" "), 1,
+            max(1, GetWidth()), max(1, GetHeight()), DT_LEFT | DT_NOPREFIX | DT_SINGLELINE, dtp).cy;
+    }
+    return m_nLineHeight;
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::DrawLines
+//
+// From the newest visible line up, until the top is reached
+//
+//************************************************************************
+
+void CLCDLogView::DrawLines(CLCDGfxBase &rGfx)
+{
+    int nLineHeight = GetLineHeight();
+    if(0 >= nLineHeight)
+    {
+        return;
+    }
+
+    HDC hDC = rGfx.GetHDC();
+    int nOldMapMode = SetMapMode(hDC, MM_TEXT);
+    int nOldBkMode = SetBkMode(hDC, TRANSPARENT);
+    HFONT hOldFont = (HFONT)SelectObject(hDC, m_hFont);
+    COLORREF crOldTextColor = SetTextColor(hDC, m_crForegroundColor);
+
+    UINT nFormat = DT_LEFT | DT_NOPREFIX | DT_SINGLELINE;
+    DRAWTEXTPARAMS dtp;
+    ZeroMemory(&dtp, sizeof(dtp));
+    dtp.cbSize = sizeof(dtp);
+
+    EnterCriticalSection(&m_csLines);
+
+    int nCapacity = (int)m_Lines.size();
+    int nY = GetHeight();
+    for(int i = m_nCount - 1 - m_nScrollBack; (0 <= i) && (0 < nY); i--)
+    {
+        nY -= nLineHeight;
+
+        const LINE &rLine = m_Lines[(m_nFirst + i) % nCapacity];
+        RECT rcLine = { 0, nY, GetWidth(), nY + nLineHeight };
+        if(!CLCDGlyphCache::GetInstance().DrawText(rGfx, m_hFont, rLine.szText, rLine.nLength,
+                rcLine, nFormat, dtp, rLine.crColor))
+        {
+            SetTextColor(hDC, rLine.crColor);
+            DrawTextEx(hDC, (LPTSTR)rLine.szText, rLine.nLength, &rcLine, nFormat, &dtp);
+        }
+    }
+
+    LeaveCriticalSection(&m_csLines);
+
+    SetMapMode(hDC, nOldMapMode);
+    SetBkMode(hDC, nOldBkMode);
+    SelectObject(hDC, hOldFont);
+    SetTextColor(hDC, crOldTextColor);
+}
+
+
+//************************************************************************
+//
+// CLCDLogView::DrawSoftLines
+//
+// Soft surfaces draw with their own font, see CLCDText. The lines keep
+// the breaks measured with the GDI font.
+//
+//************************************************************************
+
+void CLCDLogView::DrawSoftLines(CLCDGfxSoft &rSoft)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+    int nScale = CLCDGfxSoft::GetScaleForFontHeight(lf.lfHeight);
+    int nLineHeight = CLCDGfxSoft::GLYPH_LINEHEIGHT * nScale;
+
+    EnterCriticalSection(&m_csLines);
+
+    int nCapacity = (int)m_Lines.size();
+    int nY = GetHeight();
+    for(int i = m_nCount - 1 - m_nScrollBack; (0 <= i) && (0 < nY); i--)
+    {
+        nY -= nLineHeight;
+
+        const LINE &rLine = m_Lines[(m_nFirst + i) % nCapacity];
+        rSoft.DrawText(0, nY, rLine.szText, rLine.nLength, rLine.crColor, nScale);
+    }
+
+    LeaveCriticalSection(&m_csLines);
+}
+
+
+//** end of LCDLogView.cpp ***********************************************
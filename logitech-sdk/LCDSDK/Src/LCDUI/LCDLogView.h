@@ -0,0 +1,93 @@
+//************************************************************************
+//
+// LCDLogView.h
+//
+// The CLCDLogView class shows a log of events, newest at the bottom.
+// Events are broken into lines when they are added, and the lines are
+// kept in a ring of fixed size: adding costs the length of the event,
+// drawing costs the lines that are visible, and the memory used does
+// not depend on how many events came.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDLOGVIEW_H_INCLUDED_
+#define _LCDLOGVIEW_H_INCLUDED_
+
+#include "LCDBase.h"
+
+class CLCDLogView : public CLCDBase
+{
+public:
+    CLCDLogView(void);
+    virtual ~CLCDLogView(void);
+
+    // CLCDBase
+    virtual HRESULT Initialize(void);
+    virtual void OnPrepareDraw(CLCDGfxBase &rGfx);
+    virtual void OnDraw(CLCDGfxBase &rGfx);
+    virtual BOOL IsTileSafe(void);
+
+    // Number of lines kept; the oldest are dropped beyond it. Clears the
+    // log.
+    HRESULT SetCapacity(int nLines);
+    int GetCapacity(void);
+
+    // Adds an event, wrapped to the current width. Lines keep the breaks
+    // they were added with, and are cut at MAX_LINE_LENGTH characters.
+    // May be called from any thread.
+    void AddLine(LPCTSTR szText);
+    void AddLine(LPCTSTR szText, COLORREF crColor);
+    void Clear(void);
+    int GetLineCount(void);
+
+    // Lines scrolled back from the newest one. While scrolled back, new
+    // lines do not move the view.
+    void SetScrollBack(int nLines);
+    int GetScrollBack(void);
+
+    void SetFont(LOGFONT& lf);
+    void SetFontFaceName(LPCTSTR szFontName);
+    void SetFontPointSize(int nPointSize);
+    void SetFontWeight(int nWeight);
+    void SetFontColor(COLORREF color);
+    HFONT GetFont(void);
+
+    enum { DEFAULT_DPI = 96, DEFAULT_POINTSIZE = 8 };
+    enum { DEFAULT_CAPACITY = 128, MAX_LINE_LENGTH = 128 };
+
+protected:
+    struct LINE
+    {
+        TCHAR szText[MAX_LINE_LENGTH];
+        int nLength;
+        COLORREF crColor;
+    };
+
+    LINE &PushLine(void);
+    int GetLineHeight(void);
+    void DrawLines(CLCDGfxBase &rGfx);
+    void DrawSoftLines(CLCDGfxSoft &rSoft);
+
+protected:
+    // m_nCount lines from m_nFirst on, wrapping around
+    std::vector<LINE> m_Lines;
+    int m_nFirst;
+    int m_nCount;
+    int m_nScrollBack;
+
+    // where the event being added breaks, kept to avoid allocations
+    std::vector<int> m_LineStarts;
+
+    HFONT m_hFont;
+    // 0 until measured for the font
+    int m_nLineHeight;
+
+    CRITICAL_SECTION m_csLines;
+};
+
+#endif // !_LCDLOGVIEW_H_INCLUDED_
+
+//** end of LCDLogView.h *************************************************
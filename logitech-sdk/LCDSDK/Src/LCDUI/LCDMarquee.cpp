@@ -0,0 +1,545 @@
+//************************************************************************
+//
+// LCDMarquee.cpp
+//
+// The CLCDMarquee class renders the text of a scrolling control once
+// into an off-screen strip.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDMarquee::CLCDMarquee
+//
+//************************************************************************
+
+CLCDMarquee::CLCDMarquee(void)
+:   m_nGapWidth(0),
+    m_hFont(NULL),
+    m_nFormat(DT_LEFT | DT_NOPREFIX),
+    m_nWrapWidth(0),
+    m_bRepeat(FALSE),
+    m_nStripWidth(0),
+    m_nStripHeight(0),
+    m_bMeasured(FALSE),
+    m_bRendered(FALSE),
+    m_bRenderedMono(FALSE),
+    m_bStripValid(FALSE)
+{
+    m_sizeText.cx = m_sizeText.cy = 0;
+    m_sizeGap.cx = m_sizeGap.cy = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::~CLCDMarquee
+//
+//************************************************************************
+
+CLCDMarquee::~CLCDMarquee(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::SetText
+//
+//************************************************************************
+
+void CLCDMarquee::SetText(LPCTSTR szText, int nLength)
+{
+    if((NULL == szText) || (0 > nLength))
+    {
+        nLength = 0;
+    }
+    if(((int)m_sText.size() != nLength) || (0 != m_sText.compare(0, nLength, szText, nLength)))
+    {
+        m_sText.assign(szText, nLength);
+        m_bMeasured = m_bRendered = FALSE;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::SetGap
+//
+//************************************************************************
+
+void CLCDMarquee::SetGap(LPCTSTR szGapText, int nGapWidth)
+{
+    if(NULL == szGapText)
+    {
+        szGapText = _T("");
+    }
+    if(_tcscmp(m_sGapText.c_str(), szGapText) || (m_nGapWidth != nGapWidth))
+    {
+        m_sGapText.assign(szGapText);
+        m_nGapWidth = max(0, nGapWidth);
+        m_bMeasured = m_bRendered = FALSE;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::SetFont
+//
+//************************************************************************
+
+void CLCDMarquee::SetFont(HFONT hFont)
+{
+    if(m_hFont != hFont)
+    {
+        m_hFont = hFont;
+        m_bMeasured = m_bRendered = FALSE;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::SetFormat
+//
+//************************************************************************
+
+void CLCDMarquee::SetFormat(UINT nFormat)
+{
+    if(m_nFormat != nFormat)
+    {
+        m_nFormat = nFormat;
+        m_bMeasured = m_bRendered = FALSE;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::SetWrapWidth
+//
+//************************************************************************
+
+void CLCDMarquee::SetWrapWidth(int nWrapWidth)
+{
+    if(m_nWrapWidth != nWrapWidth)
+    {
+        m_nWrapWidth = max(0, nWrapWidth);
+        m_bMeasured = m_bRendered = FALSE;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::EnableRepeat
+//
+//************************************************************************
+
+void CLCDMarquee::EnableRepeat(BOOL bRepeat)
+{
+    m_bRepeat = bRepeat;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::IsRepeating
+//
+//************************************************************************
+
+BOOL CLCDMarquee::IsRepeating(void)
+{
+    return m_bRepeat;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::GetTextExtent
+//
+//************************************************************************
+
+SIZE CLCDMarquee::GetTextExtent(void)
+{
+    if(!m_bMeasured)
+    {
+        Measure();
+    }
+    return m_sizeText;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::GetPeriod
+//
+//************************************************************************
+
+int CLCDMarquee::GetPeriod(void)
+{
+    if(!m_bMeasured)
+    {
+        Measure();
+    }
+    return m_nStripWidth;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::Draw
+//
+//************************************************************************
+
+BOOL CLCDMarquee::Draw(CLCDGfxBase &rGfx, const RECT &rcBoundary, int nOffset, COLORREF crColor)
+{
+    // the strip is blended into 8 or 32bpp pixels
+    int nBitCount = rGfx.GetBitCount();
+    if((8 != nBitCount) && (32 != nBitCount))
+    {
+        return FALSE;
+    }
+
+    BOOL bMono = (8 == nBitCount);
+    Prepare(rGfx);
+    if(!m_bStripValid)
+    {
+        return FALSE;
+    }
+    if(m_sText.empty())
+    {
+        return TRUE;
+    }
+
+    POINT ptOffset;
+    RECT rcClip;
+    if(!rGfx.GetDirectTarget(ptOffset, rcClip))
+    {
+        return FALSE;
+    }
+
+    RECT rcBoundarySurface = rcBoundary;
+    OffsetRect(&rcBoundarySurface, ptOffset.x, ptOffset.y);
+    IntersectRect(&rcClip, &rcClip, &rcBoundarySurface);
+    if(IsRectEmpty(&rcClip))
+    {
+        return TRUE;
+    }
+
+    BYTE byMono = (BYTE)((77 * GetRValue(crColor) + 150 * GetGValue(crColor) +
+        29 * GetBValue(crColor) >= 128 * 256) ? 255 : 0);
+
+    int nBoxWidth = rcBoundary.right - rcBoundary.left;
+    int nBoxHeight = rcBoundary.bottom - rcBoundary.top;
+    int nX = rcBoundary.left;
+    int nY = rcBoundary.top;
+
+    if(0 < m_nWrapWidth)
+    {
+        DrawStrip(rGfx, rcClip, nX + ptOffset.x, nY - nOffset + ptOffset.y, m_sizeText.cx,
+            bMono, byMono, crColor);
+        return TRUE;
+    }
+
+    if(m_nFormat & DT_SINGLELINE)
+    {
+        if(m_nFormat & DT_VCENTER)
+        {
+            nY += (nBoxHeight - m_nStripHeight) / 2;
+        }
+        else if(m_nFormat & DT_BOTTOM)
+        {
+            nY += nBoxHeight - m_nStripHeight;
+        }
+    }
+
+    if(m_bRepeat && (0 < m_nStripWidth))
+    {
+        // the first copy that reaches into the box
+        int nStart = nOffset % m_nStripWidth;
+        if(0 > nStart)
+        {
+            nStart += m_nStripWidth;
+        }
+        for(int x = nX - nStart; x < rcBoundary.right; x += m_nStripWidth)
+        {
+            DrawStrip(rGfx, rcClip, x + ptOffset.x, nY + ptOffset.y, m_nStripWidth,
+                bMono, byMono, crColor);
+        }
+        return TRUE;
+    }
+
+    if(m_sizeText.cx < nBoxWidth)
+    {
+        if(m_nFormat & DT_CENTER)
+        {
+            nX += (nBoxWidth - m_sizeText.cx) / 2;
+        }
+        else if(m_nFormat & DT_RIGHT)
+        {
+            nX += nBoxWidth - m_sizeText.cx;
+        }
+    }
+    DrawStrip(rGfx, rcClip, nX - nOffset + ptOffset.x, nY + ptOffset.y, m_sizeText.cx,
+        bMono, byMono, crColor);
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::Prepare
+//
+//************************************************************************
+
+void CLCDMarquee::Prepare(CLCDGfxBase &rGfx)
+{
+    int nBitCount = rGfx.GetBitCount();
+    if((8 != nBitCount) && (32 != nBitCount))
+    {
+        return;
+    }
+
+    BOOL bMono = (8 == nBitCount);
+    if(!m_bRendered || (m_bRenderedMono != bMono))
+    {
+        Render(bMono);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::GetStripFormat
+//
+// The alignment of a single line is applied in Draw()
+//
+//************************************************************************
+
+UINT CLCDMarquee::GetStripFormat(void)
+{
+    UINT nFormat = m_nFormat & ~(DT_WORDBREAK | DT_CALCRECT | DT_NOCLIP);
+    if(0 < m_nWrapWidth)
+    {
+        nFormat = (nFormat | DT_WORDBREAK) & ~DT_SINGLELINE;
+    }
+    else
+    {
+        nFormat &= ~(DT_CENTER | DT_RIGHT | DT_VCENTER | DT_BOTTOM);
+    }
+    return nFormat;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::Measure
+//
+//************************************************************************
+
+void CLCDMarquee::Measure(void)
+{
+    m_bMeasured = TRUE;
+
+    DRAWTEXTPARAMS dtp;
+    ZeroMemory(&dtp, sizeof(dtp));
+    dtp.cbSize = sizeof(dtp);
+
+    UINT nFormat = GetStripFormat();
+    CLCDTextLayout &rLayout = CLCDTextLayout::GetInstance();
+    m_sizeText = rLayout.GetExtent(NULL, m_hFont, m_sText.c_str(), (int)m_sText.size(),
+        m_nWrapWidth, 0, nFormat, dtp);
+    if(0 < m_nWrapWidth)
+    {
+        m_sizeText.cx = m_nWrapWidth;
+    }
+
+    m_sizeGap.cx = m_sizeGap.cy = 0;
+    if((0 == m_nWrapWidth) && !m_sGapText.empty())
+    {
+        m_sizeGap = rLayout.GetExtent(NULL, m_hFont, m_sGapText.c_str(), (int)m_sGapText.size(),
+            0, 0, nFormat | DT_SINGLELINE, dtp);
+    }
+
+    m_nStripWidth = m_sizeText.cx;
+    m_nStripHeight = max(m_sizeText.cy, m_sizeGap.cy);
+    if(0 == m_nWrapWidth)
+    {
+        m_nStripWidth += m_sizeGap.cx + m_nGapWidth;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::Render
+//
+// Draws the text in white on black and keeps one channel as coverage.
+// Mono surfaces get the strip from an 8bpp bitmap, where GDI does not
+// smooth text, so that the text looks the same as drawn with DrawTextEx().
+//
+//************************************************************************
+
+BOOL CLCDMarquee::Render(BOOL bMono)
+{
+    if(!m_bMeasured)
+    {
+        Measure();
+    }
+
+    m_bRendered = TRUE;
+    m_bRenderedMono = bMono;
+    m_bStripValid = FALSE;
+
+    if(m_sText.empty() || (0 >= m_nStripWidth) || (0 >= m_nStripHeight))
+    {
+        m_Strip.clear();
+        m_bStripValid = TRUE;
+        return TRUE;
+    }
+    if(MAX_STRIP_WIDTH < m_nStripWidth)
+    {
+        m_Strip.clear();
+        return FALSE;
+    }
+
+    HDC hDC = CreateCompatibleDC(NULL);
+    if(NULL == hDC)
+    {
+        LCDUITRACE(_T("CLCDMarquee::Render(): failed to create a device context.\n"));
+        return FALSE;
+    }
+
+    int nBMISize = sizeof(BITMAPINFO) + 256 * sizeof(RGBQUAD);
+    std::vector<BYTE> BitmapInfo(nBMISize, 0);
+    BITMAPINFO *pBitmapInfo = (BITMAPINFO *)&BitmapInfo[0];
+    pBitmapInfo->bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    pBitmapInfo->bmiHeader.biWidth = m_nStripWidth;
+    pBitmapInfo->bmiHeader.biHeight = -m_nStripHeight;
+    pBitmapInfo->bmiHeader.biPlanes = 1;
+    pBitmapInfo->bmiHeader.biBitCount = (WORD)(bMono ? 8 : 32);
+    pBitmapInfo->bmiHeader.biCompression = BI_RGB;
+    if(bMono)
+    {
+        // gray ramp, so that the index is the coverage
+        pBitmapInfo->bmiHeader.biClrUsed = 256;
+        for(int nColor = 0; nColor < 256; nColor++)
+        {
+            pBitmapInfo->bmiColors[nColor].rgbRed = (BYTE)nColor;
+            pBitmapInfo->bmiColors[nColor].rgbGreen = (BYTE)nColor;
+            pBitmapInfo->bmiColors[nColor].rgbBlue = (BYTE)nColor;
+            pBitmapInfo->bmiColors[nColor].rgbReserved = 0;
+        }
+    }
+
+    PBYTE pBits = NULL;
+    HBITMAP hBitmap = CreateDIBSection(hDC, pBitmapInfo, DIB_RGB_COLORS, (PVOID *)&pBits, NULL, 0);
+    if((NULL == hBitmap) || (NULL == pBits))
+    {
+        LCDUITRACE(_T("CLCDMarquee::Render(): failed to create the strip.\n"));
+        DeleteDC(hDC);
+        m_Strip.clear();
+        return FALSE;
+    }
+
+    HBITMAP hOldBitmap = (HBITMAP)SelectObject(hDC, hBitmap);
+    HFONT hOldFont = (HFONT)SelectObject(hDC, m_hFont);
+    int nPitch = bMono ? ((m_nStripWidth + 3) & ~3) : m_nStripWidth * 4;
+    ZeroMemory(pBits, nPitch * m_nStripHeight);
+
+    SetMapMode(hDC, MM_TEXT);
+    SetBkMode(hDC, TRANSPARENT);
+    SetTextColor(hDC, RGB(255, 255, 255));
+
+    DRAWTEXTPARAMS dtp;
+    ZeroMemory(&dtp, sizeof(dtp));
+    dtp.cbSize = sizeof(dtp);
+
+    UINT nFormat = GetStripFormat();
+    RECT rcText = { 0, 0, m_sizeText.cx, m_nStripHeight };
+    DrawTextEx(hDC, (LPTSTR)m_sText.c_str(), (int)m_sText.size(), &rcText, nFormat, &dtp);
+    if(0 < m_sizeGap.cx)
+    {
+        RECT rcGap = { m_sizeText.cx, 0, m_sizeText.cx + m_sizeGap.cx, m_nStripHeight };
+        DrawTextEx(hDC, (LPTSTR)m_sGapText.c_str(), (int)m_sGapText.size(), &rcGap,
+            nFormat | DT_SINGLELINE, &dtp);
+    }
+    GdiFlush();
+
+    m_Strip.resize(m_nStripWidth * m_nStripHeight);
+    for(int y = 0; y < m_nStripHeight; y++)
+    {
+        const BYTE *pSrc = pBits + y * nPitch;
+        PBYTE pDst = &m_Strip[y * m_nStripWidth];
+        if(bMono)
+        {
+            memcpy(pDst, pSrc, m_nStripWidth);
+        }
+        else
+        {
+            // green, the channel that weighs most
+            for(int x = 0; x < m_nStripWidth; x++)
+            {
+                pDst[x] = pSrc[x * 4 + 1];
+            }
+        }
+    }
+
+    SelectObject(hDC, hOldFont);
+    SelectObject(hDC, hOldBitmap);
+    DeleteObject(hBitmap);
+    DeleteDC(hDC);
+
+    m_bStripValid = TRUE;
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDMarquee::DrawStrip
+//
+// Draws the first nWidth columns of the strip with its top left at
+// nX, nY, in surface coordinates.
+//
+//************************************************************************
+
+void CLCDMarquee::DrawStrip(CLCDGfxBase &rGfx, const RECT &rcClip, int nX, int nY, int nWidth,
+                            BOOL bMono, BYTE byMono, COLORREF crColor)
+{
+    RECT rcStrip = { nX, nY, nX + min(nWidth, m_nStripWidth), nY + m_nStripHeight };
+    RECT rcDraw;
+    if(!IntersectRect(&rcDraw, &rcStrip, &rcClip))
+    {
+        return;
+    }
+
+    PBYTE pBits = rGfx.GetBits();
+    int nPitch = rGfx.GetPitch();
+    int nDrawWidth = rcDraw.right - rcDraw.left;
+    for(int y = rcDraw.top; y < rcDraw.bottom; y++)
+    {
+        const BYTE *pCoverage = &m_Strip[(y - nY) * m_nStripWidth + (rcDraw.left - nX)];
+        if(bMono)
+        {
+            CLCDCompositor::ThresholdCoverageRow(pBits + y * nPitch + rcDraw.left,
+                pCoverage, nDrawWidth, byMono);
+        }
+        else
+        {
+            CLCDCompositor::BlendCoverageRow(pBits + y * nPitch + rcDraw.left * 4,
+                pCoverage, nDrawWidth, crColor);
+        }
+    }
+}
+
+
+//** end of LCDMarquee.cpp ***********************************************
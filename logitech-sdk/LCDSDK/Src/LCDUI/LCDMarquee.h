@@ -0,0 +1,97 @@
+//************************************************************************
+//
+// LCDMarquee.h
+//
+// The CLCDMarquee class renders the text of a scrolling control once
+// into an off-screen strip, followed by its gap when the text repeats.
+// Each frame then only copies the part of the strip at the current
+// offset, instead of laying out and drawing the whole string again.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDMARQUEE_H_INCLUDED_
+#define _LCDMARQUEE_H_INCLUDED_
+
+class CLCDMarquee
+{
+public:
+    CLCDMarquee(void);
+    virtual ~CLCDMarquee(void);
+
+    // The strip is rendered again on the next draw after any of these
+    // changed. Setting the same value again costs a comparison.
+    void SetText(LPCTSTR szText, int nLength);
+    // what follows the text when it repeats: szGapText, then nGapWidth
+    // blank pixels
+    void SetGap(LPCTSTR szGapText, int nGapWidth);
+    void SetFont(HFONT hFont);
+    // DrawTextEx() flags. The horizontal and vertical alignment of a
+    // single line is applied when drawing.
+    void SetFormat(UINT nFormat);
+    // Word wraps the text to nWrapWidth pixels, for scrolling vertically.
+    // 0 keeps lines as they are.
+    void SetWrapWidth(int nWrapWidth);
+
+    // Draws copies of the text one period apart, instead of one aligned
+    // copy. Takes effect without rendering again.
+    void EnableRepeat(BOOL bRepeat);
+    BOOL IsRepeating(void);
+
+    // size of the text alone
+    SIZE GetTextExtent(void);
+    // distance between two copies of the text when it repeats
+    int GetPeriod(void);
+
+    // Draws the strip into rcBoundary, in logical coordinates of the
+    // surface, with a transparent background. nOffset is how far the
+    // strip has scrolled: left, or up when wrapped. Returns FALSE without
+    // drawing if the surface cannot be written directly, the caller then
+    // draws the text itself.
+    BOOL Draw(CLCDGfxBase &rGfx, const RECT &rcBoundary, int nOffset, COLORREF crColor);
+    // Renders the strip for the surface now, so that Draw() only reads
+    // it. Controls drawn into several tiles at once call this from
+    // OnPrepareDraw().
+    void Prepare(CLCDGfxBase &rGfx);
+
+    // strips wider than this are not rendered, Draw() returns FALSE
+    enum { MAX_STRIP_WIDTH = 4096 };
+
+protected:
+    UINT GetStripFormat(void);
+    void Measure(void);
+    BOOL Render(BOOL bMono);
+    void DrawStrip(CLCDGfxBase &rGfx, const RECT &rcClip, int nX, int nY, int nWidth,
+                   BOOL bMono, BYTE byMono, COLORREF crColor);
+
+protected:
+#ifdef UNICODE
+    std::wstring m_sText;
+    std::wstring m_sGapText;
+#else
+    std::string m_sText;
+    std::string m_sGapText;
+#endif
+    int m_nGapWidth;
+    HFONT m_hFont;
+    UINT m_nFormat;
+    int m_nWrapWidth;
+    BOOL m_bRepeat;
+
+    // one byte of coverage per pixel, rendered for a mono or color surface
+    std::vector<BYTE> m_Strip;
+    int m_nStripWidth;
+    int m_nStripHeight;
+    SIZE m_sizeText;
+    SIZE m_sizeGap;
+    BOOL m_bMeasured;
+    BOOL m_bRendered;
+    BOOL m_bRenderedMono;
+    BOOL m_bStripValid;
+};
+
+#endif // !_LCDMARQUEE_H_INCLUDED_
+
+//** end of LCDMarquee.h *************************************************
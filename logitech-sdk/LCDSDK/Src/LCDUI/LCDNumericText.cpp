@@ -0,0 +1,810 @@
+//************************************************************************
+//
+// LCDNumericText.cpp
+//
+// The CLCDNumericText class shows a number, redrawing only the digit
+// cells that changed.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+static const ULONGLONG s_aullPowersOf10[] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+static const TCHAR s_szSIPrefixes[] = _T("kMGTPE");
+
+
+//************************************************************************
+//
+// CLCDNumericText::CLCDNumericText
+//
+//************************************************************************
+
+CLCDNumericText::CLCDNumericText(void)
+:   m_llValue(0),
+    m_nDecimals(0),
+    m_bNumeric(TRUE),
+    m_chGroupSeparator(0),
+    m_chDecimalSeparator(_T('.')),
+    m_bSIPrefixes(FALSE),
+    m_nSIPrecision(1),
+    m_nCells(0),
+    m_nDrawnCells(-1),
+    m_bCellsOnly(FALSE),
+    m_bRemeasure(TRUE),
+    m_bSoftMetrics(FALSE),
+    m_nDigitWidth(0),
+    m_nLineHeight(0)
+{
+    m_szUnits[0] = _T('\0');
+    m_szDrawnCells[0] = _T('\0');
+    ZeroMemory(m_anCellX, sizeof(m_anCellX));
+    ZeroMemory(m_anDrawnCellX, sizeof(m_anDrawnCellX));
+    SetRectEmpty(&m_rcCells);
+
+    // measured on the first draw
+    Format();
+    m_nTextLength = m_nCells;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::~CLCDNumericText
+//
+//************************************************************************
+
+CLCDNumericText::~CLCDNumericText(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetValue
+//
+//************************************************************************
+
+void CLCDNumericText::SetValue(LONGLONG llValue)
+{
+    SetFixedValue(llValue, 0);
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetFixedValue
+//
+//************************************************************************
+
+void CLCDNumericText::SetFixedValue(LONGLONG llValue, int nDecimals)
+{
+    nDecimals = max(0, min(nDecimals, (int)MAX_DECIMALS));
+    if (m_bNumeric && (llValue == m_llValue) && (nDecimals == m_nDecimals))
+    {
+        return;
+    }
+
+    m_llValue = llValue;
+    m_nDecimals = nDecimals;
+    m_bNumeric = TRUE;
+    Format();
+    UpdateCells();
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::GetValue
+//
+//************************************************************************
+
+LONGLONG CLCDNumericText::GetValue(void)
+{
+    return m_llValue;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::GetDecimals
+//
+//************************************************************************
+
+int CLCDNumericText::GetDecimals(void)
+{
+    return m_nDecimals;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetGroupSeparator
+//
+//************************************************************************
+
+void CLCDNumericText::SetGroupSeparator(TCHAR chSeparator)
+{
+    m_chGroupSeparator = chSeparator;
+    if (m_bNumeric)
+    {
+        Format();
+        UpdateCells();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetDecimalSeparator
+//
+//************************************************************************
+
+void CLCDNumericText::SetDecimalSeparator(TCHAR chSeparator)
+{
+    m_chDecimalSeparator = chSeparator;
+    if (m_bNumeric)
+    {
+        Format();
+        UpdateCells();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetSIPrefixes
+//
+//************************************************************************
+
+void CLCDNumericText::SetSIPrefixes(BOOL bEnable, int nPrecision)
+{
+    m_bSIPrefixes = bEnable;
+    m_nSIPrecision = max(0, min(nPrecision, (int)MAX_PRECISION));
+    if (m_bNumeric)
+    {
+        Format();
+        UpdateCells();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetUnits
+//
+//************************************************************************
+
+void CLCDNumericText::SetUnits(LPCTSTR szUnits)
+{
+    LCDUI_tcsncpy(m_szUnits, (NULL != szUnits) ? szUnits : _T(""), MAX_UNITS);
+    m_szUnits[MAX_UNITS] = _T('\0');
+    if (m_bNumeric)
+    {
+        Format();
+        UpdateCells();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetText
+//
+//************************************************************************
+
+void CLCDNumericText::SetText(LPCTSTR szText, int nLength)
+{
+    LCDUIASSERT(NULL != szText);
+    if ((NULL == szText) || (0 > nLength))
+    {
+        szText = _T("");
+        nLength = 0;
+    }
+
+    nLength = min(nLength, (int)MAX_LENGTH);
+    if (!m_bNumeric && (nLength == m_nCells) && (0 == memcmp(m_szCells, szText, nLength * sizeof(TCHAR))))
+    {
+        return;
+    }
+
+    memcpy(m_szCells, szText, nLength * sizeof(TCHAR));
+    m_szCells[nLength] = _T('\0');
+    m_nCells = nLength;
+    m_bNumeric = FALSE;
+    UpdateCells();
+}
+
+
+#ifdef LCDUI_RVALUE_REFS
+//************************************************************************
+//
+// CLCDNumericText::SetText
+//
+// The cells are copied anyway, there is no buffer to take
+//************************************************************************
+
+void CLCDNumericText::SetText(lcdstring &&sText)
+{
+    SetText(sText.data(), static_cast<int>(sText.size()));
+}
+#endif
+
+
+//************************************************************************
+//
+// CLCDNumericText::GetText
+//
+//************************************************************************
+
+LPCTSTR CLCDNumericText::GetText(void)
+{
+    return m_szCells;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetFont
+//
+//************************************************************************
+
+void CLCDNumericText::SetFont(LOGFONT& lf)
+{
+    CLCDText::SetFont(lf);
+    m_bRemeasure = TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::SetBitmapFont
+//
+//************************************************************************
+
+void CLCDNumericText::SetBitmapFont(CLCDBitmapFont *pFont)
+{
+    CLCDText::SetBitmapFont(pFont);
+    m_bRemeasure = TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::Invalidate
+//
+// Anything but a new value redraws the whole control
+//
+//************************************************************************
+
+void CLCDNumericText::Invalidate(void)
+{
+    m_bCellsOnly = FALSE;
+    CLCDText::Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::GetDamage
+//
+//************************************************************************
+
+void CLCDNumericText::GetDamage(RECT &rcDamage)
+{
+    if (!IsDirty())
+    {
+        return;
+    }
+    if (!m_bCellsOnly || !IsVisible())
+    {
+        CLCDText::GetDamage(rcDamage);
+        return;
+    }
+
+    // the changed cells, in the parent's coordinates
+    RECT rcCells = m_rcCells;
+    OffsetRect(&rcCells, GetOrigin().x + GetLogicalOrigin().x, GetOrigin().y + GetLogicalOrigin().y);
+
+    RECT rcBounds;
+    GetBounds(rcBounds);
+    if (IntersectRect(&rcCells, &rcCells, &rcBounds))
+    {
+        UnionRect(&rcDamage, &rcDamage, &rcCells);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::ClearDamage
+//
+// The cells are on the screen, the next value is compared to them
+//
+//************************************************************************
+
+void CLCDNumericText::ClearDamage(void)
+{
+    CLCDText::ClearDamage();
+
+    m_bCellsOnly = FALSE;
+    SetRectEmpty(&m_rcCells);
+
+    memcpy(m_szDrawnCells, m_szCells, (m_nCells + 1) * sizeof(TCHAR));
+    memcpy(m_anDrawnCellX, m_anCellX, (m_nCells + 1) * sizeof(int));
+    m_nDrawnCells = m_nCells;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::OnPrepareDraw
+//
+// Soft surfaces draw with their built-in font, unless there is a bitmap
+// font
+//
+//************************************************************************
+
+void CLCDNumericText::OnPrepareDraw(CLCDGfxBase &rGfx)
+{
+    BOOL bSoftMetrics = (NULL != rGfx.GetSoftSurface()) &&
+        ((NULL == m_pBitmapFont) || !m_pBitmapFont->IsLoaded());
+    if (bSoftMetrics != m_bSoftMetrics)
+    {
+        m_bSoftMetrics = bSoftMetrics;
+        m_bRemeasure = TRUE;
+    }
+
+    // also picks up alignment and size changes
+    EnsureMetrics();
+    LayoutCells();
+
+    if (m_bRecalcExtent)
+    {
+        RecalcExtent(NULL);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::OnDraw
+//
+// Only the cells within the clip box are drawn
+//
+//************************************************************************
+
+void CLCDNumericText::OnDraw(CLCDGfxBase &rGfx)
+{
+    CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+    RECT rcLogical = { 0, 0, GetLogicalSize().cx, GetLogicalSize().cy };
+
+    if (GetBackgroundMode() == OPAQUE)
+    {
+        if (NULL != pSoft)
+        {
+            pSoft->FillRect(rcLogical, m_crBackgroundColor);
+        }
+        else
+        {
+            HBRUSH hBackBrush = CreateSolidBrush(m_crBackgroundColor);
+            FillRect(rGfx.GetHDC(), &rcLogical, hBackBrush);
+            DeleteObject(hBackBrush);
+        }
+    }
+
+    if (m_nCells && IsVisible())
+    {
+        RECT rcVisible;
+        GetVisibleRect(rGfx, rcVisible);
+
+        // map mode text, with transparency
+        HDC hDC = (NULL == pSoft) ? rGfx.GetHDC() : NULL;
+        int nOldMapMode = 0;
+        int nOldBkMode = 0;
+        HFONT hOldFont = NULL;
+        COLORREF crOldTextColor = 0;
+        if (NULL != hDC)
+        {
+            nOldMapMode = SetMapMode(hDC, MM_TEXT);
+            nOldBkMode = SetBkMode(hDC, TRANSPARENT);
+            hOldFont = (HFONT)SelectObject(hDC, m_hFont);
+            crOldTextColor = SetTextColor(hDC, m_crForegroundColor);
+        }
+
+        for (int i = 0; i < m_nCells; i++)
+        {
+            RECT rcCell = { m_anCellX[i], 0, m_anCellX[i + 1], rcLogical.bottom };
+            RECT rcDraw;
+            if (IntersectRect(&rcDraw, &rcCell, &rcVisible))
+            {
+                DrawCell(rGfx, i);
+            }
+        }
+
+        if (NULL != hDC)
+        {
+            SetMapMode(hDC, nOldMapMode);
+            SetBkMode(hDC, nOldBkMode);
+            SelectObject(hDC, hOldFont);
+            SetTextColor(hDC, crOldTextColor);
+        }
+    }
+
+    if (m_bInverted)
+    {
+        if (NULL != pSoft)
+        {
+            pSoft->InvertRect(rcLogical);
+        }
+        else
+        {
+            InvertRect(rGfx.GetHDC(), &rcLogical);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::IsTileSafe
+//
+//************************************************************************
+
+BOOL CLCDNumericText::IsTileSafe(void)
+{
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::RecalcExtent
+//
+//************************************************************************
+
+void CLCDNumericText::RecalcExtent(HDC hDC)
+{
+    UNREFERENCED_PARAMETER(hDC);
+
+    EnsureMetrics();
+    LayoutCells();
+
+    m_sizeHExtent.cx = m_anCellX[m_nCells] - m_anCellX[0] + m_dtp.iLeftMargin + m_dtp.iRightMargin;
+    m_sizeHExtent.cy = m_nLineHeight;
+    m_sizeVExtent = m_sizeHExtent;
+    m_bRecalcExtent = FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::Format
+//
+// Writes the value into m_szCells from the end: units, SI prefix, then
+// the digits with their separators and the sign
+//
+//************************************************************************
+
+void CLCDNumericText::Format(void)
+{
+    TCHAR szBuffer[MAX_LENGTH + 1];
+    int nPos = MAX_LENGTH;
+    szBuffer[nPos] = _T('\0');
+
+    int nUnits = (int)_tcslen(m_szUnits);
+    nPos -= nUnits;
+    memcpy(&szBuffer[nPos], m_szUnits, nUnits * sizeof(TCHAR));
+
+    BOOL bNegative = (0 > m_llValue);
+    ULONGLONG ullDigits = bNegative ? (ULONGLONG)0 - (ULONGLONG)m_llValue : (ULONGLONG)m_llValue;
+    int nDecimals = m_nDecimals;
+
+    if (m_bSIPrefixes)
+    {
+        // thousands until the rounded value is below 1000
+        double dValue = (double)ullDigits / (double)s_aullPowersOf10[nDecimals];
+        double dScale = (double)s_aullPowersOf10[m_nSIPrecision];
+        int nPrefix = -1;
+        while ((nPrefix < (int)_countof(s_szSIPrefixes) - 2) && (dValue * dScale + 0.5 >= 1000.0 * dScale))
+        {
+            dValue /= 1000.0;
+            nPrefix++;
+        }
+
+        if (0 <= nPrefix)
+        {
+            ullDigits = (ULONGLONG)(dValue * dScale + 0.5);
+            nDecimals = m_nSIPrecision;
+            szBuffer[--nPos] = s_szSIPrefixes[nPrefix];
+        }
+    }
+
+    int nDigit = 0;
+    do
+    {
+        if ((0 < nDecimals) && (nDigit == nDecimals))
+        {
+            szBuffer[--nPos] = m_chDecimalSeparator;
+        }
+        else if ((0 != m_chGroupSeparator) && (nDigit > nDecimals) && (0 == (nDigit - nDecimals) % 3))
+        {
+            szBuffer[--nPos] = m_chGroupSeparator;
+        }
+
+        szBuffer[--nPos] = (TCHAR)(_T('0') + (int)(ullDigits % 10));
+        ullDigits /= 10;
+        nDigit++;
+    }
+    while ((0 != ullDigits) || (nDigit <= nDecimals));
+
+    if (bNegative)
+    {
+        szBuffer[--nPos] = _T('-');
+    }
+
+    m_nCells = MAX_LENGTH - nPos;
+    memcpy(m_szCells, &szBuffer[nPos], (m_nCells + 1) * sizeof(TCHAR));
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::UpdateCells
+//
+// Lays out the new cells and damages the ones that differ from the
+// cells on the screen
+//
+//************************************************************************
+
+void CLCDNumericText::UpdateCells(void)
+{
+    m_nTextLength = m_nCells;
+    m_bRecalcExtent = TRUE;
+    EnsureMetrics();
+    LayoutCells();
+
+    if (0 > m_nDrawnCells)
+    {
+        // nothing to compare to
+        Invalidate();
+        return;
+    }
+
+    RECT rcChanged;
+    SetRectEmpty(&rcChanged);
+    int nCells = max(m_nCells, m_nDrawnCells);
+    for (int i = 0; i < nCells; i++)
+    {
+        BOOL bCell = (i < m_nCells);
+        BOOL bDrawnCell = (i < m_nDrawnCells);
+        if (bCell && bDrawnCell && (m_szCells[i] == m_szDrawnCells[i]) &&
+            (m_anCellX[i] == m_anDrawnCellX[i]) && (m_anCellX[i + 1] == m_anDrawnCellX[i + 1]))
+        {
+            continue;
+        }
+
+        if (bCell)
+        {
+            RECT rcCell = { m_anCellX[i], 0, m_anCellX[i + 1], GetLogicalSize().cy };
+            UnionRect(&rcChanged, &rcChanged, &rcCell);
+        }
+        if (bDrawnCell)
+        {
+            RECT rcCell = { m_anDrawnCellX[i], 0, m_anDrawnCellX[i + 1], GetLogicalSize().cy };
+            UnionRect(&rcChanged, &rcChanged, &rcCell);
+        }
+    }
+
+    // already redrawn as a whole
+    if (IsDirty() && !m_bCellsOnly)
+    {
+        return;
+    }
+
+    m_bCellsOnly = TRUE;
+    m_rcCells = rcChanged;
+    m_bDirty = !IsRectEmpty(&rcChanged);
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::EnsureMetrics
+//
+//************************************************************************
+
+void CLCDNumericText::EnsureMetrics(void)
+{
+    if (!m_bRemeasure)
+    {
+        return;
+    }
+
+    for (int i = 0; i < _countof(m_anCharWidth); i++)
+    {
+        m_anCharWidth[i] = -1;
+    }
+
+    // tabular digits, as wide as the widest
+    m_nDigitWidth = 0;
+    m_nLineHeight = 0;
+    for (TCHAR ch = _T('0'); ch <= _T('9'); ch++)
+    {
+        SIZE sizeDigit = MeasureChar(ch);
+        m_nDigitWidth = max(m_nDigitWidth, (int)sizeDigit.cx);
+        m_nLineHeight = max(m_nLineHeight, (int)sizeDigit.cy);
+    }
+
+    // the cells on the screen were measured differently
+    m_nDrawnCells = -1;
+    m_bRemeasure = FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::LayoutCells
+//
+// Lays out the cells aside and only writes m_anCellX when a position
+// changed, so that tiles being drawn never see a half updated layout.
+//************************************************************************
+
+void CLCDNumericText::LayoutCells(void)
+{
+    int anCellX[MAX_LENGTH + 1];
+    int nX = 0;
+    for (int i = 0; i < m_nCells; i++)
+    {
+        anCellX[i] = nX;
+        nX += GetCellWidth(m_szCells[i]);
+    }
+    anCellX[m_nCells] = nX;
+
+    int nOffset = m_dtp.iLeftMargin;
+    if (m_nTextFormat & DT_CENTER)
+    {
+        nOffset = (GetLogicalSize().cx - nX) / 2;
+    }
+    else if (m_nTextFormat & DT_RIGHT)
+    {
+        nOffset = GetLogicalSize().cx - m_dtp.iRightMargin - nX;
+    }
+
+    for (int i = 0; i <= m_nCells; i++)
+    {
+        anCellX[i] += nOffset;
+    }
+
+    size_t nBytes = (m_nCells + 1) * sizeof(int);
+    if (0 != memcmp(m_anCellX, anCellX, nBytes))
+    {
+        memcpy(m_anCellX, anCellX, nBytes);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::GetCellWidth
+//
+//************************************************************************
+
+int CLCDNumericText::GetCellWidth(TCHAR ch)
+{
+    if ((_T('0') <= ch) && (ch <= _T('9')))
+    {
+        return m_nDigitWidth;
+    }
+
+    if (_countof(m_anCharWidth) > (TBYTE)ch)
+    {
+        int &rnWidth = m_anCharWidth[(TBYTE)ch];
+        if (0 > rnWidth)
+        {
+            rnWidth = MeasureChar(ch).cx;
+        }
+        return rnWidth;
+    }
+
+    return MeasureChar(ch).cx;
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::MeasureChar
+//
+//************************************************************************
+
+SIZE CLCDNumericText::MeasureChar(TCHAR ch)
+{
+    if (m_bSoftMetrics)
+    {
+        return CLCDGfxSoft::GetTextExtent(&ch, 1, GetSoftScale());
+    }
+
+    if ((NULL != m_pBitmapFont) && m_pBitmapFont->IsLoaded())
+    {
+        return m_pBitmapFont->GetTextExtent(&ch, 1, 0, DT_SINGLELINE);
+    }
+
+    DRAWTEXTPARAMS dtp;
+    ZeroMemory(&dtp, sizeof(DRAWTEXTPARAMS));
+    dtp.cbSize = sizeof(DRAWTEXTPARAMS);
+    return CLCDTextLayout::GetInstance().GetExtent(NULL, m_hFont, &ch, 1, GetWidth(), GetHeight(),
+                                                   DT_SINGLELINE | DT_NOPREFIX, dtp);
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::GetVisibleRect
+//
+// The clip box, in logical coordinates of the control
+//
+//************************************************************************
+
+void CLCDNumericText::GetVisibleRect(CLCDGfxBase &rGfx, RECT &rcVisible)
+{
+    CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+    if (NULL != pSoft)
+    {
+        POINT ptOrigin = pSoft->GetOrigin();
+        pSoft->GetClipRect(&rcVisible);
+        OffsetRect(&rcVisible, -ptOrigin.x, -ptOrigin.y);
+        return;
+    }
+
+    if (ERROR == GetClipBox(rGfx.GetHDC(), &rcVisible))
+    {
+        SetRect(&rcVisible, 0, 0, GetLogicalSize().cx, GetLogicalSize().cy);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDNumericText::DrawCell
+//
+// Characters are centered in their cells
+//
+//************************************************************************
+
+void CLCDNumericText::DrawCell(CLCDGfxBase &rGfx, int nCell)
+{
+    RECT rcCell = { m_anCellX[nCell], 0, m_anCellX[nCell + 1], GetLogicalSize().cy };
+    LPCTSTR szCell = &m_szCells[nCell];
+    UINT nFormat = DT_CENTER | DT_SINGLELINE | DT_NOPREFIX;
+
+    if ((NULL != m_pBitmapFont) && m_pBitmapFont->DrawText(rGfx, rcCell, szCell, 1, nFormat, m_crForegroundColor))
+    {
+        return;
+    }
+
+    CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+    if (NULL != pSoft)
+    {
+        // all the cells of the built-in font are one advance wide
+        pSoft->DrawText(rcCell.left, 0, szCell, 1, m_crForegroundColor, GetSoftScale());
+        return;
+    }
+
+    // see CLCDText::DrawText
+    DRAWTEXTPARAMS dtp;
+    ZeroMemory(&dtp, sizeof(DRAWTEXTPARAMS));
+    dtp.cbSize = sizeof(DRAWTEXTPARAMS);
+    if (!CLCDGlyphCache::GetInstance().DrawText(rGfx, m_hFont, szCell, 1, rcCell, nFormat, dtp, m_crForegroundColor))
+    {
+        DrawTextEx(rGfx.GetHDC(), (LPTSTR)szCell, 1, &rcCell, nFormat, &dtp);
+    }
+}
+
+
+//** end of LCDNumericText.cpp *******************************************
@@ -0,0 +1,109 @@
+//************************************************************************
+//
+// LCDNumericText.h
+//
+// The CLCDNumericText class shows a number: an integer or a fixed point
+// value, with optional digit grouping, SI prefixes and units. The value
+// is formatted into an inline buffer and laid out in cells, digits all
+// as wide as the widest one, so an update allocates nothing and only
+// damages the cells that changed.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDNUMERICTEXT_H_INCLUDED_
+#define _LCDNUMERICTEXT_H_INCLUDED_
+
+#include "LCDText.h"
+
+class CLCDNumericText : public CLCDText
+{
+public:
+    CLCDNumericText(void);
+    virtual ~CLCDNumericText(void);
+
+    // llValue / 10^nDecimals, 0 to 9 decimals
+    void SetValue(LONGLONG llValue);
+    void SetFixedValue(LONGLONG llValue, int nDecimals);
+    LONGLONG GetValue(void);
+    int GetDecimals(void);
+
+    // 0 for no grouping
+    void SetGroupSeparator(TCHAR chSeparator);
+    void SetDecimalSeparator(TCHAR chSeparator);
+    // 1234567 shows as 1.2M with a precision of 1, 0 to 3 decimals
+    void SetSIPrefixes(BOOL bEnable, int nPrecision = 1);
+    // appended to the number, up to MAX_UNITS characters
+    void SetUnits(LPCTSTR szUnits);
+
+    // CLCDText
+    // Shows the text as is, cut to MAX_LENGTH characters
+    using CLCDText::SetText;
+    virtual void SetText(LPCTSTR szText, int nLength);
+#ifdef LCDUI_RVALUE_REFS
+    virtual void SetText(lcdstring &&sText);
+#endif
+    virtual LPCTSTR GetText(void);
+    virtual void SetFont(LOGFONT& lf);
+    virtual void SetBitmapFont(CLCDBitmapFont *pFont);
+
+    // CLCDBase
+    virtual void Invalidate(void);
+    virtual void GetDamage(RECT &rcDamage);
+    virtual void ClearDamage(void);
+    virtual void OnPrepareDraw(CLCDGfxBase &rGfx);
+    virtual void OnDraw(CLCDGfxBase &rGfx);
+    virtual BOOL IsTileSafe(void);
+
+    enum { MAX_LENGTH = 48, MAX_UNITS = 8, MAX_DECIMALS = 9, MAX_PRECISION = 3 };
+
+protected:
+    virtual void RecalcExtent(HDC hDC);
+
+    void Format(void);
+    void UpdateCells(void);
+    void EnsureMetrics(void);
+    void LayoutCells(void);
+    int GetCellWidth(TCHAR ch);
+    SIZE MeasureChar(TCHAR ch);
+    void GetVisibleRect(CLCDGfxBase &rGfx, RECT &rcVisible);
+    void DrawCell(CLCDGfxBase &rGfx, int nCell);
+
+protected:
+    // the value and how it is formatted
+    LONGLONG m_llValue;
+    int m_nDecimals;
+    BOOL m_bNumeric;
+    TCHAR m_chGroupSeparator;
+    TCHAR m_chDecimalSeparator;
+    BOOL m_bSIPrefixes;
+    int m_nSIPrecision;
+    TCHAR m_szUnits[MAX_UNITS + 1];
+
+    // the text and the left of each cell, then the right of the last one
+    TCHAR m_szCells[MAX_LENGTH + 1];
+    int m_nCells;
+    int m_anCellX[MAX_LENGTH + 1];
+
+    // as last drawn, -1 cells if unknown
+    TCHAR m_szDrawnCells[MAX_LENGTH + 1];
+    int m_nDrawnCells;
+    int m_anDrawnCellX[MAX_LENGTH + 1];
+
+    // TRUE while only m_rcCells, in logical coordinates, has to be redrawn
+    BOOL m_bCellsOnly;
+    RECT m_rcCells;
+
+    // widths of the first 128 characters, -1 until measured
+    BOOL m_bRemeasure;
+    BOOL m_bSoftMetrics;
+    int m_anCharWidth[128];
+    int m_nDigitWidth;
+    int m_nLineHeight;
+};
+
+#endif // !_LCDNUMERICTEXT_H_INCLUDED_
+
+//** end of LCDNumericText.h *********************************************
@@ -1,648 +1,1518 @@
-//************************************************************************
-//
-// LCDOutput.cpp
-//
-// The CLCDOutput manages the actual device and the various pages that
-// are sent to that device
-// 
-// This class is now managed by CLCDConnection. You no longer need to 
-// derive or instantiate this class yourself
-//
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDOutput::CLCDOutput
-//
-//************************************************************************
-
-CLCDOutput::CLCDOutput(void)
-:   m_pActivePage(NULL),
-    m_hDevice(LGLCD_INVALID_DEVICE),
-    m_bSetAsForeground(FALSE),
-    m_dwButtonState(0),
-    m_nPriority(LGLCD_PRIORITY_NORMAL),
-    m_pGfx(NULL)
-{
-    ZeroMemory(&m_OpenByTypeContext, sizeof(m_OpenByTypeContext));
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::~CLCDOutput
-//
-//************************************************************************
-
-CLCDOutput::~CLCDOutput(void)
-{
-    Shutdown();
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::SetGfx
-//
-//************************************************************************
-
-void CLCDOutput::SetGfx(CLCDGfxBase *gfx)
-{
-    m_pGfx = gfx;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::Open
-//
-//************************************************************************
-
-BOOL CLCDOutput::Open(lgLcdOpenContext & OpenContext)
-{
-    //Close the old device if there is one
-    Close();
-
-    DWORD res = lgLcdOpen(&OpenContext);
-    if (ERROR_SUCCESS != res)
-    {
-        if( res == ERROR_INVALID_PARAMETER )
-        {
-            LCDUITRACE( _T("Open failed: invalid parameter.\n") );
-            return FALSE;
-        }
-        else if( res == ERROR_ALREADY_EXISTS )
-        {
-            LCDUITRACE( _T("Open failed: already exists.\n") );
-            return FALSE;
-        }
-        return FALSE;
-    }
-
-    m_hDevice = OpenContext.device;
-    m_dwButtonState = 0;
-
-    // restores
-    SetAsForeground(m_bSetAsForeground);
-
-    OnOpenedDevice(m_hDevice);
-
-    return TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OpenByType
-//
-//************************************************************************
-
-BOOL CLCDOutput::OpenByType(lgLcdOpenByTypeContext &OpenContext)
-{
-    //Close the old device if there is one
-    Close();
-
-    DWORD res = lgLcdOpenByType(&OpenContext);
-    if (ERROR_SUCCESS != res)
-    {
-        if( res == ERROR_INVALID_PARAMETER )
-        {
-            LCDUITRACE( _T("Open failed: invalid parameter.\n") );
-            return FALSE;
-        }
-        else if( res == ERROR_ALREADY_EXISTS )
-        {
-            LCDUITRACE( _T("Open failed: already exists.\n") );
-            return FALSE;
-        }
-        return FALSE;
-    }
-
-    m_hDevice = OpenContext.device;
-    m_dwButtonState = 0;
-
-    // restores
-    SetAsForeground(m_bSetAsForeground);
-
-    m_OpenByTypeContext = OpenContext;
-
-    OnOpenedDevice(m_hDevice);
-
-    return TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::ReOpenDeviceType
-//
-//************************************************************************
-
-BOOL CLCDOutput::ReOpenDeviceType(void)
-{
-    // The device type must be active
-    if (!HasBeenOpenedByDeviceType())
-    {
-        return FALSE;
-    }
-
-    return OpenByType(m_OpenByTypeContext);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::Close
-//
-//************************************************************************
-
-void CLCDOutput::Close(void)
-{
-    if( LGLCD_INVALID_DEVICE != m_hDevice )
-    {
-        OnClosingDevice(m_hDevice);
-        lgLcdClose(m_hDevice);
-        m_hDevice = LGLCD_INVALID_DEVICE;
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::Shutdown
-//
-//************************************************************************
-
-void CLCDOutput::Shutdown(void)
-{
-    Close();
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::AddPage
-//
-//************************************************************************
-
-void CLCDOutput::AddPage(CLCDPage *pPage)
-{
-    pPage->Initialize();
-    AddObject(pPage);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::RemovePage
-//
-//************************************************************************
-
-void CLCDOutput::RemovePage(CLCDPage *pPage)
-{
-    RemoveObject(pPage);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::ShowPage
-//
-//************************************************************************
-
-void CLCDOutput::ShowPage(CLCDPage *pPage, BOOL bShow)
-{
-    LCDUIASSERT(NULL != pPage);
-
-    if (bShow)
-    {
-        m_pActivePage = pPage;
-
-        SetAsForeground(m_bSetAsForeground);
-
-        OnPageShown(pPage);
-    }
-    else
-    {
-        // Expire it and update
-        pPage->SetExpiration(0);
-        OnUpdate(GetTickCount());
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::GetShowingPage
-//
-//************************************************************************
-
-CLCDPage* CLCDOutput::GetShowingPage(void)
-{
-    return m_pActivePage;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::SetScreenPriority
-//
-//************************************************************************
-
-void CLCDOutput::SetScreenPriority(DWORD priority)
-{
-    // Priority has changed
-    // If we're going into idle, send an idle frame
-    if (LGLCD_PRIORITY_IDLE_NO_SHOW == priority)
-    {
-        lgLcdUpdateBitmap(m_hDevice, &m_pGfx->GetLCDScreen()->bmp_mono.hdr,
-            LGLCD_ASYNC_UPDATE(LGLCD_PRIORITY_IDLE_NO_SHOW));
-    }
-
-    m_nPriority = priority;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::GetScreenPriority
-//
-//************************************************************************
-
-DWORD CLCDOutput::GetScreenPriority(void)
-{
-    return m_nPriority;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::IsOpened
-//
-//************************************************************************
-
-BOOL CLCDOutput::IsOpened(void)
-{
-    return (LGLCD_INVALID_DEVICE != m_hDevice);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::SetAsForeground
-//
-//************************************************************************
-
-HRESULT CLCDOutput::SetAsForeground(BOOL bSetAsForeground)
-{
-    m_bSetAsForeground = bSetAsForeground;
-    if (LGLCD_INVALID_DEVICE != m_hDevice)
-    {
-        DWORD dwRes = lgLcdSetAsLCDForegroundApp(m_hDevice, bSetAsForeground);
-        if(ERROR_SUCCESS != dwRes)
-        {
-            return MAKE_HRESULT(SEVERITY_ERROR, 0, dwRes);
-        }
-    }
-    return E_FAIL;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnDraw
-//
-//************************************************************************
-
-BOOL CLCDOutput::OnDraw(void)
-{
-    DWORD dwPriorityToUse = LGLCD_ASYNC_UPDATE(m_nPriority);
-
-    if ( (NULL == m_pActivePage) ||
-        (LGLCD_INVALID_DEVICE == m_hDevice) ||
-        (LGLCD_PRIORITY_IDLE_NO_SHOW == dwPriorityToUse) )
-    {
-        // don't submit the bitmap
-        return TRUE;
-    }
-
-    // Render the active screen
-    m_pGfx->BeginDraw();
-    m_pGfx->ClearScreen();
-    m_pActivePage->OnDraw(*m_pGfx);
-    m_pGfx->EndDraw(); 
-
-    // Get the active bitmap
-    lgLcdBitmap* pBitmap = m_pGfx->GetLCDScreen();
-
-    // Only submit if the bitmap needs to be updated
-    // (If the priority or bitmap have changed)
-    DWORD res = ERROR_SUCCESS;
-    if (DoesBitmapNeedUpdate(pBitmap))
-    {
-        res = lgLcdUpdateBitmap(m_hDevice, &pBitmap->bmp_mono.hdr, dwPriorityToUse);
-        HandleErrorFromAPI(res);
-    }
-
-    return (LGLCD_INVALID_DEVICE != m_hDevice);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnUpdate
-//
-//************************************************************************
-
-void CLCDOutput::OnUpdate(DWORD dwTimestamp)
-{
-    if (m_pActivePage)
-    {
-        m_pActivePage->OnUpdate(dwTimestamp);
-    }
-
-    // check for expiration
-    if (m_pActivePage && m_pActivePage->HasExpired())
-    {
-        m_pActivePage = NULL;
-        //m_nPriority = LGLCD_PRIORITY_FYI; -> needs to go so that if a 
-        // program sets priority to LGLCD_PRIORITY_BACKGROUND, that 
-        // priority sticks.
-
-        OnPageExpired(m_pActivePage);
-
-        // find the next active screen
-        for (size_t i = 0; i < m_Objects.size(); i++)
-        {
-            CLCDPage *pPage = dynamic_cast<CLCDPage*>(m_Objects[i]);
-            LCDUIASSERT(NULL != pPage);
-
-            if (!pPage->HasExpired())
-            {
-                ShowPage(pPage);
-                //m_nPriority = LGLCD_PRIORITY_FYI;  -> needs to go so that if a 
-                // program sets priority to LGLCD_PRIORITY_BACKGROUND, that 
-                // priority sticks.
-                break;
-            }
-        }
-
-        // if no screen found, empty the screen at idle priority
-        if (NULL == m_pActivePage)
-        {
-            OnEnteringIdle();
-            if (LGLCD_INVALID_DEVICE != m_hDevice)
-            {
-                m_pGfx->ClearScreen();
-                lgLcdUpdateBitmap(m_hDevice, &m_pGfx->GetLCDScreen()->bmp_mono.hdr,
-                    LGLCD_ASYNC_UPDATE(LGLCD_PRIORITY_IDLE_NO_SHOW));
-            }
-        }
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::GetSoftButtonState
-//
-//************************************************************************
-
-DWORD CLCDOutput::GetSoftButtonState(void)
-{
-    return IsOpened() ? m_dwButtonState : 0;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::HandleErrorFromAPI
-//
-//************************************************************************
-
-HRESULT CLCDOutput::HandleErrorFromAPI(DWORD dwRes)
-{
-    switch(dwRes)
-    {
-        // all is well
-    case ERROR_SUCCESS:
-    case RPC_S_PROTOCOL_ERROR:
-        break;
-        // we lost our device
-    case ERROR_DEVICE_NOT_CONNECTED:
-        LCDUITRACE(_T("lgLcdAPI returned with ERROR_DEVICE_NOT_CONNECTED, closing device\n"));
-        Close();
-        break;
-    default:
-        LCDUITRACE(_T("lgLcdAPI returned with other error (0x%08x) closing device\n"));
-        Close();
-        // something else happened, such as LCDMon that was terminated
-        break;
-    }
-
-    if(ERROR_SUCCESS != dwRes)
-    {
-        return MAKE_HRESULT(SEVERITY_ERROR, 0, dwRes);
-    }
-
-    return S_OK;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::DoesBitmapNeedUpdate
-//
-//************************************************************************
-
-BOOL CLCDOutput::DoesBitmapNeedUpdate(lgLcdBitmap* pBitmap)
-{
-    UNREFERENCED_PARAMETER(pBitmap);
-    // For now, always update
-    return TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnPageExpired
-//
-//************************************************************************
-
-void CLCDOutput::OnPageExpired(CLCDCollection* pScreen)
-{
-    UNREFERENCED_PARAMETER(pScreen);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnPageShown
-//
-//************************************************************************
-
-void CLCDOutput::OnPageShown(CLCDCollection* pScreen)
-{
-    UNREFERENCED_PARAMETER(pScreen);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnEnteringIdle
-//
-//************************************************************************
-
-void CLCDOutput::OnEnteringIdle(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnClosingDevice
-//
-//************************************************************************
-
-void CLCDOutput::OnClosingDevice(int hDevice)
-{
-    UNREFERENCED_PARAMETER(hDevice);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnOpenedDevice
-//
-//************************************************************************
-
-void CLCDOutput::OnOpenedDevice(int hDevice)
-{
-    UNREFERENCED_PARAMETER(hDevice);
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnSoftButtonEvent
-//
-//************************************************************************
-
-void CLCDOutput::OnSoftButtonEvent(DWORD dwButtonState)
-{
-    if (LGLCD_DEVICE_FAMILY_QVGA_BASIC == m_pGfx->GetFamily())
-    {
-        HandleButtonState(dwButtonState, LGLCDBUTTON_LEFT);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_RIGHT);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_OK);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_CANCEL);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_UP);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_DOWN);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_MENU);
-    }
-    else
-    {
-        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON0);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON1);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON2);
-        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON3);
-    }
-
-    m_dwButtonState = dwButtonState;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::HandleButtonState
-//
-//************************************************************************
-
-void CLCDOutput::HandleButtonState(DWORD dwButtonState, DWORD dwButton)
-{
-    if ( (m_dwButtonState & dwButton) && !(dwButtonState & dwButton) )
-    {
-        LCDUITRACE(_T("Button 0x%x released\n"), dwButton);
-        OnLCDButtonUp(dwButton);
-    }
-    if ( !(m_dwButtonState & dwButton) && (dwButtonState & dwButton) )
-    {
-        LCDUITRACE(_T("Button 0x%x pressed\n"), dwButton);
-        OnLCDButtonDown(dwButton);
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnLCDButtonDown
-//
-//************************************************************************
-
-void CLCDOutput::OnLCDButtonDown(int nButton)
-{
-    if (m_pActivePage)
-    {
-        m_pActivePage->OnLCDButtonDown(nButton);
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::OnLCDButtonUp
-//
-//************************************************************************
-
-void CLCDOutput::OnLCDButtonUp(int nButton)
-{
-    if (m_pActivePage)
-    {
-        m_pActivePage->OnLCDButtonUp(nButton);
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::GetDeviceId
-//
-//************************************************************************
-
-int CLCDOutput::GetDeviceId(void)
-{
-    return m_hDevice;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::StopOpeningByDeviceType
-//
-//************************************************************************
-
-void CLCDOutput::StopOpeningByDeviceType(void)
-{
-    m_OpenByTypeContext.deviceType = 0;
-}
-
-
-//************************************************************************
-//
-// CLCDOutput::HasBeenOpenedByDeviceType
-//
-//************************************************************************
-
-BOOL CLCDOutput::HasBeenOpenedByDeviceType(void)
-{
-    return (0 != m_OpenByTypeContext.deviceType);
-}
-
-
-//** end of LCDOutput.cpp ************************************************
+//************************************************************************
+//
+// LCDOutput.cpp
+//
+// The CLCDOutput manages the actual device and the various pages that
+// are sent to that device
+// 
+// This class is now managed by CLCDConnection. You no longer need to 
+// derive or instantiate this class yourself
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define LCDUI_SSE2
+#endif
+
+
+//************************************************************************
+//
+// CLCDOutput::CLCDOutput
+//
+//************************************************************************
+
+CLCDOutput::CLCDOutput(void)
+:   m_pActivePage(NULL),
+    m_hDevice(LGLCD_INVALID_DEVICE),
+    m_bSetAsForeground(FALSE),
+    m_dwButtonState(0),
+    m_nPriority(LGLCD_PRIORITY_NORMAL),
+    m_pGfx(NULL),
+    m_pTileRenderer(NULL),
+    m_nTileThreads(0),
+    m_dwLastFormat(0),
+    m_dwLastPriority(LGLCD_PRIORITY_NORMAL),
+    m_bLastFrameValid(FALSE),
+    m_dwSubmittedFrames(0),
+    m_dwSuppressedFrames(0),
+    m_bPartialRedraw(FALSE),
+    m_bRedrawAll(TRUE),
+    m_dwRenderCount(0),
+    m_dwUpdateCount(1),
+    m_dwRenderedUpdate(0),
+    m_pMirrorSource(NULL),
+    m_eMirrorDither(CLCDDither::DITHER_ORDERED),
+    m_dwMirroredCount(0),
+    m_pSubmitQueue(NULL),
+    m_hSubmitThread(NULL),
+    m_bSwapBuffer(FALSE),
+    m_dwDroppedFrames(0)
+{
+    ZeroMemory(&m_OpenByTypeContext, sizeof(m_OpenByTypeContext));
+    SetRectEmpty(&m_rcMirrorSource);
+    for (int i = 0; i < FRAME_RING_SIZE; i++)
+    {
+        SetRectEmpty(&m_arcBufferDamage[i]);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::~CLCDOutput
+//
+//************************************************************************
+
+CLCDOutput::~CLCDOutput(void)
+{
+    Shutdown();
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::SetGfx
+//
+//************************************************************************
+
+void CLCDOutput::SetGfx(CLCDGfxBase *gfx)
+{
+    // the queued frames live in the buffers of the old surface
+    BOOL bPipelined = IsPipelinedSubmit();
+    if (bPipelined)
+    {
+        StopSubmitThread();
+    }
+
+    m_pGfx = gfx;
+    m_bRedrawAll = TRUE;
+
+    if (bPipelined && (NULL != m_pGfx))
+    {
+        EnablePipelinedSubmit(TRUE);
+    }
+
+    // the workers draw into views of the old surface
+    if (NULL != m_pTileRenderer)
+    {
+        m_pTileRenderer->Shutdown();
+        if (NULL != m_pGfx)
+        {
+            m_pTileRenderer->Initialize(m_pGfx, m_nTileThreads);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::Open
+//
+//************************************************************************
+
+BOOL CLCDOutput::Open(lgLcdOpenContext & OpenContext)
+{
+    //Close the old device if there is one
+    Close();
+
+    DWORD res = lgLcdOpen(&OpenContext);
+    if (ERROR_SUCCESS != res)
+    {
+        if( res == ERROR_INVALID_PARAMETER )
+        {
+            LCDUITRACE( _T("Open failed: invalid parameter.\n") );
+            return FALSE;
+        }
+        else if( res == ERROR_ALREADY_EXISTS )
+        {
+            LCDUITRACE( _T("Open failed: already exists.\n") );
+            return FALSE;
+        }
+        return FALSE;
+    }
+
+    m_hDevice = OpenContext.device;
+    m_dwButtonState = 0;
+    InvalidateLastFrame();
+
+    // restores
+    SetAsForeground(m_bSetAsForeground);
+
+    OnOpenedDevice(m_hDevice);
+
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OpenByType
+//
+//************************************************************************
+
+BOOL CLCDOutput::OpenByType(lgLcdOpenByTypeContext &OpenContext)
+{
+    //Close the old device if there is one
+    Close();
+
+    DWORD res = lgLcdOpenByType(&OpenContext);
+    if (ERROR_SUCCESS != res)
+    {
+        if( res == ERROR_INVALID_PARAMETER )
+        {
+            LCDUITRACE( _T("Open failed: invalid parameter.\n") );
+            return FALSE;
+        }
+        else if( res == ERROR_ALREADY_EXISTS )
+        {
+            LCDUITRACE( _T("Open failed: already exists.\n") );
+            return FALSE;
+        }
+        return FALSE;
+    }
+
+    m_hDevice = OpenContext.device;
+    m_dwButtonState = 0;
+    InvalidateLastFrame();
+
+    // restores
+    SetAsForeground(m_bSetAsForeground);
+
+    m_OpenByTypeContext = OpenContext;
+
+    OnOpenedDevice(m_hDevice);
+
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::ReOpenDeviceType
+//
+//************************************************************************
+
+BOOL CLCDOutput::ReOpenDeviceType(void)
+{
+    // The device type must be active
+    if (!HasBeenOpenedByDeviceType())
+    {
+        return FALSE;
+    }
+
+    return OpenByType(m_OpenByTypeContext);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::Close
+//
+//************************************************************************
+
+void CLCDOutput::Close(void)
+{
+    if( LGLCD_INVALID_DEVICE != m_hDevice )
+    {
+        OnClosingDevice(m_hDevice);
+        // the worker must be done with the handle before it goes away
+        FlushSubmitQueue();
+        lgLcdClose(m_hDevice);
+        m_hDevice = LGLCD_INVALID_DEVICE;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::Shutdown
+//
+//************************************************************************
+
+void CLCDOutput::Shutdown(void)
+{
+    Close();
+    StopSubmitThread();
+    EnableTileRendering(FALSE);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::AddPage
+//
+//************************************************************************
+
+void CLCDOutput::AddPage(CLCDPage *pPage)
+{
+    pPage->Initialize();
+    AddObject(pPage);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::RemovePage
+//
+//************************************************************************
+
+void CLCDOutput::RemovePage(CLCDPage *pPage)
+{
+    RemoveObject(pPage);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::ShowPage
+//
+//************************************************************************
+
+void CLCDOutput::ShowPage(CLCDPage *pPage, BOOL bShow)
+{
+    LCDUIASSERT(NULL != pPage);
+
+    if (bShow)
+    {
+        m_pActivePage = pPage;
+        m_bRedrawAll = TRUE;
+
+        SetAsForeground(m_bSetAsForeground);
+
+        OnPageShown(pPage);
+    }
+    else
+    {
+        // Expire it and update
+        pPage->SetExpiration(0);
+        OnUpdate(CLCDClock::Now());
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetShowingPage
+//
+//************************************************************************
+
+CLCDPage* CLCDOutput::GetShowingPage(void)
+{
+    return m_pActivePage;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::SetScreenPriority
+//
+//************************************************************************
+
+void CLCDOutput::SetScreenPriority(DWORD priority)
+{
+    // Priority has changed
+    // If we're going into idle, send an idle frame
+    if (LGLCD_PRIORITY_IDLE_NO_SHOW == priority)
+    {
+        SubmitFrame(m_pGfx->GetLCDScreen(),
+            LGLCD_ASYNC_UPDATE(LGLCD_PRIORITY_IDLE_NO_SHOW));
+        InvalidateLastFrame();
+    }
+
+    m_nPriority = priority;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetScreenPriority
+//
+//************************************************************************
+
+DWORD CLCDOutput::GetScreenPriority(void)
+{
+    return m_nPriority;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::IsOpened
+//
+//************************************************************************
+
+BOOL CLCDOutput::IsOpened(void)
+{
+    return (LGLCD_INVALID_DEVICE != m_hDevice);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::SetAsForeground
+//
+//************************************************************************
+
+HRESULT CLCDOutput::SetAsForeground(BOOL bSetAsForeground)
+{
+    m_bSetAsForeground = bSetAsForeground;
+    if (LGLCD_INVALID_DEVICE != m_hDevice)
+    {
+        DWORD dwRes = lgLcdSetAsLCDForegroundApp(m_hDevice, bSetAsForeground);
+        if(ERROR_SUCCESS != dwRes)
+        {
+            return MAKE_HRESULT(SEVERITY_ERROR, 0, dwRes);
+        }
+    }
+    return E_FAIL;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnDraw
+//
+//************************************************************************
+
+BOOL CLCDOutput::OnDraw(void)
+{
+    DWORD dwPriorityToUse = LGLCD_ASYNC_UPDATE(m_nPriority);
+    CLCDPage* pPage = (NULL != m_pMirrorSource) ?
+        m_pMirrorSource->GetShowingPage() : m_pActivePage;
+
+    if ( (NULL == pPage) ||
+        (LGLCD_INVALID_DEVICE == m_hDevice) ||
+        (LGLCD_PRIORITY_IDLE_NO_SHOW == dwPriorityToUse) )
+    {
+        // don't submit the bitmap
+        return TRUE;
+    }
+
+    if (NULL != m_pMirrorSource)
+    {
+        RenderMirror();
+    }
+    else
+    {
+        RenderActivePage();
+    }
+
+    // Get the active bitmap
+    lgLcdBitmap* pBitmap = m_pGfx->GetLCDScreen();
+
+    // Only submit if the bitmap needs to be updated
+    // (If the priority or bitmap have changed)
+    DWORD res = ERROR_SUCCESS;
+    if (DoesBitmapNeedUpdate(pBitmap))
+    {
+        // With pipelined submission this is the result of an earlier frame
+        res = SubmitFrame(pBitmap, dwPriorityToUse);
+        if (ERROR_SUCCESS != res)
+        {
+            // the device may not have this frame, so send the next one
+            InvalidateLastFrame();
+        }
+        m_dwSubmittedFrames++;
+        HandleErrorFromAPI(res);
+    }
+    else
+    {
+        m_dwSuppressedFrames++;
+    }
+
+    return (LGLCD_INVALID_DEVICE != m_hDevice);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::RenderActivePage
+//
+// Renders the active page, or the part of it that changed
+//
+//************************************************************************
+
+void CLCDOutput::RenderActivePage(void)
+{
+    if (NULL == m_pActivePage)
+    {
+        return;
+    }
+    AcquireBuffer();
+
+    // Find the area that changed since the last frame, and since the
+    // current screen buffer was last drawn
+    RECT rcScreen = { 0, 0, m_pGfx->GetWidth(), m_pGfx->GetHeight() };
+    RECT rcDamage = rcScreen;
+    BOOL bPartial = (m_bPartialRedraw && !m_bRedrawAll && !m_pActivePage->IsDirty());
+    if (bPartial)
+    {
+        SetRectEmpty(&rcDamage);
+        m_pActivePage->GetDamage(rcDamage);
+        UnionRect(&rcDamage, &rcDamage, &m_arcBufferDamage[m_pGfx->GetCurrentBuffer()]);
+        IntersectRect(&rcDamage, &rcDamage, &rcScreen);
+    }
+
+    // Render the active screen, or the part of it that changed
+    if (!IsRectEmpty(&rcDamage))
+    {
+        m_pGfx->BeginDraw();
+        if (bPartial && !EqualRect(&rcDamage, &rcScreen))
+        {
+            m_pGfx->ClearRect(rcDamage);
+            m_pGfx->SetDamageRect(&rcDamage);
+        }
+        else
+        {
+            m_pGfx->ClearScreen();
+        }
+        if ((NULL == m_pTileRenderer) || !m_pTileRenderer->Render(*m_pActivePage, rcDamage))
+        {
+            m_pActivePage->OnDraw(*m_pGfx);
+        }
+        m_pGfx->SetDamageRect(NULL);
+        m_pGfx->EndDraw(); 
+        m_dwRenderCount++;
+    }
+    MarkBufferDrawn(rcDamage);
+    m_pActivePage->ClearDamage();
+    m_bRedrawAll = FALSE;
+    m_dwRenderedUpdate = m_dwUpdateCount;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::RenderMirror
+//
+// Renders the page of the mirror source on its own surface, then scales
+// that surface down to the luminance of this one and dithers it.
+//
+//************************************************************************
+
+void CLCDOutput::RenderMirror(void)
+{
+    CLCDGfxBase* pSourceGfx = m_pMirrorSource->m_pGfx;
+    if ((NULL == pSourceGfx) || (NULL == m_pGfx))
+    {
+        return;
+    }
+
+    // the source usually has drawn this update already, on its own device
+    if (m_pMirrorSource->m_bRedrawAll ||
+        (m_pMirrorSource->m_dwRenderedUpdate != m_pMirrorSource->m_dwUpdateCount))
+    {
+        m_pMirrorSource->RenderActivePage();
+    }
+    AcquireBuffer();
+    if (!m_bRedrawAll && IsRectEmpty(&m_arcBufferDamage[m_pGfx->GetCurrentBuffer()]) &&
+        (m_dwMirroredCount == m_pMirrorSource->m_dwRenderCount))
+    {
+        return;
+    }
+    m_dwMirroredCount = m_pMirrorSource->m_dwRenderCount;
+    m_bRedrawAll = FALSE;
+
+    lgLcdBitmap* pSource = pSourceGfx->GetLCDScreen();
+    if ((NULL == pSource) || (LGLCD_BMP_FORMAT_QVGAx32 != pSource->hdr.Format))
+    {
+        LCDUITRACE(_T("CLCDOutput::RenderMirror(): the source is not a QVGA surface\n"));
+        return;
+    }
+
+    RECT rcSource = { 0, 0, pSourceGfx->GetWidth(), pSourceGfx->GetHeight() };
+    if (!IsRectEmpty(&m_rcMirrorSource))
+    {
+        IntersectRect(&rcSource, &rcSource, &m_rcMirrorSource);
+        if (IsRectEmpty(&rcSource))
+        {
+            return;
+        }
+    }
+
+    int nWidth = m_pGfx->GetWidth();
+    int nHeight = m_pGfx->GetHeight();
+    int nSourcePitch = pSourceGfx->GetWidth() * 4;
+    int nPackedPitch = CLCDDither::GetPackedPitch(nWidth);
+    m_MirrorLuma.resize((size_t)nWidth * nHeight);
+    m_MirrorBits.resize((size_t)nPackedPitch * nHeight);
+
+    CLCDDither::DownscaleLuminance(
+        pSource->bmp_qvga32.pixels + rcSource.top * nSourcePitch + rcSource.left * 4,
+        nSourcePitch, rcSource.right - rcSource.left, rcSource.bottom - rcSource.top,
+        &m_MirrorLuma[0], nWidth, nWidth, nHeight);
+    CLCDDither::DitherLuminance(&m_MirrorLuma[0], nWidth, nWidth, nHeight,
+        &m_MirrorBits[0], nPackedPitch, m_eMirrorDither);
+
+    CLCDGfxSoft* pSoft = m_pGfx->GetSoftSurface();
+    if (NULL != pSoft)
+    {
+        m_pGfx->BeginDraw();
+        pSoft->BlitPacked(0, 0, nWidth, nHeight, &m_MirrorBits[0], nPackedPitch);
+        m_pGfx->EndDraw();
+    }
+    else
+    {
+        // the mono surface is the payload itself, one byte per pixel
+        PBYTE pPixels = m_pGfx->GetLCDScreen()->bmp_mono.pixels;
+        for (int y = 0; y < nHeight; y++)
+        {
+            CLCDGfxSoft::ExpandPackedRow(&m_MirrorBits[(size_t)y * nPackedPitch],
+                                         pPixels + y * nWidth, nWidth);
+        }
+    }
+    RECT rcScreen = { 0, 0, nWidth, nHeight };
+    MarkBufferDrawn(rcScreen);
+    m_dwRenderCount++;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnUpdate
+//
+//************************************************************************
+
+void CLCDOutput::OnUpdate(DWORD dwTimestamp)
+{
+    m_dwUpdateCount++;
+
+    // without a device of its own, the source is only updated through here
+    if (m_pMirrorSource && !m_pMirrorSource->IsOpened())
+    {
+        m_pMirrorSource->OnUpdate(dwTimestamp);
+    }
+
+    if (m_pActivePage)
+    {
+        m_pActivePage->OnUpdate(dwTimestamp);
+    }
+
+    // check for expiration
+    if (m_pActivePage && m_pActivePage->HasExpired())
+    {
+        m_pActivePage = NULL;
+        //m_nPriority = LGLCD_PRIORITY_FYI; -> needs to go so that if a 
+        // program sets priority to LGLCD_PRIORITY_BACKGROUND, that 
+        // priority sticks.
+
+        OnPageExpired(m_pActivePage);
+
+        // find the next active screen
+        for (size_t i = 0; i < m_Objects.size(); i++)
+        {
+            CLCDPage *pPage = dynamic_cast<CLCDPage*>(m_Objects[i]);
+            LCDUIASSERT(NULL != pPage);
+
+            if (!pPage->HasExpired())
+            {
+                ShowPage(pPage);
+                //m_nPriority = LGLCD_PRIORITY_FYI;  -> needs to go so that if a 
+                // program sets priority to LGLCD_PRIORITY_BACKGROUND, that 
+                // priority sticks.
+                break;
+            }
+        }
+
+        // if no screen found, empty the screen at idle priority
+        if (NULL == m_pActivePage)
+        {
+            OnEnteringIdle();
+            if (LGLCD_INVALID_DEVICE != m_hDevice)
+            {
+                AcquireBuffer();
+                m_pGfx->ClearScreen();
+                SubmitFrame(m_pGfx->GetLCDScreen(),
+                    LGLCD_ASYNC_UPDATE(LGLCD_PRIORITY_IDLE_NO_SHOW));
+                InvalidateLastFrame();
+                m_bRedrawAll = TRUE;
+            }
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetSoftButtonState
+//
+//************************************************************************
+
+DWORD CLCDOutput::GetSoftButtonState(void)
+{
+    return IsOpened() ? m_dwButtonState : 0;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::HandleErrorFromAPI
+//
+//************************************************************************
+
+HRESULT CLCDOutput::HandleErrorFromAPI(DWORD dwRes)
+{
+    switch(dwRes)
+    {
+        // all is well
+    case ERROR_SUCCESS:
+    case RPC_S_PROTOCOL_ERROR:
+        break;
+        // we lost our device
+    case ERROR_DEVICE_NOT_CONNECTED:
+        LCDUITRACE(_T("lgLcdAPI returned with ERROR_DEVICE_NOT_CONNECTED, closing device\n"));
+        Close();
+        break;
+    default:
+        LCDUITRACE(_T("lgLcdAPI returned with other error (0x%08x) closing device\n"));
+        Close();
+        // something else happened, such as LCDMon that was terminated
+        break;
+    }
+
+    if(ERROR_SUCCESS != dwRes)
+    {
+        return MAKE_HRESULT(SEVERITY_ERROR, 0, dwRes);
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::DoesBitmapNeedUpdate
+//
+//************************************************************************
+
+BOOL CLCDOutput::DoesBitmapNeedUpdate(lgLcdBitmap* pBitmap)
+{
+    LCDUIASSERT(NULL != pBitmap);
+
+    int nRowBytes = 0;
+    int nRows = 0;
+    switch(pBitmap->hdr.Format)
+    {
+    case LGLCD_BMP_FORMAT_160x43x1:
+        nRowBytes = LGLCD_BMP_WIDTH * LGLCD_BMP_BPP;
+        nRows = LGLCD_BMP_HEIGHT;
+        break;
+    case LGLCD_BMP_FORMAT_QVGAx32:
+        nRowBytes = LGLCD_QVGA_BMP_WIDTH * LGLCD_QVGA_BMP_BPP;
+        nRows = LGLCD_QVGA_BMP_HEIGHT;
+        break;
+    default:
+        // unknown layout, always update
+        return TRUE;
+    }
+
+    const BYTE *pPixels = pBitmap->bmp_mono.pixels;
+    size_t nFrameBytes = (size_t)nRowBytes * nRows;
+
+    // A new priority must reach the device even if the pixels did not change
+    if (!m_bLastFrameValid ||
+        (m_dwLastFormat != pBitmap->hdr.Format) ||
+        (m_dwLastPriority != m_nPriority) ||
+        (m_LastFrame.size() != nFrameBytes))
+    {
+        m_LastFrame.assign(pPixels, pPixels + nFrameBytes);
+        m_dwLastFormat = pBitmap->hdr.Format;
+        m_dwLastPriority = m_nPriority;
+        m_bLastFrameValid = TRUE;
+        return TRUE;
+    }
+
+    BOOL bChanged = FALSE;
+    PBYTE pLast = &m_LastFrame[0];
+    for (int y = 0; y < nRows; y++)
+    {
+        if (CompareAndCopyRow(pPixels, pLast, nRowBytes))
+        {
+            bChanged = TRUE;
+        }
+        pPixels += nRowBytes;
+        pLast += nRowBytes;
+    }
+
+    return bChanged;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::CompareAndCopyRow
+//
+// Returns TRUE and refreshes the copy if the row differs from it.
+//
+//************************************************************************
+
+BOOL CLCDOutput::CompareAndCopyRow(const BYTE *pSrc, PBYTE pDst, int nBytes)
+{
+    int i = 0;
+
+#ifdef LCDUI_SSE2
+    // both row sizes are multiples of 16 bytes
+    int nMask = 0xFFFF;
+    for (; i + 16 <= nBytes; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(pSrc + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(pDst + i));
+        nMask &= _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+    }
+    BOOL bChanged = (0xFFFF != nMask);
+#else
+    BOOL bChanged = FALSE;
+#endif
+
+    if (!bChanged && (i < nBytes))
+    {
+        bChanged = (0 != memcmp(pSrc + i, pDst + i, nBytes - i));
+    }
+
+    if (bChanged)
+    {
+        memcpy(pDst, pSrc, nBytes);
+    }
+
+    return bChanged;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetSubmittedFrameCount
+//
+//************************************************************************
+
+DWORD CLCDOutput::GetSubmittedFrameCount(void)
+{
+    return m_dwSubmittedFrames;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetSuppressedFrameCount
+//
+//************************************************************************
+
+DWORD CLCDOutput::GetSuppressedFrameCount(void)
+{
+    return m_dwSuppressedFrames;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::ResetFrameCounters
+//
+//************************************************************************
+
+void CLCDOutput::ResetFrameCounters(void)
+{
+    m_dwSubmittedFrames = 0;
+    m_dwSuppressedFrames = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::InvalidateLastFrame
+//
+//************************************************************************
+
+void CLCDOutput::InvalidateLastFrame(void)
+{
+    m_bLastFrameValid = FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::EnablePartialRedraw
+//
+//************************************************************************
+
+void CLCDOutput::EnablePartialRedraw(BOOL bEnable)
+{
+    m_bPartialRedraw = bEnable;
+    m_bRedrawAll = TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::SetMirrorSource
+//
+//************************************************************************
+
+void CLCDOutput::SetMirrorSource(CLCDOutput *pSource, CLCDDither::eDITHER_MODE eMode,
+                                 const RECT *prcSource)
+{
+    LCDUIASSERT(this != pSource);
+
+    m_pMirrorSource = (this != pSource) ? pSource : NULL;
+    m_eMirrorDither = eMode;
+    if (NULL != prcSource)
+    {
+        m_rcMirrorSource = *prcSource;
+    }
+    else
+    {
+        SetRectEmpty(&m_rcMirrorSource);
+    }
+
+    m_bRedrawAll = TRUE;
+    if (NULL == m_pMirrorSource)
+    {
+        m_MirrorLuma.clear();
+        m_MirrorBits.clear();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetMirrorSource
+//
+//************************************************************************
+
+CLCDOutput* CLCDOutput::GetMirrorSource(void)
+{
+    return m_pMirrorSource;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::EnablePipelinedSubmit
+//
+//************************************************************************
+
+HRESULT CLCDOutput::EnablePipelinedSubmit(BOOL bEnable)
+{
+    if (!bEnable)
+    {
+        StopSubmitThread();
+        return S_OK;
+    }
+
+    if (NULL != m_hSubmitThread)
+    {
+        return S_OK;
+    }
+
+    // one buffer is drawn, one waits and one is being submitted
+    if ((NULL == m_pGfx) || FAILED(m_pGfx->SetBufferCount(FRAME_RING_SIZE)))
+    {
+        LCDUITRACE(_T("Could not create the screen buffers for pipelined submission\n"));
+        return E_FAIL;
+    }
+    m_bRedrawAll = TRUE;
+
+    SUBMITQUEUE* pQueue = new SUBMITQUEUE;
+    ZeroMemory(pQueue, sizeof(SUBMITQUEUE));
+    pQueue->nRefs = 1;
+    pQueue->nPending = NO_FRAME;
+    pQueue->nSubmitting = NO_FRAME;
+    pQueue->dwResult = ERROR_SUCCESS;
+    pQueue->hResultDevice = LGLCD_INVALID_DEVICE;
+    InitializeCriticalSection(&pQueue->cs);
+    m_pSubmitQueue = pQueue;
+    m_bSwapBuffer = FALSE;
+
+    pQueue->hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    pQueue->hIdle = CreateEvent(NULL, TRUE, TRUE, NULL);
+    if ((NULL != pQueue->hEvent) && (NULL != pQueue->hIdle))
+    {
+        // the reference of the worker
+        InterlockedIncrement(&pQueue->nRefs);
+        m_hSubmitThread = CreateThread(NULL, 0, _SubmitThreadProc, pQueue, 0, NULL);
+        if (NULL == m_hSubmitThread)
+        {
+            InterlockedDecrement(&pQueue->nRefs);
+        }
+    }
+
+    if (NULL == m_hSubmitThread)
+    {
+        LCDUITRACE(_T("Could not start the submit thread\n"));
+        StopSubmitThread();
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::IsPipelinedSubmit
+//
+//************************************************************************
+
+BOOL CLCDOutput::IsPipelinedSubmit(void)
+{
+    return (NULL != m_hSubmitThread);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetDroppedFrameCount
+//
+//************************************************************************
+
+DWORD CLCDOutput::GetDroppedFrameCount(void)
+{
+    DWORD dwDropped = m_dwDroppedFrames;
+    if (NULL != m_pSubmitQueue)
+    {
+        EnterCriticalSection(&m_pSubmitQueue->cs);
+        dwDropped += m_pSubmitQueue->dwDropped;
+        LeaveCriticalSection(&m_pSubmitQueue->cs);
+    }
+    return dwDropped;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::EnableTileRendering
+//
+//************************************************************************
+
+HRESULT CLCDOutput::EnableTileRendering(BOOL bEnable, int nThreads)
+{
+    if (!bEnable)
+    {
+        if (NULL != m_pTileRenderer)
+        {
+            delete m_pTileRenderer;
+            m_pTileRenderer = NULL;
+        }
+        return S_OK;
+    }
+
+    if (NULL == m_pGfx)
+    {
+        return E_FAIL;
+    }
+
+    if (NULL == m_pTileRenderer)
+    {
+        m_pTileRenderer = new CLCDTileRenderer();
+    }
+    m_nTileThreads = nThreads;
+
+    HRESULT hRes = m_pTileRenderer->Initialize(m_pGfx, m_nTileThreads);
+    if (FAILED(hRes))
+    {
+        LCDUITRACE(_T("Could not start the tile renderer\n"));
+        delete m_pTileRenderer;
+        m_pTileRenderer = NULL;
+    }
+    return hRes;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::IsTileRendering
+//
+//************************************************************************
+
+BOOL CLCDOutput::IsTileRendering(void)
+{
+    return (NULL != m_pTileRenderer);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::SubmitFrame
+//
+// Sends the bitmap to the device, or queues it for the submit thread.
+// In the latter case, the returned error belongs to an earlier frame.
+//
+//************************************************************************
+
+DWORD CLCDOutput::SubmitFrame(lgLcdBitmap *pBitmap, DWORD dwPriority)
+{
+    if (NULL == m_hSubmitThread)
+    {
+        return lgLcdUpdateBitmap(m_hDevice, &pBitmap->bmp_mono.hdr, dwPriority);
+    }
+
+    if (LGLCD_INVALID_DEVICE == m_hDevice)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    return QueueFrame(pBitmap, dwPriority);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::QueueFrame
+//
+// Makes the current screen buffer the pending frame. Nothing is copied,
+// the next frame is drawn into another buffer, see AcquireBuffer().
+//
+//************************************************************************
+
+DWORD CLCDOutput::QueueFrame(lgLcdBitmap *pBitmap, DWORD dwPriority)
+{
+    SUBMITQUEUE* pQueue = m_pSubmitQueue;
+    int nSlot = m_pGfx->GetCurrentBuffer();
+    LCDUIASSERT(pBitmap == m_pGfx->GetLCDScreen());
+    DWORD dwRes = ERROR_SUCCESS;
+
+    EnterCriticalSection(&pQueue->cs);
+    // only report failures of frames that went to the current device
+    if (pQueue->hResultDevice == m_hDevice)
+    {
+        dwRes = pQueue->dwResult;
+    }
+    pQueue->dwResult = ERROR_SUCCESS;
+    pQueue->hResultDevice = LGLCD_INVALID_DEVICE;
+
+    if ((NO_FRAME != pQueue->nPending) && (nSlot != pQueue->nPending))
+    {
+        // the worker is still busy with an older frame, this one wins
+        pQueue->dwDropped++;
+    }
+    pQueue->apFrame[nSlot] = pBitmap;
+    pQueue->adwPriority[nSlot] = dwPriority;
+    pQueue->ahDevice[nSlot] = m_hDevice;
+    pQueue->nPending = nSlot;
+    LeaveCriticalSection(&pQueue->cs);
+
+    SetEvent(pQueue->hEvent);
+    m_bSwapBuffer = TRUE;
+
+    return dwRes;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::AcquireBuffer
+//
+// Before drawing, switches to a screen buffer that the worker is not
+// using, if the current one was queued. The switch is deferred until
+// then, so that outputs mirroring this one still see the last frame.
+// The buffer holds an older frame, m_arcBufferDamage says what to redraw.
+//
+//************************************************************************
+
+void CLCDOutput::AcquireBuffer(void)
+{
+    if (!m_bSwapBuffer || (NULL == m_pSubmitQueue))
+    {
+        return;
+    }
+
+    // with three buffers, one is always neither pending nor submitted
+    int nBuffer = NO_FRAME;
+    EnterCriticalSection(&m_pSubmitQueue->cs);
+    for (int i = 0; i < m_pGfx->GetBufferCount(); i++)
+    {
+        if ((i != m_pSubmitQueue->nPending) && (i != m_pSubmitQueue->nSubmitting))
+        {
+            nBuffer = i;
+            break;
+        }
+    }
+    LeaveCriticalSection(&m_pSubmitQueue->cs);
+
+    LCDUIASSERT(NO_FRAME != nBuffer);
+    if (NO_FRAME == nBuffer)
+    {
+        return;
+    }
+
+    m_pGfx->SelectBuffer(nBuffer);
+    m_bSwapBuffer = FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::MarkBufferDrawn
+//
+// Records that rcDrawn was drawn into the current screen buffer, which
+// is up to date now. The other buffers miss that change.
+//
+//************************************************************************
+
+void CLCDOutput::MarkBufferDrawn(const RECT &rcDrawn)
+{
+    int nCurrent = m_pGfx->GetCurrentBuffer();
+    for (int i = 0; (i < m_pGfx->GetBufferCount()) && (i < FRAME_RING_SIZE); i++)
+    {
+        if (i == nCurrent)
+        {
+            SetRectEmpty(&m_arcBufferDamage[i]);
+        }
+        else
+        {
+            UnionRect(&m_arcBufferDamage[i], &m_arcBufferDamage[i], &rcDrawn);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::FlushSubmitQueue
+//
+// Drops the pending frame and waits for the one being submitted.
+//
+//************************************************************************
+
+void CLCDOutput::FlushSubmitQueue(void)
+{
+    if (NULL == m_hSubmitThread)
+    {
+        return;
+    }
+
+    EnterCriticalSection(&m_pSubmitQueue->cs);
+    m_pSubmitQueue->nPending = NO_FRAME;
+    LeaveCriticalSection(&m_pSubmitQueue->cs);
+
+    if (WAIT_OBJECT_0 != WaitForSingleObject(m_pSubmitQueue->hIdle, SUBMIT_TIMEOUT))
+    {
+        // the device does not answer, the submit fails once it is closed
+        LCDUITRACE(_T("CLCDOutput::FlushSubmitQueue(): the device does not take the frame\n"));
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::StopSubmitThread
+//
+//************************************************************************
+
+void CLCDOutput::StopSubmitThread(void)
+{
+    if (NULL != m_hSubmitThread)
+    {
+        EnterCriticalSection(&m_pSubmitQueue->cs);
+        m_pSubmitQueue->bStop = TRUE;
+        m_pSubmitQueue->nPending = NO_FRAME;
+        LeaveCriticalSection(&m_pSubmitQueue->cs);
+
+        SetEvent(m_pSubmitQueue->hEvent);
+        if (WAIT_OBJECT_0 != WaitForSingleObject(m_hSubmitThread, SUBMIT_TIMEOUT))
+        {
+            // The worker hangs in lgLcdUpdateBitmap() and reads one of the
+            // screen buffers until the call returns, so they cannot be
+            // freed before. Closing the device ends the call.
+            LCDUITRACE(_T("CLCDOutput::StopSubmitThread(): waiting for the submit thread\n"));
+            WaitForSingleObject(m_hSubmitThread, INFINITE);
+        }
+        CloseHandle(m_hSubmitThread);
+        m_hSubmitThread = NULL;
+    }
+
+    if (NULL != m_pSubmitQueue)
+    {
+        EnterCriticalSection(&m_pSubmitQueue->cs);
+        m_dwDroppedFrames += m_pSubmitQueue->dwDropped;
+        m_pSubmitQueue->dwDropped = 0;
+        LeaveCriticalSection(&m_pSubmitQueue->cs);
+
+        ReleaseSubmitQueue(m_pSubmitQueue);
+        m_pSubmitQueue = NULL;
+    }
+    m_bSwapBuffer = FALSE;
+
+    if ((NULL != m_pGfx) && (1 < m_pGfx->GetBufferCount()))
+    {
+        m_pGfx->SetBufferCount(1);
+        m_bRedrawAll = TRUE;
+    }
+
+    // frames that were dropped may never have reached the device
+    InvalidateLastFrame();
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::ReleaseSubmitQueue
+//
+//************************************************************************
+
+void CLCDOutput::ReleaseSubmitQueue(SUBMITQUEUE *pQueue)
+{
+    if (0 != InterlockedDecrement(&pQueue->nRefs))
+    {
+        return;
+    }
+
+    if (NULL != pQueue->hEvent)
+    {
+        CloseHandle(pQueue->hEvent);
+    }
+    if (NULL != pQueue->hIdle)
+    {
+        CloseHandle(pQueue->hIdle);
+    }
+    DeleteCriticalSection(&pQueue->cs);
+    delete pQueue;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::_SubmitThreadProc
+//
+//************************************************************************
+
+DWORD WINAPI CLCDOutput::_SubmitThreadProc(LPVOID pContext)
+{
+    SUBMITQUEUE* pQueue = (SUBMITQUEUE*)pContext;
+    SubmitThreadLoop(pQueue);
+    ReleaseSubmitQueue(pQueue);
+    return 0;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::SubmitThreadLoop
+//
+//************************************************************************
+
+void CLCDOutput::SubmitThreadLoop(SUBMITQUEUE *pQueue)
+{
+    for (;;)
+    {
+        WaitForSingleObject(pQueue->hEvent, SUBMIT_TIMEOUT);
+
+        // submit until no frame is left, a new one may arrive meanwhile
+        for (;;)
+        {
+            EnterCriticalSection(&pQueue->cs);
+            if (pQueue->bStop)
+            {
+                LeaveCriticalSection(&pQueue->cs);
+                return;
+            }
+            int nSlot = pQueue->nPending;
+            if (NO_FRAME == nSlot)
+            {
+                LeaveCriticalSection(&pQueue->cs);
+                break;
+            }
+            pQueue->nPending = NO_FRAME;
+            pQueue->nSubmitting = nSlot;
+            ResetEvent(pQueue->hIdle);
+            LeaveCriticalSection(&pQueue->cs);
+
+            // the output does not draw into this buffer until it is done
+            DWORD dwRes = lgLcdUpdateBitmap(pQueue->ahDevice[nSlot],
+                &pQueue->apFrame[nSlot]->bmp_mono.hdr, pQueue->adwPriority[nSlot]);
+
+            EnterCriticalSection(&pQueue->cs);
+            if (ERROR_SUCCESS != dwRes)
+            {
+                pQueue->dwResult = dwRes;
+                pQueue->hResultDevice = pQueue->ahDevice[nSlot];
+            }
+            pQueue->nSubmitting = NO_FRAME;
+            SetEvent(pQueue->hIdle);
+            LeaveCriticalSection(&pQueue->cs);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnPageExpired
+//
+//************************************************************************
+
+void CLCDOutput::OnPageExpired(CLCDCollection* pScreen)
+{
+    UNREFERENCED_PARAMETER(pScreen);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnPageShown
+//
+//************************************************************************
+
+void CLCDOutput::OnPageShown(CLCDCollection* pScreen)
+{
+    UNREFERENCED_PARAMETER(pScreen);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnEnteringIdle
+//
+//************************************************************************
+
+void CLCDOutput::OnEnteringIdle(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnClosingDevice
+//
+//************************************************************************
+
+void CLCDOutput::OnClosingDevice(int hDevice)
+{
+    UNREFERENCED_PARAMETER(hDevice);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnOpenedDevice
+//
+//************************************************************************
+
+void CLCDOutput::OnOpenedDevice(int hDevice)
+{
+    UNREFERENCED_PARAMETER(hDevice);
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnSoftButtonEvent
+//
+//************************************************************************
+
+void CLCDOutput::OnSoftButtonEvent(DWORD dwButtonState)
+{
+    if (LGLCD_DEVICE_FAMILY_QVGA_BASIC == m_pGfx->GetFamily())
+    {
+        HandleButtonState(dwButtonState, LGLCDBUTTON_LEFT);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_RIGHT);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_OK);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_CANCEL);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_UP);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_DOWN);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_MENU);
+    }
+    else
+    {
+        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON0);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON1);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON2);
+        HandleButtonState(dwButtonState, LGLCDBUTTON_BUTTON3);
+    }
+
+    m_dwButtonState = dwButtonState;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::HandleButtonState
+//
+//************************************************************************
+
+void CLCDOutput::HandleButtonState(DWORD dwButtonState, DWORD dwButton)
+{
+    if ( (m_dwButtonState & dwButton) && !(dwButtonState & dwButton) )
+    {
+        LCDUITRACE(_T("Button 0x%x released\n"), dwButton);
+        OnLCDButtonUp(dwButton);
+    }
+    if ( !(m_dwButtonState & dwButton) && (dwButtonState & dwButton) )
+    {
+        LCDUITRACE(_T("Button 0x%x pressed\n"), dwButton);
+        OnLCDButtonDown(dwButton);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnLCDButtonDown
+//
+//************************************************************************
+
+void CLCDOutput::OnLCDButtonDown(int nButton)
+{
+    if (m_pActivePage)
+    {
+        m_pActivePage->OnLCDButtonDown(nButton);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::OnLCDButtonUp
+//
+//************************************************************************
+
+void CLCDOutput::OnLCDButtonUp(int nButton)
+{
+    if (m_pActivePage)
+    {
+        m_pActivePage->OnLCDButtonUp(nButton);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::GetDeviceId
+//
+//************************************************************************
+
+int CLCDOutput::GetDeviceId(void)
+{
+    return m_hDevice;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::StopOpeningByDeviceType
+//
+//************************************************************************
+
+void CLCDOutput::StopOpeningByDeviceType(void)
+{
+    m_OpenByTypeContext.deviceType = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDOutput::HasBeenOpenedByDeviceType
+//
+//************************************************************************
+
+BOOL CLCDOutput::HasBeenOpenedByDeviceType(void)
+{
+    return (0 != m_OpenByTypeContext.deviceType);
+}
+
+
+//** end of LCDOutput.cpp ************************************************
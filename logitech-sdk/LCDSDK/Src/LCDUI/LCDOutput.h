@@ -1,101 +1,211 @@
-//************************************************************************
-//
-// LCDOutput.h
-//
-// The CLCDOutput manages the actual device and the various pages that
-// are sent to that device
-//
-// This class is now managed by CLCDConnection. You no longer need to 
-// derive or instantiate this class yourself
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#ifndef _CLCDOUTPUT_H_INCLUDED_ 
-#define _CLCDOUTPUT_H_INCLUDED_ 
-
-#include "LCDCollection.h"
-#include "LCDGfxBase.h"
-#include "LCDPage.h"
-
-
-class CLCDOutput : public CLCDCollection
-{
-public:
-    CLCDOutput(void);
-    virtual ~CLCDOutput(void);
-
-    // Assign the type of graphics this output supports.
-    // This is set by CLCDConnection.
-    void SetGfx(CLCDGfxBase *gfx);
-
-    void AddPage(CLCDPage *pPage);
-    void RemovePage(CLCDPage *pPage);
-    void ShowPage(CLCDPage *pPage, BOOL bShow = TRUE);
-    CLCDPage* GetShowingPage(void);
-
-    BOOL Open(lgLcdOpenContext &OpenContext);
-    BOOL OpenByType(lgLcdOpenByTypeContext &OpenContext);
-    void Close(void);
-    void Shutdown(void);
-
-    void SetScreenPriority(DWORD priority);
-    DWORD GetScreenPriority(void);
-
-    BOOL IsOpened(void);
-    HRESULT SetAsForeground(BOOL bSetAsForeground);
-
-    virtual BOOL OnDraw(void);
-    virtual void OnUpdate(DWORD dwTimestamp );
-    virtual void OnLCDButtonDown(int nButton);
-    virtual void OnLCDButtonUp(int nButton);
-
-    virtual void OnSoftButtonEvent(DWORD dwButtonState);
-    DWORD GetSoftButtonState(void);
-
-    // This returns true, if the device got opened through
-    // OpenByType(), instead of regular Open().
-    BOOL HasBeenOpenedByDeviceType(void);
-
-    // This is being called when we receive a device removal
-    // notification. After that, we can't reopen devices anymore
-    // (until the next device arrival comes in)
-    void StopOpeningByDeviceType(void);
-
-    // This is called, when a device function fails. This can
-    // sometimes happen during plug/unplug and two same devices
-    // are present.
-    BOOL ReOpenDeviceType(void);
-
-    int GetDeviceId(void);
-
-protected:
-    virtual BOOL DoesBitmapNeedUpdate(lgLcdBitmap* pBitmap);
-    virtual void OnPageShown(CLCDCollection* pScreen);
-    virtual void OnPageExpired(CLCDCollection* pScreen);
-    virtual void OnEnteringIdle(void);
-    virtual void OnClosingDevice(int hDevice);
-    virtual void OnOpenedDevice(int hDevice);
-
-private:
-    HRESULT HandleErrorFromAPI(DWORD dwRes);
-    void HandleButtonState(DWORD dwButtonState, DWORD dwButton);
-
-    CLCDPage* m_pActivePage;
-
-    int m_hDevice;
-    BOOL m_bSetAsForeground;
-    DWORD m_dwButtonState;
-
-    DWORD m_nPriority;
-
-    CLCDGfxBase* m_pGfx;
-
-    lgLcdOpenByTypeContext m_OpenByTypeContext;
-};
-
-#endif
-
-//** end of LCDOutput.h **************************************************
+//************************************************************************
+//
+// LCDOutput.h
+//
+// The CLCDOutput manages the actual device and the various pages that
+// are sent to that device
+//
+// This class is now managed by CLCDConnection. You no longer need to 
+// derive or instantiate this class yourself
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _CLCDOUTPUT_H_INCLUDED_ 
+#define _CLCDOUTPUT_H_INCLUDED_ 
+
+#include "LCDCollection.h"
+#include "LCDGfxBase.h"
+#include "LCDPage.h"
+#include "LCDDither.h"
+#include "LCDTileRenderer.h"
+
+
+class CLCDOutput : public CLCDCollection
+{
+public:
+    CLCDOutput(void);
+    virtual ~CLCDOutput(void);
+
+    // Assign the type of graphics this output supports.
+    // This is set by CLCDConnection.
+    void SetGfx(CLCDGfxBase *gfx);
+
+    void AddPage(CLCDPage *pPage);
+    void RemovePage(CLCDPage *pPage);
+    void ShowPage(CLCDPage *pPage, BOOL bShow = TRUE);
+    CLCDPage* GetShowingPage(void);
+
+    BOOL Open(lgLcdOpenContext &OpenContext);
+    BOOL OpenByType(lgLcdOpenByTypeContext &OpenContext);
+    void Close(void);
+    void Shutdown(void);
+
+    void SetScreenPriority(DWORD priority);
+    DWORD GetScreenPriority(void);
+
+    BOOL IsOpened(void);
+    HRESULT SetAsForeground(BOOL bSetAsForeground);
+
+    virtual BOOL OnDraw(void);
+    virtual void OnUpdate(DWORD dwTimestamp );
+    virtual void OnLCDButtonDown(int nButton);
+    virtual void OnLCDButtonUp(int nButton);
+
+    virtual void OnSoftButtonEvent(DWORD dwButtonState);
+    DWORD GetSoftButtonState(void);
+
+    // This returns true, if the device got opened through
+    // OpenByType(), instead of regular Open().
+    BOOL HasBeenOpenedByDeviceType(void);
+
+    // This is being called when we receive a device removal
+    // notification. After that, we can't reopen devices anymore
+    // (until the next device arrival comes in)
+    void StopOpeningByDeviceType(void);
+
+    // This is called, when a device function fails. This can
+    // sometimes happen during plug/unplug and two same devices
+    // are present.
+    BOOL ReOpenDeviceType(void);
+
+    int GetDeviceId(void);
+
+    // Frames are only submitted when their pixels or the priority differ
+    // from the last frame sent to the device. These count both outcomes.
+    DWORD GetSubmittedFrameCount(void);
+    DWORD GetSuppressedFrameCount(void);
+    void ResetFrameCounters(void);
+
+    // Forces the next frame to be submitted, even if it is unchanged
+    void InvalidateLastFrame(void);
+
+    // Only the damaged area of the active page is cleared and redrawn.
+    // Off by default; all controls on the pages must call
+    // CLCDBase::Invalidate() when their appearance changes.
+    void EnablePartialRedraw(BOOL bEnable);
+
+    // Hands frames to a worker thread that calls lgLcdUpdateBitmap(), so
+    // the next frame can be rendered while the last one is submitted.
+    // Only the newest waiting frame is kept; older ones are dropped.
+    HRESULT EnablePipelinedSubmit(BOOL bEnable);
+    BOOL IsPipelinedSubmit(void);
+    DWORD GetDroppedFrameCount(void);
+
+    // Draws pages in tiles on a pool of worker threads, see
+    // CLCDTileRenderer. Pages with objects that are not tile safe are
+    // still drawn on the calling thread. nThreads = 0 starts one worker
+    // for each additional processor.
+    HRESULT EnableTileRendering(BOOL bEnable, int nThreads = 0);
+    BOOL IsTileRendering(void);
+
+    // Shows a scaled down copy of another output's page instead of the
+    // pages of this output. The source is rendered even if its own device
+    // is not there. prcSource selects the part of the source to show,
+    // NULL shows all of it. Pass a NULL source to stop mirroring.
+    void SetMirrorSource(CLCDOutput *pSource, CLCDDither::eDITHER_MODE eMode,
+                         const RECT *prcSource = NULL);
+    CLCDOutput* GetMirrorSource(void);
+
+protected:
+    void RenderActivePage(void);
+    void RenderMirror(void);
+    virtual BOOL DoesBitmapNeedUpdate(lgLcdBitmap* pBitmap);
+    virtual void OnPageShown(CLCDCollection* pScreen);
+    virtual void OnPageExpired(CLCDCollection* pScreen);
+    virtual void OnEnteringIdle(void);
+    virtual void OnClosingDevice(int hDevice);
+    virtual void OnOpenedDevice(int hDevice);
+
+private:
+    struct SUBMITQUEUE;
+
+    HRESULT HandleErrorFromAPI(DWORD dwRes);
+    void HandleButtonState(DWORD dwButtonState, DWORD dwButton);
+    static BOOL CompareAndCopyRow(const BYTE *pSrc, PBYTE pDst, int nBytes);
+    DWORD SubmitFrame(lgLcdBitmap *pBitmap, DWORD dwPriority);
+    DWORD QueueFrame(lgLcdBitmap *pBitmap, DWORD dwPriority);
+    void FlushSubmitQueue(void);
+    void StopSubmitThread(void);
+    void AcquireBuffer(void);
+    void MarkBufferDrawn(const RECT &rcDrawn);
+    static void ReleaseSubmitQueue(SUBMITQUEUE *pQueue);
+    static void SubmitThreadLoop(SUBMITQUEUE *pQueue);
+    static DWORD WINAPI _SubmitThreadProc(LPVOID pContext);
+
+    CLCDPage* m_pActivePage;
+
+    int m_hDevice;
+    BOOL m_bSetAsForeground;
+    DWORD m_dwButtonState;
+
+    DWORD m_nPriority;
+
+    CLCDGfxBase* m_pGfx;
+    CLCDTileRenderer* m_pTileRenderer;
+    int m_nTileThreads;
+
+    // copy of the last submitted frame, for change detection
+    std::vector<BYTE> m_LastFrame;
+    DWORD m_dwLastFormat;
+    DWORD m_dwLastPriority;
+    BOOL m_bLastFrameValid;
+    DWORD m_dwSubmittedFrames;
+    DWORD m_dwSuppressedFrames;
+
+    BOOL m_bPartialRedraw;
+    // the surface does not hold the active page, redraw all of it
+    BOOL m_bRedrawAll;
+    // incremented whenever the surface is rendered
+    DWORD m_dwRenderCount;
+    // incremented by OnUpdate(), and its value when the active page was
+    // last rendered, so that a mirror does not render it a second time
+    DWORD m_dwUpdateCount;
+    DWORD m_dwRenderedUpdate;
+
+    CLCDOutput* m_pMirrorSource;
+    CLCDDither::eDITHER_MODE m_eMirrorDither;
+    RECT m_rcMirrorSource;
+    // render count of the source when it was last mirrored
+    DWORD m_dwMirroredCount;
+    std::vector<BYTE> m_MirrorLuma;
+    std::vector<BYTE> m_MirrorBits;
+
+    // pipelined submission: frames are rendered into the screen buffers of
+    // m_pGfx in turn, queueing one hands its buffer index to the worker
+    enum { FRAME_RING_SIZE = 3, NO_FRAME = -1, SUBMIT_TIMEOUT = 1000 };
+    struct SUBMITQUEUE
+    {
+        // the output and the worker each hold a reference
+        volatile LONG nRefs;
+        CRITICAL_SECTION cs;
+        HANDLE hEvent;
+        HANDLE hIdle;
+        BOOL bStop;
+        lgLcdBitmap *apFrame[FRAME_RING_SIZE];
+        DWORD adwPriority[FRAME_RING_SIZE];
+        int ahDevice[FRAME_RING_SIZE];
+        int nPending;
+        int nSubmitting;
+        // error of the last failed asynchronous submit, and its device
+        DWORD dwResult;
+        int hResultDevice;
+        DWORD dwDropped;
+    };
+    SUBMITQUEUE *m_pSubmitQueue;
+    HANDLE m_hSubmitThread;
+    // the current buffer went to the worker, draw into another one
+    BOOL m_bSwapBuffer;
+    // per screen buffer, the area that changed since it was last drawn
+    RECT m_arcBufferDamage[FRAME_RING_SIZE];
+    // frames dropped by workers that are gone
+    DWORD m_dwDroppedFrames;
+
+    lgLcdOpenByTypeContext m_OpenByTypeContext;
+};
+
+#endif
+
+//** end of LCDOutput.h **************************************************
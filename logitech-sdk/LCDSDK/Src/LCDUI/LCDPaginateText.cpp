@@ -1,266 +1,452 @@
-//************************************************************************
-//
-// LCDPaginateText.h
-//
-// The CLCDPaginateText class draws text onto the LCD in pages.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDPaginateText::CLCDPaginateText
-//
-//************************************************************************
-
-CLCDPaginateText::CLCDPaginateText(void)
-:   m_linePerPage(0),
-    m_totalPageNum(0),
-    m_iCurPageNum(0)
-{
-    ZeroMemory(&m_origSize, sizeof(m_origSize));
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::~CLCDPaginateText
-//
-//************************************************************************
-
-CLCDPaginateText::~CLCDPaginateText(void)
-{
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::SetSize
-//
-//************************************************************************
-
-void CLCDPaginateText::SetSize(SIZE& size)
-{
-    CLCDBase::SetSize(size);
-    m_origSize = size;
-    m_bRecalcExtent = true;
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::SetSize
-//
-//************************************************************************
-
-void CLCDPaginateText::SetSize(int nCX, int nCY)
-{
-    CLCDBase::SetSize(nCX, nCY);
-    m_origSize = m_Size;
-    m_bRecalcExtent = true;
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::DoPaginate
-//
-// Force the re-pagination, will set the first page to be the current page
-//
-//************************************************************************
-
-void CLCDPaginateText::DoPaginate(void)
-{
-    // if m_bRecalcExtent is false, nothing affects pagination changes, don't do anything
-    if(!m_bRecalcExtent)
-    {
-        return;
-    }
-    // if the page size is 0, set current page, total number of page, and line of text per page as 0
-    if(m_origSize.cx == 0 || m_origSize.cy == 0)
-    {
-        m_iCurPageNum = 0;
-        m_totalPageNum = 0;
-        m_linePerPage = 0;
-    }
-    else
-    {
-        HDC hdc = CreateCompatibleDC(NULL);
-
-        int nOldMapMode = SetMapMode(hdc, MM_TEXT);
-        int nOldBkMode = SetBkMode(hdc, GetBackgroundMode()); 
-        // select current font
-        HFONT hOldFont = (HFONT)SelectObject(hdc, m_hFont);   
-
-        RECT rExtent;
-
-        // calculate horizontal extent w/ single line, we can get the line height
-        int nTextFormat = (m_nTextFormat | DT_SINGLELINE | DT_CALCRECT);
-        rExtent.left = rExtent.top = 0;
-        rExtent.right = m_origSize.cx;
-        rExtent.bottom = m_origSize.cy;
-        DrawTextEx(hdc, (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rExtent, nTextFormat, &m_dtp);
-        m_sizeHExtent.cx = rExtent.right;
-        m_sizeHExtent.cy = rExtent.bottom;
-
-        // calculate vertical extent with word wrap
-        nTextFormat = (m_nTextFormat | DT_WORDBREAK | DT_CALCRECT);
-        rExtent.left = rExtent.top = 0;
-        rExtent.right = m_origSize.cx;
-        rExtent.bottom = m_origSize.cy;
-        DrawTextEx(hdc, (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rExtent, nTextFormat, &m_dtp);
-        m_sizeVExtent.cx = rExtent.right;
-        m_sizeVExtent.cy = rExtent.bottom;
-
-        CLCDText::SetLogicalSize(m_sizeVExtent.cx, m_sizeVExtent.cy);
-
-        // restores
-        SetMapMode(hdc, nOldMapMode);
-        SetBkMode(hdc, nOldBkMode);
-        SelectObject(hdc, hOldFont);
-
-        DeleteDC(hdc);
-
-        m_linePerPage = (int)(m_origSize.cy / m_sizeHExtent.cy);
-        // we re-set the m_Size.cy to show m_linePerPage line of text exactly (no clipping text)
-        m_Size.cy = m_linePerPage * m_sizeHExtent.cy;
-
-        // if the control size is too small to fit one line of text, the m_Size.cy is set to 0, 
-        // and we also set total number of pages to be 0
-        if(m_Size.cy == 0)
-        {
-            m_iCurPageNum = 0;
-            m_totalPageNum = 0;
-            m_linePerPage = 0;
-        }
-        else
-        {
-            m_totalPageNum = (int)(m_sizeVExtent.cy / m_Size.cy);
-            m_totalPageNum += ((m_sizeVExtent.cy % m_Size.cy) > 0) ? 1 : 0;
-
-            m_totalPageNum = (m_totalPageNum > 0) ? m_totalPageNum : 1;
-
-            // after paginate, always set first page to be the current page
-            m_iCurPageNum = 0;
-        }
-    }
-    // set m_bRecalcExtent to be false to avoid another calculation at Draw time
-    m_bRecalcExtent = false;
-    SetLogicalOrigin(0, (int)((-1) * m_iCurPageNum * m_Size.cy));
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::GetTotalPages
-//
-//************************************************************************
-
-int CLCDPaginateText::GetTotalPages(void)
-{
-    DoPaginate();
-    return m_totalPageNum;
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::SetCurPage
-//
-//************************************************************************
-
-void CLCDPaginateText::SetCurPage(int iPageNum)
-{
-    DoPaginate();
-
-    if(iPageNum > m_totalPageNum - 1)
-    {
-        iPageNum = m_totalPageNum - 1;
-    }
-    if(iPageNum < 0) 
-    {
-        iPageNum = 0;
-    }
-
-    m_iCurPageNum = iPageNum;
-
-    SetLogicalOrigin(0, (int)((-1) * m_iCurPageNum * m_Size.cy));
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::GetCurPage
-//
-//************************************************************************
-
-int CLCDPaginateText::GetCurPage(void)
-{
-    DoPaginate();
-    return m_iCurPageNum;
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::GotoPrevPage
-//
-// Go to previous page, return false if it is already at the first page.
-// Otherwise, return true;
-//
-//************************************************************************
-
-bool CLCDPaginateText::GotoPrevPage(void)
-{
-    DoPaginate();
-    if(m_iCurPageNum > 0)
-    {
-        SetCurPage(--m_iCurPageNum);
-        return true;
-    }
-
-    return false;
-}
-
-
-//************************************************************************
-//
-// CLCDPaginateText::GotoNextPage
-//
-// Go to next page, return false if it is already at the last page.
-// Otherwise, return true;
-//
-//************************************************************************
-
-bool CLCDPaginateText::GotoNextPage(void)
-{
-    DoPaginate();
-    if(m_iCurPageNum < m_totalPageNum -1)
-    {
-        SetCurPage(++m_iCurPageNum);
-        return true;
-    }
-
-    return false;
-}
-
-//************************************************************************
-//
-// CLCDPaginateText::OnDraw
-//
-// Before drawing, make sure we have a updated pagination
-//
-//************************************************************************
-
-void CLCDPaginateText::OnDraw(CLCDGfxBase &rGfx)
-{
-    DoPaginate();
-    CLCDText::OnDraw(rGfx);
-}
-
-//** end of LCDPaginateText.cpp ******************************************
+//************************************************************************
+//
+// LCDPaginateText.h
+//
+// The CLCDPaginateText class draws text onto the LCD in pages.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDPaginateText::CLCDPaginateText
+//
+//************************************************************************
+
+CLCDPaginateText::CLCDPaginateText(void)
+:   m_linePerPage(0),
+    m_totalPageNum(0),
+    m_iCurPageNum(0),
+    m_nIndexedLength(0),
+    m_hIndexFont(NULL),
+    m_nIndexWidth(0),
+    m_nIndexFormat(0),
+    m_iIndexLeftMargin(0),
+    m_iIndexRightMargin(0),
+    m_bAppendOnly(FALSE)
+{
+    ZeroMemory(&m_origSize, sizeof(m_origSize));
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::~CLCDPaginateText
+//
+//************************************************************************
+
+CLCDPaginateText::~CLCDPaginateText(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::SetSize
+//
+//************************************************************************
+
+void CLCDPaginateText::SetSize(SIZE& size)
+{
+    CLCDBase::SetSize(size);
+    m_origSize = size;
+    m_bRecalcExtent = true;
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::SetSize
+//
+//************************************************************************
+
+void CLCDPaginateText::SetSize(int nCX, int nCY)
+{
+    CLCDBase::SetSize(nCX, nCY);
+    m_origSize = m_Size;
+    m_bRecalcExtent = true;
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::SetText
+//
+//************************************************************************
+
+void CLCDPaginateText::SetText(LPCTSTR szText, int nLength)
+{
+    LCDUIASSERT(NULL != szText);
+    if(NULL == szText)
+    {
+        return;
+    }
+
+    // the lines of the current text stay where they are
+    int nCurLength = static_cast<int>(m_nTextLength);
+    if((nLength >= nCurLength) && (0 == memcmp(szText, m_sText.data(), nCurLength * sizeof(TCHAR))))
+    {
+        AppendText(szText + nCurLength, nLength - nCurLength);
+        return;
+    }
+
+    m_LineStarts.clear();
+    m_nIndexedLength = 0;
+    CLCDText::SetText(szText, nLength);
+}
+
+
+#ifdef LCDUI_RVALUE_REFS
+//************************************************************************
+//
+// CLCDPaginateText::SetText
+//
+//************************************************************************
+
+void CLCDPaginateText::SetText(lcdstring &&sText)
+{
+    // appending copies only the new end, so it beats taking the buffer
+    int nCurLength = static_cast<int>(m_nTextLength);
+    if((sText.size() >= m_nTextLength) && (0 == memcmp(sText.data(), m_sText.data(), nCurLength * sizeof(TCHAR))))
+    {
+        AppendText(sText.data() + nCurLength, static_cast<int>(sText.size()) - nCurLength);
+        return;
+    }
+
+    m_LineStarts.clear();
+    m_nIndexedLength = 0;
+    CLCDText::SetText(std::move(sText));
+}
+#endif
+
+
+//************************************************************************
+//
+// CLCDPaginateText::AppendText
+//
+//************************************************************************
+
+void CLCDPaginateText::AppendText(LPCTSTR szText)
+{
+    LCDUIASSERT(NULL != szText);
+    if(NULL != szText)
+    {
+        AppendText(szText, static_cast<int>(_tcslen(szText)));
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::AppendText
+//
+//************************************************************************
+
+void CLCDPaginateText::AppendText(LPCTSTR szText, int nLength)
+{
+    LCDUIASSERT(NULL != szText);
+    if((NULL == szText) || (0 >= nLength))
+    {
+        return;
+    }
+
+    m_bAppendOnly = m_bAppendOnly || !m_bRecalcExtent;
+    m_sText.append(szText, nLength);
+    m_nTextLength = m_sText.size();
+    m_bRecalcExtent = TRUE;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::SetBitmapFont
+//
+// Pages are broken with the line index of the GDI font
+//************************************************************************
+
+void CLCDPaginateText::SetBitmapFont(CLCDBitmapFont *pFont)
+{
+    UNREFERENCED_PARAMETER(pFont);
+    LCDUITRACE(_T("CLCDPaginateText::SetBitmapFont(): bitmap fonts are not supported.\n"));
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::DoPaginate
+//
+// Force the re-pagination, will set the first page to be the current page
+// unless text was only appended. Lines are broken where the line index
+// does not reach yet; all of the text only when the font, width, format
+// or margins changed, or text was replaced.
+//
+//************************************************************************
+
+void CLCDPaginateText::DoPaginate(void)
+{
+    // if m_bRecalcExtent is false, nothing affects pagination changes, don't do anything
+    if(!m_bRecalcExtent)
+    {
+        return;
+    }
+    // if the page size is 0, set current page, total number of page, and line of text per page as 0
+    if(m_origSize.cx == 0 || m_origSize.cy == 0)
+    {
+        m_iCurPageNum = 0;
+        m_totalPageNum = 0;
+        m_linePerPage = 0;
+    }
+    else
+    {
+        CLCDTextLayout &rLayout = CLCDTextLayout::GetInstance();
+        UINT nFormat = m_nTextFormat | DT_WORDBREAK;
+
+        // the height of one line of text, whatever the text
+        SIZE sizeLine = rLayout.GetExtent(NULL, m_hFont, _T(" "), 1, m_origSize.cx, m_origSize.cy,
+                                          m_nTextFormat | DT_SINGLELINE, m_dtp);
+
+        BOOL bRebuild = m_LineStarts.empty() || (m_nIndexedLength > m_nTextLength) ||
+            (m_hIndexFont != m_hFont) || (m_nIndexWidth != m_origSize.cx) || (m_nIndexFormat != nFormat) ||
+            (m_iIndexLeftMargin != m_dtp.iLeftMargin) || (m_iIndexRightMargin != m_dtp.iRightMargin);
+        if(bRebuild)
+        {
+            m_LineStarts.clear();
+            m_hIndexFont = m_hFont;
+            m_nIndexWidth = m_origSize.cx;
+            m_nIndexFormat = nFormat;
+            m_iIndexLeftMargin = m_dtp.iLeftMargin;
+            m_iIndexRightMargin = m_dtp.iRightMargin;
+        }
+        if(bRebuild || (m_nIndexedLength < m_nTextLength))
+        {
+            rLayout.ExtendLineStarts(m_hFont, m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                     m_origSize.cx, nFormat, m_dtp, m_LineStarts);
+            m_nIndexedLength = m_nTextLength;
+        }
+        int nLines = static_cast<int>(m_LineStarts.size());
+
+        // the whole text, as if it was drawn at once
+        m_sizeHExtent.cx = m_origSize.cx;
+        m_sizeHExtent.cy = sizeLine.cy;
+        m_sizeVExtent.cx = m_origSize.cx;
+        m_sizeVExtent.cy = nLines * sizeLine.cy;
+
+        CLCDText::SetLogicalSize(m_sizeVExtent.cx, m_sizeVExtent.cy);
+
+        m_linePerPage = (sizeLine.cy > 0) ? (int)(m_origSize.cy / sizeLine.cy) : 0;
+        // we re-set the m_Size.cy to show m_linePerPage line of text exactly (no clipping text)
+        m_Size.cy = m_linePerPage * sizeLine.cy;
+
+        // if the control size is too small to fit one line of text, the m_Size.cy is set to 0, 
+        // and we also set total number of pages to be 0
+        if(m_Size.cy == 0)
+        {
+            m_iCurPageNum = 0;
+            m_totalPageNum = 0;
+            m_linePerPage = 0;
+        }
+        else
+        {
+            m_totalPageNum = (nLines + m_linePerPage - 1) / m_linePerPage;
+
+            m_totalPageNum = (m_totalPageNum > 0) ? m_totalPageNum : 1;
+
+            // after paginate, set first page to be the current page, unless the text just got longer
+            if(bRebuild || !m_bAppendOnly)
+            {
+                m_iCurPageNum = 0;
+            }
+            m_iCurPageNum = min(m_iCurPageNum, m_totalPageNum - 1);
+        }
+    }
+    // set m_bRecalcExtent to be false to avoid another calculation at Draw time
+    m_bRecalcExtent = false;
+    m_bAppendOnly = FALSE;
+    SetLogicalOrigin(0, (int)((-1) * m_iCurPageNum * m_Size.cy));
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::GetTotalPages
+//
+//************************************************************************
+
+int CLCDPaginateText::GetTotalPages(void)
+{
+    DoPaginate();
+    return m_totalPageNum;
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::SetCurPage
+//
+//************************************************************************
+
+void CLCDPaginateText::SetCurPage(int iPageNum)
+{
+    DoPaginate();
+
+    if(iPageNum > m_totalPageNum - 1)
+    {
+        iPageNum = m_totalPageNum - 1;
+    }
+    if(iPageNum < 0) 
+    {
+        iPageNum = 0;
+    }
+
+    m_iCurPageNum = iPageNum;
+
+    SetLogicalOrigin(0, (int)((-1) * m_iCurPageNum * m_Size.cy));
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::GetCurPage
+//
+//************************************************************************
+
+int CLCDPaginateText::GetCurPage(void)
+{
+    DoPaginate();
+    return m_iCurPageNum;
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::GotoPrevPage
+//
+// Go to previous page, return false if it is already at the first page.
+// Otherwise, return true;
+//
+//************************************************************************
+
+bool CLCDPaginateText::GotoPrevPage(void)
+{
+    DoPaginate();
+    if(m_iCurPageNum > 0)
+    {
+        SetCurPage(--m_iCurPageNum);
+        return true;
+    }
+
+    return false;
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::GotoNextPage
+//
+// Go to next page, return false if it is already at the last page.
+// Otherwise, return true;
+//
+//************************************************************************
+
+bool CLCDPaginateText::GotoNextPage(void)
+{
+    DoPaginate();
+    if(m_iCurPageNum < m_totalPageNum -1)
+    {
+        SetCurPage(++m_iCurPageNum);
+        return true;
+    }
+
+    return false;
+}
+
+//************************************************************************
+//
+// CLCDPaginateText::OnDraw
+//
+// Before drawing, make sure we have a updated pagination
+//
+//************************************************************************
+
+void CLCDPaginateText::OnDraw(CLCDGfxBase &rGfx)
+{
+    DoPaginate();
+    CLCDText::OnDraw(rGfx);
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::IsTileSafe
+//
+// Pagination runs while drawing
+//
+//************************************************************************
+
+BOOL CLCDPaginateText::IsTileSafe(void)
+{
+    return FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::RecalcExtent
+//
+// The extents are those of the pagination, which measures with the
+// layout cache's own DC
+//
+//************************************************************************
+
+void CLCDPaginateText::RecalcExtent(HDC hDC)
+{
+    UNREFERENCED_PARAMETER(hDC);
+    DoPaginate();
+}
+
+
+//************************************************************************
+//
+// CLCDPaginateText::DrawText
+//
+// Draws the lines of the current page only, where they are in the whole
+// text
+//
+//************************************************************************
+
+void CLCDPaginateText::DrawText(CLCDGfxBase &rGfx)
+{
+    int nLines = static_cast<int>(m_LineStarts.size());
+    int nFirstLine = m_iCurPageNum * m_linePerPage;
+    if((0 == m_linePerPage) || (nFirstLine >= nLines))
+    {
+        return;
+    }
+
+    int nStart = m_LineStarts[nFirstLine];
+    int nEnd = (nFirstLine + m_linePerPage < nLines) ?
+        m_LineStarts[nFirstLine + m_linePerPage] : static_cast<int>(m_nTextLength);
+    UINT nFormat = m_nTextFormat | DT_WORDBREAK;
+
+    // DrawTextEx() writes to the parameters
+    DRAWTEXTPARAMS dtp = m_dtp;
+    RECT rBoundary = { 0, m_iCurPageNum * m_Size.cy, GetLogicalSize().cx, (m_iCurPageNum + 1) * m_Size.cy };
+    if (!CLCDGlyphCache::GetInstance().DrawText(rGfx, m_hFont, m_sText.c_str() + nStart, nEnd - nStart,
+            rBoundary, nFormat, dtp, m_crForegroundColor))
+    {
+        DrawTextEx(rGfx.GetHDC(), (LPTSTR)m_sText.c_str() + nStart, nEnd - nStart, &rBoundary, nFormat, &dtp);
+    }
+
+    if (m_bInverted)
+    {
+        InvertRect(rGfx.GetHDC(), &rBoundary);
+    }
+}
+
+//** end of LCDPaginateText.cpp ******************************************
@@ -1,55 +1,89 @@
-//************************************************************************
-//
-// LCDPaginateText.h
-//
-// The CLCDPaginateText class draws text onto the LCD in pages.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#ifndef _LCDPAGINATETEXT_H_INCLUDED_ 
-#define _LCDPAGINATETEXT_H_INCLUDED_ 
-
-#include "LCDText.h"
-
-class CLCDPaginateText: public CLCDText
-{
-
-public:
-    CLCDPaginateText(void);
-    virtual ~CLCDPaginateText(void);
-
-    // CLCDText
-    virtual void SetSize(SIZE& size);
-    virtual void SetSize(int nCX, int nCY);
-    virtual void OnDraw(CLCDGfxBase &rGfx);
-
-    // force the re-pagination, will set the first page to be the current page
-    void    DoPaginate(void);
-    int     GetTotalPages(void);
-    int     GetCurPage(void);
-    void    SetCurPage(int iPageNum);
-    // go to previous page, return false if it is already at the first page. Otherwise, return true;
-    bool    GotoPrevPage(void);
-    // go to next page, return false if it is already at the last page. Otherwise, return true;
-    bool    GotoNextPage(void);
-
-private:
-    // this is the original size for the control. As we try to squeeze text into
-    // the rectangle, we squeeze the m_Size to show unclipped text. but if the 
-    // user change settings where a recalc is needed to figure out the total page,
-    // we need the original size for that calculation
-    SIZE    m_origSize;
-
-    // using the current setting, number of lines fit to one page (w/o clipping)
-    int     m_linePerPage;
-    int     m_totalPageNum;
-    int     m_iCurPageNum;
-};
-
-
-#endif // !_LCDPAGINATETEXT_H_INCLUDED_ 
-
-//** end of LCDPaginateText.h *******************************************
+//************************************************************************
+//
+// LCDPaginateText.h
+//
+// The CLCDPaginateText class draws text onto the LCD in pages.
+// It keeps where every line starts, so that a page is drawn without
+// laying out the text before it, and appended text only lays out the
+// last line and what follows.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDPAGINATETEXT_H_INCLUDED_ 
+#define _LCDPAGINATETEXT_H_INCLUDED_ 
+
+#include "LCDText.h"
+
+class CLCDPaginateText: public CLCDText
+{
+
+public:
+    CLCDPaginateText(void);
+    virtual ~CLCDPaginateText(void);
+
+    // CLCDText
+    virtual void SetSize(SIZE& size);
+    virtual void SetSize(int nCX, int nCY);
+    virtual void OnDraw(CLCDGfxBase &rGfx);
+    virtual BOOL IsTileSafe(void);
+    // text starting with the current text is appended
+    using CLCDText::SetText;
+    virtual void SetText(LPCTSTR szText, int nLength);
+#ifdef LCDUI_RVALUE_REFS
+    virtual void SetText(lcdstring &&sText);
+#endif
+    virtual void SetBitmapFont(CLCDBitmapFont *pFont);
+
+    // adds szText to the end, keeping the current page
+    void    AppendText(LPCTSTR szText);
+    void    AppendText(LPCTSTR szText, int nLength);
+
+    // force the re-pagination, will set the first page to be the current page
+    // unless text was only appended
+    void    DoPaginate(void);
+    int     GetTotalPages(void);
+    int     GetCurPage(void);
+    void    SetCurPage(int iPageNum);
+    // go to previous page, return false if it is already at the first page. Otherwise, return true;
+    bool    GotoPrevPage(void);
+    // go to next page, return false if it is already at the last page. Otherwise, return true;
+    bool    GotoNextPage(void);
+
+protected:
+    // CLCDText
+    virtual void RecalcExtent(HDC hDC);
+    virtual void DrawText(CLCDGfxBase &rGfx);
+
+private:
+    // this is the original size for the control. As we try to squeeze text into
+    // the rectangle, we squeeze the m_Size to show unclipped text. but if the 
+    // user change settings where a recalc is needed to figure out the total page,
+    // we need the original size for that calculation
+    SIZE    m_origSize;
+
+    // using the current setting, number of lines fit to one page (w/o clipping)
+    int     m_linePerPage;
+    int     m_totalPageNum;
+    int     m_iCurPageNum;
+
+    // offset of the first character of every line of the first
+    // m_nIndexedLength characters, broken for the font, width, format
+    // and margins below
+    std::vector<int> m_LineStarts;
+    lcdstring::size_type m_nIndexedLength;
+    HFONT   m_hIndexFont;
+    int     m_nIndexWidth;
+    UINT    m_nIndexFormat;
+    int     m_iIndexLeftMargin;
+    int     m_iIndexRightMargin;
+    // no change since the last pagination other than appended text
+    BOOL    m_bAppendOnly;
+};
+
+
+#endif // !_LCDPAGINATETEXT_H_INCLUDED_ 
+
+//** end of LCDPaginateText.h *******************************************
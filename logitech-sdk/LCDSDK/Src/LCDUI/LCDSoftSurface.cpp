@@ -0,0 +1,947 @@
+//************************************************************************
+//
+// LCDSoftSurface.cpp
+//
+// The raster core of CLCDGfxSoft. Standard C++ only, this file does not
+// include LCDUI.h (nor windows.h) and is not built with its precompiled
+// header.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include <string.h>
+#include <stdlib.h>
+#include "LCDSoftSurface.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define LCDSOFT_SSE2
+#endif
+
+// the packed rows are made of 32 bit words
+typedef char LCDSOFT_UINT_IS_32_BITS[(4 == sizeof(unsigned int)) ? 1 : -1];
+
+static inline int SoftMin(int a, int b)
+{
+    return (a < b) ? a : b;
+}
+
+static inline int SoftMax(int a, int b)
+{
+    return (a > b) ? a : b;
+}
+
+
+// 5x7 glyphs for the printable ASCII range (0x20 - 0x7E).
+// One byte per column, bit 0 is the top row.
+static const unsigned char s_Glyphs[][CLCDSoftSurface::GLYPH_WIDTH] =
+{
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 },
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 },
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+    { 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 },
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 },
+    { 0x08, 0x2A, 0x1C, 0x2A, 0x08 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 },
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 },
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 },
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E },
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 },
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 },
+    { 0x32, 0x49, 0x79, 0x41, 0x3E }, { 0x7E, 0x11, 0x11, 0x11, 0x7E },
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 },
+    { 0x7F, 0x09, 0x09, 0x01, 0x01 }, { 0x3E, 0x41, 0x41, 0x51, 0x32 },
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 },
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 },
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x04, 0x02, 0x7F },
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E },
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 },
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F },
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x7F, 0x20, 0x18, 0x20, 0x7F },
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x03, 0x04, 0x78, 0x04, 0x03 },
+    { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 },
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 },
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 },
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 },
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 },
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x08, 0x14, 0x54, 0x54, 0x3C },
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 },
+    { 0x20, 0x40, 0x44, 0x3D, 0x00 }, { 0x00, 0x7F, 0x10, 0x28, 0x44 },
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 },
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 },
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, { 0x08, 0x14, 0x14, 0x18, 0x7C },
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 },
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C },
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C },
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C },
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 },
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 },
+    { 0x10, 0x08, 0x08, 0x10, 0x08 }
+};
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::CLCDSoftSurface
+//
+//************************************************************************
+
+CLCDSoftSurface::CLCDSoftSurface(void)
+:   m_pBits(NULL),
+    m_nWidth(0),
+    m_nHeight(0),
+    m_nPitch(0),
+    m_nBitCount(32)
+{
+    memset(&m_rcClip, 0, sizeof(m_rcClip));
+    memset(&m_ptOrigin, 0, sizeof(m_ptOrigin));
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::~CLCDSoftSurface
+//
+//************************************************************************
+
+CLCDSoftSurface::~CLCDSoftSurface(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::Attach
+//
+//************************************************************************
+
+void CLCDSoftSurface::Attach(unsigned char *pBits, int nWidth, int nHeight, int nPitch, int nBitCount)
+{
+    m_pBits = pBits;
+    m_nWidth = nWidth;
+    m_nHeight = nHeight;
+    m_nPitch = nPitch;
+    m_nBitCount = nBitCount;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::Detach
+//
+//************************************************************************
+
+void CLCDSoftSurface::Detach(void)
+{
+    m_pBits = NULL;
+    m_nPitch = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetBits
+//
+//************************************************************************
+
+unsigned char *CLCDSoftSurface::GetBits(void) const
+{
+    return m_pBits;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetWidth
+//
+//************************************************************************
+
+int CLCDSoftSurface::GetWidth(void) const
+{
+    return m_nWidth;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetHeight
+//
+//************************************************************************
+
+int CLCDSoftSurface::GetHeight(void) const
+{
+    return m_nHeight;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetPitch
+//
+//************************************************************************
+
+int CLCDSoftSurface::GetPitch(void) const
+{
+    return m_nPitch;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetBitCount
+//
+//************************************************************************
+
+int CLCDSoftSurface::GetBitCount(void) const
+{
+    return m_nBitCount;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::SetClipRect
+//
+// NULL resets the clip rectangle to the whole surface.
+//************************************************************************
+
+void CLCDSoftSurface::SetClipRect(const LCDSOFTRECT *prcClip)
+{
+    LCDSOFTRECT rcSurface = { 0, 0, m_nWidth, m_nHeight };
+    if(NULL == prcClip)
+    {
+        m_rcClip = rcSurface;
+        return;
+    }
+
+    m_rcClip.left = SoftMax(prcClip->left, rcSurface.left);
+    m_rcClip.top = SoftMax(prcClip->top, rcSurface.top);
+    m_rcClip.right = SoftMin(prcClip->right, rcSurface.right);
+    m_rcClip.bottom = SoftMin(prcClip->bottom, rcSurface.bottom);
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetClipRect
+//
+//************************************************************************
+
+LCDSOFTRECT CLCDSoftSurface::GetClipRect(void) const
+{
+    return m_rcClip;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::SetOrigin
+//
+// Returns the previous origin.
+//************************************************************************
+
+LCDSOFTPOINT CLCDSoftSurface::SetOrigin(int nX, int nY)
+{
+    LCDSOFTPOINT ptPrev = m_ptOrigin;
+    m_ptOrigin.x = nX;
+    m_ptOrigin.y = nY;
+    return ptPrev;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetOrigin
+//
+//************************************************************************
+
+LCDSOFTPOINT CLCDSoftSurface::GetOrigin(void) const
+{
+    return m_ptOrigin;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::Clear
+//
+//************************************************************************
+
+void CLCDSoftSurface::Clear(void)
+{
+    if(NULL != m_pBits)
+    {
+        memset(m_pBits, 0, (size_t)m_nPitch * m_nHeight);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::ClearRect
+//
+//************************************************************************
+
+void CLCDSoftSurface::ClearRect(const LCDSOFTRECT &rc)
+{
+    LCDSOFTRECT rcClear;
+    rcClear.left = SoftMax(rc.left, 0);
+    rcClear.top = SoftMax(rc.top, 0);
+    rcClear.right = SoftMin(rc.right, m_nWidth);
+    rcClear.bottom = SoftMin(rc.bottom, m_nHeight);
+    if((NULL == m_pBits) || (rcClear.left >= rcClear.right) || (rcClear.top >= rcClear.bottom))
+    {
+        return;
+    }
+
+    for(int y = rcClear.top; y < rcClear.bottom; ++y)
+    {
+        if(1 == m_nBitCount)
+        {
+            FillPackedSpan(y, rcClear.left, rcClear.right, 0, false);
+        }
+        else
+        {
+            int nBytesPerPixel = m_nBitCount / 8;
+            memset(m_pBits + y * m_nPitch + rcClear.left * nBytesPerPixel, 0,
+                   (rcClear.right - rcClear.left) * nBytesPerPixel);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::FillRect
+//
+//************************************************************************
+
+void CLCDSoftSurface::FillRect(const LCDSOFTRECT &rc, LCDSOFTCOLOR crColor)
+{
+    LCDSOFTRECT rcSurface;
+    if(!ClipToSurface(rc, rcSurface))
+    {
+        return;
+    }
+
+    unsigned int dwColor = ToSurfaceColor(crColor);
+    int nWidth = rcSurface.right - rcSurface.left;
+
+    for(int y = rcSurface.top; y < rcSurface.bottom; ++y)
+    {
+        if(1 == m_nBitCount)
+        {
+            FillPackedSpan(y, rcSurface.left, rcSurface.right, dwColor, false);
+        }
+        else if(32 == m_nBitCount)
+        {
+            unsigned int *pRow = (unsigned int *)(m_pBits + y * m_nPitch) + rcSurface.left;
+            for(int x = 0; x < nWidth; ++x)
+            {
+                pRow[x] = dwColor;
+            }
+        }
+        else
+        {
+            memset(m_pBits + y * m_nPitch + rcSurface.left, (unsigned char)dwColor, nWidth);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::FrameRect
+//
+//************************************************************************
+
+void CLCDSoftSurface::FrameRect(const LCDSOFTRECT &rc, LCDSOFTCOLOR crColor)
+{
+    LCDSOFTRECT rcEdge = { rc.left, rc.top, rc.right, rc.top + 1 };
+    FillRect(rcEdge, crColor);
+
+    rcEdge.top = rc.bottom - 1;
+    rcEdge.bottom = rc.bottom;
+    FillRect(rcEdge, crColor);
+
+    rcEdge.top = rc.top;
+    rcEdge.right = rc.left + 1;
+    FillRect(rcEdge, crColor);
+
+    rcEdge.left = rc.right - 1;
+    rcEdge.right = rc.right;
+    FillRect(rcEdge, crColor);
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::InvertRect
+//
+//************************************************************************
+
+void CLCDSoftSurface::InvertRect(const LCDSOFTRECT &rc)
+{
+    LCDSOFTRECT rcSurface;
+    if(!ClipToSurface(rc, rcSurface))
+    {
+        return;
+    }
+
+    int nWidth = rcSurface.right - rcSurface.left;
+    for(int y = rcSurface.top; y < rcSurface.bottom; ++y)
+    {
+        if(1 == m_nBitCount)
+        {
+            FillPackedSpan(y, rcSurface.left, rcSurface.right, 1, true);
+        }
+        else if(32 == m_nBitCount)
+        {
+            unsigned int *pRow = (unsigned int *)(m_pBits + y * m_nPitch) + rcSurface.left;
+            for(int x = 0; x < nWidth; ++x)
+            {
+                pRow[x] ^= 0x00FFFFFF;
+            }
+        }
+        else
+        {
+            unsigned char *pRow = m_pBits + y * m_nPitch + rcSurface.left;
+            for(int x = 0; x < nWidth; ++x)
+            {
+                pRow[x] ^= 0xFF;
+            }
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::HLine
+//
+//************************************************************************
+
+void CLCDSoftSurface::HLine(int nX1, int nX2, int nY, LCDSOFTCOLOR crColor)
+{
+    LCDSOFTRECT rc = { SoftMin(nX1, nX2), nY, SoftMax(nX1, nX2), nY + 1 };
+    FillRect(rc, crColor);
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::Blit
+//
+// The source is a top-down 32bpp BGRA image. With bAlpha, the source is
+// expected to be premultiplied, as with AlphaBlend().
+//************************************************************************
+
+void CLCDSoftSurface::Blit(int nX, int nY, int nWidth, int nHeight,
+                           const unsigned char *pSrcBits, int nSrcPitch, bool bAlpha)
+{
+    if(NULL == pSrcBits)
+    {
+        return;
+    }
+
+    LCDSOFTRECT rc = { nX, nY, nX + nWidth, nY + nHeight };
+    LCDSOFTRECT rcSurface;
+    if(!ClipToSurface(rc, rcSurface))
+    {
+        return;
+    }
+
+    // where the clipped area starts in the source
+    int nSrcX = rcSurface.left - (nX + m_ptOrigin.x);
+    int nSrcY = rcSurface.top - (nY + m_ptOrigin.y);
+    int nCopyWidth = rcSurface.right - rcSurface.left;
+
+    for(int y = rcSurface.top; y < rcSurface.bottom; ++y)
+    {
+        const unsigned char *pSrc = pSrcBits + (nSrcY + y - rcSurface.top) * nSrcPitch + nSrcX * 4;
+
+        if(32 == m_nBitCount)
+        {
+            unsigned char *pDst = m_pBits + y * m_nPitch + rcSurface.left * 4;
+            if(!bAlpha)
+            {
+                memcpy(pDst, pSrc, nCopyWidth * 4);
+                continue;
+            }
+
+            BlendRow(pDst, pSrc, nCopyWidth);
+        }
+        else if(1 == m_nBitCount)
+        {
+            unsigned int *pDst = (unsigned int *)(m_pBits + y * m_nPitch);
+            for(int x = rcSurface.left; x < rcSurface.right; ++x, pSrc += 4)
+            {
+                if(bAlpha && pSrc[3] < 128)
+                {
+                    continue;
+                }
+                unsigned int dwBit = 1U << (x & 31);
+                if(ToSurfaceColor(LCDSOFT_RGB(pSrc[2], pSrc[1], pSrc[0])))
+                {
+                    pDst[x >> 5] |= dwBit;
+                }
+                else
+                {
+                    pDst[x >> 5] &= ~dwBit;
+                }
+            }
+        }
+        else
+        {
+            unsigned char *pDst = m_pBits + y * m_nPitch + rcSurface.left;
+            for(int x = 0; x < nCopyWidth; ++x, pSrc += 4)
+            {
+                if(bAlpha && pSrc[3] < 128)
+                {
+                    continue;
+                }
+                pDst[x] = (unsigned char)ToSurfaceColor(LCDSOFT_RGB(pSrc[2], pSrc[1], pSrc[0]));
+            }
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::BlitPacked
+//
+// The source and the optional mask are packed 1bpp images in the layout
+// of the 1bpp surface. Pixels whose mask bit is clear are left alone.
+//************************************************************************
+
+void CLCDSoftSurface::BlitPacked(int nX, int nY, int nWidth, int nHeight,
+                                 const unsigned char *pSrcBits, int nSrcPitch,
+                                 const unsigned char *pMaskBits, int nMaskPitch)
+{
+    if(NULL == pSrcBits)
+    {
+        return;
+    }
+
+    LCDSOFTRECT rc = { nX, nY, nX + nWidth, nY + nHeight };
+    LCDSOFTRECT rcSurface;
+    if(!ClipToSurface(rc, rcSurface))
+    {
+        return;
+    }
+
+    // where the clipped area starts in the source
+    int nSrcX = rcSurface.left - (nX + m_ptOrigin.x);
+    int nSrcY = rcSurface.top - (nY + m_ptOrigin.y);
+    int nSrcBits = nWidth;
+
+    for(int y = rcSurface.top; y < rcSurface.bottom; ++y)
+    {
+        const unsigned char *pSrcRow = pSrcBits + (nSrcY + y - rcSurface.top) * nSrcPitch;
+        const unsigned char *pMaskRow = (NULL != pMaskBits) ?
+            pMaskBits + (nSrcY + y - rcSurface.top) * nMaskPitch : NULL;
+
+        if(1 != m_nBitCount)
+        {
+            for(int x = rcSurface.left; x < rcSurface.right; ++x)
+            {
+                int nBit = nSrcX + x - rcSurface.left;
+                if((NULL != pMaskRow) && !(pMaskRow[nBit >> 3] & (1 << (nBit & 7))))
+                {
+                    continue;
+                }
+                bool bSet = (pSrcRow[nBit >> 3] & (1 << (nBit & 7))) ? true : false;
+                LCDSOFTRECT rcPixel = { x - m_ptOrigin.x, y - m_ptOrigin.y, 0, 0 };
+                rcPixel.right = rcPixel.left + 1;
+                rcPixel.bottom = rcPixel.top + 1;
+                FillRect(rcPixel, bSet ? LCDSOFT_RGB(255, 255, 255) : LCDSOFT_RGB(0, 0, 0));
+            }
+            continue;
+        }
+
+        // one destination word at a time
+        unsigned int *pDst = (unsigned int *)(m_pBits + y * m_nPitch);
+        int x = rcSurface.left;
+        while(x < rcSurface.right)
+        {
+            int nSpan = SoftMin(32 - (x & 31), rcSurface.right - x);
+            int nBit = nSrcX + x - rcSurface.left;
+
+            unsigned int dwMask = (32 == nSpan) ? 0xFFFFFFFF : ((1U << nSpan) - 1);
+            unsigned int dwSrc = GetPackedBits(pSrcRow, nBit, nSrcBits) & dwMask;
+            if(NULL != pMaskRow)
+            {
+                dwMask &= GetPackedBits(pMaskRow, nBit, nSrcBits);
+                dwSrc &= dwMask;
+            }
+
+            int nShift = x & 31;
+            unsigned int &dwDst = pDst[x >> 5];
+            dwDst = (dwDst & ~(dwMask << nShift)) | (dwSrc << nShift);
+
+            x += nSpan;
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::DrawText
+//
+// Draws with the built-in 5x7 font. '\n' starts a new line.
+//************************************************************************
+
+void CLCDSoftSurface::DrawText(int nX, int nY, const char *szText, int nLength,
+                               LCDSOFTCOLOR crColor, int nScale)
+{
+    DrawTextT(nX, nY, szText, nLength, crColor, nScale);
+}
+
+void CLCDSoftSurface::DrawText(int nX, int nY, const wchar_t *szText, int nLength,
+                               LCDSOFTCOLOR crColor, int nScale)
+{
+    DrawTextT(nX, nY, szText, nLength, crColor, nScale);
+}
+
+template<class CHAR>
+void CLCDSoftSurface::DrawTextT(int nX, int nY, const CHAR *szText, int nLength,
+                                LCDSOFTCOLOR crColor, int nScale)
+{
+    if((NULL == szText) || (NULL == m_pBits))
+    {
+        return;
+    }
+
+    nScale = SoftMax(nScale, 1);
+    unsigned int dwColor = ToSurfaceColor(crColor);
+
+    int nPenX = nX;
+    for(int i = 0; i < nLength; ++i)
+    {
+        if('\n' == szText[i])
+        {
+            nPenX = nX;
+            nY += GLYPH_LINEHEIGHT * nScale;
+            continue;
+        }
+
+        DrawGlyph(nPenX, nY, (unsigned int)szText[i], dwColor, nScale);
+        nPenX += GLYPH_ADVANCE * nScale;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::ClipToSurface
+//
+//************************************************************************
+
+bool CLCDSoftSurface::ClipToSurface(const LCDSOFTRECT &rcLogical, LCDSOFTRECT &rcSurface) const
+{
+    if(NULL == m_pBits)
+    {
+        return false;
+    }
+
+    rcSurface.left = SoftMax(rcLogical.left + m_ptOrigin.x, m_rcClip.left);
+    rcSurface.top = SoftMax(rcLogical.top + m_ptOrigin.y, m_rcClip.top);
+    rcSurface.right = SoftMin(rcLogical.right + m_ptOrigin.x, m_rcClip.right);
+    rcSurface.bottom = SoftMin(rcLogical.bottom + m_ptOrigin.y, m_rcClip.bottom);
+
+    return (rcSurface.left < rcSurface.right) && (rcSurface.top < rcSurface.bottom);
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetTextExtent
+//
+//************************************************************************
+
+LCDSOFTSIZE CLCDSoftSurface::GetTextExtent(const char *szText, int nLength, int nScale)
+{
+    return GetTextExtentT(szText, nLength, nScale);
+}
+
+LCDSOFTSIZE CLCDSoftSurface::GetTextExtent(const wchar_t *szText, int nLength, int nScale)
+{
+    return GetTextExtentT(szText, nLength, nScale);
+}
+
+template<class CHAR>
+LCDSOFTSIZE CLCDSoftSurface::GetTextExtentT(const CHAR *szText, int nLength, int nScale)
+{
+    LCDSOFTSIZE sizeExtent = { 0, 0 };
+    if((NULL == szText) || (0 >= nLength))
+    {
+        return sizeExtent;
+    }
+
+    nScale = SoftMax(nScale, 1);
+
+    int nLines = 1;
+    int nColumns = 0;
+    int nMaxColumns = 0;
+    for(int i = 0; i < nLength; ++i)
+    {
+        if('\n' == szText[i])
+        {
+            ++nLines;
+            nColumns = 0;
+            continue;
+        }
+        nMaxColumns = SoftMax(nMaxColumns, ++nColumns);
+    }
+
+    sizeExtent.cx = nMaxColumns * GLYPH_ADVANCE * nScale;
+    sizeExtent.cy = nLines * GLYPH_LINEHEIGHT * nScale;
+    return sizeExtent;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetScaleForFontHeight
+//
+// Maps a font height (LOGFONT, negative or not) onto an integer scale of
+// the built-in font.
+//************************************************************************
+
+int CLCDSoftSurface::GetScaleForFontHeight(int nFontHeight)
+{
+    int nScale = abs(nFontHeight) / GLYPH_LINEHEIGHT;
+    return SoftMax(nScale, 1);
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::BlendRow
+//
+// Portable version of CLCDCompositor::BlendRow, with the same rounding.
+//************************************************************************
+
+void CLCDSoftSurface::BlendRow(unsigned char *pDst, const unsigned char *pSrc, int nWidth)
+{
+    for(int x = 0; x < nWidth; ++x)
+    {
+        const unsigned char *pS = pSrc + x * 4;
+        unsigned char *pD = pDst + x * 4;
+        unsigned int nInvAlpha = 255 - pS[3];
+        for(int c = 0; c < 4; ++c)
+        {
+            // pD[c] * nInvAlpha / 255, rounded
+            unsigned int t = pD[c] * nInvAlpha + 128;
+            unsigned int nValue = pS[c] + ((t + (t >> 8)) >> 8);
+            pD[c] = (unsigned char)((nValue > 255) ? 255 : nValue);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::ToSurfaceColor
+//
+// 32bpp surfaces store BGRA, 8bpp and 1bpp surfaces use the same
+// threshold as the monochrome DIB palette (see CLCDGfxBase::CreateBitmap).
+//************************************************************************
+
+unsigned int CLCDSoftSurface::ToSurfaceColor(LCDSOFTCOLOR crColor) const
+{
+    unsigned int nRed = crColor & 0xFF;
+    unsigned int nGreen = (crColor >> 8) & 0xFF;
+    unsigned int nBlue = (crColor >> 16) & 0xFF;
+
+    if(32 == m_nBitCount)
+    {
+        return (nRed << 16) | (nGreen << 8) | nBlue;
+    }
+
+    unsigned int nLuma = (nRed * 77 + nGreen * 150 + nBlue * 29) >> 8;
+    if(1 == m_nBitCount)
+    {
+        return (nLuma > 128) ? 1 : 0;
+    }
+    return (nLuma > 128) ? 0xFF : 0x00;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::DrawGlyph
+//
+//************************************************************************
+
+void CLCDSoftSurface::DrawGlyph(int nX, int nY, unsigned int ch, unsigned int dwColor, int nScale)
+{
+    if((ch < 0x20) || (ch > 0x7E))
+    {
+        ch = '?';
+    }
+    const unsigned char *pGlyph = s_Glyphs[ch - 0x20];
+
+    for(int nCol = 0; nCol < GLYPH_WIDTH; ++nCol)
+    {
+        for(int nRow = 0; nRow < GLYPH_HEIGHT; ++nRow)
+        {
+            if(0 == (pGlyph[nCol] & (1 << nRow)))
+            {
+                continue;
+            }
+
+            LCDSOFTRECT rc = { nX + nCol * nScale, nY + nRow * nScale, 0, 0 };
+            rc.right = rc.left + nScale;
+            rc.bottom = rc.top + nScale;
+
+            LCDSOFTRECT rcSurface;
+            if(!ClipToSurface(rc, rcSurface))
+            {
+                continue;
+            }
+
+            for(int y = rcSurface.top; y < rcSurface.bottom; ++y)
+            {
+                if(1 == m_nBitCount)
+                {
+                    FillPackedSpan(y, rcSurface.left, rcSurface.right, dwColor, false);
+                    continue;
+                }
+
+                for(int x = rcSurface.left; x < rcSurface.right; ++x)
+                {
+                    if(32 == m_nBitCount)
+                    {
+                        ((unsigned int *)(m_pBits + y * m_nPitch))[x] = dwColor;
+                    }
+                    else
+                    {
+                        m_pBits[y * m_nPitch + x] = (unsigned char)dwColor;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::FillPackedSpan
+//
+// Sets (or, with bInvert, toggles) the bits [nLeft, nRight) of a row of
+// the 1bpp surface, a whole word at a time.
+//************************************************************************
+
+void CLCDSoftSurface::FillPackedSpan(int nY, int nLeft, int nRight, unsigned int dwBit, bool bInvert)
+{
+    unsigned int *pRow = (unsigned int *)(m_pBits + nY * m_nPitch);
+    unsigned int dwFill = dwBit ? 0xFFFFFFFF : 0;
+
+    int nFirst = nLeft >> 5;
+    int nLast = (nRight - 1) >> 5;
+    unsigned int dwFirstMask = 0xFFFFFFFF << (nLeft & 31);
+    unsigned int dwLastMask = 0xFFFFFFFF >> (31 - ((nRight - 1) & 31));
+
+    for(int nWord = nFirst; nWord <= nLast; ++nWord)
+    {
+        unsigned int dwMask = 0xFFFFFFFF;
+        if(nWord == nFirst)
+        {
+            dwMask &= dwFirstMask;
+        }
+        if(nWord == nLast)
+        {
+            dwMask &= dwLastMask;
+        }
+
+        if(bInvert)
+        {
+            pRow[nWord] ^= dwMask;
+        }
+        else
+        {
+            pRow[nWord] = (pRow[nWord] & ~dwMask) | (dwFill & dwMask);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::GetPackedBits
+//
+// Returns up to 32 bits of a packed row, starting at nBit. Bits at or
+// past nRowBits read as zero.
+//************************************************************************
+
+unsigned int CLCDSoftSurface::GetPackedBits(const unsigned char *pRow, int nBit, int nRowBits)
+{
+    const unsigned int *pWords = (const unsigned int *)pRow;
+    int nWord = nBit >> 5;
+    int nShift = nBit & 31;
+    int nWords = (nRowBits + 31) >> 5;
+
+    unsigned int dwBits = pWords[nWord] >> nShift;
+    if((0 != nShift) && (nWord + 1 < nWords))
+    {
+        dwBits |= pWords[nWord + 1] << (32 - nShift);
+    }
+
+    int nValid = nRowBits - nBit;
+    if(nValid < 32)
+    {
+        dwBits &= (1U << nValid) - 1;
+    }
+    return dwBits;
+}
+
+
+//************************************************************************
+//
+// CLCDSoftSurface::ExpandPackedRow
+//
+// Expands a packed 1bpp row into one byte (0x00 or 0xFF) per pixel, the
+// layout of lgLcdBitmap160x43x1.
+//************************************************************************
+
+void CLCDSoftSurface::ExpandPackedRow(const unsigned char *pSrc, unsigned char *pDst, int nWidth)
+{
+    int x = 0;
+
+#ifdef LCDSOFT_SSE2
+    // 16 pixels per step: broadcast the two source bytes over 8 lanes each,
+    // isolate one bit per lane and widen it to a full byte
+    const __m128i xmmBits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128);
+    for(; x + 16 <= nWidth; x += 16)
+    {
+        int nPair = pSrc[x >> 3] | (pSrc[(x >> 3) + 1] << 8);
+        __m128i xmm = _mm_cvtsi32_si128(nPair);
+        xmm = _mm_unpacklo_epi8(xmm, xmm);
+        xmm = _mm_unpacklo_epi16(xmm, xmm);
+        xmm = _mm_unpacklo_epi32(xmm, xmm);
+        xmm = _mm_cmpeq_epi8(_mm_and_si128(xmm, xmmBits), xmmBits);
+        _mm_storeu_si128((__m128i *)(pDst + x), xmm);
+    }
+#endif
+
+    for(; x < nWidth; ++x)
+    {
+        pDst[x] = (pSrc[x >> 3] & (1 << (x & 7))) ? 0xFF : 0x00;
+    }
+}
+
+//** end of LCDSoftSurface.cpp *******************************************
@@ -0,0 +1,138 @@
+//************************************************************************
+//
+// LCDSoftSurface.h
+//
+// The CLCDSoftSurface class is the raster core of CLCDGfxSoft: fill,
+// blit, clip and text primitives on a plain pixel buffer it does not
+// own. It only uses standard C++ and the plain structs below, so that
+// it builds without windows.h; CLCDGfxSoft adapts it to the RECT,
+// COLORREF and lgLcdBitmap types of the rest of the library.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDSOFTSURFACE_H_INCLUDED_
+#define _LCDSOFTSURFACE_H_INCLUDED_
+
+#include <stddef.h>
+
+// same layouts as RECT, POINT and SIZE
+struct LCDSOFTRECT
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+struct LCDSOFTPOINT
+{
+    int x;
+    int y;
+};
+
+struct LCDSOFTSIZE
+{
+    int cx;
+    int cy;
+};
+
+// 0x00BBGGRR, the layout of COLORREF
+typedef unsigned int LCDSOFTCOLOR;
+#define LCDSOFT_RGB(r, g, b) ((LCDSOFTCOLOR)(((unsigned char)(r)) | \
+                              ((unsigned int)((unsigned char)(g)) << 8) | \
+                              ((unsigned int)((unsigned char)(b)) << 16)))
+
+
+class CLCDSoftSurface
+{
+public:
+    CLCDSoftSurface(void);
+    virtual ~CLCDSoftSurface(void);
+
+    // pBits holds nHeight rows of nPitch bytes at 32 (BGRA), 8 or 1 bits
+    // per pixel. 1bpp rows are packed into 32 bit words, leftmost pixel
+    // in the least significant bit. The clip rectangle and the origin
+    // are kept, so that the buffers of a ring can be swapped in.
+    void Attach(unsigned char *pBits, int nWidth, int nHeight, int nPitch, int nBitCount);
+    void Detach(void);
+    unsigned char *GetBits(void) const;
+    int GetWidth(void) const;
+    int GetHeight(void) const;
+    int GetPitch(void) const;
+    int GetBitCount(void) const;
+
+    // clipping and origin, in surface coordinates
+    void SetClipRect(const LCDSOFTRECT *prcClip);
+    LCDSOFTRECT GetClipRect(void) const;
+    LCDSOFTPOINT SetOrigin(int nX, int nY);
+    LCDSOFTPOINT GetOrigin(void) const;
+
+    // in surface coordinates, regardless of the clip rectangle
+    void Clear(void);
+    void ClearRect(const LCDSOFTRECT &rc);
+
+    // primitives, in coordinates relative to the current origin
+    void FillRect(const LCDSOFTRECT &rc, LCDSOFTCOLOR crColor);
+    void FrameRect(const LCDSOFTRECT &rc, LCDSOFTCOLOR crColor);
+    void InvertRect(const LCDSOFTRECT &rc);
+    void HLine(int nX1, int nX2, int nY, LCDSOFTCOLOR crColor);
+    void Blit(int nX, int nY, int nWidth, int nHeight,
+              const unsigned char *pSrcBits, int nSrcPitch, bool bAlpha);
+    void BlitPacked(int nX, int nY, int nWidth, int nHeight,
+                    const unsigned char *pSrcBits, int nSrcPitch,
+                    const unsigned char *pMaskBits = NULL, int nMaskPitch = 0);
+    void DrawText(int nX, int nY, const char *szText, int nLength,
+                  LCDSOFTCOLOR crColor, int nScale = 1);
+    void DrawText(int nX, int nY, const wchar_t *szText, int nLength,
+                  LCDSOFTCOLOR crColor, int nScale = 1);
+
+    // Translates a rectangle by the current origin and intersects it
+    // with the clip rectangle. Returns false when nothing is left.
+    bool ClipToSurface(const LCDSOFTRECT &rcLogical, LCDSOFTRECT &rcSurface) const;
+
+    // built-in 5x7 font metrics
+    static LCDSOFTSIZE GetTextExtent(const char *szText, int nLength, int nScale = 1);
+    static LCDSOFTSIZE GetTextExtent(const wchar_t *szText, int nLength, int nScale = 1);
+    static int GetScaleForFontHeight(int nFontHeight);
+
+    // packed 1bpp helpers
+    static void ExpandPackedRow(const unsigned char *pSrc, unsigned char *pDst, int nWidth);
+    static unsigned int GetPackedBits(const unsigned char *pRow, int nBit, int nRowBits);
+
+    enum
+    {
+        GLYPH_WIDTH = 5,
+        GLYPH_HEIGHT = 7,
+        GLYPH_ADVANCE = 6,
+        GLYPH_LINEHEIGHT = 9
+    };
+
+protected:
+    // dst = src + dst * (1 - src.alpha), premultiplied BGRA
+    virtual void BlendRow(unsigned char *pDst, const unsigned char *pSrc, int nWidth);
+    unsigned int ToSurfaceColor(LCDSOFTCOLOR crColor) const;
+    void DrawGlyph(int nX, int nY, unsigned int ch, unsigned int dwColor, int nScale);
+    void FillPackedSpan(int nY, int nLeft, int nRight, unsigned int dwBit, bool bInvert);
+
+    template<class CHAR>
+    void DrawTextT(int nX, int nY, const CHAR *szText, int nLength,
+                   LCDSOFTCOLOR crColor, int nScale);
+    template<class CHAR>
+    static LCDSOFTSIZE GetTextExtentT(const CHAR *szText, int nLength, int nScale);
+
+protected:
+    unsigned char *m_pBits;
+    int m_nWidth;
+    int m_nHeight;
+    int m_nPitch;
+    int m_nBitCount;
+    LCDSOFTRECT m_rcClip;
+    LCDSOFTPOINT m_ptOrigin;
+};
+
+#endif // !_LCDSOFTSURFACE_H_INCLUDED_
+
+//** end of LCDSoftSurface.h *********************************************
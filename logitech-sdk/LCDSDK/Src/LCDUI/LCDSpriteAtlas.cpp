@@ -0,0 +1,463 @@
+//************************************************************************
+//
+// LCDSpriteAtlas.cpp
+//
+// The CLCDSpriteAtlas class holds many animations in one bitmap. Each
+// animation is a sequence of frames, each frame a rectangle of the
+// bitmap shown for its own duration.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::CLCDSpriteAtlas
+//
+//************************************************************************
+
+CLCDSpriteAtlas::CLCDSpriteAtlas(void)
+:   m_hBitmap(NULL),
+    m_eDitherMode(CLCDDither::DITHER_NONE)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::~CLCDSpriteAtlas
+//
+//************************************************************************
+
+CLCDSpriteAtlas::~CLCDSpriteAtlas(void)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::SetBitmap
+//
+//************************************************************************
+
+HRESULT CLCDSpriteAtlas::SetBitmap(HBITMAP hBitmap, BOOL bPremultiply /* = FALSE */)
+{
+    Clear();
+    m_hBitmap = hBitmap;
+    if(NULL == hBitmap)
+    {
+        m_Image.Clear();
+        return S_OK;
+    }
+
+    HRESULT hRes = m_Image.SetBitmap(hBitmap, bPremultiply);
+    if(FAILED(hRes))
+    {
+        LCDUITRACE(_T("CLCDSpriteAtlas::SetBitmap(): could not convert the bitmap.\n"));
+    }
+    return hRes;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetBitmap
+//
+//************************************************************************
+
+HBITMAP CLCDSpriteAtlas::GetBitmap(void)
+{
+    return m_hBitmap;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::SetDitherMode
+//
+//************************************************************************
+
+void CLCDSpriteAtlas::SetDitherMode(CLCDDither::eDITHER_MODE eMode)
+{
+    if(m_eDitherMode != eMode)
+    {
+        m_eDitherMode = eMode;
+        ConvertFrames();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetDitherMode
+//
+//************************************************************************
+
+CLCDDither::eDITHER_MODE CLCDSpriteAtlas::GetDitherMode(void)
+{
+    return m_eDitherMode;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::AddAnimation
+//
+//************************************************************************
+
+int CLCDSpriteAtlas::AddAnimation(BOOL bLoop /* = TRUE */)
+{
+    ANIMATION Animation;
+    Animation.bLoop = bLoop;
+    m_Animations.push_back(Animation);
+    return (int)m_Animations.size() - 1;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::AddFrame
+//
+//************************************************************************
+
+HRESULT CLCDSpriteAtlas::AddFrame(int nAnimation, const RECT &rcFrame, DWORD dwDuration)
+{
+    if((0 > nAnimation) || ((int)m_Animations.size() <= nAnimation))
+    {
+        LCDUITRACE(_T("CLCDSpriteAtlas::AddFrame(): invalid animation.\n"));
+        return E_INVALIDARG;
+    }
+
+    // frames must lie within the bitmap
+    RECT rcImage = { 0, 0, m_Image.GetWidth(), m_Image.GetHeight() };
+    RECT rcInside;
+    if(IsRectEmpty(&rcFrame) || !IntersectRect(&rcInside, &rcFrame, &rcImage) ||
+       !EqualRect(&rcInside, &rcFrame))
+    {
+        LCDUITRACE(_T("CLCDSpriteAtlas::AddFrame(): the frame is not within the bitmap.\n"));
+        return E_INVALIDARG;
+    }
+
+    FRAME Frame;
+    Frame.rc = rcFrame;
+    Frame.dwDuration = dwDuration;
+    Frame.dwEnd = 0;
+    ConvertFrame(Frame);
+
+    ANIMATION &rAnimation = m_Animations[nAnimation];
+    rAnimation.Frames.push_back(Frame);
+    UpdateTimes(rAnimation);
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::AddStrip
+//
+//************************************************************************
+
+int CLCDSpriteAtlas::AddStrip(int nX, int nY, int nFrameWidth, int nFrameHeight, int nFrames,
+                              DWORD dwDuration, BOOL bLoop /* = TRUE */)
+{
+    int nAnimation = AddAnimation(bLoop);
+    for(int i = 0; i < nFrames; i++)
+    {
+        RECT rcFrame = { nX + i * nFrameWidth, nY, nX + (i + 1) * nFrameWidth, nY + nFrameHeight };
+        if(FAILED(AddFrame(nAnimation, rcFrame, dwDuration)))
+        {
+            // the animation was added last, so no other index changes
+            m_Animations.pop_back();
+            return -1;
+        }
+    }
+    return nAnimation;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::SetDuration
+//
+//************************************************************************
+
+HRESULT CLCDSpriteAtlas::SetDuration(int nAnimation, DWORD dwDuration)
+{
+    if((0 > nAnimation) || ((int)m_Animations.size() <= nAnimation))
+    {
+        return E_INVALIDARG;
+    }
+
+    ANIMATION &rAnimation = m_Animations[nAnimation];
+    for(size_t i = 0; i < rAnimation.Frames.size(); i++)
+    {
+        rAnimation.Frames[i].dwDuration = dwDuration;
+    }
+    UpdateTimes(rAnimation);
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::Clear
+//
+//************************************************************************
+
+void CLCDSpriteAtlas::Clear(void)
+{
+    m_Animations.clear();
+    m_PackedBits.clear();
+    m_PackedMask.clear();
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetAnimationCount
+//
+//************************************************************************
+
+int CLCDSpriteAtlas::GetAnimationCount(void)
+{
+    return (int)m_Animations.size();
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetFrameCount
+//
+//************************************************************************
+
+int CLCDSpriteAtlas::GetFrameCount(int nAnimation)
+{
+    if((0 > nAnimation) || ((int)m_Animations.size() <= nAnimation))
+    {
+        return 0;
+    }
+    return (int)m_Animations[nAnimation].Frames.size();
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetTotalDuration
+//
+//************************************************************************
+
+DWORD CLCDSpriteAtlas::GetTotalDuration(int nAnimation)
+{
+    if(0 == GetFrameCount(nAnimation))
+    {
+        return 0;
+    }
+    return m_Animations[nAnimation].Frames.back().dwEnd;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetFrameRect
+//
+//************************************************************************
+
+BOOL CLCDSpriteAtlas::GetFrameRect(int nAnimation, int nFrame, RECT &rcFrame)
+{
+    FRAME *pFrame = GetFrame(nAnimation, nFrame);
+    if(NULL == pFrame)
+    {
+        return FALSE;
+    }
+    rcFrame = pFrame->rc;
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetFrameAt
+//
+// Looks the frame up in the end times of the frames, so the result only
+// depends on the time elapsed, not on how often this is called.
+//************************************************************************
+
+int CLCDSpriteAtlas::GetFrameAt(int nAnimation, DWORD dwElapsed)
+{
+    int nFrames = GetFrameCount(nAnimation);
+    if(0 == nFrames)
+    {
+        return -1;
+    }
+
+    ANIMATION &rAnimation = m_Animations[nAnimation];
+    DWORD dwTotal = rAnimation.Frames.back().dwEnd;
+    if(dwElapsed >= dwTotal)
+    {
+        if(!rAnimation.bLoop || (0 == dwTotal))
+        {
+            return nFrames - 1;
+        }
+        dwElapsed %= dwTotal;
+    }
+
+    // first frame ending after dwElapsed
+    int nFirst = 0;
+    int nLast = nFrames - 1;
+    while(nFirst < nLast)
+    {
+        int nMiddle = (nFirst + nLast) / 2;
+        if(rAnimation.Frames[nMiddle].dwEnd > dwElapsed)
+        {
+            nLast = nMiddle;
+        }
+        else
+        {
+            nFirst = nMiddle + 1;
+        }
+    }
+    return nFirst;
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::DrawFrame
+//
+//************************************************************************
+
+void CLCDSpriteAtlas::DrawFrame(CLCDGfxBase &rGfx, int nAnimation, int nFrame, int nX, int nY)
+{
+    FRAME *pFrame = GetFrame(nAnimation, nFrame);
+    if(NULL == pFrame)
+    {
+        return;
+    }
+
+    int nWidth = pFrame->rc.right - pFrame->rc.left;
+    int nHeight = pFrame->rc.bottom - pFrame->rc.top;
+
+    // each surface takes the conversion it can copy directly
+    BOOL bAlpha = m_Image.HasAlpha();
+    if(rGfx.DrawPacked(nX, nY, nWidth, nHeight,
+                       &m_PackedBits[pFrame->nPacked], pFrame->nPackedPitch,
+                       bAlpha ? &m_PackedMask[pFrame->nPacked] : NULL, pFrame->nPackedPitch))
+    {
+        return;
+    }
+
+    RECT rcDst = { nX, nY, nX + nWidth, nY + nHeight };
+    if(rGfx.DrawImage(rcDst, m_Image, &pFrame->rc))
+    {
+        return;
+    }
+
+    if(NULL != m_hBitmap)
+    {
+        HDC hCompatibleDC = CreateCompatibleDC(rGfx.GetHDC());
+        HBITMAP hOldBitmap = (HBITMAP)SelectObject(hCompatibleDC, m_hBitmap);
+        if(bAlpha)
+        {
+            BLENDFUNCTION opblender = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+            AlphaBlend(rGfx.GetHDC(), nX, nY, nWidth, nHeight,
+                       hCompatibleDC, pFrame->rc.left, pFrame->rc.top, nWidth, nHeight, opblender);
+        }
+        else
+        {
+            BitBlt(rGfx.GetHDC(), nX, nY, nWidth, nHeight,
+                   hCompatibleDC, pFrame->rc.left, pFrame->rc.top, SRCCOPY);
+        }
+        SelectObject(hCompatibleDC, hOldBitmap);
+        DeleteDC(hCompatibleDC);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::GetFrame
+//
+//************************************************************************
+
+CLCDSpriteAtlas::FRAME *CLCDSpriteAtlas::GetFrame(int nAnimation, int nFrame)
+{
+    if((0 > nFrame) || (GetFrameCount(nAnimation) <= nFrame))
+    {
+        return NULL;
+    }
+    return &m_Animations[nAnimation].Frames[nFrame];
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::ConvertFrame
+//
+// Dithers the frame and appends it to the packed images. Frames are
+// converted on their own, so that each starts on a byte.
+//************************************************************************
+
+void CLCDSpriteAtlas::ConvertFrame(FRAME &rFrame)
+{
+    int nWidth = rFrame.rc.right - rFrame.rc.left;
+    int nHeight = rFrame.rc.bottom - rFrame.rc.top;
+
+    rFrame.nPackedPitch = CLCDDither::GetPackedPitch(nWidth);
+    rFrame.nPacked = m_PackedBits.size();
+    m_PackedBits.resize(rFrame.nPacked + (size_t)rFrame.nPackedPitch * nHeight);
+    m_PackedMask.resize(m_PackedBits.size());
+
+    const BYTE *pSrc = m_Image.GetBits() + rFrame.rc.top * m_Image.GetPitch() + rFrame.rc.left * 4;
+    CLCDDither::Dither(pSrc, m_Image.GetPitch(), nWidth, nHeight,
+                       &m_PackedBits[rFrame.nPacked], rFrame.nPackedPitch, m_eDitherMode);
+    if(m_Image.HasAlpha())
+    {
+        CLCDDither::AlphaMask(pSrc, m_Image.GetPitch(), nWidth, nHeight,
+                              &m_PackedMask[rFrame.nPacked], rFrame.nPackedPitch);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::ConvertFrames
+//
+//************************************************************************
+
+void CLCDSpriteAtlas::ConvertFrames(void)
+{
+    m_PackedBits.clear();
+    m_PackedMask.clear();
+    for(size_t nAnimation = 0; nAnimation < m_Animations.size(); nAnimation++)
+    {
+        std::vector<FRAME> &rFrames = m_Animations[nAnimation].Frames;
+        for(size_t nFrame = 0; nFrame < rFrames.size(); nFrame++)
+        {
+            ConvertFrame(rFrames[nFrame]);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDSpriteAtlas::UpdateTimes
+//
+//************************************************************************
+
+void CLCDSpriteAtlas::UpdateTimes(ANIMATION &rAnimation)
+{
+    DWORD dwEnd = 0;
+    for(size_t i = 0; i < rAnimation.Frames.size(); i++)
+    {
+        dwEnd += rAnimation.Frames[i].dwDuration;
+        rAnimation.Frames[i].dwEnd = dwEnd;
+    }
+}
+
+
+//** end of LCDSpriteAtlas.cpp *******************************************
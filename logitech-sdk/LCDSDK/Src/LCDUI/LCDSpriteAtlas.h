@@ -0,0 +1,100 @@
+//************************************************************************
+//
+// LCDSpriteAtlas.h
+//
+// The CLCDSpriteAtlas class holds many animations in one bitmap. Each
+// animation is a sequence of frames, each frame a rectangle of the
+// bitmap shown for its own duration.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDSPRITEATLAS_H_INCLUDED_
+#define _LCDSPRITEATLAS_H_INCLUDED_
+
+#include "LCDDither.h"
+#include "LCDCompositor.h"
+
+class CLCDSpriteAtlas
+{
+public:
+    CLCDSpriteAtlas(void);
+    virtual ~CLCDSpriteAtlas(void);
+
+    // The bitmap is not copied for GDI and must stay valid. 32bpp bitmaps
+    // are expected to be premultiplied, unless bPremultiply is set.
+    // Removes all animations.
+    HRESULT SetBitmap(HBITMAP hBitmap, BOOL bPremultiply = FALSE);
+    HBITMAP GetBitmap(void);
+
+    // How the frames are converted for the monochrome display
+    void SetDitherMode(CLCDDither::eDITHER_MODE eMode);
+    CLCDDither::eDITHER_MODE GetDitherMode(void);
+
+    // Returns the index of the new, empty animation. Animations that do
+    // not loop stay on their last frame.
+    int AddAnimation(BOOL bLoop = TRUE);
+    HRESULT AddFrame(int nAnimation, const RECT &rcFrame, DWORD dwDuration);
+    // An animation of nFrames equal frames side by side, starting at
+    // (nX, nY). Returns its index, or -1.
+    int AddStrip(int nX, int nY, int nFrameWidth, int nFrameHeight, int nFrames,
+                 DWORD dwDuration, BOOL bLoop = TRUE);
+    // Gives every frame of the animation the same duration
+    HRESULT SetDuration(int nAnimation, DWORD dwDuration);
+    void Clear(void);
+
+    int GetAnimationCount(void);
+    int GetFrameCount(int nAnimation);
+    DWORD GetTotalDuration(int nAnimation);
+    BOOL GetFrameRect(int nAnimation, int nFrame, RECT &rcFrame);
+
+    // The frame shown dwElapsed milliseconds after the animation started,
+    // or -1 for an animation without frames
+    int GetFrameAt(int nAnimation, DWORD dwElapsed);
+
+    // Draws the frame with its top left corner at (nX, nY), in logical
+    // coordinates. Only the rectangle of the frame is read.
+    void DrawFrame(CLCDGfxBase &rGfx, int nAnimation, int nFrame, int nX, int nY);
+
+protected:
+    struct FRAME
+    {
+        RECT rc;
+        DWORD dwDuration;
+        // time from the start of the animation to the end of the frame
+        DWORD dwEnd;
+        // the frame in m_PackedBits and m_PackedMask
+        size_t nPacked;
+        int nPackedPitch;
+    };
+
+    struct ANIMATION
+    {
+        std::vector<FRAME> Frames;
+        BOOL bLoop;
+    };
+
+    FRAME *GetFrame(int nAnimation, int nFrame);
+    void ConvertFrame(FRAME &rFrame);
+    void ConvertFrames(void);
+    void UpdateTimes(ANIMATION &rAnimation);
+
+protected:
+    HBITMAP m_hBitmap;
+    // premultiplied copy of the bitmap for the compositor
+    CLCDImage m_Image;
+    std::vector<ANIMATION> m_Animations;
+
+    // every frame converted for the monochrome display, packed one after
+    // the other, and the alpha masks at the same offsets
+    CLCDDither::eDITHER_MODE m_eDitherMode;
+    std::vector<BYTE> m_PackedBits;
+    std::vector<BYTE> m_PackedMask;
+};
+
+
+#endif // !_LCDSPRITEATLAS_H_INCLUDED_
+
+//** end of LCDSpriteAtlas.h *********************************************
@@ -1,745 +1,604 @@
-//************************************************************************
-//
-// LCDStreamingText.cpp
-//
-// The CLCDStreamingText class draws streaming text onto the LCD.
-// Streaming text is a single line of text that is repeatedly streamed
-// horizontally across the LCD.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-//************************************************************************
-//
-// CLCDStreamingText::CLCDStreamingText
-//
-//************************************************************************
-
-CLCDStreamingText::CLCDStreamingText()
-{
-    m_sText.erase(m_sText.begin(), m_sText.end());
-    m_sGapText.erase(m_sGapText.begin(), m_sGapText.end());
-
-    m_sGapText.assign(_T("   "));
-    m_hFont = NULL;
-    m_nTextAlignment = DT_LEFT;
-
-    m_bRedoColors = TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::~CLCDStreamingText
-//
-//************************************************************************
-
-CLCDStreamingText::~CLCDStreamingText()
-{
-    RemoveAllText();
-    if (m_hFont)
-    {
-        DeleteObject(m_hFont);
-        m_hFont = NULL;
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::Initialize
-//
-//************************************************************************
-
-HRESULT CLCDStreamingText::Initialize(void)
-{
-    m_eState = STATE_DELAY;
-    m_dwStartDelay  = 2000;
-    m_dwSpeed       = 7;
-	m_dwStepInPixels = 7;
-    m_dwLastUpdate = 0;
-    m_dwEllapsedTime = 0;
-    m_dwLastUpdate = GetTickCount();
-    m_bRecalcExtent = FALSE;
-    m_pQueueHead = NULL;
-    m_fFractDistance = 0.0f;
-
-    m_hFont = (HFONT) GetStockObject(DEFAULT_GUI_FONT);
-    if(NULL != m_hFont)
-    {
-        SetFontPointSize(DEFAULT_POINTSIZE);
-    }
-
-    //return CLCDCollection::Initialize();
-    return ERROR_SUCCESS;
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::ResetUpdate
-//
-//************************************************************************
-
-void CLCDStreamingText::ResetUpdate(void)
-{
-    m_eState = STATE_DELAY;
-    m_dwEllapsedTime = 0;
-    m_dwLastUpdate = GetTickCount();
-    m_pQueueHead = NULL;
-    m_fFractDistance = 0.0f;
-    
-    // remove, re-add, and recalculate the text
-    m_bRecalcExtent = TRUE;
-    RemoveAllText();
-    AddText(m_sText.c_str());
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::Show
-//
-//************************************************************************
-
-void CLCDStreamingText::Show(BOOL bShow)
-{
-    CLCDCollection::Show(bShow);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetText
-//
-//************************************************************************
-
-void CLCDStreamingText::SetText(LPCTSTR szText)
-{
-    LCDUIASSERT(NULL != szText);
-    if(szText && _tcscmp(m_sText.c_str(), szText))
-    {
-        m_sText.assign(szText);
-        m_bRecalcExtent = TRUE;
-        ResetUpdate();
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetOrigin
-//
-//************************************************************************
-
-void CLCDStreamingText::SetOrigin(POINT pt)
-{
-	m_Origin = pt;
-	SetOrigin(pt.x, pt.y);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetOrigin
-//
-//************************************************************************
-
-void CLCDStreamingText::SetOrigin(int nX, int nY)
-{
-	m_Origin.x = nX;
-	m_Origin.y = nY;
-
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-	if (it != m_Objects.end())
-	{
-        CLCDBase *pObject = *it;
-		POINT ptOldOrigin = pObject->GetOrigin();
-		pObject->SetOrigin(nX, nY);
-
-		if ( (ptOldOrigin.x != nX) && (ptOldOrigin.y != nY) )
-        {
-            ResetUpdate();
-        }
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetSize
-//
-//************************************************************************
-
-void CLCDStreamingText::SetSize(SIZE& size)
-{
-    CLCDBase::SetSize(size);
-
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-	if (it != m_Objects.end())
-	{
-        CLCDBase *pObject = *it;
-		pObject->SetSize(size);
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetSize
-//
-//************************************************************************
-
-void CLCDStreamingText::SetSize(int nCX, int nCY)
-{
-    SIZE size = { nCX, nCY };
-    SetSize(size);  
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetBackgroundMode
-//
-//************************************************************************
-
-void CLCDStreamingText::SetBackgroundMode(int nMode)
-{
-    m_bRedoColors = TRUE;
-    CLCDBase::SetBackgroundMode(nMode);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetForegroundColor
-//
-//************************************************************************
-
-void CLCDStreamingText::SetForegroundColor(COLORREF crForeground)
-{
-    m_bRedoColors = TRUE;
-    CLCDBase::SetForegroundColor(crForeground);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetBackgroundColor
-//
-//************************************************************************
-
-void CLCDStreamingText::SetBackgroundColor(COLORREF crBackground)
-{
-    m_bRedoColors = TRUE;
-    CLCDBase::SetBackgroundColor(crBackground);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetGapText
-//
-//************************************************************************
-
-void CLCDStreamingText::SetGapText(LPCTSTR szGapText)
-{
-    LCDUIASSERT(NULL != szGapText);
-    if(szGapText && _tcscmp(m_sGapText.c_str(), szGapText))
-    {
-        m_sGapText.assign(szGapText);
-        m_bRecalcExtent = TRUE;
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetFont
-//
-//************************************************************************
-
-void CLCDStreamingText::SetFont(LOGFONT& lf)
-{
-    if (m_hFont)
-    {
-        DeleteObject(m_hFont);
-        m_hFont = NULL;
-    }
-
-    m_hFont = CreateFontIndirect(&lf);
-    m_bRecalcExtent = TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::GetFont
-//
-//************************************************************************
-
-HFONT CLCDStreamingText::GetFont()
-{
-    return m_hFont;
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetFontFaceName
-//
-//************************************************************************
-
-void CLCDStreamingText::SetFontFaceName(LPCTSTR szFontName)
-{
-    // if NULL, uses the default gui font
-    if (NULL == szFontName)
-        return;
-
-    LOGFONT lf;
-    ZeroMemory(&lf, sizeof(lf));
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-
-    DeleteObject(m_hFont);
-    m_hFont = NULL;
-
-    LCDUI_tcsncpy(lf.lfFaceName, szFontName, LF_FACESIZE);
-
-    m_hFont = CreateFontIndirect(&lf);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetFontPointSize
-//
-//************************************************************************
-
-void CLCDStreamingText::SetFontPointSize(int nPointSize)
-{
-    LOGFONT lf;
-    ZeroMemory(&lf, sizeof(lf));
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-
-    DeleteObject(m_hFont);
-    m_hFont = NULL;
-
-    lf.lfHeight = -MulDiv(nPointSize, DEFAULT_DPI, 72);
-
-    m_hFont = CreateFontIndirect(&lf);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetFontWeight
-//
-//************************************************************************
-
-void CLCDStreamingText::SetFontWeight(int nWeight)
-{
-    LOGFONT lf;
-    ZeroMemory(&lf, sizeof(lf));
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-
-    DeleteObject(m_hFont);
-    m_hFont = NULL;
-
-    lf.lfWeight = nWeight;
-
-    m_hFont = CreateFontIndirect(&lf);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetFontColor
-//
-//************************************************************************
-
-void CLCDStreamingText::SetFontColor(COLORREF color)
-{
-    SetForegroundColor(color);
-
-    // Apply it to any existing text objects
-    for (size_t i = 0; i < m_Objects.size(); i++)
-    {
-        m_Objects[i]->SetForegroundColor(color);
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetAlignment
-//
-// only relevant if no streaming
-//************************************************************************
-
-void CLCDStreamingText::SetAlignment(int nAlignment)
-{
-    m_nTextAlignment = nAlignment;
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::AddText
-//
-//************************************************************************
-
-int CLCDStreamingText::AddText(LPCTSTR szText)
-{
-
-    CLCDText* pText = new CLCDText;
-    pText->Initialize();
-    pText->SetText(szText);
-    pText->SetOrigin(GetOrigin().x, GetOrigin().y);
-    pText->SetLogicalOrigin(GetLogicalOrigin().x, GetLogicalOrigin().y);
-    pText->SetSize(GetWidth(), GetHeight());
-    pText->SetBackgroundMode(m_nBkMode);
-    pText->SetBackgroundColor(m_crBackgroundColor);
-    pText->SetFontColor(m_crForegroundColor);
-
-    LOGFONT lf;
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-    pText->SetFont(lf);
-
-    m_bRecalcExtent = TRUE;
-
-    AddObject(pText);
-
-
-    if (NULL == m_pQueueHead)
-    {
-        m_pQueueHead = pText;
-    }
-
-    // return the zero-based index
-    return (int)(m_Objects.size()-1);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::RemoveText
-//
-//************************************************************************
-
-void CLCDStreamingText::RemoveText(int nIndex)
-{
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-    int i = 0;
-    while(it != m_Objects.end())
-    {
-        CLCDBase *pObject = *it;
-        LCDUIASSERT(NULL != pObject);
-
-        if (i == nIndex)
-        {
-            m_Objects.erase(it);
-            if(NULL != pObject)
-            {
-                delete pObject;
-            }
-            break;
-        }
-        
-        ++it;
-        ++i;
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::RemoveAllText
-//
-//************************************************************************
-
-void CLCDStreamingText::RemoveAllText()
-{
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-    while(it != m_Objects.end())
-    {
-        // we need to delete all the text objects that were placed in to m_Objects
-        CLCDBase *pObject = *it;
-        LCDUIASSERT(NULL != pObject);
-
-        if(NULL != pObject)
-        {
-            delete pObject;
-        }
-        ++it;
-    }
-    m_Objects.erase(m_Objects.begin(), m_Objects.end());
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetStartDelay
-//
-//************************************************************************
-
-void CLCDStreamingText::SetStartDelay(DWORD dwMilliseconds)
-{
-    m_dwStartDelay = dwMilliseconds;
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::SetSpeed
-//
-//************************************************************************
-
-void CLCDStreamingText::SetSpeed(DWORD dwSpeed)
-{
-    m_dwSpeed = dwSpeed;
-}
-
-//************************************************************************
-//
-// CLCDStreamingText::SetScrollingStep: sets the number of pixels the text 
-// will jump when it scrolls
-//
-//************************************************************************
-
-void CLCDStreamingText::SetScrollingStep(DWORD dwStepInPixels)
-{
-    m_dwStepInPixels = dwStepInPixels;
-}
-
-//************************************************************************
-//
-// CLCDStreamingText::OnUpdate
-//
-//************************************************************************
-
-void CLCDStreamingText::OnUpdate(DWORD dwTimestamp)
-{
-    m_dwEllapsedTime = (dwTimestamp - m_dwLastUpdate);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::OnDraw
-//
-//************************************************************************
-
-void CLCDStreamingText::OnDraw(CLCDGfxBase &rGfx)
-{
-
-    if (m_bRecalcExtent)
-    {
-        // this just recalculates the text extents
-        RecalcTextBoxes(rGfx);
-        m_bRecalcExtent = FALSE;
-        return;
-    }
-
-    switch(m_eState)
-    {
-    case STATE_DELAY:
-        if (m_dwEllapsedTime > m_dwStartDelay)
-        {
-            m_eState = STATE_SCROLL;
-            m_dwEllapsedTime = 0;
-            m_dwLastUpdate = GetTickCount();
-        }
-        break;
-    case STATE_SCROLL:
-        {
-            // update the positions
-            float fDistance = (float)(m_dwSpeed * m_dwEllapsedTime) / 1000.0f;
-            m_dwLastUpdate = GetTickCount();
-
-            if (m_Objects.size() > 1)
-            {
-                // extract any previous fractional remainder
-                // and add it to the current distance
-                float fTotDistance = (fDistance + m_fFractDistance);
-                m_fFractDistance = (fTotDistance >= (float)m_dwStepInPixels) ? (float)(fTotDistance - (int)fTotDistance) : fTotDistance;
-
-                if (fTotDistance < 0.0f)
-                    fTotDistance = 0.0f;
-                if (m_fFractDistance < 0.0f)
-                    m_fFractDistance = 0.0f;
-
-				if (fTotDistance >= (float)m_dwStepInPixels)
-                    ApplyOrigins(-1 * (int)fTotDistance); // left
-            }
-        }
-        break;
-    default:
-        break;
-    }
-
-    if( m_bRedoColors )
-    {
-        LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-        while(it != m_Objects.end())
-        {
-            // we need to delete all the text objects that were placed in to m_Objects
-            CLCDBase *pObject = *it;
-            LCDUIASSERT(NULL != pObject);
-
-            if(NULL != pObject)
-            {
-                pObject->SetBackgroundMode(m_nBkMode);
-                pObject->SetBackgroundColor(m_crBackgroundColor);
-                pObject->SetForegroundColor(m_crForegroundColor);
-            }
-            ++it;
-        }
-
-        m_bRedoColors = FALSE;
-    }
-
-    CLCDCollection::OnDraw(rGfx);
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::C
-//
-//************************************************************************
-
-BOOL CLCDStreamingText::RecalcTextBoxes(CLCDGfxBase &rGfx)
-{
-
-    // check if we need to add another text box
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-
-    if (it == m_Objects.end())
-        return FALSE;
-
-    CLCDBase* pObject = *it;
-    CLCDText* pText = (CLCDText*)pObject;
-    LCDUIASSERT(NULL != pObject);
-    
-    LOGFONT lf;
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-    pText->SetFont(lf);
-
-    // this will re-evaluate the main text object
-    LCDUIASSERT(m_Objects.size() == 1);
-    pText->CalculateExtent(TRUE);
-
-    if (it != m_Objects.end())
-    {
-        if (pText->GetHExtent().cx > GetWidth())
-        {
-
-            pText->SetAlignment(DT_LEFT);
-
-            // add a gap
-            AddText(m_sGapText.c_str());
-            // add another text
-            AddText(m_sText.c_str());
-            // add last gap
-            AddText(m_sGapText.c_str());
-        }
-        else
-        {
-            pText->SetAlignment(m_nTextAlignment);
-        }
-    }
-
-    // this will re-evaluate the other text objects
-    CLCDCollection::OnDraw(rGfx);
-    RecalcTextBoxOrigins();
-
-    return TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::RecalcTextBoxOrigins
-//
-// Puts all the text boxes in order next to each other
-//************************************************************************
-
-void CLCDStreamingText::RecalcTextBoxOrigins()
-{
-
-    if (m_Objects.size() <= 1)
-        return;
-
-    // draw everyone to the left by the offset
-    int nOrgOffset = 0;
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-    while(it != m_Objects.end())
-    {
-        CLCDBase* pObject = *it;
-        CLCDText* pText = (CLCDText*)pObject;
-        LCDUIASSERT(NULL != pObject);
-
-        pText->SetLogicalSize(pText->GetHExtent().cx, pText->GetHExtent().cy);
-
-        // string can be empty which generates zero logical space
-        //LCDUIASSERT(pText->GetLogicalSize().cx);
-        //LCDUIASSERT(pText->GetLogicalSize().cy);
-
-        POINT& ptOrigin = pText->GetLogicalOrigin();
-
-		if (nOrgOffset == 0)
-		{
-			nOrgOffset = pText->GetLogicalOrigin().x;
-		}
-
-        pText->SetLogicalOrigin(nOrgOffset, ptOrigin.y);
-        nOrgOffset += pText->GetHExtent().cx;
-
-        ++it;
-    }
-
-}
-
-
-//************************************************************************
-//
-// CLCDStreamingText::ApplyOrigins
-//
-//************************************************************************
-
-void CLCDStreamingText::ApplyOrigins(int nOffset)
-{
-    
-    // draw everyone to the left by the offset
-    LCD_OBJECT_LIST::iterator it = m_Objects.begin();
-    while(it != m_Objects.end())
-    {
-        CLCDBase* pObject = *it;
-        CLCDText* pText = (CLCDText*)pObject;
-        LCDUIASSERT(NULL != pObject);
-
-        POINT& ptOrigin = pText->GetLogicalOrigin();
-
-        pText->SetLogicalOrigin(ptOrigin.x + nOffset, ptOrigin.y);
-
-        ++it;
-    }
-
-    // If the active box is no longer visible, 
-    // pop it off the push it to the end of the list
-    if (abs(m_pQueueHead->GetLogicalOrigin().x) >= m_pQueueHead->GetHExtent().cx)
-    {
-        RemoveObject(0);
-        AddObject(m_pQueueHead);
-        RecalcTextBoxOrigins();
-        m_pQueueHead = (CLCDText*)RetrieveObject(0);
-    }
-
-}
-
-
-//** end of LCDStreamingText.cpp *******************************************
+//************************************************************************
+//
+// LCDStreamingText.cpp
+//
+// The CLCDStreamingText class draws streaming text onto the LCD.
+// Streaming text is a single line of text that is repeatedly streamed
+// horizontally across the LCD.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+//************************************************************************
+//
+// CLCDStreamingText::CLCDStreamingText
+//
+//************************************************************************
+
+CLCDStreamingText::CLCDStreamingText()
+{
+    m_sText.erase(m_sText.begin(), m_sText.end());
+    m_sGapText.erase(m_sGapText.begin(), m_sGapText.end());
+
+    m_sGapText.assign(_T("   "));
+    m_hFont = NULL;
+    m_nTextAlignment = DT_LEFT;
+    m_bStreaming = FALSE;
+    m_nOffset = 0;
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::~CLCDStreamingText
+//
+//************************************************************************
+
+CLCDStreamingText::~CLCDStreamingText()
+{
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    m_hFont = NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDStreamingText::Initialize(void)
+{
+    m_eState = STATE_DELAY;
+    m_dwStartDelay  = 2000;
+    m_dwSpeed       = 7;
+	m_dwStepInPixels = 7;
+    m_dwLastUpdate = 0;
+    m_dwEllapsedTime = 0;
+    m_dwLastUpdate = CLCDClock::Now();
+    m_bRecalcExtent = FALSE;
+    m_bStreaming = FALSE;
+    m_nOffset = 0;
+    m_fFractDistance = 0.0f;
+
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    m_hFont = (HFONT) GetStockObject(DEFAULT_GUI_FONT);
+    if(NULL != m_hFont)
+    {
+        SetFontPointSize(DEFAULT_POINTSIZE);
+    }
+
+    //return CLCDBase::Initialize();
+    return ERROR_SUCCESS;
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::ResetUpdate
+//
+//************************************************************************
+
+void CLCDStreamingText::ResetUpdate(void)
+{
+    m_eState = STATE_DELAY;
+    m_dwEllapsedTime = 0;
+    m_dwLastUpdate = CLCDClock::Now();
+    m_nOffset = 0;
+    m_fFractDistance = 0.0f;
+    
+    // recalculate the text
+    m_bRecalcExtent = TRUE;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetText
+//
+//************************************************************************
+
+void CLCDStreamingText::SetText(LPCTSTR szText)
+{
+    LCDUIASSERT(NULL != szText);
+    if(szText)
+    {
+        SetText(szText, (int)_tcslen(szText));
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetText
+//
+// A text of another length differs without being read
+//************************************************************************
+
+void CLCDStreamingText::SetText(LPCTSTR szText, int nLength)
+{
+    LCDUIASSERT(NULL != szText);
+    LCDUIASSERT(0 <= nLength);
+    if(!szText || (0 > nLength))
+    {
+        return;
+    }
+
+    if(((size_t)nLength != m_sText.size()) || memcmp(m_sText.data(), szText, nLength * sizeof(TCHAR)))
+    {
+        m_sText.assign(szText, nLength);
+        m_bRecalcExtent = TRUE;
+        ResetUpdate();
+    }
+}
+
+
+#ifdef LCDUI_RVALUE_REFS
+//************************************************************************
+//
+// CLCDStreamingText::SetText
+//
+//************************************************************************
+
+void CLCDStreamingText::SetText(std::basic_string<TCHAR> &&sText)
+{
+    if((sText.size() != m_sText.size()) || memcmp(m_sText.data(), sText.data(), sText.size() * sizeof(TCHAR)))
+    {
+        m_sText.swap(sText);
+        m_bRecalcExtent = TRUE;
+        ResetUpdate();
+    }
+}
+#endif
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetSize
+//
+//************************************************************************
+
+void CLCDStreamingText::SetSize(SIZE& size)
+{
+    // whether the text fits depends on the width
+    if (size.cx != m_Size.cx)
+    {
+        m_bRecalcExtent = TRUE;
+    }
+    CLCDBase::SetSize(size);
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetSize
+//
+//************************************************************************
+
+void CLCDStreamingText::SetSize(int nCX, int nCY)
+{
+    SIZE size = { nCX, nCY };
+    SetSize(size);  
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetGapText
+//
+//************************************************************************
+
+void CLCDStreamingText::SetGapText(LPCTSTR szGapText)
+{
+    LCDUIASSERT(NULL != szGapText);
+    if(szGapText && _tcscmp(m_sGapText.c_str(), szGapText))
+    {
+        m_sGapText.assign(szGapText);
+        m_bRecalcExtent = TRUE;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetFont
+//
+//************************************************************************
+
+void CLCDStreamingText::SetFont(LOGFONT& lf)
+{
+    HFONT hFont = CLCDFontRegistry::GetInstance().Acquire(lf);
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    if (hFont == m_hFont)
+    {
+        return;
+    }
+
+    m_hFont = hFont;
+    m_bRecalcExtent = TRUE;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::GetFont
+//
+//************************************************************************
+
+HFONT CLCDStreamingText::GetFont()
+{
+    return m_hFont;
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetFontFaceName
+//
+//************************************************************************
+
+void CLCDStreamingText::SetFontFaceName(LPCTSTR szFontName)
+{
+    // if NULL, uses the default gui font
+    if (NULL == szFontName)
+        return;
+
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    LCDUI_tcsncpy(lf.lfFaceName, szFontName, LF_FACESIZE);
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetFontPointSize
+//
+//************************************************************************
+
+void CLCDStreamingText::SetFontPointSize(int nPointSize)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    lf.lfHeight = -MulDiv(nPointSize, DEFAULT_DPI, 72);
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetFontWeight
+//
+//************************************************************************
+
+void CLCDStreamingText::SetFontWeight(int nWeight)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    lf.lfWeight = nWeight;
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetFontColor
+//
+//************************************************************************
+
+void CLCDStreamingText::SetFontColor(COLORREF color)
+{
+    SetForegroundColor(color);
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetAlignment
+//
+// only relevant if no streaming
+//************************************************************************
+
+void CLCDStreamingText::SetAlignment(int nAlignment)
+{
+    if (m_nTextAlignment != nAlignment)
+    {
+        m_nTextAlignment = nAlignment;
+        m_bRecalcExtent = TRUE;
+        Invalidate();
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetStartDelay
+//
+//************************************************************************
+
+void CLCDStreamingText::SetStartDelay(DWORD dwMilliseconds)
+{
+    m_dwStartDelay = dwMilliseconds;
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::SetSpeed
+//
+//************************************************************************
+
+void CLCDStreamingText::SetSpeed(DWORD dwSpeed)
+{
+    m_dwSpeed = dwSpeed;
+}
+
+//************************************************************************
+//
+// CLCDStreamingText::SetScrollingStep: sets the number of pixels the text 
+// will jump when it scrolls
+//
+//************************************************************************
+
+void CLCDStreamingText::SetScrollingStep(DWORD dwStepInPixels)
+{
+    m_dwStepInPixels = dwStepInPixels;
+}
+
+//************************************************************************
+//
+// CLCDStreamingText::OnUpdate
+//
+//************************************************************************
+
+void CLCDStreamingText::OnUpdate(DWORD dwTimestamp)
+{
+    m_dwEllapsedTime = (dwTimestamp - m_dwLastUpdate);
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::IsDirty
+//
+// The text is only measured and moved while drawing, so keep drawing
+// while that is pending or the text streams.
+//
+//************************************************************************
+
+BOOL CLCDStreamingText::IsDirty(void)
+{
+    if (m_bRecalcExtent || m_bStreaming)
+    {
+        return TRUE;
+    }
+    return CLCDBase::IsDirty();
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::OnDraw
+//
+//************************************************************************
+
+void CLCDStreamingText::OnDraw(CLCDGfxBase &rGfx)
+{
+
+    if (m_bRecalcExtent)
+    {
+        RecalcExtent();
+    }
+
+    switch(m_eState)
+    {
+    case STATE_DELAY:
+        if (m_dwEllapsedTime > m_dwStartDelay)
+        {
+            m_eState = STATE_SCROLL;
+            m_dwEllapsedTime = 0;
+            m_dwLastUpdate = CLCDClock::Now();
+        }
+        break;
+    case STATE_SCROLL:
+        {
+            // update the positions
+            float fDistance = (float)(m_dwSpeed * m_dwEllapsedTime) / 1000.0f;
+            m_dwLastUpdate = CLCDClock::Now();
+
+            if (m_bStreaming)
+            {
+                // extract any previous fractional remainder
+                // and add it to the current distance
+                float fTotDistance = (fDistance + m_fFractDistance);
+                m_fFractDistance = (fTotDistance >= (float)m_dwStepInPixels) ? (float)(fTotDistance - (int)fTotDistance) : fTotDistance;
+
+                if (fTotDistance < 0.0f)
+                    fTotDistance = 0.0f;
+                if (m_fFractDistance < 0.0f)
+                    m_fFractDistance = 0.0f;
+
+				if (fTotDistance >= (float)m_dwStepInPixels)
+                {
+                    // the text repeats after the gap, start over there
+                    int nPeriod = max(1, m_Marquee.GetPeriod());
+                    m_nOffset = (m_nOffset + (int)fTotDistance) % nPeriod;
+                }
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (GetBackgroundMode() == OPAQUE)
+    {
+        RECT rcBack = { 0, 0, GetWidth(), GetHeight() };
+        if (NULL != rGfx.GetSoftSurface())
+        {
+            rGfx.GetSoftSurface()->FillRect(rcBack, m_crBackgroundColor);
+        }
+        else
+        {
+            HBRUSH hBackBrush = CreateSolidBrush(m_crBackgroundColor);
+            FillRect(rGfx.GetHDC(), &rcBack, hBackBrush);
+            DeleteObject(hBackBrush);
+        }
+    }
+
+    if (m_sText.empty() || !IsVisible())
+    {
+        return;
+    }
+
+    if (NULL != rGfx.GetSoftSurface())
+    {
+        DrawSoftCopies(*rGfx.GetSoftSurface());
+        return;
+    }
+
+    RECT rBoundary = { 0, 0, GetWidth(), GetHeight() };
+    if (!m_Marquee.Draw(rGfx, rBoundary, m_nOffset, m_crForegroundColor))
+    {
+        DrawCopies(rGfx);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::IsTileSafe
+//
+// The streaming advances while drawing
+//
+//************************************************************************
+
+BOOL CLCDStreamingText::IsTileSafe(void)
+{
+    return FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::RecalcExtent
+//
+// Decides whether the text streams. Text that fits is aligned instead.
+//************************************************************************
+
+void CLCDStreamingText::RecalcExtent(void)
+{
+    m_Marquee.SetFont(m_hFont);
+    m_Marquee.SetText(m_sText.c_str(), (int)m_sText.size());
+    m_Marquee.SetGap(m_sGapText.c_str(), 0);
+
+    m_bStreaming = (m_Marquee.GetTextExtent().cx > GetWidth());
+    m_Marquee.SetFormat(DT_NOPREFIX | (m_bStreaming ? DT_LEFT : m_nTextAlignment));
+    m_Marquee.EnableRepeat(m_bStreaming);
+
+    m_nOffset = 0;
+    m_bRecalcExtent = FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::DrawCopies
+//
+// Draws the text and the gap with DrawTextEx(), for surfaces the
+// marquee cannot draw on
+//************************************************************************
+
+void CLCDStreamingText::DrawCopies(CLCDGfxBase &rGfx)
+{
+    HDC hDC = rGfx.GetHDC();
+    int nOldMapMode = SetMapMode(hDC, MM_TEXT);
+    int nOldBkMode = SetBkMode(hDC, TRANSPARENT);
+    HFONT hOldFont = (HFONT)SelectObject(hDC, m_hFont);
+    COLORREF crOldTextColor = SetTextColor(hDC, m_crForegroundColor);
+
+    DRAWTEXTPARAMS dtp;
+    ZeroMemory(&dtp, sizeof(dtp));
+    dtp.cbSize = sizeof(dtp);
+
+    if (!m_bStreaming)
+    {
+        RECT rText = { 0, 0, GetWidth(), GetHeight() };
+        DrawTextEx(hDC, (LPTSTR)m_sText.c_str(), (int)m_sText.size(), &rText, DT_NOPREFIX | m_nTextAlignment, &dtp);
+    }
+    else
+    {
+        int nTextWidth = m_Marquee.GetTextExtent().cx;
+        int nPeriod = max(1, m_Marquee.GetPeriod());
+        for (int x = -m_nOffset; x < GetWidth(); x += nPeriod)
+        {
+            RECT rText = { x, 0, x + nTextWidth, GetHeight() };
+            DrawTextEx(hDC, (LPTSTR)m_sText.c_str(), (int)m_sText.size(), &rText, DT_NOPREFIX | DT_LEFT, &dtp);
+
+            RECT rGap = { x + nTextWidth, 0, x + nPeriod, GetHeight() };
+            DrawTextEx(hDC, (LPTSTR)m_sGapText.c_str(), (int)m_sGapText.size(), &rGap,
+                DT_NOPREFIX | DT_LEFT | DT_SINGLELINE, &dtp);
+        }
+    }
+
+    SetMapMode(hDC, nOldMapMode);
+    SetBkMode(hDC, nOldBkMode);
+    SelectObject(hDC, hOldFont);
+    SetTextColor(hDC, crOldTextColor);
+}
+
+
+//************************************************************************
+//
+// CLCDStreamingText::DrawSoftCopies
+//
+// Soft surfaces measure and draw with their own font, see CLCDText
+//************************************************************************
+
+void CLCDStreamingText::DrawSoftCopies(CLCDGfxSoft &rSoft)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+    int nScale = CLCDGfxSoft::GetScaleForFontHeight(lf.lfHeight);
+
+    int nTextLength = (int)m_sText.size();
+    int nGapLength = (int)m_sGapText.size();
+    int nTextWidth = CLCDGfxSoft::GetTextExtent(m_sText.c_str(), nTextLength, nScale).cx;
+
+    if (nTextWidth <= GetWidth())
+    {
+        int nX = 0;
+        if (m_nTextAlignment & DT_CENTER)
+        {
+            nX = (GetWidth() - nTextWidth) / 2;
+        }
+        else if (m_nTextAlignment & DT_RIGHT)
+        {
+            nX = GetWidth() - nTextWidth;
+        }
+        rSoft.DrawText(nX, 0, m_sText.c_str(), nTextLength, m_crForegroundColor, nScale);
+        return;
+    }
+
+    int nPeriod = nTextWidth + CLCDGfxSoft::GetTextExtent(m_sGapText.c_str(), nGapLength, nScale).cx;
+    for (int x = -(m_nOffset % nPeriod); x < GetWidth(); x += nPeriod)
+    {
+        rSoft.DrawText(x, 0, m_sText.c_str(), nTextLength, m_crForegroundColor, nScale);
+        rSoft.DrawText(x + nTextWidth, 0, m_sGapText.c_str(), nGapLength, m_crForegroundColor, nScale);
+    }
+}
+
+
+//** end of LCDStreamingText.cpp *******************************************
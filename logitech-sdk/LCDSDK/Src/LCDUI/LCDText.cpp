@@ -1,459 +1,744 @@
-//************************************************************************
-//
-// LCDText.cpp
-//
-// The CLCDText class draws simple text onto the LCD.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#include "LCDUI.h"
-
-
-//************************************************************************
-//
-// CLCDText::CLCDText
-//
-//************************************************************************
-
-CLCDText::CLCDText(void)
-:   m_hFont(NULL),
-    m_nTextLength(0),
-    m_nTextFormat(DT_LEFT | DT_NOPREFIX),
-    m_bRecalcExtent(TRUE),
-    m_nTextAlignment(DT_LEFT)
-{
-    ZeroMemory(&m_dtp, sizeof(DRAWTEXTPARAMS));
-    m_dtp.cbSize = sizeof(DRAWTEXTPARAMS);
-    ZeroMemory(&m_sizeVExtent, sizeof(m_sizeVExtent));
-    ZeroMemory(&m_sizeHExtent, sizeof(m_sizeHExtent));
-    SetBackgroundMode(TRANSPARENT);
-    Initialize();
-}
-
-
-//************************************************************************
-//
-// CLCDText::~CLCDText
-//
-//************************************************************************
-
-CLCDText::~CLCDText(void)
-{
-    if (m_hFont)
-    {
-        DeleteObject(m_hFont);
-        m_hFont = NULL;
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDText::Initialize
-//
-//************************************************************************
-
-HRESULT CLCDText::Initialize()
-{
-    m_hFont = (HFONT) GetStockObject(DEFAULT_GUI_FONT);
-    if(NULL != m_hFont)
-    {
-        SetFontPointSize(DEFAULT_POINTSIZE);
-    }
-    SetForegroundColor(RGB(255, 255, 255));
-    return (NULL != m_hFont) ? S_OK : E_OUTOFMEMORY;
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetFont
-//
-//************************************************************************
-
-void CLCDText::SetFont(LOGFONT& lf)
-{
-    if (m_hFont)
-    {
-        DeleteObject(m_hFont);
-        m_hFont = NULL;
-    }
-
-    m_hFont = CreateFontIndirect(&lf);
-    m_bRecalcExtent = TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDText::GetFont
-//
-//************************************************************************
-
-HFONT CLCDText::GetFont()
-{
-    return m_hFont;
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetFontFaceName
-//
-//************************************************************************
-
-void CLCDText::SetFontFaceName(LPCTSTR szFontName)
-{
-    // if NULL, uses the default gui font
-    if (NULL == szFontName)
-    {
-        return;
-    }
-
-    LOGFONT lf;
-    ZeroMemory(&lf, sizeof(lf));
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-
-    LCDUI_tcsncpy(lf.lfFaceName, szFontName, LF_FACESIZE);
-
-    SetFont(lf);
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetFontPointSize
-//
-//************************************************************************
-
-void CLCDText::SetFontPointSize(int nPointSize)
-{
-    LOGFONT lf;
-    ZeroMemory(&lf, sizeof(lf));
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-
-    lf.lfHeight = -MulDiv(nPointSize, DEFAULT_DPI, 72);
-
-    SetFont(lf);
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetFontWeight
-//
-//************************************************************************
-
-void CLCDText::SetFontWeight(int nWeight)
-{
-    LOGFONT lf;
-    ZeroMemory(&lf, sizeof(lf));
-    GetObject(m_hFont, sizeof(LOGFONT), &lf);
-
-    lf.lfWeight = nWeight;
-
-    SetFont(lf);
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetFontColor
-//
-//************************************************************************
-
-void CLCDText::SetFontColor(COLORREF color)
-{
-    SetForegroundColor(color);
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetText
-//
-//************************************************************************
-
-void CLCDText::SetText(LPCTSTR szText)
-{
-    LCDUIASSERT(NULL != szText);
-    if(szText && _tcscmp(m_sText.c_str(), szText))
-    {
-        m_sText.assign(szText);
-        m_nTextLength = m_sText.size();
-        m_dtp.iLeftMargin = 0;
-        m_dtp.iRightMargin = 0;
-        m_bRecalcExtent = TRUE;
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDText::GetText
-//
-//************************************************************************
-
-LPCTSTR CLCDText::GetText()
-{
-    return m_sText.c_str();
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetWordWrap
-//
-//************************************************************************
-
-void CLCDText::SetWordWrap(BOOL bEnable)
-{
-    if (bEnable)
-    {
-        m_nTextFormat |= DT_WORDBREAK;
-    }
-    else
-    {
-        m_nTextFormat &= ~DT_WORDBREAK;
-    }
-    m_bRecalcExtent = TRUE;
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetLeftMargin
-//
-//************************************************************************
-
-void CLCDText::SetLeftMargin(int nLeftMargin)
-{
-    m_dtp.iLeftMargin = nLeftMargin;
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetRightMargin
-//
-//************************************************************************
-
-void CLCDText::SetRightMargin(int nRightMargin)
-{
-    m_dtp.iRightMargin = nRightMargin;
-}
-
-
-//************************************************************************
-//
-// CLCDText::GetLeftMargin
-//
-//************************************************************************
-
-int CLCDText::GetLeftMargin(void)
-{
-    return m_dtp.iLeftMargin;
-}
-
-
-//************************************************************************
-//
-// CLCDText::GetRightMargin
-//
-//************************************************************************
-
-int CLCDText::GetRightMargin(void)
-{
-    return m_dtp.iRightMargin;
-}
-
-
-//************************************************************************
-//
-// CLCDText::GetVExtent
-//
-//************************************************************************
-
-SIZE& CLCDText::GetVExtent()
-{
-    return m_sizeVExtent;
-}
-
-
-//************************************************************************
-//
-// CLCDText::GetHExtent
-//
-//************************************************************************
-
-SIZE& CLCDText::GetHExtent()
-{
-    return m_sizeHExtent;
-}
-
-
-//************************************************************************
-//
-// CLCDText::CalculateExtent
-//
-//************************************************************************
-
-void CLCDText::CalculateExtent(BOOL bSingleLine)
-{
-    HDC hdc = CreateCompatibleDC(NULL);
-
-    int nOldMapMode = SetMapMode(hdc, MM_TEXT);
-    int nOldBkMode = SetBkMode(hdc, GetBackgroundMode());
-    // select current font
-    HFONT hOldFont = (HFONT)SelectObject(hdc, m_hFont);
-
-    int nTextFormat;
-    RECT rExtent;
-
-    if(bSingleLine)
-    {
-        // calculate horizontal extent w/ single line, we can get the line height
-        nTextFormat = (m_nTextFormat | DT_SINGLELINE | DT_CALCRECT);
-        rExtent.left = rExtent.top = 0;
-        rExtent.right = m_Size.cx;
-        rExtent.bottom = m_Size.cy;
-        DrawTextEx(hdc, (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rExtent, nTextFormat, &m_dtp);
-        m_sizeHExtent.cx = rExtent.right;
-        m_sizeHExtent.cy = rExtent.bottom;
-    }
-    else
-    {
-        // calculate vertical extent with word wrap
-        nTextFormat = (m_nTextFormat | DT_WORDBREAK | DT_CALCRECT);
-        rExtent.left = rExtent.top = 0;
-        rExtent.right = m_Size.cx;
-        rExtent.bottom = m_Size.cy;
-        DrawTextEx(hdc, (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rExtent, nTextFormat, &m_dtp);
-        m_sizeVExtent.cx = rExtent.right;
-        m_sizeVExtent.cy = rExtent.bottom;
-    }
-
-    // restores
-    SetMapMode(hdc, nOldMapMode);
-    SetBkMode(hdc, nOldBkMode);
-    SelectObject(hdc, hOldFont);
-
-    DeleteDC(hdc);
-}
-
-
-//************************************************************************
-//
-// CLCDText::SetAlignment
-//
-//************************************************************************
-
-void CLCDText::SetAlignment(int nAlignment)
-{
-    m_nTextFormat &= ~m_nTextAlignment;
-    m_nTextFormat |= nAlignment;
-    m_nTextAlignment = nAlignment;
-}
-
-
-//************************************************************************
-//
-// CLCDText::DrawText
-//
-//************************************************************************
-
-void CLCDText::DrawText(CLCDGfxBase &rGfx)
-{
-    // draw the text
-    RECT rBoundary = { 0, 0,0 + GetLogicalSize().cx, 0 + GetLogicalSize().cy }; 
-    DrawTextEx(rGfx.GetHDC(), (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rBoundary, m_nTextFormat, &m_dtp);
-
-    if (m_bInverted)
-    {
-        InvertRect(rGfx.GetHDC(), &rBoundary);
-    }
-}
-
-
-//************************************************************************
-//
-// CLCDText::OnDraw
-//
-//************************************************************************
-
-void CLCDText::OnDraw(CLCDGfxBase &rGfx)
-{
-    if (GetBackgroundMode() == OPAQUE)
-    {
-        HBRUSH hBackBrush = CreateSolidBrush(m_crBackgroundColor);
-
-        // clear the clipped area
-        RECT rcClp = { 0, 0, m_Size.cx, m_Size.cy };
-        FillRect(rGfx.GetHDC(), &rcClp, (HBRUSH) GetStockObject(BLACK_BRUSH));
-    
-        // clear the logical area
-        RECT rcLog = { 0, 0, m_sizeLogical.cx, m_sizeLogical.cy };
-        FillRect(rGfx.GetHDC(), &rcLog, hBackBrush);
-
-        DeleteObject(hBackBrush);
-    }
-    
-    if (m_nTextLength)
-    {
-
-        // map mode text, with transparency
-        int nOldMapMode = SetMapMode(rGfx.GetHDC(), MM_TEXT);
-        int nOldBkMode = SetBkMode(rGfx.GetHDC(), GetBackgroundMode()); 
-        COLORREF nOldBkColor = SetBkColor(rGfx.GetHDC(), m_crBackgroundColor);
-
-        // select current font
-        HFONT hOldFont = (HFONT)SelectObject(rGfx.GetHDC(), m_hFont);   
-
-        // select color
-        COLORREF crOldTextColor = SetTextColor(rGfx.GetHDC(), m_crForegroundColor);
-        
-        if (m_bRecalcExtent)
-        {
-            int nTextFormat;
-
-            RECT rExtent;
-            // calculate vertical extent with word wrap
-            nTextFormat = (m_nTextFormat | DT_WORDBREAK | DT_CALCRECT);
-            rExtent.left = rExtent.top = 0;
-            rExtent.right = GetWidth();
-            rExtent.bottom = GetHeight();
-            DrawTextEx(rGfx.GetHDC(), (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rExtent, nTextFormat, &m_dtp);
-            m_sizeVExtent.cx = rExtent.right;
-            m_sizeVExtent.cy = rExtent.bottom;
-
-            // calculate horizontal extent w/o word wrap
-            nTextFormat = (m_nTextFormat | DT_CALCRECT);
-            rExtent.left = rExtent.top = 0;
-            rExtent.right = GetWidth();
-            rExtent.bottom = GetHeight();
-            DrawTextEx(rGfx.GetHDC(), (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rExtent, nTextFormat, &m_dtp);
-            m_sizeHExtent.cx = rExtent.right;
-            m_sizeHExtent.cy = rExtent.bottom;
-
-            m_bRecalcExtent = FALSE;
-        }
-
-        if (IsVisible())
-        {
-            DrawText(rGfx);
-        }
-
-        // restores
-        SetMapMode(rGfx.GetHDC(), nOldMapMode);
-        SetTextColor(rGfx.GetHDC(), crOldTextColor);
-        SetBkMode(rGfx.GetHDC(), nOldBkMode);
-        SetBkColor(rGfx.GetHDC(), nOldBkColor);
-        SelectObject(rGfx.GetHDC(), hOldFont);
-    }
-}
-
-//** end of LCDText.cpp **************************************************
-
+//************************************************************************
+//
+// LCDText.cpp
+//
+// The CLCDText class draws simple text onto the LCD.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDText::CLCDText
+//
+//************************************************************************
+
+CLCDText::CLCDText(void)
+:   m_hFont(NULL),
+    m_pBitmapFont(NULL),
+    m_nTextLength(0),
+    m_nTextFormat(DT_LEFT | DT_NOPREFIX),
+    m_bRecalcExtent(TRUE),
+    m_nTextAlignment(DT_LEFT)
+{
+    ZeroMemory(&m_dtp, sizeof(DRAWTEXTPARAMS));
+    m_dtp.cbSize = sizeof(DRAWTEXTPARAMS);
+    ZeroMemory(&m_sizeVExtent, sizeof(m_sizeVExtent));
+    ZeroMemory(&m_sizeHExtent, sizeof(m_sizeHExtent));
+    SetBackgroundMode(TRANSPARENT);
+    Initialize();
+}
+
+
+//************************************************************************
+//
+// CLCDText::~CLCDText
+//
+//************************************************************************
+
+CLCDText::~CLCDText(void)
+{
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    m_hFont = NULL;
+}
+
+
+//************************************************************************
+//
+// CLCDText::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDText::Initialize()
+{
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    m_hFont = (HFONT) GetStockObject(DEFAULT_GUI_FONT);
+    if(NULL != m_hFont)
+    {
+        SetFontPointSize(DEFAULT_POINTSIZE);
+    }
+    SetForegroundColor(RGB(255, 255, 255));
+    return (NULL != m_hFont) ? S_OK : E_OUTOFMEMORY;
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetFont
+//
+//************************************************************************
+
+void CLCDText::SetFont(LOGFONT& lf)
+{
+    // fonts are shared, an identical one is found instead of created
+    HFONT hFont = CLCDFontRegistry::GetInstance().Acquire(lf);
+    CLCDFontRegistry::GetInstance().Release(m_hFont);
+    if (hFont == m_hFont)
+    {
+        return;
+    }
+
+    m_hFont = hFont;
+    m_bRecalcExtent = TRUE;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetFont
+//
+//************************************************************************
+
+HFONT CLCDText::GetFont()
+{
+    return m_hFont;
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetFontFaceName
+//
+//************************************************************************
+
+void CLCDText::SetFontFaceName(LPCTSTR szFontName)
+{
+    // if NULL, uses the default gui font
+    if (NULL == szFontName)
+    {
+        return;
+    }
+
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    LCDUI_tcsncpy(lf.lfFaceName, szFontName, LF_FACESIZE);
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetFontPointSize
+//
+//************************************************************************
+
+void CLCDText::SetFontPointSize(int nPointSize)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    lf.lfHeight = -MulDiv(nPointSize, DEFAULT_DPI, 72);
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetFontWeight
+//
+//************************************************************************
+
+void CLCDText::SetFontWeight(int nWeight)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    lf.lfWeight = nWeight;
+
+    SetFont(lf);
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetFontColor
+//
+//************************************************************************
+
+void CLCDText::SetFontColor(COLORREF color)
+{
+    SetForegroundColor(color);
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetBitmapFont
+//
+//************************************************************************
+
+void CLCDText::SetBitmapFont(CLCDBitmapFont *pFont)
+{
+    if (pFont == m_pBitmapFont)
+    {
+        return;
+    }
+
+    m_pBitmapFont = pFont;
+    m_bRecalcExtent = TRUE;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetBitmapFont
+//
+//************************************************************************
+
+CLCDBitmapFont *CLCDText::GetBitmapFont(void)
+{
+    return m_pBitmapFont;
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetText
+//
+//************************************************************************
+
+void CLCDText::SetText(LPCTSTR szText)
+{
+    LCDUIASSERT(NULL != szText);
+    if(szText)
+    {
+        SetText(szText, static_cast<int>(_tcslen(szText)));
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetText
+//
+//************************************************************************
+
+void CLCDText::SetText(LPCTSTR szText, int nLength)
+{
+    LCDUIASSERT(NULL != szText);
+    LCDUIASSERT(0 <= nLength);
+    if(szText && (0 <= nLength) && !IsSameText(szText, nLength))
+    {
+        m_sText.assign(szText, nLength);
+        OnTextChanged();
+    }
+}
+
+
+#ifdef LCDUI_RVALUE_REFS
+//************************************************************************
+//
+// CLCDText::SetText
+//
+//************************************************************************
+
+void CLCDText::SetText(lcdstring &&sText)
+{
+    if(!IsSameText(sText.data(), static_cast<int>(sText.size())))
+    {
+        m_sText.swap(sText);
+        OnTextChanged();
+    }
+}
+#endif
+
+
+//************************************************************************
+//
+// CLCDText::IsSameText
+//
+// A text of another length differs without being read
+//************************************************************************
+
+BOOL CLCDText::IsSameText(LPCTSTR szText, int nLength)
+{
+    return (static_cast<lcdstring::size_type>(nLength) == m_sText.size()) &&
+        (0 == memcmp(m_sText.data(), szText, nLength * sizeof(TCHAR)));
+}
+
+
+//************************************************************************
+//
+// CLCDText::OnTextChanged
+//
+//************************************************************************
+
+void CLCDText::OnTextChanged(void)
+{
+    m_nTextLength = m_sText.size();
+    m_dtp.iLeftMargin = 0;
+    m_dtp.iRightMargin = 0;
+    m_bRecalcExtent = TRUE;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetText
+//
+//************************************************************************
+
+LPCTSTR CLCDText::GetText()
+{
+    return m_sText.c_str();
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetWordWrap
+//
+//************************************************************************
+
+void CLCDText::SetWordWrap(BOOL bEnable)
+{
+    if (bEnable)
+    {
+        m_nTextFormat |= DT_WORDBREAK;
+    }
+    else
+    {
+        m_nTextFormat &= ~DT_WORDBREAK;
+    }
+    m_bRecalcExtent = TRUE;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetLeftMargin
+//
+//************************************************************************
+
+void CLCDText::SetLeftMargin(int nLeftMargin)
+{
+    m_dtp.iLeftMargin = nLeftMargin;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetRightMargin
+//
+//************************************************************************
+
+void CLCDText::SetRightMargin(int nRightMargin)
+{
+    m_dtp.iRightMargin = nRightMargin;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetLeftMargin
+//
+//************************************************************************
+
+int CLCDText::GetLeftMargin(void)
+{
+    return m_dtp.iLeftMargin;
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetRightMargin
+//
+//************************************************************************
+
+int CLCDText::GetRightMargin(void)
+{
+    return m_dtp.iRightMargin;
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetVExtent
+//
+//************************************************************************
+
+SIZE& CLCDText::GetVExtent()
+{
+    return m_sizeVExtent;
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetHExtent
+//
+//************************************************************************
+
+SIZE& CLCDText::GetHExtent()
+{
+    return m_sizeHExtent;
+}
+
+
+//************************************************************************
+//
+// CLCDText::CalculateExtent
+//
+//************************************************************************
+
+void CLCDText::CalculateExtent(BOOL bSingleLine)
+{
+    CLCDTextLayout &rLayout = CLCDTextLayout::GetInstance();
+
+    if(bSingleLine)
+    {
+        // calculate horizontal extent w/ single line, we can get the line height
+        m_sizeHExtent = rLayout.GetExtent(NULL, m_hFont, m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                          m_Size.cx, m_Size.cy, m_nTextFormat | DT_SINGLELINE, m_dtp);
+    }
+    else
+    {
+        // calculate vertical extent with word wrap
+        m_sizeVExtent = rLayout.GetExtent(NULL, m_hFont, m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                          m_Size.cx, m_Size.cy, m_nTextFormat | DT_WORDBREAK, m_dtp);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDText::SetAlignment
+//
+//************************************************************************
+
+void CLCDText::SetAlignment(int nAlignment)
+{
+    m_nTextFormat &= ~m_nTextAlignment;
+    m_nTextFormat |= nAlignment;
+    m_nTextAlignment = nAlignment;
+    Invalidate();
+}
+
+
+//************************************************************************
+//
+// CLCDText::OnPrepareDraw
+//
+// Measures changed text before drawing, so that OnDraw() does not have
+// to. Soft surfaces measure with the built-in font in DrawSoft().
+//************************************************************************
+
+void CLCDText::OnPrepareDraw(CLCDGfxBase &rGfx)
+{
+    if (!m_bRecalcExtent || !m_nTextLength || (NULL != rGfx.GetSoftSurface()))
+    {
+        return;
+    }
+
+    int nOldMapMode = SetMapMode(rGfx.GetHDC(), MM_TEXT);
+    HFONT hOldFont = (HFONT)SelectObject(rGfx.GetHDC(), m_hFont);
+
+    RecalcExtent(rGfx.GetHDC());
+
+    SetMapMode(rGfx.GetHDC(), nOldMapMode);
+    SelectObject(rGfx.GetHDC(), hOldFont);
+}
+
+
+//************************************************************************
+//
+// CLCDText::IsTileSafe
+//
+//************************************************************************
+
+BOOL CLCDText::IsTileSafe(void)
+{
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDText::RecalcExtent
+//
+// The font of the text must be selected into hDC, unless it is NULL.
+//************************************************************************
+
+void CLCDText::RecalcExtent(HDC hDC)
+{
+    if ((NULL != m_pBitmapFont) && m_pBitmapFont->IsLoaded())
+    {
+        // margins are added the way DrawTextEx() measures them
+        int nMargins = m_dtp.iLeftMargin + m_dtp.iRightMargin;
+        m_sizeVExtent = m_pBitmapFont->GetTextExtent(m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                                     GetWidth() - nMargins, m_nTextFormat | DT_WORDBREAK);
+        m_sizeHExtent = m_pBitmapFont->GetTextExtent(m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                                     GetWidth() - nMargins, m_nTextFormat);
+        m_sizeVExtent.cx += nMargins;
+        m_sizeHExtent.cx += nMargins;
+        m_bRecalcExtent = FALSE;
+        return;
+    }
+
+    CLCDTextLayout &rLayout = CLCDTextLayout::GetInstance();
+
+    // calculate vertical extent with word wrap
+    m_sizeVExtent = rLayout.GetExtent(hDC, m_hFont, m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                      GetWidth(), GetHeight(), m_nTextFormat | DT_WORDBREAK, m_dtp);
+
+    // calculate horizontal extent w/o word wrap
+    m_sizeHExtent = rLayout.GetExtent(hDC, m_hFont, m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                      GetWidth(), GetHeight(), m_nTextFormat, m_dtp);
+
+    m_bRecalcExtent = FALSE;
+}
+
+
+//************************************************************************
+//
+// CLCDText::DrawText
+//
+// Draws with the bitmap font if there is one, from the glyph cache if it
+// can, with DrawTextEx() otherwise.
+//************************************************************************
+
+void CLCDText::DrawText(CLCDGfxBase &rGfx)
+{
+    if (DrawBitmapText(rGfx))
+    {
+        if (m_bInverted)
+        {
+            RECT rBoundary = { 0, 0, GetLogicalSize().cx, GetLogicalSize().cy };
+            InvertRect(rGfx.GetHDC(), &rBoundary);
+        }
+        return;
+    }
+
+    // draw the text
+    // DrawTextEx() writes to the parameters, keep m_dtp untouched for
+    // other threads drawing this object (see IsTileSafe)
+    DRAWTEXTPARAMS dtp = m_dtp;
+    RECT rBoundary = { 0, 0,0 + GetLogicalSize().cx, 0 + GetLogicalSize().cy }; 
+    if (!CLCDGlyphCache::GetInstance().DrawText(rGfx, m_hFont, m_sText.c_str(), static_cast<int>(m_nTextLength),
+            rBoundary, m_nTextFormat, dtp, m_crForegroundColor))
+    {
+        DrawTextEx(rGfx.GetHDC(), (LPTSTR)m_sText.c_str(), static_cast<int>(m_nTextLength), &rBoundary, m_nTextFormat, &dtp);
+    }
+
+    if (m_bInverted)
+    {
+        InvertRect(rGfx.GetHDC(), &rBoundary);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDText::OnDraw
+//
+//************************************************************************
+
+void CLCDText::OnDraw(CLCDGfxBase &rGfx)
+{
+    CLCDGfxSoft *pSoft = rGfx.GetSoftSurface();
+    if(NULL != pSoft)
+    {
+        DrawSoft(*pSoft);
+        return;
+    }
+
+    if (GetBackgroundMode() == OPAQUE)
+    {
+        HBRUSH hBackBrush = CreateSolidBrush(m_crBackgroundColor);
+
+        // clear the clipped area
+        RECT rcClp = { 0, 0, m_Size.cx, m_Size.cy };
+        FillRect(rGfx.GetHDC(), &rcClp, (HBRUSH) GetStockObject(BLACK_BRUSH));
+    
+        // clear the logical area
+        RECT rcLog = { 0, 0, m_sizeLogical.cx, m_sizeLogical.cy };
+        FillRect(rGfx.GetHDC(), &rcLog, hBackBrush);
+
+        DeleteObject(hBackBrush);
+    }
+    
+    if (m_nTextLength)
+    {
+
+        // map mode text, with transparency
+        int nOldMapMode = SetMapMode(rGfx.GetHDC(), MM_TEXT);
+        int nOldBkMode = SetBkMode(rGfx.GetHDC(), GetBackgroundMode()); 
+        COLORREF nOldBkColor = SetBkColor(rGfx.GetHDC(), m_crBackgroundColor);
+
+        // select current font
+        HFONT hOldFont = (HFONT)SelectObject(rGfx.GetHDC(), m_hFont);   
+
+        // select color
+        COLORREF crOldTextColor = SetTextColor(rGfx.GetHDC(), m_crForegroundColor);
+        
+        if (m_bRecalcExtent)
+        {
+            RecalcExtent(rGfx.GetHDC());
+        }
+
+        if (IsVisible())
+        {
+            DrawText(rGfx);
+        }
+
+        // restores
+        SetMapMode(rGfx.GetHDC(), nOldMapMode);
+        SetTextColor(rGfx.GetHDC(), crOldTextColor);
+        SetBkMode(rGfx.GetHDC(), nOldBkMode);
+        SetBkColor(rGfx.GetHDC(), nOldBkColor);
+        SelectObject(rGfx.GetHDC(), hOldFont);
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDText::DrawSoft
+//
+// Renders without a device context, using the built-in font of the
+// software surface at the integer scale closest to the current font.
+//************************************************************************
+
+void CLCDText::DrawSoft(CLCDGfxSoft &rSoft)
+{
+    if (GetBackgroundMode() == OPAQUE)
+    {
+        RECT rcClp = { 0, 0, m_Size.cx, m_Size.cy };
+        rSoft.FillRect(rcClp, RGB(0, 0, 0));
+
+        RECT rcLog = { 0, 0, m_sizeLogical.cx, m_sizeLogical.cy };
+        rSoft.FillRect(rcLog, m_crBackgroundColor);
+    }
+
+    if (m_nTextLength && (NULL != m_pBitmapFont) && m_pBitmapFont->IsLoaded())
+    {
+        if (m_bRecalcExtent)
+        {
+            RecalcExtent(NULL);
+        }
+
+        if (IsVisible() && DrawBitmapText(rSoft) && m_bInverted)
+        {
+            RECT rBoundary = { 0, 0, GetLogicalSize().cx, GetLogicalSize().cy };
+            rSoft.InvertRect(rBoundary);
+        }
+    }
+    else if (m_nTextLength)
+    {
+        if (m_bRecalcExtent)
+        {
+            SIZE sizeText = CLCDGfxSoft::GetTextExtent(m_sText.c_str(),
+                static_cast<int>(m_nTextLength), GetSoftScale());
+            m_sizeVExtent = sizeText;
+            m_sizeHExtent = sizeText;
+            m_bRecalcExtent = FALSE;
+        }
+
+        if (IsVisible())
+        {
+            DrawSoftText(rSoft, 0);
+
+            if (m_bInverted)
+            {
+                RECT rBoundary = { 0, 0, GetLogicalSize().cx, GetLogicalSize().cy };
+                rSoft.InvertRect(rBoundary);
+            }
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDText::DrawSoftText
+//
+// Draws the text line by line, honoring the horizontal alignment.
+//************************************************************************
+
+void CLCDText::DrawSoftText(CLCDGfxSoft &rSoft, int nOffsetX)
+{
+    int nScale = GetSoftScale();
+    int nY = 0;
+
+    LPCTSTR szLine = m_sText.c_str();
+    LPCTSTR szEnd = szLine + m_nTextLength;
+    while (szLine < szEnd)
+    {
+        LPCTSTR szNext = szLine;
+        while ((szNext < szEnd) && (_T('\n') != *szNext))
+        {
+            ++szNext;
+        }
+
+        int nLength = static_cast<int>(szNext - szLine);
+        int nLineWidth = CLCDGfxSoft::GetTextExtent(szLine, nLength, nScale).cx;
+
+        int nX = m_dtp.iLeftMargin;
+        if (m_nTextFormat & DT_CENTER)
+        {
+            nX = (GetLogicalSize().cx - nLineWidth) / 2;
+        }
+        else if (m_nTextFormat & DT_RIGHT)
+        {
+            nX = GetLogicalSize().cx - m_dtp.iRightMargin - nLineWidth;
+        }
+
+        rSoft.DrawText(nOffsetX + nX, nY, szLine, nLength, m_crForegroundColor, nScale);
+
+        nY += CLCDGfxSoft::GLYPH_LINEHEIGHT * nScale;
+        szLine = szNext + 1;
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDText::GetSoftScale
+//
+//************************************************************************
+
+int CLCDText::GetSoftScale(void)
+{
+    LOGFONT lf;
+    CLCDFontRegistry::GetInstance().GetLogFont(m_hFont, lf);
+
+    return CLCDGfxSoft::GetScaleForFontHeight(lf.lfHeight);
+}
+
+
+//************************************************************************
+//
+// CLCDText::DrawBitmapText
+//
+// Returns FALSE without drawing if there is no bitmap font.
+//************************************************************************
+
+BOOL CLCDText::DrawBitmapText(CLCDGfxBase &rGfx)
+{
+    if ((NULL == m_pBitmapFont) || !m_pBitmapFont->IsLoaded())
+    {
+        return FALSE;
+    }
+
+    RECT rBoundary = { m_dtp.iLeftMargin, 0, GetLogicalSize().cx - m_dtp.iRightMargin, GetLogicalSize().cy };
+    return m_pBitmapFont->DrawText(rGfx, rBoundary, m_sText.c_str(), static_cast<int>(m_nTextLength),
+                                   m_nTextFormat, m_crForegroundColor);
+}
+
+//** end of LCDText.cpp **************************************************
+
@@ -1,72 +1,95 @@
-//************************************************************************
-//
-// LCDText.h
-//
-// The CLCDText class draws simple text onto the LCD.
-// 
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//************************************************************************
-
-#ifndef _LCDTEXT_H_INCLUDED_ 
-#define _LCDTEXT_H_INCLUDED_ 
-
-#include "LCDBase.h"
-
-class CLCDText : public CLCDBase
-{
-public:
-#ifdef UNICODE
-    typedef std::wstring lcdstring;
-#else
-    typedef std::string lcdstring;
-#endif
-
-public:
-    CLCDText(void);
-    virtual ~CLCDText(void);
-
-    virtual HRESULT Initialize(void);
-    
-    virtual void SetFont(LOGFONT& lf);
-    virtual void SetFontFaceName(LPCTSTR szFontName);
-    virtual void SetFontPointSize(int nPointSize);
-    virtual void SetFontWeight(int nWeight);
-    virtual void SetFontColor(COLORREF color);
-
-    virtual HFONT GetFont(void);
-    virtual void SetText(LPCTSTR szText);
-    virtual LPCTSTR GetText(void);
-    virtual void SetWordWrap(BOOL bEnable);
-    virtual SIZE& GetVExtent(void);
-    virtual SIZE& GetHExtent(void);
-    virtual void CalculateExtent(BOOL bSingleLine);
-    virtual void SetLeftMargin(int nLeftMargin);
-    virtual int GetLeftMargin(void);
-    virtual void SetRightMargin(int nRightMargin);
-    virtual int GetRightMargin(void);
-    virtual void SetAlignment(int nAlignment = DT_LEFT);
-
-    // CLCDBase
-    virtual void OnDraw(CLCDGfxBase &rGfx);
-
-    enum { DEFAULT_DPI = 96, DEFAULT_POINTSIZE = 8 };
-
-protected:
-    void DrawText(CLCDGfxBase &rGfx);
-
-    lcdstring m_sText;
-    HFONT m_hFont;
-    lcdstring::size_type m_nTextLength;
-    UINT m_nTextFormat;
-    BOOL m_bRecalcExtent;
-    DRAWTEXTPARAMS m_dtp;
-    int m_nTextAlignment;
-    SIZE m_sizeVExtent, m_sizeHExtent;
-};
-
-
-#endif // !_LCDTEXT_H_INCLUDED_ 
-
-//** end of LCDText.h ****************************************************
+//************************************************************************
+//
+// LCDText.h
+//
+// The CLCDText class draws simple text onto the LCD.
+// 
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDTEXT_H_INCLUDED_ 
+#define _LCDTEXT_H_INCLUDED_ 
+
+#include "LCDBase.h"
+
+class CLCDText : public CLCDBase
+{
+public:
+#ifdef UNICODE
+    typedef std::wstring lcdstring;
+#else
+    typedef std::string lcdstring;
+#endif
+
+public:
+    CLCDText(void);
+    virtual ~CLCDText(void);
+
+    virtual HRESULT Initialize(void);
+    
+    virtual void SetFont(LOGFONT& lf);
+    virtual void SetFontFaceName(LPCTSTR szFontName);
+    virtual void SetFontPointSize(int nPointSize);
+    virtual void SetFontWeight(int nWeight);
+    virtual void SetFontColor(COLORREF color);
+
+    // Draws and measures with a bitmap font instead of the GDI font, which
+    // is kept for when it is set back to NULL. The font is not owned.
+    // Color and paginated text lay out with GDI and ignore it.
+    virtual void SetBitmapFont(CLCDBitmapFont *pFont);
+    virtual CLCDBitmapFont *GetBitmapFont(void);
+
+    virtual HFONT GetFont(void);
+    virtual void SetText(LPCTSTR szText);
+    // szText needs no terminator; text of the same length as the current
+    // text is copied into its buffer
+    virtual void SetText(LPCTSTR szText, int nLength);
+#ifdef LCDUI_RVALUE_REFS
+    // takes the buffer of sText, leaving it the one of the previous text
+    virtual void SetText(lcdstring &&sText);
+#endif
+    virtual LPCTSTR GetText(void);
+    virtual void SetWordWrap(BOOL bEnable);
+    virtual SIZE& GetVExtent(void);
+    virtual SIZE& GetHExtent(void);
+    virtual void CalculateExtent(BOOL bSingleLine);
+    virtual void SetLeftMargin(int nLeftMargin);
+    virtual int GetLeftMargin(void);
+    virtual void SetRightMargin(int nRightMargin);
+    virtual int GetRightMargin(void);
+    virtual void SetAlignment(int nAlignment = DT_LEFT);
+
+    // CLCDBase
+    virtual void OnPrepareDraw(CLCDGfxBase &rGfx);
+    virtual void OnDraw(CLCDGfxBase &rGfx);
+    virtual BOOL IsTileSafe(void);
+
+    enum { DEFAULT_DPI = 96, DEFAULT_POINTSIZE = 8 };
+
+protected:
+    virtual void RecalcExtent(HDC hDC);
+    virtual void DrawText(CLCDGfxBase &rGfx);
+    void DrawSoft(CLCDGfxSoft &rSoft);
+    void DrawSoftText(CLCDGfxSoft &rSoft, int nOffsetX);
+    int GetSoftScale(void);
+    BOOL DrawBitmapText(CLCDGfxBase &rGfx);
+    BOOL IsSameText(LPCTSTR szText, int nLength);
+    void OnTextChanged(void);
+
+    lcdstring m_sText;
+    HFONT m_hFont;
+    CLCDBitmapFont *m_pBitmapFont;
+    lcdstring::size_type m_nTextLength;
+    UINT m_nTextFormat;
+    BOOL m_bRecalcExtent;
+    DRAWTEXTPARAMS m_dtp;
+    int m_nTextAlignment;
+    SIZE m_sizeVExtent, m_sizeHExtent;
+};
+
+
+#endif // !_LCDTEXT_H_INCLUDED_ 
+
+//** end of LCDText.h ****************************************************
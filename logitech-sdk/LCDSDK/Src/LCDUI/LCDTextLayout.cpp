@@ -0,0 +1,477 @@
+//************************************************************************
+//
+// LCDTextLayout.cpp
+//
+// The CLCDTextLayout class remembers text measurements.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+static CLCDTextLayout s_TextLayout;
+
+
+//************************************************************************
+//
+// CLCDTextLayout::CLCDTextLayout
+//
+//************************************************************************
+
+CLCDTextLayout::CLCDTextLayout(void)
+:   m_dwUseCount(0),
+    m_hDC(NULL),
+    m_bEnabled(TRUE),
+    m_dwHits(0),
+    m_dwMisses(0)
+{
+    InitializeCriticalSection(&m_csLayout);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::~CLCDTextLayout
+//
+//************************************************************************
+
+CLCDTextLayout::~CLCDTextLayout(void)
+{
+    Clear();
+    if(NULL != m_hDC)
+    {
+        DeleteDC(m_hDC);
+        m_hDC = NULL;
+    }
+    DeleteCriticalSection(&m_csLayout);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::GetInstance
+//
+//************************************************************************
+
+CLCDTextLayout &CLCDTextLayout::GetInstance(void)
+{
+    return s_TextLayout;
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::GetExtent
+//
+//************************************************************************
+
+SIZE CLCDTextLayout::GetExtent(HDC hDC, HFONT hFont, LPCTSTR szText, int nLength, int nWidth, int nHeight,
+                               UINT nFormat, const DRAWTEXTPARAMS &dtp)
+{
+    EnterCriticalSection(&m_csLayout);
+
+    LAYOUT *pLayout = FindLayout(hFont, szText, nLength, nWidth, nHeight, nFormat, dtp);
+    if((NULL != pLayout) && pLayout->bExtentValid)
+    {
+        m_dwHits++;
+        SIZE sizeExtent = pLayout->sizeExtent;
+        LeaveCriticalSection(&m_csLayout);
+        return sizeExtent;
+    }
+    m_dwMisses++;
+
+    HFONT hOldFont = NULL;
+    HDC hMeasureDC = (NULL != hDC) ? hDC : SelectFont(hFont, hOldFont);
+
+    // DrawTextEx() writes to the parameters
+    DRAWTEXTPARAMS dtpCalc = dtp;
+    RECT rExtent = { 0, 0, nWidth, nHeight };
+    if(NULL != hMeasureDC)
+    {
+        DrawTextEx(hMeasureDC, (LPTSTR)szText, nLength, &rExtent, nFormat | DT_CALCRECT, &dtpCalc);
+    }
+    if((NULL == hDC) && (NULL != hMeasureDC))
+    {
+        SelectObject(hMeasureDC, hOldFont);
+    }
+
+    SIZE sizeExtent = { rExtent.right, rExtent.bottom };
+    if(NULL != pLayout)
+    {
+        pLayout->sizeExtent = sizeExtent;
+        pLayout->bExtentValid = TRUE;
+    }
+
+    LeaveCriticalSection(&m_csLayout);
+    return sizeExtent;
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::GetLineStarts
+//
+//************************************************************************
+
+void CLCDTextLayout::GetLineStarts(HFONT hFont, LPCTSTR szText, int nLength, int nWidth,
+                                   UINT nFormat, const DRAWTEXTPARAMS &dtp, std::vector<int> &rLineStarts)
+{
+    EnterCriticalSection(&m_csLayout);
+
+    LAYOUT *pLayout = FindLayout(hFont, szText, nLength, nWidth, 0, nFormat, dtp);
+    if((NULL != pLayout) && pLayout->bLinesValid)
+    {
+        m_dwHits++;
+        rLineStarts = pLayout->LineStarts;
+        LeaveCriticalSection(&m_csLayout);
+        return;
+    }
+    m_dwMisses++;
+
+    HFONT hOldFont = NULL;
+    HDC hMeasureDC = SelectFont(hFont, hOldFont);
+    rLineStarts.clear();
+    if(NULL != hMeasureDC)
+    {
+        BreakLines(hMeasureDC, szText, 0, nLength, nWidth, nFormat, dtp, rLineStarts);
+        SelectObject(hMeasureDC, hOldFont);
+    }
+
+    if(NULL != pLayout)
+    {
+        pLayout->LineStarts = rLineStarts;
+        pLayout->bLinesValid = TRUE;
+    }
+
+    LeaveCriticalSection(&m_csLayout);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::ExtendLineStarts
+//
+//************************************************************************
+
+void CLCDTextLayout::ExtendLineStarts(HFONT hFont, LPCTSTR szText, int nLength, int nWidth,
+                                      UINT nFormat, const DRAWTEXTPARAMS &dtp, std::vector<int> &rLineStarts)
+{
+    // the last line may continue in the appended text
+    int nStart = 0;
+    if(!rLineStarts.empty())
+    {
+        nStart = min(rLineStarts.back(), nLength);
+        rLineStarts.pop_back();
+    }
+
+    EnterCriticalSection(&m_csLayout);
+
+    HFONT hOldFont = NULL;
+    HDC hMeasureDC = SelectFont(hFont, hOldFont);
+    if(NULL != hMeasureDC)
+    {
+        BreakLines(hMeasureDC, szText, nStart, nLength, nWidth, nFormat, dtp, rLineStarts);
+        SelectObject(hMeasureDC, hOldFont);
+    }
+    else
+    {
+        rLineStarts.push_back(nStart);
+    }
+
+    LeaveCriticalSection(&m_csLayout);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::Clear
+//
+//************************************************************************
+
+void CLCDTextLayout::Clear(void)
+{
+    EnterCriticalSection(&m_csLayout);
+
+    LAYOUT_MAP::iterator it = m_Layouts.begin();
+    while(it != m_Layouts.end())
+    {
+        delete it->second;
+        ++it;
+    }
+    m_Layouts.clear();
+
+    LeaveCriticalSection(&m_csLayout);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::Enable
+//
+//************************************************************************
+
+void CLCDTextLayout::Enable(BOOL bEnable)
+{
+    m_bEnabled = bEnable;
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::IsEnabled
+//
+//************************************************************************
+
+BOOL CLCDTextLayout::IsEnabled(void)
+{
+    return m_bEnabled;
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::GetStatistics
+//
+//************************************************************************
+
+void CLCDTextLayout::GetStatistics(DWORD &dwHits, DWORD &dwMisses)
+{
+    EnterCriticalSection(&m_csLayout);
+    dwHits = m_dwHits;
+    dwMisses = m_dwMisses;
+    LeaveCriticalSection(&m_csLayout);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::ResetStatistics
+//
+//************************************************************************
+
+void CLCDTextLayout::ResetStatistics(void)
+{
+    EnterCriticalSection(&m_csLayout);
+    m_dwHits = 0;
+    m_dwMisses = 0;
+    LeaveCriticalSection(&m_csLayout);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::HashText
+//
+// FNV-1a
+//
+//************************************************************************
+
+DWORD CLCDTextLayout::HashText(LPCTSTR szText, int nLength)
+{
+    DWORD dwHash = 2166136261U;
+    for(int i = 0; i < nLength; i++)
+    {
+        dwHash = (dwHash ^ (DWORD)(TBYTE)szText[i]) * 16777619U;
+    }
+    return dwHash;
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::FindLayout
+//
+// Returns the layout for these arguments, a new one if there was none.
+// NULL while the cache is disabled.
+//
+//************************************************************************
+
+CLCDTextLayout::LAYOUT *CLCDTextLayout::FindLayout(HFONT hFont, LPCTSTR szText, int nLength,
+                                                   int nWidth, int nHeight, UINT nFormat,
+                                                   const DRAWTEXTPARAMS &dtp)
+{
+    LOGFONT lf;
+    if(!m_bEnabled || (NULL == szText) || !CLCDFontRegistry::GetInstance().GetLogFont(hFont, lf))
+    {
+        return NULL;
+    }
+
+    DWORD dwHash = HashText(szText, nLength);
+    std::pair<LAYOUT_MAP::iterator, LAYOUT_MAP::iterator> range = m_Layouts.equal_range(dwHash);
+    for(LAYOUT_MAP::iterator it = range.first; it != range.second; ++it)
+    {
+        LAYOUT *pLayout = it->second;
+        if((pLayout->nWidth == nWidth) && (pLayout->nHeight == nHeight) &&
+            (pLayout->nFormat == nFormat) &&
+            (pLayout->iLeftMargin == dtp.iLeftMargin) && (pLayout->iRightMargin == dtp.iRightMargin) &&
+            (0 == memcmp(&pLayout->lf, &lf, sizeof(LOGFONT))) &&
+            ((int)pLayout->sText.size() == nLength) &&
+            (0 == pLayout->sText.compare(0, nLength, szText, nLength)))
+        {
+            pLayout->dwLastUse = ++m_dwUseCount;
+            return pLayout;
+        }
+    }
+
+    Trim();
+
+    LAYOUT *pLayout = new LAYOUT;
+    pLayout->lf = lf;
+    pLayout->nWidth = nWidth;
+    pLayout->nHeight = nHeight;
+    pLayout->nFormat = nFormat;
+    pLayout->iLeftMargin = dtp.iLeftMargin;
+    pLayout->iRightMargin = dtp.iRightMargin;
+    pLayout->sText.assign(szText, nLength);
+    pLayout->bExtentValid = FALSE;
+    pLayout->sizeExtent.cx = pLayout->sizeExtent.cy = 0;
+    pLayout->bLinesValid = FALSE;
+    pLayout->dwLastUse = ++m_dwUseCount;
+    m_Layouts.insert(std::make_pair(dwHash, pLayout));
+    return pLayout;
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::SelectFont
+//
+// Selects hFont into the measuring DC, which is created on first use
+//
+//************************************************************************
+
+HDC CLCDTextLayout::SelectFont(HFONT hFont, HFONT &hOldFont)
+{
+    if(NULL == m_hDC)
+    {
+        m_hDC = CreateCompatibleDC(NULL);
+        if(NULL == m_hDC)
+        {
+            return NULL;
+        }
+        SetMapMode(m_hDC, MM_TEXT);
+    }
+
+    hOldFont = (HFONT)SelectObject(m_hDC, hFont);
+    return m_hDC;
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::BreakLines
+//
+// Breaks szText into lines from nStart, which must begin a line. Lines
+// end at CR, LF or CR LF and, with DT_WORDBREAK, at the last blank
+// before the first character that does not fit. A word that is wider
+// than the box is not broken. The font must be selected into hDC.
+//
+//************************************************************************
+
+void CLCDTextLayout::BreakLines(HDC hDC, LPCTSTR szText, int nStart, int nLength, int nWidth, UINT nFormat,
+                                const DRAWTEXTPARAMS &dtp, std::vector<int> &rLineStarts)
+{
+    if(nFormat & DT_SINGLELINE)
+    {
+        rLineStarts.push_back(nStart);
+        return;
+    }
+
+    BOOL bWordBreak = (0 != (nFormat & DT_WORDBREAK));
+    int nMaxWidth = max(0, nWidth - dtp.iLeftMargin - dtp.iRightMargin);
+
+    do
+    {
+        rLineStarts.push_back(nStart);
+
+        int nEnd = nStart;
+        while((nEnd < nLength) && (_T('\r') != szText[nEnd]) && (_T('\n') != szText[nEnd]))
+        {
+            nEnd++;
+        }
+
+        int nNext = nEnd;
+        if(bWordBreak && (nEnd > nStart))
+        {
+            int nFit = 0;
+            SIZE sizeLine;
+            GetTextExtentExPoint(hDC, szText + nStart, nEnd - nStart, nMaxWidth, &nFit, NULL, &sizeLine);
+            if(nStart + nFit < nEnd)
+            {
+                // back to the blank before the word that does not fit
+                int nBreak = nStart + nFit;
+                while((nBreak > nStart) && (_T(' ') != szText[nBreak]))
+                {
+                    nBreak--;
+                }
+                if(nBreak == nStart)
+                {
+                    // or past the end of a word wider than the box
+                    nBreak = nStart + max(1, nFit);
+                    while((nBreak < nEnd) && (_T(' ') != szText[nBreak]))
+                    {
+                        nBreak++;
+                    }
+                }
+                nNext = nBreak;
+            }
+        }
+
+        // skip the line break, or the blanks a wrapped line ends with
+        nStart = nNext;
+        if((nStart < nLength) && (_T('\r') == szText[nStart]))
+        {
+            nStart++;
+            if((nStart < nLength) && (_T('\n') == szText[nStart]))
+            {
+                nStart++;
+            }
+        }
+        else if((nStart < nLength) && (_T('\n') == szText[nStart]))
+        {
+            nStart++;
+        }
+        else
+        {
+            while((nStart < nLength) && (_T(' ') == szText[nStart]))
+            {
+                nStart++;
+            }
+        }
+    }
+    while(nStart < nLength);
+}
+
+
+//************************************************************************
+//
+// CLCDTextLayout::Trim
+//
+// Makes room for one more layout
+//
+//************************************************************************
+
+void CLCDTextLayout::Trim(void)
+{
+    if((int)m_Layouts.size() < MAX_LAYOUTS)
+    {
+        return;
+    }
+
+    LAYOUT_MAP::iterator itOldest = m_Layouts.begin();
+    for(LAYOUT_MAP::iterator it = m_Layouts.begin(); it != m_Layouts.end(); ++it)
+    {
+        if(it->second->dwLastUse < itOldest->second->dwLastUse)
+        {
+            itOldest = it;
+        }
+    }
+
+    delete itOldest->second;
+    m_Layouts.erase(itOldest);
+}
+
+
+//** end of LCDTextLayout.cpp ********************************************
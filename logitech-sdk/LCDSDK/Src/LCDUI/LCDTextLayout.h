@@ -0,0 +1,110 @@
+//************************************************************************
+//
+// LCDTextLayout.h
+//
+// The CLCDTextLayout class remembers text measurements: extents as
+// DrawTextEx(DT_CALCRECT) returns them, and where lines break. Objects
+// measuring the same text with the same font, box and format share
+// the result.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDTEXTLAYOUT_H_INCLUDED_
+#define _LCDTEXTLAYOUT_H_INCLUDED_
+
+#include <map>
+
+class CLCDTextLayout
+{
+public:
+    CLCDTextLayout(void);
+    virtual ~CLCDTextLayout(void);
+
+    // the cache shared by all text objects
+    static CLCDTextLayout &GetInstance(void);
+
+    // The extent DrawTextEx() computes with DT_CALCRECT for a box of
+    // nWidth x nHeight at 0, 0. hDC, if not NULL, must have hFont
+    // selected; otherwise the cache measures with its own DC.
+    SIZE GetExtent(HDC hDC, HFONT hFont, LPCTSTR szText, int nLength, int nWidth, int nHeight,
+                   UINT nFormat, const DRAWTEXTPARAMS &dtp);
+
+    // Offsets of the first character of each line, following the line
+    // breaks and, with DT_WORDBREAK, the word wrapping of DrawTextEx()
+    void GetLineStarts(HFONT hFont, LPCTSTR szText, int nLength, int nWidth,
+                       UINT nFormat, const DRAWTEXTPARAMS &dtp, std::vector<int> &rLineStarts);
+
+    // Completes rLineStarts, which holds the line starts of a prefix of
+    // szText (or nothing), for all of szText. Only the last line and what
+    // follows are broken again; the lines before it cannot change when
+    // text is appended. Documents are too large to be cached.
+    void ExtendLineStarts(HFONT hFont, LPCTSTR szText, int nLength, int nWidth,
+                          UINT nFormat, const DRAWTEXTPARAMS &dtp, std::vector<int> &rLineStarts);
+
+    void Clear(void);
+
+    // While disabled, every measurement goes to GDI
+    void Enable(BOOL bEnable);
+    BOOL IsEnabled(void);
+
+    // lookups since the last reset
+    void GetStatistics(DWORD &dwHits, DWORD &dwMisses);
+    void ResetStatistics(void);
+
+    // least recently used layouts are dropped beyond this
+    enum { MAX_LAYOUTS = 256 };
+
+protected:
+    struct LAYOUT
+    {
+        LOGFONT lf;
+        int nWidth;
+        int nHeight;
+        UINT nFormat;
+        int iLeftMargin;
+        int iRightMargin;
+#ifdef UNICODE
+        std::wstring sText;
+#else
+        std::string sText;
+#endif
+
+        BOOL bExtentValid;
+        SIZE sizeExtent;
+        BOOL bLinesValid;
+        std::vector<int> LineStarts;
+
+        DWORD dwLastUse;
+    };
+
+    typedef std::multimap<DWORD, LAYOUT *> LAYOUT_MAP;
+
+    static DWORD HashText(LPCTSTR szText, int nLength);
+    LAYOUT *FindLayout(HFONT hFont, LPCTSTR szText, int nLength, int nWidth, int nHeight,
+                       UINT nFormat, const DRAWTEXTPARAMS &dtp);
+    HDC SelectFont(HFONT hFont, HFONT &hOldFont);
+    void BreakLines(HDC hDC, LPCTSTR szText, int nStart, int nLength, int nWidth, UINT nFormat,
+                    const DRAWTEXTPARAMS &dtp, std::vector<int> &rLineStarts);
+    void Trim(void);
+
+protected:
+    // keyed by the hash of the text
+    LAYOUT_MAP m_Layouts;
+    DWORD m_dwUseCount;
+
+    // measures when the caller has no device context
+    HDC m_hDC;
+
+    BOOL m_bEnabled;
+    DWORD m_dwHits;
+    DWORD m_dwMisses;
+
+    CRITICAL_SECTION m_csLayout;
+};
+
+#endif // !_LCDTEXTLAYOUT_H_INCLUDED_
+
+//** end of LCDTextLayout.h **********************************************
@@ -0,0 +1,341 @@
+//************************************************************************
+//
+// LCDTileRenderer.cpp
+//
+// The CLCDTileRenderer class splits a screen into tiles and draws a page
+// into them on a pool of worker threads.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#include "LCDUI.h"
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::CLCDTileRenderer
+//
+//************************************************************************
+
+CLCDTileRenderer::CLCDTileRenderer(void)
+:   m_pGfx(NULL),
+    m_pWorkers(NULL),
+    m_nWorkers(0),
+    m_pView(NULL),
+    m_pPage(NULL),
+    m_nNextTile(0),
+    m_nBusyWorkers(0),
+    m_bStop(FALSE),
+    m_hStartSemaphore(NULL),
+    m_hDoneEvent(NULL)
+{
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::~CLCDTileRenderer
+//
+//************************************************************************
+
+CLCDTileRenderer::~CLCDTileRenderer(void)
+{
+    Shutdown();
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::Initialize
+//
+//************************************************************************
+
+HRESULT CLCDTileRenderer::Initialize(CLCDGfxBase *pGfx, int nThreads)
+{
+    Shutdown();
+
+    // soft surfaces have a single clip rectangle, and no device context
+    LCDUIASSERT(NULL != pGfx);
+    if((NULL == pGfx) || (NULL != pGfx->GetSoftSurface()))
+    {
+        return E_INVALIDARG;
+    }
+
+    if(0 >= nThreads)
+    {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        nThreads = (int)si.dwNumberOfProcessors - 1;
+    }
+    nThreads = max(0, nThreads);
+
+    m_pGfx = pGfx;
+    m_pView = new CLCDGfxView(*pGfx);
+    if(FAILED(m_pView->Initialize()))
+    {
+        LCDUITRACE(_T("CLCDTileRenderer::Initialize(): failed to create the view.\n"));
+        Shutdown();
+        return E_FAIL;
+    }
+
+    m_hStartSemaphore = CreateSemaphore(NULL, 0, max(1, nThreads), NULL);
+    m_hDoneEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if((NULL == m_hStartSemaphore) || (NULL == m_hDoneEvent))
+    {
+        Shutdown();
+        return E_FAIL;
+    }
+
+    m_pWorkers = new WORKER[nThreads];
+    for(int i = 0; i < nThreads; i++)
+    {
+        m_pWorkers[i].pRenderer = this;
+        m_pWorkers[i].pView = NULL;
+        m_pWorkers[i].hThread = NULL;
+    }
+    m_nWorkers = nThreads;
+
+    for(int i = 0; i < nThreads; i++)
+    {
+        m_pWorkers[i].pView = new CLCDGfxView(*pGfx);
+        if(FAILED(m_pWorkers[i].pView->Initialize()))
+        {
+            LCDUITRACE(_T("CLCDTileRenderer::Initialize(): failed to create a view.\n"));
+            Shutdown();
+            return E_FAIL;
+        }
+
+        m_pWorkers[i].hThread = CreateThread(NULL, 0, _WorkerThreadProc, &m_pWorkers[i], 0, NULL);
+        if(NULL == m_pWorkers[i].hThread)
+        {
+            LCDUITRACE(_T("CLCDTileRenderer::Initialize(): could not start a worker.\n"));
+            Shutdown();
+            return E_FAIL;
+        }
+    }
+
+    return S_OK;
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::Shutdown
+//
+//************************************************************************
+
+void CLCDTileRenderer::Shutdown(void)
+{
+    if(NULL != m_pWorkers)
+    {
+        int nThreads = 0;
+        for(int i = 0; i < m_nWorkers; i++)
+        {
+            if(NULL != m_pWorkers[i].hThread)
+            {
+                nThreads++;
+            }
+        }
+
+        m_bStop = TRUE;
+        if(0 < nThreads)
+        {
+            ReleaseSemaphore(m_hStartSemaphore, nThreads, NULL);
+        }
+
+        for(int i = 0; i < m_nWorkers; i++)
+        {
+            if(NULL != m_pWorkers[i].hThread)
+            {
+                WaitForSingleObject(m_pWorkers[i].hThread, INFINITE);
+                CloseHandle(m_pWorkers[i].hThread);
+            }
+            delete m_pWorkers[i].pView;
+        }
+
+        delete [] m_pWorkers;
+        m_pWorkers = NULL;
+    }
+    m_nWorkers = 0;
+    m_bStop = FALSE;
+
+    if(NULL != m_hStartSemaphore)
+    {
+        CloseHandle(m_hStartSemaphore);
+        m_hStartSemaphore = NULL;
+    }
+    if(NULL != m_hDoneEvent)
+    {
+        CloseHandle(m_hDoneEvent);
+        m_hDoneEvent = NULL;
+    }
+
+    if(NULL != m_pView)
+    {
+        delete m_pView;
+        m_pView = NULL;
+    }
+
+    m_pGfx = NULL;
+    m_Tiles.clear();
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::IsInitialized
+//
+//************************************************************************
+
+BOOL CLCDTileRenderer::IsInitialized(void)
+{
+    return (NULL != m_pView);
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::GetThreadCount
+//
+//************************************************************************
+
+int CLCDTileRenderer::GetThreadCount(void)
+{
+    return m_nWorkers;
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::Render
+//
+//************************************************************************
+
+BOOL CLCDTileRenderer::Render(CLCDBase &rPage, const RECT &rcArea)
+{
+    if(!IsInitialized() || !rPage.IsTileSafe())
+    {
+        return FALSE;
+    }
+
+    // anything that is computed while drawing is done here, once
+    rPage.OnPrepareDraw(*m_pGfx);
+
+    m_Tiles.clear();
+    for(int y = 0; y < m_pGfx->GetHeight(); y += TILE_HEIGHT)
+    {
+        for(int x = 0; x < m_pGfx->GetWidth(); x += TILE_WIDTH)
+        {
+            RECT rcTile = { x, y, x + TILE_WIDTH, y + TILE_HEIGHT };
+            if(IntersectRect(&rcTile, &rcTile, &rcArea))
+            {
+                m_Tiles.push_back(rcTile);
+            }
+        }
+    }
+
+    // the caller cleared the area through its own device context
+    GdiFlush();
+
+    m_pPage = &rPage;
+    m_nNextTile = 0;
+    int nWake = min(m_nWorkers, (int)m_Tiles.size() - 1);
+    if(0 < nWake)
+    {
+        m_nBusyWorkers = nWake;
+        ReleaseSemaphore(m_hStartSemaphore, nWake, NULL);
+    }
+
+    DrawTiles(*m_pView);
+
+    if(0 < nWake)
+    {
+        WaitForSingleObject(m_hDoneEvent, INFINITE);
+    }
+    m_pPage = NULL;
+
+    return TRUE;
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::_WorkerThreadProc
+//
+//************************************************************************
+
+DWORD WINAPI CLCDTileRenderer::_WorkerThreadProc(LPVOID pContext)
+{
+    WORKER *pWorker = (WORKER *)pContext;
+    pWorker->pRenderer->WorkerLoop(*pWorker->pView);
+    return 0;
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::WorkerLoop
+//
+//************************************************************************
+
+void CLCDTileRenderer::WorkerLoop(CLCDGfxView &rView)
+{
+    for (;;)
+    {
+        WaitForSingleObject(m_hStartSemaphore, INFINITE);
+        if (m_bStop)
+        {
+            return;
+        }
+
+        DrawTiles(rView);
+
+        // A worker may take the turn of another one that is slow to wake
+        // up, the count stays right either way
+        if (0 == InterlockedDecrement(&m_nBusyWorkers))
+        {
+            SetEvent(m_hDoneEvent);
+        }
+    }
+}
+
+
+//************************************************************************
+//
+// CLCDTileRenderer::DrawTiles
+//
+// Draws tiles until none are left
+//
+//************************************************************************
+
+void CLCDTileRenderer::DrawTiles(CLCDGfxView &rView)
+{
+    rView.BeginDraw();
+
+    // Render() prepared the page, objects must only be read from here on
+    rView.SetPrepared(TRUE);
+
+    for (;;)
+    {
+        LONG nTile = InterlockedIncrement(&m_nNextTile) - 1;
+        if (nTile >= (LONG)m_Tiles.size())
+        {
+            break;
+        }
+
+        rView.SetDamageRect(&m_Tiles[nTile]);
+        m_pPage->OnDraw(rView);
+    }
+
+    rView.SetDamageRect(NULL);
+    rView.SetPrepared(FALSE);
+    rView.EndDraw();
+
+    // the pixels have to be in the screen before it is submitted
+    GdiFlush();
+}
+
+
+//** end of LCDTileRenderer.cpp ******************************************
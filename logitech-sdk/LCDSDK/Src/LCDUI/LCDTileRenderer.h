@@ -0,0 +1,74 @@
+//************************************************************************
+//
+// LCDTileRenderer.h
+//
+// The CLCDTileRenderer class splits a screen into tiles and draws a page
+// into them on a pool of worker threads. Every tile is drawn with the
+// damage rectangle set to it, so the result is the same as drawing the
+// page at once.
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//************************************************************************
+
+#ifndef _LCDTILERENDERER_H_INCLUDED_
+#define _LCDTILERENDERER_H_INCLUDED_
+
+#include "LCDGfxView.h"
+
+class CLCDTileRenderer
+{
+public:
+    CLCDTileRenderer(void);
+    virtual ~CLCDTileRenderer(void);
+
+    // nThreads is the number of workers, besides the thread calling
+    // Render(). 0 starts one for each additional processor.
+    HRESULT Initialize(CLCDGfxBase *pGfx, int nThreads = 0);
+    void Shutdown(void);
+    BOOL IsInitialized(void);
+    int GetThreadCount(void);
+
+    // Draws rPage into rcArea of the surface given to Initialize(), which
+    // must be between BeginDraw() and EndDraw(), with rcArea cleared.
+    // Returns FALSE without drawing if the page has objects that are not
+    // tile safe (see CLCDBase::IsTileSafe); the caller then draws it.
+    BOOL Render(CLCDBase &rPage, const RECT &rcArea);
+
+    enum { TILE_WIDTH = 80, TILE_HEIGHT = 60 };
+
+protected:
+    struct WORKER
+    {
+        CLCDTileRenderer *pRenderer;
+        CLCDGfxView *pView;
+        HANDLE hThread;
+    };
+
+    static DWORD WINAPI _WorkerThreadProc(LPVOID pContext);
+    void WorkerLoop(CLCDGfxView &rView);
+    void DrawTiles(CLCDGfxView &rView);
+
+protected:
+    CLCDGfxBase *m_pGfx;
+    WORKER *m_pWorkers;
+    int m_nWorkers;
+    // tiles of the calling thread
+    CLCDGfxView *m_pView;
+
+    // the frame being rendered
+    CLCDBase *m_pPage;
+    std::vector<RECT> m_Tiles;
+    volatile LONG m_nNextTile;
+    volatile LONG m_nBusyWorkers;
+    BOOL m_bStop;
+
+    // released once per worker for each frame
+    HANDLE m_hStartSemaphore;
+    HANDLE m_hDoneEvent;
+};
+
+#endif // !_LCDTILERENDERER_H_INCLUDED_
+
+//** end of LCDTileRenderer.h ********************************************
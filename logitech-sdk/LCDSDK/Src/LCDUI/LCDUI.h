@@ -1,84 +1,115 @@
-//************************************************************************
-//
-// LCDUI.h
-//
-// Common header file for all LCDUI source files
-// This file can be used to compile with pre-compiled headers
-// under Visual Studio
-//
-// Logitech LCD SDK
-//
-// Copyright 2008 Logitech Inc.
-//
-//************************************************************************
-
-#ifndef _LCDUI_H_INCLUDED_
-#define _LCDUI_H_INCLUDED_
-
-//************************************************************************
-// all windows header files
-//************************************************************************
-
-#include <windows.h>
-#include <tchar.h>
-#include <vector>
-#include <queue>
-#include <Vfw.h>
-#include <GdiPlus.h>
-
-
-//************************************************************************
-// all classes
-//************************************************************************
-
-class CLCDBase;
-class CLCDCollection;
-class CLCDPage;
-class CLCDPopupBackground;
-class CLCDConnection;
-class CLCDOutput;
-class CLCDGfxBase;
-class CLCDGfxMono;
-class CLCDGfxColor;
-class CLCDText;
-class CLCDColorText;
-class CLCDScrollingText;
-class CLCDStreamingText;
-class CLCDPaginateText;
-class CLCDIcon;
-class CLCDBitmap;
-class CLCDAnimatedBitmap;
-class CLCDProgressBar;
-class CLCDColorProgressBar;
-class CLCDSkinnedProgressBar;
-
-
-//************************************************************************
-// all header files
-//************************************************************************
-
-#include <lglcd.h>
-#include "LCDBase.h"
-#include "LCDCollection.h"
-#include "LCDPage.h"
-#include "LCDConnection.h"
-#include "LCDOutput.h"
-#include "LCDGfxBase.h"
-#include "LCDGfxMono.h"
-#include "LCDGfxColor.h"
-#include "LCDText.h"
-#include "LCDColorText.h"
-#include "LCDScrollingText.h"
-#include "LCDStreamingText.h"
-#include "LCDPaginateText.h"
-#include "LCDIcon.h"
-#include "LCDBitmap.h"
-#include "LCDAnimatedBitmap.h"
-#include "LCDProgressBar.h"
-#include "LCDColorProgressBar.h"
-#include "LCDSkinnedProgressBar.h"
-
-
-#endif //~_LCDUI_H_INCLUDED_
-
-//** end of LCDUI.h ******************************************************
+//************************************************************************
+//
+// LCDUI.h
+//
+// Common header file for all LCDUI source files
+// This file can be used to compile with pre-compiled headers
+// under Visual Studio
+//
+// Logitech LCD SDK
+//
+// Copyright 2008 Logitech Inc.
+//
+//************************************************************************
+
+#ifndef _LCDUI_H_INCLUDED_
+#define _LCDUI_H_INCLUDED_
+
+//************************************************************************
+// all windows header files
+//************************************************************************
+
+#include <windows.h>
+#include <tchar.h>
+#include <vector>
+#include <queue>
+#include <Vfw.h>
+#include <GdiPlus.h>
+
+
+//************************************************************************
+// all classes
+//************************************************************************
+
+class CLCDClock;
+class CLCDBase;
+class CLCDCollection;
+class CLCDPage;
+class CLCDPopupBackground;
+class CLCDConnection;
+class CLCDOutput;
+class CLCDGfxBase;
+class CLCDGfxMono;
+class CLCDGfxColor;
+class CLCDGfxSoft;
+class CLCDSoftSurface;
+class CLCDGfxView;
+class CLCDDither;
+class CLCDImage;
+class CLCDCompositor;
+class CLCDTileRenderer;
+class CLCDGlyphCache;
+class CLCDFontRegistry;
+class CLCDTextLayout;
+class CLCDMarquee;
+class CLCDBitmapFont;
+class CLCDText;
+class CLCDNumericText;
+class CLCDColorText;
+class CLCDScrollingText;
+class CLCDStreamingText;
+class CLCDPaginateText;
+class CLCDLogView;
+class CLCDIcon;
+class CLCDBitmap;
+class CLCDSpriteAtlas;
+class CLCDAnimatedBitmap;
+class CLCDProgressBar;
+class CLCDColorProgressBar;
+class CLCDSkinnedProgressBar;
+
+
+//************************************************************************
+// all header files
+//************************************************************************
+
+#include <lglcd.h>
+#include "LCDClock.h"
+#include "LCDBase.h"
+#include "LCDCollection.h"
+#include "LCDPage.h"
+#include "LCDConnection.h"
+#include "LCDOutput.h"
+#include "LCDGfxBase.h"
+#include "LCDGfxMono.h"
+#include "LCDGfxColor.h"
+#include "LCDGfxSoft.h"
+#include "LCDGfxView.h"
+#include "LCDDither.h"
+#include "LCDCompositor.h"
+#include "LCDImageDecoder.h"
+#include "LCDTileRenderer.h"
+#include "LCDGlyphCache.h"
+#include "LCDFontRegistry.h"
+#include "LCDTextLayout.h"
+#include "LCDMarquee.h"
+#include "LCDBitmapFont.h"
+#include "LCDText.h"
+#include "LCDNumericText.h"
+#include "LCDColorText.h"
+#include "LCDScrollingText.h"
+#include "LCDStreamingText.h"
+#include "LCDPaginateText.h"
+#include "LCDLogView.h"
+#include "LCDIcon.h"
+#include "LCDBitmap.h"
+#include "LCDSpriteAtlas.h"
+#include "LCDAnimatedBitmap.h"
+#include "LCDProgressBar.h"
+#include "LCDColorProgressBar.h"
+#include "LCDSkinnedProgressBar.h"
+
+
+#endif //~_LCDUI_H_INCLUDED_
+
+//** end of LCDUI.h ******************************************************